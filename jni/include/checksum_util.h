@@ -0,0 +1,32 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_CHECKSUM_UTIL_H
+#define OPENSEARCH_KNN_CHECKSUM_UTIL_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace knn_jni {
+    namespace util {
+        /**
+         * Update a CRC-32 checksum with length bytes. This is the checksum of java.util.zip.CRC32, which Lucene writes
+         * in file footers.
+         * Carry-less multiplication is used on x86-64 CPUs supporting it, a table based implementation otherwise.
+         *
+         * @param crc checksum of the bytes before data, 0 for the first bytes
+         * @return checksum of the bytes up to the end of data
+         */
+        uint32_t crc32(uint32_t crc, const uint8_t *data, size_t length);
+    }
+}
+
+#endif //OPENSEARCH_KNN_CHECKSUM_UTIL_H
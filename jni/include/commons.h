@@ -14,8 +14,19 @@
 
 #include "jni_util.h"
 #include <jni.h>
+#include <optional>
 namespace knn_jni {
     namespace commons {
+        /**
+         * Query time method parameters. They are resolved from the Java method parameters map once and can then be
+         * reused by every query and segment of a search, skipping the map conversion on the hot path. Parameters
+         * that are not set fall back to the value the index was built with.
+         */
+        struct SearchParams {
+            std::optional<int> efSearch;
+            std::optional<int> nprobes;
+        };
+
         /**
          * This is utility function that can be used to store data in native memory. This function will allocate memory for
          * the data(rows*columns) with initialCapacity and return the memory address where the data is stored.
@@ -33,7 +44,7 @@ namespace knn_jni {
          * @param data 2D float array containing data to be stored in native memory.
          * @param initialCapacity The initial capacity of the memory location.
          * @param append whether to append or start from index 0 when called subsequently with the same address
-         * @return memory address of std::vector<float> where the data is stored.
+         * @return memory address of the knn_jni::memory::VectorBuffer<float> where the data is stored.
          */
         jlong storeVectorData(knn_jni::JNIUtilInterface *, JNIEnv *, jlong , jobjectArray, jlong, jboolean);
 
@@ -54,7 +65,7 @@ namespace knn_jni {
          * @param data 2D byte array containing binary data to be stored in native memory.
          * @param initialCapacity The initial capacity of the memory location.
          * @param append whether to append or start from index 0 when called subsequently with the same address
-         * @return memory address of std::vector<uint8_t> where the data is stored.
+         * @return memory address of the knn_jni::memory::VectorBuffer<uint8_t> where the data is stored.
          */
         jlong storeBinaryVectorData(knn_jni::JNIUtilInterface *, JNIEnv *, jlong , jobjectArray, jlong, jboolean);
 
@@ -69,10 +80,65 @@ namespace knn_jni {
         * @param data 2D byte array containing int8 data to be stored in native memory.
         * @param initialCapacity The initial capacity of the memory location.
         * @param append whether to append or start from index 0 when called subsequently with the same address
-        * @return memory address of std::vector<int8_t> where the data is stored.
+        * @return memory address of the knn_jni::memory::VectorBuffer<int8_t> where the data is stored.
         */
         jlong storeByteVectorData(knn_jni::JNIUtilInterface *, JNIEnv *, jlong , jobjectArray, jlong, jboolean);
 
+        /**
+         * Same as storeVectorData, but takes the vectors as one flat float array of rows*columns elements. The first
+         * length elements of the array are appended to the native store with a single copy from a critical section,
+         * instead of one JNI round trip per row.
+         *
+         * @param memoryAddress The address of the memory location where data will be stored.
+         * @param data flat float array containing data to be stored in native memory.
+         * @param length number of elements of data to store.
+         * @param initialCapacity The initial capacity of the memory location.
+         * @param append whether to append or start from index 0 when called subsequently with the same address
+         * @return memory address of the knn_jni::memory::VectorBuffer<float> where the data is stored.
+         */
+        jlong storeFlatVectorData(knn_jni::JNIUtilInterface *, JNIEnv *, jlong, jfloatArray, jint, jlong, jboolean);
+
+        /**
+         * Same as storeBinaryVectorData, but takes the vectors as one flat byte array. See storeFlatVectorData.
+         *
+         * @return memory address of the knn_jni::memory::VectorBuffer<uint8_t> where the data is stored.
+         */
+        jlong storeFlatBinaryVectorData(knn_jni::JNIUtilInterface *, JNIEnv *, jlong, jbyteArray, jint, jlong, jboolean);
+
+        /**
+         * Same as storeByteVectorData, but takes the vectors as one flat byte array. See storeFlatVectorData.
+         *
+         * @return memory address of the knn_jni::memory::VectorBuffer<int8_t> where the data is stored.
+         */
+        jlong storeFlatByteVectorData(knn_jni::JNIUtilInterface *, JNIEnv *, jlong, jbyteArray, jint, jlong, jboolean);
+
+        /**
+         * Same as storeVectorData, but copies the vectors from a direct ByteBuffer holding native order floats. The
+         * buffer contents are read from its start, regardless of its position.
+         *
+         * @param memoryAddress The address of the memory location where data will be stored.
+         * @param data direct ByteBuffer containing data to be stored in native memory.
+         * @param length number of floats of data to store.
+         * @param initialCapacity The initial capacity of the memory location.
+         * @param append whether to append or start from index 0 when called subsequently with the same address
+         * @return memory address of the knn_jni::memory::VectorBuffer<float> where the data is stored.
+         */
+        jlong storeVectorDataFromBuffer(knn_jni::JNIUtilInterface *, JNIEnv *, jlong, jobject, jlong, jlong, jboolean);
+
+        /**
+         * Same as storeBinaryVectorData, but copies the vectors from a direct ByteBuffer. See storeVectorDataFromBuffer.
+         *
+         * @return memory address of the knn_jni::memory::VectorBuffer<uint8_t> where the data is stored.
+         */
+        jlong storeBinaryVectorDataFromBuffer(knn_jni::JNIUtilInterface *, JNIEnv *, jlong, jobject, jlong, jlong, jboolean);
+
+        /**
+         * Same as storeByteVectorData, but copies the vectors from a direct ByteBuffer. See storeVectorDataFromBuffer.
+         *
+         * @return memory address of the knn_jni::memory::VectorBuffer<int8_t> where the data is stored.
+         */
+        jlong storeByteVectorDataFromBuffer(knn_jni::JNIUtilInterface *, JNIEnv *, jlong, jobject, jlong, jlong, jboolean);
+
         /**
          * Free up the memory allocated for the data stored in memory address. This function should be used with the memory
          * address returned by {@link JNICommons#storeVectorData(long, float[][], long, long)}
@@ -97,10 +163,66 @@ namespace knn_jni {
          */
         void freeBinaryVectorData(jlong);
 
+        /**
+         * Configure the pool of slabs backing the vector data stores.
+         *
+         * @param maxPooledBytes maximum number of bytes of released slabs kept for reuse, 0 disables pooling
+         * @param useHugePages whether slabs of 2MB and more are backed by transparent huge pages
+         */
+        void configureVectorBufferPool(jlong, jboolean);
+
+        /**
+         * Statistics of the pool of slabs backing the vector data stores, as a long array of
+         * [pooled bytes, pooled slabs, used bytes, max pooled bytes, hits, misses].
+         */
+        jlongArray getVectorBufferPoolStats(knn_jni::JNIUtilInterface *, JNIEnv *);
+
+        /**
+         * Hand the free memory of the allocator back to the operating system, such as the memory of freed indices that
+         * glibc keeps in its arenas. This walks all the arenas and can take a while on large heaps.
+         *
+         * @return true if memory was released, false if there was none to release or the allocator cannot be trimmed
+         */
+        jboolean trimNativeMemory();
+
         /**
          * Extracts query time efSearch from method parameters
          **/
-        int getIntegerMethodParameter(JNIEnv *, knn_jni::JNIUtilInterface *, std::unordered_map<std::string, jobject>, std::string, int);
+        int getIntegerMethodParameter(JNIEnv *, knn_jni::JNIUtilInterface *, const std::unordered_map<std::string, jobject> &, const std::string &, int);
+
+        /**
+         * Resolves the search parameters from a Java Map<String, ?> of method parameters. A null map yields
+         * parameters with nothing set.
+         *
+         * @param methodParamsJ Java method parameters map, may be null.
+         * @return resolved search parameters.
+         */
+        SearchParams parseSearchParams(knn_jni::JNIUtilInterface *, JNIEnv *, jobject);
+
+        /**
+         * Allocates search parameters from primitive values, without going through a Java map. Negative values
+         * leave the parameter unset. The returned address must be freed with {@link JNICommons#freeSearchParams(long)}
+         *
+         * @param efSearch query time ef_search.
+         * @param nprobes query time nprobes.
+         * @return memory address of the knn_jni::commons::SearchParams.
+         */
+        jlong createSearchParams(jint, jint);
+
+        /**
+         * Reads the search parameters stored in memory address. An address of 0 yields parameters with nothing set.
+         *
+         * @param searchParamsAddress address returned by createSearchParams, or 0.
+         * @return the search parameters.
+         */
+        SearchParams getSearchParams(jlong);
+
+        /**
+         * Free up the search parameters stored in memory address.
+         *
+         * @param searchParamsAddress address to be freed.
+         */
+        void freeSearchParams(jlong);
     }
 }
 
@@ -0,0 +1,128 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_FAISS_HNSW_COMPACT_H
+#define OPENSEARCH_KNN_FAISS_HNSW_COMPACT_H
+
+#include "faiss/IndexBinaryHNSW.h"
+#include "faiss/IndexHNSW.h"
+#include "faiss/IndexIDMap.h"
+#include "faiss/impl/HNSW.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace knn_jni {
+    namespace graph {
+        /**
+         * Neighbor lists of all the levels of an HNSW graph, encoded compactly. faiss stores a fixed number of slots
+         * per node and level, padded with -1, which for M=32 costs 256 bytes per vector on level 0 alone.
+         *
+         * Each list is sorted and stored as its first id followed by the deltas between consecutive ids, bit packed
+         * with the width of the largest delta of the list. Padding is dropped. The lists of a node are stored next to
+         * each other, from level 0 up, and are byte aligned.
+         *
+         * Sorting drops the closest first order of the lists, which only matters when neighbors are added to the
+         * graph, so compact graphs are read only. faiss decodes the lists as it searches the graph, through
+         * faiss::HNSW::external_neighbors.
+         */
+        class CompactNeighborLists : public faiss::HNSWNeighborLists {
+        public:
+            CompactNeighborLists() = default;
+
+            explicit CompactNeighborLists(const faiss::HNSW &hnsw);
+
+            // Decode the neighbors of node on level into neighbors, which must hold maxNeighbors() ids, and return
+            // how many there are. level must be one of the levels of node.
+            size_t decode(faiss::HNSW::storage_idx_t node, int level,
+                          faiss::HNSW::storage_idx_t *neighbors) const override;
+
+            // Largest number of neighbors of a list, the size of level 0 lists
+            size_t maxNeighbors() const {
+                return maxListSize;
+            }
+
+            const std::vector<uint8_t> &encodedLists() const {
+                return lists;
+            }
+
+            const std::vector<uint32_t> &listOffsets() const {
+                return nodeOffsets;
+            }
+
+            // Bytes held by the encoded lists and their offsets, by capacity
+            int64_t bytes() const;
+
+        private:
+            const uint8_t *nodeLists(faiss::HNSW::storage_idx_t node) const;
+
+            // Lists of node n start at blockOffsets[n / NODES_PER_BLOCK] + nodeOffsets[n] in lists. Offsets within
+            // a block fit in 32 bits for any sensible M
+            std::vector<uint64_t> blockOffsets;
+            std::vector<uint32_t> nodeOffsets;
+            std::vector<uint8_t> lists;
+            size_t maxListSize = 0;
+        };
+
+        /**
+         * HNSW index whose graph is held in compact neighbor lists. It takes over the graph and storage of a loaded
+         * IndexHNSW and frees its neighbor lists and offsets. It is searched by IndexHNSW, which decodes the lists on
+         * the fly, so search parameters, filters, grouping and range search work the same. Vectors cannot be added.
+         */
+        class IndexHNSWCompact : public faiss::IndexHNSW {
+        public:
+            // Take over the graph and storage of index, which is left empty and can be deleted
+            explicit IndexHNSWCompact(faiss::IndexHNSW *index);
+
+            IndexHNSWCompact(const IndexHNSWCompact &) = delete;
+            IndexHNSWCompact &operator=(const IndexHNSWCompact &) = delete;
+
+            void add(faiss::idx_t n, const float *x) override;
+
+            const CompactNeighborLists &neighborLists() const {
+                return compactNeighbors;
+            }
+
+        private:
+            CompactNeighborLists compactNeighbors;
+        };
+
+        // Binary counterpart of IndexHNSWCompact
+        class IndexBinaryHNSWCompact : public faiss::IndexBinaryHNSW {
+        public:
+            // Take over the graph and storage of index, which is left empty and can be deleted
+            explicit IndexBinaryHNSWCompact(faiss::IndexBinaryHNSW *index);
+
+            IndexBinaryHNSWCompact(const IndexBinaryHNSWCompact &) = delete;
+            IndexBinaryHNSWCompact &operator=(const IndexBinaryHNSWCompact &) = delete;
+
+            void add(faiss::idx_t n, const uint8_t *x) override;
+
+            const CompactNeighborLists &neighborLists() const {
+                return compactNeighbors;
+            }
+
+        private:
+            CompactNeighborLists compactNeighbors;
+        };
+
+        // Replace the HNSW index wrapped by idMap with a compact one. Returns false and leaves the index as it is when
+        // it is not an HNSW index of flat, SQ or PQ storage.
+        bool compactIndexIDMapHNSW(faiss::IndexIDMap *idMap);
+
+        // Replace the binary HNSW index wrapped by idMap with a compact one. Returns false and leaves the index as it
+        // is when it is not a binary HNSW index.
+        bool compactIndexBinaryIDMapHNSW(faiss::IndexBinaryIDMap *idMap);
+    }
+}
+
+#endif //OPENSEARCH_KNN_FAISS_HNSW_COMPACT_H
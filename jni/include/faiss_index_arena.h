@@ -0,0 +1,114 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_FAISS_INDEX_ARENA_H
+#define OPENSEARCH_KNN_FAISS_INDEX_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace knn_jni {
+    namespace memory {
+        struct IndexArenaStats {
+            // Bytes of address space backed by the arena, and how much of it live allocations hold
+            int64_t mappedBytes;
+            int64_t liveBytes;
+            int64_t liveAllocations;
+            // Chunks shared by small allocations, and mappings dedicated to a single large allocation
+            int64_t chunks;
+            int64_t largeAllocations;
+        };
+
+        /**
+         * Memory of a single loaded index. While an IndexArenaScope is active on a thread, the operator new of the
+         * faiss JNI library hands out arena memory instead of heap memory, so that the vectors faiss reads an index
+         * into all come from the arena. The arena is carved out of one address range reserved for all the arenas, so
+         * operator delete tells arena memory from heap memory by its address alone.
+         *
+         * Small allocations are packed into chunks and large ones get a mapping of their own, which is unmapped as soon
+         * as they are freed. Once the index is freed and the arena closed, all its chunks are unmapped at once instead of
+         * leaving holes in the heap.
+         *
+         * Arenas are only supported on Linux, by libraries built with KNN_INDEX_ARENAS. Memory handed out by the arena
+         * must only be freed through the operator delete of this library, which the build makes its own calls bind to.
+         */
+        class IndexArena {
+        public:
+            // Whether the library was built with arenas and runs on a platform supporting them
+            static bool isSupported();
+
+            // Return a new arena, or nullptr if arenas are not supported or no address space could be reserved
+            static IndexArena *create();
+
+            // Whether ptr was allocated from an arena
+            static bool owns(const void *ptr);
+
+            // Free ptr, which must have been allocated from an arena
+            static void deallocate(void *ptr);
+
+            void *allocate(size_t bytes, size_t alignment);
+
+            // Give the arena up once its index is freed. Its memory is unmapped right away if no allocation of it is
+            // left, and otherwise when its last allocation is freed. The arena must not be used afterwards.
+            void close();
+
+            IndexArenaStats getStats();
+
+        private:
+            struct Range {
+                uintptr_t start;
+                size_t bytes;
+            };
+
+            IndexArena() = default;
+
+            ~IndexArena();
+
+            void freeAllocation(void *ptr);
+
+            std::mutex lock;
+            std::vector<Range> chunks;
+            // Next free byte of the last chunk
+            uintptr_t chunkPosition = 0;
+            uintptr_t chunkEnd = 0;
+            size_t mappedBytes = 0;
+            size_t liveBytes = 0;
+            int64_t liveAllocations = 0;
+            int64_t largeAllocations = 0;
+            bool closed = false;
+        };
+
+        /**
+         * Routes the allocations made through operator new by the current thread to arena while in scope. Scopes nest,
+         * and a null arena routes allocations to the heap.
+         */
+        class IndexArenaScope {
+        public:
+            explicit IndexArenaScope(IndexArena *arena);
+
+            IndexArenaScope(const IndexArenaScope &) = delete;
+
+            IndexArenaScope &operator=(const IndexArenaScope &) = delete;
+
+            ~IndexArenaScope();
+
+            // Arena the allocations of the current thread are routed to, nullptr when they go to the heap
+            static IndexArena *current();
+
+        private:
+            IndexArena *previous;
+        };
+    }
+}
+
+#endif //OPENSEARCH_KNN_FAISS_INDEX_ARENA_H
@@ -0,0 +1,103 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+/**
+ * Framed compression of Faiss index files. This file is free of JNI to be used in faiss_wrapper.cpp.
+ *
+ * A compressed file starts with COMPRESSED_INDEX_MAGIC and the maximum uncompressed size of a frame, followed by frames
+ * each made of its uncompressed size, its compressed size and its zlib stream. A frame of uncompressed size 0 ends the
+ * file. Frames are independent from each other, so they are compressed and decompressed in batches across the OpenMP
+ * threads.
+ */
+
+#ifndef OPENSEARCH_KNN_FAISS_INDEX_COMPRESSION_H
+#define OPENSEARCH_KNN_FAISS_INDEX_COMPRESSION_H
+
+#include "faiss/impl/io.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace knn_jni {
+namespace stream {
+
+// "KNZ1" read as a faiss fourcc. No faiss index type has this fourcc, so compressed files are told apart by it
+constexpr uint32_t COMPRESSED_INDEX_MAGIC = 0x315a4e4b;
+
+bool isCompressedIndex(const uint8_t *data, size_t length);
+
+/**
+ * Decompress a whole compressed index held in memory, e.g. a mapped file. Bytes following the end frame are ignored.
+ */
+std::vector<uint8_t> decompressIndex(const uint8_t *data, size_t length);
+
+/**
+ * Splits the bytes written to it into frames, compresses them a batch at a time and hands the compressed bytes to the
+ * sink. finish() must be called once all the bytes are written.
+ */
+class IndexFrameCompressor {
+ public:
+  using Sink = std::function<void(const uint8_t *, size_t)>;
+
+  // level is a zlib compression level, from 1 (fastest) to 9 (smallest)
+  IndexFrameCompressor(Sink sink, int level);
+
+  void write(const uint8_t *source, size_t nbytes);
+
+  // Compress the pending bytes and write the end frame
+  void finish();
+
+ private:
+  void compressPending();
+
+  Sink sink;
+  int level;
+  bool started;
+  std::vector<uint8_t> pending;
+  std::vector<std::vector<uint8_t>> compressedFrames;
+};  // class IndexFrameCompressor
+
+/**
+ * Reads an index from the given source, decompressing it if it starts with COMPRESSED_INDEX_MAGIC. A batch of frames is
+ * read from the source, then decompressed concurrently. Bytes of uncompressed indexes are passed through unchanged.
+ */
+class FaissDecompressingIOReader final : public faiss::IOReader {
+ public:
+  explicit FaissDecompressingIOReader(faiss::IOReader *source);
+
+  size_t operator()(void *ptr, size_t size, size_t nitems) final;
+
+  int filedescriptor() final;
+
+ private:
+  bool readBatch();
+
+  void readSource(void *destination, size_t nbytes);
+
+  faiss::IOReader *source;
+  bool compressed;
+  uint32_t maxFrameSize;
+  // First bytes read from an uncompressed source, to be returned before the rest of the source
+  uint8_t prefix[sizeof(uint32_t)];
+  size_t prefixLength;
+  size_t prefixOffset;
+  std::vector<std::vector<uint8_t>> compressedFrames;
+  std::vector<uint8_t> batch;
+  size_t batchOffset;
+  bool ended;
+};  // class FaissDecompressingIOReader
+
+}
+}
+
+#endif //OPENSEARCH_KNN_FAISS_INDEX_COMPRESSION_H
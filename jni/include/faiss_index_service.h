@@ -20,7 +20,13 @@
 #include "jni_util.h"
 #include "faiss_methods.h"
 #include "faiss_stream_support.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace knn_jni {
 namespace faiss_wrapper {
@@ -69,6 +75,15 @@ public:
      */
     virtual void writeIndex(faiss::IOWriter* writer, jlong idMapAddress);
 
+    /**
+     * Renumber the nodes of an HNSW index in a locality preserving order before it is written, see
+     * faiss_util::reorderIndexIDMapHNSW. Other indexes are left as they are.
+     *
+     * @param idMapAddress memory address of the native index object
+     * @return true if the index was reordered
+     */
+    virtual bool reorderIndex(jlong idMapAddress);
+
     virtual ~IndexService() = default;
 
 protected:
@@ -132,6 +147,14 @@ public:
      */
     void writeIndex(faiss::IOWriter* writer, jlong idMapAddress) final;
 
+    /**
+     * Renumber the nodes of a binary HNSW index in a locality preserving order before it is written
+     *
+     * @param idMapAddress memory address of the native index object
+     * @return true if the index was reordered
+     */
+    bool reorderIndex(jlong idMapAddress) final;
+
 protected:
     void allocIndex(faiss::Index * index, size_t dim, size_t numVectors) final;
 };  // class BinaryIndexService
@@ -195,6 +218,70 @@ public:
     void allocIndex(faiss::Index * index, size_t dim, size_t numVectors) final;
 };  // class ByteIndexService
 
+/**
+ * Adds batches of vectors to an index on a background inserter thread, so that the caller can transfer the next batch
+ * while the previous one is being inserted.
+ * The caller must not reuse or free the memory of a submitted batch until it is known to be inserted. As batches are
+ * inserted in submission order, all batches but the last maxPendingBatches submitted are inserted once submit returns.
+ */
+class IngestionSession {
+public:
+    /**
+     * Start the inserter thread
+     *
+     * @param indexService index service inserting the batches, owned by the session
+     * @param idMapAddress memory address of the native index object
+     * @param dim dimension of vectors
+     * @param threadCount number of thread count to be used while adding data
+     * @param maxPendingBatches number of submitted batches that may wait for or be under insertion
+     */
+    IngestionSession(std::unique_ptr<IndexService> indexService, jlong idMapAddress, int dim, int threadCount,
+                     int maxPendingBatches);
+
+    /**
+     * Queue a batch of vectors for insertion. Blocks while maxPendingBatches batches are pending.
+     * Rethrows the failure of a previous batch, in which case no further batch is inserted.
+     *
+     * @param vectorsAddress memory address which is holding vector data
+     * @param ids ids of the vectors
+     */
+    void submit(int64_t vectorsAddress, std::vector<int64_t> ids);
+
+    /**
+     * Wait for all submitted batches to be inserted and stop the inserter thread.
+     * Rethrows the failure of a batch if any.
+     */
+    void finish();
+
+    ~IngestionSession();
+
+private:
+    struct Batch {
+        int64_t vectorsAddress;
+        std::vector<int64_t> ids;
+    };
+
+    void run();
+
+    void stop();
+
+    std::unique_ptr<IndexService> indexService;
+    jlong idMapAddress;
+    int dim;
+    int threadCount;
+    size_t maxPendingBatches;
+
+    std::mutex mutex;
+    std::condition_variable batchQueued;
+    std::condition_variable batchDone;
+    // The batch under insertion stays at the front until it is inserted
+    std::deque<Batch> pending;
+    bool finishing = false;
+    std::exception_ptr error;
+    // Declared last so that the thread starts once every other member is initialized
+    std::thread inserter;
+};  // class IngestionSession
+
 }
 }
 
@@ -13,6 +13,7 @@
 #define OPENSEARCH_KNN_JNI_FAISS_STREAM_SUPPORT_H
 
 #include "faiss/impl/io.h"
+#include "faiss_index_compression.h"
 #include "jni_util.h"
 #include "native_engines_stream_support.h"
 #include "parameter_utils.h"
@@ -20,7 +21,18 @@
 #include <jni.h>
 #include <stdexcept>
 #include <iostream>
+#include <algorithm>
 #include <cstring>
+#include <memory>
+#include <string>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace knn_jni {
 namespace stream {
@@ -33,7 +45,7 @@ namespace stream {
  */
 class FaissOpenSearchIOReader final : public faiss::IOReader {
  public:
-  explicit FaissOpenSearchIOReader(NativeEngineIndexInputMediator *_mediator)
+  explicit FaissOpenSearchIOReader(IndexInputMediator *_mediator)
       : faiss::IOReader(),
         mediator(knn_jni::util::ParameterCheck::require_non_null(_mediator, "mediator")) {
     name = "FaissOpenSearchIOReader";
@@ -53,26 +65,130 @@ class FaissOpenSearchIOReader final : public faiss::IOReader {
   }
 
  private:
-  NativeEngineIndexInputMediator *mediator;
+  IndexInputMediator *mediator;
 };  // class FaissOpenSearchIOReader
 
 
+#ifndef _WIN32
+/**
+ * IOReader serving reads from a read only memory mapping of a local index file. Compared to FaissOpenSearchIOReader,
+ * every read is a plain copy out of the page cache, without a JNI upcall and an intermediate buffer, and the kernel
+ * reads the file ahead while Faiss consumes it sequentially.
+ *
+ * Once the index is deserialized the file pages are not needed anymore, so they are dropped from the page cache on
+ * destruction instead of keeping the index in memory twice.
+ */
+class FaissMappedFileIOReader final : public faiss::IOReader {
+ public:
+  explicit FaissMappedFileIOReader(const std::string &path)
+      : faiss::IOReader(),
+        fd(-1),
+        mapping(nullptr),
+        length(0),
+        offset(0) {
+    name = path;
+    fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::runtime_error("Unable to open index file " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat fileStat {};
+    if (::fstat(fd, &fileStat) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::runtime_error("Unable to stat index file " + path + ": " + std::strerror(error));
+    }
+    length = static_cast<size_t>(fileStat.st_size);
+
+    if (length > 0) {
+      mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED) {
+        const int error = errno;
+        ::close(fd);
+        throw std::runtime_error("Unable to map index file " + path + ": " + std::strerror(error));
+      }
+      // Advisory only, loading still works if the kernel ignores them
+      ::madvise(mapping, length, MADV_SEQUENTIAL);
+      ::madvise(mapping, length, MADV_WILLNEED);
+    }
+  }
+
+  FaissMappedFileIOReader(const FaissMappedFileIOReader &) = delete;
+
+  FaissMappedFileIOReader &operator=(const FaissMappedFileIOReader &) = delete;
+
+  ~FaissMappedFileIOReader() override {
+    if (mapping != nullptr) {
+      ::munmap(mapping, length);
+    }
+#ifdef POSIX_FADV_DONTNEED
+    ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+    ::close(fd);
+  }
+
+  size_t operator()(void *ptr, size_t size, size_t nitems) final {
+    if (size == 0) {
+      return nitems;
+    }
+    // A short read is reported to Faiss, which fails the load on a truncated file
+    nitems = std::min(nitems, (length - offset) / size);
+    const auto readBytes = size * nitems;
+    if (readBytes > 0) {
+      std::memcpy(ptr, static_cast<const uint8_t *>(mapping) + offset, readBytes);
+      offset += readBytes;
+    }
+    return nitems;
+  }
+
+  int filedescriptor() final {
+    return fd;
+  }
+
+  // Whole file, for loaders reading sections at their positions instead of through operator()
+  const uint8_t *data() const {
+    return static_cast<const uint8_t *>(mapping);
+  }
+
+  size_t size() const {
+    return length;
+  }
+
+ private:
+  int fd;
+  void *mapping;
+  size_t length;
+  size_t offset;
+};  // class FaissMappedFileIOReader
+#endif
+
 /**
  * A glue component inheriting IOWriter to delegate IO processing down to the given
  * mediator. The mediator is expected to do write bytes via the provided Lucene's IndexOutput.
+ * With a compression level above 0, the bytes are compressed in frames on their way to the mediator, see
+ * faiss_index_compression.h.
  */
 class FaissOpenSearchIOWriter final : public faiss::IOWriter {
  public:
-  explicit FaissOpenSearchIOWriter(NativeEngineIndexOutputMediator *_mediator)
+  explicit FaissOpenSearchIOWriter(IndexOutputMediator *_mediator, int compressionLevel = 0)
       : faiss::IOWriter(),
-        mediator(knn_jni::util::ParameterCheck::require_non_null(_mediator, "mediator")) {
+        mediator(knn_jni::util::ParameterCheck::require_non_null(_mediator, "mediator")),
+        compressor() {
     name = "FaissOpenSearchIOWriter";
+    if (compressionLevel > 0) {
+      compressor = std::make_unique<IndexFrameCompressor>(
+          [this](const uint8_t *bytes, size_t nbytes) { mediator->writeBytes(bytes, nbytes); }, compressionLevel);
+    }
   }
 
   size_t operator()(const void *ptr, size_t size, size_t nitems) final {
     const auto writeBytes = size * nitems;
     if (writeBytes > 0) {
-      mediator->writeBytes(reinterpret_cast<const uint8_t *>(ptr), writeBytes);
+      if (compressor) {
+        compressor->write(reinterpret_cast<const uint8_t *>(ptr), writeBytes);
+      } else {
+        mediator->writeBytes(reinterpret_cast<const uint8_t *>(ptr), writeBytes);
+      }
     }
     return nitems;
   }
@@ -82,12 +198,18 @@ class FaissOpenSearchIOWriter final : public faiss::IOWriter {
     throw std::runtime_error("filedescriptor() is not supported in FaissOpenSearchIOWriter.");
   }
 
+  // Called once the whole index is written, as it ends the compressed frames
   void flush() {
+    if (compressor) {
+      compressor->finish();
+      compressor.reset();
+    }
     mediator->flush();
   }
 
  private:
-  NativeEngineIndexOutputMediator *mediator;
+  IndexOutputMediator *mediator;
+  std::unique_ptr<IndexFrameCompressor> compressor;
 };  // class FaissOpenSearchIOWriter
 
 
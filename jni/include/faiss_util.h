@@ -15,10 +15,72 @@
 #define OPENSEARCH_KNN_FAISS_UTIL_H
 
 #include "faiss/impl/IDGrouper.h"
+#include "faiss/Index.h"
+#include "faiss/IndexBinaryHNSW.h"
+#include "faiss/IndexHNSW.h"
+#include "faiss/IndexIDMap.h"
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace faiss_util {
     std::unique_ptr<faiss::IDGrouperBitmap> buildIDGrouperBitmap(int *parentIdsArray,  int parentIdsLength, std::vector<uint64_t>* bitmap);
+
+    // Widens the n int8 values at src to floats at dst. Large inputs are split across the OpenMP threads.
+    void convertInt8ToFloat(const int8_t *src, size_t n, float *dst);
+
+    // Encodes the n int8 values at src to codes of the 8bit_direct_signed scalar quantizer at dst. The quantizer
+    // stores each value shifted by 128 in an unsigned byte, so the codes are computed without going through floats.
+    void encodeInt8DirectSigned(const int8_t *src, size_t n, uint8_t *dst);
+
+    // Deserializes an IndexIDMap wrapping an IndexHNSWFlat from the length bytes at data, the layout written by
+    // faiss::write_index. The section headers are parsed first, then the graph, the vectors and the id map are copied
+    // concurrently from their positions in data. Bytes following the index are ignored. Returns nullptr, without allocating the index, if the bytes hold any
+    // other index type, so that the caller can fall back to faiss::read_index.
+    faiss::Index *readIndexIDMapHNSWFlat(const uint8_t *data, size_t length);
+
+    // Order of the nodes of an HNSW graph in which searches mostly walk through nearby memory: breadth first over
+    // level 0 from the entry point, in the order of the neighbor lists, which faiss keeps closest first. Nodes the entry
+    // point does not reach follow, breadth first from each of them. order[i] is the current id of the node numbered i.
+    std::vector<faiss::idx_t> computeHNSWLocalityOrder(const faiss::HNSW &hnsw);
+
+    // Renumber the nodes of hnsw by order, as returned by computeHNSWLocalityOrder. The levels, neighbor lists and
+    // entry point are moved and remapped so that the graph stays the same.
+    void permuteHNSW(faiss::HNSW *hnsw, const std::vector<faiss::idx_t> &order);
+
+    // Renumber the nodes of the HNSW index under idMap in the locality order of its graph, moving the codes of its
+    // storage and the labels of idMap along, so that searches return the same labels. The index is still written and
+    // read by faiss as before, but the labels of idMap are no longer in ascending order. Returns false, leaving the
+    // index as it is, if idMap does not wrap an HNSW index whose storage is a flat array of codes.
+    bool reorderIndexIDMapHNSW(faiss::IndexIDMap *idMap);
+
+    // Same as reorderIndexIDMapHNSW for binary HNSW indexes over an IndexBinaryFlat storage
+    bool reorderIndexBinaryIDMapHNSW(faiss::IndexBinaryIDMap *idMap);
+
+    // Memory of an index structure, such as the neighbor lists of a graph or the codes of the vectors
+    struct MemoryRegion {
+        const void *data;
+        size_t bytes;
+    };
+
+    // Brings the regions into memory ahead of the queries reading them. The kernel is advised that their pages will be
+    // needed and, if touch is true, one byte of every page is also read across the OpenMP threads. Returns the number
+    // of bytes of the regions.
+    size_t warmMemoryRegions(const std::vector<MemoryRegion> &regions, bool touch);
+
+    // Number of NUMA nodes of the host. 1 when the host has a single node or when it cannot be told, e.g. outside Linux.
+    int getNumaNodeCount();
+
+    // Moves the pages of the regions to the NUMA node node, or interleaves them across all the nodes if node is -1, and
+    // keeps them there. Only regions of at least 1MB are placed, and only the pages they fully cover, so that smaller
+    // allocations sharing their pages are left alone. Returns false, leaving the pages where they are, on single node
+    // hosts or when the kernel does not support memory policies.
+    bool placeMemoryRegions(const std::vector<MemoryRegion> &regions, int node);
+
+    // Drops the memory policy placeMemoryRegions gave the pages of the regions, so that the allocations reusing them
+    // once they are freed are placed as usual. Returns false when the kernel does not support memory policies.
+    bool resetMemoryRegions(const std::vector<MemoryRegion> &regions);
 };
 
 
@@ -13,18 +13,104 @@
 #define OPENSEARCH_KNN_FAISS_WRAPPER_H
 
 #include "jni_util.h"
+#include "faiss_hnsw_compact.h"
+#include "faiss_index_arena.h"
 #include "faiss_index_service.h"
 #include "faiss_stream_support.h"
+#include "faiss/IndexBinaryFlat.h"
+#include "faiss/IndexBinaryHNSW.h"
+#include "faiss/IndexBinaryIVF.h"
+#include "faiss/IndexHNSW.h"
+#include "faiss/IndexIDMap.h"
+#include "faiss/IndexIVF.h"
+#include <atomic>
 #include <jni.h>
 
 namespace knn_jni {
     namespace faiss_wrapper {
+        // Search algorithm of a loaded index, which decides the type of search parameters it takes
+        enum class IndexKind {
+            HNSW,
+            IVF,
+            OTHER
+        };
+
+        // Handle of a loaded index, which is the pointer handed to Java by the load functions and taken back by the
+        // query and free functions. Everything queries need to know about the index is resolved once here at load
+        // time, so that the query path does not probe the index with dynamic_cast.
+        //
+        // The handle does not own the index. Free deletes both the index and the handle.
+        struct NativeIndexHandle {
+            explicit NativeIndexHandle(faiss::Index * index);
+            explicit NativeIndexHandle(faiss::IndexBinary * binaryIndex);
+
+            // Exactly one of index and binaryIndex is set
+            faiss::Index * index = nullptr;
+            faiss::IndexBinary * binaryIndex = nullptr;
+            bool isBinary = false;
+
+            IndexKind kind = IndexKind::OTHER;
+            int dimension = 0;
+            faiss::MetricType metric = faiss::METRIC_L2;
+
+            // Id map at the top of the index and the index it wraps, set when the index has that layout
+            faiss::IndexIDMap * idMap = nullptr;
+            faiss::IndexBinaryIDMap * binaryIdMap = nullptr;
+            faiss::IndexHNSW * hnsw = nullptr;
+            faiss::IndexIVF * ivf = nullptr;
+            faiss::IndexBinaryHNSW * binaryHnsw = nullptr;
+            faiss::IndexBinaryIVF * binaryIvf = nullptr;
+            faiss::IndexBinaryFlat * binaryFlat = nullptr;
+
+            // Whether the labels of idMap are in ascending order, so that a label is mapped back to its internal id
+            // by binary search
+            bool idMapSorted = false;
+
+            // Internal ids of idMap in the ascending order of their labels, set when the labels are not sorted, e.g.
+            // for graphs reordered for locality, so that labels are still mapped back by binary search
+            std::vector<faiss::idx_t> labelOrder;
+
+            // Query time parameters the index was built with, used when a query does not override them
+            int defaultEfSearch = 0;
+            size_t defaultNprobe = 0;
+
+            // Number of query vectors searched against the index
+            std::atomic<int64_t> queryCount {0};
+
+            // NUMA node the memory of the index was bound to by PlaceIndex, -1 when it was not bound to a single node
+            int numaNode = -1;
+
+            // Whether PlaceIndex gave the memory of the index a NUMA policy, which Free drops before deleting it
+            bool numaPlaced = false;
+
+            // Arena the index was read into, closed by Free once the index is deleted. nullptr when the index lives
+            // on the heap.
+            knn_jni::memory::IndexArena * arena = nullptr;
+        };
+
         jlong InitIndex(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong numDocs, jint dimJ, jobject parametersJ, IndexService *indexService);
 
         void InsertToIndex(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jintArray idsJ, jlong vectorsAddressJ, jint dimJ, jlong indexAddr, jint threadCount, IndexService *indexService);
 
         void WriteIndex(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jobject output, jlong indexAddr, IndexService *indexService);
 
+        // Start an ingestion session adding the vectors submitted to it to the index at indexAddr on a background
+        // thread, with indexService. At most maxPendingBatchesJ submitted batches wait for or are under insertion.
+        //
+        // Return the address of the session
+        jlong StartIngestion(jlong indexAddr, jint dimJ, jint threadCount, jint maxPendingBatchesJ,
+                             std::unique_ptr<IndexService> indexService);
+
+        // Queue the vectors at vectorsAddressJ with ids idsJ for insertion by the session at sessionAddr. Blocks until
+        // the session has room for the batch. The vectors must be kept until all batches but the last
+        // maxPendingBatchesJ submitted are inserted, which is the case once a later submit returns.
+        void SubmitToIngestion(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong sessionAddr, jintArray idsJ,
+                               jlong vectorsAddressJ);
+
+        // Wait for the session at sessionAddr to insert all submitted batches and free it. The failure of any batch
+        // is rethrown here if it was not already by SubmitToIngestion.
+        void FinishIngestion(jlong sessionAddr);
+
         // Create an index with ids and vectors. Instead of creating a new index, this function creates the index
         // based off of the template index passed in. The index is serialized to indexPathJ.
         void CreateIndexFromTemplate(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
@@ -43,24 +129,24 @@ namespace knn_jni {
                                          jlong vectorsAddressJ, jint dimJ, jobject output, jbyteArray templateIndexJ,
                                          jobject parametersJ);
 
-        // Load an index from indexPathJ into memory.
+        // Load an index from indexPathJ into memory. The file is read through a memory mapping where supported.
         //
-        // Return a pointer to the loaded index
+        // Return a pointer to the NativeIndexHandle of the loaded index
         jlong LoadIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jstring indexPathJ);
 
         // Loads an index with a reader implemented IOReader
         //
-        // Returns a pointer of the loaded index
+        // Returns a pointer to the NativeIndexHandle of the loaded index
         jlong LoadIndexWithStream(faiss::IOReader* ioReader);
 
-        // Load a binary index from indexPathJ into memory.
+        // Load a binary index from indexPathJ into memory. The file is read through a memory mapping where supported.
         //
-        // Return a pointer to the loaded index
+        // Return a pointer to the NativeIndexHandle of the loaded index
         jlong LoadBinaryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jstring indexPathJ);
 
         // Loads a binary index with a reader implemented IOReader
         //
-        // Returns a pointer of the loaded index
+        // Returns a pointer to the NativeIndexHandle of the loaded index
         jlong LoadBinaryIndexWithStream(faiss::IOReader* ioReader);
 
         // Check if a loaded index requires shared state
@@ -98,13 +184,153 @@ namespace knn_jni {
                                            jfloatArray queryVectorJ, jint kJ, jobject methodParamsJ, jlongArray filterIdsJ,
                                            jint filterIdsTypeJ, jintArray parentIdsJ);
 
+        // Same as QueryIndex_WithFilter, but the method parameters are read from searchParamsJ, the address returned
+        // by knn_jni::commons::createSearchParams, instead of a Java map. An address of 0 uses the index defaults.
+        // The filter ids are read in place from filterBufferJ, a direct ByteBuffer holding native order longs, instead
+        // of being copied out of a Java long[]. The caller owns the buffer and may reuse it across queries and
+        // segments. A null buffer means no filter. The ids and distances of the results are written to the caller
+        // provided resultIdsJ and resultDistancesJ, which must hold at least k entries, instead of allocating
+        // KNNQueryResults.
+        //
+        // Return the number of results written
+        jint QueryIndex_WithFilterBuffer(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                         jfloatArray queryVectorJ, jint kJ, jlong searchParamsJ, jobject filterBufferJ,
+                                         jint filterIdsTypeJ, jintArray parentIdsJ, jintArray resultIdsJ,
+                                         jfloatArray resultDistancesJ);
+
         // Execute a query against the binary index located in memory at indexPointerJ along with Filters
         //
         // Return an array of KNNQueryResults
         jobjectArray QueryBinaryIndex_WithFilter(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
                                                  jbyteArray queryVectorJ, jint kJ, jobject methodParamsJ, jlongArray filterIdsJ, jint filterIdsTypeJ, jintArray parentIdsJ);
 
-        // Free the index located in memory at indexPointerJ
+        // Same as QueryIndex_WithFilterBuffer, for the binary index located in memory at indexPointerJ
+        //
+        // Return the number of results written
+        jint QueryBinaryIndex_WithFilterBuffer(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                               jbyteArray queryVectorJ, jint kJ, jlong searchParamsJ,
+                                               jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ,
+                                               jintArray resultIdsJ, jfloatArray resultDistancesJ);
+
+        // Execute numQueriesJ queries, stored row-major in queryVectorsJ, against the index located in memory at
+        // indexPointerJ with a single search call. k, the search parameters created by commons::createSearchParams,
+        // the filter read in place from the direct ByteBuffer filterBufferJ and the parent ids are shared by all
+        // queries.
+        //
+        // The k nearest ids and distances of query i are written to [i * k, (i + 1) * k) of resultIdsJ and
+        // resultDistancesJ. When a query has fewer than k results, the remaining slots are padded with id -1.
+        void QueryIndexBatch(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                             jfloatArray queryVectorsJ, jint numQueriesJ, jint kJ, jlong searchParamsJ,
+                             jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ,
+                             jintArray resultIdsJ, jfloatArray resultDistancesJ);
+
+        // Same as QueryIndexBatch, except that the queries are signed byte vectors. They are widened to float
+        // natively before searching, so callers do not need to materialize a float copy.
+        void QueryByteIndexBatch(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                 jbyteArray queryVectorsJ, jint numQueriesJ, jint kJ, jlong searchParamsJ,
+                                 jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ,
+                                 jintArray resultIdsJ, jfloatArray resultDistancesJ);
+
+        // Same as QueryIndexBatch for the binary index located in memory at indexPointerJ. Each query is
+        // dimension / 8 bytes long and the hamming distances are returned as floats.
+        void QueryBinaryIndexBatch(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                   jbyteArray queryVectorsJ, jint numQueriesJ, jint kJ, jlong searchParamsJ,
+                                   jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ,
+                                   jintArray resultIdsJ, jfloatArray resultDistancesJ);
+
+        // Execute an exact search of the k nearest neighbors of queryVectorJ among the vectors of the index located in
+        // memory at indexPointerJ that pass the filter, or among all its vectors if filterIdsJ is null. The vectors
+        // are scored straight from the index storage, decoding quantized codes as needed, instead of being read back
+        // from the segment. Only float indices whose vectors can be scored by internal id, such as HNSW and flat
+        // indices, are supported.
+        //
+        // The ids and distances of the results are written to resultIdsJ and resultDistancesJ, which must hold at
+        // least k entries, closest first.
+        //
+        // Return the number of results written
+        jint ExactSearch_WithFilter(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                    jfloatArray queryVectorJ, jint kJ, jlongArray filterIdsJ, jint filterIdsTypeJ,
+                                    jintArray resultIdsJ, jfloatArray resultDistancesJ);
+
+        // Radius counterpart of ExactSearch_WithFilter. Vectors within radiusJ of the query, following the range
+        // search semantics of the index metric, are written closest first, capped at maxResultWindowJ.
+        //
+        // Return the number of results written
+        jint ExactRangeSearch_WithFilter(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                         jfloatArray queryVectorJ, jfloat radiusJ, jint maxResultWindowJ,
+                                         jlongArray filterIdsJ, jint filterIdsTypeJ, jintArray resultIdsJ,
+                                         jfloatArray resultDistancesJ);
+
+        // How WarmIndex brings a loaded index into memory. The values are shared with NativeIndexWarmupMode in Java
+        enum class WarmupMode {
+            // Advise the kernel that the pages of the index will be needed, without waiting for them
+            ADVISE = 0,
+            // ADVISE, then read every page of the graph, the vectors and the id map
+            TOUCH = 1,
+            // TOUCH, then run a few queries made of indexed vectors to pull in the path from the entry point
+            QUERY = 2
+        };
+
+        struct WarmupStats {
+            // Bytes of the index structures that were advised or touched
+            int64_t bytes = 0;
+            int64_t elapsedNanos = 0;
+        };
+
+        // Warm up the index located in memory at indexPointerJ, so that the first queries against it do not pay the
+        // page faults and cache misses of a cold index. Graph and flat storage of HNSW indices and inverted lists of
+        // IVF indices are warmed up, other structures are left as they are.
+        WarmupStats WarmIndex(jlong indexPointerJ, WarmupMode mode);
+
+        // Bytes held by the structures of a loaded index, by component. Vectors are counted by capacity, as that is what
+        // they hold on to.
+        struct IndexMemoryUsage {
+            // Vector codes of flat storages and inverted lists
+            int64_t codes = 0;
+            // HNSW graph: neighbor lists, level of every vector and offset of its neighbors
+            int64_t neighbors = 0;
+            int64_t levels = 0;
+            int64_t offsets = 0;
+            // Labels of id maps and ids of inverted lists
+            int64_t idMap = 0;
+            // Coarse quantizer of IVF indices, codebooks and tables of PQ and SQ encoders
+            int64_t quantizer = 0;
+            // Precomputed table set with SetSharedIndexState. It is shared by all the indices of a model, so it is not
+            // part of the memory of a single index
+            int64_t sharedState = 0;
+            // Index handle, tables of the inverted lists and small HNSW tables
+            int64_t other = 0;
+        };
+
+        // Walk the index located in memory at indexPointerJ and count the bytes of its structures
+        IndexMemoryUsage GetIndexMemoryUsage(jlong indexPointerJ);
+
+        // Place the memory of the index located at indexPointerJ on the NUMA node nodeJ, or interleave it across all
+        // the nodes if nodeJ is -1. Nothing is moved on single node hosts or when the kernel does not support memory
+        // policies. Returns the node the index is bound to afterwards, -1 when it is not bound to a single node.
+        jint PlaceIndex(jlong indexPointerJ, jint nodeJ);
+
+        // Returns the node the memory of the index located at indexPointerJ was bound to by PlaceIndex, -1 if none
+        jint GetIndexNumaNode(jlong indexPointerJ);
+
+        // Returns the number of NUMA nodes of the host, 1 when it has a single node or when it cannot be told
+        jint GetNumaNodeCount();
+
+        // Whether the indexes loaded from now on are read into an arena of their own, so that freeing an index
+        // unmaps all of its memory at once instead of returning it to the heap piece by piece. Indexes are loaded on
+        // the heap when arenas are not supported. Returns whether the indexes loaded from now on use arenas, false when
+        // they are enabled but the library was built without KNN_INDEX_ARENAS.
+        bool ConfigureIndexArenas(bool enabled);
+
+        // Returns the statistics of the arena of the index located at indexPointerJ, all zeros if it has none
+        knn_jni::memory::IndexArenaStats GetIndexArenaStats(jlong indexPointerJ);
+
+        // Whether the HNSW graphs of the indexes loaded from now on are converted to compact neighbor lists, which
+        // are decoded as the graph is searched. Only HNSW indexes wrapped in an id map are converted.
+        void ConfigureCompactGraphs(bool enabled);
+
+        // Free the index located in memory at indexPointerJ along with its NativeIndexHandle. Whether the index is
+        // binary is read from the handle, isBinaryIndexJ is only kept for compatibility of the Java API.
         void Free(jlong indexPointer, jboolean isBinaryIndexJ);
 
         // Free shared index state in memory at shareIndexStatePointerJ
@@ -151,6 +377,28 @@ namespace knn_jni {
         jobjectArray RangeSearchWithFilter(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong indexPointerJ, jfloatArray queryVectorJ,
                                            jfloat radiusJ, jobject methodParamsJ, jint maxResultWindowJ, jlongArray filterIdsJ, jint filterIdsTypeJ, jintArray parentIdsJ);
 
+        // Same as RangeSearchWithFilter, but the method parameters are read from searchParamsJ and the filter ids are
+        // read in place from the direct ByteBuffer filterBufferJ, as in QueryIndex_WithFilterBuffer. The results are
+        // written to the caller provided resultIdsJ and resultDistancesJ, which must hold at least maxResultWindowJ
+        // entries.
+        //
+        // Return the number of results written
+        jint RangeSearch_WithFilterBuffer(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong indexPointerJ,
+                                          jfloatArray queryVectorJ, jfloat radiusJ, jlong searchParamsJ,
+                                          jint maxResultWindowJ, jobject filterBufferJ, jint filterIdsTypeJ,
+                                          jintArray parentIdsJ, jintArray resultIdsJ, jfloatArray resultDistancesJ);
+
+        // Binary counterpart of RangeSearch_WithFilterBuffer. The hits are the vectors whose Hamming distance to the
+        // query is at most radiusJ, closest first. A radius at or above the dimension takes every vector, so that the
+        // results are the maxResultWindowJ closest ones.
+        //
+        // Return the number of results written
+        jint RangeSearchBinaryIndex_WithFilterBuffer(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong indexPointerJ,
+                                                     jbyteArray queryVectorJ, jfloat radiusJ, jlong searchParamsJ,
+                                                     jint maxResultWindowJ, jobject filterBufferJ, jint filterIdsTypeJ,
+                                                     jintArray parentIdsJ, jintArray resultIdsJ,
+                                                     jfloatArray resultDistancesJ);
+
         /*
          * Perform a range search against the index located in memory at indexPointerJ.
          *
@@ -20,6 +20,8 @@
 #include <cstdint>
 #include <functional>
 
+#include "vector_buffer_pool.h"
+
 namespace knn_jni {
 
     // Interface for making calls to JNI
@@ -70,11 +72,11 @@ namespace knn_jni {
                                                                             int dim) = 0;
 
         virtual void Convert2dJavaObjectArrayAndStoreToFloatVector(JNIEnv *env, jobjectArray array2dJ,
-                                                                   int dim, std::vector<float> *vect ) = 0;
+                                                                   int dim, knn_jni::memory::VectorBuffer<float> *vect ) = 0;
         virtual void Convert2dJavaObjectArrayAndStoreToBinaryVector(JNIEnv *env, jobjectArray array2dJ,
-                                                                   int dim, std::vector<uint8_t> *vect ) = 0;
+                                                                   int dim, knn_jni::memory::VectorBuffer<uint8_t> *vect ) = 0;
         virtual void Convert2dJavaObjectArrayAndStoreToByteVector(JNIEnv *env, jobjectArray array2dJ,
-                                                                           int dim, std::vector<int8_t> *vect ) = 0;
+                                                                           int dim, knn_jni::memory::VectorBuffer<int8_t> *vect ) = 0;
 
         virtual std::vector<int64_t> ConvertJavaIntArrayToCppIntVector(JNIEnv *env, jintArray arrayJ) = 0;
 
@@ -115,6 +117,8 @@ namespace knn_jni {
 
         virtual jbyteArray NewByteArray(JNIEnv *env, jsize len) = 0;
 
+        virtual jlongArray NewLongArray(JNIEnv *env, jsize len) = 0;
+
         virtual void ReleaseByteArrayElements(JNIEnv *env, jbyteArray array, jbyte *elems, int mode) = 0;
 
         virtual void ReleaseFloatArrayElements(JNIEnv *env, jfloatArray array, jfloat *elems, int mode) = 0;
@@ -127,6 +131,12 @@ namespace knn_jni {
 
         virtual void SetByteArrayRegion(JNIEnv *env, jbyteArray array, jsize start, jsize len, const jbyte * buf) = 0;
 
+        virtual void SetIntArrayRegion(JNIEnv *env, jintArray array, jsize start, jsize len, const jint * buf) = 0;
+
+        virtual void SetLongArrayRegion(JNIEnv *env, jlongArray array, jsize start, jsize len, const jlong * buf) = 0;
+
+        virtual void SetFloatArrayRegion(JNIEnv *env, jfloatArray array, jsize start, jsize len, const jfloat * buf) = 0;
+
         virtual jobject GetObjectField(JNIEnv * env, jobject obj, jfieldID fieldID) = 0;
 
         virtual jclass FindClassFromJNIEnv(JNIEnv * env, const char *name) = 0;
@@ -139,6 +149,10 @@ namespace knn_jni {
 
         virtual void ReleasePrimitiveArrayCritical(JNIEnv * env, jarray array, void *carray, jint mode) = 0;
 
+        virtual void * GetDirectBufferAddress(JNIEnv * env, jobject buf) = 0;
+
+        virtual jlong GetDirectBufferCapacity(JNIEnv * env, jobject buf) = 0;
+
         virtual jint CallNonvirtualIntMethodA(JNIEnv *env, jobject obj, jclass clazz,
                                               jmethodID methodID, jvalue *args) = 0;
 
@@ -189,15 +203,19 @@ namespace knn_jni {
         jobject NewObject(JNIEnv *env, jclass clazz, jmethodID methodId, int id, float distance) final;
         jobjectArray NewObjectArray(JNIEnv *env, jsize len, jclass clazz, jobject init) final;
         jbyteArray NewByteArray(JNIEnv *env, jsize len) final;
+        jlongArray NewLongArray(JNIEnv *env, jsize len) final;
         void ReleaseByteArrayElements(JNIEnv *env, jbyteArray array, jbyte *elems, int mode) final;
         void ReleaseFloatArrayElements(JNIEnv *env, jfloatArray array, jfloat *elems, int mode) final;
         void ReleaseIntArrayElements(JNIEnv *env, jintArray array, jint *elems, jint mode) final;
         void ReleaseLongArrayElements(JNIEnv *env, jlongArray array, jlong *elems, jint mode) final;
         void SetObjectArrayElement(JNIEnv *env, jobjectArray array, jsize index, jobject val) final;
         void SetByteArrayRegion(JNIEnv *env, jbyteArray array, jsize start, jsize len, const jbyte * buf) final;
-        void Convert2dJavaObjectArrayAndStoreToFloatVector(JNIEnv *env, jobjectArray array2dJ, int dim, std::vector<float> *vect) final;
-        void Convert2dJavaObjectArrayAndStoreToBinaryVector(JNIEnv *env, jobjectArray array2dJ, int dim, std::vector<uint8_t> *vect) final;
-        void Convert2dJavaObjectArrayAndStoreToByteVector(JNIEnv *env, jobjectArray array2dJ, int dim, std::vector<int8_t> *vect) final;
+        void SetIntArrayRegion(JNIEnv *env, jintArray array, jsize start, jsize len, const jint * buf) final;
+        void SetLongArrayRegion(JNIEnv *env, jlongArray array, jsize start, jsize len, const jlong * buf) final;
+        void SetFloatArrayRegion(JNIEnv *env, jfloatArray array, jsize start, jsize len, const jfloat * buf) final;
+        void Convert2dJavaObjectArrayAndStoreToFloatVector(JNIEnv *env, jobjectArray array2dJ, int dim, knn_jni::memory::VectorBuffer<float> *vect) final;
+        void Convert2dJavaObjectArrayAndStoreToBinaryVector(JNIEnv *env, jobjectArray array2dJ, int dim, knn_jni::memory::VectorBuffer<uint8_t> *vect) final;
+        void Convert2dJavaObjectArrayAndStoreToByteVector(JNIEnv *env, jobjectArray array2dJ, int dim, knn_jni::memory::VectorBuffer<int8_t> *vect) final;
         jobject GetObjectField(JNIEnv * env, jobject obj, jfieldID fieldID) final;
         jclass FindClassFromJNIEnv(JNIEnv * env, const char *name) final;
         jmethodID GetMethodID(JNIEnv * env, jclass clazz, const char *name, const char *sig) final;
@@ -207,6 +225,8 @@ namespace knn_jni {
         void CallNonvirtualVoidMethodA(JNIEnv * env, jobject obj, jclass clazz, jmethodID methodID, jvalue* args) final;
         void * GetPrimitiveArrayCritical(JNIEnv * env, jarray array, jboolean *isCopy) final;
         void ReleasePrimitiveArrayCritical(JNIEnv * env, jarray array, void *carray, jint mode) final;
+        void * GetDirectBufferAddress(JNIEnv * env, jobject buf) final;
+        jlong GetDirectBufferCapacity(JNIEnv * env, jobject buf) final;
 
     private:
         std::unordered_map<std::string, jclass> cachedClasses;
@@ -15,19 +15,58 @@
 #include "jni_util.h"
 #include "parameter_utils.h"
 #include "memory_util.h"
+#include "checksum_util.h"
 
 #include <jni.h>
+#include <algorithm>
 #include <stdexcept>
 #include <iostream>
 #include <cstring>
+#include <cerrno>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace knn_jni {
 namespace stream {
 
+/**
+ * Source of the bytes of an index being loaded, read from a Java IndexInputWithBuffer.
+ */
+class IndexInputMediator {
+ public:
+  virtual ~IndexInputMediator() = default;
+
+  virtual void copyBytes(int64_t nbytes, uint8_t * RESTRICT destination) = 0;
+
+  virtual int64_t remainingBytes() = 0;
+};  // class IndexInputMediator
+
+
+
+/**
+ * Sink of the bytes of an index being written, delegating to a Java IndexOutputWithBuffer.
+ */
+class IndexOutputMediator {
+ public:
+  virtual ~IndexOutputMediator() = default;
+
+  virtual void writeBytes(const uint8_t * RESTRICT source, size_t nbytes) = 0;
+
+  virtual void flush() = 0;
+};  // class IndexOutputMediator
+
+
+
 /**
  * This class contains Java IndexInputWithBuffer reference and calls its API to copy required bytes into a read buffer.
  */
-class NativeEngineIndexInputMediator {
+class NativeEngineIndexInputMediator final : public IndexInputMediator {
  public:
   // Expect IndexInputWithBuffer is given as `_indexInput`.
   NativeEngineIndexInputMediator(JNIUtilInterface *_jni_interface,
@@ -44,7 +83,7 @@ class NativeEngineIndexInputMediator {
         remainingBytesMethod(getRemainingBytesMethod(_jni_interface, _env)) {
   }
 
-  void copyBytes(int64_t nbytes, uint8_t * RESTRICT destination) {
+  void copyBytes(int64_t nbytes, uint8_t * RESTRICT destination) final {
     auto jclazz = getIndexInputWithBufferClass(jni_interface, env);
 
     while (nbytes > 0) {
@@ -77,7 +116,7 @@ class NativeEngineIndexInputMediator {
     }  // End while
   }
 
-  int64_t remainingBytes() {
+  int64_t remainingBytes() final {
     auto bytes = jni_interface->CallNonvirtualLongMethodA(env,
                                                           indexInput,
                                                           getIndexInputWithBufferClass(jni_interface, env),
@@ -124,12 +163,122 @@ class NativeEngineIndexInputMediator {
 
 
 
+
+/**
+ * Reads from the direct read-ahead buffer of IndexInputWithBuffer. The buffer is split in two chunks: native code copies
+ * from one chunk in place, without critical sections, while the Java side reads the next chunk ahead into the other one.
+ * A JNI upcall is only made once a whole chunk has been consumed.
+ */
+class NativeEngineDirectIndexInputMediator final : public IndexInputMediator {
+ public:
+  // Expect IndexInputWithBuffer is given as `_indexInput`, and its read-ahead buffer as `_readAheadBuffer`.
+  NativeEngineDirectIndexInputMediator(JNIUtilInterface *_jni_interface,
+                                       JNIEnv *_env,
+                                       jobject _indexInput,
+                                       jobject _readAheadBuffer)
+      : jni_interface(knn_jni::util::ParameterCheck::require_non_null(_jni_interface, "jni_interface")),
+        env(knn_jni::util::ParameterCheck::require_non_null(_env, "env")),
+        indexInput(knn_jni::util::ParameterCheck::require_non_null(_indexInput, "indexInput")),
+        chunks(reinterpret_cast<uint8_t *>(knn_jni::util::ParameterCheck::require_non_null(
+            _jni_interface->GetDirectBufferAddress(_env, _readAheadBuffer), "readAheadBuffer"))),
+        chunkCapacity(_jni_interface->GetDirectBufferCapacity(_env, _readAheadBuffer) / 2),
+        nextChunkMethod(getNextChunkMethod(_jni_interface, _env)),
+        totalBytes(fetchRemainingBytes()),
+        readBytes(),
+        chunkIndex(-1),
+        chunkLength(),
+        chunkOffset() {
+  }
+
+  void copyBytes(int64_t nbytes, uint8_t * RESTRICT destination) final {
+    while (nbytes > 0) {
+      if (chunkOffset == chunkLength) {
+        nextChunk();
+      }
+
+      const auto copyBytes = std::min(nbytes, chunkLength - chunkOffset);
+      std::memcpy(destination, chunks + (chunkIndex & 1) * chunkCapacity + chunkOffset, copyBytes);
+
+      chunkOffset += copyBytes;
+      readBytes += copyBytes;
+      destination += copyBytes;
+      nbytes -= copyBytes;
+    }  // End while
+  }
+
+  int64_t remainingBytes() final {
+    return totalBytes - readBytes;
+  }
+
+ private:
+  static jclass getIndexInputWithBufferClass(JNIUtilInterface *jni_interface, JNIEnv *env) {
+    static jclass INDEX_INPUT_WITH_BUFFER_CLASS =
+        jni_interface->FindClassFromJNIEnv(env, "org/opensearch/knn/index/store/IndexInputWithBuffer");
+    return INDEX_INPUT_WITH_BUFFER_CLASS;
+  }
+
+  static jmethodID getNextChunkMethod(JNIUtilInterface *jni_interface, JNIEnv *env) {
+    static jmethodID NEXT_CHUNK_METHOD_ID =
+        jni_interface->GetMethodID(env, getIndexInputWithBufferClass(jni_interface, env), "nextChunk", "()I");
+    return NEXT_CHUNK_METHOD_ID;
+  }
+
+  static jmethodID getRemainingBytesMethod(JNIUtilInterface *jni_interface, JNIEnv *env) {
+    static jmethodID REMAINING_BYTES_METHOD_ID =
+        jni_interface->GetMethodID(env, getIndexInputWithBufferClass(jni_interface, env), "remainingBytes", "()J");
+    return REMAINING_BYTES_METHOD_ID;
+  }
+
+  // Only called before the first chunk is requested, the Java side is reading ahead afterwards.
+  int64_t fetchRemainingBytes() {
+    auto bytes = jni_interface->CallNonvirtualLongMethodA(env,
+                                                          indexInput,
+                                                          getIndexInputWithBufferClass(jni_interface, env),
+                                                          getRemainingBytesMethod(jni_interface, env),
+                                                          nullptr);
+    jni_interface->HasExceptionInStack(env, "Checking remaining bytes has failed.");
+    return bytes;
+  }
+
+  void nextChunk() {
+    // The chunk we are done with is handed back here, and is the one the Java side reads ahead into next.
+    const auto length = jni_interface->CallNonvirtualIntMethodA(env,
+                                                                indexInput,
+                                                                getIndexInputWithBufferClass(jni_interface, env),
+                                                                nextChunkMethod,
+                                                                nullptr);
+    jni_interface->HasExceptionInStack(env, "Reading bytes via IndexInput has failed.");
+    if (length <= 0) {
+      throw std::runtime_error("Reading bytes via IndexInput has failed. Reached the end of the index.");
+    }
+    chunkIndex++;
+    chunkLength = length;
+    chunkOffset = 0;
+  }
+
+  JNIUtilInterface *jni_interface;
+  JNIEnv *env;
+
+  // `IndexInputWithBuffer` instance having `IndexInput` instance obtained from `Directory` for reading.
+  jobject indexInput;
+  uint8_t *chunks;
+  int64_t chunkCapacity;
+  jmethodID nextChunkMethod;
+  int64_t totalBytes;
+  int64_t readBytes;
+  int64_t chunkIndex;
+  int64_t chunkLength;
+  int64_t chunkOffset;
+};  // class NativeEngineDirectIndexInputMediator
+
+
+
 /**
  * This class delegates the provided index output to do IO processing.
  * In most cases, it is expected that IndexOutputWithBuffer was passed down to this,
  * which eventually have Lucene's IndexOutput to write bytes.
  */
-class NativeEngineIndexOutputMediator {
+class NativeEngineIndexOutputMediator final : public IndexOutputMediator {
  public:
   NativeEngineIndexOutputMediator(JNIUtilInterface *_jni_interface,
                                   JNIEnv *_env,
@@ -145,7 +294,7 @@ class NativeEngineIndexOutputMediator {
         nextWriteIndex() {
   }
 
-  void writeBytes(const uint8_t * RESTRICT source, size_t nbytes) {
+  void writeBytes(const uint8_t * RESTRICT source, size_t nbytes) final {
     auto left = nbytes;
     while (left > 0) {
       const auto writeBytes = std::min(bufferLength - nextWriteIndex, left);
@@ -180,7 +329,7 @@ class NativeEngineIndexOutputMediator {
     }  // End while
   }
 
-  void flush() {
+  void flush() final {
     if (nextWriteIndex > 0) {
       callWriteBytesInIndexOutput();
     }
@@ -227,6 +376,363 @@ class NativeEngineIndexOutputMediator {
 };  // NativeEngineIndexOutputMediator
 
 
+/**
+ * Writes into the direct buffer of IndexOutputWithBuffer. Bytes are copied to the buffer address without critical
+ * sections, and the Java side is only called once the buffer is full.
+ */
+class NativeEngineDirectIndexOutputMediator final : public IndexOutputMediator {
+ public:
+  // Expect IndexOutputWithBuffer is given as `_indexOutput`, and its direct buffer as `_directBuffer`.
+  NativeEngineDirectIndexOutputMediator(JNIUtilInterface *_jni_interface,
+                                        JNIEnv *_env,
+                                        jobject _indexOutput,
+                                        jobject _directBuffer)
+      : jni_interface(knn_jni::util::ParameterCheck::require_non_null(_jni_interface, "jni_interface")),
+        env(knn_jni::util::ParameterCheck::require_non_null(_env, "env")),
+        indexOutput(knn_jni::util::ParameterCheck::require_non_null(_indexOutput, "indexOutput")),
+        buffer(reinterpret_cast<uint8_t *>(knn_jni::util::ParameterCheck::require_non_null(
+            _jni_interface->GetDirectBufferAddress(_env, _directBuffer), "directBuffer"))),
+        bufferLength(_jni_interface->GetDirectBufferCapacity(_env, _directBuffer)),
+        writeDirectBytesMethod(getWriteDirectBytesMethod(_jni_interface, _env)),
+        nextWriteIndex() {
+  }
+
+  void writeBytes(const uint8_t * RESTRICT source, size_t nbytes) final {
+    while (nbytes > 0) {
+      const auto writeBytes = std::min(bufferLength - nextWriteIndex, nbytes);
+      std::memcpy(buffer + nextWriteIndex, source, writeBytes);
+
+      nextWriteIndex += writeBytes;
+      if (nextWriteIndex >= bufferLength) {
+        callWriteDirectBytesInIndexOutput();
+      }
+
+      source += writeBytes;
+      nbytes -= writeBytes;
+    }  // End while
+  }
+
+  void flush() final {
+    if (nextWriteIndex > 0) {
+      callWriteDirectBytesInIndexOutput();
+    }
+  }
+
+ private:
+  static jclass getIndexOutputWithBufferClass(JNIUtilInterface *jni_interface, JNIEnv *env) {
+    static jclass INDEX_OUTPUT_WITH_BUFFER_CLASS =
+        jni_interface->FindClassFromJNIEnv(env, "org/opensearch/knn/index/store/IndexOutputWithBuffer");
+    return INDEX_OUTPUT_WITH_BUFFER_CLASS;
+  }
+
+  static jmethodID getWriteDirectBytesMethod(JNIUtilInterface *jni_interface, JNIEnv *env) {
+    static jmethodID WRITE_DIRECT_METHOD_ID =
+        jni_interface->GetMethodID(env, getIndexOutputWithBufferClass(jni_interface, env), "writeDirectBytes", "(I)V");
+    return WRITE_DIRECT_METHOD_ID;
+  }
+
+  void callWriteDirectBytesInIndexOutput() {
+    auto jclazz = getIndexOutputWithBufferClass(jni_interface, env);
+    jvalue args {.i = static_cast<jint>(nextWriteIndex)};
+    jni_interface->CallNonvirtualVoidMethodA(env, indexOutput, jclazz, writeDirectBytesMethod, &args);
+    jni_interface->HasExceptionInStack(env, "Writing bytes via IndexOutput has failed.");
+    nextWriteIndex = 0;
+  }
+
+  JNIUtilInterface *jni_interface;
+  JNIEnv *env;
+
+  // `IndexOutputWithBuffer` instance having `IndexOutput` instance obtained from `Directory` for writing.
+  jobject indexOutput;
+  uint8_t *buffer;
+  size_t bufferLength;
+  jmethodID writeDirectBytesMethod;
+  size_t nextWriteIndex;
+};  // class NativeEngineDirectIndexOutputMediator
+
+
+
+#ifndef _WIN32
+/**
+ * Writes the index straight to the local file behind the IndexOutput of IndexOutputWithBuffer, in large aligned blocks,
+ * and keeps the CRC-32 of the written bytes. flush() completes the file with the Lucene codec footer and hands its length
+ * and checksum back to the Java side, which must then leave the footer out.
+ */
+class NativeEngineFileIndexOutputMediator final : public IndexOutputMediator {
+ public:
+  static constexpr size_t BLOCK_SIZE = 4 * 1024 * 1024;
+  static constexpr size_t BLOCK_ALIGNMENT = 4096;
+  // ~CodecUtil.CODEC_MAGIC
+  static constexpr uint32_t FOOTER_MAGIC = 0xC02893E8;
+  static constexpr size_t FOOTER_LENGTH = 16;
+
+  // Expect IndexOutputWithBuffer is given as `_indexOutput`, and the path of its file as `path`.
+  NativeEngineFileIndexOutputMediator(JNIUtilInterface *_jni_interface,
+                                      JNIEnv *_env,
+                                      jobject _indexOutput,
+                                      const std::string &path,
+                                      int64_t _preallocationStep)
+      : jni_interface(knn_jni::util::ParameterCheck::require_non_null(_jni_interface, "jni_interface")),
+        env(knn_jni::util::ParameterCheck::require_non_null(_env, "env")),
+        indexOutput(_indexOutput),
+        fd(-1),
+        block(nullptr),
+        blockLength(),
+        fileLength(),
+        preallocationStep(_preallocationStep),
+        preallocatedLength(),
+        checksum(),
+        finished(false) {
+    void *aligned = nullptr;
+    if (posix_memalign(&aligned, BLOCK_ALIGNMENT, BLOCK_SIZE) != 0) {
+      throw std::bad_alloc();
+    }
+    block = static_cast<uint8_t *>(aligned);
+    // The file was created by Lucene and is empty, it is only opened here to write to it
+    fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+      std::free(block);
+      throw std::runtime_error("Failed to open " + path + " for writing: " + std::strerror(errno));
+    }
+  }
+
+  NativeEngineFileIndexOutputMediator(const NativeEngineFileIndexOutputMediator &) = delete;
+
+  NativeEngineFileIndexOutputMediator &operator=(const NativeEngineFileIndexOutputMediator &) = delete;
+
+  ~NativeEngineFileIndexOutputMediator() final {
+    ::close(fd);
+    std::free(block);
+  }
+
+  void writeBytes(const uint8_t * RESTRICT source, size_t nbytes) final {
+    if (finished) {
+      throw std::runtime_error("Cannot write to the index file after its footer was written.");
+    }
+    while (nbytes > 0) {
+      const auto writeBytes = std::min(BLOCK_SIZE - blockLength, nbytes);
+      std::memcpy(block + blockLength, source, writeBytes);
+
+      blockLength += writeBytes;
+      if (blockLength == BLOCK_SIZE) {
+        writeBlock();
+      }
+
+      source += writeBytes;
+      nbytes -= writeBytes;
+    }  // End while
+  }
+
+  void flush() final {
+    if (finished) {
+      return;
+    }
+
+    // The footer checksum covers the footer magic and algorithm id, both big endian like the checksum
+    uint8_t footer[FOOTER_LENGTH] = {};
+    putBigEndian(footer, FOOTER_MAGIC, 4);
+    writeBytes(footer, 8);
+    const uint32_t footerChecksum = knn_jni::util::crc32(checksum, block, blockLength);
+    putBigEndian(footer + 8, footerChecksum, 8);
+    writeBytes(footer + 8, 8);
+    writeBlock();
+    releasePreallocation();
+    finished = true;
+
+    jvalue args[2];
+    args[0].j = static_cast<jlong>(fileLength);
+    args[1].j = static_cast<jlong>(footerChecksum);
+    jni_interface->CallNonvirtualVoidMethodA(env,
+                                             indexOutput,
+                                             getIndexOutputWithBufferClass(jni_interface, env),
+                                             getDirectWriteFinishedMethod(jni_interface, env),
+                                             args);
+    jni_interface->HasExceptionInStack(env, "Completing the direct write of the index has failed.");
+  }
+
+ private:
+  static jclass getIndexOutputWithBufferClass(JNIUtilInterface *jni_interface, JNIEnv *env) {
+    static jclass INDEX_OUTPUT_WITH_BUFFER_CLASS =
+        jni_interface->FindClassFromJNIEnv(env, "org/opensearch/knn/index/store/IndexOutputWithBuffer");
+    return INDEX_OUTPUT_WITH_BUFFER_CLASS;
+  }
+
+  static jmethodID getDirectWriteFinishedMethod(JNIUtilInterface *jni_interface, JNIEnv *env) {
+    static jmethodID DIRECT_WRITE_FINISHED_METHOD_ID = jni_interface->GetMethodID(
+        env, getIndexOutputWithBufferClass(jni_interface, env), "directWriteFinished", "(JJ)V");
+    return DIRECT_WRITE_FINISHED_METHOD_ID;
+  }
+
+  static void putBigEndian(uint8_t *destination, uint64_t value, size_t nbytes) {
+    for (size_t i = 0; i < nbytes; ++i) {
+      destination[i] = static_cast<uint8_t>(value >> (8 * (nbytes - 1 - i)));
+    }
+  }
+
+  void writeBlock() {
+    preallocate(fileLength + blockLength);
+    checksum = knn_jni::util::crc32(checksum, block, blockLength);
+    size_t written = 0;
+    while (written < blockLength) {
+      const auto result = ::write(fd, block + written, blockLength - written);
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::runtime_error(std::string("Writing the index file has failed: ") + std::strerror(errno));
+      }
+      written += result;
+    }
+    fileLength += blockLength;
+    blockLength = 0;
+  }
+
+  // Reserve disk space for the file up to at least `length` bytes, a preallocation step at a time. Best effort, as not
+  // every file system supports it
+  void preallocate(size_t length) {
+#ifdef __linux__
+    if (preallocationStep <= 0 || length <= preallocatedLength) {
+      return;
+    }
+    const auto reserved = (length + preallocationStep - 1) / preallocationStep * preallocationStep;
+    if (fallocate(fd, FALLOC_FL_KEEP_SIZE, preallocatedLength, reserved - preallocatedLength) == 0) {
+      preallocatedLength = reserved;
+    } else {
+      preallocationStep = 0;
+    }
+#endif
+  }
+
+  // Give back the space reserved past the end of the file
+  void releasePreallocation() {
+#ifdef __linux__
+    if (preallocatedLength > fileLength) {
+      fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, fileLength, preallocatedLength - fileLength);
+      preallocatedLength = fileLength;
+    }
+#endif
+  }
+
+  JNIUtilInterface *jni_interface;
+  JNIEnv *env;
+
+  // `IndexOutputWithBuffer` instance having `IndexOutput` instance obtained from `Directory` for writing.
+  jobject indexOutput;
+  int fd;
+  uint8_t *block;
+  size_t blockLength;
+  size_t fileLength;
+  int64_t preallocationStep;
+  size_t preallocatedLength;
+  // CRC-32 of the bytes written to the file so far
+  uint32_t checksum;
+  bool finished;
+};  // class NativeEngineFileIndexOutputMediator
+#endif
+
+
+
+/**
+ * Create the mediator reading from the given IndexInputWithBuffer. The direct read-ahead buffer is used when the Java
+ * side could allocate one, the heap buffer otherwise.
+ */
+inline std::unique_ptr<IndexInputMediator> createIndexInputMediator(JNIUtilInterface *jni_interface,
+                                                                    JNIEnv *env,
+                                                                    jobject indexInput) {
+  static jfieldID READ_AHEAD_BUFFER_FIELD_ID = jni_interface->GetFieldID(
+      env,
+      jni_interface->FindClassFromJNIEnv(env, "org/opensearch/knn/index/store/IndexInputWithBuffer"),
+      "readAheadBuffer",
+      "Ljava/nio/ByteBuffer;");
+  jobject readAheadBuffer = jni_interface->GetObjectField(env, indexInput, READ_AHEAD_BUFFER_FIELD_ID);
+  if (readAheadBuffer != nullptr) {
+    return std::make_unique<NativeEngineDirectIndexInputMediator>(jni_interface, env, indexInput, readAheadBuffer);
+  }
+  return std::make_unique<NativeEngineIndexInputMediator>(jni_interface, env, indexInput);
+}
+
+/**
+ * Create the mediator writing to the given IndexOutputWithBuffer. The index is written straight to the local file when
+ * the Java side asks for it. Otherwise, the direct buffer is used when the Java side could allocate one, the heap buffer
+ * otherwise.
+ */
+inline std::unique_ptr<IndexOutputMediator> createIndexOutputMediator(JNIUtilInterface *jni_interface,
+                                                                      JNIEnv *env,
+                                                                      jobject indexOutput) {
+#ifndef _WIN32
+  static jclass INDEX_OUTPUT_WITH_BUFFER_CLASS =
+      jni_interface->FindClassFromJNIEnv(env, "org/opensearch/knn/index/store/IndexOutputWithBuffer");
+  static jfieldID DIRECT_FILE_PATH_FIELD_ID =
+      jni_interface->GetFieldID(env, INDEX_OUTPUT_WITH_BUFFER_CLASS, "directFilePath", "Ljava/lang/String;");
+  jobject directFilePath = jni_interface->GetObjectField(env, indexOutput, DIRECT_FILE_PATH_FIELD_ID);
+  if (directFilePath != nullptr) {
+    static jmethodID PREALLOCATION_STEP_METHOD_ID =
+        jni_interface->GetMethodID(env, INDEX_OUTPUT_WITH_BUFFER_CLASS, "preallocationStep", "()J");
+    const auto preallocationStep = jni_interface->CallNonvirtualLongMethodA(env,
+                                                                            indexOutput,
+                                                                            INDEX_OUTPUT_WITH_BUFFER_CLASS,
+                                                                            PREALLOCATION_STEP_METHOD_ID,
+                                                                            nullptr);
+    jni_interface->HasExceptionInStack(env, "Getting the preallocation step has failed.");
+    return std::make_unique<NativeEngineFileIndexOutputMediator>(
+        jni_interface, env, indexOutput,
+        jni_interface->ConvertJavaStringToCppString(env, (jstring) directFilePath), preallocationStep);
+  }
+#endif
+  static jfieldID DIRECT_BUFFER_FIELD_ID = jni_interface->GetFieldID(
+      env,
+      jni_interface->FindClassFromJNIEnv(env, "org/opensearch/knn/index/store/IndexOutputWithBuffer"),
+      "directBuffer",
+      "Ljava/nio/ByteBuffer;");
+  jobject directBuffer = jni_interface->GetObjectField(env, indexOutput, DIRECT_BUFFER_FIELD_ID);
+  if (directBuffer != nullptr) {
+    return std::make_unique<NativeEngineDirectIndexOutputMediator>(jni_interface, env, indexOutput, directBuffer);
+  }
+  return std::make_unique<NativeEngineIndexOutputMediator>(jni_interface, env, indexOutput);
+}
+
+/**
+ * Get the zlib level the given IndexOutputWithBuffer asks the index to be compressed with, 0 when it should be written
+ * uncompressed.
+ */
+inline int getIndexCompressionLevel(JNIUtilInterface *jni_interface, JNIEnv *env, jobject indexOutput) {
+  static jclass INDEX_OUTPUT_WITH_BUFFER_CLASS =
+      jni_interface->FindClassFromJNIEnv(env, "org/opensearch/knn/index/store/IndexOutputWithBuffer");
+  static jmethodID COMPRESSION_LEVEL_METHOD_ID =
+      jni_interface->GetMethodID(env, INDEX_OUTPUT_WITH_BUFFER_CLASS, "compressionLevel", "()I");
+  const auto level = jni_interface->CallNonvirtualIntMethodA(env,
+                                                             indexOutput,
+                                                             INDEX_OUTPUT_WITH_BUFFER_CLASS,
+                                                             COMPRESSION_LEVEL_METHOD_ID,
+                                                             nullptr);
+  jni_interface->HasExceptionInStack(env, "Getting the index compression level has failed.");
+  return level;
+}
+
+// Orders IndexOutputWithBuffer#graphOrder asks HNSW graphs to be written in: as the vectors were inserted, or
+// renumbered breadth first from the entry point
+constexpr int GRAPH_ORDER_INSERTION = 0;
+constexpr int GRAPH_ORDER_LOCALITY = 1;
+
+/**
+ * Whether the given IndexOutputWithBuffer asks for the nodes of HNSW graphs to be renumbered in a locality preserving
+ * order before they are written.
+ */
+inline bool isGraphReorderRequested(JNIUtilInterface *jni_interface, JNIEnv *env, jobject indexOutput) {
+  static jclass INDEX_OUTPUT_WITH_BUFFER_CLASS =
+      jni_interface->FindClassFromJNIEnv(env, "org/opensearch/knn/index/store/IndexOutputWithBuffer");
+  static jmethodID GRAPH_ORDER_METHOD_ID =
+      jni_interface->GetMethodID(env, INDEX_OUTPUT_WITH_BUFFER_CLASS, "graphOrder", "()I");
+  const auto graphOrder = jni_interface->CallNonvirtualIntMethodA(env,
+                                                                  indexOutput,
+                                                                  INDEX_OUTPUT_WITH_BUFFER_CLASS,
+                                                                  GRAPH_ORDER_METHOD_ID,
+                                                                  nullptr);
+  jni_interface->HasExceptionInStack(env, "Getting the graph order has failed.");
+  return graphOrder == GRAPH_ORDER_LOCALITY;
+}
+
+
 
 }
 }
@@ -20,11 +20,11 @@ namespace knn_jni {
 namespace stream {
 
 /**
- * NmslibIOReader implementation delegating NativeEngineIndexInputMediator to read bytes.
+ * NmslibIOReader implementation delegating IndexInputMediator to read bytes.
  */
 class NmslibOpenSearchIOReader final : public similarity::NmslibIOReader {
  public:
-  explicit NmslibOpenSearchIOReader(NativeEngineIndexInputMediator *_mediator)
+  explicit NmslibOpenSearchIOReader(IndexInputMediator *_mediator)
       : similarity::NmslibIOReader(),
         mediator(knn_jni::util::ParameterCheck::require_non_null(_mediator, "mediator")) {
   }
@@ -41,13 +41,13 @@ class NmslibOpenSearchIOReader final : public similarity::NmslibIOReader {
   }
 
  private:
-  NativeEngineIndexInputMediator *mediator;
+  IndexInputMediator *mediator;
 };  // class NmslibOpenSearchIOReader
 
 
 class NmslibOpenSearchIOWriter final : public similarity::NmslibIOWriter {
  public:
-  explicit NmslibOpenSearchIOWriter(NativeEngineIndexOutputMediator *_mediator)
+  explicit NmslibOpenSearchIOWriter(IndexOutputMediator *_mediator)
       : similarity::NmslibIOWriter(),
         mediator(knn_jni::util::ParameterCheck::require_non_null(_mediator, "mediator")) {
   }
@@ -63,7 +63,7 @@ class NmslibOpenSearchIOWriter final : public similarity::NmslibIOWriter {
   }
 
  private:
-  NativeEngineIndexOutputMediator *mediator;
+  IndexOutputMediator *mediator;
 };  // class NmslibOpenSearchIOWriter
 
 
@@ -47,6 +47,15 @@ namespace knn_jni {
         jobjectArray QueryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
                                 jfloatArray queryVectorJ, jint kJ, jobject methodParamsJ);
 
+        // Same as QueryIndex, but ef_search is read from the native search parameters at searchParamsJ, or left to
+        // the index default when it is 0, and the ids and distances of the results are written to the caller provided
+        // resultIdsJ and resultDistancesJ, which must hold at least k entries, instead of allocating KNNQueryResults.
+        //
+        // Return the number of results written
+        jint QueryIndex_WithSearchParams(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                         jfloatArray queryVectorJ, jint kJ, jlong searchParamsJ, jintArray resultIdsJ,
+                                         jfloatArray resultDistancesJ);
+
         // Free the index located in memory at indexPointerJ
         void Free(jlong indexPointer);
 
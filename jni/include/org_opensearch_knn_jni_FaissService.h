@@ -70,6 +70,46 @@ JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_insertToByteInde
                                                                                   jlong vectorsAddressJ, jint dimJ,
                                                                                   jlong indexAddress, jint threadCount);
 
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    startIngestion
+ * Signature: (JIII)J
+ */
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_startIngestion
+  (JNIEnv *, jclass, jlong, jint, jint, jint);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    startBinaryIngestion
+ * Signature: (JIII)J
+ */
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_startBinaryIngestion
+  (JNIEnv *, jclass, jlong, jint, jint, jint);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    startByteIngestion
+ * Signature: (JIII)J
+ */
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_startByteIngestion
+  (JNIEnv *, jclass, jlong, jint, jint, jint);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    submitToIngestion
+ * Signature: (J[IJ)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_submitToIngestion
+  (JNIEnv *, jclass, jlong, jintArray, jlong);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    finishIngestion
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_finishIngestion
+  (JNIEnv *, jclass, jlong);
+
 /*
  * Class:     org_opensearch_knn_jni_FaissService
  * Method:    writeIndex
@@ -196,6 +236,126 @@ JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_queryInd
 JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_queryBinaryIndexWithFilter
   (JNIEnv *, jclass, jlong, jbyteArray, jint, jobject, jlongArray, jint, jintArray);
 
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    queryIndexWithFilterBuffer
+ * Signature: (J[FIJLjava/nio/ByteBuffer;I[I[I[F)I
+ */
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_queryIndexWithFilterBuffer
+  (JNIEnv *, jclass, jlong, jfloatArray, jint, jlong, jobject, jint, jintArray, jintArray, jfloatArray);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    queryBinaryIndexWithFilterBuffer
+ * Signature: (J[BIJLjava/nio/ByteBuffer;I[I[I[F)I
+ */
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_queryBinaryIndexWithFilterBuffer
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jlong, jobject, jint, jintArray, jintArray, jfloatArray);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    queryIndexBatch
+ * Signature: (J[FIIJLjava/nio/ByteBuffer;I[I[I[F)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_queryIndexBatch
+  (JNIEnv *, jclass, jlong, jfloatArray, jint, jint, jlong, jobject, jint, jintArray, jintArray, jfloatArray);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    queryByteIndexBatch
+ * Signature: (J[BIIJLjava/nio/ByteBuffer;I[I[I[F)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_queryByteIndexBatch
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jint, jlong, jobject, jint, jintArray, jintArray, jfloatArray);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    queryBinaryIndexBatch
+ * Signature: (J[BIIJLjava/nio/ByteBuffer;I[I[I[F)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_queryBinaryIndexBatch
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jint, jlong, jobject, jint, jintArray, jintArray, jfloatArray);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    exactSearchWithFilter
+ * Signature: (J[FI[JI[I[F)I
+ */
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_exactSearchWithFilter
+  (JNIEnv *, jclass, jlong, jfloatArray, jint, jlongArray, jint, jintArray, jfloatArray);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    exactRangeSearchWithFilter
+ * Signature: (J[FFI[JI[I[F)I
+ */
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_exactRangeSearchWithFilter
+  (JNIEnv *, jclass, jlong, jfloatArray, jfloat, jint, jlongArray, jint, jintArray, jfloatArray);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    warmIndex
+ * Signature: (JI)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_org_opensearch_knn_jni_FaissService_warmIndex
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    getIndexMemoryUsage
+ * Signature: (J)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_org_opensearch_knn_jni_FaissService_getIndexMemoryUsage
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    placeIndex
+ * Signature: (JI)I
+ */
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_placeIndex
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    getIndexNumaNode
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_getIndexNumaNode
+  (JNIEnv *, jclass, jlong);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    getNumaNodeCount
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_getNumaNodeCount
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    configureIndexArenas
+ * Signature: (Z)Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_opensearch_knn_jni_FaissService_configureIndexArenas
+  (JNIEnv *, jclass, jboolean);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    configureCompactGraphs
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_configureCompactGraphs
+  (JNIEnv *, jclass, jboolean);
+
+/*
+ * Class:     org_opensearch_knn_jni_FaissService
+ * Method:    getIndexArenaStats
+ * Signature: (J)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_org_opensearch_knn_jni_FaissService_getIndexArenaStats
+  (JNIEnv *, jclass, jlong);
+
 /*
  * Class:     org_opensearch_knn_jni_FaissService
  * Method:    free
@@ -260,6 +420,22 @@ JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_transferVectors
 JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_rangeSearchIndexWithFilter
   (JNIEnv *, jclass, jlong, jfloatArray, jfloat, jobject, jint, jlongArray, jint, jintArray);
 
+/*
+* Class:     org_opensearch_knn_jni_FaissService
+* Method:    rangeSearchIndexWithFilterBuffer
+* Signature: (J[FFJILjava/nio/ByteBuffer;I[I[I[F)I
+*/
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_rangeSearchIndexWithFilterBuffer
+  (JNIEnv *, jclass, jlong, jfloatArray, jfloat, jlong, jint, jobject, jint, jintArray, jintArray, jfloatArray);
+
+/*
+* Class:     org_opensearch_knn_jni_FaissService
+* Method:    rangeSearchBinaryIndexWithFilterBuffer
+* Signature: (J[BFJILjava/nio/ByteBuffer;I[I[I[F)I
+*/
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_rangeSearchBinaryIndexWithFilterBuffer
+  (JNIEnv *, jclass, jlong, jbyteArray, jfloat, jlong, jint, jobject, jint, jintArray, jintArray, jfloatArray);
+
 /*
  * Class:     org_opensearch_knn_jni_FaissService
  * Method:    rangeSearchIndex
@@ -42,6 +42,54 @@ JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeBinaryVector
 JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeByteVectorData
   (JNIEnv *, jclass, jlong, jobjectArray, jlong, jboolean);
 
+/*
+ * Class:     org_opensearch_knn_jni_JNICommons
+ * Method:    storeFlatVectorData
+ * Signature: (J[FIJZ)J
+ */
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeFlatVectorData
+  (JNIEnv *, jclass, jlong, jfloatArray, jint, jlong, jboolean);
+
+/*
+ * Class:     org_opensearch_knn_jni_JNICommons
+ * Method:    storeFlatBinaryVectorData
+ * Signature: (J[BIJZ)J
+ */
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeFlatBinaryVectorData
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jlong, jboolean);
+
+/*
+ * Class:     org_opensearch_knn_jni_JNICommons
+ * Method:    storeFlatByteVectorData
+ * Signature: (J[BIJZ)J
+ */
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeFlatByteVectorData
+  (JNIEnv *, jclass, jlong, jbyteArray, jint, jlong, jboolean);
+
+/*
+ * Class:     org_opensearch_knn_jni_JNICommons
+ * Method:    storeVectorDataFromBuffer
+ * Signature: (JLjava/nio/ByteBuffer;JJZ)J
+ */
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeVectorDataFromBuffer
+  (JNIEnv *, jclass, jlong, jobject, jlong, jlong, jboolean);
+
+/*
+ * Class:     org_opensearch_knn_jni_JNICommons
+ * Method:    storeBinaryVectorDataFromBuffer
+ * Signature: (JLjava/nio/ByteBuffer;JJZ)J
+ */
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeBinaryVectorDataFromBuffer
+  (JNIEnv *, jclass, jlong, jobject, jlong, jlong, jboolean);
+
+/*
+ * Class:     org_opensearch_knn_jni_JNICommons
+ * Method:    storeByteVectorDataFromBuffer
+ * Signature: (JLjava/nio/ByteBuffer;JJZ)J
+ */
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeByteVectorDataFromBuffer
+  (JNIEnv *, jclass, jlong, jobject, jlong, jlong, jboolean);
+
 /*
  * Class:     org_opensearch_knn_jni_JNICommons
  * Method:    freeVectorData
@@ -66,6 +114,46 @@ JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_JNICommons_freeBinaryVectorDa
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_JNICommons_freeByteVectorData
 (JNIEnv *, jclass, jlong);
 
+/*
+ * Class:     org_opensearch_knn_jni_JNICommons
+ * Method:    configureVectorBufferPool
+ * Signature: (JZ)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_JNICommons_configureVectorBufferPool
+  (JNIEnv *, jclass, jlong, jboolean);
+
+/*
+ * Class:     org_opensearch_knn_jni_JNICommons
+ * Method:    getVectorBufferPoolStats
+ * Signature: ()[J
+ */
+JNIEXPORT jlongArray JNICALL Java_org_opensearch_knn_jni_JNICommons_getVectorBufferPoolStats
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_opensearch_knn_jni_JNICommons
+ * Method:    trimNativeMemory
+ * Signature: ()Z
+ */
+JNIEXPORT jboolean JNICALL Java_org_opensearch_knn_jni_JNICommons_trimNativeMemory
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     org_opensearch_knn_jni_JNICommons
+ * Method:    createSearchParams
+ * Signature: (II)J
+ */
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_createSearchParams
+  (JNIEnv *, jclass, jint, jint);
+
+/*
+ * Class:     org_opensearch_knn_jni_JNICommons
+ * Method:    freeSearchParams
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_JNICommons_freeSearchParams
+  (JNIEnv *, jclass, jlong);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,200 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#ifndef OPENSEARCH_KNN_VECTOR_BUFFER_POOL_H
+#define OPENSEARCH_KNN_VECTOR_BUFFER_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <type_traits>
+
+namespace knn_jni {
+    namespace memory {
+        struct BufferPoolStats {
+            // Bytes and number of the free slabs kept for reuse
+            int64_t pooledBytes;
+            int64_t pooledSlabs;
+            // Bytes of the slabs currently backing vector buffers
+            int64_t usedBytes;
+            // Upper bound of pooledBytes
+            int64_t maxPooledBytes;
+            // Slab requests served from the pool, and requests that had to allocate
+            int64_t hits;
+            int64_t misses;
+        };
+
+        /**
+         * Process wide pool of aligned slabs backing the vector buffers that are filled from Java during flush and
+         * merge. Released slabs are kept, up to a configurable number of bytes, and handed out again to later builds
+         * instead of going back to the allocator. Slabs of 2MB and more are aligned to 2MB and can be backed by
+         * transparent huge pages.
+         *
+         * The pool lives in the util library, so buffers can be created and released from any of the JNI libraries.
+         */
+        class BufferPool {
+        public:
+            static BufferPool &getInstance();
+
+            /**
+             * Get a slab of at least bytes bytes.
+             *
+             * @param bytes minimum size of the slab
+             * @param slabBytes set to the actual size of the slab, which has to be passed back on release
+             * @return slab, aligned to at least 64 bytes
+             */
+            void *acquire(size_t bytes, size_t *slabBytes);
+
+            /**
+             * Give a slab back. It is kept for reuse if it fits under the pool limit, and freed otherwise.
+             */
+            void release(void *slab, size_t slabBytes);
+
+            /**
+             * Set the maximum number of bytes kept in the pool, freeing pooled slabs above it, and whether new slabs
+             * should be backed by huge pages.
+             */
+            void configure(size_t maxPooledBytes, bool useHugePages);
+
+            BufferPoolStats getStats();
+
+            ~BufferPool();
+
+        private:
+            BufferPool() = default;
+
+            void trim();
+
+            std::mutex lock;
+            // Free slabs by size
+            std::multimap<size_t, void *> freeSlabs;
+            size_t pooledBytes = 0;
+            size_t usedBytes = 0;
+            size_t maxPooledBytes = 256 * 1024 * 1024;
+            bool useHugePages = false;
+            int64_t hits = 0;
+            int64_t misses = 0;
+        };
+
+        /**
+         * Growable buffer of vector components, backed by a slab of the BufferPool. This is the object behind the
+         * memory addresses returned by JNICommons.store*VectorData.
+         *
+         * Native index builds can release the storage once they no longer need it, to lower the peak memory of the
+         * build. The buffer itself stays valid and empty, and is always freed by its owner on the Java side.
+         */
+        template<typename T>
+        class VectorBuffer {
+            static_assert(std::is_trivially_copyable<T>::value, "VectorBuffer only holds trivially copyable types");
+
+        public:
+            VectorBuffer() = default;
+
+            VectorBuffer(const VectorBuffer &) = delete;
+
+            VectorBuffer &operator=(const VectorBuffer &) = delete;
+
+            ~VectorBuffer() {
+                release();
+            }
+
+            size_t size() const {
+                return length;
+            }
+
+            size_t capacity() const {
+                return slabBytes / sizeof(T);
+            }
+
+            bool empty() const {
+                return length == 0;
+            }
+
+            T *data() {
+                return elements;
+            }
+
+            const T *data() const {
+                return elements;
+            }
+
+            T *begin() {
+                return elements;
+            }
+
+            T *end() {
+                return elements + length;
+            }
+
+            T &operator[](size_t i) {
+                return elements[i];
+            }
+
+            const T &operator[](size_t i) const {
+                return elements[i];
+            }
+
+            void reserve(size_t count) {
+                if (count <= capacity()) {
+                    return;
+                }
+                size_t grownBytes;
+                T *grown = static_cast<T *>(BufferPool::getInstance().acquire(count * sizeof(T), &grownBytes));
+                if (length > 0) {
+                    std::memcpy(grown, elements, length * sizeof(T));
+                }
+                size_t keptLength = length;
+                release();
+                elements = grown;
+                slabBytes = grownBytes;
+                length = keptLength;
+            }
+
+            void append(const T *source, size_t count) {
+                if (length + count > capacity()) {
+                    reserve(std::max(length + count, 2 * capacity()));
+                }
+                if (count > 0) {
+                    std::memcpy(elements + length, source, count * sizeof(T));
+                }
+                length += count;
+            }
+
+            void push_back(T value) {
+                append(&value, 1);
+            }
+
+            void clear() {
+                length = 0;
+            }
+
+            // Hand the storage back to the pool. The buffer stays usable and is empty afterwards
+            void release() {
+                if (elements != nullptr) {
+                    BufferPool::getInstance().release(elements, slabBytes);
+                }
+                elements = nullptr;
+                slabBytes = 0;
+                length = 0;
+            }
+
+        private:
+            T *elements = nullptr;
+            size_t slabBytes = 0;
+            size_t length = 0;
+        };
+    }
+}
+
+#endif //OPENSEARCH_KNN_VECTOR_BUFFER_POOL_H
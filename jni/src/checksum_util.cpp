@@ -0,0 +1,165 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "checksum_util.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define KNN_CRC32_CLMUL
+#include <immintrin.h>
+#endif
+
+namespace {
+    // Reflected polynomial of CRC-32
+    constexpr uint32_t CRC32_POLYNOMIAL = 0xEDB88320;
+
+    // Slicing-by-8 tables, table[k][b] is the CRC of byte b followed by k zero bytes
+    struct Crc32Tables {
+        uint32_t table[8][256];
+
+        Crc32Tables() : table() {
+            for (uint32_t b = 0; b < 256; ++b) {
+                uint32_t crc = b;
+                for (int bit = 0; bit < 8; ++bit) {
+                    crc = (crc >> 1) ^ (CRC32_POLYNOMIAL & (0 - (crc & 1)));
+                }
+                table[0][b] = crc;
+            }
+            for (uint32_t b = 0; b < 256; ++b) {
+                for (int k = 1; k < 8; ++k) {
+                    table[k][b] = (table[k - 1][b] >> 8) ^ table[0][table[k - 1][b] & 0xFF];
+                }
+            }
+        }
+    };
+
+    const Crc32Tables &getTables() {
+        static const Crc32Tables tables;
+        return tables;
+    }
+
+    // Works on the inverted CRC state
+    uint32_t crc32Table(uint32_t state, const uint8_t *data, size_t length) {
+        const auto &table = getTables().table;
+        for (; length >= 8; data += 8, length -= 8) {
+            const uint32_t low = state ^ (data[0] | data[1] << 8 | data[2] << 16 | (uint32_t) data[3] << 24);
+            state = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF] ^ table[5][(low >> 16) & 0xFF]
+                    ^ table[4][low >> 24] ^ table[3][data[4]] ^ table[2][data[5]] ^ table[1][data[6]]
+                    ^ table[0][data[7]];
+        }
+        for (; length > 0; ++data, --length) {
+            state = (state >> 8) ^ table[0][(state ^ *data) & 0xFF];
+        }
+        return state;
+    }
+
+#ifdef KNN_CRC32_CLMUL
+    // Folding constants of CRC-32 in the bit reflected domain, from "Fast CRC Computation for Generic Polynomials
+    // Using PCLMULQDQ Instruction" (Intel, 2009)
+    alignas(16) const uint64_t K1K2[] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) const uint64_t K3K4[] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) const uint64_t K5K0[] = {0x0163cd6124, 0x0000000000};
+    alignas(16) const uint64_t POLY[] = {0x01db710641, 0x01f7011641};
+
+    bool hasClmul() {
+        static const bool supported = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+        return supported;
+    }
+
+    // Works on the inverted CRC state. length must be a multiple of 16, and at least 64
+    __attribute__((target("pclmul,sse4.1")))
+    uint32_t crc32Clmul(uint32_t state, const uint8_t *data, size_t length) {
+        __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, y5, y6, y7, y8;
+
+        x1 = _mm_loadu_si128((const __m128i *) (data + 0x00));
+        x2 = _mm_loadu_si128((const __m128i *) (data + 0x10));
+        x3 = _mm_loadu_si128((const __m128i *) (data + 0x20));
+        x4 = _mm_loadu_si128((const __m128i *) (data + 0x30));
+        x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int) state));
+        x0 = _mm_load_si128((const __m128i *) K1K2);
+        data += 64;
+        length -= 64;
+
+        // Fold 64 bytes at a time into four accumulators
+        while (length >= 64) {
+            x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+            x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+            x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+            x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+            x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+            x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+            y5 = _mm_loadu_si128((const __m128i *) (data + 0x00));
+            y6 = _mm_loadu_si128((const __m128i *) (data + 0x10));
+            y7 = _mm_loadu_si128((const __m128i *) (data + 0x20));
+            y8 = _mm_loadu_si128((const __m128i *) (data + 0x30));
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), y5);
+            x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), y6);
+            x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), y7);
+            x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), y8);
+            data += 64;
+            length -= 64;
+        }
+
+        // Fold the accumulators into one
+        x0 = _mm_load_si128((const __m128i *) K3K4);
+        const __m128i accumulators[] = {x2, x3, x4};
+        for (const __m128i &next : accumulators) {
+            x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, next), x5);
+        }
+
+        // Fold the remaining 16 byte blocks
+        while (length >= 16) {
+            x2 = _mm_loadu_si128((const __m128i *) data);
+            x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+            x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+            x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+            data += 16;
+            length -= 16;
+        }
+
+        // Fold 128 bits to 64 bits
+        x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+        x3 = _mm_setr_epi32(~0, 0, ~0, 0);
+        x1 = _mm_srli_si128(x1, 8);
+        x1 = _mm_xor_si128(x1, x2);
+        x0 = _mm_loadl_epi64((const __m128i *) K5K0);
+        x2 = _mm_srli_si128(x1, 4);
+        x1 = _mm_and_si128(x1, x3);
+        x1 = _mm_clmulepi64_si128(x1, x0, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+
+        // Barrett reduction to 32 bits
+        x0 = _mm_load_si128((const __m128i *) POLY);
+        x2 = _mm_and_si128(x1, x3);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+        x2 = _mm_and_si128(x2, x3);
+        x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+        x1 = _mm_xor_si128(x1, x2);
+        return (uint32_t) _mm_extract_epi32(x1, 1);
+    }
+#endif
+}
+
+uint32_t knn_jni::util::crc32(uint32_t crc, const uint8_t *data, size_t length) {
+    uint32_t state = ~crc;
+#ifdef KNN_CRC32_CLMUL
+    if (length >= 64 && hasClmul()) {
+        const size_t blocks = length & ~(size_t) 15;
+        state = crc32Clmul(state, data, blocks);
+        data += blocks;
+        length -= blocks;
+    }
+#endif
+    return ~crc32Table(state, data, length);
+}
@@ -10,25 +10,91 @@
  */
 #include <jni.h>
 
-#include <vector>
+#include <algorithm>
+#include <stdexcept>
 
 #include "jni_util.h"
 #include "commons.h"
+#include "vector_buffer_pool.h"
 
-jlong knn_jni::commons::storeVectorData(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong memoryAddressJ,
-                                        jobjectArray dataJ, jlong initialCapacityJ, jboolean appendJ) {
-    std::vector<float> *vect;
-    if ((long) memoryAddressJ == 0) {
-        vect = new std::vector<float>();
-        vect->reserve((long)initialCapacityJ);
-    } else {
-        vect = reinterpret_cast<std::vector<float>*>(memoryAddressJ);
+#if defined(__linux__)
+#include <malloc.h>
+#endif
+
+namespace {
+    template<typename T>
+    knn_jni::memory::VectorBuffer<T> *getVectorStore(jlong memoryAddressJ, jlong initialCapacityJ, jboolean appendJ) {
+        knn_jni::memory::VectorBuffer<T> *vect;
+        if (memoryAddressJ == 0) {
+            vect = new knn_jni::memory::VectorBuffer<T>();
+            vect->reserve(static_cast<size_t>(initialCapacityJ));
+        } else {
+            vect = reinterpret_cast<knn_jni::memory::VectorBuffer<T>*>(memoryAddressJ);
+        }
+
+        if (appendJ == JNI_FALSE) {
+            vect->clear();
+        }
+        return vect;
     }
 
-    if (appendJ == JNI_FALSE) {
-        vect->clear();
+    // The store is grown before appending, so no allocation happens while the source may be pinned in a critical
+    // section
+    template<typename T>
+    void reserveForAppend(knn_jni::memory::VectorBuffer<T> *vect, size_t length) {
+        size_t required = vect->size() + length;
+        if (required > vect->capacity()) {
+            vect->reserve(std::max(required, 2 * vect->capacity()));
+        }
     }
 
+    template<typename T>
+    jlong storeFlatData(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong memoryAddressJ, jarray dataJ,
+                        jsize dataLength, jint lengthJ, jlong initialCapacityJ, jboolean appendJ) {
+        if (lengthJ < 0 || lengthJ > dataLength) {
+            throw std::runtime_error("Length of the vector data is out of the bounds of the array");
+        }
+
+        knn_jni::memory::VectorBuffer<T> *vect = getVectorStore<T>(memoryAddressJ, initialCapacityJ, appendJ);
+        reserveForAppend(vect, lengthJ);
+        if (lengthJ == 0) {
+            return (jlong) vect;
+        }
+
+        auto *data = reinterpret_cast<T *>(jniUtil->GetPrimitiveArrayCritical(env, dataJ, nullptr));
+        if (data == nullptr) {
+            if (memoryAddressJ == 0) {
+                delete vect;
+            }
+            throw std::runtime_error("Unable to pin vector data");
+        }
+        vect->append(data, lengthJ);
+        jniUtil->ReleasePrimitiveArrayCritical(env, dataJ, data, JNI_ABORT);
+        return (jlong) vect;
+    }
+
+    template<typename T>
+    jlong storeBufferData(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong memoryAddressJ, jobject bufferJ,
+                          jlong lengthJ, jlong initialCapacityJ, jboolean appendJ) {
+        auto *data = reinterpret_cast<const T *>(jniUtil->GetDirectBufferAddress(env, bufferJ));
+        if (data == nullptr) {
+            throw std::runtime_error("Vector data buffer must be a direct buffer");
+        }
+        jlong capacity = jniUtil->GetDirectBufferCapacity(env, bufferJ);
+        if (lengthJ < 0 || lengthJ > capacity / (jlong) sizeof(T)) {
+            throw std::runtime_error("Length of the vector data is out of the bounds of the buffer");
+        }
+
+        knn_jni::memory::VectorBuffer<T> *vect = getVectorStore<T>(memoryAddressJ, initialCapacityJ, appendJ);
+        reserveForAppend(vect, lengthJ);
+        vect->append(data, lengthJ);
+        return (jlong) vect;
+    }
+}
+
+jlong knn_jni::commons::storeVectorData(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong memoryAddressJ,
+                                        jobjectArray dataJ, jlong initialCapacityJ, jboolean appendJ) {
+    auto *vect = getVectorStore<float>(memoryAddressJ, initialCapacityJ, appendJ);
     int dim = jniUtil->GetInnerDimensionOf2dJavaFloatArray(env, dataJ);
     jniUtil->Convert2dJavaObjectArrayAndStoreToFloatVector(env, dataJ, dim, vect);
 
@@ -37,18 +103,7 @@ jlong knn_jni::commons::storeVectorData(knn_jni::JNIUtilInterface *jniUtil, JNIE
 
 jlong knn_jni::commons::storeBinaryVectorData(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong memoryAddressJ,
                                         jobjectArray dataJ, jlong initialCapacityJ, jboolean appendJ) {
-    std::vector<uint8_t> *vect;
-    if ((long) memoryAddressJ == 0) {
-        vect = new std::vector<uint8_t>();
-        vect->reserve((long)initialCapacityJ);
-    } else {
-        vect = reinterpret_cast<std::vector<uint8_t>*>(memoryAddressJ);
-    }
-
-    if (appendJ == JNI_FALSE) {
-        vect->clear();
-    }
-
+    auto *vect = getVectorStore<uint8_t>(memoryAddressJ, initialCapacityJ, appendJ);
     int dim = jniUtil->GetInnerDimensionOf2dJavaByteArray(env, dataJ);
     jniUtil->Convert2dJavaObjectArrayAndStoreToBinaryVector(env, dataJ, dim, vect);
 
@@ -57,53 +112,145 @@ jlong knn_jni::commons::storeBinaryVectorData(knn_jni::JNIUtilInterface *jniUtil
 
 jlong knn_jni::commons::storeByteVectorData(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong memoryAddressJ,
                                         jobjectArray dataJ, jlong initialCapacityJ, jboolean appendJ) {
-    std::vector<int8_t> *vect;
-    if (memoryAddressJ == 0) {
-        vect = new std::vector<int8_t>();
-        vect->reserve(static_cast<long>(initialCapacityJ));
-    } else {
-        vect = reinterpret_cast<std::vector<int8_t>*>(memoryAddressJ);
-    }
-
-    if (appendJ == JNI_FALSE) {
-            vect->clear();
-    }
-
+    auto *vect = getVectorStore<int8_t>(memoryAddressJ, initialCapacityJ, appendJ);
     int dim = jniUtil->GetInnerDimensionOf2dJavaByteArray(env, dataJ);
     jniUtil->Convert2dJavaObjectArrayAndStoreToByteVector(env, dataJ, dim, vect);
 
     return (jlong) vect;
 }
 
+jlong knn_jni::commons::storeFlatVectorData(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong memoryAddressJ,
+                                            jfloatArray dataJ, jint lengthJ, jlong initialCapacityJ, jboolean appendJ) {
+    return storeFlatData<float>(jniUtil, env, memoryAddressJ, dataJ, jniUtil->GetJavaFloatArrayLength(env, dataJ),
+                                lengthJ, initialCapacityJ, appendJ);
+}
+
+jlong knn_jni::commons::storeFlatBinaryVectorData(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong memoryAddressJ,
+                                                  jbyteArray dataJ, jint lengthJ, jlong initialCapacityJ, jboolean appendJ) {
+    return storeFlatData<uint8_t>(jniUtil, env, memoryAddressJ, dataJ, jniUtil->GetJavaBytesArrayLength(env, dataJ),
+                                  lengthJ, initialCapacityJ, appendJ);
+}
+
+jlong knn_jni::commons::storeFlatByteVectorData(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong memoryAddressJ,
+                                                jbyteArray dataJ, jint lengthJ, jlong initialCapacityJ, jboolean appendJ) {
+    return storeFlatData<int8_t>(jniUtil, env, memoryAddressJ, dataJ, jniUtil->GetJavaBytesArrayLength(env, dataJ),
+                                 lengthJ, initialCapacityJ, appendJ);
+}
+
+jlong knn_jni::commons::storeVectorDataFromBuffer(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong memoryAddressJ,
+                                                  jobject bufferJ, jlong lengthJ, jlong initialCapacityJ, jboolean appendJ) {
+    return storeBufferData<float>(jniUtil, env, memoryAddressJ, bufferJ, lengthJ, initialCapacityJ, appendJ);
+}
+
+jlong knn_jni::commons::storeBinaryVectorDataFromBuffer(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong memoryAddressJ,
+                                                        jobject bufferJ, jlong lengthJ, jlong initialCapacityJ, jboolean appendJ) {
+    return storeBufferData<uint8_t>(jniUtil, env, memoryAddressJ, bufferJ, lengthJ, initialCapacityJ, appendJ);
+}
+
+jlong knn_jni::commons::storeByteVectorDataFromBuffer(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong memoryAddressJ,
+                                                      jobject bufferJ, jlong lengthJ, jlong initialCapacityJ, jboolean appendJ) {
+    return storeBufferData<int8_t>(jniUtil, env, memoryAddressJ, bufferJ, lengthJ, initialCapacityJ, appendJ);
+}
+
 void knn_jni::commons::freeVectorData(jlong memoryAddressJ) {
     if (memoryAddressJ != 0) {
-        auto *vect = reinterpret_cast<std::vector<float>*>(memoryAddressJ);
+        auto *vect = reinterpret_cast<knn_jni::memory::VectorBuffer<float>*>(memoryAddressJ);
         delete vect;
     }
 }
 
 void knn_jni::commons::freeBinaryVectorData(jlong memoryAddressJ) {
     if (memoryAddressJ != 0) {
-        auto *vect = reinterpret_cast<std::vector<uint8_t>*>(memoryAddressJ);
+        auto *vect = reinterpret_cast<knn_jni::memory::VectorBuffer<uint8_t>*>(memoryAddressJ);
         delete vect;
     }
 }
 
 void knn_jni::commons::freeByteVectorData(jlong memoryAddressJ) {
     if (memoryAddressJ != 0) {
-        auto *vect = reinterpret_cast<std::vector<int8_t>*>(memoryAddressJ);
+        auto *vect = reinterpret_cast<knn_jni::memory::VectorBuffer<int8_t>*>(memoryAddressJ);
         delete vect;
     }
 }
 
-int knn_jni::commons::getIntegerMethodParameter(JNIEnv * env, knn_jni::JNIUtilInterface * jniUtil, std::unordered_map<std::string, jobject> methodParams, std::string methodParam, int defaultValue) {
+void knn_jni::commons::configureVectorBufferPool(jlong maxPooledBytesJ, jboolean useHugePagesJ) {
+    if (maxPooledBytesJ < 0) {
+        throw std::runtime_error("Vector buffer pool limit cannot be negative");
+    }
+    knn_jni::memory::BufferPool::getInstance().configure((size_t) maxPooledBytesJ, useHugePagesJ == JNI_TRUE);
+}
+
+jlongArray knn_jni::commons::getVectorBufferPoolStats(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env) {
+    knn_jni::memory::BufferPoolStats stats = knn_jni::memory::BufferPool::getInstance().getStats();
+    jlong statsCpp[] = {
+        stats.pooledBytes, stats.pooledSlabs, stats.usedBytes, stats.maxPooledBytes, stats.hits, stats.misses
+    };
+    jsize numStats = sizeof(statsCpp) / sizeof(statsCpp[0]);
+    jlongArray statsJ = jniUtil->NewLongArray(env, numStats);
+    jniUtil->SetLongArrayRegion(env, statsJ, 0, numStats, statsCpp);
+    return statsJ;
+}
+
+jboolean knn_jni::commons::trimNativeMemory() {
+#if defined(__GLIBC__)
+    return malloc_trim(0) == 1 ? JNI_TRUE : JNI_FALSE;
+#else
+    return JNI_FALSE;
+#endif
+}
+
+int knn_jni::commons::getIntegerMethodParameter(JNIEnv * env, knn_jni::JNIUtilInterface * jniUtil, const std::unordered_map<std::string, jobject> &methodParams, const std::string &methodParam, int defaultValue) {
     if (methodParams.empty()) {
         return defaultValue;
     }
     auto efSearchIt = methodParams.find(methodParam);
     if (efSearchIt != methodParams.end()) {
-        return jniUtil->ConvertJavaObjectToCppInteger(env, methodParams[methodParam]);
+        return jniUtil->ConvertJavaObjectToCppInteger(env, efSearchIt->second);
     }
 
     return defaultValue;
 }
+
+knn_jni::commons::SearchParams knn_jni::commons::parseSearchParams(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env,
+                                                                   jobject methodParamsJ) {
+    SearchParams searchParams;
+    if (methodParamsJ == nullptr) {
+        return searchParams;
+    }
+
+    auto methodParams = jniUtil->ConvertJavaMapToCppMap(env, methodParamsJ);
+    auto efSearchIt = methodParams.find(knn_jni::EF_SEARCH);
+    if (efSearchIt != methodParams.end()) {
+        searchParams.efSearch = jniUtil->ConvertJavaObjectToCppInteger(env, efSearchIt->second);
+    }
+    auto nprobesIt = methodParams.find(knn_jni::NPROBES);
+    if (nprobesIt != methodParams.end()) {
+        searchParams.nprobes = jniUtil->ConvertJavaObjectToCppInteger(env, nprobesIt->second);
+    }
+    return searchParams;
+}
+
+jlong knn_jni::commons::createSearchParams(jint efSearchJ, jint nprobesJ) {
+    auto *searchParams = new SearchParams();
+    if (efSearchJ >= 0) {
+        searchParams->efSearch = efSearchJ;
+    }
+    if (nprobesJ >= 0) {
+        searchParams->nprobes = nprobesJ;
+    }
+    return (jlong) searchParams;
+}
+
+knn_jni::commons::SearchParams knn_jni::commons::getSearchParams(jlong searchParamsAddressJ) {
+    if (searchParamsAddressJ == 0) {
+        return SearchParams();
+    }
+    return *reinterpret_cast<SearchParams*>(searchParamsAddressJ);
+}
+
+void knn_jni::commons::freeSearchParams(jlong searchParamsAddressJ) {
+    if (searchParamsAddressJ != 0) {
+        auto *searchParams = reinterpret_cast<SearchParams*>(searchParamsAddressJ);
+        delete searchParams;
+    }
+}
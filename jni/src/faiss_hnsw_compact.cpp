@@ -0,0 +1,313 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_hnsw_compact.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <typeinfo>
+#include <utility>
+
+namespace {
+using storage_idx_t = faiss::HNSW::storage_idx_t;
+
+// Nodes whose list offsets are relative to the same 64 bit block offset
+constexpr size_t NODES_PER_BLOCK = 1 << 16;
+// Zero bytes after the last list, so that a delta can always be read with an 8 byte load
+constexpr size_t LIST_PADDING = sizeof(uint64_t);
+
+size_t varintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+uint8_t *putVarint(uint8_t *destination, uint64_t value) {
+    while (value >= 0x80) {
+        *destination++ = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    *destination++ = (uint8_t) value;
+    return destination;
+}
+
+const uint8_t *getVarint(const uint8_t *source, uint64_t *value) {
+    uint64_t result = 0;
+    int shift = 0;
+    while (*source & 0x80) {
+        result |= (uint64_t) (*source++ & 0x7f) << shift;
+        shift += 7;
+    }
+    result |= (uint64_t) *source++ << shift;
+    *value = result;
+    return source;
+}
+
+int bitWidth(uint32_t value) {
+    int width = 0;
+    while (value != 0) {
+        ++width;
+        value >>= 1;
+    }
+    return width;
+}
+
+// Neighbors of node on level in ascending order, without padding
+void sortedNeighbors(const faiss::HNSW &hnsw, storage_idx_t node, int level, std::vector<storage_idx_t> *neighbors) {
+    neighbors->clear();
+    size_t begin, end;
+    hnsw.neighbor_range(node, level, &begin, &end);
+    for (size_t i = begin; i < end && hnsw.neighbors[i] >= 0; ++i) {
+        neighbors->push_back(hnsw.neighbors[i]);
+    }
+    std::sort(neighbors->begin(), neighbors->end());
+}
+
+int deltaWidth(const std::vector<storage_idx_t> &neighbors) {
+    uint32_t maxDelta = 0;
+    for (size_t i = 1; i < neighbors.size(); ++i) {
+        maxDelta = std::max(maxDelta, (uint32_t) (neighbors[i] - neighbors[i - 1]));
+    }
+    return bitWidth(maxDelta);
+}
+
+// A list is made of its size, and unless it is empty the width of its deltas, its first id and its packed deltas
+size_t encodedListSize(const std::vector<storage_idx_t> &neighbors) {
+    if (neighbors.empty()) {
+        return varintSize(0);
+    }
+    const auto packedBits = (neighbors.size() - 1) * deltaWidth(neighbors);
+    return varintSize(neighbors.size()) + 1 + varintSize((uint32_t) neighbors[0]) + (packedBits + 7) / 8;
+}
+
+// destination must be followed by LIST_PADDING zero bytes, which are written over but left as zeros
+uint8_t *encodeList(const std::vector<storage_idx_t> &neighbors, uint8_t *destination) {
+    destination = putVarint(destination, neighbors.size());
+    if (neighbors.empty()) {
+        return destination;
+    }
+    const int width = deltaWidth(neighbors);
+    *destination++ = (uint8_t) width;
+    destination = putVarint(destination, (uint32_t) neighbors[0]);
+    uint64_t bit = 0;
+    for (size_t i = 1; i < neighbors.size(); ++i) {
+        const uint64_t delta = (uint32_t) (neighbors[i] - neighbors[i - 1]);
+        uint64_t word;
+        std::memcpy(&word, destination + bit / 8, sizeof(word));
+        word |= delta << (bit % 8);
+        std::memcpy(destination + bit / 8, &word, sizeof(word));
+        bit += width;
+    }
+    return destination + (bit + 7) / 8;
+}
+
+const uint8_t *decodeList(const uint8_t *source, storage_idx_t *neighbors, size_t *count) {
+    uint64_t size;
+    source = getVarint(source, &size);
+    *count = size;
+    if (size == 0) {
+        return source;
+    }
+    const int width = *source++;
+    const uint64_t mask = (uint64_t {1} << width) - 1;
+    uint64_t first;
+    source = getVarint(source, &first);
+    auto value = (storage_idx_t) first;
+    neighbors[0] = value;
+    uint64_t bit = 0;
+    for (size_t i = 1; i < size; ++i) {
+        uint64_t word;
+        std::memcpy(&word, source + bit / 8, sizeof(word));
+        value += (storage_idx_t) ((word >> (bit % 8)) & mask);
+        neighbors[i] = value;
+        bit += width;
+    }
+    return source + (bit + 7) / 8;
+}
+
+const uint8_t *skipList(const uint8_t *source) {
+    uint64_t size;
+    source = getVarint(source, &size);
+    if (size == 0) {
+        return source;
+    }
+    const int width = *source++;
+    uint64_t first;
+    source = getVarint(source, &first);
+    return source + ((size - 1) * width + 7) / 8;
+}
+
+template<typename HNSWIndex>
+void takeOver(HNSWIndex *to, HNSWIndex *from) {
+    to->d = from->d;
+    to->ntotal = from->ntotal;
+    to->verbose = from->verbose;
+    to->is_trained = from->is_trained;
+    to->metric_type = from->metric_type;
+    to->hnsw = std::move(from->hnsw);
+    to->storage = from->storage;
+    to->own_fields = from->own_fields;
+    from->storage = nullptr;
+    from->own_fields = false;
+    from->ntotal = 0;
+}
+
+// Free the neighbor lists of hnsw once they are encoded. Offsets only locate them
+void dropNeighbors(faiss::HNSW *hnsw) {
+    hnsw->neighbors = decltype(hnsw->neighbors)();
+    hnsw->offsets = decltype(hnsw->offsets)();
+}
+}
+
+knn_jni::graph::CompactNeighborLists::CompactNeighborLists(const faiss::HNSW &hnsw) {
+    const auto ntotal = (int64_t) hnsw.levels.size();
+    for (size_t level = 0; level + 1 < hnsw.cum_nneighbor_per_level.size(); ++level) {
+        maxListSize = std::max(maxListSize, (size_t) hnsw.nb_neighbors((int) level));
+    }
+
+    // Lists are sized first, so that every node knows where its lists go, then encoded concurrently
+    std::vector<size_t> nodeSizes(ntotal);
+#pragma omp parallel
+    {
+        std::vector<storage_idx_t> neighbors;
+#pragma omp for schedule(static)
+        for (int64_t node = 0; node < ntotal; ++node) {
+            size_t size = 0;
+            for (int level = 0; level < hnsw.levels[node]; ++level) {
+                sortedNeighbors(hnsw, (storage_idx_t) node, level, &neighbors);
+                size += encodedListSize(neighbors);
+            }
+            nodeSizes[node] = size;
+        }
+    }
+
+    blockOffsets.resize((ntotal + NODES_PER_BLOCK - 1) / NODES_PER_BLOCK);
+    nodeOffsets.resize(ntotal);
+    uint64_t totalSize = 0;
+    for (int64_t node = 0; node < ntotal; ++node) {
+        if (node % NODES_PER_BLOCK == 0) {
+            blockOffsets[node / NODES_PER_BLOCK] = totalSize;
+        }
+        const uint64_t offset = totalSize - blockOffsets[node / NODES_PER_BLOCK];
+        if (offset > std::numeric_limits<uint32_t>::max()) {
+            throw std::runtime_error("Neighbor lists are too large to be compacted");
+        }
+        nodeOffsets[node] = (uint32_t) offset;
+        totalSize += nodeSizes[node];
+    }
+
+    lists.resize(totalSize + LIST_PADDING);
+#pragma omp parallel
+    {
+        std::vector<storage_idx_t> neighbors;
+        // Lists are packed into a zeroed buffer of their own, as packing writes past their last byte
+        std::vector<uint8_t> encoded;
+#pragma omp for schedule(static)
+        for (int64_t node = 0; node < ntotal; ++node) {
+            encoded.assign(nodeSizes[node] + LIST_PADDING, 0);
+            uint8_t *position = encoded.data();
+            for (int level = 0; level < hnsw.levels[node]; ++level) {
+                sortedNeighbors(hnsw, (storage_idx_t) node, level, &neighbors);
+                position = encodeList(neighbors, position);
+            }
+            std::memcpy(lists.data() + blockOffsets[node / NODES_PER_BLOCK] + nodeOffsets[node], encoded.data(),
+                        nodeSizes[node]);
+        }
+    }
+}
+
+const uint8_t *knn_jni::graph::CompactNeighborLists::nodeLists(storage_idx_t node) const {
+    return lists.data() + blockOffsets[node / NODES_PER_BLOCK] + nodeOffsets[node];
+}
+
+size_t knn_jni::graph::CompactNeighborLists::decode(storage_idx_t node, int level, storage_idx_t *neighbors) const {
+    const uint8_t *source = nodeLists(node);
+    for (int lowerLevel = 0; lowerLevel < level; ++lowerLevel) {
+        source = skipList(source);
+    }
+    size_t count;
+    decodeList(source, neighbors, &count);
+    return count;
+}
+
+int64_t knn_jni::graph::CompactNeighborLists::bytes() const {
+    return (int64_t) (lists.capacity() + nodeOffsets.capacity() * sizeof(uint32_t)
+                      + blockOffsets.capacity() * sizeof(uint64_t));
+}
+
+knn_jni::graph::IndexHNSWCompact::IndexHNSWCompact(faiss::IndexHNSW *index) : faiss::IndexHNSW() {
+    storage = nullptr;
+    own_fields = false;
+    // Lists are encoded before anything is taken over, so that index is left intact if encoding fails
+    compactNeighbors = CompactNeighborLists(index->hnsw);
+    takeOver<faiss::IndexHNSW>(this, index);
+    dropNeighbors(&hnsw);
+    hnsw.external_neighbors = &compactNeighbors;
+}
+
+void knn_jni::graph::IndexHNSWCompact::add(faiss::idx_t n, const float *x) {
+    throw std::runtime_error("Vectors cannot be added to a compact HNSW index");
+}
+
+knn_jni::graph::IndexBinaryHNSWCompact::IndexBinaryHNSWCompact(faiss::IndexBinaryHNSW *index)
+        : faiss::IndexBinaryHNSW() {
+    storage = nullptr;
+    own_fields = false;
+    compactNeighbors = CompactNeighborLists(index->hnsw);
+    code_size = index->code_size;
+    takeOver<faiss::IndexBinaryHNSW>(this, index);
+    dropNeighbors(&hnsw);
+    hnsw.external_neighbors = &compactNeighbors;
+}
+
+void knn_jni::graph::IndexBinaryHNSWCompact::add(faiss::idx_t n, const uint8_t *x) {
+    throw std::runtime_error("Vectors cannot be added to a compact HNSW index");
+}
+
+bool knn_jni::graph::compactIndexIDMapHNSW(faiss::IndexIDMap *idMap) {
+    if (idMap == nullptr || idMap->index == nullptr || !idMap->own_fields) {
+        return false;
+    }
+    // Subclasses that search the graph differently, such as CAGRA based ones, are left as they are
+    const std::type_info &type = typeid(*idMap->index);
+    if (type != typeid(faiss::IndexHNSWFlat) && type != typeid(faiss::IndexHNSWSQ)
+        && type != typeid(faiss::IndexHNSWPQ)) {
+        return false;
+    }
+    auto *hnswIndex = static_cast<faiss::IndexHNSW *>(idMap->index);
+    if (hnswIndex->storage == nullptr || hnswIndex->ntotal == 0 || hnswIndex->hnsw.upper_beam != 1) {
+        return false;
+    }
+    idMap->index = new IndexHNSWCompact(hnswIndex);
+    delete hnswIndex;
+    return true;
+}
+
+bool knn_jni::graph::compactIndexBinaryIDMapHNSW(faiss::IndexBinaryIDMap *idMap) {
+    if (idMap == nullptr || idMap->index == nullptr || !idMap->own_fields) {
+        return false;
+    }
+    if (typeid(*idMap->index) != typeid(faiss::IndexBinaryHNSW)) {
+        return false;
+    }
+    auto *hnswIndex = static_cast<faiss::IndexBinaryHNSW *>(idMap->index);
+    if (hnswIndex->storage == nullptr || hnswIndex->ntotal == 0 || hnswIndex->hnsw.upper_beam != 1) {
+        return false;
+    }
+    idMap->index = new IndexBinaryHNSWCompact(hnswIndex);
+    delete hnswIndex;
+    return true;
+}
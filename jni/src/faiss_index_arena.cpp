@@ -0,0 +1,430 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_index_arena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Address space reserved for all the arenas, halved until the reservation succeeds
+    constexpr size_t MAX_ADDRESS_SPACE_SIZE = (size_t) 1 << 40;
+    constexpr size_t MIN_ADDRESS_SPACE_SIZE = (size_t) 1 << 34;
+    constexpr size_t CHUNK_SIZE = 16 * 1024 * 1024;
+    // Allocations of this size and more get a mapping of their own
+    constexpr size_t LARGE_ALLOCATION_SIZE = 1024 * 1024;
+    constexpr size_t MIN_ALIGNMENT = 16;
+
+    // Written in front of every arena allocation, so that it can be freed from its address alone
+    struct AllocationHeader {
+        knn_jni::memory::IndexArena *arena;
+        size_t bytes;
+        // Mapping dedicated to the allocation, 0 for allocations packed into a chunk
+        uintptr_t rangeStart;
+        size_t rangeBytes;
+    };
+    constexpr size_t HEADER_SIZE = sizeof(AllocationHeader);
+    static_assert(HEADER_SIZE % MIN_ALIGNMENT == 0, "Headers must keep allocations aligned");
+
+    thread_local knn_jni::memory::IndexArena *currentArena = nullptr;
+
+    std::atomic<uintptr_t> spaceStart(0);
+    std::atomic<uintptr_t> spaceEnd(0);
+    std::mutex spaceLock;
+    // Unmapped ranges of the address space, by start
+    std::map<uintptr_t, size_t> *freeSpace = nullptr;
+
+    uintptr_t alignUp(uintptr_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    size_t getPageSize() {
+#ifdef __linux__
+        static const auto pageSize = (size_t) sysconf(_SC_PAGESIZE);
+        return pageSize;
+#else
+        return 4096;
+#endif
+    }
+
+#ifdef KNN_INDEX_ARENAS
+    std::once_flag spaceReserved;
+
+    // Reserve the address space of the arenas on first use. Returns false when no space could be reserved.
+    bool reserveSpace() {
+#ifdef __linux__
+        std::call_once(spaceReserved, []() {
+            for (size_t size = MAX_ADDRESS_SPACE_SIZE; size >= MIN_ADDRESS_SPACE_SIZE; size /= 2) {
+                void *space = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+                if (space == MAP_FAILED) {
+                    continue;
+                }
+                freeSpace = new std::map<uintptr_t, size_t>();
+                freeSpace->emplace(reinterpret_cast<uintptr_t>(space), size);
+                spaceStart.store(reinterpret_cast<uintptr_t>(space), std::memory_order_release);
+                spaceEnd.store(reinterpret_cast<uintptr_t>(space) + size, std::memory_order_release);
+                return;
+            }
+        });
+        return spaceEnd.load(std::memory_order_acquire) != 0;
+#else
+        return false;
+#endif
+    }
+#endif
+
+    // Map bytes of the reserved address space, which must be a multiple of the page size. Returns 0 when the space is
+    // exhausted or the memory cannot be committed.
+    uintptr_t mapRange(size_t bytes) {
+#ifdef __linux__
+        uintptr_t start = 0;
+        {
+            std::lock_guard<std::mutex> guard(spaceLock);
+            auto it = std::find_if(freeSpace->begin(), freeSpace->end(),
+                                   [bytes](const std::pair<const uintptr_t, size_t> &range) {
+                                       return range.second >= bytes;
+                                   });
+            if (it == freeSpace->end()) {
+                return 0;
+            }
+            start = it->first;
+            const size_t remaining = it->second - bytes;
+            freeSpace->erase(it);
+            if (remaining > 0) {
+                freeSpace->emplace(start + bytes, remaining);
+            }
+        }
+        if (mmap(reinterpret_cast<void *>(start), bytes, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0) == MAP_FAILED) {
+            std::lock_guard<std::mutex> guard(spaceLock);
+            freeSpace->emplace(start, bytes);
+            return 0;
+        }
+        return start;
+#else
+        return 0;
+#endif
+    }
+
+    // Drop the pages of a range and give it back to the reserved address space
+    void unmapRange(uintptr_t start, size_t bytes) {
+#ifdef __linux__
+        // Mapping the range again without access both frees its pages and keeps the address space reserved
+        mmap(reinterpret_cast<void *>(start), bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED,
+             -1, 0);
+        std::lock_guard<std::mutex> guard(spaceLock);
+        auto next = freeSpace->lower_bound(start);
+        if (next != freeSpace->end() && start + bytes == next->first) {
+            bytes += next->second;
+            next = freeSpace->erase(next);
+        }
+        if (next != freeSpace->begin()) {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == start) {
+                previous->second += bytes;
+                return;
+            }
+        }
+        freeSpace->emplace(start, bytes);
+#endif
+    }
+}
+
+bool knn_jni::memory::IndexArena::isSupported() {
+#if defined(__linux__) && defined(KNN_INDEX_ARENAS)
+    return true;
+#else
+    return false;
+#endif
+}
+
+knn_jni::memory::IndexArena *knn_jni::memory::IndexArena::create() {
+#ifndef KNN_INDEX_ARENAS
+    // Nothing would be allocated from an arena without the replaced operator new
+    return nullptr;
+#else
+    // Bookkeeping of the arenas themselves always goes to the heap
+    IndexArenaScope heapScope(nullptr);
+    if (!reserveSpace()) {
+        return nullptr;
+    }
+    return new IndexArena();
+#endif
+}
+
+bool knn_jni::memory::IndexArena::owns(const void *ptr) {
+    const auto address = reinterpret_cast<uintptr_t>(ptr);
+    return address >= spaceStart.load(std::memory_order_relaxed) && address < spaceEnd.load(std::memory_order_relaxed);
+}
+
+void knn_jni::memory::IndexArena::deallocate(void *ptr) {
+    const auto *header = reinterpret_cast<AllocationHeader *>(reinterpret_cast<uintptr_t>(ptr) - HEADER_SIZE);
+    header->arena->freeAllocation(ptr);
+}
+
+void *knn_jni::memory::IndexArena::allocate(size_t bytes, size_t alignment) {
+    IndexArenaScope heapScope(nullptr);
+    alignment = std::max(alignment, MIN_ALIGNMENT);
+    const size_t span = HEADER_SIZE + bytes + (alignment > MIN_ALIGNMENT ? alignment : 0);
+
+    uintptr_t address;
+    AllocationHeader header {this, bytes, 0, 0};
+    if (span >= LARGE_ALLOCATION_SIZE) {
+        header.rangeBytes = alignUp(span, getPageSize());
+        header.rangeStart = mapRange(header.rangeBytes);
+        if (header.rangeStart == 0) {
+            return nullptr;
+        }
+        address = alignUp(header.rangeStart + HEADER_SIZE, alignment);
+        std::lock_guard<std::mutex> guard(lock);
+        mappedBytes += header.rangeBytes;
+        largeAllocations++;
+        liveBytes += bytes;
+        liveAllocations++;
+    } else {
+        std::lock_guard<std::mutex> guard(lock);
+        address = alignUp(chunkPosition + HEADER_SIZE, alignment);
+        if (chunkPosition == 0 || address + bytes > chunkEnd) {
+            const uintptr_t chunk = mapRange(CHUNK_SIZE);
+            if (chunk == 0) {
+                return nullptr;
+            }
+            chunks.push_back(Range {chunk, CHUNK_SIZE});
+            mappedBytes += CHUNK_SIZE;
+            chunkEnd = chunk + CHUNK_SIZE;
+            address = alignUp(chunk + HEADER_SIZE, alignment);
+        }
+        chunkPosition = address + bytes;
+        liveBytes += bytes;
+        liveAllocations++;
+    }
+    *reinterpret_cast<AllocationHeader *>(address - HEADER_SIZE) = header;
+    return reinterpret_cast<void *>(address);
+}
+
+void knn_jni::memory::IndexArena::freeAllocation(void *ptr) {
+    IndexArenaScope heapScope(nullptr);
+    const AllocationHeader header = *reinterpret_cast<AllocationHeader *>(reinterpret_cast<uintptr_t>(ptr) - HEADER_SIZE);
+    bool destroy;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        liveBytes -= header.bytes;
+        liveAllocations--;
+        if (header.rangeStart != 0) {
+            mappedBytes -= header.rangeBytes;
+            largeAllocations--;
+        } else if (reinterpret_cast<uintptr_t>(ptr) + header.bytes == chunkPosition) {
+            // Temporary buffers are usually freed right after they are allocated, so their space is reused
+            chunkPosition = reinterpret_cast<uintptr_t>(ptr) - HEADER_SIZE;
+        }
+        destroy = closed && liveAllocations == 0;
+    }
+    if (header.rangeStart != 0) {
+        unmapRange(header.rangeStart, header.rangeBytes);
+    }
+    if (destroy) {
+        delete this;
+    }
+}
+
+void knn_jni::memory::IndexArena::close() {
+    IndexArenaScope heapScope(nullptr);
+    bool destroy;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        closed = true;
+        destroy = liveAllocations == 0;
+    }
+    if (destroy) {
+        delete this;
+    }
+}
+
+knn_jni::memory::IndexArenaStats knn_jni::memory::IndexArena::getStats() {
+    std::lock_guard<std::mutex> guard(lock);
+    return IndexArenaStats {
+        (int64_t) mappedBytes,
+        (int64_t) liveBytes,
+        liveAllocations,
+        (int64_t) chunks.size(),
+        largeAllocations
+    };
+}
+
+knn_jni::memory::IndexArena::~IndexArena() {
+    for (const Range &chunk : chunks) {
+        unmapRange(chunk.start, chunk.bytes);
+    }
+}
+
+knn_jni::memory::IndexArenaScope::IndexArenaScope(IndexArena *arena) : previous(currentArena) {
+    currentArena = arena;
+}
+
+knn_jni::memory::IndexArenaScope::~IndexArenaScope() {
+    currentArena = previous;
+}
+
+knn_jni::memory::IndexArena *knn_jni::memory::IndexArenaScope::current() {
+    return currentArena;
+}
+
+#if defined(__linux__) && defined(KNN_INDEX_ARENAS)
+// Replacements of the global allocation functions, routing the allocations made under an IndexArenaScope to its arena.
+// Anything else goes to malloc as with the default ones, and arena memory is told apart by its address when freed.
+namespace {
+    void *allocateHeap(size_t bytes, size_t alignment) {
+        while (true) {
+            void *ptr = nullptr;
+            if (alignment > MIN_ALIGNMENT) {
+                if (posix_memalign(&ptr, alignment, std::max(bytes, (size_t) 1)) != 0) {
+                    ptr = nullptr;
+                }
+            } else {
+                ptr = std::malloc(std::max(bytes, (size_t) 1));
+            }
+            if (ptr != nullptr) {
+                return ptr;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (handler == nullptr) {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void *allocate(size_t bytes, size_t alignment) {
+        if (knn_jni::memory::IndexArena *arena = currentArena) {
+            // Falls back to the heap once the reserved address space is exhausted
+            if (void *ptr = arena->allocate(bytes, alignment)) {
+                return ptr;
+            }
+        }
+        return allocateHeap(bytes, alignment);
+    }
+
+    void deallocate(void *ptr) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
+        if (knn_jni::memory::IndexArena::owns(ptr)) {
+            knn_jni::memory::IndexArena::deallocate(ptr);
+        } else {
+            std::free(ptr);
+        }
+    }
+}
+
+void *operator new(size_t bytes) {
+    return allocate(bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new[](size_t bytes) {
+    return allocate(bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new(size_t bytes, std::align_val_t alignment) {
+    return allocate(bytes, static_cast<size_t>(alignment));
+}
+
+void *operator new[](size_t bytes, std::align_val_t alignment) {
+    return allocate(bytes, static_cast<size_t>(alignment));
+}
+
+void *operator new(size_t bytes, const std::nothrow_t &) noexcept {
+    try {
+        return allocate(bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void *operator new[](size_t bytes, const std::nothrow_t &) noexcept {
+    try {
+        return allocate(bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void *operator new(size_t bytes, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    try {
+        return allocate(bytes, static_cast<size_t>(alignment));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void *operator new[](size_t bytes, std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    try {
+        return allocate(bytes, static_cast<size_t>(alignment));
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void *ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t &) noexcept {
+    deallocate(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t &) noexcept {
+    deallocate(ptr);
+}
+#endif
@@ -0,0 +1,288 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "faiss_index_compression.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+// Uncompressed bytes per frame
+constexpr uint32_t FRAME_SIZE = 1024 * 1024;
+// Frames compressed or decompressed together, one per OpenMP thread
+constexpr size_t FRAMES_PER_BATCH = 16;
+// Upper bound accepted for the frame size of a file
+constexpr uint32_t MAX_FRAME_SIZE = 64 * 1024 * 1024;
+// Uncompressed and compressed size of the frame
+constexpr size_t FRAME_HEADER_SIZE = 2 * sizeof(uint32_t);
+
+void putUint32(uint8_t *destination, uint32_t value) {
+  std::memcpy(destination, &value, sizeof(value));
+}
+
+uint32_t getUint32(const uint8_t *source) {
+  uint32_t value;
+  std::memcpy(&value, source, sizeof(value));
+  return value;
+}
+
+void checkFrameSizes(uint32_t rawSize, uint32_t compressedSize, uint32_t maxFrameSize) {
+  if (rawSize > maxFrameSize || compressedSize > compressBound(maxFrameSize)) {
+    throw std::runtime_error("Invalid frame in compressed index: " + std::to_string(rawSize) + " bytes compressed to "
+                             + std::to_string(compressedSize) + " bytes");
+  }
+}
+
+bool decompressFrame(const uint8_t *source, uint32_t compressedSize, uint8_t *destination, uint32_t rawSize) {
+  uLongf destinationLength = rawSize;
+  return uncompress(destination, &destinationLength, source, compressedSize) == Z_OK && destinationLength == rawSize;
+}
+
+// Location of a frame within a compressed index in memory, and of its bytes in the decompressed index
+struct Frame {
+  const uint8_t *source;
+  uint32_t compressedSize;
+  uint32_t rawSize;
+  size_t offset;
+};
+}
+
+bool knn_jni::stream::isCompressedIndex(const uint8_t *data, size_t length) {
+  return data != nullptr && length >= sizeof(uint32_t) && getUint32(data) == COMPRESSED_INDEX_MAGIC;
+}
+
+std::vector<uint8_t> knn_jni::stream::decompressIndex(const uint8_t *data, size_t length) {
+  if (!isCompressedIndex(data, length) || length < 2 * sizeof(uint32_t)) {
+    throw std::runtime_error("Index is not compressed");
+  }
+  const uint32_t maxFrameSize = getUint32(data + sizeof(uint32_t));
+  if (maxFrameSize > MAX_FRAME_SIZE) {
+    throw std::runtime_error("Invalid frame size in compressed index: " + std::to_string(maxFrameSize));
+  }
+
+  // Frame headers are walked first, so that every frame knows where its bytes go
+  std::vector<Frame> frames;
+  size_t position = 2 * sizeof(uint32_t);
+  size_t rawLength = 0;
+  while (true) {
+    if (length - position < FRAME_HEADER_SIZE) {
+      throw std::runtime_error("Unexpected end of compressed index");
+    }
+    const uint32_t rawSize = getUint32(data + position);
+    const uint32_t compressedSize = getUint32(data + position + sizeof(uint32_t));
+    position += FRAME_HEADER_SIZE;
+    if (rawSize == 0) {
+      break;
+    }
+    checkFrameSizes(rawSize, compressedSize, maxFrameSize);
+    if (length - position < compressedSize) {
+      throw std::runtime_error("Unexpected end of compressed index");
+    }
+    frames.push_back(Frame {data + position, compressedSize, rawSize, rawLength});
+    position += compressedSize;
+    rawLength += rawSize;
+  }
+
+  std::vector<uint8_t> index(rawLength);
+  std::atomic<bool> corrupted(false);
+  const auto numFrames = (int64_t) frames.size();
+#pragma omp parallel for schedule(dynamic) if (numFrames > 1)
+  for (int64_t i = 0; i < numFrames; ++i) {
+    const Frame &frame = frames[i];
+    if (!decompressFrame(frame.source, frame.compressedSize, index.data() + frame.offset, frame.rawSize)) {
+      corrupted = true;
+    }
+  }
+  if (corrupted) {
+    throw std::runtime_error("Failed to decompress index, a frame is corrupted");
+  }
+  return index;
+}
+
+knn_jni::stream::IndexFrameCompressor::IndexFrameCompressor(Sink _sink, int _level)
+    : sink(std::move(_sink)),
+      level(_level),
+      started(false),
+      pending(),
+      compressedFrames(FRAMES_PER_BATCH) {
+  if (level < Z_BEST_SPEED || level > Z_BEST_COMPRESSION) {
+    throw std::runtime_error("Invalid index compression level: " + std::to_string(level));
+  }
+  pending.reserve(FRAMES_PER_BATCH * FRAME_SIZE);
+}
+
+void knn_jni::stream::IndexFrameCompressor::write(const uint8_t *source, size_t nbytes) {
+  while (nbytes > 0) {
+    const auto copyBytes = std::min(nbytes, FRAMES_PER_BATCH * FRAME_SIZE - pending.size());
+    pending.insert(pending.end(), source, source + copyBytes);
+    if (pending.size() == FRAMES_PER_BATCH * FRAME_SIZE) {
+      compressPending();
+    }
+    source += copyBytes;
+    nbytes -= copyBytes;
+  }
+}
+
+void knn_jni::stream::IndexFrameCompressor::finish() {
+  compressPending();
+  uint8_t endFrame[FRAME_HEADER_SIZE] = {};
+  sink(endFrame, sizeof(endFrame));
+}
+
+void knn_jni::stream::IndexFrameCompressor::compressPending() {
+  if (!started) {
+    uint8_t header[2 * sizeof(uint32_t)];
+    putUint32(header, COMPRESSED_INDEX_MAGIC);
+    putUint32(header + sizeof(uint32_t), FRAME_SIZE);
+    sink(header, sizeof(header));
+    started = true;
+  }
+
+  const auto numFrames = (int64_t) ((pending.size() + FRAME_SIZE - 1) / FRAME_SIZE);
+  std::atomic<bool> failed(false);
+#pragma omp parallel for schedule(dynamic) if (numFrames > 1)
+  for (int64_t i = 0; i < numFrames; ++i) {
+    const size_t offset = (size_t) i * FRAME_SIZE;
+    const auto rawSize = (uint32_t) std::min((size_t) FRAME_SIZE, pending.size() - offset);
+    std::vector<uint8_t> &frame = compressedFrames[i];
+    frame.resize(FRAME_HEADER_SIZE + compressBound(rawSize));
+    uLongf compressedSize = frame.size() - FRAME_HEADER_SIZE;
+    if (compress2(frame.data() + FRAME_HEADER_SIZE, &compressedSize, pending.data() + offset, rawSize, level) != Z_OK) {
+      failed = true;
+      continue;
+    }
+    putUint32(frame.data(), rawSize);
+    putUint32(frame.data() + sizeof(uint32_t), (uint32_t) compressedSize);
+    frame.resize(FRAME_HEADER_SIZE + compressedSize);
+  }
+  if (failed) {
+    throw std::runtime_error("Failed to compress index");
+  }
+
+  for (int64_t i = 0; i < numFrames; ++i) {
+    sink(compressedFrames[i].data(), compressedFrames[i].size());
+  }
+  pending.clear();
+}
+
+knn_jni::stream::FaissDecompressingIOReader::FaissDecompressingIOReader(faiss::IOReader *_source)
+    : faiss::IOReader(),
+      source(_source),
+      compressed(false),
+      maxFrameSize(0),
+      prefix(),
+      prefixLength(0),
+      prefixOffset(0),
+      compressedFrames(),
+      batch(),
+      batchOffset(0),
+      ended(false) {
+  if (source == nullptr) {
+    throw std::runtime_error("IOReader cannot be null");
+  }
+  name = source->name;
+  prefixLength = (*source)(prefix, 1, sizeof(prefix));
+  compressed = isCompressedIndex(prefix, prefixLength);
+  if (compressed) {
+    readSource(&maxFrameSize, sizeof(maxFrameSize));
+    if (maxFrameSize > MAX_FRAME_SIZE) {
+      throw std::runtime_error("Invalid frame size in compressed index: " + std::to_string(maxFrameSize));
+    }
+    compressedFrames.resize(FRAMES_PER_BATCH);
+  }
+}
+
+size_t knn_jni::stream::FaissDecompressingIOReader::operator()(void *ptr, size_t size, size_t nitems) {
+  if (size == 0) {
+    return nitems;
+  }
+  auto *destination = static_cast<uint8_t *>(ptr);
+  const size_t nbytes = size * nitems;
+  size_t readBytes = 0;
+
+  if (!compressed) {
+    const auto prefixBytes = std::min(nbytes, prefixLength - prefixOffset);
+    std::memcpy(destination, prefix + prefixOffset, prefixBytes);
+    prefixOffset += prefixBytes;
+    readBytes = prefixBytes;
+    if (readBytes < nbytes) {
+      readBytes += (*source)(destination + readBytes, 1, nbytes - readBytes);
+    }
+    return readBytes / size;
+  }
+
+  while (readBytes < nbytes) {
+    if (batchOffset == batch.size() && !readBatch()) {
+      break;
+    }
+    const auto copyBytes = std::min(nbytes - readBytes, batch.size() - batchOffset);
+    std::memcpy(destination + readBytes, batch.data() + batchOffset, copyBytes);
+    batchOffset += copyBytes;
+    readBytes += copyBytes;
+  }
+  return readBytes / size;
+}
+
+int knn_jni::stream::FaissDecompressingIOReader::filedescriptor() {
+  throw std::runtime_error("filedescriptor() is not supported in FaissDecompressingIOReader.");
+}
+
+bool knn_jni::stream::FaissDecompressingIOReader::readBatch() {
+  // Compressed frames are read from the source in order, then decompressed concurrently
+  std::vector<uint32_t> rawSizes;
+  std::vector<size_t> offsets;
+  size_t batchLength = 0;
+  while (!ended && rawSizes.size() < FRAMES_PER_BATCH) {
+    uint8_t header[FRAME_HEADER_SIZE];
+    readSource(header, sizeof(header));
+    const uint32_t rawSize = getUint32(header);
+    const uint32_t compressedSize = getUint32(header + sizeof(uint32_t));
+    if (rawSize == 0) {
+      ended = true;
+      break;
+    }
+    checkFrameSizes(rawSize, compressedSize, maxFrameSize);
+    std::vector<uint8_t> &frame = compressedFrames[rawSizes.size()];
+    frame.resize(compressedSize);
+    readSource(frame.data(), compressedSize);
+    rawSizes.push_back(rawSize);
+    offsets.push_back(batchLength);
+    batchLength += rawSize;
+  }
+
+  batch.resize(batchLength);
+  batchOffset = 0;
+  std::atomic<bool> corrupted(false);
+  const auto numFrames = (int64_t) rawSizes.size();
+#pragma omp parallel for schedule(dynamic) if (numFrames > 1)
+  for (int64_t i = 0; i < numFrames; ++i) {
+    const std::vector<uint8_t> &frame = compressedFrames[i];
+    if (!decompressFrame(frame.data(), (uint32_t) frame.size(), batch.data() + offsets[i], rawSizes[i])) {
+      corrupted = true;
+    }
+  }
+  if (corrupted) {
+    throw std::runtime_error("Failed to decompress index, a frame is corrupted");
+  }
+  return batchLength > 0;
+}
+
+void knn_jni::stream::FaissDecompressingIOReader::readSource(void *destination, size_t nbytes) {
+  if ((*source)(destination, 1, nbytes) != nbytes) {
+    throw std::runtime_error("Unexpected end of compressed index");
+  }
+}
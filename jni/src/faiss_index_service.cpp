@@ -9,6 +9,8 @@
 
 #include "faiss_index_service.h"
 #include "faiss_methods.h"
+#include "faiss_util.h"
+#include "vector_buffer_pool.h"
 #include "faiss/Index.h"
 #include "faiss/IndexBinary.h"
 #include "faiss/IndexHNSW.h"
@@ -16,7 +18,10 @@
 #include "faiss/IndexIVFFlat.h"
 #include "faiss/IndexBinaryIVF.h"
 #include "faiss/IndexIDMap.h"
+#include "faiss/IndexScalarQuantizer.h"
+#include "faiss/impl/DistanceComputer.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include <memory>
@@ -53,6 +58,78 @@ void SetExtraParameters(knn_jni::JNIUtilInterface * jniUtil, JNIEnv *env,
     }
 }
 
+namespace {
+
+// Scalar quantizer index holding the int8 values of byte vectors as they are, with 8bit_direct_signed codes, or nullptr
+faiss::IndexScalarQuantizer * asInt8DirectSigned(faiss::Index * index, int dim) {
+    auto * sqIndex = dynamic_cast<faiss::IndexScalarQuantizer *>(index);
+    if (sqIndex != nullptr && sqIndex->sq.qtype == faiss::ScalarQuantizer::QT_8bit_direct_signed
+        && sqIndex->code_size == (size_t) dim) {
+        return sqIndex;
+    }
+    return nullptr;
+}
+
+void appendInt8DirectSignedCodes(faiss::IndexScalarQuantizer * sqIndex, const int8_t * vectors, int numVectors) {
+    const size_t codesOffset = sqIndex->codes.size();
+    sqIndex->codes.resize(codesOffset + (size_t) numVectors * sqIndex->code_size);
+    faiss_util::encodeInt8DirectSigned(vectors, (size_t) numVectors * sqIndex->code_size,
+                                       sqIndex->codes.data() + codesOffset);
+    sqIndex->ntotal += numVectors;
+}
+
+// Storage an IndexHNSW adds vectors to when their codes were already appended to its actual storage. Adding only
+// counts the vectors, so that IndexHNSW::add inserts their graph vertices, and distances are computed by the actual
+// storage.
+struct AddedCodesStorage : faiss::Index {
+    const faiss::Index * storage;
+
+    explicit AddedCodesStorage(const faiss::Index * _storage)
+        : faiss::Index(_storage->d, _storage->metric_type), storage(_storage) {
+        metric_arg = _storage->metric_arg;
+        ntotal = _storage->ntotal;
+    }
+
+    void add(faiss::idx_t n, const float * x) override {
+        ntotal += n;
+    }
+
+    void search(faiss::idx_t n, const float * x, faiss::idx_t k, float * distances, faiss::idx_t * labels,
+                const faiss::SearchParameters * params) const override {
+        throw std::runtime_error("search() is not supported while the codes are added");
+    }
+
+    void reset() override {
+        throw std::runtime_error("reset() is not supported while the codes are added");
+    }
+
+    faiss::DistanceComputer * get_distance_computer() const override {
+        return storage->get_distance_computer();
+    }
+};
+
+// Swaps the storage of an IndexHNSW for as long as it is in scope
+class StorageSwap {
+public:
+    StorageSwap(faiss::IndexHNSW * _index, faiss::Index * storage) : index(_index), previous(_index->storage) {
+        index->storage = storage;
+    }
+
+    StorageSwap(const StorageSwap &) = delete;
+
+    StorageSwap &operator=(const StorageSwap &) = delete;
+
+    ~StorageSwap() {
+        index->storage = previous;
+    }
+
+private:
+    faiss::IndexHNSW * index;
+    faiss::Index * previous;
+};
+
+}  // namespace
+
 IndexService::IndexService(std::unique_ptr<FaissMethods> _faissMethods) : faissMethods(std::move(_faissMethods)) {}
 
 void IndexService::allocIndex(faiss::Index * index, size_t dim, size_t numVectors) {
@@ -115,7 +192,7 @@ void IndexService::insertToIndex(
         jlong idMapAddress
     ) {
     // Read vectors from memory address
-    std::vector<float> * inputVectors = reinterpret_cast<std::vector<float>*>(vectorsAddress);
+    auto *inputVectors = reinterpret_cast<knn_jni::memory::VectorBuffer<float>*>(vectorsAddress);
 
     // The number of vectors can be int here because a lucene segment number of total docs never crosses INT_MAX value
     int numVectors = (int) (inputVectors->size() / (uint64_t) dim);
@@ -155,6 +232,10 @@ void IndexService::writeIndex(
     }
 }
 
+bool IndexService::reorderIndex(jlong idMapAddress) {
+    return faiss_util::reorderIndexIDMapHNSW(reinterpret_cast<faiss::IndexIDMap *>(idMapAddress));
+}
+
 BinaryIndexService::BinaryIndexService(std::unique_ptr<FaissMethods> _faissMethods)
   : IndexService(std::move(_faissMethods)) {
 }
@@ -212,7 +293,7 @@ void BinaryIndexService::insertToIndex(
         jlong idMapAddress
     ) {
     // Read vectors from memory address (unique ptr since we want to remove from memory after use)
-    std::vector<uint8_t> * inputVectors = reinterpret_cast<std::vector<uint8_t>*>(vectorsAddress);
+    auto *inputVectors = reinterpret_cast<knn_jni::memory::VectorBuffer<uint8_t>*>(vectorsAddress);
 
     // The number of vectors can be int here because a lucene segment number of total docs never crosses INT_MAX value
     int numVectors = (int) (inputVectors->size() / (uint64_t) (dim / 8));
@@ -252,6 +333,10 @@ void BinaryIndexService::writeIndex(
     }
 }
 
+bool BinaryIndexService::reorderIndex(jlong idMapAddress) {
+    return faiss_util::reorderIndexBinaryIDMapHNSW(reinterpret_cast<faiss::IndexBinaryIDMap *>(idMapAddress));
+}
+
 ByteIndexService::ByteIndexService(std::unique_ptr<FaissMethods> _faissMethods)
   : IndexService(std::move(_faissMethods)) {
 }
@@ -311,7 +396,7 @@ void ByteIndexService::insertToIndex(
         jlong idMapAddress
     ) {
     // Read vectors from memory address
-    auto *inputVectors = reinterpret_cast<std::vector<int8_t>*>(vectorsAddress);
+    auto *inputVectors = reinterpret_cast<knn_jni::memory::VectorBuffer<int8_t>*>(vectorsAddress);
 
     // The number of vectors can be int here because a lucene segment number of total docs never crosses INT_MAX value
     int numVectors = inputVectors->size() / dim;
@@ -330,25 +415,41 @@ void ByteIndexService::insertToIndex(
 
     faiss::IndexIDMap * idMap = reinterpret_cast<faiss::IndexIDMap *> (idMapAddress);
 
+    // A 8bit_direct_signed scalar quantizer stores the int8 values as they are, so its codes are written directly
+    // instead of quantizing floats widened from the same values
+    if (auto * sqIndex = asInt8DirectSigned(idMap->index, dim)) {
+        appendInt8DirectSignedCodes(sqIndex, inputVectors->data(), numVectors);
+        idMap->id_map.insert(idMap->id_map.end(), ids.begin(), ids.end());
+        idMap->ntotal = sqIndex->ntotal;
+        return;
+    }
+
+    // The same goes for the storage of an HNSW index, though its graph is still built from the widened floats
+    auto * hnswIndex = dynamic_cast<faiss::IndexHNSW *>(idMap->index);
+    auto * hnswStorage = hnswIndex == nullptr ? nullptr : asInt8DirectSigned(hnswIndex->storage, dim);
+    std::unique_ptr<AddedCodesStorage> addedCodesStorage;
+    std::unique_ptr<StorageSwap> storageSwap;
+    if (hnswStorage != nullptr) {
+        addedCodesStorage = std::make_unique<AddedCodesStorage>(hnswStorage);
+        storageSwap = std::make_unique<StorageSwap>(hnswIndex, addedCodesStorage.get());
+    }
+
     // Add vectors in batches by casting int8 vectors into float with a batch size of 1000 to avoid additional memory spike.
     // Refer to this github issue for more details https://github.com/opensearch-project/k-NN/issues/1659#issuecomment-2307390255
     int batchSize = 1000;
     std::vector <float> inputFloatVectors(batchSize * dim);
-    std::vector <int64_t> floatVectorsIds(batchSize);
-    auto iter = inputVectors->begin();
 
     for (int id = 0; id < numVectors; id += batchSize) {
         if (numVectors - id < batchSize) {
             batchSize = numVectors - id;
         }
 
-        for (int i = 0; i < batchSize; ++i) {
-            floatVectorsIds[i] = ids[id + i];
-            for (int j = 0; j < dim; ++j, ++iter) {
-                inputFloatVectors[i * dim + j] = static_cast<float>(*iter);
-            }
+        const int8_t * batchVectors = inputVectors->data() + (size_t) id * dim;
+        faiss_util::convertInt8ToFloat(batchVectors, (size_t) batchSize * dim, inputFloatVectors.data());
+        if (hnswStorage != nullptr) {
+            appendInt8DirectSignedCodes(hnswStorage, batchVectors, batchSize);
         }
-        idMap->add_with_ids(batchSize, inputFloatVectors.data(), floatVectorsIds.data());
+        idMap->add_with_ids(batchSize, inputFloatVectors.data(), ids.data() + id);
     }
 }
 
@@ -368,5 +469,79 @@ void ByteIndexService::writeIndex(
         throw std::runtime_error("Failed to write index to disk");
     }
 }
+
+IngestionSession::IngestionSession(std::unique_ptr<IndexService> _indexService, jlong _idMapAddress, int _dim,
+                                   int _threadCount, int _maxPendingBatches)
+    : indexService(std::move(_indexService)),
+      idMapAddress(_idMapAddress),
+      dim(_dim),
+      threadCount(_threadCount),
+      maxPendingBatches(std::max(_maxPendingBatches, 1)),
+      inserter(&IngestionSession::run, this) {
+}
+
+void IngestionSession::submit(int64_t vectorsAddress, std::vector<int64_t> ids) {
+    std::unique_lock<std::mutex> lock(mutex);
+    // Back-pressure, the caller may only reuse the memory of a batch once it is inserted
+    batchDone.wait(lock, [this] { return pending.size() < maxPendingBatches || error; });
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (finishing) {
+        throw std::runtime_error("Ingestion session is already finished");
+    }
+    pending.push_back(Batch{vectorsAddress, std::move(ids)});
+    batchQueued.notify_one();
+}
+
+void IngestionSession::finish() {
+    stop();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+IngestionSession::~IngestionSession() {
+    stop();
+}
+
+void IngestionSession::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        finishing = true;
+    }
+    batchQueued.notify_one();
+    if (inserter.joinable()) {
+        inserter.join();
+    }
+}
+
+void IngestionSession::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        batchQueued.wait(lock, [this] { return !pending.empty() || finishing; });
+        if (pending.empty()) {
+            return;
+        }
+
+        // References to the front survive the batches pushed while the lock is released
+        Batch& batch = pending.front();
+        lock.unlock();
+        try {
+            indexService->insertToIndex(dim, (int) batch.ids.size(), threadCount, batch.vectorsAddress, batch.ids,
+                                        idMapAddress);
+        } catch (...) {
+            lock.lock();
+            error = std::current_exception();
+            pending.clear();
+            batchDone.notify_all();
+            return;
+        }
+        lock.lock();
+        pending.pop_front();
+        batchDone.notify_all();
+    }
+}
 } // namespace faiss_wrapper
 } // namesapce knn_jni
@@ -8,7 +8,312 @@
 // GitHub history for details.
 
 #include "faiss_util.h"
+#include "faiss_index_arena.h"
+#include "faiss/IndexBinaryFlat.h"
+#include "faiss/IndexFlat.h"
+#include "faiss/IndexFlatCodes.h"
+#include "faiss/IndexHNSW.h"
+#include "faiss/IndexIDMap.h"
+#include "faiss/impl/io.h"
 #include <algorithm>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <fstream>
+#include <string>
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define KNN_INT8_AVX2
+#include <immintrin.h>
+#endif
+
+namespace {
+// Values converted per OpenMP chunk, large enough for the thread start to be amortized
+constexpr size_t CONVERSION_CHUNK_SIZE = 64 * 1024;
+
+void convertInt8ToFloatScalar(const int8_t *src, size_t n, float *dst) {
+#pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = static_cast<float>(src[i]);
+    }
+}
+
+#ifdef KNN_INT8_AVX2
+bool hasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+// Only this kernel is compiled for AVX2, the rest of the library keeps the baseline instruction set
+__attribute__((target("avx2")))
+void convertInt8ToFloatAvx2(const int8_t *src, size_t n, float *dst) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m256i low = _mm256_cvtepi8_epi32(bytes);
+        __m256i high = _mm256_cvtepi8_epi32(_mm_srli_si128(bytes, 8));
+        _mm256_storeu_ps(dst + i, _mm256_cvtepi32_ps(low));
+        _mm256_storeu_ps(dst + i + 8, _mm256_cvtepi32_ps(high));
+    }
+    for (; i < n; ++i) {
+        dst[i] = static_cast<float>(src[i]);
+    }
+}
+#endif
+
+void convertInt8ToFloatChunk(const int8_t *src, size_t n, float *dst) {
+#ifdef KNN_INT8_AVX2
+    if (hasAvx2()) {
+        convertInt8ToFloatAvx2(src, n, dst);
+        return;
+    }
+#endif
+    convertInt8ToFloatScalar(src, n, dst);
+}
+
+// Bytes read per OpenMP iteration when warming up an index
+constexpr size_t WARMUP_SLICE_SIZE = 1024 * 1024;
+constexpr size_t DEFAULT_PAGE_SIZE = 4096;
+
+size_t getPageSize() {
+#ifndef _WIN32
+    static const size_t pageSize = sysconf(_SC_PAGESIZE) > 0 ? (size_t) sysconf(_SC_PAGESIZE) : DEFAULT_PAGE_SIZE;
+    return pageSize;
+#else
+    return DEFAULT_PAGE_SIZE;
+#endif
+}
+
+// Regions below this size are not placed on NUMA nodes, their pages are likely shared with unrelated allocations
+constexpr size_t MIN_PLACED_REGION_SIZE = 1024 * 1024;
+// Upper bound of the NUMA nodes placeMemoryRegions supports
+constexpr int MAX_NUMA_NODES = 1024;
+
+#ifdef __linux__
+// Applies the memory policy mode to the pages fully covered by the regions placeMemoryRegions handles
+bool bindMemoryRegions(const std::vector<faiss_util::MemoryRegion> &regions, int mode, const unsigned long *nodeMask,
+                       unsigned long maxNode, unsigned flags) {
+    const size_t pageSize = getPageSize();
+    for (const faiss_util::MemoryRegion &region : regions) {
+        if (region.data == nullptr || region.bytes < MIN_PLACED_REGION_SIZE) {
+            continue;
+        }
+        const auto address = reinterpret_cast<uintptr_t>(region.data);
+        const uintptr_t pageStart = (address + pageSize - 1) / pageSize * pageSize;
+        const uintptr_t pageEnd = (address + region.bytes) / pageSize * pageSize;
+        if (pageEnd <= pageStart) {
+            continue;
+        }
+        if (syscall(SYS_mbind, pageStart, pageEnd - pageStart, mode, nodeMask, maxNode, flags) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Reads the highest node id of a node list of sysfs, such as "0-1" or "0,2-3"
+int readMaxNumaNode(const std::string &path) {
+    std::ifstream file(path);
+    std::string nodes;
+    if (!std::getline(file, nodes)) {
+        return 0;
+    }
+    int maxNode = 0;
+    int current = 0;
+    bool inNumber = false;
+    for (char c : nodes) {
+        if (c >= '0' && c <= '9') {
+            current = current * 10 + (c - '0');
+            inNumber = true;
+        } else {
+            if (inNumber) {
+                maxNode = std::max(maxNode, current);
+            }
+            current = 0;
+            inNumber = false;
+        }
+    }
+    if (inNumber) {
+        maxNode = std::max(maxNode, current);
+    }
+    return std::min(maxNode, MAX_NUMA_NODES - 1);
+}
+#endif
+
+// Bytes copied per OpenMP iteration when deserializing an index
+constexpr size_t DESERIALIZATION_BLOCK_SIZE = 4 * 1024 * 1024;
+// Same bound faiss puts on the number of elements of a serialized vector
+constexpr uint64_t MAX_SERIALIZED_VECTOR_SIZE = uint64_t{1} << 40;
+
+// Position and number of elements of a serialized vector
+struct Section {
+    size_t offset;
+    size_t count;
+};
+
+// Forward cursor over serialized bytes. Reading past the end marks the cursor as failed instead of throwing, so that
+// unsupported or truncated inputs are detected before anything is allocated
+class ByteCursor {
+public:
+    ByteCursor(const uint8_t *data, size_t length) : data(data), length(length), offset(0), failed(data == nullptr) {}
+
+    template<typename T>
+    T read() {
+        T value {};
+        if (failed || length - offset < sizeof(T)) {
+            failed = true;
+            return value;
+        }
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return value;
+    }
+
+    // Skips a vector serialized as its number of elements followed by the elements, as faiss READVECTOR expects it.
+    // Vectors of the flat storage count 4 byte words, hence the separate count unit
+    Section skipVector(size_t elementSize, size_t countUnit = 1) {
+        const auto count = read<uint64_t>();
+        if (failed || count >= MAX_SERIALIZED_VECTOR_SIZE) {
+            failed = true;
+            return Section {0, 0};
+        }
+        const Section section {offset, (size_t) count * countUnit};
+        if ((length - offset) / elementSize < section.count) {
+            failed = true;
+            return Section {0, 0};
+        }
+        offset += section.count * elementSize;
+        return section;
+    }
+
+    bool isValid() const {
+        return !failed;
+    }
+
+private:
+    const uint8_t *data;
+    size_t length;
+    size_t offset;
+    bool failed;
+};
+
+// Fields written by faiss write_index_header
+struct IndexHeader {
+    int d;
+    int64_t ntotal;
+    bool isTrained;
+    int metricType;
+    float metricArg;
+};
+
+IndexHeader readIndexHeader(ByteCursor *cursor) {
+    IndexHeader header {};
+    header.d = cursor->read<int>();
+    header.ntotal = cursor->read<int64_t>();
+    // Two deprecated fields
+    cursor->read<int64_t>();
+    cursor->read<int64_t>();
+    header.isTrained = cursor->read<uint8_t>() != 0;
+    header.metricType = cursor->read<int>();
+    if (header.metricType > 1) {
+        header.metricArg = cursor->read<float>();
+    }
+    return header;
+}
+
+void applyIndexHeader(const IndexHeader &header, faiss::Index *index) {
+    index->d = header.d;
+    index->ntotal = header.ntotal;
+    index->is_trained = header.isTrained;
+    index->metric_type = (faiss::MetricType) header.metricType;
+    if (header.metricType > 1) {
+        index->metric_arg = header.metricArg;
+    }
+    index->verbose = false;
+}
+
+faiss::IndexFlat *createFlatStorage(uint32_t h) {
+    if (h == faiss::fourcc("IxF2")) {
+        return new faiss::IndexFlatL2();
+    }
+    if (h == faiss::fourcc("IxFI")) {
+        return new faiss::IndexFlatIP();
+    }
+    if (h == faiss::fourcc("IxFl")) {
+        return new faiss::IndexFlat();
+    }
+    return nullptr;
+}
+
+template<typename V>
+std::function<void()> resizeTask(V *vector, size_t count) {
+    return [vector, count]() { vector->resize(count); };
+}
+
+// Runs the tasks on the OpenMP threads and rethrows the first exception, which must not escape the parallel region.
+// The tasks allocate from the arena of the calling thread, if any.
+void runConcurrently(const std::vector<std::function<void()>> &tasks) {
+    std::exception_ptr error;
+    knn_jni::memory::IndexArena *arena = knn_jni::memory::IndexArenaScope::current();
+    const auto numTasks = (int64_t) tasks.size();
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t i = 0; i < numTasks; ++i) {
+        try {
+            knn_jni::memory::IndexArenaScope arenaScope(arena);
+            tasks[i]();
+        } catch (...) {
+#pragma omp critical
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Move the rows of rowSize elements of rows so that row i holds the row order[i] held before
+template<typename V>
+void permuteRows(V *rows, size_t rowSize, const std::vector<faiss::idx_t> &order) {
+    V permuted;
+    permuted.resize(rows->size());
+    const auto numRows = (int64_t) order.size();
+#pragma omp parallel for if (numRows * rowSize > CONVERSION_CHUNK_SIZE)
+    for (int64_t i = 0; i < numRows; ++i) {
+        std::memcpy(permuted.data() + i * rowSize, rows->data() + order[i] * rowSize,
+                    rowSize * sizeof(*rows->data()));
+    }
+    *rows = std::move(permuted);
+}
+
+struct CopyBlock {
+    const uint8_t *src;
+    uint8_t *dst;
+    size_t bytes;
+};
+
+void addCopyBlocks(const uint8_t *data, const Section &section, size_t elementSize, void *dst,
+                   std::vector<CopyBlock> *blocks) {
+    const size_t bytes = section.count * elementSize;
+    for (size_t offset = 0; offset < bytes; offset += DESERIALIZATION_BLOCK_SIZE) {
+        blocks->push_back(CopyBlock {data + section.offset + offset, static_cast<uint8_t *>(dst) + offset,
+                                     std::min(DESERIALIZATION_BLOCK_SIZE, bytes - offset)});
+    }
+}
+}
 
 std::unique_ptr<faiss::IDGrouperBitmap> faiss_util::buildIDGrouperBitmap(int *parentIdsArray,  int parentIdsLength, std::vector<uint64_t>* bitmap) {
     const int* maxValue = std::max_element(parentIdsArray, parentIdsArray + parentIdsLength);
@@ -21,3 +326,284 @@ std::unique_ptr<faiss::IDGrouperBitmap> faiss_util::buildIDGrouperBitmap(int *pa
     }
     return idGrouper;
 }
+
+void faiss_util::convertInt8ToFloat(const int8_t *src, size_t n, float *dst) {
+    const int64_t numChunks = (int64_t) ((n + CONVERSION_CHUNK_SIZE - 1) / CONVERSION_CHUNK_SIZE);
+#pragma omp parallel for if (numChunks > 1)
+    for (int64_t chunk = 0; chunk < numChunks; ++chunk) {
+        const size_t offset = (size_t) chunk * CONVERSION_CHUNK_SIZE;
+        convertInt8ToFloatChunk(src + offset, std::min(CONVERSION_CHUNK_SIZE, n - offset), dst + offset);
+    }
+}
+
+void faiss_util::encodeInt8DirectSigned(const int8_t *src, size_t n, uint8_t *dst) {
+    // value + 128 over an unsigned byte is the two's complement value with its sign bit flipped
+#pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = static_cast<uint8_t>(src[i]) ^ 0x80;
+    }
+}
+
+faiss::Index *faiss_util::readIndexIDMapHNSWFlat(const uint8_t *data, size_t length) {
+    // Walk the section headers, in the order of faiss read_index, and only remember where the arrays are
+    ByteCursor cursor(data, length);
+    if (cursor.read<uint32_t>() != faiss::fourcc("IxMp")) {
+        return nullptr;
+    }
+    const IndexHeader idMapHeader = readIndexHeader(&cursor);
+    if (cursor.read<uint32_t>() != faiss::fourcc("IHNf")) {
+        return nullptr;
+    }
+    const IndexHeader hnswHeader = readIndexHeader(&cursor);
+    const Section assignProbas = cursor.skipVector(sizeof(double));
+    const Section cumNeighborsPerLevel = cursor.skipVector(sizeof(int));
+    const Section levels = cursor.skipVector(sizeof(int));
+    const Section offsets = cursor.skipVector(sizeof(size_t));
+    const Section neighbors = cursor.skipVector(sizeof(faiss::HNSW::storage_idx_t));
+    const auto entryPoint = cursor.read<faiss::HNSW::storage_idx_t>();
+    const auto maxLevel = cursor.read<int>();
+    const auto efConstruction = cursor.read<int>();
+    const auto efSearch = cursor.read<int>();
+    // Deprecated upper_beam
+    cursor.read<int>();
+    const auto storageFourcc = cursor.read<uint32_t>();
+    const IndexHeader storageHeader = readIndexHeader(&cursor);
+    const Section codes = cursor.skipVector(sizeof(uint8_t), sizeof(float));
+    const Section idMapIds = cursor.skipVector(sizeof(faiss::idx_t));
+
+    std::unique_ptr<faiss::IndexFlat> storage(createFlatStorage(storageFourcc));
+    const auto ntotal = (size_t) hnswHeader.ntotal;
+    // Bytes following the index, like the Lucene footer, are not part of it
+    if (!cursor.isValid() || storage == nullptr || hnswHeader.ntotal < 0
+        || levels.count != ntotal || offsets.count != ntotal + 1 || idMapIds.count != ntotal
+        || codes.count != (size_t) storageHeader.ntotal * storageHeader.d * sizeof(float)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<faiss::IndexHNSWFlat> hnswIndex(new faiss::IndexHNSWFlat());
+    std::unique_ptr<faiss::IndexIDMap> idMap(new faiss::IndexIDMap());
+    applyIndexHeader(idMapHeader, idMap.get());
+    applyIndexHeader(hnswHeader, hnswIndex.get());
+    applyIndexHeader(storageHeader, storage.get());
+    storage->code_size = storage->d * sizeof(float);
+
+    faiss::HNSW &hnsw = hnswIndex->hnsw;
+    hnsw.assign_probas.resize(assignProbas.count);
+    std::memcpy(hnsw.assign_probas.data(), data + assignProbas.offset, assignProbas.count * sizeof(double));
+    hnsw.cum_nneighbor_per_level.resize(cumNeighborsPerLevel.count);
+    std::memcpy(hnsw.cum_nneighbor_per_level.data(), data + cumNeighborsPerLevel.offset,
+                cumNeighborsPerLevel.count * sizeof(int));
+    hnsw.entry_point = entryPoint;
+    hnsw.max_level = maxLevel;
+    hnsw.efConstruction = efConstruction;
+    hnsw.efSearch = efSearch;
+
+    // Zero filling the large arrays costs about as much as copying them, so they are sized concurrently as well
+    runConcurrently({
+        resizeTask(&hnsw.levels, levels.count),
+        resizeTask(&hnsw.offsets, offsets.count),
+        resizeTask(&hnsw.neighbors, neighbors.count),
+        resizeTask(&storage->codes, codes.count),
+        resizeTask(&idMap->id_map, idMapIds.count)
+    });
+
+    std::vector<CopyBlock> blocks;
+    addCopyBlocks(data, levels, sizeof(int), hnsw.levels.data(), &blocks);
+    addCopyBlocks(data, offsets, sizeof(size_t), hnsw.offsets.data(), &blocks);
+    addCopyBlocks(data, neighbors, sizeof(faiss::HNSW::storage_idx_t), hnsw.neighbors.data(), &blocks);
+    addCopyBlocks(data, codes, sizeof(uint8_t), storage->codes.data(), &blocks);
+    addCopyBlocks(data, idMapIds, sizeof(faiss::idx_t), idMap->id_map.data(), &blocks);
+    const auto numBlocks = (int64_t) blocks.size();
+#pragma omp parallel for schedule(dynamic) if (numBlocks > 1)
+    for (int64_t i = 0; i < numBlocks; ++i) {
+        std::memcpy(blocks[i].dst, blocks[i].src, blocks[i].bytes);
+    }
+
+    hnswIndex->storage = storage.release();
+    hnswIndex->own_fields = true;
+    idMap->index = hnswIndex.release();
+    idMap->own_fields = true;
+    return idMap.release();
+}
+
+std::vector<faiss::idx_t> faiss_util::computeHNSWLocalityOrder(const faiss::HNSW &hnsw) {
+    const auto ntotal = (faiss::idx_t) hnsw.levels.size();
+    std::vector<faiss::idx_t> order;
+    order.reserve(ntotal);
+    std::vector<bool> visited(ntotal, false);
+    // The order doubles as the queue of the breadth first search
+    const auto visitFrom = [&](faiss::idx_t start) {
+        visited[start] = true;
+        order.push_back(start);
+        for (size_t head = order.size() - 1; head < order.size(); ++head) {
+            size_t begin, end;
+            hnsw.neighbor_range(order[head], 0, &begin, &end);
+            for (size_t i = begin; i < end && hnsw.neighbors[i] >= 0; ++i) {
+                const faiss::idx_t neighbor = hnsw.neighbors[i];
+                if (!visited[neighbor]) {
+                    visited[neighbor] = true;
+                    order.push_back(neighbor);
+                }
+            }
+        }
+    };
+
+    if (hnsw.entry_point >= 0 && hnsw.entry_point < ntotal) {
+        visitFrom(hnsw.entry_point);
+    }
+    for (faiss::idx_t node = 0; node < ntotal; ++node) {
+        if (!visited[node]) {
+            visitFrom(node);
+        }
+    }
+    return order;
+}
+
+void faiss_util::permuteHNSW(faiss::HNSW *hnsw, const std::vector<faiss::idx_t> &order) {
+    const auto ntotal = (int64_t) order.size();
+    if ((size_t) ntotal != hnsw->levels.size()) {
+        throw std::runtime_error("Order does not cover the nodes of the graph");
+    }
+    std::vector<faiss::HNSW::storage_idx_t> newIds(ntotal);
+    for (int64_t i = 0; i < ntotal; ++i) {
+        newIds[order[i]] = (faiss::HNSW::storage_idx_t) i;
+    }
+
+    // Every node keeps the same number of neighbor slots, only their position moves
+    decltype(hnsw->offsets) offsets;
+    offsets.resize(ntotal + 1);
+    offsets[0] = 0;
+    for (int64_t i = 0; i < ntotal; ++i) {
+        offsets[i + 1] = offsets[i] + hnsw->offsets[order[i] + 1] - hnsw->offsets[order[i]];
+    }
+
+    decltype(hnsw->levels) levels;
+    levels.resize(ntotal);
+    decltype(hnsw->neighbors) neighbors;
+    neighbors.resize(hnsw->neighbors.size());
+#pragma omp parallel for schedule(dynamic, 4096) if (ntotal > 4096)
+    for (int64_t i = 0; i < ntotal; ++i) {
+        levels[i] = hnsw->levels[order[i]];
+        size_t slot = offsets[i];
+        for (size_t j = hnsw->offsets[order[i]]; j < hnsw->offsets[order[i] + 1]; ++j, ++slot) {
+            const auto neighbor = hnsw->neighbors[j];
+            neighbors[slot] = neighbor >= 0 ? newIds[neighbor] : neighbor;
+        }
+    }
+
+    hnsw->levels = std::move(levels);
+    hnsw->offsets = std::move(offsets);
+    hnsw->neighbors = std::move(neighbors);
+    if (hnsw->entry_point >= 0) {
+        hnsw->entry_point = newIds[hnsw->entry_point];
+    }
+}
+
+bool faiss_util::reorderIndexIDMapHNSW(faiss::IndexIDMap *idMap) {
+    auto *hnswIndex = dynamic_cast<faiss::IndexHNSW *>(idMap->index);
+    auto *storage = hnswIndex == nullptr ? nullptr : dynamic_cast<faiss::IndexFlatCodes *>(hnswIndex->storage);
+    if (storage == nullptr || hnswIndex->hnsw.levels.size() != idMap->id_map.size()
+        || storage->codes.size() != idMap->id_map.size() * storage->code_size) {
+        return false;
+    }
+
+    const std::vector<faiss::idx_t> order = computeHNSWLocalityOrder(hnswIndex->hnsw);
+    permuteHNSW(&hnswIndex->hnsw, order);
+    permuteRows(&storage->codes, storage->code_size, order);
+    permuteRows(&idMap->id_map, 1, order);
+    return true;
+}
+
+bool faiss_util::reorderIndexBinaryIDMapHNSW(faiss::IndexBinaryIDMap *idMap) {
+    auto *hnswIndex = dynamic_cast<faiss::IndexBinaryHNSW *>(idMap->index);
+    auto *storage = hnswIndex == nullptr ? nullptr : dynamic_cast<faiss::IndexBinaryFlat *>(hnswIndex->storage);
+    if (storage == nullptr || hnswIndex->hnsw.levels.size() != idMap->id_map.size()
+        || storage->xb.size() != idMap->id_map.size() * storage->code_size) {
+        return false;
+    }
+
+    const std::vector<faiss::idx_t> order = computeHNSWLocalityOrder(hnswIndex->hnsw);
+    permuteHNSW(&hnswIndex->hnsw, order);
+    permuteRows(&storage->xb, storage->code_size, order);
+    permuteRows(&idMap->id_map, 1, order);
+    return true;
+}
+
+size_t faiss_util::warmMemoryRegions(const std::vector<MemoryRegion> &regions, bool touch) {
+    const size_t pageSize = getPageSize();
+    size_t totalBytes = 0;
+    std::vector<MemoryRegion> slices;
+    for (const MemoryRegion &region : regions) {
+        if (region.data == nullptr || region.bytes == 0) {
+            continue;
+        }
+        totalBytes += region.bytes;
+        const auto address = reinterpret_cast<uintptr_t>(region.data);
+#ifdef MADV_WILLNEED
+        // madvise takes page aligned addresses. Failures are ignored, the pages are still read below if asked to
+        const uintptr_t pageStart = address / pageSize * pageSize;
+        madvise(reinterpret_cast<void *>(pageStart), address + region.bytes - pageStart, MADV_WILLNEED);
+#endif
+        for (size_t offset = 0; touch && offset < region.bytes; offset += WARMUP_SLICE_SIZE) {
+            slices.push_back(MemoryRegion {
+                reinterpret_cast<const uint8_t *>(region.data) + offset,
+                std::min(WARMUP_SLICE_SIZE, region.bytes - offset)
+            });
+        }
+    }
+
+    // The sum keeps the reads from being optimized away
+    uint64_t checksum = 0;
+    const auto numSlices = (int64_t) slices.size();
+#pragma omp parallel for schedule(dynamic) reduction(+:checksum) if (numSlices > 1)
+    for (int64_t i = 0; i < numSlices; ++i) {
+        const auto *bytes = static_cast<const volatile uint8_t *>(slices[i].data);
+        for (size_t offset = 0; offset < slices[i].bytes; offset += pageSize) {
+            checksum += bytes[offset];
+        }
+        checksum += bytes[slices[i].bytes - 1];
+    }
+    volatile uint64_t sink = checksum;
+    (void) sink;
+    return totalBytes;
+}
+
+int faiss_util::getNumaNodeCount() {
+#ifdef __linux__
+    static const int nodeCount = readMaxNumaNode("/sys/devices/system/node/online") + 1;
+    return nodeCount;
+#else
+    return 1;
+#endif
+}
+
+bool faiss_util::placeMemoryRegions(const std::vector<MemoryRegion> &regions, int node) {
+#ifdef __linux__
+    const int nodeCount = getNumaNodeCount();
+    if (nodeCount <= 1 || node >= nodeCount || node < -1) {
+        return false;
+    }
+
+    constexpr size_t BITS_PER_WORD = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> nodeMask((nodeCount + BITS_PER_WORD - 1) / BITS_PER_WORD, 0);
+    for (int i = 0; i < nodeCount; ++i) {
+        if (node == -1 || node == i) {
+            nodeMask[i / BITS_PER_WORD] |= 1UL << (i % BITS_PER_WORD);
+        }
+    }
+    const int mode = node == -1 ? MPOL_INTERLEAVE : MPOL_BIND;
+    // The node mask is one bit larger than the nodes, as the kernel drops the last bit of maxnode
+    return bindMemoryRegions(regions, mode, nodeMask.data(), nodeMask.size() * BITS_PER_WORD + 1, MPOL_MF_MOVE);
+#else
+    return false;
+#endif
+}
+
+bool faiss_util::resetMemoryRegions(const std::vector<MemoryRegion> &regions) {
+#ifdef __linux__
+    // The pages stay where they are, only the memory reusing them once they are freed is no longer bound
+    return bindMemoryRegions(regions, MPOL_DEFAULT, nullptr, 0, 0);
+#else
+    return false;
+#endif
+}
@@ -12,8 +12,10 @@
 #include "jni_util.h"
 #include "faiss_wrapper.h"
 #include "faiss_util.h"
+#include "faiss_index_compression.h"
 #include "faiss_index_service.h"
 #include "faiss_stream_support.h"
+#include "vector_buffer_pool.h"
 
 #include "faiss/impl/io.h"
 #include "faiss/index_factory.h"
@@ -21,20 +23,47 @@
 #include "faiss/IndexHNSW.h"
 #include "faiss/IndexIVFFlat.h"
 #include "faiss/Index.h"
+#include "faiss/MetricType.h"
+#include "faiss/impl/AuxIndexStructures.h"
+#include "faiss/impl/DistanceComputer.h"
 #include "faiss/impl/IDSelector.h"
+#include "faiss/impl/ResultHandler.h"
 #include "faiss/IndexIVFPQ.h"
+#include "faiss/IndexPQ.h"
+#include "faiss/IndexScalarQuantizer.h"
+#include "faiss/invlists/InvertedLists.h"
+#include "faiss/utils/Heap.h"
+#include "faiss/utils/hamming.h"
 #include "commons.h"
 #include "faiss/IndexBinaryIVF.h"
 #include "faiss/IndexBinaryHNSW.h"
+#include "faiss/IndexBinaryFlat.h"
+#include "faiss/IndexFlatCodes.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <jni.h>
+#include <memory>
+#include <numeric>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+namespace {
+// Set by ConfigureIndexArenas
+std::atomic<bool> indexArenasEnabled(false);
+// Set by ConfigureCompactGraphs
+std::atomic<bool> compactGraphsEnabled(false);
+}
+
 // Defines type of IDSelector
 enum FilterIdsSelectorType{
-    BITMAP = 0, BATCH = 1,
+    BITMAP = 0, BATCH = 1, SORTED_ARRAY = 2,
 };
 namespace faiss {
 
@@ -64,6 +93,59 @@ struct IDSelectorJlongBitmap : IDSelector {
     }
 };  // class IDSelectorJlongBitmap
 
+// Bitmap selector owning its words, for a sorted id list dense enough that setting one bit per id costs no more than
+// reading the list
+struct IDSelectorDensifiedJlongBitmap : IDSelector {
+    std::vector<jlong> bitmap;
+
+    /** Construct from ids sorted in ascending order
+     *
+     * @param n number of ids
+     * @param ids sorted ids
+     */
+    IDSelectorDensifiedJlongBitmap(size_t n, const jlong* ids)
+      : IDSelector(),
+        bitmap(n == 0 ? 0 : (ids[n - 1] >> 6) + 1, 0) {
+        for (size_t i = 0; i < n; i++) {
+            bitmap[ids[i] >> 6] |= 1ULL << (ids[i] & 63);
+        }
+    }
+
+    bool is_member(idx_t id) const final {
+        const uint64_t index = id;
+        const uint64_t i = index >> 6ULL;  // div 64
+        if (i >= bitmap.size()) {
+            return false;
+        }
+        return (bitmap[i] >> (index & 63ULL)) & 1ULL;
+    }
+};  // class IDSelectorDensifiedJlongBitmap
+
+// Selector over ids sorted in ascending order, read in place. Unlike IDSelectorBatch, nothing is built per query,
+// membership is a binary search.
+struct IDSelectorJlongSortedArray : IDSelector {
+    size_t n;
+    const jlong* ids;
+
+    /** Construct with ids sorted in ascending order, like the doc ids of a Lucene BitSetIterator
+     *
+     * @param n number of ids
+     * @param ids sorted ids
+     */
+    IDSelectorJlongSortedArray(size_t _n, const jlong* _ids)
+      : IDSelector(),
+        n(_n),
+        ids(_ids) {
+    }
+
+    bool is_member(idx_t id) const final {
+        if (n == 0 || id < ids[0] || id > ids[n - 1]) {
+            return false;
+        }
+        return std::binary_search(ids, ids + n, (jlong) id);
+    }
+};  // class IDSelectorJlongSortedArray
+
 }  // namespace faiss
 
 
@@ -88,6 +170,233 @@ void buildFilterIdsBitMap(const int* filterIds, int filterIdsLength, uint8_t* bi
 
 std::unique_ptr<faiss::IDGrouperBitmap> buildIDGrouperBitmap(knn_jni::JNIUtilInterface * jniUtil, JNIEnv *env, jintArray parentIdsJ, std::vector<uint64_t>* bitmap);
 
+// Builds the IDSelector for filter ids passed either as a Lucene FixedBitSet (BITMAP), as an id list (BATCH) or as an
+// id list sorted in ascending order (SORTED_ARRAY)
+std::unique_ptr<faiss::IDSelector> buildIDSelector(const jlong* filterIds, size_t filterIdsLength, jint filterIdsType);
+
+// Filter ids of a single search call. The ids are either pinned from a Java long[] until the FilterIds goes out of
+// scope, or read in place from native memory, such as a direct ByteBuffer, whose lifetime the caller manages.
+class FilterIds {
+public:
+    // No filter
+    FilterIds() = default;
+
+    // Pins filterIdsJ if it is not null. GetLongArrayElements may copy the array, callers that want to avoid that
+    // copy for large filters should use fromDirectBuffer instead.
+    FilterIds(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlongArray filterIdsJ, jint filterIdsTypeJ);
+
+    // Reads length ids at ids in place, nothing is released by the FilterIds
+    FilterIds(const jlong * ids, size_t length, jint filterIdsTypeJ);
+
+    // Reads the ids from the direct ByteBuffer filterBufferJ in place. A null buffer means no filter.
+    static FilterIds fromDirectBuffer(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jobject filterBufferJ,
+                                      jint filterIdsTypeJ);
+
+    FilterIds(const FilterIds&) = delete;
+    FilterIds& operator=(const FilterIds&) = delete;
+
+    ~FilterIds();
+
+    // Returns the IDSelector reading the ids, or nullptr when there is no filter. It must not outlive the FilterIds.
+    std::unique_ptr<faiss::IDSelector> buildIDSelector() const;
+
+    const jlong * getIds() const { return ids; }
+    size_t getLength() const { return length; }
+    jint getType() const { return type; }
+
+private:
+    knn_jni::JNIUtilInterface * jniUtil = nullptr;
+    JNIEnv * env = nullptr;
+    jlongArray pinnedArrayJ = nullptr;
+    jlong * ids = nullptr;
+    size_t length = 0;
+    jint type = BITMAP;
+};
+
+// Orders scored vectors closest first for the metric, ties by label
+inline auto closerFirst(faiss::MetricType metric) {
+    const bool isSimilarity = faiss::is_similarity_metric(metric);
+    return [isSimilarity](const std::pair<float, faiss::idx_t>& a, const std::pair<float, faiss::idx_t>& b) {
+        if (a.first != b.first) {
+            return isSimilarity ? a.first > b.first : a.first < b.first;
+        }
+        return a.second < b.second;
+    };
+}
+
+// Returns the handle located in memory at indexPointerJ, checking that it holds a binary index if isBinary is true and
+// a float index otherwise
+knn_jni::faiss_wrapper::NativeIndexHandle * getIndexHandle(jlong indexPointerJ, bool isBinary);
+
+// Adds the graph, vector storage, inverted lists and id map of the index of indexHandle to regions
+void collectIndexRegions(const knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle,
+                         std::vector<faiss_util::MemoryRegion> * regions);
+
+// Searches the index of indexHandle with a few of its own vectors, or with the centroids of IVF indices
+void runWarmupQueries(const knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle);
+
+// Closes the arena of a load that failed, or that was not handed to the handle of the index yet
+struct IndexArenaCloser {
+    void operator()(knn_jni::memory::IndexArena * arena) const {
+        arena->close();
+    }
+};
+using LoadArena = std::unique_ptr<knn_jni::memory::IndexArena, IndexArenaCloser>;
+
+// Returns the arena a load reads its index into, nullptr when arenas are disabled or not supported
+LoadArena createLoadArena();
+
+// Converts the HNSW graph of a loaded index to compact neighbor lists when compact graphs are enabled
+void compactLoadedGraph(faiss::Index * index);
+void compactLoadedGraph(faiss::IndexBinary * index);
+
+// Bytes allocated by vector
+template<typename Vector>
+int64_t vectorBytes(const Vector & vector);
+
+// Adds the bytes of index and of the indices nested in it, such as the storage of HNSW indices, to usage
+void addIndexMemoryUsage(const faiss::Index * index, knn_jni::faiss_wrapper::IndexMemoryUsage * usage);
+void addIndexMemoryUsage(const faiss::IndexBinary * index, knn_jni::faiss_wrapper::IndexMemoryUsage * usage);
+
+// Resolves the search parameters for the index of indexHandle. Query params supersede the values provided during index
+// setting. hnswParams and ivfParams provide the storage, the returned pointer is one of them or nullptr if the index
+// type does not take search parameters. Works for both float and binary indices.
+faiss::SearchParameters * resolveSearchParameters(const knn_jni::commons::SearchParams& searchParams,
+                                                  const knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle,
+                                                  faiss::IDSelector * idSelector, faiss::IDGrouper * idGrouper,
+                                                  faiss::SearchParametersHNSW * hnswParams,
+                                                  faiss::SearchParametersIVF * ivfParams);
+
+// Copies the size elements of a query vector out of the Java heap. The array is only held critical for the copy, as
+// holding it for a whole search would keep the GC waiting for as long as the search takes.
+template<typename T>
+std::vector<T> copyQueryVector(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jarray queryVectorJ, size_t size);
+
+// Searches the k nearest neighbors of a single query against the index located in memory at indexPointerJ
+//
+// Returns the number of results found. ids and dis are padded with -1 beyond it
+int InternalQueryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ, jfloatArray queryVectorJ,
+                       jint kJ, const knn_jni::commons::SearchParams& searchParams, const FilterIds& filterIds,
+                       jintArray parentIdsJ, std::vector<float> * dis, std::vector<faiss::idx_t> * ids);
+
+// Binary counterpart of InternalQueryIndex
+int InternalQueryBinaryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ, jbyteArray queryVectorJ,
+                             jint kJ, const knn_jni::commons::SearchParams& searchParams, const FilterIds& filterIds,
+                             jintArray parentIdsJ, std::vector<int32_t> * dis, std::vector<faiss::idx_t> * ids);
+
+// Checks the arguments shared by the batch queries
+void checkQueryBatch(jarray queryVectorsJ, jint numQueriesJ, jint kJ, jintArray resultIdsJ, jfloatArray resultDistancesJ);
+
+// Searches the k nearest neighbors of numQueriesJ queries, laid out one after another in queryVectors, with a single
+// search call against the index of indexHandle. Queries of binary indices are codes, the others are floats. The results
+// are written row-major by query to the caller provided Java arrays, padded with -1.
+template<typename QueryT>
+void InternalQueryIndexBatch(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                             knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle,
+                             const std::vector<QueryT>& queryVectors, jint numQueriesJ, jint kJ,
+                             const knn_jni::commons::SearchParams& searchParams, const FilterIds& filterIds,
+                             jintArray parentIdsJ, jintArray resultIdsJ, jfloatArray resultDistancesJ);
+
+// Runs a range search of a single query against the index located in memory at indexPointerJ into dis and ids. At most
+// maxResultWindowJ hits within the radius are kept, which must be at least 1: the closest ones, closest first, for HNSW
+// and IVF indices, and the first ones in the order of their ids, as Faiss returns them, for indices whose vectors are
+// all scanned. With parentIdsJ, only the closest hit of each parent is kept.
+//
+// Returns the number of results
+int InternalRangeSearch(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong indexPointerJ, jfloatArray queryVectorJ,
+                        jfloat radiusJ, const knn_jni::commons::SearchParams& searchParams, jint maxResultWindowJ,
+                        const FilterIds& filterIds, jintArray parentIdsJ, std::vector<float> * dis,
+                        std::vector<faiss::idx_t> * ids);
+
+// Searches the quantizer of ivf for the lists to probe for query, at most nprobe of them, into listNos with their
+// coarse distances
+void probeIVFLists(const faiss::IndexIVF * ivf, const float * query, size_t nprobe, std::vector<faiss::idx_t> * listNos,
+                   std::vector<float> * coarseDis);
+
+// Binary counterpart of InternalRangeSearch. The hits are the vectors whose Hamming distance to the query is at most
+// radiusJ, at most maxResultWindowJ of them, closest first, for every kind of binary index.
+//
+// Returns the number of results
+int InternalRangeSearchBinaryIndex(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong indexPointerJ,
+                                   jbyteArray queryVectorJ, jfloat radiusJ,
+                                   const knn_jni::commons::SearchParams& searchParams, jint maxResultWindowJ,
+                                   const FilterIds& filterIds, jintArray parentIdsJ, std::vector<float> * dis,
+                                   std::vector<faiss::idx_t> * ids);
+
+// Range search of a single query against a binary IVF index keeping at most window of the hits of the probed lists
+// below the Hamming radius into result, only the closest hit of each group when there is a grouper. Faiss has no
+// bounded range search for binary inverted lists, so the hits are offered one by one to its bounded range handler.
+void binaryIVFRangeSearch(const faiss::IndexBinaryIVF * ivf, const uint8_t * query, int radius, size_t window,
+                          size_t nprobe, const faiss::IDSelector * idSelector, const faiss::IDGrouper * grouper,
+                          faiss::RangeSearchResult * result);
+
+// Same as binaryIVFRangeSearch for a binary flat index, whose codes are all scanned
+void binaryFlatRangeSearch(const faiss::IndexBinaryFlat * flat, const uint8_t * query, int radius, size_t window,
+                           const faiss::IDSelector * idSelector, const faiss::IDGrouper * grouper,
+                           faiss::RangeSearchResult * result);
+
+// Range search of a single query against an IVF index that never holds more than window hits. The hits are collected
+// in a heap of size window seeded with the radius, so hits outside the radius are rejected by the list scanners and
+// the bound tightens to the window-th closest hit once the heap is full.
+//
+// Returns the number of hits written to dis and labels, closest first
+size_t boundedIVFRangeSearch(const faiss::IndexIVF * ivf, const float * query, float radius, size_t window,
+                             size_t nprobe, const faiss::IDSelector * idSelector, float * dis, faiss::idx_t * labels);
+
+// Range search of a single query against an IVF index keeping the closest hit of each group of grouper, at most window
+// of them, into result. The hits of the probed lists are offered one by one to the bounded range handler of Faiss, as
+// the list scanners of Faiss do not take a grouper. C orders the distances of the metric of ivf, closest first.
+template<typename C>
+void groupedIVFRangeSearch(const faiss::IndexIVF * ivf, const float * query, float radius, size_t window,
+                           size_t nprobe, const faiss::IDSelector * idSelector, const faiss::IDGrouper * grouper,
+                           faiss::RangeSearchResult * result);
+
+// Copies the hits of the single query of result into dis and ids
+void copyRangeSearchResult(const faiss::RangeSearchResult & result, std::vector<float> * dis,
+                           std::vector<faiss::idx_t> * ids);
+
+// Range search of a single query scanning every vector of index, an index without a search structure, in the order of
+// their ids. The scan stops at window hits, which are the hits Faiss returns first. With a grouper, every vector is
+// scanned and the closest hit of each group takes the place of the first hit of the group. The filter and the grouper
+// take labels, which idMap maps internal ids to when it is not null.
+void scanRangeSearch(const faiss::Index * index, const float * query, float radius, size_t window,
+                     const faiss::IDSelector * idSelector, const faiss::IDGrouper * grouper,
+                     const std::vector<faiss::idx_t> * idMap, std::vector<float> * dis,
+                     std::vector<faiss::idx_t> * ids);
+
+// Copies the window closest of the n hits at labels and distances into dis and ids, closest first
+void keepClosestRangeResults(const faiss::idx_t * labels, const float * distances, size_t n, size_t window,
+                             faiss::MetricType metric, std::vector<float> * dis, std::vector<faiss::idx_t> * ids);
+
+// Returns the index whose distance computer scores the vectors of the float index of indexHandle by internal id
+faiss::Index * getExactSearchStorage(const knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle);
+
+// Collects the internal ids of the vectors of the float index of indexHandle passing filterIds. Id lists are mapped
+// to internal ids one by one when the labels allow it, otherwise every vector of the index is checked.
+std::vector<faiss::idx_t> collectExactSearchCandidates(const knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle,
+                                                       const FilterIds& filterIds);
+
+// Writes the first resultSize scored vectors to the caller provided Java arrays and returns resultSize
+jint setExactSearchResults(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                           const std::vector<std::pair<float, faiss::idx_t>>& scored, size_t resultSize,
+                           jintArray resultIdsJ, jfloatArray resultDistancesJ);
+
+// Scores the query against the vectors of the float index of indexHandle passing filterIds, straight from the index
+// storage. Returns the (distance, label) pairs of the scored vectors, in no particular order.
+std::vector<std::pair<float, faiss::idx_t>> InternalExactScore(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                               knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle,
+                                                               jfloatArray queryVectorJ, const FilterIds& filterIds);
+
+// Creates a KNNQueryResult array holding the first resultSize ids and distances
+template<typename DistanceT>
+jobjectArray buildKNNQueryResults(knn_jni::JNIUtilInterface * jniUtil, JNIEnv *env, const faiss::idx_t * ids,
+                                  const DistanceT * dis, int resultSize);
+
+// Copies the first resultSize ids and distances into the caller provided Java arrays
+template<typename DistanceT>
+void setQueryResults(knn_jni::JNIUtilInterface * jniUtil, JNIEnv *env, const faiss::idx_t * ids,
+                     const DistanceT * dis, int resultSize, jintArray resultIdsJ, jfloatArray resultDistancesJ);
+
 // Check if a loaded index is an IVFPQ index with l2 space type
 bool isIndexIVFPQL2(faiss::Index * index);
 
@@ -191,13 +500,65 @@ void knn_jni::faiss_wrapper::WriteIndex(knn_jni::JNIUtilInterface * jniUtil, JNI
     }
 
     // IndexOutput wrapper.
-    knn_jni::stream::NativeEngineIndexOutputMediator mediator {jniUtil, env, output};
-    knn_jni::stream::FaissOpenSearchIOWriter writer {&mediator};
+    auto mediator = knn_jni::stream::createIndexOutputMediator(jniUtil, env, output);
+    knn_jni::stream::FaissOpenSearchIOWriter writer {mediator.get(),
+                                                     knn_jni::stream::getIndexCompressionLevel(jniUtil, env, output)};
+
+    // Renumbering the graph only moves the nodes around, the index is written and loaded as before
+    if (knn_jni::stream::isGraphReorderRequested(jniUtil, env, output)) {
+        indexService->reorderIndex(index_ptr);
+    }
 
     // Create index.
     indexService->writeIndex(&writer, index_ptr);
 }
 
+jlong knn_jni::faiss_wrapper::StartIngestion(jlong indexAddr, jint dimJ, jint threadCount, jint maxPendingBatchesJ,
+                                            std::unique_ptr<IndexService> indexService) {
+    if (indexAddr == 0) {
+        throw std::runtime_error("Index address cannot be 0");
+    }
+
+    if(dimJ <= 0) {
+        throw std::runtime_error("Vectors dimensions cannot be less than or equal to 0");
+    }
+
+    if (maxPendingBatchesJ <= 0) {
+        throw std::runtime_error("Max pending batches must be greater than 0");
+    }
+
+    return reinterpret_cast<jlong>(new IngestionSession(std::move(indexService), indexAddr, (int) dimJ,
+                                                        (int) threadCount, (int) maxPendingBatchesJ));
+}
+
+void knn_jni::faiss_wrapper::SubmitToIngestion(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong sessionAddr,
+                                               jintArray idsJ, jlong vectorsAddressJ) {
+    if (sessionAddr == 0) {
+        throw std::runtime_error("Ingestion session cannot be null");
+    }
+
+    if (idsJ == nullptr) {
+        throw std::runtime_error("IDs cannot be null");
+    }
+
+    if (vectorsAddressJ <= 0) {
+        throw std::runtime_error("VectorsAddress cannot be less than 0");
+    }
+
+    // The ids are copied here as the inserter thread cannot call into the JVM
+    auto * session = reinterpret_cast<IngestionSession *>(sessionAddr);
+    session->submit((int64_t) vectorsAddressJ, jniUtil->ConvertJavaIntArrayToCppIntVector(env, idsJ));
+}
+
+void knn_jni::faiss_wrapper::FinishIngestion(jlong sessionAddr) {
+    if (sessionAddr == 0) {
+        throw std::runtime_error("Ingestion session cannot be null");
+    }
+
+    std::unique_ptr<IngestionSession> session(reinterpret_cast<IngestionSession *>(sessionAddr));
+    session->finish();
+}
+
 void knn_jni::faiss_wrapper::CreateIndexFromTemplate(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
                                                      jlong vectorsAddressJ, jint dimJ, jobject output,
                                                      jbyteArray templateIndexJ, jobject parametersJ) {
@@ -231,7 +592,7 @@ void knn_jni::faiss_wrapper::CreateIndexFromTemplate(knn_jni::JNIUtilInterface *
 
     // Read data set
     // Read vectors from memory address
-    auto *inputVectors = reinterpret_cast<std::vector<float>*>(vectorsAddressJ);
+    auto *inputVectors = reinterpret_cast<knn_jni::memory::VectorBuffer<float>*>(vectorsAddressJ);
     int dim = (int)dimJ;
     int numVectors = (int) (inputVectors->size() / (uint64_t) dim);
     int numIds = jniUtil->GetJavaIntArrayLength(env, idsJ);
@@ -256,16 +617,16 @@ void knn_jni::faiss_wrapper::CreateIndexFromTemplate(knn_jni::JNIUtilInterface *
     auto idVector = jniUtil->ConvertJavaIntArrayToCppIntVector(env, idsJ);
     faiss::IndexIDMap idMap =  faiss::IndexIDMap(indexWriter.get());
     idMap.add_with_ids(numVectors, inputVectors->data(), idVector.data());
-    // Releasing the vectorsAddressJ memory as that is not required once we have created the index.
-    // This is not the ideal approach, please refer this gh issue for long term solution:
-    // https://github.com/opensearch-project/k-NN/issues/1600
-    delete inputVectors;
+    // Hand the vectors back to the pool as they are not required once we have created the index. The buffer itself
+    // stays owned by the Java layer, which frees it
+    inputVectors->release();
 
     // Write the index to disk
-    knn_jni::stream::NativeEngineIndexOutputMediator mediator {jniUtil, env, output};
-    knn_jni::stream::FaissOpenSearchIOWriter writer {&mediator};
+    auto mediator = knn_jni::stream::createIndexOutputMediator(jniUtil, env, output);
+    knn_jni::stream::FaissOpenSearchIOWriter writer {mediator.get(),
+                                                     knn_jni::stream::getIndexCompressionLevel(jniUtil, env, output)};
     faiss::write_index(&idMap, &writer);
-    mediator.flush();
+    writer.flush();
 }
 
 void knn_jni::faiss_wrapper::CreateBinaryIndexFromTemplate(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
@@ -301,7 +662,7 @@ void knn_jni::faiss_wrapper::CreateBinaryIndexFromTemplate(knn_jni::JNIUtilInter
 
     // Read data set
     // Read vectors from memory address
-    auto *inputVectors = reinterpret_cast<std::vector<uint8_t>*>(vectorsAddressJ);
+    auto *inputVectors = reinterpret_cast<knn_jni::memory::VectorBuffer<uint8_t>*>(vectorsAddressJ);
     int dim = (int)dimJ;
     if (dim % 8 != 0) {
         throw std::runtime_error("Dimensions should be multiple of 8");
@@ -329,16 +690,16 @@ void knn_jni::faiss_wrapper::CreateBinaryIndexFromTemplate(knn_jni::JNIUtilInter
     auto idVector = jniUtil->ConvertJavaIntArrayToCppIntVector(env, idsJ);
     faiss::IndexBinaryIDMap idMap =  faiss::IndexBinaryIDMap(indexWriter.get());
     idMap.add_with_ids(numVectors, reinterpret_cast<const uint8_t*>(inputVectors->data()), idVector.data());
-    // Releasing the vectorsAddressJ memory as that is not required once we have created the index.
-    // This is not the ideal approach, please refer this gh issue for long term solution:
-    // https://github.com/opensearch-project/k-NN/issues/1600
-    delete inputVectors;
+    // Hand the vectors back to the pool as they are not required once we have created the index. The buffer itself
+    // stays owned by the Java layer, which frees it
+    inputVectors->release();
 
     // Write the index to disk
-    knn_jni::stream::NativeEngineIndexOutputMediator mediator {jniUtil, env, output};
-    knn_jni::stream::FaissOpenSearchIOWriter writer {&mediator};
+    auto mediator = knn_jni::stream::createIndexOutputMediator(jniUtil, env, output);
+    knn_jni::stream::FaissOpenSearchIOWriter writer {mediator.get(),
+                                                     knn_jni::stream::getIndexCompressionLevel(jniUtil, env, output)};
     faiss::write_index_binary(&idMap, &writer);
-    mediator.flush();
+    writer.flush();
 }
 
 void knn_jni::faiss_wrapper::CreateByteIndexFromTemplate(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jintArray idsJ,
@@ -375,7 +736,7 @@ void knn_jni::faiss_wrapper::CreateByteIndexFromTemplate(knn_jni::JNIUtilInterfa
 
     // Read data set
     // Read vectors from memory address
-    auto *inputVectors = reinterpret_cast<std::vector<int8_t>*>(vectorsAddressJ);
+    auto *inputVectors = reinterpret_cast<knn_jni::memory::VectorBuffer<int8_t>*>(vectorsAddressJ);
     auto dim = (int) dimJ;
     auto numVectors = (int) (inputVectors->size() / (uint64_t) dim);
     int numIds = jniUtil->GetJavaIntArrayLength(env, idsJ);
@@ -405,34 +766,71 @@ void knn_jni::faiss_wrapper::CreateByteIndexFromTemplate(knn_jni::JNIUtilInterfa
     // Refer to this github issue for more details https://github.com/opensearch-project/k-NN/issues/1659#issuecomment-2307390255
     int batchSize = 1000;
     std::vector <float> inputFloatVectors(batchSize * dim);
-    std::vector <int64_t> floatVectorsIds(batchSize);
-    int id = 0;
-    auto iter = inputVectors->begin();
 
     for (int id = 0; id < numVectors; id += batchSize) {
         if (numVectors - id < batchSize) {
             batchSize = numVectors - id;
         }
 
-        for (int i = 0; i < batchSize; ++i) {
-            floatVectorsIds[i] = ids[id + i];
-            for (int j = 0; j < dim; ++j, ++iter) {
-                inputFloatVectors[i * dim + j] = static_cast<float>(*iter);
-            }
-        }
-        idMap.add_with_ids(batchSize, inputFloatVectors.data(), floatVectorsIds.data());
+        faiss_util::convertInt8ToFloat(inputVectors->data() + (size_t) id * dim, (size_t) batchSize * dim,
+                                       inputFloatVectors.data());
+        idMap.add_with_ids(batchSize, inputFloatVectors.data(), ids.data() + id);
     }
 
-    // Releasing the vectorsAddressJ memory as that is not required once we have created the index.
-    // This is not the ideal approach, please refer this gh issue for long term solution:
-    // https://github.com/opensearch-project/k-NN/issues/1600
-    delete inputVectors;
+    // Hand the vectors back to the pool as they are not required once we have created the index. The buffer itself
+    // stays owned by the Java layer, which frees it
+    inputVectors->release();
 
     // Write the index to disk
-    knn_jni::stream::NativeEngineIndexOutputMediator mediator {jniUtil, env, output};
-    knn_jni::stream::FaissOpenSearchIOWriter writer {&mediator};
+    auto mediator = knn_jni::stream::createIndexOutputMediator(jniUtil, env, output);
+    knn_jni::stream::FaissOpenSearchIOWriter writer {mediator.get(),
+                                                     knn_jni::stream::getIndexCompressionLevel(jniUtil, env, output)};
     faiss::write_index(&idMap, &writer);
-    mediator.flush();
+    writer.flush();
+}
+
+knn_jni::faiss_wrapper::NativeIndexHandle::NativeIndexHandle(faiss::Index * index)
+        : index(index), isBinary(false), dimension(index->d), metric(index->metric_type) {
+    faiss::Index * innerIndex = index;
+    idMap = dynamic_cast<faiss::IndexIDMap *>(index);
+    if (idMap != nullptr) {
+        innerIndex = idMap->index;
+        idMapSorted = std::is_sorted(idMap->id_map.begin(), idMap->id_map.end());
+        if (!idMapSorted) {
+            const std::vector<faiss::idx_t> &labels = idMap->id_map;
+            labelOrder.resize(labels.size());
+            std::iota(labelOrder.begin(), labelOrder.end(), 0);
+            std::sort(labelOrder.begin(), labelOrder.end(),
+                      [&labels](faiss::idx_t a, faiss::idx_t b) { return labels[a] < labels[b]; });
+        }
+    }
+
+    if ((hnsw = dynamic_cast<faiss::IndexHNSW *>(innerIndex)) != nullptr) {
+        kind = IndexKind::HNSW;
+        defaultEfSearch = hnsw->hnsw.efSearch;
+    } else if ((ivf = dynamic_cast<faiss::IndexIVF *>(innerIndex)) != nullptr) {
+        kind = IndexKind::IVF;
+        defaultNprobe = ivf->nprobe;
+    }
+}
+
+knn_jni::faiss_wrapper::NativeIndexHandle::NativeIndexHandle(faiss::IndexBinary * binaryIndex)
+        : binaryIndex(binaryIndex), isBinary(true), dimension(binaryIndex->d), metric(binaryIndex->metric_type) {
+    faiss::IndexBinary * innerIndex = binaryIndex;
+    binaryIdMap = dynamic_cast<faiss::IndexBinaryIDMap *>(binaryIndex);
+    if (binaryIdMap != nullptr) {
+        innerIndex = binaryIdMap->index;
+    }
+
+    if ((binaryHnsw = dynamic_cast<faiss::IndexBinaryHNSW *>(innerIndex)) != nullptr) {
+        kind = IndexKind::HNSW;
+        defaultEfSearch = binaryHnsw->hnsw.efSearch;
+    } else if ((binaryIvf = dynamic_cast<faiss::IndexBinaryIVF *>(innerIndex)) != nullptr) {
+        kind = IndexKind::IVF;
+        defaultNprobe = binaryIvf->nprobe;
+    } else {
+        binaryFlat = dynamic_cast<faiss::IndexBinaryFlat *>(innerIndex);
+    }
 }
 
 jlong knn_jni::faiss_wrapper::LoadIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jstring indexPathJ) {
@@ -444,8 +842,44 @@ jlong knn_jni::faiss_wrapper::LoadIndex(knn_jni::JNIUtilInterface * jniUtil, JNI
     // Skipping IO_FLAG_PQ_SKIP_SDC_TABLE because the index is read only and the sdc table is only used during ingestion
     // Skipping IO_PRECOMPUTE_TABLE because it is only needed for IVFPQ-l2 and it leads to high memory consumption if
     // done for each segment. Instead, we will set it later on with `setSharedIndexState`
-    faiss::Index* indexReader = faiss::read_index(indexPathCpp.c_str(), faiss::IO_FLAG_READ_ONLY | faiss::IO_FLAG_PQ_SKIP_SDC_TABLE | faiss::IO_FLAG_SKIP_PRECOMPUTE_TABLE);
-    return (jlong) indexReader;
+#ifndef _WIN32
+    // Read through a memory mapping of the file, so the bytes come straight from the page cache
+    knn_jni::stream::FaissMappedFileIOReader fileReader(indexPathCpp);
+    // Compressed files are decompressed as a whole, all frames at once
+    faiss::VectorIOReader decompressedReader;
+    faiss::IOReader *reader = &fileReader;
+    const uint8_t *indexBytes = fileReader.data();
+    size_t indexLength = fileReader.size();
+    if (knn_jni::stream::isCompressedIndex(indexBytes, indexLength)) {
+        decompressedReader.data = knn_jni::stream::decompressIndex(indexBytes, indexLength);
+        reader = &decompressedReader;
+        indexBytes = decompressedReader.data.data();
+        indexLength = decompressedReader.data.size();
+    }
+    LoadArena arena = createLoadArena();
+    std::unique_ptr<faiss::Index> indexReader;
+    {
+        knn_jni::memory::IndexArenaScope arenaScope(arena.get());
+        // HNSW indexes of float vectors are copied out of the mapping by all OpenMP threads, others are read
+        // sequentially
+        indexReader.reset(faiss_util::readIndexIDMapHNSWFlat(indexBytes, indexLength));
+        if (indexReader == nullptr) {
+            indexReader.reset(faiss::read_index(reader, faiss::IO_FLAG_READ_ONLY | faiss::IO_FLAG_PQ_SKIP_SDC_TABLE | faiss::IO_FLAG_SKIP_PRECOMPUTE_TABLE));
+        }
+        // Converted within the scope, so that the compact lists live in the arena as well
+        compactLoadedGraph(indexReader.get());
+    }
+#else
+    faiss::FileIOReader fileReader(indexPathCpp.c_str());
+    knn_jni::stream::FaissDecompressingIOReader reader(&fileReader);
+    LoadArena arena;
+    std::unique_ptr<faiss::Index> indexReader(faiss::read_index(&reader, faiss::IO_FLAG_READ_ONLY | faiss::IO_FLAG_PQ_SKIP_SDC_TABLE | faiss::IO_FLAG_SKIP_PRECOMPUTE_TABLE));
+    compactLoadedGraph(indexReader.get());
+#endif
+    auto * indexHandle = new NativeIndexHandle(indexReader.get());
+    indexReader.release();
+    indexHandle->arena = arena.release();
+    return (jlong) indexHandle;
 }
 
 jlong knn_jni::faiss_wrapper::LoadIndexWithStream(faiss::IOReader* ioReader) {
@@ -453,13 +887,24 @@ jlong knn_jni::faiss_wrapper::LoadIndexWithStream(faiss::IOReader* ioReader) {
         throw std::runtime_error("IOReader cannot be null");
     }
 
-    faiss::Index* indexReader =
-      faiss::read_index(ioReader,
-                        faiss::IO_FLAG_READ_ONLY
-                        | faiss::IO_FLAG_PQ_SKIP_SDC_TABLE
-                        | faiss::IO_FLAG_SKIP_PRECOMPUTE_TABLE);
-
-    return (jlong) indexReader;
+    // Compressed indexes are decompressed on the way, uncompressed ones pass through
+    knn_jni::stream::FaissDecompressingIOReader decompressingReader(ioReader);
+    LoadArena arena = createLoadArena();
+    std::unique_ptr<faiss::Index> indexReader;
+    {
+        knn_jni::memory::IndexArenaScope arenaScope(arena.get());
+        indexReader.reset(
+          faiss::read_index(&decompressingReader,
+                            faiss::IO_FLAG_READ_ONLY
+                            | faiss::IO_FLAG_PQ_SKIP_SDC_TABLE
+                            | faiss::IO_FLAG_SKIP_PRECOMPUTE_TABLE));
+        compactLoadedGraph(indexReader.get());
+    }
+
+    auto * indexHandle = new NativeIndexHandle(indexReader.get());
+    indexReader.release();
+    indexHandle->arena = arena.release();
+    return (jlong) indexHandle;
 }
 
 jlong knn_jni::faiss_wrapper::LoadBinaryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jstring indexPathJ) {
@@ -471,8 +916,34 @@ jlong knn_jni::faiss_wrapper::LoadBinaryIndex(knn_jni::JNIUtilInterface * jniUti
     // Skipping IO_FLAG_PQ_SKIP_SDC_TABLE because the index is read only and the sdc table is only used during ingestion
     // Skipping IO_PRECOMPUTE_TABLE because it is only needed for IVFPQ-l2 and it leads to high memory consumption if
     // done for each segment. Instead, we will set it later on with `setSharedIndexState`
-    faiss::IndexBinary* indexReader = faiss::read_index_binary(indexPathCpp.c_str(), faiss::IO_FLAG_READ_ONLY | faiss::IO_FLAG_PQ_SKIP_SDC_TABLE | faiss::IO_FLAG_SKIP_PRECOMPUTE_TABLE);
-    return (jlong) indexReader;
+#ifndef _WIN32
+    // Read through a memory mapping of the file, so the bytes come straight from the page cache
+    knn_jni::stream::FaissMappedFileIOReader fileReader(indexPathCpp);
+    // Compressed files are decompressed as a whole, all frames at once
+    faiss::VectorIOReader decompressedReader;
+    faiss::IOReader *reader = &fileReader;
+    if (knn_jni::stream::isCompressedIndex(fileReader.data(), fileReader.size())) {
+        decompressedReader.data = knn_jni::stream::decompressIndex(fileReader.data(), fileReader.size());
+        reader = &decompressedReader;
+    }
+    LoadArena arena = createLoadArena();
+    std::unique_ptr<faiss::IndexBinary> indexReader;
+    {
+        knn_jni::memory::IndexArenaScope arenaScope(arena.get());
+        indexReader.reset(faiss::read_index_binary(reader, faiss::IO_FLAG_READ_ONLY | faiss::IO_FLAG_PQ_SKIP_SDC_TABLE | faiss::IO_FLAG_SKIP_PRECOMPUTE_TABLE));
+        compactLoadedGraph(indexReader.get());
+    }
+#else
+    faiss::FileIOReader fileReader(indexPathCpp.c_str());
+    knn_jni::stream::FaissDecompressingIOReader reader(&fileReader);
+    LoadArena arena;
+    std::unique_ptr<faiss::IndexBinary> indexReader(faiss::read_index_binary(&reader, faiss::IO_FLAG_READ_ONLY | faiss::IO_FLAG_PQ_SKIP_SDC_TABLE | faiss::IO_FLAG_SKIP_PRECOMPUTE_TABLE));
+    compactLoadedGraph(indexReader.get());
+#endif
+    auto * indexHandle = new NativeIndexHandle(indexReader.get());
+    indexReader.release();
+    indexHandle->arena = arena.release();
+    return (jlong) indexHandle;
 }
 
 jlong knn_jni::faiss_wrapper::LoadBinaryIndexWithStream(faiss::IOReader* ioReader) {
@@ -480,22 +951,36 @@ jlong knn_jni::faiss_wrapper::LoadBinaryIndexWithStream(faiss::IOReader* ioReade
         throw std::runtime_error("IOReader cannot be null");
     }
 
-    faiss::IndexBinary* indexReader =
-      faiss::read_index_binary(ioReader,
-                               faiss::IO_FLAG_READ_ONLY
-                               | faiss::IO_FLAG_PQ_SKIP_SDC_TABLE
-                               | faiss::IO_FLAG_SKIP_PRECOMPUTE_TABLE);
-
-    return (jlong) indexReader;
+    // Compressed indexes are decompressed on the way, uncompressed ones pass through
+    knn_jni::stream::FaissDecompressingIOReader decompressingReader(ioReader);
+    LoadArena arena = createLoadArena();
+    std::unique_ptr<faiss::IndexBinary> indexReader;
+    {
+        knn_jni::memory::IndexArenaScope arenaScope(arena.get());
+        indexReader.reset(
+          faiss::read_index_binary(&decompressingReader,
+                                   faiss::IO_FLAG_READ_ONLY
+                                   | faiss::IO_FLAG_PQ_SKIP_SDC_TABLE
+                                   | faiss::IO_FLAG_SKIP_PRECOMPUTE_TABLE));
+        compactLoadedGraph(indexReader.get());
+    }
+
+    auto * indexHandle = new NativeIndexHandle(indexReader.get());
+    indexReader.release();
+    indexHandle->arena = arena.release();
+    return (jlong) indexHandle;
 }
 
 bool knn_jni::faiss_wrapper::IsSharedIndexStateRequired(jlong indexPointerJ) {
-    auto * index = reinterpret_cast<faiss::Index*>(indexPointerJ);
-    return isIndexIVFPQL2(index);
+    auto * indexHandle = reinterpret_cast<NativeIndexHandle*>(indexPointerJ);
+    if (indexHandle == nullptr) {
+        return false;
+    }
+    return isIndexIVFPQL2(indexHandle->index);
 }
 
 jlong knn_jni::faiss_wrapper::InitSharedIndexState(jlong indexPointerJ) {
-    auto * index = reinterpret_cast<faiss::Index*>(indexPointerJ);
+    auto * index = getIndexHandle(indexPointerJ, false)->index;
     if (!isIndexIVFPQL2(index)) {
         throw std::runtime_error("Unable to init shared index state from index. index is not of type IVFPQ-l2");
     }
@@ -514,7 +999,7 @@ jlong knn_jni::faiss_wrapper::InitSharedIndexState(jlong indexPointerJ) {
 }
 
 void knn_jni::faiss_wrapper::SetSharedIndexState(jlong indexPointerJ, jlong shareIndexStatePointerJ) {
-    auto * index = reinterpret_cast<faiss::Index*>(indexPointerJ);
+    auto * index = getIndexHandle(indexPointerJ, false)->index;
     if (!isIndexIVFPQL2(index)) {
         throw std::runtime_error("Unable to set shared index state from index. index is not of type IVFPQ-l2");
     }
@@ -544,262 +1029,271 @@ jobjectArray knn_jni::faiss_wrapper::QueryIndex(knn_jni::JNIUtilInterface * jniU
 
 jobjectArray knn_jni::faiss_wrapper::QueryIndex_WithFilter(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
                                                 jfloatArray queryVectorJ, jint kJ, jobject methodParamsJ, jlongArray filterIdsJ, jint filterIdsTypeJ, jintArray parentIdsJ) {
+    // The ids vector will hold the top k ids from the search and the dis vector will hold the top k distances from
+    // the query point
+    std::vector<float> dis(kJ);
+    std::vector<faiss::idx_t> ids(kJ);
+    int resultSize = InternalQueryIndex(jniUtil, env, indexPointerJ, queryVectorJ, kJ,
+                                        knn_jni::commons::parseSearchParams(jniUtil, env, methodParamsJ), FilterIds(jniUtil, env, filterIdsJ, filterIdsTypeJ),
+                                        parentIdsJ, &dis, &ids);
+    return buildKNNQueryResults(jniUtil, env, ids.data(), dis.data(), resultSize);
+}
 
-    if (queryVectorJ == nullptr) {
-        throw std::runtime_error("Query Vector cannot be null");
+jint knn_jni::faiss_wrapper::QueryIndex_WithFilterBuffer(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                                         jfloatArray queryVectorJ, jint kJ, jlong searchParamsJ,
+                                                         jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ,
+                                                         jintArray resultIdsJ, jfloatArray resultDistancesJ) {
+    if (resultIdsJ == nullptr || resultDistancesJ == nullptr) {
+        throw std::runtime_error("Result arrays cannot be null");
     }
 
-    auto *indexReader = reinterpret_cast<faiss::IndexIDMap *>(indexPointerJ);
-
-    if (indexReader == nullptr) {
-        throw std::runtime_error("Invalid pointer to index");
-    }
+    std::vector<float> dis(kJ);
+    std::vector<faiss::idx_t> ids(kJ);
+    int resultSize = InternalQueryIndex(jniUtil, env, indexPointerJ, queryVectorJ, kJ,
+                                        knn_jni::commons::getSearchParams(searchParamsJ),
+                                        FilterIds::fromDirectBuffer(jniUtil, env, filterBufferJ, filterIdsTypeJ),
+                                        parentIdsJ, &dis, &ids);
+    setQueryResults(jniUtil, env, ids.data(), dis.data(), resultSize, resultIdsJ, resultDistancesJ);
+    return resultSize;
+}
 
-    std::unordered_map<std::string, jobject> methodParams;
-    if (methodParamsJ != nullptr) {
-        methodParams = jniUtil->ConvertJavaMapToCppMap(env, methodParamsJ);
-    }
+jobjectArray knn_jni::faiss_wrapper::QueryBinaryIndex_WithFilter(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                                jbyteArray queryVectorJ, jint kJ, jobject methodParamsJ, jlongArray filterIdsJ, jint filterIdsTypeJ, jintArray parentIdsJ) {
     // The ids vector will hold the top k ids from the search and the dis vector will hold the top k distances from
     // the query point
-    std::vector<float> dis(kJ);
+    std::vector<int32_t> dis(kJ);
     std::vector<faiss::idx_t> ids(kJ);
-    float* rawQueryvector = jniUtil->GetFloatArrayElements(env, queryVectorJ, nullptr);
-    /*
-        Setting the omp_set_num_threads to 1 to make sure that no new OMP threads are getting created.
-    */
-    omp_set_num_threads(1);
-    // create the filterSearch params if the filterIdsJ is not a null pointer
-    if(filterIdsJ != nullptr) {
-        jlong *filteredIdsArray = jniUtil->GetLongArrayElements(env, filterIdsJ, nullptr);
-        int filterIdsLength = jniUtil->GetJavaLongArrayLength(env, filterIdsJ);
-        std::unique_ptr<faiss::IDSelector> idSelector;
-        if(filterIdsTypeJ == BITMAP) {
-            idSelector.reset(new faiss::IDSelectorJlongBitmap(filterIdsLength, filteredIdsArray));
-        } else {
-            faiss::idx_t* batchIndices = reinterpret_cast<faiss::idx_t*>(filteredIdsArray);
-            idSelector.reset(new faiss::IDSelectorBatch(filterIdsLength, batchIndices));
-        }
-        faiss::SearchParameters *searchParameters;
-        faiss::SearchParametersHNSW hnswParams;
-        faiss::SearchParametersIVF ivfParams;
-        std::unique_ptr<faiss::IDGrouperBitmap> idGrouper;
-        std::vector<uint64_t> idGrouperBitmap;
-        auto hnswReader = dynamic_cast<const faiss::IndexHNSW*>(indexReader->index);
-        if(hnswReader) {
-            // Query param efsearch supersedes ef_search provided during index setting.
-            hnswParams.efSearch = knn_jni::commons::getIntegerMethodParameter(env, jniUtil, methodParams, EF_SEARCH, hnswReader->hnsw.efSearch);
-            hnswParams.sel = idSelector.get();
-            if (parentIdsJ != nullptr) {
-                idGrouper = buildIDGrouperBitmap(jniUtil, env, parentIdsJ, &idGrouperBitmap);
-                hnswParams.grp = idGrouper.get();
-            }
-            searchParameters = &hnswParams;
-        } else {
-            auto ivfReader = dynamic_cast<const faiss::IndexIVF*>(indexReader->index);
-            auto ivfFlatReader = dynamic_cast<const faiss::IndexIVFFlat*>(indexReader->index);
-            
-            if(ivfReader || ivfFlatReader) {
-                int indexNprobe = ivfReader == nullptr ? ivfFlatReader->nprobe : ivfReader->nprobe;
-                ivfParams.nprobe = commons::getIntegerMethodParameter(env, jniUtil, methodParams, NPROBES, indexNprobe);
-                ivfParams.sel = idSelector.get();
-                searchParameters = &ivfParams;
-            }
-        }
-        try {
-            indexReader->search(1, rawQueryvector, kJ, dis.data(), ids.data(), searchParameters);
-        } catch (...) {
-            jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
-            jniUtil->ReleaseLongArrayElements(env, filterIdsJ, filteredIdsArray, JNI_ABORT);
-            throw;
-        }
-        jniUtil->ReleaseLongArrayElements(env, filterIdsJ, filteredIdsArray, JNI_ABORT);
-    } else {
-        faiss::SearchParameters *searchParameters = nullptr;
-        faiss::SearchParametersHNSW hnswParams;
-        faiss::SearchParametersIVF ivfParams;
-        std::unique_ptr<faiss::IDGrouperBitmap> idGrouper;
-        std::vector<uint64_t> idGrouperBitmap;
-        auto hnswReader = dynamic_cast<const faiss::IndexHNSW*>(indexReader->index);
-        if(hnswReader != nullptr) {
-            // Query param efsearch supersedes ef_search provided during index setting.
-            hnswParams.efSearch = knn_jni::commons::getIntegerMethodParameter(env, jniUtil, methodParams, EF_SEARCH, hnswReader->hnsw.efSearch);
-            if (parentIdsJ != nullptr) {
-                idGrouper = buildIDGrouperBitmap(jniUtil, env, parentIdsJ, &idGrouperBitmap);
-                hnswParams.grp = idGrouper.get();
-            }
-            searchParameters = &hnswParams;
-        } else {
-            auto ivfReader = dynamic_cast<const faiss::IndexIVF*>(indexReader->index);
-            if (ivfReader) {
-                int indexNprobe = ivfReader->nprobe;
-                ivfParams.nprobe = commons::getIntegerMethodParameter(env, jniUtil, methodParams, NPROBES, indexNprobe);
-                searchParameters = &ivfParams;
-            }
-        }
-        try {
-            indexReader->search(1, rawQueryvector, kJ, dis.data(), ids.data(), searchParameters);
-        } catch (...) {
-            jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
-            throw;
-        }
-    }
-    jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
+    int resultSize = InternalQueryBinaryIndex(jniUtil, env, indexPointerJ, queryVectorJ, kJ,
+                                              knn_jni::commons::parseSearchParams(jniUtil, env, methodParamsJ), FilterIds(jniUtil, env, filterIdsJ, filterIdsTypeJ),
+                                              parentIdsJ, &dis, &ids);
+    return buildKNNQueryResults(jniUtil, env, ids.data(), dis.data(), resultSize);
+}
 
-    // If there are not k results, the results will be padded with -1. Find the first -1, and set result size to that
-    // index
-    int resultSize = kJ;
-    auto it = std::find(ids.begin(), ids.end(), -1);
-    if (it != ids.end()) {
-        resultSize = it - ids.begin();
+jint knn_jni::faiss_wrapper::QueryBinaryIndex_WithFilterBuffer(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                                               jbyteArray queryVectorJ, jint kJ, jlong searchParamsJ,
+                                                               jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ,
+                                                               jintArray resultIdsJ, jfloatArray resultDistancesJ) {
+    if (resultIdsJ == nullptr || resultDistancesJ == nullptr) {
+        throw std::runtime_error("Result arrays cannot be null");
     }
 
-    jclass resultClass = jniUtil->FindClass(env,"org/opensearch/knn/index/query/KNNQueryResult");
-    jmethodID allArgs = jniUtil->FindMethod(env, "org/opensearch/knn/index/query/KNNQueryResult", "<init>");
+    std::vector<int32_t> dis(kJ);
+    std::vector<faiss::idx_t> ids(kJ);
+    int resultSize = InternalQueryBinaryIndex(jniUtil, env, indexPointerJ, queryVectorJ, kJ,
+                                              knn_jni::commons::getSearchParams(searchParamsJ),
+                                              FilterIds::fromDirectBuffer(jniUtil, env, filterBufferJ, filterIdsTypeJ),
+                                              parentIdsJ, &dis, &ids);
+    setQueryResults(jniUtil, env, ids.data(), dis.data(), resultSize, resultIdsJ, resultDistancesJ);
+    return resultSize;
+}
 
-    jobjectArray results = jniUtil->NewObjectArray(env, resultSize, resultClass, nullptr);
+void knn_jni::faiss_wrapper::QueryIndexBatch(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                             jfloatArray queryVectorsJ, jint numQueriesJ, jint kJ, jlong searchParamsJ,
+                                             jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ,
+                                             jintArray resultIdsJ, jfloatArray resultDistancesJ) {
+    checkQueryBatch(queryVectorsJ, numQueriesJ, kJ, resultIdsJ, resultDistancesJ);
+    auto *indexHandle = getIndexHandle(indexPointerJ, false);
+    const size_t queryLength = (size_t) numQueriesJ * indexHandle->dimension;
+    if ((size_t) jniUtil->GetJavaFloatArrayLength(env, queryVectorsJ) != queryLength) {
+        throw std::runtime_error("Length of query vectors does not match number of queries times dimension");
+    }
+
+    const std::vector<float> queryVectors = copyQueryVector<float>(jniUtil, env, queryVectorsJ, queryLength);
+    InternalQueryIndexBatch(jniUtil, env, indexHandle, queryVectors, numQueriesJ, kJ,
+                            knn_jni::commons::getSearchParams(searchParamsJ),
+                            FilterIds::fromDirectBuffer(jniUtil, env, filterBufferJ, filterIdsTypeJ), parentIdsJ,
+                            resultIdsJ, resultDistancesJ);
+}
 
-    jobject result;
-    for(int i = 0; i < resultSize; ++i) {
-        result = jniUtil->NewObject(env, resultClass, allArgs, ids[i], dis[i]);
-        jniUtil->SetObjectArrayElement(env, results, i, result);
-    }
-    return results;
+void knn_jni::faiss_wrapper::QueryByteIndexBatch(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                                 jbyteArray queryVectorsJ, jint numQueriesJ, jint kJ, jlong searchParamsJ,
+                                                 jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ,
+                                                 jintArray resultIdsJ, jfloatArray resultDistancesJ) {
+    checkQueryBatch(queryVectorsJ, numQueriesJ, kJ, resultIdsJ, resultDistancesJ);
+    auto *indexHandle = getIndexHandle(indexPointerJ, false);
+    const size_t queryLength = (size_t) numQueriesJ * indexHandle->dimension;
+    if ((size_t) jniUtil->GetJavaBytesArrayLength(env, queryVectorsJ) != queryLength) {
+        throw std::runtime_error("Length of query vectors does not match number of queries times dimension");
+    }
+
+    // Byte indices store signed byte vectors with a scalar quantizer that consumes float input, so the queries are
+    // widened once here for the whole batch
+    const std::vector<int8_t> byteQueryVectors = copyQueryVector<int8_t>(jniUtil, env, queryVectorsJ, queryLength);
+    const std::vector<float> queryVectors(byteQueryVectors.begin(), byteQueryVectors.end());
+    InternalQueryIndexBatch(jniUtil, env, indexHandle, queryVectors, numQueriesJ, kJ,
+                            knn_jni::commons::getSearchParams(searchParamsJ),
+                            FilterIds::fromDirectBuffer(jniUtil, env, filterBufferJ, filterIdsTypeJ), parentIdsJ,
+                            resultIdsJ, resultDistancesJ);
 }
 
-jobjectArray knn_jni::faiss_wrapper::QueryBinaryIndex_WithFilter(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
-                                                jbyteArray queryVectorJ, jint kJ, jobject methodParamsJ, jlongArray filterIdsJ, jint filterIdsTypeJ, jintArray parentIdsJ) {
+void knn_jni::faiss_wrapper::QueryBinaryIndexBatch(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                                   jbyteArray queryVectorsJ, jint numQueriesJ, jint kJ, jlong searchParamsJ,
+                                                   jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ,
+                                                   jintArray resultIdsJ, jfloatArray resultDistancesJ) {
+    checkQueryBatch(queryVectorsJ, numQueriesJ, kJ, resultIdsJ, resultDistancesJ);
+    auto *indexHandle = getIndexHandle(indexPointerJ, true);
+    const size_t queryLength = (size_t) numQueriesJ * indexHandle->binaryIndex->code_size;
+    if ((size_t) jniUtil->GetJavaBytesArrayLength(env, queryVectorsJ) != queryLength) {
+        throw std::runtime_error("Length of query vectors does not match number of queries times code size");
+    }
+
+    const std::vector<uint8_t> queryVectors = copyQueryVector<uint8_t>(jniUtil, env, queryVectorsJ, queryLength);
+    InternalQueryIndexBatch(jniUtil, env, indexHandle, queryVectors, numQueriesJ, kJ,
+                            knn_jni::commons::getSearchParams(searchParamsJ),
+                            FilterIds::fromDirectBuffer(jniUtil, env, filterBufferJ, filterIdsTypeJ), parentIdsJ,
+                            resultIdsJ, resultDistancesJ);
+}
 
-    if (queryVectorJ == nullptr) {
-        throw std::runtime_error("Query Vector cannot be null");
+jint knn_jni::faiss_wrapper::ExactSearch_WithFilter(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ,
+                                                    jfloatArray queryVectorJ, jint kJ, jlongArray filterIdsJ,
+                                                    jint filterIdsTypeJ, jintArray resultIdsJ, jfloatArray resultDistancesJ) {
+    if (resultIdsJ == nullptr || resultDistancesJ == nullptr) {
+        throw std::runtime_error("Result arrays cannot be null");
+    }
+
+    if (kJ <= 0) {
+        throw std::runtime_error("k must be greater than 0");
     }
 
-    auto *indexReader = reinterpret_cast<faiss::IndexBinaryIDMap *>(indexPointerJ);
+    auto *indexHandle = getIndexHandle(indexPointerJ, false);
+    std::vector<std::pair<float, faiss::idx_t>> scored = InternalExactScore(
+            jniUtil, env, indexHandle, queryVectorJ, FilterIds(jniUtil, env, filterIdsJ, filterIdsTypeJ));
+
+    const size_t resultSize = std::min((size_t) kJ, scored.size());
+    std::partial_sort(scored.begin(), scored.begin() + resultSize, scored.end(),
+                      closerFirst(indexHandle->metric));
+    return setExactSearchResults(jniUtil, env, scored, resultSize, resultIdsJ, resultDistancesJ);
+}
 
-    if (indexReader == nullptr) {
+jint knn_jni::faiss_wrapper::ExactRangeSearch_WithFilter(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                         jlong indexPointerJ, jfloatArray queryVectorJ, jfloat radiusJ,
+                                                         jint maxResultWindowJ, jlongArray filterIdsJ,
+                                                         jint filterIdsTypeJ, jintArray resultIdsJ,
+                                                         jfloatArray resultDistancesJ) {
+    if (resultIdsJ == nullptr || resultDistancesJ == nullptr) {
+        throw std::runtime_error("Result arrays cannot be null");
+    }
+
+    auto *indexHandle = getIndexHandle(indexPointerJ, false);
+    std::vector<std::pair<float, faiss::idx_t>> scored = InternalExactScore(
+            jniUtil, env, indexHandle, queryVectorJ, FilterIds(jniUtil, env, filterIdsJ, filterIdsTypeJ));
+
+    // Same bound as the range search of the index: below the radius for distances, above it for similarities
+    const bool isSimilarity = faiss::is_similarity_metric(indexHandle->metric);
+    scored.erase(std::remove_if(scored.begin(), scored.end(),
+                                [isSimilarity, radiusJ](const std::pair<float, faiss::idx_t>& candidate) {
+                                    return isSimilarity ? candidate.first <= radiusJ : candidate.first >= radiusJ;
+                                }),
+                 scored.end());
+
+    const size_t resultSize = std::min((size_t) std::max(maxResultWindowJ, 0), scored.size());
+    std::partial_sort(scored.begin(), scored.begin() + resultSize, scored.end(),
+                      closerFirst(indexHandle->metric));
+    return setExactSearchResults(jniUtil, env, scored, resultSize, resultIdsJ, resultDistancesJ);
+}
+
+void knn_jni::faiss_wrapper::Free(jlong indexPointer, jboolean isBinaryIndexJ) {
+    auto *indexHandle = reinterpret_cast<NativeIndexHandle*>(indexPointer);
+    if (indexHandle == nullptr) {
+        return;
+    }
+    knn_jni::memory::IndexArena * arena = indexHandle->arena;
+    // Heap pages outlive the index, memory allocated on them later must not stay bound to the node of the index
+    if (indexHandle->numaPlaced) {
+        std::vector<faiss_util::MemoryRegion> regions;
+        collectIndexRegions(indexHandle, &regions);
+        faiss_util::resetMemoryRegions(regions);
+    }
+    delete indexHandle->index;
+    delete indexHandle->binaryIndex;
+    delete indexHandle;
+    // All the memory of the index is back in its arena, which is unmapped as a whole
+    if (arena != nullptr) {
+        arena->close();
+    }
+}
+
+knn_jni::faiss_wrapper::WarmupStats knn_jni::faiss_wrapper::WarmIndex(jlong indexPointerJ, WarmupMode mode) {
+    auto *indexHandle = reinterpret_cast<NativeIndexHandle*>(indexPointerJ);
+    if (indexHandle == nullptr) {
         throw std::runtime_error("Invalid pointer to index");
     }
 
-    std::unordered_map<std::string, jobject> methodParams;
-    if (methodParamsJ != nullptr) {
-        methodParams = jniUtil->ConvertJavaMapToCppMap(env, methodParamsJ);
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<faiss_util::MemoryRegion> regions;
+    collectIndexRegions(indexHandle, &regions);
+    WarmupStats stats;
+    stats.bytes = (int64_t) faiss_util::warmMemoryRegions(regions, mode != WarmupMode::ADVISE);
+    if (mode == WarmupMode::QUERY) {
+        runWarmupQueries(indexHandle);
     }
+    stats.elapsedNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
 
-    // The ids vector will hold the top k ids from the search and the dis vector will hold the top k distances from
-    // the query point
-    std::vector<int32_t> dis(kJ);
-    std::vector<faiss::idx_t> ids(kJ);
-    int8_t* rawQueryvector = jniUtil->GetByteArrayElements(env, queryVectorJ, nullptr);
-    /*
-        Setting the omp_set_num_threads to 1 to make sure that no new OMP threads are getting created.
-    */
-    omp_set_num_threads(1);
-    // create the filterSearch params if the filterIdsJ is not a null pointer
-    if(filterIdsJ != nullptr) {
-        jlong *filteredIdsArray = jniUtil->GetLongArrayElements(env, filterIdsJ, nullptr);
-        int filterIdsLength = jniUtil->GetJavaLongArrayLength(env, filterIdsJ);
-        std::unique_ptr<faiss::IDSelector> idSelector;
-        if(filterIdsTypeJ == BITMAP) {
-            idSelector.reset(new faiss::IDSelectorJlongBitmap(filterIdsLength, filteredIdsArray));
-        } else {
-            faiss::idx_t* batchIndices = reinterpret_cast<faiss::idx_t*>(filteredIdsArray);
-            idSelector.reset(new faiss::IDSelectorBatch(filterIdsLength, batchIndices));
-        }
-        faiss::SearchParameters *searchParameters;
-        faiss::SearchParametersHNSW hnswParams;
-        faiss::SearchParametersIVF ivfParams;
-        std::unique_ptr<faiss::IDGrouperBitmap> idGrouper;
-        std::vector<uint64_t> idGrouperBitmap;
-        auto hnswReader = dynamic_cast<const faiss::IndexBinaryHNSW*>(indexReader->index);
-        if(hnswReader) {
-            // Query param efsearch supersedes ef_search provided during index setting.
-            hnswParams.efSearch = knn_jni::commons::getIntegerMethodParameter(env, jniUtil, methodParams, EF_SEARCH, hnswReader->hnsw.efSearch);
-            hnswParams.sel = idSelector.get();
-            if (parentIdsJ != nullptr) {
-                idGrouper = buildIDGrouperBitmap(jniUtil, env, parentIdsJ, &idGrouperBitmap);
-                hnswParams.grp = idGrouper.get();
-            }
-            searchParameters = &hnswParams;
-        } else {
-            auto ivfReader = dynamic_cast<const faiss::IndexBinaryIVF*>(indexReader->index);
-            if(ivfReader) {
-                ivfParams.sel = idSelector.get();
-                searchParameters = &ivfParams;
-            }
-        }
-        try {
-            indexReader->search(1, reinterpret_cast<uint8_t*>(rawQueryvector), kJ, dis.data(), ids.data(), searchParameters);
-        } catch (...) {
-            jniUtil->ReleaseByteArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
-            jniUtil->ReleaseLongArrayElements(env, filterIdsJ, filteredIdsArray, JNI_ABORT);
-            throw;
-        }
-        jniUtil->ReleaseLongArrayElements(env, filterIdsJ, filteredIdsArray, JNI_ABORT);
+knn_jni::faiss_wrapper::IndexMemoryUsage knn_jni::faiss_wrapper::GetIndexMemoryUsage(jlong indexPointerJ) {
+    auto *indexHandle = reinterpret_cast<NativeIndexHandle*>(indexPointerJ);
+    if (indexHandle == nullptr) {
+        throw std::runtime_error("Invalid pointer to index");
+    }
+
+    IndexMemoryUsage usage;
+    usage.other += sizeof(NativeIndexHandle);
+    usage.idMap += vectorBytes(indexHandle->labelOrder);
+    if (indexHandle->isBinary) {
+        addIndexMemoryUsage(indexHandle->binaryIndex, &usage);
     } else {
-        faiss::SearchParameters *searchParameters = nullptr;
-        faiss::SearchParametersHNSW hnswParams;
-        faiss::SearchParametersIVF ivfParams;
-        std::unique_ptr<faiss::IDGrouperBitmap> idGrouper;
-        std::vector<uint64_t> idGrouperBitmap;
-        auto ivfReader = dynamic_cast<const faiss::IndexBinaryIVF*>(indexReader->index);
-        // TODO currently, search parameter is not supported in binary index
-        // To avoid test failure, we skip setting ef search when methodPramsJ is null temporary
-        if (ivfReader) {
-            int indexNprobe = ivfReader->nprobe;
-            ivfParams.nprobe = commons::getIntegerMethodParameter(env, jniUtil, methodParams, NPROBES, indexNprobe);
-            searchParameters = &ivfParams;
-        } else {
-            auto hnswReader = dynamic_cast<const faiss::IndexBinaryHNSW*>(indexReader->index);
-            if(hnswReader != nullptr && (methodParamsJ != nullptr || parentIdsJ != nullptr)) {
-               // Query param efsearch supersedes ef_search provided during index setting.
-               hnswParams.efSearch = knn_jni::commons::getIntegerMethodParameter(env, jniUtil, methodParams, EF_SEARCH, hnswReader->hnsw.efSearch);
-               if (parentIdsJ != nullptr) {
-                   idGrouper = buildIDGrouperBitmap(jniUtil, env, parentIdsJ, &idGrouperBitmap);
-                   hnswParams.grp = idGrouper.get();
-               }
-               searchParameters = &hnswParams;
-            }
-        }
+        addIndexMemoryUsage(indexHandle->index, &usage);
+    }
+    return usage;
+}
 
-        try {
-            indexReader->search(1, reinterpret_cast<uint8_t*>(rawQueryvector), kJ, dis.data(), ids.data(), searchParameters);
-        } catch (...) {
-            jniUtil->ReleaseByteArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
-            throw;
-        }
+jint knn_jni::faiss_wrapper::PlaceIndex(jlong indexPointerJ, jint nodeJ) {
+    auto *indexHandle = reinterpret_cast<NativeIndexHandle*>(indexPointerJ);
+    if (indexHandle == nullptr) {
+        throw std::runtime_error("Invalid pointer to index");
     }
-    jniUtil->ReleaseByteArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
 
-    // If there are not k results, the results will be padded with -1. Find the first -1, and set result size to that
-    // index
-    int resultSize = kJ;
-    auto it = std::find(ids.begin(), ids.end(), -1);
-    if (it != ids.end()) {
-        resultSize = it - ids.begin();
+    std::vector<faiss_util::MemoryRegion> regions;
+    collectIndexRegions(indexHandle, &regions);
+    if (faiss_util::placeMemoryRegions(regions, nodeJ)) {
+        indexHandle->numaNode = nodeJ;
+        indexHandle->numaPlaced = true;
     }
+    return indexHandle->numaNode;
+}
 
-    jclass resultClass = jniUtil->FindClass(env,"org/opensearch/knn/index/query/KNNQueryResult");
-    jmethodID allArgs = jniUtil->FindMethod(env, "org/opensearch/knn/index/query/KNNQueryResult", "<init>");
+jint knn_jni::faiss_wrapper::GetIndexNumaNode(jlong indexPointerJ) {
+    auto *indexHandle = reinterpret_cast<NativeIndexHandle*>(indexPointerJ);
+    if (indexHandle == nullptr) {
+        throw std::runtime_error("Invalid pointer to index");
+    }
+    return indexHandle->numaNode;
+}
 
-    jobjectArray results = jniUtil->NewObjectArray(env, resultSize, resultClass, nullptr);
+jint knn_jni::faiss_wrapper::GetNumaNodeCount() {
+    return faiss_util::getNumaNodeCount();
+}
 
-    jobject result;
-    for(int i = 0; i < resultSize; ++i) {
-        result = jniUtil->NewObject(env, resultClass, allArgs, ids[i], dis[i]);
-        jniUtil->SetObjectArrayElement(env, results, i, result);
-    }
-    return results;
+bool knn_jni::faiss_wrapper::ConfigureIndexArenas(bool enabled) {
+    indexArenasEnabled = enabled;
+    return enabled && knn_jni::memory::IndexArena::isSupported();
 }
 
-void knn_jni::faiss_wrapper::Free(jlong indexPointer, jboolean isBinaryIndexJ) {
-    bool isBinaryIndex = static_cast<bool>(isBinaryIndexJ);
-    if (isBinaryIndex) {
-        auto *indexWrapper = reinterpret_cast<faiss::IndexBinary*>(indexPointer);
-        delete indexWrapper;
+knn_jni::memory::IndexArenaStats knn_jni::faiss_wrapper::GetIndexArenaStats(jlong indexPointerJ) {
+    auto *indexHandle = reinterpret_cast<NativeIndexHandle*>(indexPointerJ);
+    if (indexHandle == nullptr) {
+        throw std::runtime_error("Invalid pointer to index");
     }
-    else {
-        auto *indexWrapper = reinterpret_cast<faiss::Index*>(indexPointer);
-        delete indexWrapper;
+    if (indexHandle->arena == nullptr) {
+        return knn_jni::memory::IndexArenaStats {};
     }
+    return indexHandle->arena->getStats();
+}
+
+void knn_jni::faiss_wrapper::ConfigureCompactGraphs(bool enabled) {
+    compactGraphsEnabled = enabled;
 }
 
 void knn_jni::faiss_wrapper::FreeSharedIndexState(jlong shareIndexStatePointerJ) {
@@ -859,7 +1353,7 @@ jbyteArray knn_jni::faiss_wrapper::TrainIndex(knn_jni::JNIUtilInterface * jniUti
     }
 
     // Train index if needed
-    auto *trainingVectorsPointerCpp = reinterpret_cast<std::vector<float>*>(trainVectorsPointerJ);
+    auto *trainingVectorsPointerCpp = reinterpret_cast<knn_jni::memory::VectorBuffer<float>*>(trainVectorsPointerJ);
     int numVectors = trainingVectorsPointerCpp->size()/(int) dimensionJ;
     if(!indexWriter->is_trained) {
         InternalTrainIndex(indexWriter.get(), numVectors, trainingVectorsPointerCpp->data());
@@ -914,7 +1408,7 @@ jbyteArray knn_jni::faiss_wrapper::TrainBinaryIndex(knn_jni::JNIUtilInterface *
     if (dim % 8 != 0) {
         throw std::runtime_error("Dimensions should be multiple of 8");
     }
-    auto *trainingVectorsPointerCpp = reinterpret_cast<std::vector<uint8_t>*>(trainVectorsPointerJ);
+    auto *trainingVectorsPointerCpp = reinterpret_cast<knn_jni::memory::VectorBuffer<uint8_t>*>(trainVectorsPointerJ);
     int numVectors = (int) (trainingVectorsPointerCpp->size() / (dim / 8));
     if(!indexWriter->is_trained) {
         InternalTrainBinaryIndex(indexWriter.get(), numVectors, trainingVectorsPointerCpp->data());
@@ -973,7 +1467,7 @@ jbyteArray knn_jni::faiss_wrapper::TrainByteIndex(knn_jni::JNIUtilInterface * jn
     }
 
     // Train index if needed
-    auto *trainingVectorsPointerCpp = reinterpret_cast<std::vector<int8_t>*>(trainVectorsPointerJ);
+    auto *trainingVectorsPointerCpp = reinterpret_cast<knn_jni::memory::VectorBuffer<int8_t>*>(trainVectorsPointerJ);
     int numVectors = trainingVectorsPointerCpp->size()/(int) dimensionJ;
 
     auto iter = trainingVectorsPointerCpp->begin();
@@ -1080,6 +1574,392 @@ std::unique_ptr<faiss::IDGrouperBitmap> buildIDGrouperBitmap(knn_jni::JNIUtilInt
     return idGrouper;
 }
 
+std::unique_ptr<faiss::IDSelector> buildIDSelector(const jlong* filterIds, size_t filterIdsLength, jint filterIdsType) {
+    if (filterIdsType == BITMAP) {
+        return std::make_unique<faiss::IDSelectorJlongBitmap>(filterIdsLength, filterIds);
+    }
+    if (filterIdsType == SORTED_ARRAY) {
+        // Neither form costs more than reading the list once. The bitmap is only built when it is no larger than
+        // the list, otherwise the ids are searched in place.
+        if (filterIdsLength > 0 && (size_t) (filterIds[filterIdsLength - 1] >> 6) < filterIdsLength) {
+            return std::make_unique<faiss::IDSelectorDensifiedJlongBitmap>(filterIdsLength, filterIds);
+        }
+        return std::make_unique<faiss::IDSelectorJlongSortedArray>(filterIdsLength, filterIds);
+    }
+    auto batchIndices = reinterpret_cast<const faiss::idx_t*>(filterIds);
+    return std::make_unique<faiss::IDSelectorBatch>(filterIdsLength, batchIndices);
+}
+
+FilterIds::FilterIds(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlongArray filterIdsJ, jint filterIdsTypeJ)
+        : type(filterIdsTypeJ) {
+    if (filterIdsJ == nullptr) {
+        return;
+    }
+    length = jniUtil->GetJavaLongArrayLength(env, filterIdsJ);
+    ids = jniUtil->GetLongArrayElements(env, filterIdsJ, nullptr);
+    this->jniUtil = jniUtil;
+    this->env = env;
+    pinnedArrayJ = filterIdsJ;
+}
+
+FilterIds::FilterIds(const jlong * ids, size_t length, jint filterIdsTypeJ)
+        : ids(const_cast<jlong *>(ids)), length(length), type(filterIdsTypeJ) {
+}
+
+FilterIds FilterIds::fromDirectBuffer(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jobject filterBufferJ,
+                                      jint filterIdsTypeJ) {
+    if (filterBufferJ == nullptr) {
+        return FilterIds();
+    }
+    auto * address = reinterpret_cast<const jlong *>(jniUtil->GetDirectBufferAddress(env, filterBufferJ));
+    if (address == nullptr) {
+        throw std::runtime_error("Filter buffer must be a direct buffer");
+    }
+    if (reinterpret_cast<uintptr_t>(address) % alignof(jlong) != 0) {
+        throw std::runtime_error("Filter buffer must be aligned to 8 bytes");
+    }
+    jlong capacity = jniUtil->GetDirectBufferCapacity(env, filterBufferJ);
+    return FilterIds(address, capacity / sizeof(jlong), filterIdsTypeJ);
+}
+
+FilterIds::~FilterIds() {
+    if (pinnedArrayJ != nullptr) {
+        jniUtil->ReleaseLongArrayElements(env, pinnedArrayJ, ids, JNI_ABORT);
+    }
+}
+
+std::unique_ptr<faiss::IDSelector> FilterIds::buildIDSelector() const {
+    if (ids == nullptr) {
+        return nullptr;
+    }
+    return ::buildIDSelector(ids, length, type);
+}
+
+knn_jni::faiss_wrapper::NativeIndexHandle * getIndexHandle(jlong indexPointerJ, bool isBinary) {
+    auto *indexHandle = reinterpret_cast<knn_jni::faiss_wrapper::NativeIndexHandle *>(indexPointerJ);
+    if (indexHandle == nullptr) {
+        throw std::runtime_error("Invalid pointer to index");
+    }
+    if (indexHandle->isBinary != isBinary) {
+        throw std::runtime_error(isBinary ? "Index is not a binary index" : "Index is not a float index");
+    }
+    return indexHandle;
+}
+
+faiss::Index * getExactSearchStorage(const knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle) {
+    switch (indexHandle->kind) {
+        case knn_jni::faiss_wrapper::IndexKind::HNSW:
+            return indexHandle->hnsw->storage;
+        case knn_jni::faiss_wrapper::IndexKind::IVF:
+            // Inverted lists can only be scored by internal id with a direct map, which loaded indices do not have
+            throw std::runtime_error("Exact search is not supported for IVF indices");
+        default:
+            return indexHandle->idMap != nullptr ? indexHandle->idMap->index : indexHandle->index;
+    }
+}
+
+std::vector<faiss::idx_t> collectExactSearchCandidates(const knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle,
+                                                       const FilterIds& filterIds) {
+    const faiss::idx_t ntotal = indexHandle->index->ntotal;
+    const std::vector<faiss::idx_t> * labels = indexHandle->idMap != nullptr ? &indexHandle->idMap->id_map : nullptr;
+    std::vector<faiss::idx_t> candidates;
+
+    // A restrictive filter is usually an id list, only its ids are looked up
+    if (filterIds.getIds() != nullptr && filterIds.getType() != BITMAP) {
+        const std::vector<faiss::idx_t> & labelOrder = indexHandle->labelOrder;
+        candidates.reserve(filterIds.getLength());
+        for (size_t i = 0; i < filterIds.getLength(); i++) {
+            const faiss::idx_t label = filterIds.getIds()[i];
+            if (labels == nullptr) {
+                if (label >= 0 && label < ntotal) {
+                    candidates.push_back(label);
+                }
+            } else if (indexHandle->idMapSorted) {
+                auto it = std::lower_bound(labels->begin(), labels->end(), label);
+                if (it != labels->end() && *it == label) {
+                    candidates.push_back(it - labels->begin());
+                }
+            } else {
+                auto it = std::lower_bound(labelOrder.begin(), labelOrder.end(), label,
+                                           [labels](faiss::idx_t internalId, faiss::idx_t value) {
+                                               return (*labels)[internalId] < value;
+                                           });
+                if (it != labelOrder.end() && (*labels)[*it] == label) {
+                    candidates.push_back(*it);
+                }
+            }
+        }
+        return candidates;
+    }
+
+    std::unique_ptr<faiss::IDSelector> idSelector = filterIds.buildIDSelector();
+    for (faiss::idx_t internalId = 0; internalId < ntotal; internalId++) {
+        const faiss::idx_t label = labels == nullptr ? internalId : (*labels)[internalId];
+        if (idSelector == nullptr || idSelector->is_member(label)) {
+            candidates.push_back(internalId);
+        }
+    }
+    return candidates;
+}
+
+std::vector<std::pair<float, faiss::idx_t>> InternalExactScore(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                                                               knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle,
+                                                               jfloatArray queryVectorJ, const FilterIds& filterIds) {
+    if (queryVectorJ == nullptr) {
+        throw std::runtime_error("Query Vector cannot be null");
+    }
+
+    faiss::Index * storage = getExactSearchStorage(indexHandle);
+
+    if (jniUtil->GetJavaFloatArrayLength(env, queryVectorJ) != indexHandle->dimension) {
+        throw std::runtime_error("Length of query vector does not match dimension");
+    }
+
+    const std::vector<faiss::idx_t> candidates = collectExactSearchCandidates(indexHandle, filterIds);
+
+    // Scoring can take a while with a broad filter, so the query is copied out instead of being pinned
+    std::vector<float> query(indexHandle->dimension);
+    jfloat * rawQueryVector = jniUtil->GetFloatArrayElements(env, queryVectorJ, nullptr);
+    std::copy(rawQueryVector, rawQueryVector + indexHandle->dimension, query.begin());
+    jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryVector, JNI_ABORT);
+
+    // The distance computer of the storage runs the SIMD kernels of the index and decodes scalar quantized and fp16
+    // codes on the fly
+    std::unique_ptr<faiss::DistanceComputer> distanceComputer(storage->get_distance_computer());
+    distanceComputer->set_query(query.data());
+
+    std::vector<std::pair<float, faiss::idx_t>> scored(candidates.size());
+    size_t i = 0;
+    for (; i + 4 <= candidates.size(); i += 4) {
+        distanceComputer->distances_batch_4(candidates[i], candidates[i + 1], candidates[i + 2], candidates[i + 3],
+                                            scored[i].first, scored[i + 1].first, scored[i + 2].first,
+                                            scored[i + 3].first);
+    }
+    for (; i < candidates.size(); i++) {
+        scored[i].first = (*distanceComputer)(candidates[i]);
+    }
+
+    const std::vector<faiss::idx_t> * labels = indexHandle->idMap != nullptr ? &indexHandle->idMap->id_map : nullptr;
+    for (i = 0; i < candidates.size(); i++) {
+        scored[i].second = labels == nullptr ? candidates[i] : (*labels)[candidates[i]];
+    }
+    indexHandle->queryCount++;
+    return scored;
+}
+
+jint setExactSearchResults(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                           const std::vector<std::pair<float, faiss::idx_t>>& scored, size_t resultSize,
+                           jintArray resultIdsJ, jfloatArray resultDistancesJ) {
+    std::vector<faiss::idx_t> ids(resultSize);
+    std::vector<float> dis(resultSize);
+    for (size_t i = 0; i < resultSize; i++) {
+        dis[i] = scored[i].first;
+        ids[i] = scored[i].second;
+    }
+    setQueryResults(jniUtil, env, ids.data(), dis.data(), resultSize, resultIdsJ, resultDistancesJ);
+    return resultSize;
+}
+
+faiss::SearchParameters * resolveSearchParameters(const knn_jni::commons::SearchParams& searchParams,
+                                                  const knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle,
+                                                  faiss::IDSelector * idSelector, faiss::IDGrouper * idGrouper,
+                                                  faiss::SearchParametersHNSW * hnswParams,
+                                                  faiss::SearchParametersIVF * ivfParams) {
+    switch (indexHandle->kind) {
+        case knn_jni::faiss_wrapper::IndexKind::HNSW:
+            hnswParams->efSearch = searchParams.efSearch.value_or(indexHandle->defaultEfSearch);
+            hnswParams->sel = idSelector;
+            hnswParams->grp = idGrouper;
+            return hnswParams;
+        case knn_jni::faiss_wrapper::IndexKind::IVF:
+            ivfParams->nprobe = searchParams.nprobes.value_or(indexHandle->defaultNprobe);
+            ivfParams->sel = idSelector;
+            return ivfParams;
+        default:
+            return nullptr;
+    }
+}
+
+int InternalQueryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ, jfloatArray queryVectorJ,
+                       jint kJ, const knn_jni::commons::SearchParams& searchParams, const FilterIds& filterIds,
+                       jintArray parentIdsJ, std::vector<float> * dis, std::vector<faiss::idx_t> * ids) {
+    if (queryVectorJ == nullptr) {
+        throw std::runtime_error("Query Vector cannot be null");
+    }
+
+    auto *indexHandle = getIndexHandle(indexPointerJ, false);
+
+    std::unique_ptr<faiss::IDGrouperBitmap> idGrouper;
+    std::vector<uint64_t> idGrouperBitmap;
+    if (parentIdsJ != nullptr) {
+        idGrouper = buildIDGrouperBitmap(jniUtil, env, parentIdsJ, &idGrouperBitmap);
+    }
+
+    std::unique_ptr<faiss::IDSelector> idSelector = filterIds.buildIDSelector();
+
+    faiss::SearchParametersHNSW hnswParams;
+    faiss::SearchParametersIVF ivfParams;
+    faiss::SearchParameters *searchParameters = resolveSearchParameters(searchParams, indexHandle,
+                                                                        idSelector.get(), idGrouper.get(),
+                                                                        &hnswParams, &ivfParams);
+    const std::vector<float> queryVector = copyQueryVector<float>(jniUtil, env, queryVectorJ, indexHandle->index->d);
+    /*
+        Setting the omp_set_num_threads to 1 to make sure that no new OMP threads are getting created.
+    */
+    omp_set_num_threads(1);
+    indexHandle->index->search(1, queryVector.data(), kJ, dis->data(), ids->data(), searchParameters);
+    indexHandle->queryCount++;
+
+    // If there are not k results, the results will be padded with -1. Find the first -1, and set result size to that
+    // index
+    auto it = std::find(ids->begin(), ids->end(), -1);
+    return it - ids->begin();
+}
+
+int InternalQueryBinaryIndex(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jlong indexPointerJ, jbyteArray queryVectorJ,
+                             jint kJ, const knn_jni::commons::SearchParams& searchParams, const FilterIds& filterIds,
+                             jintArray parentIdsJ, std::vector<int32_t> * dis, std::vector<faiss::idx_t> * ids) {
+    if (queryVectorJ == nullptr) {
+        throw std::runtime_error("Query Vector cannot be null");
+    }
+
+    auto *indexHandle = getIndexHandle(indexPointerJ, true);
+
+    std::unique_ptr<faiss::IDGrouperBitmap> idGrouper;
+    std::vector<uint64_t> idGrouperBitmap;
+    if (parentIdsJ != nullptr) {
+        idGrouper = buildIDGrouperBitmap(jniUtil, env, parentIdsJ, &idGrouperBitmap);
+    }
+
+    std::unique_ptr<faiss::IDSelector> idSelector = filterIds.buildIDSelector();
+
+    faiss::SearchParametersHNSW hnswParams;
+    faiss::SearchParametersIVF ivfParams;
+    faiss::SearchParameters *searchParameters = nullptr;
+    // TODO currently, search parameter is not supported in binary index
+    // To avoid test failure, we skip setting ef search when there is nothing to override temporary
+    if (idSelector != nullptr || searchParams.efSearch.has_value() || parentIdsJ != nullptr
+        || indexHandle->kind == knn_jni::faiss_wrapper::IndexKind::IVF) {
+        searchParameters = resolveSearchParameters(searchParams, indexHandle, idSelector.get(), idGrouper.get(),
+                                                   &hnswParams, &ivfParams);
+    }
+    const std::vector<uint8_t> queryVector = copyQueryVector<uint8_t>(jniUtil, env, queryVectorJ,
+                                                                      indexHandle->binaryIndex->code_size);
+    /*
+        Setting the omp_set_num_threads to 1 to make sure that no new OMP threads are getting created.
+    */
+    omp_set_num_threads(1);
+    indexHandle->binaryIndex->search(1, queryVector.data(), kJ, dis->data(), ids->data(), searchParameters);
+    indexHandle->queryCount++;
+
+    // If there are not k results, the results will be padded with -1. Find the first -1, and set result size to that
+    // index
+    auto it = std::find(ids->begin(), ids->end(), -1);
+    return it - ids->begin();
+}
+
+void checkQueryBatch(jarray queryVectorsJ, jint numQueriesJ, jint kJ, jintArray resultIdsJ, jfloatArray resultDistancesJ) {
+    if (queryVectorsJ == nullptr) {
+        throw std::runtime_error("Query Vectors cannot be null");
+    }
+
+    if (resultIdsJ == nullptr || resultDistancesJ == nullptr) {
+        throw std::runtime_error("Result arrays cannot be null");
+    }
+
+    if (numQueriesJ <= 0 || kJ <= 0) {
+        throw std::runtime_error("Number of queries and k must be greater than 0");
+    }
+}
+
+template<typename QueryT>
+void InternalQueryIndexBatch(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env,
+                             knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle,
+                             const std::vector<QueryT>& queryVectors, jint numQueriesJ, jint kJ,
+                             const knn_jni::commons::SearchParams& searchParams, const FilterIds& filterIds,
+                             jintArray parentIdsJ, jintArray resultIdsJ, jfloatArray resultDistancesJ) {
+    std::unique_ptr<faiss::IDGrouperBitmap> idGrouper;
+    std::vector<uint64_t> idGrouperBitmap;
+    if (parentIdsJ != nullptr) {
+        idGrouper = buildIDGrouperBitmap(jniUtil, env, parentIdsJ, &idGrouperBitmap);
+    }
+
+    std::unique_ptr<faiss::IDSelector> idSelector = filterIds.buildIDSelector();
+
+    faiss::SearchParametersHNSW hnswParams;
+    faiss::SearchParametersIVF ivfParams;
+    faiss::SearchParameters *searchParameters = resolveSearchParameters(searchParams, indexHandle,
+                                                                        idSelector.get(), idGrouper.get(),
+                                                                        &hnswParams, &ivfParams);
+
+    // The ids of all the queries, row-major by query
+    const size_t resultLength = (size_t) numQueriesJ * kJ;
+    std::vector<faiss::idx_t> ids(resultLength);
+    /*
+        Setting the omp_set_num_threads to 1 to make sure that no new OMP threads are getting created.
+    */
+    omp_set_num_threads(1);
+    if constexpr (std::is_same_v<QueryT, uint8_t>) {
+        // Same as InternalQueryBinaryIndex, the defaults of the index apply when nothing is overridden
+        if (idSelector == nullptr && !searchParams.efSearch.has_value() && parentIdsJ == nullptr
+            && indexHandle->kind != knn_jni::faiss_wrapper::IndexKind::IVF) {
+            searchParameters = nullptr;
+        }
+        std::vector<int32_t> dis(resultLength);
+        indexHandle->binaryIndex->search(numQueriesJ, queryVectors.data(), kJ, dis.data(), ids.data(), searchParameters);
+        setQueryResults(jniUtil, env, ids.data(), dis.data(), resultLength, resultIdsJ, resultDistancesJ);
+    } else {
+        std::vector<float> dis(resultLength);
+        indexHandle->index->search(numQueriesJ, queryVectors.data(), kJ, dis.data(), ids.data(), searchParameters);
+        setQueryResults(jniUtil, env, ids.data(), dis.data(), resultLength, resultIdsJ, resultDistancesJ);
+    }
+    indexHandle->queryCount += numQueriesJ;
+}
+
+template<typename T>
+std::vector<T> copyQueryVector(knn_jni::JNIUtilInterface * jniUtil, JNIEnv * env, jarray queryVectorJ, size_t size) {
+    std::vector<T> queryVector(size);
+    void *rawQueryVector = jniUtil->GetPrimitiveArrayCritical(env, queryVectorJ, nullptr);
+    if (rawQueryVector == nullptr) {
+        throw std::runtime_error("Unable to pin query vector");
+    }
+    std::memcpy(queryVector.data(), rawQueryVector, size * sizeof(T));
+    jniUtil->ReleasePrimitiveArrayCritical(env, queryVectorJ, rawQueryVector, JNI_ABORT);
+    return queryVector;
+}
+
+template<typename DistanceT>
+jobjectArray buildKNNQueryResults(knn_jni::JNIUtilInterface * jniUtil, JNIEnv *env, const faiss::idx_t * ids,
+                                  const DistanceT * dis, int resultSize) {
+    jclass resultClass = jniUtil->FindClass(env,"org/opensearch/knn/index/query/KNNQueryResult");
+    jmethodID allArgs = jniUtil->FindMethod(env, "org/opensearch/knn/index/query/KNNQueryResult", "<init>");
+
+    jobjectArray results = jniUtil->NewObjectArray(env, resultSize, resultClass, nullptr);
+
+    jobject result;
+    for(int i = 0; i < resultSize; ++i) {
+        result = jniUtil->NewObject(env, resultClass, allArgs, ids[i], dis[i]);
+        jniUtil->SetObjectArrayElement(env, results, i, result);
+        // The array holds its own reference, drop the local one so that large k does not exhaust the local frame
+        jniUtil->DeleteLocalRef(env, result);
+    }
+    return results;
+}
+
+template<typename DistanceT>
+void setQueryResults(knn_jni::JNIUtilInterface * jniUtil, JNIEnv *env, const faiss::idx_t * ids,
+                     const DistanceT * dis, int resultSize, jintArray resultIdsJ, jfloatArray resultDistancesJ) {
+    // Labels are Lucene doc ids, so they always fit in a jint. Padding of missing results with -1 is kept.
+    std::vector<jint> resultIds(ids, ids + resultSize);
+    jniUtil->SetIntArrayRegion(env, resultIdsJ, 0, resultSize, resultIds.data());
+    if constexpr (std::is_same_v<DistanceT, float>) {
+        jniUtil->SetFloatArrayRegion(env, resultDistancesJ, 0, resultSize, dis);
+    } else {
+        std::vector<jfloat> resultDistances(dis, dis + resultSize);
+        jniUtil->SetFloatArrayRegion(env, resultDistancesJ, 0, resultSize, resultDistances.data());
+    }
+}
+
 bool isIndexIVFPQL2(faiss::Index * index) {
     faiss::Index * candidateIndex = index;
     // Unwrap the index if it is wrapped in IndexIDMap. Dynamic cast will "Safely converts pointers and references to
@@ -1119,113 +1999,650 @@ jobjectArray knn_jni::faiss_wrapper::RangeSearch(knn_jni::JNIUtilInterface *jniU
 
 jobjectArray knn_jni::faiss_wrapper::RangeSearchWithFilter(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong indexPointerJ,
                                                            jfloatArray queryVectorJ, jfloat radiusJ, jobject methodParamsJ, jint maxResultWindowJ, jlongArray filterIdsJ, jint filterIdsTypeJ, jintArray parentIdsJ) {
+    std::vector<float> dis;
+    std::vector<faiss::idx_t> ids;
+    int resultSize = InternalRangeSearch(jniUtil, env, indexPointerJ, queryVectorJ, radiusJ,
+                                         knn_jni::commons::parseSearchParams(jniUtil, env, methodParamsJ), maxResultWindowJ,
+                                         FilterIds(jniUtil, env, filterIdsJ, filterIdsTypeJ), parentIdsJ, &dis, &ids);
+    return buildKNNQueryResults(jniUtil, env, ids.data(), dis.data(), resultSize);
+}
+
+jint knn_jni::faiss_wrapper::RangeSearch_WithFilterBuffer(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong indexPointerJ,
+                                                          jfloatArray queryVectorJ, jfloat radiusJ, jlong searchParamsJ,
+                                                          jint maxResultWindowJ, jobject filterBufferJ, jint filterIdsTypeJ,
+                                                          jintArray parentIdsJ, jintArray resultIdsJ, jfloatArray resultDistancesJ) {
+    if (resultIdsJ == nullptr || resultDistancesJ == nullptr) {
+        throw std::runtime_error("Result arrays cannot be null");
+    }
+
+    std::vector<float> dis;
+    std::vector<faiss::idx_t> ids;
+    int resultSize = InternalRangeSearch(jniUtil, env, indexPointerJ, queryVectorJ, radiusJ,
+                                         knn_jni::commons::getSearchParams(searchParamsJ), maxResultWindowJ,
+                                         FilterIds::fromDirectBuffer(jniUtil, env, filterBufferJ, filterIdsTypeJ),
+                                         parentIdsJ, &dis, &ids);
+    setQueryResults(jniUtil, env, ids.data(), dis.data(), resultSize, resultIdsJ, resultDistancesJ);
+    return resultSize;
+}
+
+jint knn_jni::faiss_wrapper::RangeSearchBinaryIndex_WithFilterBuffer(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env,
+                                                                     jlong indexPointerJ, jbyteArray queryVectorJ,
+                                                                     jfloat radiusJ, jlong searchParamsJ,
+                                                                     jint maxResultWindowJ, jobject filterBufferJ,
+                                                                     jint filterIdsTypeJ, jintArray parentIdsJ,
+                                                                     jintArray resultIdsJ, jfloatArray resultDistancesJ) {
+    if (resultIdsJ == nullptr || resultDistancesJ == nullptr) {
+        throw std::runtime_error("Result arrays cannot be null");
+    }
+
+    std::vector<float> dis;
+    std::vector<faiss::idx_t> ids;
+    int resultSize = InternalRangeSearchBinaryIndex(jniUtil, env, indexPointerJ, queryVectorJ, radiusJ,
+                                                    knn_jni::commons::getSearchParams(searchParamsJ), maxResultWindowJ,
+                                                    FilterIds::fromDirectBuffer(jniUtil, env, filterBufferJ,
+                                                                                filterIdsTypeJ),
+                                                    parentIdsJ, &dis, &ids);
+    setQueryResults(jniUtil, env, ids.data(), dis.data(), resultSize, resultIdsJ, resultDistancesJ);
+    return resultSize;
+}
+
+int InternalRangeSearch(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong indexPointerJ, jfloatArray queryVectorJ,
+                        jfloat radiusJ, const knn_jni::commons::SearchParams& searchParams, jint maxResultWindowJ,
+                        const FilterIds& filterIds, jintArray parentIdsJ, std::vector<float> * dis,
+                        std::vector<faiss::idx_t> * ids) {
     if (queryVectorJ == nullptr) {
         throw std::runtime_error("Query Vector cannot be null");
     }
 
-    auto *indexReader = reinterpret_cast<faiss::IndexIDMap *>(indexPointerJ);
+    if (maxResultWindowJ <= 0) {
+        throw std::runtime_error("Max result window must be greater than 0");
+    }
+    const size_t window = maxResultWindowJ;
+
+    auto *indexHandle = getIndexHandle(indexPointerJ, false);
 
-    if (indexReader == nullptr) {
-        throw std::runtime_error("Invalid pointer to indexReader");
+    std::unique_ptr<faiss::IDGrouperBitmap> idGrouper;
+    std::vector<uint64_t> idGrouperBitmap;
+    if (parentIdsJ != nullptr) {
+        idGrouper = buildIDGrouperBitmap(jniUtil, env, parentIdsJ, &idGrouperBitmap);
     }
 
-    float *rawQueryVector = jniUtil->GetFloatArrayElements(env, queryVectorJ, nullptr);
+    std::unique_ptr<faiss::IDSelector> idSelector = filterIds.buildIDSelector();
 
-    std::unordered_map<std::string, jobject> methodParams;
-    if (methodParamsJ != nullptr) {
-        methodParams = jniUtil->ConvertJavaMapToCppMap(env, methodParamsJ);
+    // HNSW and IVF indices hold the ids internal to the IDMap, so the filter and the grouper are translated to them
+    faiss::IDSelector * internalSelector = idSelector.get();
+    faiss::IDGrouper * internalGrouper = idGrouper.get();
+    std::unique_ptr<faiss::IDSelectorTranslated> translatedSelector;
+    std::unique_ptr<faiss::IDGrouperTranslated> translatedGrouper;
+    if (indexHandle->idMap != nullptr && indexHandle->kind != knn_jni::faiss_wrapper::IndexKind::OTHER) {
+        if (internalSelector != nullptr) {
+            translatedSelector = std::make_unique<faiss::IDSelectorTranslated>(indexHandle->idMap->id_map,
+                                                                               internalSelector);
+            internalSelector = translatedSelector.get();
+        }
+        if (internalGrouper != nullptr) {
+            translatedGrouper = std::make_unique<faiss::IDGrouperTranslated>(indexHandle->idMap->id_map,
+                                                                             internalGrouper);
+            internalGrouper = translatedGrouper.get();
+        }
     }
 
-    // The res will be freed by ~RangeSearchResult() in FAISS
-    // The second parameter is always true, as lims is allocated by FAISS
-    faiss::RangeSearchResult res(1, true);
+    const auto toLabels = [indexHandle](std::vector<faiss::idx_t> * internalIds) {
+        if (indexHandle->idMap != nullptr) {
+            for (auto & id : *internalIds) {
+                id = indexHandle->idMap->id_map[id];
+            }
+        }
+    };
+
+    const std::vector<float> queryVector = copyQueryVector<float>(jniUtil, env, queryVectorJ, indexHandle->index->d);
+    switch (indexHandle->kind) {
+        case knn_jni::faiss_wrapper::IndexKind::HNSW: {
+            // The graph search offers every node it visits within the radius, of which only the closest are held
+            faiss::SearchParametersHNSW hnswParams;
+            hnswParams.efSearch = searchParams.efSearch.value_or(indexHandle->defaultEfSearch);
+            hnswParams.sel = internalSelector;
+            hnswParams.grp = internalGrouper;
+            hnswParams.max_range_results = window;
+            faiss::RangeSearchResult result(1);
+            indexHandle->hnsw->range_search(1, queryVector.data(), radiusJ, &result, &hnswParams);
+            copyRangeSearchResult(result, dis, ids);
+            toLabels(ids);
+            break;
+        }
+        case knn_jni::faiss_wrapper::IndexKind::IVF: {
+            const size_t nprobe = searchParams.nprobes.value_or(indexHandle->defaultNprobe);
+            if (internalGrouper != nullptr) {
+                faiss::RangeSearchResult result(1);
+                if (faiss::is_similarity_metric(indexHandle->metric)) {
+                    groupedIVFRangeSearch<faiss::CMin<float, faiss::idx_t>>(
+                            indexHandle->ivf, queryVector.data(), radiusJ, window, nprobe, internalSelector,
+                            internalGrouper, &result);
+                } else {
+                    groupedIVFRangeSearch<faiss::CMax<float, faiss::idx_t>>(
+                            indexHandle->ivf, queryVector.data(), radiusJ, window, nprobe, internalSelector,
+                            internalGrouper, &result);
+                }
+                copyRangeSearchResult(result, dis, ids);
+                toLabels(ids);
+                break;
+            }
+            std::vector<float> boundedDis(window);
+            std::vector<faiss::idx_t> boundedLabels(window);
+            size_t hits = boundedIVFRangeSearch(indexHandle->ivf, queryVector.data(), radiusJ, window, nprobe,
+                                                internalSelector, boundedDis.data(), boundedLabels.data());
+            keepClosestRangeResults(boundedLabels.data(), boundedDis.data(), hits, window, indexHandle->metric,
+                                    dis, ids);
+            toLabels(ids);
+            break;
+        }
+        default: {
+            const bool hasIdMap = indexHandle->idMap != nullptr;
+            scanRangeSearch(hasIdMap ? indexHandle->idMap->index : indexHandle->index, queryVector.data(), radiusJ,
+                            window, idSelector.get(), idGrouper.get(),
+                            hasIdMap ? &indexHandle->idMap->id_map : nullptr, dis, ids);
+            break;
+        }
+    }
+    indexHandle->queryCount++;
 
-    if (filterIdsJ != nullptr) {
-        jlong *filteredIdsArray = jniUtil->GetLongArrayElements(env, filterIdsJ, nullptr);
-        int filterIdsLength = jniUtil->GetJavaLongArrayLength(env, filterIdsJ);
-        std::unique_ptr<faiss::IDSelector> idSelector;
-        if (filterIdsTypeJ == BITMAP) {
-            idSelector.reset(new faiss::IDSelectorJlongBitmap(filterIdsLength, filteredIdsArray));
-        } else {
-            faiss::idx_t* batchIndices = reinterpret_cast<faiss::idx_t*>(filteredIdsArray);
-            idSelector.reset(new faiss::IDSelectorBatch(filterIdsLength, batchIndices));
+    return ids->size();
+}
+
+int InternalRangeSearchBinaryIndex(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong indexPointerJ,
+                                   jbyteArray queryVectorJ, jfloat radiusJ,
+                                   const knn_jni::commons::SearchParams& searchParams, jint maxResultWindowJ,
+                                   const FilterIds& filterIds, jintArray parentIdsJ, std::vector<float> * dis,
+                                   std::vector<faiss::idx_t> * ids) {
+    if (queryVectorJ == nullptr) {
+        throw std::runtime_error("Query Vector cannot be null");
+    }
+
+    if (maxResultWindowJ <= 0) {
+        throw std::runtime_error("Max result window must be greater than 0");
+    }
+    const size_t window = maxResultWindowJ;
+
+    auto *indexHandle = getIndexHandle(indexPointerJ, true);
+
+    std::unique_ptr<faiss::IDGrouperBitmap> idGrouper;
+    std::vector<uint64_t> idGrouperBitmap;
+    if (parentIdsJ != nullptr) {
+        idGrouper = buildIDGrouperBitmap(jniUtil, env, parentIdsJ, &idGrouperBitmap);
+    }
+
+    std::unique_ptr<faiss::IDSelector> idSelector = filterIds.buildIDSelector();
+
+    // Every kind of binary index is searched by id internal to the IDMap, so the filter and the grouper are translated
+    faiss::IDSelector * internalSelector = idSelector.get();
+    faiss::IDGrouper * internalGrouper = idGrouper.get();
+    std::unique_ptr<faiss::IDSelectorTranslated> translatedSelector;
+    std::unique_ptr<faiss::IDGrouperTranslated> translatedGrouper;
+    if (indexHandle->binaryIdMap != nullptr) {
+        if (internalSelector != nullptr) {
+            translatedSelector = std::make_unique<faiss::IDSelectorTranslated>(indexHandle->binaryIdMap->id_map,
+                                                                               internalSelector);
+            internalSelector = translatedSelector.get();
+        }
+        if (internalGrouper != nullptr) {
+            translatedGrouper = std::make_unique<faiss::IDGrouperTranslated>(indexHandle->binaryIdMap->id_map,
+                                                                             internalGrouper);
+            internalGrouper = translatedGrouper.get();
         }
-        faiss::SearchParameters *searchParameters;
-        faiss::SearchParametersHNSW hnswParams;
-        faiss::SearchParametersIVF ivfParams;
-        std::unique_ptr<faiss::IDGrouperBitmap> idGrouper;
-        std::vector<uint64_t> idGrouperBitmap;
-        auto hnswReader = dynamic_cast<const faiss::IndexHNSW*>(indexReader->index);
-        if (hnswReader) {
-            // Query param ef_search supersedes ef_search provided during index setting.
-            hnswParams.efSearch = knn_jni::commons::getIntegerMethodParameter(env, jniUtil, methodParams, EF_SEARCH, hnswReader->hnsw.efSearch);
-            hnswParams.sel = idSelector.get();
-            if (parentIdsJ != nullptr) {
-                idGrouper = buildIDGrouperBitmap(jniUtil, env, parentIdsJ, &idGrouperBitmap);
-                hnswParams.grp = idGrouper.get();
+    }
+
+    const std::vector<uint8_t> queryVector = copyQueryVector<uint8_t>(jniUtil, env, queryVectorJ,
+                                                                      indexHandle->binaryIndex->code_size);
+    dis->clear();
+    ids->clear();
+    if (radiusJ >= 0) {
+        // Faiss takes the hits strictly below its radius, while radiusJ is the largest distance taken. No Hamming
+        // distance exceeds the dimension.
+        const int radius = radiusJ >= indexHandle->dimension ? indexHandle->dimension + 1 : (int) radiusJ + 1;
+        faiss::RangeSearchResult result(1);
+        switch (indexHandle->kind) {
+            case knn_jni::faiss_wrapper::IndexKind::HNSW: {
+                faiss::SearchParametersHNSW hnswParams;
+                hnswParams.efSearch = searchParams.efSearch.value_or(indexHandle->defaultEfSearch);
+                hnswParams.sel = internalSelector;
+                hnswParams.grp = internalGrouper;
+                hnswParams.max_range_results = window;
+                indexHandle->binaryHnsw->range_search(1, queryVector.data(), radius, &result, &hnswParams);
+                break;
             }
-            searchParameters = &hnswParams;
-        } else {
-            auto ivfReader = dynamic_cast<const faiss::IndexIVF*>(indexReader->index);
-            auto ivfFlatReader = dynamic_cast<const faiss::IndexIVFFlat*>(indexReader->index);
-            if(ivfReader || ivfFlatReader) {
-                ivfParams.sel = idSelector.get();
-                searchParameters = &ivfParams;
+            case knn_jni::faiss_wrapper::IndexKind::IVF:
+                binaryIVFRangeSearch(indexHandle->binaryIvf, queryVector.data(), radius, window,
+                                     searchParams.nprobes.value_or(indexHandle->defaultNprobe), internalSelector,
+                                     internalGrouper, &result);
+                break;
+            default:
+                if (indexHandle->binaryFlat == nullptr) {
+                    throw std::runtime_error("Range search is not supported for this binary index");
+                }
+                binaryFlatRangeSearch(indexHandle->binaryFlat, queryVector.data(), radius, window, internalSelector,
+                                      internalGrouper, &result);
+                break;
+        }
+        copyRangeSearchResult(result, dis, ids);
+        if (indexHandle->binaryIdMap != nullptr) {
+            for (auto & id : *ids) {
+                id = indexHandle->binaryIdMap->id_map[id];
             }
         }
-        try {
-            indexReader->range_search(1, rawQueryVector, radiusJ, &res, searchParameters);
-        } catch (...) {
-            jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryVector, JNI_ABORT);
-            jniUtil->ReleaseLongArrayElements(env, filterIdsJ, filteredIdsArray, JNI_ABORT);
-            throw;
+    }
+    indexHandle->queryCount++;
+
+    return ids->size();
+}
+
+size_t boundedIVFRangeSearch(const faiss::IndexIVF * ivf, const float * query, float radius, size_t window,
+                             size_t nprobe, const faiss::IDSelector * idSelector, float * dis, faiss::idx_t * labels) {
+    std::vector<faiss::idx_t> listNos;
+    std::vector<float> coarseDis;
+    probeIVFLists(ivf, query, nprobe, &listNos, &coarseDis);
+
+    std::fill(dis, dis + window, radius);
+    std::fill(labels, labels + window, -1);
+
+    std::unique_ptr<faiss::InvertedListScanner> scanner(ivf->get_InvertedListScanner(false, idSelector));
+    scanner->set_query(query);
+    for (size_t i = 0; i < listNos.size(); i++) {
+        if (listNos[i] < 0) {
+            continue;
+        }
+        const size_t listSize = ivf->invlists->list_size(listNos[i]);
+        if (listSize == 0) {
+            continue;
         }
-        jniUtil->ReleaseLongArrayElements(env, filterIdsJ, filteredIdsArray, JNI_ABORT);
+        scanner->set_list(listNos[i], coarseDis[i]);
+        faiss::InvertedLists::ScopedCodes codes(ivf->invlists, listNos[i]);
+        faiss::InvertedLists::ScopedIds ids(ivf->invlists, listNos[i]);
+        scanner->scan_codes(listSize, codes.get(), ids.get(), dis, labels, window);
+    }
+
+    // Entries still holding the seed are not hits
+    if (faiss::is_similarity_metric(ivf->metric_type)) {
+        faiss::heap_reorder<faiss::CMin<float, faiss::idx_t>>(window, dis, labels);
     } else {
-        faiss::SearchParameters *searchParameters = nullptr;
-        faiss::SearchParametersHNSW hnswParams;
-        std::unique_ptr<faiss::IDGrouperBitmap> idGrouper;
-        std::vector<uint64_t> idGrouperBitmap;
-        auto hnswReader = dynamic_cast<const faiss::IndexHNSW*>(indexReader->index);
-        if(hnswReader!= nullptr) {
-            // Query param ef_search supersedes ef_search provided during index setting.
-            hnswParams.efSearch = knn_jni::commons::getIntegerMethodParameter(env, jniUtil, methodParams, EF_SEARCH, hnswReader->hnsw.efSearch);
-            if (parentIdsJ != nullptr) {
-                idGrouper = buildIDGrouperBitmap(jniUtil, env, parentIdsJ, &idGrouperBitmap);
-                hnswParams.grp = idGrouper.get();
+        faiss::heap_reorder<faiss::CMax<float, faiss::idx_t>>(window, dis, labels);
+    }
+    return std::find(labels, labels + window, -1) - labels;
+}
+
+void probeIVFLists(const faiss::IndexIVF * ivf, const float * query, size_t nprobe, std::vector<faiss::idx_t> * listNos,
+                   std::vector<float> * coarseDis) {
+    nprobe = std::min(std::max(nprobe, (size_t) 1), ivf->nlist);
+    listNos->resize(nprobe);
+    coarseDis->resize(nprobe);
+    ivf->quantizer->search(1, query, nprobe, coarseDis->data(), listNos->data());
+}
+
+template<typename C>
+void groupedIVFRangeSearch(const faiss::IndexIVF * ivf, const float * query, float radius, size_t window,
+                           size_t nprobe, const faiss::IDSelector * idSelector, const faiss::IDGrouper * grouper,
+                           faiss::RangeSearchResult * result) {
+    std::vector<faiss::idx_t> listNos;
+    std::vector<float> coarseDis;
+    probeIVFLists(ivf, query, nprobe, &listNos, &coarseDis);
+
+    using Handler = faiss::BoundedRangeSearchBlockResultHandler<C>;
+    Handler handler(result, radius, window, grouper);
+    // The hits are written to result when res goes out of scope
+    typename Handler::SingleResultHandler res(handler);
+    res.begin(0);
+    std::unique_ptr<faiss::InvertedListScanner> scanner(ivf->get_InvertedListScanner(false, idSelector));
+    scanner->set_query(query);
+    for (size_t i = 0; i < listNos.size(); i++) {
+        if (listNos[i] < 0) {
+            continue;
+        }
+        const size_t listSize = ivf->invlists->list_size(listNos[i]);
+        scanner->set_list(listNos[i], coarseDis[i]);
+        faiss::InvertedLists::ScopedCodes codes(ivf->invlists, listNos[i]);
+        faiss::InvertedLists::ScopedIds ids(ivf->invlists, listNos[i]);
+        for (size_t j = 0; j < listSize; j++) {
+            if (idSelector != nullptr && !idSelector->is_member(ids[j])) {
+                continue;
             }
-            searchParameters = &hnswParams;
+            res.add_result(scanner->distance_to_code(codes.get() + j * ivf->code_size), ids[j]);
+        }
+    }
+    res.end();
+}
+
+void copyRangeSearchResult(const faiss::RangeSearchResult & result, std::vector<float> * dis,
+                           std::vector<faiss::idx_t> * ids) {
+    dis->assign(result.distances, result.distances + result.lims[1]);
+    ids->assign(result.labels, result.labels + result.lims[1]);
+}
+
+// Hamming distances are exact as floats, which the bounded range handler of Faiss holds
+using BinaryRangeHandler = faiss::BoundedRangeSearchBlockResultHandler<faiss::CMax<float, faiss::idx_t>>;
+
+void binaryIVFRangeSearch(const faiss::IndexBinaryIVF * ivf, const uint8_t * query, int radius, size_t window,
+                          size_t nprobe, const faiss::IDSelector * idSelector, const faiss::IDGrouper * grouper,
+                          faiss::RangeSearchResult * result) {
+    nprobe = std::min(std::max(nprobe, (size_t) 1), ivf->nlist);
+    std::vector<faiss::idx_t> listNos(nprobe);
+    std::vector<int32_t> coarseDis(nprobe);
+    ivf->quantizer->search(1, query, nprobe, coarseDis.data(), listNos.data());
+
+    BinaryRangeHandler handler(result, radius, window, grouper);
+    // The hits are written to result when res goes out of scope
+    BinaryRangeHandler::SingleResultHandler res(handler);
+    res.begin(0);
+    std::unique_ptr<faiss::BinaryInvertedListScanner> scanner(ivf->get_InvertedListScanner(false));
+    scanner->set_query(query);
+    for (size_t i = 0; i < nprobe; i++) {
+        if (listNos[i] < 0) {
+            continue;
         }
-        try {
-            indexReader->range_search(1, rawQueryVector, radiusJ, &res, searchParameters);
-        } catch (...) {
-            jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryVector, JNI_ABORT);
-            throw;
+        const size_t listSize = ivf->invlists->list_size(listNos[i]);
+        scanner->set_list(listNos[i], coarseDis[i]);
+        faiss::InvertedLists::ScopedCodes codes(ivf->invlists, listNos[i]);
+        faiss::InvertedLists::ScopedIds ids(ivf->invlists, listNos[i]);
+        for (size_t j = 0; j < listSize; j++) {
+            if (idSelector != nullptr && !idSelector->is_member(ids[j])) {
+                continue;
+            }
+            res.add_result(scanner->distance_to_code(codes.get() + j * ivf->code_size), ids[j]);
         }
     }
-    jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryVector, JNI_ABORT);
+    res.end();
+}
 
-    // lims is structured to support batched queries, it has a length of nq + 1 (where nq is the number of queries),
-    // lims[i] - lims[i-1] gives the number of results for the i-th query. With a single query we used in k-NN,
-    // res.lims[0] is always 0, and res.lims[1] gives the total number of matching entries found.
-    int resultSize = res.lims[1];
+void binaryFlatRangeSearch(const faiss::IndexBinaryFlat * flat, const uint8_t * query, int radius, size_t window,
+                           const faiss::IDSelector * idSelector, const faiss::IDGrouper * grouper,
+                           faiss::RangeSearchResult * result) {
+    BinaryRangeHandler handler(result, radius, window, grouper);
+    // The hits are written to result when res goes out of scope
+    BinaryRangeHandler::SingleResultHandler res(handler);
+    res.begin(0);
+    faiss::HammingComputerDefault hc(query, flat->code_size);
+    for (faiss::idx_t i = 0; i < flat->ntotal; i++) {
+        if (idSelector != nullptr && !idSelector->is_member(i)) {
+            continue;
+        }
+        res.add_result(hc.hamming(flat->xb.data() + i * flat->code_size), i);
+    }
+    res.end();
+}
 
-    // Limit the result size to maxResultWindowJ so that we don't return more than the max result window
-    // TODO: In the future, we should prevent this via FAISS's ResultHandler.
-    if (resultSize > maxResultWindowJ) {
-        resultSize = maxResultWindowJ;
+void scanRangeSearch(const faiss::Index * index, const float * query, float radius, size_t window,
+                     const faiss::IDSelector * idSelector, const faiss::IDGrouper * grouper,
+                     const std::vector<faiss::idx_t> * idMap, std::vector<float> * dis,
+                     std::vector<faiss::idx_t> * ids) {
+    const bool isSimilarity = faiss::is_similarity_metric(index->metric_type);
+    std::unique_ptr<faiss::DistanceComputer> dc(index->get_distance_computer());
+    dc->set_query(query);
+    // Position in dis and ids of the hit of each group
+    std::unordered_map<faiss::idx_t, size_t> groupHits;
+    for (faiss::idx_t i = 0; i < index->ntotal; i++) {
+        const faiss::idx_t label = idMap != nullptr ? (*idMap)[i] : i;
+        if (idSelector != nullptr && !idSelector->is_member(label)) {
+            continue;
+        }
+        const float distance = (*dc)(i);
+        if (isSimilarity ? distance <= radius : distance >= radius) {
+            continue;
+        }
+        if (grouper == nullptr) {
+            dis->push_back(distance);
+            ids->push_back(label);
+            if (ids->size() == window) {
+                return;
+            }
+            continue;
+        }
+        const faiss::idx_t group = grouper->get_group(label);
+        const auto groupHit = groupHits.find(group);
+        if (groupHit != groupHits.end()) {
+            const size_t position = groupHit->second;
+            if (isSimilarity ? distance > (*dis)[position] : distance < (*dis)[position]) {
+                (*dis)[position] = distance;
+                (*ids)[position] = label;
+            }
+        } else if (ids->size() < window) {
+            groupHits.emplace(group, ids->size());
+            dis->push_back(distance);
+            ids->push_back(label);
+        }
     }
+}
 
-    jclass resultClass = jniUtil->FindClass(env,"org/opensearch/knn/index/query/KNNQueryResult");
-    jmethodID allArgs = jniUtil->FindMethod(env, "org/opensearch/knn/index/query/KNNQueryResult", "<init>");
+void keepClosestRangeResults(const faiss::idx_t * labels, const float * distances, size_t n, size_t window,
+                             faiss::MetricType metric, std::vector<float> * dis, std::vector<faiss::idx_t> * ids) {
+    std::vector<std::pair<float, faiss::idx_t>> hits(n);
+    for (size_t i = 0; i < n; i++) {
+        hits[i] = {distances[i], labels[i]};
+    }
+    const size_t resultSize = std::min(window, n);
+    std::partial_sort(hits.begin(), hits.begin() + resultSize, hits.end(), closerFirst(metric));
 
-    jobjectArray results = jniUtil->NewObjectArray(env, resultSize, resultClass, nullptr);
+    dis->resize(resultSize);
+    ids->resize(resultSize);
+    for (size_t i = 0; i < resultSize; i++) {
+        (*dis)[i] = hits[i].first;
+        (*ids)[i] = hits[i].second;
+    }
+}
 
-    jobject result;
-    for (int i = 0; i < resultSize; ++i) {
-        result = jniUtil->NewObject(env, resultClass, allArgs, res.labels[i], res.distances[i]);
-        jniUtil->SetObjectArrayElement(env, results, i, result);
+// Vectors searched by runWarmupQueries, and the number of neighbors asked for
+constexpr faiss::idx_t WARMUP_QUERY_COUNT = 16;
+constexpr faiss::idx_t WARMUP_QUERY_K = 10;
+
+template<typename Vector>
+void addIndexRegion(const Vector & vector, std::vector<faiss_util::MemoryRegion> * regions) {
+    regions->push_back(faiss_util::MemoryRegion {vector.data(), vector.size() * sizeof(*vector.data())});
+}
+
+void addIndexRegions(const faiss::HNSW & hnsw, std::vector<faiss_util::MemoryRegion> * regions) {
+    addIndexRegion(hnsw.levels, regions);
+    addIndexRegion(hnsw.offsets, regions);
+    // Neighbors of all the levels of a vector are stored next to each other, level 0 being the largest part
+    addIndexRegion(hnsw.neighbors, regions);
+}
+
+void addIndexRegions(const knn_jni::graph::CompactNeighborLists & lists,
+                     std::vector<faiss_util::MemoryRegion> * regions) {
+    addIndexRegion(lists.listOffsets(), regions);
+    addIndexRegion(lists.encodedLists(), regions);
+}
+
+void addIndexRegions(const faiss::InvertedLists * invlists, std::vector<faiss_util::MemoryRegion> * regions) {
+    // Other inverted lists, such as on disk ones, would have to be read to be warmed up
+    if (dynamic_cast<const faiss::ArrayInvertedLists *>(invlists) == nullptr) {
+        return;
     }
+    for (size_t list = 0; list < invlists->nlist; ++list) {
+        const size_t listSize = invlists->list_size(list);
+        regions->push_back(faiss_util::MemoryRegion {invlists->get_codes(list), listSize * invlists->code_size});
+        regions->push_back(faiss_util::MemoryRegion {invlists->get_ids(list), listSize * sizeof(faiss::idx_t)});
+    }
+}
 
-    return results;
+void collectIndexRegions(const knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle,
+                         std::vector<faiss_util::MemoryRegion> * regions) {
+    if (indexHandle->idMap != nullptr) {
+        addIndexRegion(indexHandle->idMap->id_map, regions);
+    }
+    if (indexHandle->binaryIdMap != nullptr) {
+        addIndexRegion(indexHandle->binaryIdMap->id_map, regions);
+    }
+
+    if (indexHandle->hnsw != nullptr) {
+        addIndexRegions(indexHandle->hnsw->hnsw, regions);
+        if (auto * compact = dynamic_cast<const knn_jni::graph::IndexHNSWCompact *>(indexHandle->hnsw)) {
+            addIndexRegions(compact->neighborLists(), regions);
+        }
+        if (auto * storage = dynamic_cast<const faiss::IndexFlatCodes *>(indexHandle->hnsw->storage)) {
+            addIndexRegion(storage->codes, regions);
+        }
+    } else if (indexHandle->binaryHnsw != nullptr) {
+        addIndexRegions(indexHandle->binaryHnsw->hnsw, regions);
+        if (auto * compact = dynamic_cast<const knn_jni::graph::IndexBinaryHNSWCompact *>(indexHandle->binaryHnsw)) {
+            addIndexRegions(compact->neighborLists(), regions);
+        }
+        if (auto * storage = dynamic_cast<const faiss::IndexBinaryFlat *>(indexHandle->binaryHnsw->storage)) {
+            addIndexRegion(storage->xb, regions);
+        }
+    } else if (indexHandle->ivf != nullptr) {
+        addIndexRegions(indexHandle->ivf->invlists, regions);
+        if (auto * quantizer = dynamic_cast<const faiss::IndexFlatCodes *>(indexHandle->ivf->quantizer)) {
+            addIndexRegion(quantizer->codes, regions);
+        }
+    } else if (indexHandle->binaryIvf != nullptr) {
+        addIndexRegions(indexHandle->binaryIvf->invlists, regions);
+        if (auto * quantizer = dynamic_cast<const faiss::IndexBinaryFlat *>(indexHandle->binaryIvf->quantizer)) {
+            addIndexRegion(quantizer->xb, regions);
+        }
+    }
+}
+
+// Searches index with numQueries vectors of source spread across it. source is the vector storage of the index, or its
+// quantizer for IVF indices.
+template<typename IndexT, typename CodeT, typename DistanceT>
+void runWarmupQueries(const IndexT * source, const IndexT * index, size_t vectorLength) {
+    if (source == nullptr || source->ntotal == 0 || index->ntotal == 0) {
+        return;
+    }
+    const faiss::idx_t numQueries = std::min(WARMUP_QUERY_COUNT, source->ntotal);
+    const faiss::idx_t k = std::min(WARMUP_QUERY_K, index->ntotal);
+    std::vector<CodeT> queries(numQueries * vectorLength);
+    for (faiss::idx_t i = 0; i < numQueries; ++i) {
+        source->reconstruct(i * source->ntotal / numQueries, queries.data() + i * vectorLength);
+    }
+    std::vector<DistanceT> distances(numQueries * k);
+    std::vector<faiss::idx_t> labels(numQueries * k);
+    index->search(numQueries, queries.data(), k, distances.data(), labels.data());
+}
+
+void runWarmupQueries(const knn_jni::faiss_wrapper::NativeIndexHandle * indexHandle) {
+    if (indexHandle->hnsw != nullptr) {
+        runWarmupQueries<faiss::Index, float, float>(indexHandle->hnsw->storage, indexHandle->hnsw, indexHandle->hnsw->d);
+    } else if (indexHandle->ivf != nullptr) {
+        runWarmupQueries<faiss::Index, float, float>(indexHandle->ivf->quantizer, indexHandle->ivf, indexHandle->ivf->d);
+    } else if (indexHandle->binaryHnsw != nullptr) {
+        runWarmupQueries<faiss::IndexBinary, uint8_t, int32_t>(
+                indexHandle->binaryHnsw->storage, indexHandle->binaryHnsw, indexHandle->binaryHnsw->code_size);
+    } else if (indexHandle->binaryIvf != nullptr) {
+        runWarmupQueries<faiss::IndexBinary, uint8_t, int32_t>(
+                indexHandle->binaryIvf->quantizer, indexHandle->binaryIvf, indexHandle->binaryIvf->code_size);
+    }
+}
+
+template<typename Vector>
+int64_t vectorBytes(const Vector & vector) {
+    return (int64_t) (vector.capacity() * sizeof(*vector.data()));
+}
+
+void addHNSWMemoryUsage(const faiss::HNSW & hnsw, knn_jni::faiss_wrapper::IndexMemoryUsage * usage) {
+    usage->neighbors += vectorBytes(hnsw.neighbors);
+    usage->levels += vectorBytes(hnsw.levels);
+    usage->offsets += vectorBytes(hnsw.offsets);
+    usage->other += vectorBytes(hnsw.assign_probas) + vectorBytes(hnsw.cum_nneighbor_per_level);
+}
+
+void addInvertedListsMemoryUsage(const faiss::InvertedLists * invlists,
+                                 knn_jni::faiss_wrapper::IndexMemoryUsage * usage) {
+    // Other inverted lists, such as on disk ones, do not keep their lists in memory
+    auto * arrayInvlists = dynamic_cast<const faiss::ArrayInvertedLists *>(invlists);
+    if (arrayInvlists == nullptr) {
+        return;
+    }
+    usage->other += vectorBytes(arrayInvlists->codes) + vectorBytes(arrayInvlists->ids);
+    for (size_t list = 0; list < arrayInvlists->nlist; ++list) {
+        usage->codes += vectorBytes(arrayInvlists->codes[list]);
+        usage->idMap += vectorBytes(arrayInvlists->ids[list]);
+    }
+}
+
+// Counts the whole coarse quantizer as quantizer bytes, whatever its own structures are
+template<typename IndexT>
+void addQuantizerMemoryUsage(const IndexT * quantizer, knn_jni::faiss_wrapper::IndexMemoryUsage * usage) {
+    knn_jni::faiss_wrapper::IndexMemoryUsage quantizerUsage;
+    addIndexMemoryUsage(quantizer, &quantizerUsage);
+    usage->quantizer += quantizerUsage.codes + quantizerUsage.neighbors + quantizerUsage.levels + quantizerUsage.offsets
+                        + quantizerUsage.idMap + quantizerUsage.quantizer + quantizerUsage.other;
+}
+
+void addIndexMemoryUsage(const faiss::Index * index, knn_jni::faiss_wrapper::IndexMemoryUsage * usage) {
+    if (index == nullptr) {
+        return;
+    }
+
+    if (auto * idMap = dynamic_cast<const faiss::IndexIDMap *>(index)) {
+        usage->idMap += vectorBytes(idMap->id_map);
+        addIndexMemoryUsage(idMap->index, usage);
+    } else if (auto * hnsw = dynamic_cast<const faiss::IndexHNSW *>(index)) {
+        addHNSWMemoryUsage(hnsw->hnsw, usage);
+        if (auto * compact = dynamic_cast<const knn_jni::graph::IndexHNSWCompact *>(index)) {
+            usage->neighbors += compact->neighborLists().bytes();
+        }
+        addIndexMemoryUsage(hnsw->storage, usage);
+    } else if (auto * ivf = dynamic_cast<const faiss::IndexIVF *>(index)) {
+        addInvertedListsMemoryUsage(ivf->invlists, usage);
+        addQuantizerMemoryUsage(ivf->quantizer, usage);
+        if (auto * ivfPq = dynamic_cast<const faiss::IndexIVFPQ *>(index)) {
+            usage->quantizer += vectorBytes(ivfPq->pq.centroids) + vectorBytes(ivfPq->pq.sdc_table);
+            if (ivfPq->precomputed_table != nullptr) {
+                const auto tableBytes = (int64_t) (ivfPq->precomputed_table->size() * sizeof(float));
+                if (ivfPq->owns_precomputed_table) {
+                    usage->quantizer += tableBytes;
+                } else {
+                    usage->sharedState += tableBytes;
+                }
+            }
+        } else if (auto * ivfSq = dynamic_cast<const faiss::IndexIVFScalarQuantizer *>(index)) {
+            usage->quantizer += vectorBytes(ivfSq->sq.trained);
+        }
+    } else if (auto * flatCodes = dynamic_cast<const faiss::IndexFlatCodes *>(index)) {
+        usage->codes += vectorBytes(flatCodes->codes);
+        if (auto * pq = dynamic_cast<const faiss::IndexPQ *>(index)) {
+            usage->quantizer += vectorBytes(pq->pq.centroids) + vectorBytes(pq->pq.sdc_table);
+        } else if (auto * sq = dynamic_cast<const faiss::IndexScalarQuantizer *>(index)) {
+            usage->quantizer += vectorBytes(sq->sq.trained);
+        }
+    }
+}
+
+void addIndexMemoryUsage(const faiss::IndexBinary * index, knn_jni::faiss_wrapper::IndexMemoryUsage * usage) {
+    if (index == nullptr) {
+        return;
+    }
+
+    if (auto * idMap = dynamic_cast<const faiss::IndexBinaryIDMap *>(index)) {
+        usage->idMap += vectorBytes(idMap->id_map);
+        addIndexMemoryUsage(idMap->index, usage);
+    } else if (auto * hnsw = dynamic_cast<const faiss::IndexBinaryHNSW *>(index)) {
+        addHNSWMemoryUsage(hnsw->hnsw, usage);
+        if (auto * compact = dynamic_cast<const knn_jni::graph::IndexBinaryHNSWCompact *>(index)) {
+            usage->neighbors += compact->neighborLists().bytes();
+        }
+        addIndexMemoryUsage(hnsw->storage, usage);
+    } else if (auto * ivf = dynamic_cast<const faiss::IndexBinaryIVF *>(index)) {
+        addInvertedListsMemoryUsage(ivf->invlists, usage);
+        addQuantizerMemoryUsage(ivf->quantizer, usage);
+    } else if (auto * flat = dynamic_cast<const faiss::IndexBinaryFlat *>(index)) {
+        usage->codes += vectorBytes(flat->xb);
+    }
+}
+
+LoadArena createLoadArena() {
+    if (!indexArenasEnabled) {
+        return LoadArena();
+    }
+    return LoadArena(knn_jni::memory::IndexArena::create());
+}
+
+void compactLoadedGraph(faiss::Index * index) {
+    if (compactGraphsEnabled) {
+        knn_jni::graph::compactIndexIDMapHNSW(dynamic_cast<faiss::IndexIDMap *>(index));
+    }
+}
+
+void compactLoadedGraph(faiss::IndexBinary * index) {
+    if (compactGraphsEnabled) {
+        knn_jni::graph::compactIndexBinaryIDMapHNSW(dynamic_cast<faiss::IndexBinaryIDMap *>(index));
+    }
 }
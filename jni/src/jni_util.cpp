@@ -221,48 +221,58 @@ int knn_jni::JNIUtil::ConvertJavaObjectToCppInteger(JNIEnv *env, jobject objectJ
     return intCpp;
 }
 
-std::vector<float> knn_jni::JNIUtil::Convert2dJavaObjectArrayToCppFloatVector(JNIEnv *env, jobjectArray array2dJ,
-                                                                              int dim) {
-    std::vector<float> vect;
-    Convert2dJavaObjectArrayAndStoreToFloatVector(env, array2dJ, dim, &vect);
-    return vect;
-}
+namespace {
+    // Calls appendRow with the components of every row of a 2D Java float array
+    template<typename AppendRow>
+    void forEachJavaFloatArrayRow(knn_jni::JNIUtil *jniUtil, JNIEnv *env, jobjectArray array2dJ, int dim,
+                                  AppendRow appendRow) {
+        if (array2dJ == nullptr) {
+            throw std::runtime_error("Array cannot be null");
+        }
 
-void knn_jni::JNIUtil::Convert2dJavaObjectArrayAndStoreToFloatVector(JNIEnv *env, jobjectArray array2dJ,
-                                                                     int dim, std::vector<float> *vect) {
+        int numVectors = env->GetArrayLength(array2dJ);
+        jniUtil->HasExceptionInStack(env);
 
-    if (array2dJ == nullptr) {
-        throw std::runtime_error("Array cannot be null");
-    }
+        for (int i = 0; i < numVectors; ++i) {
+            auto vectorArray = (jfloatArray)env->GetObjectArrayElement(array2dJ, i);
+            jniUtil->HasExceptionInStack(env, "Unable to get object array element");
 
-    int numVectors = env->GetArrayLength(array2dJ);
-    this->HasExceptionInStack(env);
+            if (dim != env->GetArrayLength(vectorArray)) {
+                throw std::runtime_error("Dimension of vectors is inconsistent");
+            }
 
-    for (int i = 0; i < numVectors; ++i) {
-        auto vectorArray = (jfloatArray)env->GetObjectArrayElement(array2dJ, i);
-        this->HasExceptionInStack(env, "Unable to get object array element");
+            float* vector = env->GetFloatArrayElements(vectorArray, nullptr);
+            if (vector == nullptr) {
+                jniUtil->HasExceptionInStack(env);
+                throw std::runtime_error("Unable to get float array elements");
+            }
 
-        if (dim != env->GetArrayLength(vectorArray)) {
-            throw std::runtime_error("Dimension of vectors is inconsistent");
-        }
+            appendRow(vector, dim);
+            env->ReleaseFloatArrayElements(vectorArray, vector, JNI_ABORT);
+        }  // End for
+        jniUtil->HasExceptionInStack(env);
+        env->DeleteLocalRef(array2dJ);
+    }
+}
 
-        float* vector = env->GetFloatArrayElements(vectorArray, nullptr);
-        if (vector == nullptr) {
-            this->HasExceptionInStack(env);
-            throw std::runtime_error("Unable to get float array elements");
-        }
+std::vector<float> knn_jni::JNIUtil::Convert2dJavaObjectArrayToCppFloatVector(JNIEnv *env, jobjectArray array2dJ,
+                                                                              int dim) {
+    std::vector<float> vect;
+    forEachJavaFloatArrayRow(this, env, array2dJ, dim, [&vect](const float *vector, int dim) {
+        vect.insert(vect.end(), vector, vector + dim);
+    });
+    return vect;
+}
 
-        for (int j = 0; j < dim; ++j) {
-            vect->push_back(vector[j]);
-        }
-        env->ReleaseFloatArrayElements(vectorArray, vector, JNI_ABORT);
-    }  // End for
-    this->HasExceptionInStack(env);
-    env->DeleteLocalRef(array2dJ);
+void knn_jni::JNIUtil::Convert2dJavaObjectArrayAndStoreToFloatVector(JNIEnv *env, jobjectArray array2dJ,
+                                                                     int dim, knn_jni::memory::VectorBuffer<float> *vect) {
+    forEachJavaFloatArrayRow(this, env, array2dJ, dim, [vect](const float *vector, int dim) {
+        vect->append(vector, dim);
+    });
 }
 
 void knn_jni::JNIUtil::Convert2dJavaObjectArrayAndStoreToBinaryVector(JNIEnv *env, jobjectArray array2dJ,
-                                                                     int dim, std::vector<uint8_t> *vect) {
+                                                                     int dim, knn_jni::memory::VectorBuffer<uint8_t> *vect) {
 
     if (array2dJ == nullptr) {
         throw std::runtime_error("Array cannot be null");
@@ -285,9 +295,7 @@ void knn_jni::JNIUtil::Convert2dJavaObjectArrayAndStoreToBinaryVector(JNIEnv *en
             throw std::runtime_error("Unable to get byte array elements");
         }
 
-        for (int j = 0; j < dim; ++j) {
-            vect->push_back(vector[j]);
-        }
+        vect->append(vector, dim);
         env->ReleaseByteArrayElements(vectorArray, reinterpret_cast<int8_t*>(vector), JNI_ABORT);
     }
     this->HasExceptionInStack(env);
@@ -295,7 +303,7 @@ void knn_jni::JNIUtil::Convert2dJavaObjectArrayAndStoreToBinaryVector(JNIEnv *en
 }
 
 void knn_jni::JNIUtil::Convert2dJavaObjectArrayAndStoreToByteVector(JNIEnv *env, jobjectArray array2dJ,
-                                                                     int dim, std::vector<int8_t> *vect) {
+                                                                     int dim, knn_jni::memory::VectorBuffer<int8_t> *vect) {
 
     if (array2dJ == nullptr) {
         throw std::runtime_error("Array cannot be null");
@@ -319,7 +327,7 @@ void knn_jni::JNIUtil::Convert2dJavaObjectArrayAndStoreToByteVector(JNIEnv *env,
             throw std::runtime_error("Unable to get byte array elements");
         }
 
-        vect->insert(vect->end(), vector, vector + dim);
+        vect->append(vector, dim);
         env->ReleaseByteArrayElements(vectorArray, reinterpret_cast<int8_t*>(vector), JNI_ABORT);
     }
     this->HasExceptionInStack(env);
@@ -521,6 +529,16 @@ jbyteArray knn_jni::JNIUtil::NewByteArray(JNIEnv *env, jsize len) {
     return byteArray;
 }
 
+jlongArray knn_jni::JNIUtil::NewLongArray(JNIEnv *env, jsize len) {
+    jlongArray longArray = env->NewLongArray(len);
+    if (longArray == nullptr) {
+        this->HasExceptionInStack(env, "Unable to allocate long array");
+        throw std::runtime_error("Unable to allocate long array");
+    }
+
+    return longArray;
+}
+
 void knn_jni::JNIUtil::ReleaseByteArrayElements(JNIEnv *env, jbyteArray array, jbyte *elems, int mode) {
     env->ReleaseByteArrayElements(array, elems, mode);
 }
@@ -547,6 +565,21 @@ void knn_jni::JNIUtil::SetByteArrayRegion(JNIEnv *env, jbyteArray array, jsize s
     this->HasExceptionInStack(env, "Unable to set byte array region");
 }
 
+void knn_jni::JNIUtil::SetIntArrayRegion(JNIEnv *env, jintArray array, jsize start, jsize len, const jint * buf) {
+    env->SetIntArrayRegion(array, start, len, buf);
+    this->HasExceptionInStack(env, "Unable to set int array region");
+}
+
+void knn_jni::JNIUtil::SetLongArrayRegion(JNIEnv *env, jlongArray array, jsize start, jsize len, const jlong * buf) {
+    env->SetLongArrayRegion(array, start, len, buf);
+    this->HasExceptionInStack(env, "Unable to set long array region");
+}
+
+void knn_jni::JNIUtil::SetFloatArrayRegion(JNIEnv *env, jfloatArray array, jsize start, jsize len, const jfloat * buf) {
+    env->SetFloatArrayRegion(array, start, len, buf);
+    this->HasExceptionInStack(env, "Unable to set float array region");
+}
+
 jobject knn_jni::JNIUtil::GetObjectField(JNIEnv * env, jobject obj, jfieldID fieldID) {
     return env->GetObjectField(obj, fieldID);
 }
@@ -586,6 +619,15 @@ void knn_jni::JNIUtil::ReleasePrimitiveArrayCritical(JNIEnv * env, jarray array,
     return env->ReleasePrimitiveArrayCritical(array, carray, mode);
 }
 
+void * knn_jni::JNIUtil::GetDirectBufferAddress(JNIEnv * env, jobject buf) {
+    // Returns nullptr if buf is not a direct buffer
+    return env->GetDirectBufferAddress(buf);
+}
+
+jlong knn_jni::JNIUtil::GetDirectBufferCapacity(JNIEnv * env, jobject buf) {
+    return env->GetDirectBufferCapacity(buf);
+}
+
 jobject knn_jni::GetJObjectFromMapOrThrow(std::unordered_map<std::string, jobject> map, std::string key) {
     auto it = map.find(key);
     if (it != map.end()) {
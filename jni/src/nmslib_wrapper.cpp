@@ -14,6 +14,7 @@
 #include "nmslib_stream_support.h"
 
 #include "commons.h"
+#include "vector_buffer_pool.h"
 
 #include "init.h"
 #include "index.h"
@@ -98,7 +99,7 @@ void knn_jni::nmslib_wrapper::CreateIndex(knn_jni::JNIUtilInterface *jniUtil, JN
   space.reset(similarity::SpaceFactoryRegistry<float>::Instance().CreateSpace(spaceTypeCpp, similarity::AnyParams()));
 
   // Get number of ids and vectors and dimension
-  auto *inputVectors = reinterpret_cast<std::vector<float> *>(vectorsAddressJ);
+  auto *inputVectors = reinterpret_cast<knn_jni::memory::VectorBuffer<float> *>(vectorsAddressJ);
   int dim = (int) dimJ;
   // The number of vectors can be int here because a lucene segment number of total docs never crosses INT_MAX value
   int numVectors = (int) (inputVectors->size() / (uint64_t) dim);
@@ -151,7 +152,7 @@ void knn_jni::nmslib_wrapper::CreateIndex(knn_jni::JNIUtilInterface *jniUtil, JN
       memcpy(ptr, &vectorSizeInBytes, similarity::DATALENGTH_SIZE);
       ptr += similarity::DATALENGTH_SIZE;
 
-      memcpy(ptr, &(inputVectors->at(vectorPointer)), vectorSizeInBytes);
+      memcpy(ptr, inputVectors->data() + vectorPointer, vectorSizeInBytes);
       ptr += vectorSizeInBytes;
       vectorPointer += dim;
     }
@@ -159,11 +160,9 @@ void knn_jni::nmslib_wrapper::CreateIndex(knn_jni::JNIUtilInterface *jniUtil, JN
       jniUtil->ReleaseIntArrayElements(env, idsJ, idsCpp, JNI_ABORT);
     }};
 
-    // Releasing the vectorsAddressJ memory as that is not required once we have created the index.
-    // This is not the ideal approach, please refer this gh issue for long term solution:
-    // https://github.com/opensearch-project/k-NN/issues/1600
-    //commons::freeVectorData(vectorsAddressJ);
-    delete inputVectors;
+    // Hand the vectors back to the pool as they are not required once we have created the index. The buffer itself
+    // stays owned by the Java layer, which frees it
+    inputVectors->release();
 
     std::unique_ptr<similarity::Index<float>> index;
     index.reset(similarity::MethodFactoryRegistry<float>::Instance().CreateMethod(false,
@@ -173,8 +172,8 @@ void knn_jni::nmslib_wrapper::CreateIndex(knn_jni::JNIUtilInterface *jniUtil, JN
                                                                                   dataset));
     index->CreateIndex(similarity::AnyParams(indexParameters));
 
-    knn_jni::stream::NativeEngineIndexOutputMediator mediator {jniUtil, env, output};
-    knn_jni::stream::NmslibOpenSearchIOWriter writer {&mediator};
+    auto mediator = knn_jni::stream::createIndexOutputMediator(jniUtil, env, output);
+    knn_jni::stream::NmslibOpenSearchIOWriter writer {mediator.get()};
 
     if (auto hnswFloatIndex = dynamic_cast<similarity::Hnsw<float> *>(index.get())) {
       hnswFloatIndex->SaveIndexWithStream(writer);
@@ -267,9 +266,9 @@ jlong knn_jni::nmslib_wrapper::LoadIndexWithStream(knn_jni::JNIUtilInterface *jn
 
   // Create a mediator locally.
   // Note that `indexInput` is `IndexInputWithBuffer` type.
-  knn_jni::stream::NativeEngineIndexInputMediator mediator{jniUtil, env, readStream};
+  auto mediator = knn_jni::stream::createIndexInputMediator(jniUtil, env, readStream);
 
-  knn_jni::stream::NmslibOpenSearchIOReader ioReader {&mediator};
+  knn_jni::stream::NmslibOpenSearchIOReader ioReader {mediator.get()};
 
   // Load index
   knn_jni::nmslib_wrapper::IndexWrapper *indexWrapper = nullptr;
@@ -290,8 +289,12 @@ jlong knn_jni::nmslib_wrapper::LoadIndexWithStream(knn_jni::JNIUtilInterface *jn
   return (jlong) indexWrapper;
 }
 
-jobjectArray knn_jni::nmslib_wrapper::QueryIndex(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong indexPointerJ,
-                                                 jfloatArray queryVectorJ, jint kJ, jobject methodParamsJ) {
+// Runs a k-NN query against the index located in memory at indexPointerJ
+//
+// Returns the neighbors found, popped from the farthest to the nearest
+std::unique_ptr<similarity::KNNQueue<float>> InternalQueryIndex(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env,
+                                                                jlong indexPointerJ, jfloatArray queryVectorJ, jint kJ,
+                                                                const knn_jni::commons::SearchParams &searchParams) {
 
   if (queryVectorJ == nullptr) {
     throw std::runtime_error("Query Vector cannot be null");
@@ -305,33 +308,37 @@ jobjectArray knn_jni::nmslib_wrapper::QueryIndex(knn_jni::JNIUtilInterface *jniU
 
   int dim = jniUtil->GetJavaFloatArrayLength(env, queryVectorJ);
 
-  float *rawQueryvector = jniUtil->GetFloatArrayElements(env, queryVectorJ, nullptr); // Have to call release on this
+  // The object copies the vector, so the array is only held critical for that copy rather than copied out of the
+  // Java heap first
+  void *rawQueryvector = jniUtil->GetPrimitiveArrayCritical(env, queryVectorJ, nullptr);
+  if (rawQueryvector == nullptr) {
+    throw std::runtime_error("Unable to pin query vector");
+  }
 
   std::unique_ptr<const similarity::Object> queryObject;
   try {
     queryObject.reset(new similarity::Object(-1, -1, dim * sizeof(float), rawQueryvector));
   } catch (...) {
-    jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
+    jniUtil->ReleasePrimitiveArrayCritical(env, queryVectorJ, rawQueryvector, JNI_ABORT);
     throw;
   }
 
-  jniUtil->ReleaseFloatArrayElements(env, queryVectorJ, rawQueryvector, JNI_ABORT);
-  std::unordered_map<std::string, jobject> methodParams;
-  if (methodParamsJ != nullptr) {
-    methodParams = jniUtil->ConvertJavaMapToCppMap(env, methodParamsJ);
-  }
-
-  int queryEfSearch = knn_jni::commons::getIntegerMethodParameter(env, jniUtil, methodParams, EF_SEARCH, -1);
+  jniUtil->ReleasePrimitiveArrayCritical(env, queryVectorJ, rawQueryvector, JNI_ABORT);
   std::unique_ptr<similarity::KNNQuery<float>> query;
-  std::unique_ptr<similarity::KNNQueue<float>> neighbors;
-  if (queryEfSearch == -1) {
+  if (!searchParams.efSearch.has_value()) {
     query.reset(new similarity::KNNQuery<float>(*(indexWrapper->space), queryObject.get(), kJ));
   } else {
-    query.reset(new similarity::HNSWQuery<float>(*(indexWrapper->space), queryObject.get(), kJ, queryEfSearch));
+    query.reset(new similarity::HNSWQuery<float>(*(indexWrapper->space), queryObject.get(), kJ, *searchParams.efSearch));
   }
 
   indexWrapper->index->Search(query.get());
-  neighbors.reset(query->Result()->Clone());
+  return std::unique_ptr<similarity::KNNQueue<float>>(query->Result()->Clone());
+}
+
+jobjectArray knn_jni::nmslib_wrapper::QueryIndex(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env, jlong indexPointerJ,
+                                                 jfloatArray queryVectorJ, jint kJ, jobject methodParamsJ) {
+  std::unique_ptr<similarity::KNNQueue<float>> neighbors = InternalQueryIndex(jniUtil, env, indexPointerJ, queryVectorJ, kJ,
+                                                                              knn_jni::commons::parseSearchParams(jniUtil, env, methodParamsJ));
 
   int resultSize = neighbors->Size();
   jclass resultClass = jniUtil->FindClass(env, "org/opensearch/knn/index/query/KNNQueryResult");
@@ -347,11 +354,38 @@ jobjectArray knn_jni::nmslib_wrapper::QueryIndex(knn_jni::JNIUtilInterface *jniU
     id = neighbors->Pop()->id();
     result = jniUtil->NewObject(env, resultClass, allArgs, id, distance);
     jniUtil->SetObjectArrayElement(env, results, i, result);
+    // The array holds its own reference, drop the local one so that large k does not exhaust the local frame
+    jniUtil->DeleteLocalRef(env, result);
   }
 
   return results;
 }
 
+jint knn_jni::nmslib_wrapper::QueryIndex_WithSearchParams(knn_jni::JNIUtilInterface *jniUtil, JNIEnv *env,
+                                                          jlong indexPointerJ, jfloatArray queryVectorJ, jint kJ,
+                                                          jlong searchParamsJ, jintArray resultIdsJ,
+                                                          jfloatArray resultDistancesJ) {
+  if (resultIdsJ == nullptr || resultDistancesJ == nullptr) {
+    throw std::runtime_error("Result arrays cannot be null");
+  }
+
+  std::unique_ptr<similarity::KNNQueue<float>> neighbors = InternalQueryIndex(jniUtil, env, indexPointerJ, queryVectorJ, kJ,
+                                                                              knn_jni::commons::getSearchParams(searchParamsJ));
+
+  // Keep the same order as QueryIndex so that both result modes are interchangeable
+  int resultSize = neighbors->Size();
+  std::vector<jint> ids(resultSize);
+  std::vector<jfloat> distances(resultSize);
+  for (int i = 0; i < resultSize; ++i) {
+    distances[i] = neighbors->TopDistance();
+    ids[i] = neighbors->Pop()->id();
+  }
+
+  jniUtil->SetIntArrayRegion(env, resultIdsJ, 0, resultSize, ids.data());
+  jniUtil->SetFloatArrayRegion(env, resultDistancesJ, 0, resultSize, distances.data());
+  return resultSize;
+}
+
 void knn_jni::nmslib_wrapper::Free(jlong indexPointerJ) {
   auto *indexWrapper = reinterpret_cast<knn_jni::nmslib_wrapper::IndexWrapper *>(indexPointerJ);
   delete indexWrapper;
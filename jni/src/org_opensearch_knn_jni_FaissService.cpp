@@ -13,6 +13,7 @@
 
 #include <jni.h>
 
+#include <string>
 #include <vector>
 
 #include "faiss_wrapper.h"
@@ -124,6 +125,72 @@ JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_insertToByteInde
     }
 }
 
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_startIngestion(JNIEnv * env, jclass cls,
+                                                                                jlong indexAddress, jint dimJ,
+                                                                                jint threadCount, jint maxPendingBatchesJ)
+{
+    try {
+        std::unique_ptr<knn_jni::faiss_wrapper::FaissMethods> faissMethods(new knn_jni::faiss_wrapper::FaissMethods());
+        std::unique_ptr<knn_jni::faiss_wrapper::IndexService> indexService(
+            new knn_jni::faiss_wrapper::IndexService(std::move(faissMethods)));
+        return knn_jni::faiss_wrapper::StartIngestion(indexAddress, dimJ, threadCount, maxPendingBatchesJ, std::move(indexService));
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return (jlong)0;
+}
+
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_startBinaryIngestion(JNIEnv * env, jclass cls,
+                                                                                      jlong indexAddress, jint dimJ,
+                                                                                      jint threadCount, jint maxPendingBatchesJ)
+{
+    try {
+        std::unique_ptr<knn_jni::faiss_wrapper::FaissMethods> faissMethods(new knn_jni::faiss_wrapper::FaissMethods());
+        std::unique_ptr<knn_jni::faiss_wrapper::IndexService> binaryIndexService(
+            new knn_jni::faiss_wrapper::BinaryIndexService(std::move(faissMethods)));
+        return knn_jni::faiss_wrapper::StartIngestion(indexAddress, dimJ, threadCount, maxPendingBatchesJ, std::move(binaryIndexService));
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return (jlong)0;
+}
+
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_startByteIngestion(JNIEnv * env, jclass cls,
+                                                                                    jlong indexAddress, jint dimJ,
+                                                                                    jint threadCount, jint maxPendingBatchesJ)
+{
+    try {
+        std::unique_ptr<knn_jni::faiss_wrapper::FaissMethods> faissMethods(new knn_jni::faiss_wrapper::FaissMethods());
+        std::unique_ptr<knn_jni::faiss_wrapper::IndexService> byteIndexService(
+            new knn_jni::faiss_wrapper::ByteIndexService(std::move(faissMethods)));
+        return knn_jni::faiss_wrapper::StartIngestion(indexAddress, dimJ, threadCount, maxPendingBatchesJ, std::move(byteIndexService));
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return (jlong)0;
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_submitToIngestion(JNIEnv * env, jclass cls,
+                                                                                  jlong sessionAddress, jintArray idsJ,
+                                                                                  jlong vectorsAddressJ)
+{
+    try {
+        knn_jni::faiss_wrapper::SubmitToIngestion(&jniUtil, env, sessionAddress, idsJ, vectorsAddressJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_finishIngestion(JNIEnv * env, jclass cls,
+                                                                                jlong sessionAddress)
+{
+    try {
+        knn_jni::faiss_wrapper::FinishIngestion(sessionAddress);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_writeIndex(JNIEnv * env,
                                                                            jclass cls,
                                                                            jlong indexAddress,
@@ -252,10 +319,10 @@ JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_loadIndexWithSt
     try {
         // Create a mediator locally.
         // Note that `indexInput` is `IndexInputWithBuffer` type.
-        knn_jni::stream::NativeEngineIndexInputMediator mediator {&jniUtil, env, readStream};
+        auto mediator = knn_jni::stream::createIndexInputMediator(&jniUtil, env, readStream);
 
         // Wrap the mediator with a glue code inheriting IOReader.
-        knn_jni::stream::FaissOpenSearchIOReader faissOpenSearchIOReader {&mediator};
+        knn_jni::stream::FaissOpenSearchIOReader faissOpenSearchIOReader {mediator.get()};
 
         // Pass IOReader to Faiss for loading vector index.
         return knn_jni::faiss_wrapper::LoadIndexWithStream(
@@ -284,10 +351,10 @@ JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_loadBinaryIndex
     try {
         // Create a mediator locally.
         // Note that `indexInput` is `IndexInputWithBuffer` type.
-        knn_jni::stream::NativeEngineIndexInputMediator mediator {&jniUtil, env, readStream};
+        auto mediator = knn_jni::stream::createIndexInputMediator(&jniUtil, env, readStream);
 
         // Wrap the mediator with a glue code inheriting IOReader.
-        knn_jni::stream::FaissOpenSearchIOReader faissOpenSearchIOReader {&mediator};
+        knn_jni::stream::FaissOpenSearchIOReader faissOpenSearchIOReader {mediator.get()};
 
         // Pass IOReader to Faiss for loading vector index.
         return knn_jni::faiss_wrapper::LoadBinaryIndexWithStream(
@@ -369,6 +436,206 @@ JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_queryBin
 
 }
 
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_queryIndexWithFilterBuffer
+  (JNIEnv * env, jclass cls, jlong indexPointerJ, jfloatArray queryVectorJ, jint kJ, jlong searchParamsJ,
+   jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ, jintArray resultIdsJ, jfloatArray resultDistancesJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::QueryIndex_WithFilterBuffer(&jniUtil, env, indexPointerJ, queryVectorJ, kJ,
+                                                                   searchParamsJ, filterBufferJ, filterIdsTypeJ,
+                                                                   parentIdsJ, resultIdsJ, resultDistancesJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return 0;
+}
+
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_queryBinaryIndexWithFilterBuffer
+  (JNIEnv * env, jclass cls, jlong indexPointerJ, jbyteArray queryVectorJ, jint kJ, jlong searchParamsJ,
+   jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ, jintArray resultIdsJ, jfloatArray resultDistancesJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::QueryBinaryIndex_WithFilterBuffer(&jniUtil, env, indexPointerJ, queryVectorJ,
+                                                                         kJ, searchParamsJ, filterBufferJ,
+                                                                         filterIdsTypeJ, parentIdsJ, resultIdsJ,
+                                                                         resultDistancesJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return 0;
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_queryIndexBatch
+  (JNIEnv * env, jclass cls, jlong indexPointerJ, jfloatArray queryVectorsJ, jint numQueriesJ, jint kJ, jlong searchParamsJ,
+   jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ, jintArray resultIdsJ, jfloatArray resultDistancesJ)
+{
+    try {
+        knn_jni::faiss_wrapper::QueryIndexBatch(&jniUtil, env, indexPointerJ, queryVectorsJ, numQueriesJ, kJ, searchParamsJ,
+                                               filterBufferJ, filterIdsTypeJ, parentIdsJ, resultIdsJ, resultDistancesJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_queryByteIndexBatch
+  (JNIEnv * env, jclass cls, jlong indexPointerJ, jbyteArray queryVectorsJ, jint numQueriesJ, jint kJ, jlong searchParamsJ,
+   jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ, jintArray resultIdsJ, jfloatArray resultDistancesJ)
+{
+    try {
+        knn_jni::faiss_wrapper::QueryByteIndexBatch(&jniUtil, env, indexPointerJ, queryVectorsJ, numQueriesJ, kJ, searchParamsJ,
+                                               filterBufferJ, filterIdsTypeJ, parentIdsJ, resultIdsJ, resultDistancesJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_queryBinaryIndexBatch
+  (JNIEnv * env, jclass cls, jlong indexPointerJ, jbyteArray queryVectorsJ, jint numQueriesJ, jint kJ, jlong searchParamsJ,
+   jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ, jintArray resultIdsJ, jfloatArray resultDistancesJ)
+{
+    try {
+        knn_jni::faiss_wrapper::QueryBinaryIndexBatch(&jniUtil, env, indexPointerJ, queryVectorsJ, numQueriesJ, kJ, searchParamsJ,
+                                               filterBufferJ, filterIdsTypeJ, parentIdsJ, resultIdsJ, resultDistancesJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_exactSearchWithFilter
+  (JNIEnv * env, jclass cls, jlong indexPointerJ, jfloatArray queryVectorJ, jint kJ, jlongArray filteredIdsJ,
+   jint filterIdsTypeJ, jintArray resultIdsJ, jfloatArray resultDistancesJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::ExactSearch_WithFilter(&jniUtil, env, indexPointerJ, queryVectorJ, kJ, filteredIdsJ,
+                                                              filterIdsTypeJ, resultIdsJ, resultDistancesJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return 0;
+}
+
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_exactRangeSearchWithFilter
+  (JNIEnv * env, jclass cls, jlong indexPointerJ, jfloatArray queryVectorJ, jfloat radiusJ, jint maxResultWindowJ,
+   jlongArray filteredIdsJ, jint filterIdsTypeJ, jintArray resultIdsJ, jfloatArray resultDistancesJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::ExactRangeSearch_WithFilter(&jniUtil, env, indexPointerJ, queryVectorJ, radiusJ,
+                                                                   maxResultWindowJ, filteredIdsJ, filterIdsTypeJ,
+                                                                   resultIdsJ, resultDistancesJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return 0;
+}
+
+JNIEXPORT jlongArray JNICALL Java_org_opensearch_knn_jni_FaissService_warmIndex(JNIEnv * env, jclass cls,
+                                                                                 jlong indexPointerJ, jint modeJ)
+{
+    try {
+        if (modeJ < (jint) knn_jni::faiss_wrapper::WarmupMode::ADVISE
+            || modeJ > (jint) knn_jni::faiss_wrapper::WarmupMode::QUERY) {
+            throw std::runtime_error("Invalid warmup mode: " + std::to_string(modeJ));
+        }
+        const auto stats = knn_jni::faiss_wrapper::WarmIndex(indexPointerJ,
+                                                             static_cast<knn_jni::faiss_wrapper::WarmupMode>(modeJ));
+        jlong statsCpp[] = {stats.bytes, stats.elapsedNanos};
+        jlongArray statsJ = jniUtil.NewLongArray(env, 2);
+        jniUtil.SetLongArrayRegion(env, statsJ, 0, 2, statsCpp);
+        return statsJ;
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
+JNIEXPORT jlongArray JNICALL Java_org_opensearch_knn_jni_FaissService_getIndexMemoryUsage(JNIEnv * env, jclass cls,
+                                                                                           jlong indexPointerJ)
+{
+    try {
+        const auto usage = knn_jni::faiss_wrapper::GetIndexMemoryUsage(indexPointerJ);
+        jlong usageCpp[] = {
+            usage.codes, usage.neighbors, usage.levels, usage.offsets, usage.idMap, usage.quantizer, usage.sharedState,
+            usage.other
+        };
+        jsize numComponents = sizeof(usageCpp) / sizeof(usageCpp[0]);
+        jlongArray usageJ = jniUtil.NewLongArray(env, numComponents);
+        jniUtil.SetLongArrayRegion(env, usageJ, 0, numComponents, usageCpp);
+        return usageJ;
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_placeIndex(JNIEnv * env, jclass cls,
+                                                                           jlong indexPointerJ, jint nodeJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::PlaceIndex(indexPointerJ, nodeJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return -1;
+}
+
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_getIndexNumaNode(JNIEnv * env, jclass cls,
+                                                                                 jlong indexPointerJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::GetIndexNumaNode(indexPointerJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return -1;
+}
+
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_getNumaNodeCount(JNIEnv * env, jclass cls)
+{
+    try {
+        return knn_jni::faiss_wrapper::GetNumaNodeCount();
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return 1;
+}
+
+JNIEXPORT jboolean JNICALL Java_org_opensearch_knn_jni_FaissService_configureIndexArenas(JNIEnv * env, jclass cls,
+                                                                                         jboolean enabledJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::ConfigureIndexArenas(enabledJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return false;
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_configureCompactGraphs(JNIEnv * env, jclass cls,
+                                                                                       jboolean enabledJ)
+{
+    try {
+        knn_jni::faiss_wrapper::ConfigureCompactGraphs(enabledJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT jlongArray JNICALL Java_org_opensearch_knn_jni_FaissService_getIndexArenaStats(JNIEnv * env, jclass cls,
+                                                                                         jlong indexPointerJ)
+{
+    try {
+        const auto stats = knn_jni::faiss_wrapper::GetIndexArenaStats(indexPointerJ);
+        jlong statsCpp[] = {stats.mappedBytes, stats.liveBytes, stats.liveAllocations, stats.chunks, stats.largeAllocations};
+        jsize numStats = sizeof(statsCpp) / sizeof(statsCpp[0]);
+        jlongArray statsJ = jniUtil.NewLongArray(env, numStats);
+        jniUtil.SetLongArrayRegion(env, statsJ, 0, numStats, statsCpp);
+        return statsJ;
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_FaissService_free(JNIEnv * env, jclass cls, jlong indexPointerJ, jboolean isBinaryIndexJ)
 {
     try {
@@ -440,16 +707,15 @@ JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_FaissService_transferVectors
                                                                                  jlong vectorsPointerJ,
                                                                                  jobjectArray vectorsJ)
 {
-    std::vector<float> *vect;
+    knn_jni::memory::VectorBuffer<float> *vect;
     if ((long) vectorsPointerJ == 0) {
-        vect = new std::vector<float>;
+        vect = new knn_jni::memory::VectorBuffer<float>();
     } else {
-        vect = reinterpret_cast<std::vector<float>*>(vectorsPointerJ);
+        vect = reinterpret_cast<knn_jni::memory::VectorBuffer<float>*>(vectorsPointerJ);
     }
 
     int dim = jniUtil.GetInnerDimensionOf2dJavaFloatArray(env, vectorsJ);
-    auto dataset = jniUtil.Convert2dJavaObjectArrayToCppFloatVector(env, vectorsJ, dim);
-    vect->insert(vect->begin(), dataset.begin(), dataset.end());
+    jniUtil.Convert2dJavaObjectArrayAndStoreToFloatVector(env, vectorsJ, dim, vect);
 
     return (jlong) vect;
 }
@@ -481,3 +747,33 @@ JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_FaissService_rangeSea
     }
     return nullptr;
 }
+
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_rangeSearchIndexWithFilterBuffer(JNIEnv * env, jclass cls,
+                                                                                               jlong indexPointerJ,
+                                                                                               jfloatArray queryVectorJ,
+                                                                                               jfloat radiusJ, jlong searchParamsJ, jint maxResultWindowJ,
+                                                                                               jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ,
+                                                                                               jintArray resultIdsJ, jfloatArray resultDistancesJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::RangeSearch_WithFilterBuffer(&jniUtil, env, indexPointerJ, queryVectorJ, radiusJ, searchParamsJ, maxResultWindowJ, filterBufferJ, filterIdsTypeJ, parentIdsJ, resultIdsJ, resultDistancesJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return 0;
+}
+
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_FaissService_rangeSearchBinaryIndexWithFilterBuffer(JNIEnv * env, jclass cls,
+                                                                                                     jlong indexPointerJ,
+                                                                                                     jbyteArray queryVectorJ,
+                                                                                                     jfloat radiusJ, jlong searchParamsJ, jint maxResultWindowJ,
+                                                                                                     jobject filterBufferJ, jint filterIdsTypeJ, jintArray parentIdsJ,
+                                                                                                     jintArray resultIdsJ, jfloatArray resultDistancesJ)
+{
+    try {
+        return knn_jni::faiss_wrapper::RangeSearchBinaryIndex_WithFilterBuffer(&jniUtil, env, indexPointerJ, queryVectorJ, radiusJ, searchParamsJ, maxResultWindowJ, filterBufferJ, filterIdsTypeJ, parentIdsJ, resultIdsJ, resultDistancesJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return 0;
+}
@@ -73,6 +73,78 @@ jlong memoryAddressJ, jobjectArray dataJ, jlong initialCapacityJ, jboolean appen
     return (long)memoryAddressJ;
 }
 
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeFlatVectorData(JNIEnv * env, jclass cls,
+                                                                                   jlong memoryAddressJ, jfloatArray dataJ, jint lengthJ,
+                                                                                   jlong initialCapacityJ, jboolean appendJ)
+{
+    try {
+        return knn_jni::commons::storeFlatVectorData(&jniUtil, env, memoryAddressJ, dataJ, lengthJ, initialCapacityJ, appendJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return (long)memoryAddressJ;
+}
+
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeFlatBinaryVectorData(JNIEnv * env, jclass cls,
+                                                                                         jlong memoryAddressJ, jbyteArray dataJ, jint lengthJ,
+                                                                                         jlong initialCapacityJ, jboolean appendJ)
+{
+    try {
+        return knn_jni::commons::storeFlatBinaryVectorData(&jniUtil, env, memoryAddressJ, dataJ, lengthJ, initialCapacityJ, appendJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return (long)memoryAddressJ;
+}
+
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeFlatByteVectorData(JNIEnv * env, jclass cls,
+                                                                                       jlong memoryAddressJ, jbyteArray dataJ, jint lengthJ,
+                                                                                       jlong initialCapacityJ, jboolean appendJ)
+{
+    try {
+        return knn_jni::commons::storeFlatByteVectorData(&jniUtil, env, memoryAddressJ, dataJ, lengthJ, initialCapacityJ, appendJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return (long)memoryAddressJ;
+}
+
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeVectorDataFromBuffer(JNIEnv * env, jclass cls,
+                                                                                         jlong memoryAddressJ, jobject dataJ, jlong lengthJ,
+                                                                                         jlong initialCapacityJ, jboolean appendJ)
+{
+    try {
+        return knn_jni::commons::storeVectorDataFromBuffer(&jniUtil, env, memoryAddressJ, dataJ, lengthJ, initialCapacityJ, appendJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return (long)memoryAddressJ;
+}
+
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeBinaryVectorDataFromBuffer(JNIEnv * env, jclass cls,
+                                                                                               jlong memoryAddressJ, jobject dataJ, jlong lengthJ,
+                                                                                               jlong initialCapacityJ, jboolean appendJ)
+{
+    try {
+        return knn_jni::commons::storeBinaryVectorDataFromBuffer(&jniUtil, env, memoryAddressJ, dataJ, lengthJ, initialCapacityJ, appendJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return (long)memoryAddressJ;
+}
+
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_storeByteVectorDataFromBuffer(JNIEnv * env, jclass cls,
+                                                                                             jlong memoryAddressJ, jobject dataJ, jlong lengthJ,
+                                                                                             jlong initialCapacityJ, jboolean appendJ)
+{
+    try {
+        return knn_jni::commons::storeByteVectorDataFromBuffer(&jniUtil, env, memoryAddressJ, dataJ, lengthJ, initialCapacityJ, appendJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return (long)memoryAddressJ;
+}
+
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_JNICommons_freeVectorData(JNIEnv * env, jclass cls,
                                                                             jlong memoryAddressJ)
 {
@@ -103,3 +175,55 @@ JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_JNICommons_freeByteVectorData
         jniUtil.CatchCppExceptionAndThrowJava(env);
     }
 }
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_JNICommons_configureVectorBufferPool(JNIEnv * env, jclass cls,
+                                                                                        jlong maxPooledBytesJ,
+                                                                                        jboolean useHugePagesJ)
+{
+    try {
+        knn_jni::commons::configureVectorBufferPool(maxPooledBytesJ, useHugePagesJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
+
+JNIEXPORT jlongArray JNICALL Java_org_opensearch_knn_jni_JNICommons_getVectorBufferPoolStats(JNIEnv * env, jclass cls)
+{
+    try {
+        return knn_jni::commons::getVectorBufferPoolStats(&jniUtil, env);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return nullptr;
+}
+
+JNIEXPORT jboolean JNICALL Java_org_opensearch_knn_jni_JNICommons_trimNativeMemory(JNIEnv * env, jclass cls)
+{
+    try {
+        return knn_jni::commons::trimNativeMemory();
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return JNI_FALSE;
+}
+
+JNIEXPORT jlong JNICALL Java_org_opensearch_knn_jni_JNICommons_createSearchParams(JNIEnv * env, jclass cls,
+                                                                                 jint efSearchJ, jint nprobesJ)
+{
+    try {
+        return knn_jni::commons::createSearchParams(efSearchJ, nprobesJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+    return 0;
+}
+
+JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_JNICommons_freeSearchParams(JNIEnv * env, jclass cls,
+                                                                              jlong searchParamsAddressJ)
+{
+    try {
+        return knn_jni::commons::freeSearchParams(searchParamsAddressJ);
+    } catch (...) {
+        jniUtil.CatchCppExceptionAndThrowJava(env);
+    }
+}
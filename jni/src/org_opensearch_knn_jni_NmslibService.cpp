@@ -86,6 +86,23 @@ JNIEXPORT jobjectArray JNICALL Java_org_opensearch_knn_jni_NmslibService_queryIn
   return nullptr;
 }
 
+JNIEXPORT jint JNICALL Java_org_opensearch_knn_jni_NmslibService_queryIndexWithSearchParams(JNIEnv *env,
+                                                                                          jclass cls,
+                                                                                          jlong indexPointerJ,
+                                                                                          jfloatArray queryVectorJ,
+                                                                                          jint kJ,
+                                                                                          jlong searchParamsJ,
+                                                                                          jintArray resultIdsJ,
+                                                                                          jfloatArray resultDistancesJ) {
+  try {
+    return knn_jni::nmslib_wrapper::QueryIndex_WithSearchParams(&jniUtil, env, indexPointerJ, queryVectorJ, kJ,
+                                                                searchParamsJ, resultIdsJ, resultDistancesJ);
+  } catch (...) {
+    jniUtil.CatchCppExceptionAndThrowJava(env);
+  }
+  return 0;
+}
+
 JNIEXPORT void JNICALL Java_org_opensearch_knn_jni_NmslibService_free(JNIEnv *env, jclass cls, jlong indexPointerJ) {
   try {
     return knn_jni::nmslib_wrapper::Free(indexPointerJ);
@@ -0,0 +1,150 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "vector_buffer_pool.h"
+
+#include <cstdlib>
+#include <iterator>
+#include <new>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace {
+    constexpr size_t MIN_SLAB_SIZE = 64 * 1024;
+    constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+    constexpr size_t CACHE_LINE_SIZE = 64;
+
+    // Slabs are sized in powers of two below the huge page size and in whole huge pages above it, so that released
+    // slabs fit later requests of a similar size
+    size_t getSlabSize(size_t bytes) {
+        if (bytes >= HUGE_PAGE_SIZE) {
+            return (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        }
+        size_t slabSize = MIN_SLAB_SIZE;
+        while (slabSize < bytes) {
+            slabSize <<= 1;
+        }
+        return slabSize;
+    }
+
+    void *allocateSlab(size_t slabSize, bool useHugePages) {
+        size_t alignment = slabSize >= HUGE_PAGE_SIZE ? HUGE_PAGE_SIZE : CACHE_LINE_SIZE;
+#ifdef _WIN32
+        void *slab = _aligned_malloc(slabSize, alignment);
+        if (slab == nullptr) {
+            throw std::bad_alloc();
+        }
+#else
+        void *slab = nullptr;
+        if (posix_memalign(&slab, alignment, slabSize) != 0) {
+            throw std::bad_alloc();
+        }
+#endif
+#ifdef MADV_HUGEPAGE
+        // Best effort, the slab is still usable if transparent huge pages are disabled
+        if (useHugePages && slabSize >= HUGE_PAGE_SIZE) {
+            madvise(slab, slabSize, MADV_HUGEPAGE);
+        }
+#endif
+        return slab;
+    }
+
+    void freeSlab(void *slab) {
+#ifdef _WIN32
+        _aligned_free(slab);
+#else
+        free(slab);
+#endif
+    }
+}
+
+knn_jni::memory::BufferPool &knn_jni::memory::BufferPool::getInstance() {
+    static BufferPool instance;
+    return instance;
+}
+
+void *knn_jni::memory::BufferPool::acquire(size_t bytes, size_t *slabBytes) {
+    size_t slabSize = getSlabSize(bytes);
+    bool hugePages;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        // Reuse the smallest pooled slab that fits, unless it would waste more than half of it
+        auto it = freeSlabs.lower_bound(slabSize);
+        if (it != freeSlabs.end() && it->first <= 2 * slabSize) {
+            void *slab = it->second;
+            *slabBytes = it->first;
+            pooledBytes -= it->first;
+            usedBytes += it->first;
+            freeSlabs.erase(it);
+            hits++;
+            return slab;
+        }
+        misses++;
+        hugePages = useHugePages;
+    }
+
+    void *slab = allocateSlab(slabSize, hugePages);
+    *slabBytes = slabSize;
+    std::lock_guard<std::mutex> guard(lock);
+    usedBytes += slabSize;
+    return slab;
+}
+
+void knn_jni::memory::BufferPool::release(void *slab, size_t slabBytes) {
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        usedBytes -= slabBytes;
+        if (pooledBytes + slabBytes <= maxPooledBytes) {
+            freeSlabs.emplace(slabBytes, slab);
+            pooledBytes += slabBytes;
+            return;
+        }
+    }
+    freeSlab(slab);
+}
+
+void knn_jni::memory::BufferPool::configure(size_t maxPooledBytesCpp, bool useHugePagesCpp) {
+    std::lock_guard<std::mutex> guard(lock);
+    maxPooledBytes = maxPooledBytesCpp;
+    useHugePages = useHugePagesCpp;
+    trim();
+}
+
+knn_jni::memory::BufferPoolStats knn_jni::memory::BufferPool::getStats() {
+    std::lock_guard<std::mutex> guard(lock);
+    return BufferPoolStats {
+        (int64_t) pooledBytes,
+        (int64_t) freeSlabs.size(),
+        (int64_t) usedBytes,
+        (int64_t) maxPooledBytes,
+        hits,
+        misses
+    };
+}
+
+knn_jni::memory::BufferPool::~BufferPool() {
+    maxPooledBytes = 0;
+    trim();
+}
+
+// Frees the largest pooled slabs until the pool fits its limit. Must be called with the lock held
+void knn_jni::memory::BufferPool::trim() {
+    while (pooledBytes > maxPooledBytes && !freeSlabs.empty()) {
+        auto largest = std::prev(freeSlabs.end());
+        pooledBytes -= largest->first;
+        freeSlab(largest->second);
+        freeSlabs.erase(largest);
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * The OpenSearch Contributors require contributions made to
+ * this file be licensed under the Apache-2.0 license or a
+ * compatible open source license.
+ *
+ * Modifications Copyright OpenSearch Contributors. See
+ * GitHub history for details.
+ */
+
+#include "checksum_util.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    // Bit at a time reference implementation
+    uint32_t referenceCrc32(const uint8_t *data, size_t length) {
+        uint32_t crc = 0xFFFFFFFF;
+        for (size_t i = 0; i < length; ++i) {
+            crc ^= data[i];
+            for (int bit = 0; bit < 8; ++bit) {
+                crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+            }
+        }
+        return ~crc;
+    }
+}
+
+TEST(ChecksumUtilTest, Crc32CheckValue) {
+    const std::string check = "123456789";
+    ASSERT_EQ(0xCBF43926u, knn_jni::util::crc32(0, (const uint8_t *) check.data(), check.size()));
+    ASSERT_EQ(0u, knn_jni::util::crc32(0, nullptr, 0));
+}
+
+TEST(ChecksumUtilTest, Crc32MatchesReference) {
+    std::mt19937 random(7);
+    std::vector<uint8_t> data(100003);
+    for (auto &byte : data) {
+        byte = (uint8_t) random();
+    }
+
+    // Sizes and offsets around the 16 and 64 byte blocks of the folding implementation
+    for (size_t length : {1, 15, 16, 17, 63, 64, 65, 127, 128, 4099, 100000}) {
+        for (size_t offset : {0, 1, 3}) {
+            const uint8_t *start = data.data() + offset;
+            const uint32_t expected = referenceCrc32(start, length);
+            ASSERT_EQ(expected, knn_jni::util::crc32(0, start, length));
+
+            // Updating in pieces gives the same checksum
+            uint32_t crc = 0;
+            for (size_t position = 0; position < length; position += 1000) {
+                crc = knn_jni::util::crc32(crc, start + position, std::min((size_t) 1000, length - position));
+            }
+            ASSERT_EQ(expected, crc);
+        }
+    }
+}
@@ -11,6 +11,8 @@
 
 
 #include "test_util.h"
+#include <cstring>
+#include <memory>
 #include <vector>
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -35,9 +37,9 @@ TEST(CommonsTests, BasicAssertions) {
     jlong memoryAddress = knn_jni::commons::storeVectorData(&mockJNIUtil, jniEnv, (jlong)0,
                       reinterpret_cast<jobjectArray>(&data), (jlong)(totalNumberOfVector * dim), true);
     ASSERT_NE(memoryAddress, 0);
-    auto *vect = reinterpret_cast<std::vector<float>*>(memoryAddress);
+    auto *vect = reinterpret_cast<knn_jni::memory::VectorBuffer<float>*>(memoryAddress);
     ASSERT_EQ(vect->size(), data.size() * dim);
-    ASSERT_EQ(vect->capacity(), totalNumberOfVector * dim);
+    ASSERT_GE(vect->capacity(), totalNumberOfVector * dim);
 
     // Check by inserting more vectors at same memory location
     jlong oldMemoryAddress = memoryAddress;
@@ -51,23 +53,23 @@ TEST(CommonsTests, BasicAssertions) {
         reinterpret_cast<jobjectArray>(&data2), (jlong)(totalNumberOfVector * dim), true);
     ASSERT_NE(memoryAddress, 0);
     ASSERT_EQ(memoryAddress, oldMemoryAddress);
-    vect = reinterpret_cast<std::vector<float>*>(memoryAddress);
+    vect = reinterpret_cast<knn_jni::memory::VectorBuffer<float>*>(memoryAddress);
     int currentIndex = 0;
     std::cout << vect->size() + "\n";
     ASSERT_EQ(vect->size(), totalNumberOfVector * dim);
-    ASSERT_EQ(vect->capacity(), totalNumberOfVector * dim);
+    ASSERT_GE(vect->capacity(), totalNumberOfVector * dim);
 
     // Validate if all vectors data are at correct location
     for(auto & i : data) {
         for(float j : i) {
-            ASSERT_FLOAT_EQ(vect->at(currentIndex), j);
+            ASSERT_FLOAT_EQ((*vect)[currentIndex], j);
             currentIndex++;
         }
     }
 
     for(auto & i : data2) {
         for(float j : i) {
-            ASSERT_FLOAT_EQ(vect->at(currentIndex), j);
+            ASSERT_FLOAT_EQ((*vect)[currentIndex], j);
             currentIndex++;
         }
     }
@@ -83,15 +85,15 @@ TEST(CommonsTests, BasicAssertions) {
         reinterpret_cast<jobjectArray>(&data3), (jlong)(totalNumberOfVector * dim), false);
     ASSERT_NE(memoryAddress, 0);
     ASSERT_EQ(memoryAddress, oldMemoryAddress);
-    vect = reinterpret_cast<std::vector<float>*>(memoryAddress);
+    vect = reinterpret_cast<knn_jni::memory::VectorBuffer<float>*>(memoryAddress);
 
     ASSERT_EQ(vect->size(), dim); //Since we just added 1 vector
-    ASSERT_EQ(vect->capacity(), totalNumberOfVector * dim); //This is the initial capacity allocated
+    ASSERT_GE(vect->capacity(), totalNumberOfVector * dim); //The initial capacity is rounded up to the pool slab size
 
     currentIndex = 0;
     for(auto & i : data3) {
         for(float j : i) {
-            ASSERT_FLOAT_EQ(vect->at(currentIndex), j);
+            ASSERT_FLOAT_EQ((*vect)[currentIndex], j);
             currentIndex++;
         }
     }
@@ -118,9 +120,9 @@ TEST(StoreByteVectorTest, BasicAssertions) {
     jlong memoryAddress = knn_jni::commons::storeByteVectorData(&mockJNIUtil, jniEnv, (jlong)0,
                       reinterpret_cast<jobjectArray>(&data), (jlong)(totalNumberOfVector * dim), true);
     ASSERT_NE(memoryAddress, 0);
-    auto *vect = reinterpret_cast<std::vector<uint8_t>*>(memoryAddress);
+    auto *vect = reinterpret_cast<knn_jni::memory::VectorBuffer<uint8_t>*>(memoryAddress);
     ASSERT_EQ(vect->size(), data.size() * dim);
-    ASSERT_EQ(vect->capacity(), totalNumberOfVector * dim);
+    ASSERT_GE(vect->capacity(), totalNumberOfVector * dim);
 
     // Check by inserting more vectors at same memory location
     jlong oldMemoryAddress = memoryAddress;
@@ -134,22 +136,22 @@ TEST(StoreByteVectorTest, BasicAssertions) {
         reinterpret_cast<jobjectArray>(&data2), (jlong)(totalNumberOfVector * dim), true);
     ASSERT_NE(memoryAddress, 0);
     ASSERT_EQ(memoryAddress, oldMemoryAddress);
-    vect = reinterpret_cast<std::vector<uint8_t>*>(memoryAddress);
+    vect = reinterpret_cast<knn_jni::memory::VectorBuffer<uint8_t>*>(memoryAddress);
     int currentIndex = 0;
     ASSERT_EQ(vect->size(), totalNumberOfVector*dim);
-    ASSERT_EQ(vect->capacity(), totalNumberOfVector * dim);
+    ASSERT_GE(vect->capacity(), totalNumberOfVector * dim);
 
     // Validate if all vectors data are at correct location
     for(auto & i : data) {
         for(uint8_t j : i) {
-            ASSERT_EQ(vect->at(currentIndex), j);
+            ASSERT_EQ((*vect)[currentIndex], j);
             currentIndex++;
         }
     }
 
     for(auto & i : data2) {
         for(uint8_t j : i) {
-            ASSERT_EQ(vect->at(currentIndex), j);
+            ASSERT_EQ((*vect)[currentIndex], j);
             currentIndex++;
         }
     }
@@ -165,15 +167,15 @@ TEST(StoreByteVectorTest, BasicAssertions) {
         reinterpret_cast<jobjectArray>(&data3), (jlong)(totalNumberOfVector * dim), false);
     ASSERT_NE(memoryAddress, 0);
     ASSERT_EQ(memoryAddress, oldMemoryAddress);
-    vect = reinterpret_cast<std::vector<uint8_t>*>(memoryAddress);
+    vect = reinterpret_cast<knn_jni::memory::VectorBuffer<uint8_t>*>(memoryAddress);
 
     ASSERT_EQ(vect->size(), dim);
-    ASSERT_EQ(vect->capacity(), totalNumberOfVector * dim);
+    ASSERT_GE(vect->capacity(), totalNumberOfVector * dim);
 
     currentIndex = 0;
     for(auto & i : data3) {
         for(uint8_t j : i) {
-            ASSERT_EQ(vect->at(currentIndex), j);
+            ASSERT_EQ((*vect)[currentIndex], j);
             currentIndex++;
         }
     }
@@ -182,6 +184,63 @@ TEST(StoreByteVectorTest, BasicAssertions) {
     knn_jni::commons::freeBinaryVectorData(memoryAddress);
 }
 
+TEST(StoreFlatVectorTest, BasicAssertions) {
+    int dim = 4;
+    int numVectors = 3;
+    std::vector<float> data;
+    for (int i = 0; i < numVectors * dim; i++) {
+        data.push_back((float) i);
+    }
+    JNIEnv *jniEnv = nullptr;
+
+    testing::NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    // Only the first two vectors of the array are stored
+    jlong memoryAddress = knn_jni::commons::storeFlatVectorData(&mockJNIUtil, jniEnv, (jlong) 0,
+        reinterpret_cast<jfloatArray>(&data), 2 * dim, (jlong) (numVectors * dim), true);
+    ASSERT_NE(memoryAddress, 0);
+    auto *vect = reinterpret_cast<knn_jni::memory::VectorBuffer<float>*>(memoryAddress);
+    ASSERT_EQ(2 * dim, vect->size());
+    ASSERT_LE(numVectors * dim, vect->capacity());
+    for (int i = 0; i < 2 * dim; i++) {
+        ASSERT_FLOAT_EQ(data[i], (*vect)[i]);
+    }
+
+    // Append the vectors from a direct buffer, which the mock backs with a std::vector<jlong>
+    std::vector<jlong> buffer(data.size() * sizeof(float) / sizeof(jlong));
+    std::memcpy(buffer.data(), data.data(), data.size() * sizeof(float));
+    jlong oldMemoryAddress = memoryAddress;
+    memoryAddress = knn_jni::commons::storeVectorDataFromBuffer(&mockJNIUtil, jniEnv, memoryAddress,
+        reinterpret_cast<jobject>(&buffer), (jlong) data.size(), (jlong) (numVectors * dim), true);
+    ASSERT_EQ(oldMemoryAddress, memoryAddress);
+    ASSERT_EQ(2 * dim + data.size(), vect->size());
+    for (int i = 0; i < data.size(); i++) {
+        ASSERT_FLOAT_EQ(data[i], (*vect)[2 * dim + i]);
+    }
+
+    // Rewrite the store, and reject lengths past the end of the source
+    memoryAddress = knn_jni::commons::storeFlatVectorData(&mockJNIUtil, jniEnv, memoryAddress,
+        reinterpret_cast<jfloatArray>(&data), dim, (jlong) (numVectors * dim), false);
+    ASSERT_EQ(dim, vect->size());
+    EXPECT_THROW(knn_jni::commons::storeFlatVectorData(&mockJNIUtil, jniEnv, memoryAddress,
+        reinterpret_cast<jfloatArray>(&data), (jint) data.size() + 1, (jlong) (numVectors * dim), true), std::runtime_error);
+    EXPECT_THROW(knn_jni::commons::storeVectorDataFromBuffer(&mockJNIUtil, jniEnv, memoryAddress,
+        reinterpret_cast<jobject>(&buffer), (jlong) data.size() + 1, (jlong) (numVectors * dim), true), std::runtime_error);
+    ASSERT_EQ(dim, vect->size());
+
+    knn_jni::commons::freeVectorData(memoryAddress);
+
+    // Byte stores share the implementation, check that the element type is carried through
+    std::vector<uint8_t> byteData = {1, 2, 255, 128};
+    memoryAddress = knn_jni::commons::storeFlatByteVectorData(&mockJNIUtil, jniEnv, (jlong) 0,
+        reinterpret_cast<jbyteArray>(&byteData), (jint) byteData.size(), (jlong) byteData.size(), true);
+    auto *byteVect = reinterpret_cast<knn_jni::memory::VectorBuffer<int8_t>*>(memoryAddress);
+    ASSERT_EQ(byteData.size(), byteVect->size());
+    ASSERT_EQ(-1, (*byteVect)[2]);
+    ASSERT_EQ(-128, (*byteVect)[3]);
+    knn_jni::commons::freeByteVectorData(memoryAddress);
+}
+
 TEST(CommonTests, GetIntegerMethodParam) {
     JNIEnv *jniEnv = nullptr;
     testing::NiceMock<test_util::MockJNIUtil> mockJNIUtil;
@@ -200,3 +259,97 @@ TEST(CommonTests, GetIntegerMethodParam) {
     int actualValue3 = knn_jni::commons::getIntegerMethodParameter(jniEnv, &mockJNIUtil, methodParams2, knn_jni::EF_SEARCH, 1);
     EXPECT_EQ(1, actualValue3);
 }
+
+TEST(CommonTests, ParseSearchParams) {
+    JNIEnv *jniEnv = nullptr;
+    testing::NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    int efSearch = 10;
+    int nprobes = 5;
+    std::unordered_map<std::string, jobject> methodParams;
+    methodParams[knn_jni::EF_SEARCH] = reinterpret_cast<jobject>(&efSearch);
+    methodParams[knn_jni::NPROBES] = reinterpret_cast<jobject>(&nprobes);
+
+    knn_jni::commons::SearchParams searchParams =
+            knn_jni::commons::parseSearchParams(&mockJNIUtil, jniEnv, reinterpret_cast<jobject>(&methodParams));
+    EXPECT_EQ(efSearch, searchParams.efSearch.value());
+    EXPECT_EQ(nprobes, searchParams.nprobes.value());
+
+    EXPECT_CALL(mockJNIUtil, ConvertJavaMapToCppMap(testing::_, testing::_)).Times(0);
+    knn_jni::commons::SearchParams emptyParams = knn_jni::commons::parseSearchParams(&mockJNIUtil, jniEnv, nullptr);
+    EXPECT_FALSE(emptyParams.efSearch.has_value());
+    EXPECT_FALSE(emptyParams.nprobes.has_value());
+}
+
+TEST(CommonTests, SearchParamsHandle) {
+    jlong efSearchAddress = knn_jni::commons::createSearchParams(20, -1);
+    knn_jni::commons::SearchParams efSearch = knn_jni::commons::getSearchParams(efSearchAddress);
+    EXPECT_EQ(20, efSearch.efSearch.value());
+    EXPECT_FALSE(efSearch.nprobes.has_value());
+    knn_jni::commons::freeSearchParams(efSearchAddress);
+
+    // Negative values leave the parameter unset
+    jlong primitiveAddress = knn_jni::commons::createSearchParams(-1, 8);
+    knn_jni::commons::SearchParams primitive = knn_jni::commons::getSearchParams(primitiveAddress);
+    EXPECT_FALSE(primitive.efSearch.has_value());
+    EXPECT_EQ(8, primitive.nprobes.value());
+    knn_jni::commons::freeSearchParams(primitiveAddress);
+
+    knn_jni::commons::SearchParams defaults = knn_jni::commons::getSearchParams(0);
+    EXPECT_FALSE(defaults.efSearch.has_value());
+    EXPECT_FALSE(defaults.nprobes.has_value());
+}
+
+TEST(CommonTests, VectorBufferPool) {
+    knn_jni::memory::BufferPool &pool = knn_jni::memory::BufferPool::getInstance();
+    pool.configure(1024 * 1024, false);
+
+    std::vector<float> values(100, 1.5f);
+    knn_jni::memory::VectorBuffer<float> first;
+    first.append(values.data(), values.size());
+    ASSERT_EQ(values.size(), first.size());
+    first.release();
+    ASSERT_TRUE(first.empty());
+    ASSERT_EQ(0, first.capacity());
+
+    // A released slab is handed out again to the next buffer of a similar size
+    knn_jni::memory::BufferPoolStats before = pool.getStats();
+    knn_jni::memory::VectorBuffer<float> second;
+    second.append(values.data(), values.size());
+    knn_jni::memory::BufferPoolStats after = pool.getStats();
+    ASSERT_EQ(before.hits + 1, after.hits);
+    ASSERT_EQ(before.misses, after.misses);
+    ASSERT_FLOAT_EQ(1.5f, second[99]);
+
+    // Growing keeps the contents
+    std::vector<float> more(100000, 2.5f);
+    second.append(more.data(), more.size());
+    ASSERT_EQ(100100, second.size());
+    ASSERT_FLOAT_EQ(1.5f, second[0]);
+    ASSERT_FLOAT_EQ(2.5f, second[100099]);
+    second.release();
+
+    // Lowering the limit frees the pooled slabs
+    pool.configure(0, false);
+    knn_jni::memory::BufferPoolStats trimmed = pool.getStats();
+    ASSERT_EQ(0, trimmed.pooledBytes);
+    ASSERT_EQ(0, trimmed.pooledSlabs);
+    ASSERT_EQ(0, trimmed.maxPooledBytes);
+
+    pool.configure(256 * 1024 * 1024, false);
+}
+
+TEST(CommonTests, TrimNativeMemory) {
+    // Small blocks are served from the heap rather than mapped, so glibc keeps them once they are freed
+    std::vector<std::unique_ptr<char[]>> blocks;
+    for (int i = 0; i < 64 * 1024; ++i) {
+        blocks.emplace_back(new char[1024]);
+        blocks.back()[0] = (char) i;
+    }
+    blocks.clear();
+#if defined(__GLIBC__)
+    ASSERT_EQ(JNI_TRUE, knn_jni::commons::trimNativeMemory());
+#else
+    ASSERT_EQ(JNI_FALSE, knn_jni::commons::trimNativeMemory());
+#endif
+}
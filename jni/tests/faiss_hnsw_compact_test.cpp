@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// The OpenSearch Contributors require contributions made to
+// this file be licensed under the Apache-2.0 license or a
+// compatible open source license.
+//
+// Modifications Copyright OpenSearch Contributors. See
+// GitHub history for details.
+
+#include "faiss_hnsw_compact.h"
+#include "faiss/IDSelector.h"
+#include "faiss/impl/AuxIndexStructures.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util.h"
+
+using knn_jni::graph::CompactNeighborLists;
+using knn_jni::graph::IndexBinaryHNSWCompact;
+using knn_jni::graph::IndexHNSWCompact;
+
+namespace {
+    // Loads index back the way plugin loads do, so that the id map owns the index it wraps
+    std::unique_ptr<faiss::IndexIDMap> reloadIndex(faiss::Index *index) {
+        auto serialized = test_util::FaissGetSerializedIndex(index);
+        return std::unique_ptr<faiss::IndexIDMap>(
+                dynamic_cast<faiss::IndexIDMap *>(test_util::FaissLoadFromSerializedIndex(&serialized.data)));
+    }
+}
+
+TEST(CompactNeighborListsTest, BasicAssertions) {
+    faiss::idx_t numIds = 2000;
+    int dim = 8;
+    std::vector<faiss::idx_t> ids;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+    }
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, -500.0, 500.0);
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW16,Flat", faiss::METRIC_L2));
+    auto idMap = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    const faiss::HNSW &hnsw = dynamic_cast<faiss::IndexHNSW *>(createdIndex.get())->hnsw;
+
+    CompactNeighborLists lists(hnsw);
+    ASSERT_EQ(hnsw.nb_neighbors(0), lists.maxNeighbors());
+    ASSERT_EQ(numIds, lists.listOffsets().size());
+    ASSERT_LT(lists.bytes(), (int64_t) (hnsw.neighbors.size() * sizeof(faiss::HNSW::storage_idx_t)));
+
+    // Every list decodes to the neighbors of the graph, in ascending order and without the padding
+    std::vector<faiss::HNSW::storage_idx_t> decoded(lists.maxNeighbors());
+    for (faiss::idx_t node = 0; node < numIds; ++node) {
+        for (int level = 0; level < hnsw.levels[node]; ++level) {
+            size_t begin, end;
+            hnsw.neighbor_range(node, level, &begin, &end);
+            std::vector<faiss::HNSW::storage_idx_t> expected;
+            for (size_t j = begin; j < end && hnsw.neighbors[j] >= 0; ++j) {
+                expected.push_back(hnsw.neighbors[j]);
+            }
+            std::sort(expected.begin(), expected.end());
+
+            size_t count = lists.decode(node, level, decoded.data());
+            ASSERT_EQ(expected, std::vector<faiss::HNSW::storage_idx_t>(decoded.begin(), decoded.begin() + count));
+        }
+    }
+}
+
+TEST(CompactIndexIDMapHNSWTest, BasicAssertions) {
+    faiss::idx_t numIds = 1000;
+    int dim = 16;
+    int k = 10;
+    int numQueries = 20;
+    std::vector<faiss::idx_t> ids;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i * 3);
+    }
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, -500.0, 500.0);
+    std::vector<float> queries = test_util::RandomVectors(dim, numQueries, -500.0, 500.0);
+
+    for (auto metricType : {faiss::METRIC_L2, faiss::METRIC_INNER_PRODUCT}) {
+        std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW16,Flat", metricType));
+        auto createdIdMap = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+        std::unique_ptr<faiss::IndexIDMap> idMap = reloadIndex(&createdIdMap);
+
+        std::vector<float> distances(numQueries * k), compactDistances(numQueries * k);
+        std::vector<faiss::idx_t> labels(numQueries * k), compactLabels(numQueries * k);
+        idMap->search(numQueries, queries.data(), k, distances.data(), labels.data());
+
+        ASSERT_TRUE(knn_jni::graph::compactIndexIDMapHNSW(idMap.get()));
+        auto *compactIndex = dynamic_cast<IndexHNSWCompact *>(idMap->index);
+        ASSERT_NE(nullptr, compactIndex);
+        ASSERT_TRUE(compactIndex->hnsw.neighbors.empty());
+        ASSERT_EQ(numIds, compactIndex->ntotal);
+
+        // Faiss decodes the compact lists in place of its own, which only differ in the order of the neighbors within a
+        // list, so results only differ on rare ties
+        idMap->search(numQueries, queries.data(), k, compactDistances.data(), compactLabels.data());
+        int matches = 0;
+        for (int q = 0; q < numQueries; ++q) {
+            for (int i = 0; i < k; ++i) {
+                matches += std::count(labels.begin() + q * k, labels.begin() + (q + 1) * k, compactLabels[q * k + i]);
+            }
+        }
+        ASSERT_GE(matches, numQueries * k * 95 / 100);
+        for (int i = 0; i < numQueries * k; ++i) {
+            if (compactLabels[i] == labels[i]) {
+                ASSERT_FLOAT_EQ(distances[i], compactDistances[i]);
+            }
+        }
+
+        // Filters are applied to the labels of the id map
+        faiss::IDSelectorRange lowerHalf(0, numIds * 3 / 2);
+        faiss::SearchParametersHNSW params;
+        params.efSearch = 64;
+        params.sel = &lowerHalf;
+        idMap->search(numQueries, queries.data(), k, compactDistances.data(), compactLabels.data(), &params);
+        for (faiss::idx_t label : compactLabels) {
+            ASSERT_GE(label, 0);
+            ASSERT_LT(label, numIds * 3 / 2);
+        }
+
+        // Range search with the distance of the k-th result finds about as many
+        idMap->search(1, queries.data(), k, compactDistances.data(), compactLabels.data());
+        float radius = metricType == faiss::METRIC_L2 ? compactDistances[k - 1] * 1.0001f : compactDistances[k - 1] - 0.0001f;
+        faiss::RangeSearchResult rangeResult(1);
+        idMap->range_search(1, queries.data(), radius, &rangeResult);
+        ASSERT_GE(rangeResult.lims[1], k * 9 / 10);
+
+        // Compact graphs are read only
+        ASSERT_THROW(compactIndex->add(1, vectors.data()), std::runtime_error);
+    }
+
+    // Indexes with other layouts, and ones not owned by their id map, are left alone
+    std::unique_ptr<faiss::Index> ivfIndex(test_util::FaissCreateIndex(dim, "IVF4,Flat", faiss::METRIC_L2));
+    ivfIndex->train(numIds, vectors.data());
+    auto ivfIdMap = test_util::FaissAddData(ivfIndex.get(), ids, vectors);
+    ASSERT_FALSE(knn_jni::graph::compactIndexIDMapHNSW(&ivfIdMap));
+    std::unique_ptr<faiss::Index> hnswIndex(test_util::FaissCreateIndex(dim, "HNSW16,Flat", faiss::METRIC_L2));
+    auto hnswIdMap = test_util::FaissAddData(hnswIndex.get(), ids, vectors);
+    ASSERT_FALSE(knn_jni::graph::compactIndexIDMapHNSW(&hnswIdMap));
+}
+
+TEST(CompactIndexBinaryIDMapHNSWTest, BasicAssertions) {
+    faiss::idx_t numIds = 500;
+    int dim = 128;
+    std::vector<faiss::idx_t> ids;
+    std::vector<uint8_t> vectors;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim / 8; ++j) {
+            vectors.push_back(test_util::RandomInt(0, 255));
+        }
+    }
+
+    std::unique_ptr<faiss::IndexBinary> createdIndex(test_util::FaissCreateBinaryIndex(dim, "BHNSW16"));
+    auto createdIdMap = test_util::FaissAddBinaryData(createdIndex.get(), ids, vectors);
+    auto serialized = test_util::FaissGetSerializedBinaryIndex(&createdIdMap);
+    std::unique_ptr<faiss::IndexBinaryIDMap> idMap(dynamic_cast<faiss::IndexBinaryIDMap *>(
+            test_util::FaissLoadFromSerializedBinaryIndex(&serialized.data)));
+
+    ASSERT_TRUE(knn_jni::graph::compactIndexBinaryIDMapHNSW(idMap.get()));
+    auto *compactIndex = dynamic_cast<IndexBinaryHNSWCompact *>(idMap->index);
+    ASSERT_NE(nullptr, compactIndex);
+    ASSERT_TRUE(compactIndex->hnsw.neighbors.empty());
+
+    // Vectors are still found by searching for themselves
+    std::vector<int32_t> distances(numIds);
+    std::vector<faiss::idx_t> labels(numIds);
+    idMap->search(numIds, vectors.data(), 1, distances.data(), labels.data());
+    ASSERT_GE(std::count(distances.begin(), distances.end(), 0), numIds * 9 / 10);
+
+    ASSERT_THROW(compactIndex->add(1, vectors.data()), std::runtime_error);
+}
@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// The OpenSearch Contributors require contributions made to
+// this file be licensed under the Apache-2.0 license or a
+// compatible open source license.
+//
+// Modifications Copyright OpenSearch Contributors. See
+// GitHub history for details.
+
+#include "faiss_index_arena.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using knn_jni::memory::IndexArena;
+using knn_jni::memory::IndexArenaScope;
+using knn_jni::memory::IndexArenaStats;
+
+#if defined(__linux__) && defined(KNN_INDEX_ARENAS)
+TEST(IndexArenaTest, AllocationsInScopeComeFromArena) {
+  IndexArena *arena = IndexArena::create();
+  ASSERT_NE(nullptr, arena);
+
+  auto *outside = new std::vector<float>(16);
+  std::vector<float> *small;
+  std::vector<float> *large;
+  {
+    IndexArenaScope scope(arena);
+    ASSERT_EQ(arena, IndexArenaScope::current());
+    small = new std::vector<float>(16);
+    large = new std::vector<float>(1024 * 1024);
+    {
+      IndexArenaScope heapScope(nullptr);
+      ASSERT_EQ(nullptr, IndexArenaScope::current());
+    }
+    ASSERT_EQ(arena, IndexArenaScope::current());
+  }
+  ASSERT_EQ(nullptr, IndexArenaScope::current());
+
+  ASSERT_FALSE(IndexArena::owns(outside));
+  ASSERT_FALSE(IndexArena::owns(outside->data()));
+  ASSERT_TRUE(IndexArena::owns(small));
+  ASSERT_TRUE(IndexArena::owns(small->data()));
+  ASSERT_TRUE(IndexArena::owns(large->data()));
+  ASSERT_EQ(0, reinterpret_cast<uintptr_t>(large->data()) % alignof(std::max_align_t));
+
+  // Arena memory is usable as any other
+  (*large)[large->size() - 1] = 1.0f;
+  (*small)[0] = 2.0f;
+  ASSERT_EQ(1.0f, large->back());
+
+  IndexArenaStats stats = arena->getStats();
+  ASSERT_EQ(4, stats.liveAllocations);
+  ASSERT_EQ(1, stats.chunks);
+  ASSERT_EQ(1, stats.largeAllocations);
+  ASSERT_GE(stats.liveBytes, (int64_t) (1024 * 1024 * sizeof(float)));
+  ASSERT_GE(stats.mappedBytes, stats.liveBytes);
+
+  // Memory is freed from outside of the scope, as when an index is freed
+  delete large;
+  stats = arena->getStats();
+  ASSERT_EQ(2, stats.liveAllocations);
+  ASSERT_EQ(0, stats.largeAllocations);
+  ASSERT_LT(stats.liveBytes, 1024);
+
+  delete small;
+  delete outside;
+  stats = arena->getStats();
+  ASSERT_EQ(0, stats.liveAllocations);
+  ASSERT_EQ(0, stats.liveBytes);
+  arena->close();
+}
+
+TEST(IndexArenaTest, ArenaOutlivesCloseUntilLastAllocationIsFreed) {
+  IndexArena *arena = IndexArena::create();
+  ASSERT_NE(nullptr, arena);
+  std::unique_ptr<std::vector<uint8_t>> bytes;
+  {
+    IndexArenaScope scope(arena);
+    bytes.reset(new std::vector<uint8_t>(4 * 1024 * 1024, 1));
+  }
+  arena->close();
+
+  // The allocations are still valid once the arena is closed
+  ASSERT_TRUE(IndexArena::owns(bytes->data()));
+  ASSERT_EQ(1, bytes->back());
+  bytes.reset();
+}
+
+TEST(IndexArenaTest, AlignedAllocations) {
+  IndexArena *arena = IndexArena::create();
+  ASSERT_NE(nullptr, arena);
+  struct alignas(64) Line {
+    uint8_t bytes[64];
+  };
+  std::vector<Line *> lines;
+  lines.reserve(100);
+  {
+    IndexArenaScope scope(arena);
+    for (int i = 0; i < 100; i++) {
+      lines.push_back(new Line());
+    }
+  }
+  for (Line *line : lines) {
+    ASSERT_TRUE(IndexArena::owns(line));
+    ASSERT_EQ(0, reinterpret_cast<uintptr_t>(line) % 64);
+    delete line;
+  }
+  ASSERT_EQ(0, arena->getStats().liveAllocations);
+  arena->close();
+}
+
+TEST(IndexArenaTest, ScopeIsPerThread) {
+  IndexArena *arena = IndexArena::create();
+  ASSERT_NE(nullptr, arena);
+  IndexArenaScope scope(arena);
+
+  std::vector<int> *other = nullptr;
+  std::thread thread([&other]() { other = new std::vector<int>(8); });
+  thread.join();
+  ASSERT_FALSE(IndexArena::owns(other));
+  delete other;
+
+  auto *own = new std::vector<int>(8);
+  ASSERT_TRUE(IndexArena::owns(own));
+  delete own;
+  arena->close();
+}
+
+TEST(IndexArenaTest, ClosedArenasGiveTheirAddressSpaceBack) {
+  // Far more than the reserved address space is allocated over the arenas
+  for (int i = 0; i < 64; i++) {
+    IndexArena *arena = IndexArena::create();
+    ASSERT_NE(nullptr, arena);
+    std::vector<uint8_t> *bytes;
+    {
+      IndexArenaScope scope(arena);
+      bytes = new std::vector<uint8_t>();
+      bytes->reserve((size_t) 1 << 30);
+    }
+    ASSERT_TRUE(IndexArena::owns(bytes->data()));
+    delete bytes;
+    arena->close();
+  }
+}
+
+TEST(IndexArenaTest, StandardLibraryMembersAreFreedOutsideOfTheScope) {
+  IndexArena *arena = IndexArena::create();
+  ASSERT_NE(nullptr, arena);
+  std::unique_ptr<std::string> name;
+  std::unique_ptr<std::vector<std::string>> names;
+  {
+    IndexArenaScope scope(arena);
+    // The out of line members of std::string, which allocate and free its buffer, are compiled into libstdc++.so
+    name.reset(new std::string(1024, 'a'));
+    name->append(4096, 'b');
+    names.reset(new std::vector<std::string>(16, *name));
+  }
+  ASSERT_TRUE(IndexArena::owns(name.get()));
+  ASSERT_TRUE(IndexArena::owns(names->data()));
+
+  // Reallocating and freeing them from outside of the scope goes through libstdc++ as well
+  name->append(1024 * 1024, 'c');
+  name->shrink_to_fit();
+  ASSERT_FALSE(IndexArena::owns(name->data()));
+  names->resize(64);
+  names->clear();
+  names->shrink_to_fit();
+  name.reset();
+  names.reset();
+  ASSERT_EQ(0, arena->getStats().liveAllocations);
+  arena->close();
+}
+#else
+TEST(IndexArenaTest, NotSupportedWithoutReplacedAllocations) {
+  ASSERT_EQ(nullptr, IndexArena::create());
+}
+#endif
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+//
+// The OpenSearch Contributors require contributions made to
+// this file be licensed under the Apache-2.0 license or a
+// compatible open source license.
+//
+// Modifications Copyright OpenSearch Contributors. See
+// GitHub history for details.
+
+#include "faiss_index_compression.h"
+#include "faiss/index_io.h"
+#include "test_util.h"
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using knn_jni::stream::FaissDecompressingIOReader;
+using knn_jni::stream::IndexFrameCompressor;
+
+namespace {
+std::vector<uint8_t> compress(const std::vector<uint8_t> &raw) {
+  std::vector<uint8_t> compressed;
+  IndexFrameCompressor compressor(
+      [&compressed](const uint8_t *bytes, size_t nbytes) { compressed.insert(compressed.end(), bytes, bytes + nbytes); },
+      1);
+  // Written in uneven pieces, as faiss does
+  for (size_t offset = 0; offset < raw.size(); offset += 1000) {
+    compressor.write(raw.data() + offset, std::min((size_t) 1000, raw.size() - offset));
+  }
+  compressor.finish();
+  return compressed;
+}
+}
+
+TEST(FaissIndexCompressionTest, RoundTrip) {
+  faiss::idx_t numIds = 20000;
+  int dim = 16;
+  std::vector<faiss::idx_t> ids;
+  std::vector<float> vectors;
+  for (int64_t i = 0; i < numIds; ++i) {
+    ids.push_back(i);
+    for (int j = 0; j < dim; ++j) {
+      vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+    }
+  }
+  std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW32,Flat", faiss::METRIC_L2));
+  auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+  auto vectorIoWriter = test_util::FaissGetSerializedIndex(&createdIndexWithData);
+
+  std::vector<uint8_t> compressed = compress(vectorIoWriter.data);
+  ASSERT_TRUE(knn_jni::stream::isCompressedIndex(compressed.data(), compressed.size()));
+  ASSERT_LT(compressed.size(), vectorIoWriter.data.size());
+
+  // Bytes after the end frame, like the Lucene footer, are ignored
+  std::vector<uint8_t> withFooter(compressed);
+  withFooter.insert(withFooter.end(), 16, 0xFF);
+  ASSERT_EQ(vectorIoWriter.data, knn_jni::stream::decompressIndex(withFooter.data(), withFooter.size()));
+
+  faiss::VectorIOReader source;
+  source.data = compressed;
+  FaissDecompressingIOReader reader(&source);
+  std::unique_ptr<faiss::Index> loadedIndex(faiss::read_index(&reader));
+  ASSERT_EQ(vectorIoWriter.data, test_util::FaissGetSerializedIndex(loadedIndex.get()).data);
+
+  // Uncompressed indexes pass through
+  faiss::VectorIOReader plainSource;
+  plainSource.data = vectorIoWriter.data;
+  FaissDecompressingIOReader plainReader(&plainSource);
+  std::unique_ptr<faiss::Index> plainIndex(faiss::read_index(&plainReader));
+  ASSERT_EQ(vectorIoWriter.data, test_util::FaissGetSerializedIndex(plainIndex.get()).data);
+}
+
+TEST(FaissIndexCompressionTest, CorruptedFrame) {
+  std::vector<uint8_t> raw(3 * 1024 * 1024, 7);
+  std::vector<uint8_t> compressed = compress(raw);
+  // Flip a byte of the first zlib stream, past the file and frame headers
+  compressed[20] ^= 0xFF;
+  ASSERT_THROW(knn_jni::stream::decompressIndex(compressed.data(), compressed.size()), std::runtime_error);
+
+  // Truncated input
+  std::vector<uint8_t> truncated = compress(raw);
+  truncated.resize(truncated.size() - 12);
+  ASSERT_THROW(knn_jni::stream::decompressIndex(truncated.data(), truncated.size()), std::runtime_error);
+}
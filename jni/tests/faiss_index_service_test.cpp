@@ -14,6 +14,8 @@
 #include "mocks/faiss_methods_mock.h"
 #include "mocks/faiss_index_mock.h"
 #include "test_util.h"
+#include "faiss/IndexHNSW.h"
+#include "faiss/IndexScalarQuantizer.h"
 #include <vector>
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
@@ -27,7 +29,7 @@ TEST(CreateIndexTest, BasicAssertions) {
     // Define the data
     faiss::idx_t numIds = 200;
     std::vector<int64_t> ids;
-    std::vector<float> vectors;
+    knn_jni::memory::VectorBuffer<float> vectors;
     int dim = 2;
     vectors.reserve(dim * numIds);
     for (int64_t i = 0; i < numIds; ++i) {
@@ -74,7 +76,7 @@ TEST(CreateBinaryIndexTest, BasicAssertions) {
     // Define the data
     faiss::idx_t numIds = 200;
     std::vector<faiss::idx_t> ids;
-    std::vector<uint8_t> vectors;
+    knn_jni::memory::VectorBuffer<uint8_t> vectors;
     int dim = 128;
     vectors.reserve(numIds);
     for (int64_t i = 0; i < numIds; ++i) {
@@ -121,7 +123,7 @@ TEST(CreateByteIndexTest, BasicAssertions) {
     // Define the data
     faiss::idx_t numIds = 200;
     std::vector<faiss::idx_t> ids;
-    std::vector<int8_t> vectors;
+    knn_jni::memory::VectorBuffer<int8_t> vectors;
     int dim = 8;
     vectors.reserve(numIds * dim);
     for (int64_t i = 0; i < numIds; ++i) {
@@ -160,4 +162,156 @@ TEST(CreateByteIndexTest, BasicAssertions) {
     long indexAddress = indexService.initIndex(&mockJNIUtil, jniEnv, metricType, indexDescription, dim, numIds, threadCount, parametersMap);
     indexService.insertToIndex(dim, numIds, threadCount, (int64_t) &vectors, ids, indexAddress);
     indexService.writeIndex(&fileIOWriter, indexAddress);
-}
\ No newline at end of file
+}
+
+TEST(CreateByteIndexTest, WhenHNSWDirectSigned_thenCodesAreWrittenDirectly) {
+    // Define the data
+    faiss::idx_t numIds = 2500;
+    std::vector<faiss::idx_t> ids;
+    knn_jni::memory::VectorBuffer<int8_t> vectors;
+    std::vector<float> floatVectors;
+    int dim = 8;
+    vectors.reserve(numIds * dim);
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i * 2);
+        for (int j = 0; j < dim; ++j) {
+            vectors.push_back(test_util::RandomInt(-128, 127));
+            floatVectors.push_back(vectors.data()[vectors.size() - 1]);
+        }
+    }
+    faiss::MetricType metricType = faiss::METRIC_L2;
+    std::string indexDescription = "HNSW16,SQ8_direct_signed";
+    int threadCount = 1;
+    std::unordered_map<std::string, jobject> parametersMap;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    knn_jni::faiss_wrapper::ByteIndexService indexService(std::make_unique<knn_jni::faiss_wrapper::FaissMethods>());
+    long indexAddress = indexService.initIndex(&mockJNIUtil, nullptr, metricType, indexDescription, dim, numIds, threadCount, parametersMap);
+    indexService.insertToIndex(dim, numIds, threadCount, (int64_t) &vectors, ids, indexAddress);
+    std::unique_ptr<faiss::IndexIDMap> idMap(reinterpret_cast<faiss::IndexIDMap *>(indexAddress));
+
+    // The index matches the one built by quantizing the widened vectors, added in the same batches of 1000
+    std::unique_ptr<faiss::Index> expectedIndex(test_util::FaissCreateIndex(dim, indexDescription, metricType));
+    for (faiss::idx_t id = 0; id < numIds; id += 1000) {
+        expectedIndex->add(std::min<faiss::idx_t>(1000, numIds - id), floatVectors.data() + id * dim);
+    }
+    auto * expectedHnsw = dynamic_cast<faiss::IndexHNSW *>(expectedIndex.get());
+    auto * hnsw = dynamic_cast<faiss::IndexHNSW *>(idMap->index);
+    ASSERT_NE(nullptr, hnsw);
+    auto * storage = dynamic_cast<faiss::IndexScalarQuantizer *>(hnsw->storage);
+    ASSERT_NE(nullptr, storage);
+
+    ASSERT_EQ(numIds, idMap->ntotal);
+    ASSERT_EQ(numIds, hnsw->ntotal);
+    ASSERT_EQ(numIds, storage->ntotal);
+    ASSERT_EQ(ids, idMap->id_map);
+    ASSERT_EQ(dynamic_cast<faiss::IndexScalarQuantizer *>(expectedHnsw->storage)->codes, storage->codes);
+    ASSERT_EQ(expectedHnsw->hnsw.levels, hnsw->hnsw.levels);
+    ASSERT_EQ(expectedHnsw->hnsw.neighbors, hnsw->hnsw.neighbors);
+    ASSERT_EQ(expectedHnsw->hnsw.entry_point, hnsw->hnsw.entry_point);
+}
+
+TEST(IngestionSessionTest, BasicAssertions) {
+    // Define the data, inserted in two batches
+    int numIdsPerBatch = 100;
+    int dim = 2;
+    std::vector<int64_t> firstIds;
+    std::vector<int64_t> secondIds;
+    knn_jni::memory::VectorBuffer<float> firstVectors;
+    knn_jni::memory::VectorBuffer<float> secondVectors;
+    for (int64_t i = 0; i < numIdsPerBatch; ++i) {
+        firstIds.push_back(i);
+        secondIds.push_back(numIdsPerBatch + i);
+        for (int j = 0; j < dim; ++j) {
+            firstVectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+            secondVectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    faiss::MetricType metricType = faiss::METRIC_L2;
+    std::string indexDescription = "HNSW32,Flat";
+    int threadCount = 1;
+    std::unordered_map<std::string, jobject> parametersMap;
+
+    // Set up jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    // Setup faiss method mock
+    // This object is owned by indexIdMap
+    MockIndex* index = new MockIndex();
+    {
+        ::testing::InSequence sequence;
+        EXPECT_CALL(*index, add(numIdsPerBatch, firstVectors.data()))
+            .Times(1);
+        EXPECT_CALL(*index, add(numIdsPerBatch, secondVectors.data()))
+            .Times(1);
+    }
+    faiss::IndexIDMap* indexIdMap = new faiss::IndexIDMap(index);
+    std::unique_ptr<MockFaissMethods> mockFaissMethods(new MockFaissMethods());
+    EXPECT_CALL(*mockFaissMethods, indexFactory(dim, ::testing::StrEq(indexDescription.c_str()), metricType))
+        .WillOnce(Return(index));
+    EXPECT_CALL(*mockFaissMethods, indexIdMap(index))
+        .WillOnce(Return(indexIdMap));
+
+    // Insert the batches through the session
+    std::unique_ptr<knn_jni::faiss_wrapper::IndexService> indexService(
+        new knn_jni::faiss_wrapper::IndexService(std::move(mockFaissMethods)));
+    jlong indexAddress = indexService->initIndex(&mockJNIUtil, jniEnv, metricType, indexDescription, dim,
+                                                 2 * numIdsPerBatch, threadCount, parametersMap);
+    std::unique_ptr<faiss::IndexIDMap> createdIndex(reinterpret_cast<faiss::IndexIDMap *>(indexAddress));
+    knn_jni::faiss_wrapper::IngestionSession session(std::move(indexService), indexAddress, dim, threadCount, 1);
+    session.submit((int64_t) &firstVectors, firstIds);
+    session.submit((int64_t) &secondVectors, secondIds);
+    session.finish();
+
+    ASSERT_EQ(2 * numIdsPerBatch, createdIndex->id_map.size());
+    for (int i = 0; i < 2 * numIdsPerBatch; ++i) {
+        ASSERT_EQ(i, createdIndex->id_map[i]);
+    }
+}
+
+TEST(IngestionSessionTest, FailedInsertion) {
+    int numIds = 100;
+    int dim = 2;
+    std::vector<int64_t> ids;
+    knn_jni::memory::VectorBuffer<float> vectors;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim; ++j) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    faiss::MetricType metricType = faiss::METRIC_L2;
+    std::string indexDescription = "HNSW32,Flat";
+    int threadCount = 1;
+    std::unordered_map<std::string, jobject> parametersMap;
+
+    // Set up jni
+    JNIEnv *jniEnv = nullptr;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    // Setup faiss method mock
+    // This object is owned by indexIdMap
+    MockIndex* index = new MockIndex();
+    EXPECT_CALL(*index, add(numIds, vectors.data()))
+        .WillOnce(::testing::Throw(std::runtime_error("Failed to add vectors")));
+    faiss::IndexIDMap* indexIdMap = new faiss::IndexIDMap(index);
+    std::unique_ptr<MockFaissMethods> mockFaissMethods(new MockFaissMethods());
+    EXPECT_CALL(*mockFaissMethods, indexFactory(dim, ::testing::StrEq(indexDescription.c_str()), metricType))
+        .WillOnce(Return(index));
+    EXPECT_CALL(*mockFaissMethods, indexIdMap(index))
+        .WillOnce(Return(indexIdMap));
+
+    std::unique_ptr<knn_jni::faiss_wrapper::IndexService> indexService(
+        new knn_jni::faiss_wrapper::IndexService(std::move(mockFaissMethods)));
+    jlong indexAddress = indexService->initIndex(&mockJNIUtil, jniEnv, metricType, indexDescription, dim, numIds,
+                                                 threadCount, parametersMap);
+    std::unique_ptr<faiss::IndexIDMap> createdIndex(reinterpret_cast<faiss::IndexIDMap *>(indexAddress));
+    knn_jni::faiss_wrapper::IngestionSession session(std::move(indexService), indexAddress, dim, threadCount, 1);
+    session.submit((int64_t) &vectors, ids);
+
+    // The failure of the inserter thread is surfaced to the caller
+    ASSERT_THROW(session.finish(), std::runtime_error);
+}
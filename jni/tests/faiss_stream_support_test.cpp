@@ -14,11 +14,16 @@
 #include <gmock/gmock.h>
 #include <jni.h>
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
 #include <vector>
 
 using ::testing::_;
 using ::testing::Return;
 using knn_jni::stream::FaissOpenSearchIOReader;
+using knn_jni::stream::FaissOpenSearchIOWriter;
 using knn_jni::stream::NativeEngineIndexInputMediator;
 using test_util::MockJNIUtil;
 using test_util::JavaIndexInputMock;
@@ -102,3 +107,174 @@ TEST(FaissStreamSupportTest, FaissOpenSearchIOReaderCopy) {
     ASSERT_EQ(javaIndexInputMock.readTargetBytes, readBuffer);
   }  // End for
 }
+
+#ifndef _WIN32
+TEST(FaissStreamSupportTest, FaissMappedFileIOReaderCopy) {
+  for (auto contentSize : std::vector<int32_t>{0, 2222, 7777, 1024, 77, 1}) {
+    const std::string content = JavaIndexInputMock::makeRandomBytes(contentSize);
+    const std::string path = "mapped_file_io_reader_test.bin";
+    {
+      std::ofstream out(path, std::ios::binary);
+      out.write(content.data(), content.size());
+    }
+
+    {
+      knn_jni::stream::FaissMappedFileIOReader ioReader{path};
+
+      // Read in two parts
+      std::string readBuffer(content.size(), '\0');
+      const size_t head = content.size() / 3;
+      ASSERT_EQ(head, ioReader((void *) readBuffer.data(), 1, head));
+      ASSERT_EQ(content.size() - head, ioReader((void *) (readBuffer.data() + head), 1, content.size() - head));
+      ASSERT_EQ(content, readBuffer);
+
+      // Reading past the end of the file is a short read
+      char extra[4];
+      ASSERT_EQ(0, ioReader((void *) extra, 1, sizeof(extra)));
+    }
+    std::remove(path.c_str());
+  }  // End for
+
+  ASSERT_THROW(knn_jni::stream::FaissMappedFileIOReader{"does_not_exist.bin"}, std::runtime_error);
+}
+#endif
+
+TEST(FaissStreamSupportTest, NativeEngineDirectIndexInputMediatorCopy) {
+  for (auto contentSize : std::vector<int32_t>{0, 2222, 7777, 1024, 77, 1}) {
+    const std::string content = JavaIndexInputMock::makeRandomBytes(contentSize);
+    // Two chunks of 1000 bytes, as the Java side lays out its read-ahead buffer.
+    const int64_t chunkSize = 1000;
+    std::vector<uint8_t> readAheadBuffer(2 * chunkSize);
+    int64_t nextChunk = 0;
+    int64_t nextReadIdx = 0;
+
+    NiceMock<MockJNIUtil> mockJni;
+    EXPECT_CALL(mockJni, GetDirectBufferAddress(_, _))
+        .WillRepeatedly(Return((void *) readAheadBuffer.data()));
+    EXPECT_CALL(mockJni, GetDirectBufferCapacity(_, _))
+        .WillRepeatedly(Return((jlong) readAheadBuffer.size()));
+    EXPECT_CALL(mockJni, CallNonvirtualLongMethodA(_, _, _, _, _))
+        .WillRepeatedly(Return((jlong) content.size()));
+    // Simulates `nextChunk` in IndexInputWithBuffer.
+    EXPECT_CALL(mockJni, CallNonvirtualIntMethodA(_, _, _, _, _))
+        .WillRepeatedly([&](JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, jvalue *args) {
+          const auto readBytes = std::min(chunkSize, (int64_t) content.size() - nextReadIdx);
+          std::memcpy(readAheadBuffer.data() + (nextChunk & 1) * chunkSize, content.data() + nextReadIdx, readBytes);
+          nextReadIdx += readBytes;
+          nextChunk++;
+          return (jint) readBytes;
+        });
+
+    NiceMock<JNIEnv> jniEnv;
+    // It's a dummy value, which will not be used. If we pass a null, then NPE will be raised.
+    jobject jobjectDummy = reinterpret_cast<jobject>(1);
+    knn_jni::stream::NativeEngineDirectIndexInputMediator mediator{&mockJni, &jniEnv, jobjectDummy, jobjectDummy};
+    ASSERT_EQ(content.size(), mediator.remainingBytes());
+
+    // Read with sizes not aligned to the chunks
+    std::string readBuffer(content.size(), '\0');
+    size_t offset = 0;
+    while (offset < content.size()) {
+      const auto readBytes = std::min((size_t) 333, content.size() - offset);
+      mediator.copyBytes(readBytes, (uint8_t *) readBuffer.data() + offset);
+      offset += readBytes;
+    }
+    ASSERT_EQ(content, readBuffer);
+    ASSERT_EQ(0, mediator.remainingBytes());
+    ASSERT_EQ((content.size() + chunkSize - 1) / chunkSize, nextChunk);
+
+    // Reading past the end fails
+    char extra;
+    ASSERT_THROW(mediator.copyBytes(1, (uint8_t *) &extra), std::runtime_error);
+  }  // End for
+}
+
+TEST(FaissStreamSupportTest, NativeEngineDirectIndexOutputMediatorWrite) {
+  for (auto contentSize : std::vector<int32_t>{0, 2222, 7777, 1024, 77, 1}) {
+    const std::string content = JavaIndexInputMock::makeRandomBytes(contentSize);
+    std::vector<uint8_t> directBuffer(1024);
+    std::string written;
+
+    NiceMock<MockJNIUtil> mockJni;
+    EXPECT_CALL(mockJni, GetDirectBufferAddress(_, _))
+        .WillRepeatedly(Return((void *) directBuffer.data()));
+    EXPECT_CALL(mockJni, GetDirectBufferCapacity(_, _))
+        .WillRepeatedly(Return((jlong) directBuffer.size()));
+    // Simulates `writeDirectBytes` in IndexOutputWithBuffer.
+    EXPECT_CALL(mockJni, CallNonvirtualVoidMethodA(_, _, _, _, _))
+        .WillRepeatedly([&](JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, jvalue *args) {
+          ASSERT_LE((size_t) args[0].i, directBuffer.size());
+          written.append((const char *) directBuffer.data(), args[0].i);
+        });
+
+    NiceMock<JNIEnv> jniEnv;
+    jobject jobjectDummy = reinterpret_cast<jobject>(1);
+    knn_jni::stream::NativeEngineDirectIndexOutputMediator mediator{&mockJni, &jniEnv, jobjectDummy, jobjectDummy};
+    FaissOpenSearchIOWriter ioWriter{&mediator};
+
+    size_t offset = 0;
+    while (offset < content.size()) {
+      const auto writeBytes = std::min((size_t) 333, content.size() - offset);
+      ASSERT_EQ(writeBytes, ioWriter(content.data() + offset, 1, writeBytes));
+      offset += writeBytes;
+    }
+    ioWriter.flush();
+
+    ASSERT_EQ(content, written);
+  }  // End for
+}
+
+#ifndef _WIN32
+TEST(FaissStreamSupportTest, NativeEngineFileIndexOutputMediatorWrite) {
+  // Larger than a block, so that blocks are written before the flush
+  for (auto contentSize : std::vector<int32_t>{0, 77, 2222, 5 * 1024 * 1024 + 3}) {
+    const std::string content = JavaIndexInputMock::makeRandomBytes(contentSize);
+    const std::string indexPath = test_util::RandomString(10, "/tmp/", ".faiss");
+    int64_t finishedLength = -1;
+    int64_t finishedChecksum = -1;
+
+    NiceMock<MockJNIUtil> mockJni;
+    // Simulates `directWriteFinished` in IndexOutputWithBuffer.
+    EXPECT_CALL(mockJni, CallNonvirtualVoidMethodA(_, _, _, _, _))
+        .WillOnce([&](JNIEnv *env, jobject obj, jclass clazz, jmethodID methodID, jvalue *args) {
+          finishedLength = args[0].j;
+          finishedChecksum = args[1].j;
+        });
+
+    NiceMock<JNIEnv> jniEnv;
+    jobject jobjectDummy = reinterpret_cast<jobject>(1);
+    {
+      knn_jni::stream::NativeEngineFileIndexOutputMediator mediator{&mockJni, &jniEnv, jobjectDummy, indexPath, 1024};
+      FaissOpenSearchIOWriter ioWriter{&mediator};
+
+      size_t offset = 0;
+      while (offset < content.size()) {
+        const auto writeBytes = std::min((size_t) 333333, content.size() - offset);
+        ASSERT_EQ(writeBytes, ioWriter(content.data() + offset, 1, writeBytes));
+        offset += writeBytes;
+      }
+      ioWriter.flush();
+      ASSERT_THROW(mediator.writeBytes((const uint8_t *) "x", 1), std::runtime_error);
+    }
+
+    std::ifstream file(indexPath, std::ios::binary);
+    const std::string written((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::remove(indexPath.c_str());
+
+    // The index is followed by the Lucene footer: magic, algorithm id and checksum, all big endian
+    ASSERT_EQ(content.size() + 16, written.size());
+    ASSERT_EQ((int64_t) written.size(), finishedLength);
+    ASSERT_EQ(content, written.substr(0, content.size()));
+    const auto *footer = (const uint8_t *) written.data() + content.size();
+    const std::vector<uint8_t> magicAndAlgorithm {0xC0, 0x28, 0x93, 0xE8, 0, 0, 0, 0};
+    ASSERT_EQ(magicAndAlgorithm, std::vector<uint8_t>(footer, footer + 8));
+    uint64_t footerChecksum = 0;
+    for (int i = 8; i < 16; ++i) {
+      footerChecksum = (footerChecksum << 8) | footer[i];
+    }
+    const auto expectedChecksum = knn_jni::util::crc32(0, (const uint8_t *) written.data(), written.size() - 8);
+    ASSERT_EQ(expectedChecksum, footerChecksum);
+    ASSERT_EQ((int64_t) expectedChecksum, finishedChecksum);
+  }  // End for
+}
+#endif
@@ -8,10 +8,14 @@
 // GitHub history for details.
 
 #include "faiss_util.h"
+#include "faiss/IndexBinaryFlat.h"
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 #include "gtest/gtest.h"
+#include "test_util.h"
 
 TEST(IDGrouperBitMapTest, BasicAssertions) {
     int ids[] = {128, 1024};
@@ -26,3 +30,188 @@ TEST(IDGrouperBitMapTest, BasicAssertions) {
         ASSERT_EQ(ids[groupIndex], idGrouperBitmap->get_group(i));
     }
 }
+
+TEST(ConvertInt8ToFloatTest, BasicAssertions) {
+    // Cover empty input, a tail shorter than a vector register and more than one conversion chunk
+    for (size_t size : {0, 17, 200003}) {
+        std::vector<int8_t> src(size);
+        for (size_t i = 0; i < size; i++) {
+            src[i] = static_cast<int8_t>(static_cast<int>(i % 256) - 128);
+        }
+        std::vector<float> dst(size);
+        faiss_util::convertInt8ToFloat(src.data(), size, dst.data());
+        for (size_t i = 0; i < size; i++) {
+            ASSERT_EQ(static_cast<float>(src[i]), dst[i]);
+        }
+    }
+}
+
+TEST(EncodeInt8DirectSignedTest, BasicAssertions) {
+    std::vector<int8_t> src = {-128, -1, 0, 1, 127};
+    std::vector<uint8_t> codes(src.size());
+    faiss_util::encodeInt8DirectSigned(src.data(), src.size(), codes.data());
+    std::vector<uint8_t> expected = {0, 127, 128, 129, 255};
+    ASSERT_EQ(expected, codes);
+}
+
+TEST(ReadIndexIDMapHNSWFlatTest, BasicAssertions) {
+    faiss::idx_t numIds = 1000;
+    int dim = 16;
+    std::vector<faiss::idx_t> ids;
+    std::vector<float> vectors;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i * 3);
+        for (int j = 0; j < dim; ++j) {
+            vectors.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+    }
+
+    for (auto metricType : {faiss::METRIC_L2, faiss::METRIC_INNER_PRODUCT}) {
+        std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW32,Flat", metricType));
+        auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+        auto vectorIoWriter = test_util::FaissGetSerializedIndex(&createdIndexWithData);
+
+        std::unique_ptr<faiss::Index> loadedIndex(
+                faiss_util::readIndexIDMapHNSWFlat(vectorIoWriter.data.data(), vectorIoWriter.data.size()));
+        ASSERT_NE(nullptr, loadedIndex);
+        // Serializing the index again gives the same bytes only if every field matches what read_index would load
+        ASSERT_EQ(vectorIoWriter.data, test_util::FaissGetSerializedIndex(loadedIndex.get()).data);
+
+        // Files written through Lucene end with a footer
+        std::vector<uint8_t> withFooter(vectorIoWriter.data);
+        withFooter.insert(withFooter.end(), 16, 0xFF);
+        loadedIndex.reset(faiss_util::readIndexIDMapHNSWFlat(withFooter.data(), withFooter.size()));
+        ASSERT_NE(nullptr, loadedIndex);
+        ASSERT_EQ(vectorIoWriter.data, test_util::FaissGetSerializedIndex(loadedIndex.get()).data);
+
+        // Truncated input is left to faiss::read_index
+        ASSERT_EQ(nullptr, faiss_util::readIndexIDMapHNSWFlat(vectorIoWriter.data.data(),
+                                                              vectorIoWriter.data.size() - 1));
+    }
+
+    // Other index types are left to faiss::read_index
+    std::unique_ptr<faiss::Index> sqIndex(test_util::FaissCreateIndex(dim, "HNSW32,SQ8", faiss::METRIC_L2));
+    sqIndex->train(numIds, vectors.data());
+    auto sqIndexWithData = test_util::FaissAddData(sqIndex.get(), ids, vectors);
+    auto sqIoWriter = test_util::FaissGetSerializedIndex(&sqIndexWithData);
+    ASSERT_EQ(nullptr, faiss_util::readIndexIDMapHNSWFlat(sqIoWriter.data.data(), sqIoWriter.data.size()));
+}
+
+TEST(ReorderIndexIDMapHNSWTest, BasicAssertions) {
+    faiss::idx_t numIds = 1000;
+    int dim = 16;
+    int k = 10;
+    std::vector<faiss::idx_t> ids;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i * 3);
+    }
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, -500.0, 500.0);
+    std::vector<float> queries = test_util::RandomVectors(dim, 20, -500.0, 500.0);
+
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW32,Flat", faiss::METRIC_L2));
+    auto idMap = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    auto *hnswIndex = dynamic_cast<faiss::IndexHNSW *>(createdIndex.get());
+    const faiss::idx_t entryLabel = idMap.id_map[hnswIndex->hnsw.entry_point];
+
+    std::vector<float> distances(20 * k), reorderedDistances(20 * k);
+    std::vector<faiss::idx_t> labels(20 * k), reorderedLabels(20 * k);
+    idMap.search(20, queries.data(), k, distances.data(), labels.data());
+
+    ASSERT_TRUE(faiss_util::reorderIndexIDMapHNSW(&idMap));
+    // The entry point comes first, followed by its neighbors
+    ASSERT_EQ(0, hnswIndex->hnsw.entry_point);
+    ASSERT_EQ(entryLabel, idMap.id_map[0]);
+    size_t begin, end;
+    hnswIndex->hnsw.neighbor_range(0, 0, &begin, &end);
+    ASSERT_EQ(1, hnswIndex->hnsw.neighbors[begin]);
+
+    // The graph is the same, only numbered differently, so searches return the same results
+    idMap.search(20, queries.data(), k, reorderedDistances.data(), reorderedLabels.data());
+    ASSERT_EQ(labels, reorderedLabels);
+    ASSERT_EQ(distances, reorderedDistances);
+
+    // And so does the index read back by faiss
+    auto serialized = test_util::FaissGetSerializedIndex(&idMap);
+    std::unique_ptr<faiss::Index> loadedIndex(test_util::FaissLoadFromSerializedIndex(&serialized.data));
+    loadedIndex->search(20, queries.data(), k, reorderedDistances.data(), reorderedLabels.data());
+    ASSERT_EQ(labels, reorderedLabels);
+
+    // Indexes with other layouts are left alone
+    std::unique_ptr<faiss::Index> ivfIndex(test_util::FaissCreateIndex(dim, "IVF4,Flat", faiss::METRIC_L2));
+    ivfIndex->train(numIds, vectors.data());
+    auto ivfIdMap = test_util::FaissAddData(ivfIndex.get(), ids, vectors);
+    ASSERT_FALSE(faiss_util::reorderIndexIDMapHNSW(&ivfIdMap));
+}
+
+TEST(ReorderIndexBinaryIDMapHNSWTest, BasicAssertions) {
+    faiss::idx_t numIds = 500;
+    int dim = 128;
+    std::vector<faiss::idx_t> ids;
+    std::vector<uint8_t> vectors;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim / 8; ++j) {
+            vectors.push_back(test_util::RandomInt(0, 255));
+        }
+    }
+
+    std::unique_ptr<faiss::IndexBinary> createdIndex(test_util::FaissCreateBinaryIndex(dim, "BHNSW32"));
+    auto idMap = test_util::FaissAddBinaryData(createdIndex.get(), ids, vectors);
+    auto *hnswIndex = dynamic_cast<faiss::IndexBinaryHNSW *>(createdIndex.get());
+    const faiss::idx_t entryLabel = idMap.id_map[hnswIndex->hnsw.entry_point];
+
+    ASSERT_TRUE(faiss_util::reorderIndexBinaryIDMapHNSW(&idMap));
+    ASSERT_EQ(0, hnswIndex->hnsw.entry_point);
+    ASSERT_EQ(entryLabel, idMap.id_map[0]);
+    // Every code moved along with its label, ids being the positions of the vectors here
+    const auto *storage = dynamic_cast<faiss::IndexBinaryFlat *>(hnswIndex->storage);
+    const int codeSize = dim / 8;
+    for (faiss::idx_t i = 0; i < numIds; ++i) {
+        ASSERT_TRUE(std::equal(storage->xb.data() + i * codeSize, storage->xb.data() + (i + 1) * codeSize,
+                               vectors.data() + idMap.id_map[i] * codeSize));
+    }
+
+    // Vectors are still found by searching for themselves
+    std::vector<int32_t> distances(numIds);
+    std::vector<faiss::idx_t> labels(numIds);
+    idMap.search(numIds, vectors.data(), 1, distances.data(), labels.data());
+    ASSERT_GE(std::count(distances.begin(), distances.end(), 0), numIds * 9 / 10);
+}
+
+TEST(WarmMemoryRegionsTest, BasicAssertions) {
+    std::vector<uint8_t> large(3 * 1024 * 1024 + 5, 1);
+    std::vector<float> small(7, 1.0f);
+    std::vector<faiss_util::MemoryRegion> regions {
+        {large.data(), large.size()},
+        {small.data(), small.size() * sizeof(float)},
+        {nullptr, 0}
+    };
+
+    const size_t expectedBytes = large.size() + small.size() * sizeof(float);
+    ASSERT_EQ(expectedBytes, faiss_util::warmMemoryRegions(regions, false));
+    ASSERT_EQ(expectedBytes, faiss_util::warmMemoryRegions(regions, true));
+    ASSERT_EQ(0u, faiss_util::warmMemoryRegions({}, true));
+}
+
+TEST(PlaceMemoryRegionsTest, BasicAssertions) {
+    const int numaNodes = faiss_util::getNumaNodeCount();
+    ASSERT_GE(numaNodes, 1);
+
+    std::vector<uint8_t> large(3 * 1024 * 1024 + 5, 1);
+    std::vector<faiss_util::MemoryRegion> regions {{large.data(), large.size()}};
+
+    // Nodes outside of the host are rejected, and single node hosts never move anything
+    ASSERT_FALSE(faiss_util::placeMemoryRegions(regions, numaNodes + 1));
+    ASSERT_FALSE(faiss_util::placeMemoryRegions(regions, -2));
+    if (numaNodes == 1) {
+        ASSERT_FALSE(faiss_util::placeMemoryRegions(regions, 0));
+        ASSERT_FALSE(faiss_util::placeMemoryRegions(regions, -1));
+    } else if (faiss_util::placeMemoryRegions(regions, -1)) {
+        // The policy can be dropped wherever it was set
+        ASSERT_TRUE(faiss_util::resetMemoryRegions(regions));
+    }
+
+    // The bytes are untouched wherever they end up
+    ASSERT_EQ(1, large[0]);
+    ASSERT_EQ(1, large[large.size() - 1]);
+}
@@ -10,7 +10,12 @@
  */
 
 #include "faiss_wrapper.h"
+#include "faiss_util.h"
+#include "commons.h"
 
+#include <algorithm>
+#include <map>
+#include <set>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -55,7 +60,7 @@ void createIndexIteratively(
     long docsPerInsertion = numDocs / insertions;
     long index_ptr = knn_jni::faiss_wrapper::InitIndex(JNIUtil, jniEnv, numDocs, dim, (jobject)&parametersMap, indexService);
     std::vector<faiss::idx_t> insertIds;
-    std::vector<float> insertVecs;
+    knn_jni::memory::VectorBuffer<float> insertVecs;
     for (int i = 0; i < insertions; i++) {
         insertIds.clear();
         insertVecs.clear();
@@ -86,7 +91,7 @@ void createBinaryIndexIteratively(
     long numDocs = ids.size();
     long index_ptr = knn_jni::faiss_wrapper::InitIndex(JNIUtil, jniEnv, numDocs, dim, (jobject)&parametersMap, indexService);
     std::vector<faiss::idx_t> insertIds;
-    std::vector<float> insertVecs;
+    knn_jni::memory::VectorBuffer<uint8_t> insertVecs;
     for (int i = 0; i < insertions; i++) {
         int start_idx = numDocs * i / insertions;
         int end_idx = numDocs * (i + 1) / insertions;
@@ -218,7 +223,7 @@ TEST(FaissCreateIndexFromTemplateTest, BasicAssertions) {
         // Define the data
         faiss::idx_t numIds = 100;
         std::vector<faiss::idx_t> ids;
-        auto *vectors = new std::vector<float>();
+        auto vectors = std::make_unique<knn_jni::memory::VectorBuffer<float>>();
         int dim = 2;
         vectors->reserve(dim * numIds);
         for (int64_t i = 0; i < numIds; ++i) {
@@ -249,7 +254,7 @@ TEST(FaissCreateIndexFromTemplateTest, BasicAssertions) {
         try {
             knn_jni::faiss_wrapper::CreateIndexFromTemplate(
                 &mockJNIUtil, &jniEnv, reinterpret_cast<jintArray>(&ids),
-                (jlong)vectors, dim, (jobject)(&javaFileIndexOutputMock),
+                (jlong) vectors.get(), dim, (jobject)(&javaFileIndexOutputMock),
                 reinterpret_cast<jbyteArray>(&(vectorIoWriter.data)),
                 (jobject) &parametersMap);
             javaFileIndexOutputMock.file_writer.close();
@@ -273,7 +278,7 @@ TEST(FaissCreateByteIndexFromTemplateTest, BasicAssertions) {
         // Define the data
         faiss::idx_t numIds = 100;
         std::vector<faiss::idx_t> ids;
-        auto *vectors = new std::vector<int8_t>();
+        auto vectors = std::make_unique<knn_jni::memory::VectorBuffer<int8_t>>();
         int dim = 8;
         vectors->reserve(dim * numIds);
         for (int64_t i = 0; i < numIds; ++i) {
@@ -304,7 +309,7 @@ TEST(FaissCreateByteIndexFromTemplateTest, BasicAssertions) {
         try {
             knn_jni::faiss_wrapper::CreateByteIndexFromTemplate(
                 &mockJNIUtil, &jniEnv, reinterpret_cast<jintArray>(&ids),
-                (jlong) vectors, dim, (jstring) (&javaFileIndexOutputMock),
+                (jlong) vectors.get(), dim, (jstring) (&javaFileIndexOutputMock),
                 reinterpret_cast<jbyteArray>(&(vectorIoWriter.data)),
                 (jobject) &parametersMap
             );
@@ -349,9 +354,19 @@ TEST(FaissLoadIndexTest, BasicAssertions) {
     NiceMock<JNIEnv> jniEnv;
     NiceMock<test_util::MockJNIUtil> mockJNIUtil;
 
-    std::unique_ptr<faiss::Index> loadedIndexPointer(
-            reinterpret_cast<faiss::Index *>(knn_jni::faiss_wrapper::LoadIndex(
+    std::unique_ptr<knn_jni::faiss_wrapper::NativeIndexHandle> loadedIndexHandle(
+            reinterpret_cast<knn_jni::faiss_wrapper::NativeIndexHandle *>(knn_jni::faiss_wrapper::LoadIndex(
                     &mockJNIUtil, &jniEnv, (jstring)&indexPath)));
+    std::unique_ptr<faiss::Index> loadedIndexPointer(loadedIndexHandle->index);
+
+    // Dispatch metadata is resolved at load time
+    ASSERT_FALSE(loadedIndexHandle->isBinary);
+    ASSERT_EQ(knn_jni::faiss_wrapper::IndexKind::HNSW, loadedIndexHandle->kind);
+    ASSERT_EQ(dim, loadedIndexHandle->dimension);
+    ASSERT_EQ(metricType, loadedIndexHandle->metric);
+    ASSERT_NE(nullptr, loadedIndexHandle->idMap);
+    ASSERT_NE(nullptr, loadedIndexHandle->hnsw);
+    ASSERT_EQ(loadedIndexHandle->hnsw->hnsw.efSearch, loadedIndexHandle->defaultEfSearch);
 
     // Compare serialized versions
     auto createIndexSerialization =
@@ -400,9 +415,15 @@ TEST(FaissLoadBinaryIndexTest, BasicAssertions) {
     NiceMock<JNIEnv> jniEnv;
     NiceMock<test_util::MockJNIUtil> mockJNIUtil;
 
-    std::unique_ptr<faiss::IndexBinary> loadedIndexPointer(
-            reinterpret_cast<faiss::IndexBinary *>(knn_jni::faiss_wrapper::LoadBinaryIndex(
+    std::unique_ptr<knn_jni::faiss_wrapper::NativeIndexHandle> loadedIndexHandle(
+            reinterpret_cast<knn_jni::faiss_wrapper::NativeIndexHandle *>(knn_jni::faiss_wrapper::LoadBinaryIndex(
                     &mockJNIUtil, &jniEnv, (jstring)&indexPath)));
+    std::unique_ptr<faiss::IndexBinary> loadedIndexPointer(loadedIndexHandle->binaryIndex);
+
+    ASSERT_TRUE(loadedIndexHandle->isBinary);
+    ASSERT_EQ(knn_jni::faiss_wrapper::IndexKind::HNSW, loadedIndexHandle->kind);
+    ASSERT_EQ(dim, loadedIndexHandle->dimension);
+    ASSERT_NE(nullptr, loadedIndexHandle->binaryHnsw);
 
     // Compare serialized versions
     auto createIndexSerialization =
@@ -443,9 +464,10 @@ TEST(FaissLoadIndexTest, HNSWPQDisableSdcTable) {
     NiceMock<JNIEnv> jniEnv;
     NiceMock<test_util::MockJNIUtil> mockJNIUtil;
 
-    std::unique_ptr<faiss::Index> loadedIndexPointer(
-            reinterpret_cast<faiss::Index *>(knn_jni::faiss_wrapper::LoadIndex(
+    std::unique_ptr<knn_jni::faiss_wrapper::NativeIndexHandle> loadedIndexHandle(
+            reinterpret_cast<knn_jni::faiss_wrapper::NativeIndexHandle *>(knn_jni::faiss_wrapper::LoadIndex(
                     &mockJNIUtil, &jniEnv, (jstring)&indexPath)));
+    std::unique_ptr<faiss::Index> loadedIndexPointer(loadedIndexHandle->index);
 
     // Cast down until we get to the pq backed storage index and checke the size of the table
     auto idMapIndex = dynamic_cast<faiss::IndexIDMap *>(loadedIndexPointer.get());
@@ -476,9 +498,10 @@ TEST(FaissLoadIndexTest, IVFPQDisablePrecomputeTable) {
     NiceMock<JNIEnv> jniEnv;
     NiceMock<test_util::MockJNIUtil> mockJNIUtil;
 
-    std::unique_ptr<faiss::Index> loadedIndexPointer(
-            reinterpret_cast<faiss::Index *>(knn_jni::faiss_wrapper::LoadIndex(
+    std::unique_ptr<knn_jni::faiss_wrapper::NativeIndexHandle> loadedIndexHandle(
+            reinterpret_cast<knn_jni::faiss_wrapper::NativeIndexHandle *>(knn_jni::faiss_wrapper::LoadIndex(
                     &mockJNIUtil, &jniEnv, (jstring)&indexPath)));
+    std::unique_ptr<faiss::Index> loadedIndexPointer(loadedIndexHandle->index);
 
     // Cast down until we get to the ivfpq-l2 state
     auto idMapIndex = dynamic_cast<faiss::IndexIDMap *>(loadedIndexPointer.get());
@@ -486,6 +509,9 @@ TEST(FaissLoadIndexTest, IVFPQDisablePrecomputeTable) {
     auto ivfpqIndex = dynamic_cast<faiss::IndexIVFPQ *>(idMapIndex->index);
     ASSERT_NE(ivfpqIndex, nullptr);
     ASSERT_EQ(0, ivfpqIndex->precomputed_table->size());
+    ASSERT_EQ(knn_jni::faiss_wrapper::IndexKind::IVF, loadedIndexHandle->kind);
+    ASSERT_EQ(ivfpqIndex, loadedIndexHandle->ivf);
+    ASSERT_EQ(ivfpqIndex->nprobe, loadedIndexHandle->defaultNprobe);
 }
 
 TEST(FaissQueryIndexTest, BasicAssertions) {
@@ -521,6 +547,7 @@ TEST(FaissQueryIndexTest, BasicAssertions) {
             test_util::FaissCreateIndex(dim, method, metricType));
     auto createdIndexWithData =
             test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
 
     // Setup jni
     NiceMock<JNIEnv> jniEnv;
@@ -532,7 +559,7 @@ TEST(FaissQueryIndexTest, BasicAssertions) {
                 reinterpret_cast<std::vector<std::pair<int, float> *> *>(
                         knn_jni::faiss_wrapper::QueryIndex(
                                 &mockJNIUtil, &jniEnv,
-                                reinterpret_cast<jlong>(&createdIndexWithData),
+                                reinterpret_cast<jlong>(&indexHandle),
                                 reinterpret_cast<jfloatArray>(&query), k, methodParamsJ, nullptr)));
 
         ASSERT_EQ(k, results->size());
@@ -577,6 +604,7 @@ TEST(FaissQueryBinaryIndexTest, BasicAssertions) {
             test_util::FaissCreateBinaryIndex(dim, method));
     auto createdIndexWithData =
             test_util::FaissAddBinaryData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
 
     // Setup jni
     NiceMock<JNIEnv> jniEnv;
@@ -587,7 +615,7 @@ TEST(FaissQueryBinaryIndexTest, BasicAssertions) {
                 reinterpret_cast<std::vector<std::pair<int, int32_t> *> *>(
                         knn_jni::faiss_wrapper::QueryBinaryIndex_WithFilter(
                                 &mockJNIUtil, &jniEnv,
-                                reinterpret_cast<jlong>(&createdIndexWithData),
+                                reinterpret_cast<jlong>(&indexHandle),
                                 reinterpret_cast<jbyteArray>(&query), k, nullptr, nullptr, 0, nullptr)));
 
         ASSERT_EQ(k, results->size());
@@ -599,6 +627,474 @@ TEST(FaissQueryBinaryIndexTest, BasicAssertions) {
     }
 }
 
+TEST(FaissQueryIndexWithSearchParamsTest, BasicAssertions) {
+    // Define the index data
+    faiss::idx_t numIds = 100;
+    int dim = 16;
+    std::vector<faiss::idx_t> ids = test_util::Range(numIds);
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, randomDataMin, randomDataMax);
+
+    faiss::MetricType metricType = faiss::METRIC_L2;
+    std::string method = "HNSW32,Flat";
+
+    // Define query data
+    int k = 10;
+    int efSearch = 20;
+    std::unordered_map<std::string, jobject> methodParams;
+    methodParams[knn_jni::EF_SEARCH] = reinterpret_cast<jobject>(&efSearch);
+
+    int numQueries = 10;
+    std::vector<std::vector<float>> queries;
+    for (int i = 0; i < numQueries; i++) {
+        std::vector<float> query;
+        query.reserve(dim);
+        for (int j = 0; j < dim; j++) {
+            query.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+        queries.push_back(query);
+    }
+
+    // Create the index
+    std::unique_ptr<faiss::Index> createdIndex(
+            test_util::FaissCreateIndex(dim, method, metricType));
+    auto createdIndexWithData =
+            test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+
+    // Setup jni
+    NiceMock<JNIEnv> jniEnv;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+    auto methodParamsJ = reinterpret_cast<jobject>(&methodParams);
+
+    // Created once, the handle is reused by every query without converting a map
+    jlong searchParams = knn_jni::commons::createSearchParams(efSearch, -1);
+
+    for (auto query : queries) {
+        std::unique_ptr<std::vector<std::pair<int, float> *>> expected(
+                reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+                        knn_jni::faiss_wrapper::QueryIndex(
+                                &mockJNIUtil, &jniEnv,
+                                reinterpret_cast<jlong>(&indexHandle),
+                                reinterpret_cast<jfloatArray>(&query), k, methodParamsJ, nullptr)));
+
+        std::vector<int> resultIds;
+        std::vector<float> resultDistances;
+        int resultSize = knn_jni::faiss_wrapper::QueryIndex_WithFilterBuffer(
+                &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle),
+                reinterpret_cast<jfloatArray>(&query), k, searchParams, nullptr, 0, nullptr,
+                reinterpret_cast<jintArray>(&resultIds), reinterpret_cast<jfloatArray>(&resultDistances));
+
+        ASSERT_EQ(expected->size(), resultSize);
+        for (int i = 0; i < resultSize; i++) {
+            ASSERT_EQ((*expected)[i]->first, resultIds[i]);
+            ASSERT_FLOAT_EQ((*expected)[i]->second, resultDistances[i]);
+        }
+
+        // Need to free up each result
+        for (auto it : *expected.get()) {
+            delete it;
+        }
+    }
+
+    knn_jni::commons::freeSearchParams(searchParams);
+
+    // Every query was searched once through the map and once through the handle
+    ASSERT_EQ(numQueries * 2, indexHandle.queryCount.load());
+}
+
+TEST(FaissQueryIndexWithFilterBufferTest, BasicAssertions) {
+    // Define the index data
+    faiss::idx_t numIds = 200;
+    int dim = 16;
+    std::vector<faiss::idx_t> ids = test_util::Range(numIds);
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, randomDataMin, randomDataMax);
+
+    faiss::MetricType metricType = faiss::METRIC_L2;
+    std::string method = "HNSW32,Flat";
+
+    // Filter on the even ids, both as a Lucene FixedBitSet and as a sorted id list
+    std::vector<jlong> bitmapFilter((numIds + 63) / 64, 0);
+    std::vector<jlong> batchFilter;
+    for (faiss::idx_t id = 0; id < numIds; id += 2) {
+        bitmapFilter[id >> 6] |= (1ULL << (id & 63));
+        batchFilter.push_back(id);
+    }
+
+    // Define query data
+    int k = 10;
+    int numQueries = 10;
+    std::vector<std::vector<float>> queries;
+    for (int i = 0; i < numQueries; i++) {
+        std::vector<float> query;
+        query.reserve(dim);
+        for (int j = 0; j < dim; j++) {
+            query.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+        queries.push_back(query);
+    }
+
+    // Create the index
+    std::unique_ptr<faiss::Index> createdIndex(
+            test_util::FaissCreateIndex(dim, method, metricType));
+    auto createdIndexWithData =
+            test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+
+    // Setup jni
+    NiceMock<JNIEnv> jniEnv;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    for (auto query : queries) {
+        for (auto [filter, filterType] : {std::make_pair(&bitmapFilter, 0), std::make_pair(&batchFilter, 1)}) {
+            std::unique_ptr<std::vector<std::pair<int, float> *>> expected(
+                    reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+                            knn_jni::faiss_wrapper::QueryIndex_WithFilter(
+                                    &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle),
+                                    reinterpret_cast<jfloatArray>(&query), k, nullptr,
+                                    reinterpret_cast<jlongArray>(filter), filterType, nullptr)));
+
+            std::vector<int> resultIds;
+            std::vector<float> resultDistances;
+            int resultSize = knn_jni::faiss_wrapper::QueryIndex_WithFilterBuffer(
+                    &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle),
+                    reinterpret_cast<jfloatArray>(&query), k, 0, reinterpret_cast<jobject>(filter), filterType,
+                    nullptr, reinterpret_cast<jintArray>(&resultIds), reinterpret_cast<jfloatArray>(&resultDistances));
+
+            ASSERT_EQ(expected->size(), resultSize);
+            for (int i = 0; i < resultSize; i++) {
+                ASSERT_EQ(0, resultIds[i] % 2);
+                ASSERT_EQ((*expected)[i]->first, resultIds[i]);
+                ASSERT_FLOAT_EQ((*expected)[i]->second, resultDistances[i]);
+            }
+
+            // Need to free up each result
+            for (auto it : *expected.get()) {
+                delete it;
+            }
+        }
+    }
+
+    // A heap buffer has no native address
+    EXPECT_CALL(mockJNIUtil, GetDirectBufferAddress).WillOnce(Return(nullptr));
+    std::vector<int> resultIds;
+    std::vector<float> resultDistances;
+    EXPECT_THROW(knn_jni::faiss_wrapper::QueryIndex_WithFilterBuffer(
+                         &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle),
+                         reinterpret_cast<jfloatArray>(&queries[0]), k, 0, reinterpret_cast<jobject>(&bitmapFilter), 0,
+                         nullptr, reinterpret_cast<jintArray>(&resultIds),
+                         reinterpret_cast<jfloatArray>(&resultDistances)),
+                 std::runtime_error);
+}
+
+TEST(FaissQueryIndexWithSortedArrayFilterTest, BasicAssertions) {
+    // Define the index data
+    faiss::idx_t numIds = 1000;
+    int dim = 16;
+    std::vector<faiss::idx_t> ids = test_util::Range(numIds);
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, randomDataMin, randomDataMax);
+
+    faiss::MetricType metricType = faiss::METRIC_L2;
+    std::string method = "HNSW32,Flat";
+
+    // A sparse filter is searched in place, a dense one is turned into a bitmap
+    std::vector<jlong> sparseFilter;
+    for (faiss::idx_t id = 7; id < numIds; id += 97) {
+        sparseFilter.push_back(id);
+    }
+    std::vector<jlong> denseFilter;
+    for (faiss::idx_t id = 0; id < numIds; id += 3) {
+        denseFilter.push_back(id);
+    }
+
+    // Define query data
+    int k = 5;
+    int numQueries = 10;
+    std::vector<std::vector<float>> queries;
+    for (int i = 0; i < numQueries; i++) {
+        std::vector<float> query;
+        query.reserve(dim);
+        for (int j = 0; j < dim; j++) {
+            query.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+        queries.push_back(query);
+    }
+
+    // Create the index
+    std::unique_ptr<faiss::Index> createdIndex(
+            test_util::FaissCreateIndex(dim, method, metricType));
+    auto createdIndexWithData =
+            test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+
+    // Setup jni
+    NiceMock<JNIEnv> jniEnv;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    for (auto query : queries) {
+        for (auto filter : {&sparseFilter, &denseFilter}) {
+            std::vector<int> expectedIds;
+            std::vector<float> expectedDistances;
+            int expectedSize = knn_jni::faiss_wrapper::QueryIndex_WithFilterBuffer(
+                    &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle),
+                    reinterpret_cast<jfloatArray>(&query), k, 0, reinterpret_cast<jobject>(filter), 1,
+                    nullptr, reinterpret_cast<jintArray>(&expectedIds),
+                    reinterpret_cast<jfloatArray>(&expectedDistances));
+
+            std::vector<int> resultIds;
+            std::vector<float> resultDistances;
+            int resultSize = knn_jni::faiss_wrapper::QueryIndex_WithFilterBuffer(
+                    &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle),
+                    reinterpret_cast<jfloatArray>(&query), k, 0, reinterpret_cast<jobject>(filter), 2,
+                    nullptr, reinterpret_cast<jintArray>(&resultIds), reinterpret_cast<jfloatArray>(&resultDistances));
+
+            ASSERT_EQ(expectedSize, resultSize);
+            ASSERT_EQ(expectedIds, resultIds);
+            for (int i = 0; i < resultSize; i++) {
+                ASSERT_TRUE(std::binary_search(filter->begin(), filter->end(), (jlong) resultIds[i]));
+                ASSERT_FLOAT_EQ(expectedDistances[i], resultDistances[i]);
+            }
+        }
+    }
+}
+
+TEST(FaissExactSearchWithFilterTest, BasicAssertions) {
+    // Define the index data, with labels offset from the internal ids
+    faiss::idx_t numIds = 300;
+    int dim = 8;
+    std::vector<faiss::idx_t> ids;
+    for (faiss::idx_t i = 0; i < numIds; i++) {
+        ids.push_back(1000 + i * 2);
+    }
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, randomDataMin, randomDataMax);
+
+    faiss::MetricType metricType = faiss::METRIC_L2;
+    std::string method = "HNSW32,Flat";
+
+    std::unique_ptr<faiss::Index> createdIndex(
+            test_util::FaissCreateIndex(dim, method, metricType));
+    auto createdIndexWithData =
+            test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+    ASSERT_TRUE(indexHandle.idMapSorted);
+
+    // Every third vector passes the filter, plus a label that is not in the index
+    std::vector<jlong> filter;
+    for (faiss::idx_t i = 0; i < numIds; i += 3) {
+        filter.push_back(ids[i]);
+    }
+    filter.push_back(1);
+    std::vector<jlong> bitmapFilter((ids.back() >> 6) + 1, 0);
+    for (jlong label : filter) {
+        bitmapFilter[label >> 6] |= 1ULL << (label & 63);
+    }
+
+    std::vector<float> query = test_util::RandomVectors(dim, 1, randomDataMin, randomDataMax);
+
+    // Brute force expected results
+    std::vector<std::pair<float, faiss::idx_t>> expected;
+    for (faiss::idx_t i = 0; i < numIds; i += 3) {
+        float distance = 0;
+        for (int j = 0; j < dim; j++) {
+            float diff = query[j] - vectors[i * dim + j];
+            distance += diff * diff;
+        }
+        expected.emplace_back(distance, ids[i]);
+    }
+    std::sort(expected.begin(), expected.end());
+
+    // Setup jni
+    NiceMock<JNIEnv> jniEnv;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    int k = 10;
+    for (auto [filterIds, filterType] : {std::make_pair(&filter, 2), std::make_pair(&bitmapFilter, 0)}) {
+        std::vector<int> resultIds;
+        std::vector<float> resultDistances;
+        int resultSize = knn_jni::faiss_wrapper::ExactSearch_WithFilter(
+                &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle), reinterpret_cast<jfloatArray>(&query),
+                k, reinterpret_cast<jlongArray>(filterIds), filterType, reinterpret_cast<jintArray>(&resultIds),
+                reinterpret_cast<jfloatArray>(&resultDistances));
+
+        ASSERT_EQ(k, resultSize);
+        for (int i = 0; i < resultSize; i++) {
+            ASSERT_EQ(expected[i].second, resultIds[i]);
+            ASSERT_NEAR(expected[i].first, resultDistances[i], 1e-3 * expected[i].first);
+        }
+    }
+
+    // Range search returns everything strictly within the radius, closest first
+    size_t expectedRangeSize = expected.size() / 2;
+    float radius = (expected[expectedRangeSize - 1].first + expected[expectedRangeSize].first) / 2;
+    std::vector<int> resultIds;
+    std::vector<float> resultDistances;
+    int resultSize = knn_jni::faiss_wrapper::ExactRangeSearch_WithFilter(
+            &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle), reinterpret_cast<jfloatArray>(&query),
+            radius, numIds, reinterpret_cast<jlongArray>(&filter), 2, reinterpret_cast<jintArray>(&resultIds),
+            reinterpret_cast<jfloatArray>(&resultDistances));
+    ASSERT_EQ((int) expectedRangeSize, resultSize);
+    for (int i = 0; i < resultSize; i++) {
+        ASSERT_EQ(expected[i].second, resultIds[i]);
+    }
+
+    // The window caps the range results
+    resultSize = knn_jni::faiss_wrapper::ExactRangeSearch_WithFilter(
+            &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle), reinterpret_cast<jfloatArray>(&query),
+            radius, 3, reinterpret_cast<jlongArray>(&filter), 2, reinterpret_cast<jintArray>(&resultIds),
+            reinterpret_cast<jfloatArray>(&resultDistances));
+    ASSERT_EQ(3, resultSize);
+
+    // A graph reordered for locality no longer has sorted labels, id filters are looked up through the label order
+    ASSERT_TRUE(faiss_util::reorderIndexIDMapHNSW(&createdIndexWithData));
+    knn_jni::faiss_wrapper::NativeIndexHandle reorderedHandle(&createdIndexWithData);
+    ASSERT_FALSE(reorderedHandle.idMapSorted);
+    ASSERT_EQ(numIds, (faiss::idx_t) reorderedHandle.labelOrder.size());
+    resultSize = knn_jni::faiss_wrapper::ExactSearch_WithFilter(
+            &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&reorderedHandle), reinterpret_cast<jfloatArray>(&query),
+            k, reinterpret_cast<jlongArray>(&filter), 2, reinterpret_cast<jintArray>(&resultIds),
+            reinterpret_cast<jfloatArray>(&resultDistances));
+    ASSERT_EQ(k, resultSize);
+    for (int i = 0; i < resultSize; i++) {
+        ASSERT_EQ(expected[i].second, resultIds[i]);
+        ASSERT_NEAR(expected[i].first, resultDistances[i], 1e-3 * expected[i].first);
+    }
+}
+
+TEST(FaissQueryIndexBatchTest, BasicAssertions) {
+    // Define the index data
+    faiss::idx_t numIds = 100;
+    int dim = 16;
+    std::vector<faiss::idx_t> ids = test_util::Range(numIds);
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, randomDataMin, randomDataMax);
+
+    faiss::MetricType metricType = faiss::METRIC_L2;
+    std::string method = "HNSW32,Flat";
+
+    // Define query data
+    int k = 10;
+    int efSearch = 20;
+    std::unordered_map<std::string, jobject> methodParams;
+    methodParams[knn_jni::EF_SEARCH] = reinterpret_cast<jobject>(&efSearch);
+
+    int numQueries = 10;
+    std::vector<std::vector<float>> queries;
+    std::vector<float> flatQueries;
+    for (int i = 0; i < numQueries; i++) {
+        std::vector<float> query;
+        query.reserve(dim);
+        for (int j = 0; j < dim; j++) {
+            query.push_back(test_util::RandomFloat(-500.0, 500.0));
+        }
+        flatQueries.insert(flatQueries.end(), query.begin(), query.end());
+        queries.push_back(query);
+    }
+
+    // Create the index
+    std::unique_ptr<faiss::Index> createdIndex(
+            test_util::FaissCreateIndex(dim, method, metricType));
+    auto createdIndexWithData =
+            test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+
+    // Setup jni
+    NiceMock<JNIEnv> jniEnv;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+    auto methodParamsJ = reinterpret_cast<jobject>(&methodParams);
+
+    jlong searchParams = knn_jni::commons::createSearchParams(efSearch, -1);
+
+    std::vector<int> resultIds;
+    std::vector<float> resultDistances;
+    knn_jni::faiss_wrapper::QueryIndexBatch(
+            &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle),
+            reinterpret_cast<jfloatArray>(&flatQueries), numQueries, k, searchParams, nullptr, 0, nullptr,
+            reinterpret_cast<jintArray>(&resultIds), reinterpret_cast<jfloatArray>(&resultDistances));
+
+    ASSERT_EQ(numQueries * k, resultIds.size());
+    ASSERT_EQ(numQueries * k, resultDistances.size());
+
+    // Every query of the batch must return the same neighbors as when it is run on its own
+    for (int i = 0; i < numQueries; i++) {
+        std::unique_ptr<std::vector<std::pair<int, float> *>> results(
+                reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+                        knn_jni::faiss_wrapper::QueryIndex(
+                                &mockJNIUtil, &jniEnv,
+                                reinterpret_cast<jlong>(&indexHandle),
+                                reinterpret_cast<jfloatArray>(&queries[i]), k, methodParamsJ, nullptr)));
+
+        ASSERT_EQ(k, results->size());
+        for (int j = 0; j < k; j++) {
+            ASSERT_EQ((*results)[j]->first, resultIds[i * k + j]);
+            ASSERT_FLOAT_EQ((*results)[j]->second, resultDistances[i * k + j]);
+        }
+
+        // Need to free up each result
+        for (auto it : *results.get()) {
+            delete it;
+        }
+    }
+
+    // Query vectors must hold exactly numQueries vectors
+    std::vector<float> truncatedQueries(flatQueries.begin(), flatQueries.end() - 1);
+    EXPECT_THROW(knn_jni::faiss_wrapper::QueryIndexBatch(
+            &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle),
+            reinterpret_cast<jfloatArray>(&truncatedQueries), numQueries, k, searchParams, nullptr, 0, nullptr,
+            reinterpret_cast<jintArray>(&resultIds), reinterpret_cast<jfloatArray>(&resultDistances)),
+            std::runtime_error);
+
+    knn_jni::commons::freeSearchParams(searchParams);
+
+    // The batch counts as one query per query vector
+    ASSERT_EQ(numQueries * 2, indexHandle.queryCount.load());
+}
+
+TEST(FaissQueryBinaryIndexBatchTest, BasicAssertions) {
+    // Define the data
+    faiss::idx_t numIds = 200;
+    std::vector<faiss::idx_t> ids;
+    std::vector<uint8_t> vectors;
+    int dim = 128;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim / 8; ++j) {
+            vectors.push_back(test_util::RandomInt(0, 255));
+        }
+    }
+
+    // Define query data
+    int k = 10;
+    int numQueries = 10;
+    std::vector<uint8_t> flatQueries;
+    for (int i = 0; i < numQueries * dim / 8; i++) {
+        flatQueries.push_back(test_util::RandomInt(0, 255));
+    }
+
+    // Create the index
+    std::string method = "BHNSW32";
+    std::unique_ptr<faiss::IndexBinary> createdIndex(
+            test_util::FaissCreateBinaryIndex(dim, method));
+    auto createdIndexWithData =
+            test_util::FaissAddBinaryData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+
+    // Setup jni
+    NiceMock<JNIEnv> jniEnv;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    std::vector<int> resultIds;
+    std::vector<float> resultDistances;
+    knn_jni::faiss_wrapper::QueryBinaryIndexBatch(
+            &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle),
+            reinterpret_cast<jbyteArray>(&flatQueries), numQueries, k, 0, nullptr, 0, nullptr,
+            reinterpret_cast<jintArray>(&resultIds), reinterpret_cast<jfloatArray>(&resultDistances));
+
+    ASSERT_EQ(numQueries * k, resultIds.size());
+    ASSERT_EQ(numQueries * k, resultDistances.size());
+    for (int i = 0; i < numQueries * k; i++) {
+        ASSERT_GE(resultIds[i], 0);
+        ASSERT_LT(resultIds[i], numIds);
+    }
+}
+
 //Test for a bug reported in https://github.com/opensearch-project/k-NN/issues/1435
 TEST(FaissQueryIndexWithFilterTest1435, BasicAssertions) {
     // Define the index data
@@ -638,6 +1134,7 @@ TEST(FaissQueryIndexWithFilterTest1435, BasicAssertions) {
             test_util::FaissCreateIndex(dim, method, metricType));
     auto createdIndexWithData =
             test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
 
     // Setup jni
     NiceMock<JNIEnv> jniEnv;
@@ -653,7 +1150,7 @@ TEST(FaissQueryIndexWithFilterTest1435, BasicAssertions) {
                 reinterpret_cast<std::vector<std::pair<int, float> *> *>(
                         knn_jni::faiss_wrapper::QueryIndex_WithFilter(
                                 &mockJNIUtil, &jniEnv,
-                                reinterpret_cast<jlong>(&createdIndexWithData),
+                                reinterpret_cast<jlong>(&indexHandle),
                                 reinterpret_cast<jfloatArray>(&query), k, nullptr,
                                 reinterpret_cast<jlongArray>(&bitmap), 0, nullptr)));
 
@@ -711,6 +1208,7 @@ TEST(FaissQueryIndexWithParentFilterTest, BasicAssertions) {
             test_util::FaissCreateIndex(dim, method, metricType));
     auto createdIndexWithData =
             test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
 
     int efSearch = 100;
     std::unordered_map<std::string, jobject> methodParams;
@@ -728,7 +1226,7 @@ TEST(FaissQueryIndexWithParentFilterTest, BasicAssertions) {
                 reinterpret_cast<std::vector<std::pair<int, float> *> *>(
                         knn_jni::faiss_wrapper::QueryIndex(
                                 &mockJNIUtil, &jniEnv,
-                                reinterpret_cast<jlong>(&createdIndexWithData),
+                                reinterpret_cast<jlong>(&indexHandle),
                                 reinterpret_cast<jfloatArray>(&query), k, reinterpret_cast<jobject>(&methodParams),
                                 reinterpret_cast<jintArray>(&parentIds))));
 
@@ -789,6 +1287,7 @@ TEST(FaissQueryIndexHNSWCagraWithParentFilterTest, BasicAssertions) {
     auto createdIndexWithData =
             test_util::FaissAddData(createdIndex.get(), ids, vectors);
     dynamic_cast<faiss::IndexHNSWCagra*>(createdIndexWithData.index)->base_level_only=true;
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
 
     int efSearch = 100;
     std::unordered_map<std::string, jobject> methodParams;
@@ -806,7 +1305,7 @@ TEST(FaissQueryIndexHNSWCagraWithParentFilterTest, BasicAssertions) {
                 reinterpret_cast<std::vector<std::pair<int, float> *> *>(
                         knn_jni::faiss_wrapper::QueryIndex(
                                 &mockJNIUtil, &jniEnv,
-                                reinterpret_cast<jlong>(&createdIndexWithData),
+                                reinterpret_cast<jlong>(&indexHandle),
                                 reinterpret_cast<jfloatArray>(&query), k, reinterpret_cast<jobject>(&methodParams),
                                 reinterpret_cast<jintArray>(&parentIds))));
 
@@ -837,7 +1336,8 @@ TEST(FaissFreeTest, BasicAssertions) {
             test_util::FaissCreateIndex(dim, method, metricType));
 
     // Free created index --> memory check should catch failure
-    knn_jni::faiss_wrapper::Free(reinterpret_cast<jlong>(createdIndex), JNI_FALSE);
+    knn_jni::faiss_wrapper::Free(reinterpret_cast<jlong>(new knn_jni::faiss_wrapper::NativeIndexHandle(createdIndex)),
+                                 JNI_FALSE);
 }
 
 
@@ -851,7 +1351,152 @@ TEST(FaissBinaryFreeTest, BasicAssertions) {
             test_util::FaissCreateBinaryIndex(dim, method));
 
     // Free created index --> memory check should catch failure
-    knn_jni::faiss_wrapper::Free(reinterpret_cast<jlong>(createdIndex), JNI_TRUE);
+    knn_jni::faiss_wrapper::Free(reinterpret_cast<jlong>(new knn_jni::faiss_wrapper::NativeIndexHandle(createdIndex)),
+                                 JNI_TRUE);
+}
+
+TEST(FaissWarmIndexTest, BasicAssertions) {
+    faiss::idx_t numIds = 200;
+    int dim = 16;
+    std::vector<faiss::idx_t> ids = test_util::Range(numIds);
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, randomDataMin, randomDataMax);
+
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW32,Flat", faiss::METRIC_L2));
+    auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+
+    // The graph, the vectors and the id map are warmed up
+    const auto * hnswIndex = dynamic_cast<faiss::IndexHNSW *>(createdIndex.get());
+    ASSERT_NE(nullptr, hnswIndex);
+    const int64_t minBytes = numIds * dim * sizeof(float) + hnswIndex->hnsw.neighbors.size() * sizeof(int32_t)
+                             + numIds * sizeof(faiss::idx_t);
+
+    for (auto mode : {knn_jni::faiss_wrapper::WarmupMode::ADVISE, knn_jni::faiss_wrapper::WarmupMode::TOUCH,
+                      knn_jni::faiss_wrapper::WarmupMode::QUERY}) {
+        const auto stats = knn_jni::faiss_wrapper::WarmIndex(reinterpret_cast<jlong>(&indexHandle), mode);
+        ASSERT_GE(stats.bytes, minBytes);
+        ASSERT_GE(stats.elapsedNanos, 0);
+    }
+
+    ASSERT_THROW(knn_jni::faiss_wrapper::WarmIndex(0, knn_jni::faiss_wrapper::WarmupMode::TOUCH), std::runtime_error);
+}
+
+TEST(FaissWarmBinaryIndexTest, BasicAssertions) {
+    faiss::idx_t numIds = 200;
+    int dim = 64;
+    std::vector<faiss::idx_t> ids = test_util::Range(numIds);
+    std::vector<uint8_t> vectors;
+    for (int64_t i = 0; i < numIds * (dim / 8); ++i) {
+        vectors.push_back(test_util::RandomInt(0, 255));
+    }
+
+    std::unique_ptr<faiss::IndexBinary> createdIndex(test_util::FaissCreateBinaryIndex(dim, "BHNSW32"));
+    auto createdIndexWithData = test_util::FaissAddBinaryData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+
+    const auto stats = knn_jni::faiss_wrapper::WarmIndex(reinterpret_cast<jlong>(&indexHandle),
+                                                         knn_jni::faiss_wrapper::WarmupMode::QUERY);
+    ASSERT_GE(stats.bytes, numIds * (dim / 8));
+}
+
+TEST(FaissIndexMemoryUsageTest, BasicAssertions) {
+    faiss::idx_t numIds = 200;
+    int dim = 16;
+    std::vector<faiss::idx_t> ids = test_util::Range(numIds);
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, randomDataMin, randomDataMax);
+
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW32,Flat", faiss::METRIC_L2));
+    auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+
+    const auto usage = knn_jni::faiss_wrapper::GetIndexMemoryUsage(reinterpret_cast<jlong>(&indexHandle));
+    const auto * hnswIndex = dynamic_cast<faiss::IndexHNSW *>(createdIndex.get());
+    ASSERT_NE(nullptr, hnswIndex);
+    ASSERT_GE(usage.codes, (int64_t) (numIds * dim * sizeof(float)));
+    ASSERT_GE(usage.neighbors, (int64_t) (hnswIndex->hnsw.neighbors.size() * sizeof(int32_t)));
+    ASSERT_GE(usage.levels, (int64_t) (numIds * sizeof(int)));
+    ASSERT_GE(usage.offsets, (int64_t) (numIds * sizeof(size_t)));
+    ASSERT_GE(usage.idMap, (int64_t) (numIds * sizeof(faiss::idx_t)));
+    ASSERT_EQ(0, usage.quantizer);
+    ASSERT_EQ(0, usage.sharedState);
+    ASSERT_GE(usage.other, (int64_t) sizeof(knn_jni::faiss_wrapper::NativeIndexHandle));
+
+    ASSERT_THROW(knn_jni::faiss_wrapper::GetIndexMemoryUsage(0), std::runtime_error);
+}
+
+TEST(FaissPlaceIndexTest, BasicAssertions) {
+    faiss::idx_t numIds = 200;
+    int dim = 16;
+    std::vector<faiss::idx_t> ids = test_util::Range(numIds);
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, randomDataMin, randomDataMax);
+
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW32,Flat", faiss::METRIC_L2));
+    auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+    const auto indexPointer = reinterpret_cast<jlong>(&indexHandle);
+
+    ASSERT_EQ(-1, knn_jni::faiss_wrapper::GetIndexNumaNode(indexPointer));
+    const jint node = knn_jni::faiss_wrapper::PlaceIndex(indexPointer, 0);
+    ASSERT_EQ(node, knn_jni::faiss_wrapper::GetIndexNumaNode(indexPointer));
+
+    // Nothing is moved on single node hosts, so the index is never bound
+    if (knn_jni::faiss_wrapper::GetNumaNodeCount() == 1) {
+        ASSERT_EQ(-1, node);
+        ASSERT_EQ(-1, knn_jni::faiss_wrapper::PlaceIndex(indexPointer, -1));
+    }
+
+    ASSERT_THROW(knn_jni::faiss_wrapper::PlaceIndex(0, 0), std::runtime_error);
+    ASSERT_THROW(knn_jni::faiss_wrapper::GetIndexNumaNode(0), std::runtime_error);
+}
+
+TEST(FaissIndexArenaTest, BasicAssertions) {
+    faiss::idx_t numIds = 200;
+    int dim = 16;
+    std::vector<faiss::idx_t> ids = test_util::Range(numIds);
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, randomDataMin, randomDataMax);
+
+    std::string indexPath = test_util::RandomString(10, "tmp/", ".faiss");
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW32,Flat", faiss::METRIC_L2));
+    auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    test_util::FaissWriteIndex(&createdIndexWithData, indexPath);
+
+    NiceMock<JNIEnv> jniEnv;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    // Indexes are loaded on the heap by default
+    jlong indexPointer = knn_jni::faiss_wrapper::LoadIndex(&mockJNIUtil, &jniEnv, (jstring) &indexPath);
+    auto * indexHandle = reinterpret_cast<knn_jni::faiss_wrapper::NativeIndexHandle *>(indexPointer);
+    ASSERT_EQ(nullptr, indexHandle->arena);
+    ASSERT_EQ(0, knn_jni::faiss_wrapper::GetIndexArenaStats(indexPointer).mappedBytes);
+    knn_jni::faiss_wrapper::Free(indexPointer, false);
+
+    knn_jni::faiss_wrapper::ConfigureIndexArenas(true);
+    indexPointer = knn_jni::faiss_wrapper::LoadIndex(&mockJNIUtil, &jniEnv, (jstring) &indexPath);
+    knn_jni::faiss_wrapper::ConfigureIndexArenas(false);
+    indexHandle = reinterpret_cast<knn_jni::faiss_wrapper::NativeIndexHandle *>(indexPointer);
+#if defined(__linux__) && defined(KNN_INDEX_ARENAS)
+    ASSERT_NE(nullptr, indexHandle->arena);
+    ASSERT_FALSE(knn_jni::memory::IndexArena::owns(indexHandle));
+    ASSERT_TRUE(knn_jni::memory::IndexArena::owns(indexHandle->index));
+    ASSERT_TRUE(knn_jni::memory::IndexArena::owns(indexHandle->hnsw->hnsw.neighbors.data()));
+
+    const auto stats = knn_jni::faiss_wrapper::GetIndexArenaStats(indexPointer);
+    ASSERT_GE(stats.liveBytes, (int64_t) (numIds * dim * sizeof(float)));
+    ASSERT_GE(stats.mappedBytes, stats.liveBytes);
+    ASSERT_GT(stats.liveAllocations, 0);
+    ASSERT_GT(stats.chunks, 0);
+#else
+    ASSERT_EQ(nullptr, indexHandle->arena);
+#endif
+
+    // The index read into the arena is the same as the one written
+    auto createdSerialization = test_util::FaissGetSerializedIndex(&createdIndexWithData);
+    auto loadedSerialization = test_util::FaissGetSerializedIndex(indexHandle->index);
+    ASSERT_EQ(createdSerialization.data, loadedSerialization.data);
+
+    knn_jni::faiss_wrapper::Free(indexPointer, false);
+    ASSERT_THROW(knn_jni::faiss_wrapper::GetIndexArenaStats(0), std::runtime_error);
+    std::remove(indexPath.c_str());
 }
 
 TEST(FaissInitLibraryTest, BasicAssertions) {
@@ -870,7 +1515,9 @@ TEST(FaissTrainIndexTest, BasicAssertions) {
 
     // Define training data
     int numTrainingVectors = 256;
-    std::vector<float> trainingVectors = test_util::RandomVectors(dim, numTrainingVectors, randomDataMin, randomDataMax);
+    std::vector<float> randomVectors = test_util::RandomVectors(dim, numTrainingVectors, randomDataMin, randomDataMax);
+    knn_jni::memory::VectorBuffer<float> trainingVectors;
+    trainingVectors.append(randomVectors.data(), randomVectors.size());
 
     // Setup jni
     NiceMock<JNIEnv> jniEnv;
@@ -902,7 +1549,9 @@ TEST(FaissTrainByteIndexTest, BasicAssertions) {
 
     // Define training data
     int numTrainingVectors = 256;
-    std::vector<int8_t> trainingVectors = test_util::RandomByteVectors(dim, numTrainingVectors, -128, 127);
+    std::vector<int8_t> randomVectors = test_util::RandomByteVectors(dim, numTrainingVectors, -128, 127);
+    knn_jni::memory::VectorBuffer<int8_t> trainingVectors;
+    trainingVectors.append(randomVectors.data(), randomVectors.size());
 
     // Setup jni
     NiceMock<JNIEnv> jniEnv;
@@ -1028,15 +1677,20 @@ TEST(FaissIsSharedIndexStateRequired, BasicAssertions) {
                         faiss::METRIC_INNER_PRODUCT
                 )
             ));
+    knn_jni::faiss_wrapper::NativeIndexHandle handleHNSWL2(indexHNSWL2.get());
+    knn_jni::faiss_wrapper::NativeIndexHandle handleIVFPQIP(indexIVFPQIP.get());
+    knn_jni::faiss_wrapper::NativeIndexHandle handleIVFPQL2(indexIVFPQL2.get());
+    knn_jni::faiss_wrapper::NativeIndexHandle handleIDMapIVFPQL2(indexIDMapIVFPQL2.get());
+    knn_jni::faiss_wrapper::NativeIndexHandle handleIDMapIVFPQIP(indexIDMapIVFPQIP.get());
     jlong nullAddress = 0;
 
-    ASSERT_FALSE(knn_jni::faiss_wrapper::IsSharedIndexStateRequired((jlong) indexHNSWL2.get()));
-    ASSERT_FALSE(knn_jni::faiss_wrapper::IsSharedIndexStateRequired((jlong) indexIVFPQIP.get()));
-    ASSERT_FALSE(knn_jni::faiss_wrapper::IsSharedIndexStateRequired((jlong) indexIDMapIVFPQIP.get()));
+    ASSERT_FALSE(knn_jni::faiss_wrapper::IsSharedIndexStateRequired((jlong) &handleHNSWL2));
+    ASSERT_FALSE(knn_jni::faiss_wrapper::IsSharedIndexStateRequired((jlong) &handleIVFPQIP));
+    ASSERT_FALSE(knn_jni::faiss_wrapper::IsSharedIndexStateRequired((jlong) &handleIDMapIVFPQIP));
     ASSERT_FALSE(knn_jni::faiss_wrapper::IsSharedIndexStateRequired((jlong) nullAddress));
 
-    ASSERT_TRUE(knn_jni::faiss_wrapper::IsSharedIndexStateRequired((jlong) indexIVFPQL2.get()));
-    ASSERT_TRUE(knn_jni::faiss_wrapper::IsSharedIndexStateRequired((jlong) indexIDMapIVFPQL2.get()));
+    ASSERT_TRUE(knn_jni::faiss_wrapper::IsSharedIndexStateRequired((jlong) &handleIVFPQL2));
+    ASSERT_TRUE(knn_jni::faiss_wrapper::IsSharedIndexStateRequired((jlong) &handleIDMapIVFPQL2));
 }
 
 TEST(FaissInitAndSetSharedIndexState, BasicAssertions) {
@@ -1058,21 +1712,28 @@ TEST(FaissInitAndSetSharedIndexState, BasicAssertions) {
     NiceMock<JNIEnv> jniEnv;
     NiceMock<test_util::MockJNIUtil> mockJNIUtil;
 
-    std::unique_ptr<faiss::Index> loadedIndexPointer(
-            reinterpret_cast<faiss::Index *>(knn_jni::faiss_wrapper::LoadIndex(
+    std::unique_ptr<knn_jni::faiss_wrapper::NativeIndexHandle> loadedIndexHandle(
+            reinterpret_cast<knn_jni::faiss_wrapper::NativeIndexHandle *>(knn_jni::faiss_wrapper::LoadIndex(
                     &mockJNIUtil, &jniEnv, (jstring)&indexPath)));
+    std::unique_ptr<faiss::Index> loadedIndexPointer(loadedIndexHandle->index);
 
     auto idMapIndex = dynamic_cast<faiss::IndexIDMap *>(loadedIndexPointer.get());
     ASSERT_NE(idMapIndex, nullptr);
     auto ivfpqIndex = dynamic_cast<faiss::IndexIVFPQ *>(idMapIndex->index);
     ASSERT_NE(ivfpqIndex, nullptr);
     ASSERT_EQ(0, ivfpqIndex->precomputed_table->size());
-    jlong sharedModelAddress = knn_jni::faiss_wrapper::InitSharedIndexState((jlong) loadedIndexPointer.get());
+    jlong sharedModelAddress = knn_jni::faiss_wrapper::InitSharedIndexState((jlong) loadedIndexHandle.get());
     ASSERT_EQ(0, ivfpqIndex->precomputed_table->size());
-    knn_jni::faiss_wrapper::SetSharedIndexState((jlong) loadedIndexPointer.get(), sharedModelAddress);
+    knn_jni::faiss_wrapper::SetSharedIndexState((jlong) loadedIndexHandle.get(), sharedModelAddress);
     ASSERT_EQ(sharedModelAddress, (jlong) ivfpqIndex->precomputed_table);
     ASSERT_NE(0, ivfpqIndex->precomputed_table->size());
     ASSERT_EQ(1, ivfpqIndex->use_precomputed_table);
+
+    // The shared table is reported apart from the memory of the index
+    const auto usage = knn_jni::faiss_wrapper::GetIndexMemoryUsage((jlong) loadedIndexHandle.get());
+    ASSERT_EQ((int64_t) (ivfpqIndex->precomputed_table->size() * sizeof(float)), usage.sharedState);
+    ASSERT_GE(usage.idMap, (int64_t) (2 * numIds * sizeof(faiss::idx_t)));
+    ASSERT_GT(usage.quantizer, 0);
     knn_jni::faiss_wrapper::FreeSharedIndexState(sharedModelAddress);
 }
 
@@ -1109,6 +1770,7 @@ TEST(FaissRangeSearchQueryIndexTest, BasicAssertions) {
             test_util::FaissCreateIndex(dim, method, metricType));
     auto createdIndexWithData =
             test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
 
     // Setup jni
     NiceMock<JNIEnv> jniEnv;
@@ -1122,7 +1784,7 @@ TEST(FaissRangeSearchQueryIndexTest, BasicAssertions) {
 
                         knn_jni::faiss_wrapper::RangeSearch(
                                 &mockJNIUtil, &jniEnv,
-                                reinterpret_cast<jlong>(&createdIndexWithData),
+                                reinterpret_cast<jlong>(&indexHandle),
                                 reinterpret_cast<jfloatArray>(&query), rangeSearchRadius, methodParamsJ, maxResultWindow, nullptr)));
 
         // assert result size is not 0
@@ -1164,6 +1826,7 @@ TEST(FaissRangeSearchQueryIndexTest_WhenHitMaxWindowResult, BasicAssertions){
             test_util::FaissCreateIndex(dim, method, metricType));
     auto createdIndexWithData =
             test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
 
     // Setup jni
     NiceMock<JNIEnv> jniEnv;
@@ -1177,7 +1840,7 @@ TEST(FaissRangeSearchQueryIndexTest_WhenHitMaxWindowResult, BasicAssertions){
 
                         knn_jni::faiss_wrapper::RangeSearch(
                                 &mockJNIUtil, &jniEnv,
-                                reinterpret_cast<jlong>(&createdIndexWithData),
+                                reinterpret_cast<jlong>(&indexHandle),
                                 reinterpret_cast<jfloatArray>(&query), rangeSearchRadius, nullptr, maxResultWindow, nullptr)));
 
         // assert result size is not 0
@@ -1192,6 +1855,192 @@ TEST(FaissRangeSearchQueryIndexTest_WhenHitMaxWindowResult, BasicAssertions){
     }
 }
 
+TEST(FaissRangeSearchQueryIndexTest_WhenHitMaxWindowResultKeepsScanOrder, BasicAssertions) {
+    // Define the index data
+    faiss::idx_t numIds = 200;
+    int dim = 2;
+    std::vector<faiss::idx_t> ids = test_util::Range(numIds);
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, rangeSearchRandomDataMin, rangeSearchRandomDataMax);
+
+    faiss::MetricType metricType = faiss::METRIC_L2;
+    std::string method = "Flat";
+
+    // Create the index
+    std::unique_ptr<faiss::Index> createdIndex(
+            test_util::FaissCreateIndex(dim, method, metricType));
+    auto createdIndexWithData =
+            test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+
+    // Setup jni
+    NiceMock<JNIEnv> jniEnv;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    int maxResultWindow = 10;
+    std::vector<float> query = {0, 0};
+
+    // Every vector is within the radius, so the window must hold the first ones, as the range search of Faiss returns
+    std::unique_ptr<std::vector<std::pair<int, float> *>> results(
+            reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+                    knn_jni::faiss_wrapper::RangeSearch(
+                            &mockJNIUtil, &jniEnv,
+                            reinterpret_cast<jlong>(&indexHandle),
+                            reinterpret_cast<jfloatArray>(&query), rangeSearchRadius, nullptr, maxResultWindow, nullptr)));
+
+    ASSERT_EQ(maxResultWindow, results->size());
+    for (int i = 0; i < maxResultWindow; i++) {
+        float distance = vectors[i * dim] * vectors[i * dim] + vectors[i * dim + 1] * vectors[i * dim + 1];
+        ASSERT_EQ(i, results->at(i)->first);
+        ASSERT_NEAR(distance, results->at(i)->second, 1e-3);
+    }
+
+    // Need to free up each result
+    for (auto it : *results) {
+        delete it;
+    }
+}
+
+TEST(FaissRangeSearchQueryIndexTest_WhenHitMaxWindowResultKeepsClosestOfGraphSearch, BasicAssertions) {
+    // Define the index data
+    faiss::idx_t numIds = 200;
+    int dim = 2;
+    std::vector<faiss::idx_t> ids = test_util::Range(numIds);
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, rangeSearchRandomDataMin, rangeSearchRandomDataMax);
+
+    for (auto metricType : {faiss::METRIC_L2, faiss::METRIC_INNER_PRODUCT}) {
+        std::string method = "HNSW32,Flat";
+
+        // Create the index
+        std::unique_ptr<faiss::Index> createdIndex(
+                test_util::FaissCreateIndex(dim, method, metricType));
+        auto createdIndexWithData =
+                test_util::FaissAddData(createdIndex.get(), ids, vectors);
+        knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+
+        // Setup jni
+        NiceMock<JNIEnv> jniEnv;
+        NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+        int maxResultWindow = 10;
+        std::vector<float> query = {1, 1};
+        float radius = metricType == faiss::METRIC_L2 ? rangeSearchRadius : -rangeSearchRadius;
+
+        // The graph search of Faiss visits the same nodes, the window must hold the closest of the hits it returns
+        faiss::RangeSearchResult expectedResult(1, true);
+        createdIndexWithData.range_search(1, query.data(), radius, &expectedResult);
+        std::vector<std::pair<float, int>> expected;
+        for (size_t i = 0; i < expectedResult.lims[1]; i++) {
+            float distance = expectedResult.distances[i];
+            expected.emplace_back(metricType == faiss::METRIC_L2 ? distance : -distance, expectedResult.labels[i]);
+        }
+        std::sort(expected.begin(), expected.end());
+        ASSERT_LT(maxResultWindow, expected.size());
+
+        std::unique_ptr<std::vector<std::pair<int, float> *>> results(
+                reinterpret_cast<std::vector<std::pair<int, float> *> *>(
+                        knn_jni::faiss_wrapper::RangeSearch(
+                                &mockJNIUtil, &jniEnv,
+                                reinterpret_cast<jlong>(&indexHandle),
+                                reinterpret_cast<jfloatArray>(&query), radius, nullptr, maxResultWindow, nullptr)));
+
+        ASSERT_EQ(maxResultWindow, results->size());
+        for (int i = 0; i < maxResultWindow; i++) {
+            ASSERT_EQ(expected[i].second, results->at(i)->first);
+            float distance = metricType == faiss::METRIC_L2 ? expected[i].first : -expected[i].first;
+            ASSERT_NEAR(distance, results->at(i)->second, 1e-3);
+        }
+
+        // Need to free up each result
+        for (auto it : *results) {
+            delete it;
+        }
+    }
+}
+
+TEST(FaissRangeSearchQueryIndexTest_WhenMaxResultWindowIsZero_ThenThrows, BasicAssertions) {
+    faiss::idx_t numIds = 10;
+    int dim = 2;
+    std::vector<faiss::idx_t> ids = test_util::Range(numIds);
+    std::vector<float> vectors = test_util::RandomVectors(dim, numIds, rangeSearchRandomDataMin, rangeSearchRandomDataMax);
+
+    std::unique_ptr<faiss::Index> createdIndex(test_util::FaissCreateIndex(dim, "HNSW32,Flat", faiss::METRIC_L2));
+    auto createdIndexWithData = test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+
+    NiceMock<JNIEnv> jniEnv;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+    std::vector<float> query = {0, 0};
+
+    ASSERT_THROW(knn_jni::faiss_wrapper::RangeSearch(&mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle),
+                                                     reinterpret_cast<jfloatArray>(&query), rangeSearchRadius, nullptr,
+                                                     0, nullptr),
+                 std::runtime_error);
+}
+
+TEST(FaissRangeSearchBinaryIndexTest, BasicAssertions) {
+    // Define the data
+    faiss::idx_t numIds = 200;
+    int dim = 128;
+    std::vector<faiss::idx_t> ids;
+    std::vector<uint8_t> vectors;
+    for (int64_t i = 0; i < numIds; ++i) {
+        ids.push_back(i);
+        for (int j = 0; j < dim / 8; ++j) {
+            vectors.push_back(test_util::RandomInt(0, 255));
+        }
+    }
+
+    std::vector<uint8_t> query;
+    for (int j = 0; j < dim / 8; j++) {
+        query.push_back(test_util::RandomInt(0, 255));
+    }
+
+    // Create the index
+    std::string method = "BHNSW32";
+    std::unique_ptr<faiss::IndexBinary> createdIndex(
+            test_util::FaissCreateBinaryIndex(dim, method));
+    auto createdIndexWithData =
+            test_util::FaissAddBinaryData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
+
+    // Setup jni
+    NiceMock<JNIEnv> jniEnv;
+    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+
+    int maxResultWindow = 10;
+
+    // Every vector is within a radius of the dimension, so the window is filled closest first
+    std::vector<int> resultIds;
+    std::vector<float> resultDistances;
+    int resultSize = knn_jni::faiss_wrapper::RangeSearchBinaryIndex_WithFilterBuffer(
+            &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle),
+            reinterpret_cast<jbyteArray>(&query), dim, 0, maxResultWindow, nullptr, 0, nullptr,
+            reinterpret_cast<jintArray>(&resultIds), reinterpret_cast<jfloatArray>(&resultDistances));
+    ASSERT_EQ(maxResultWindow, resultSize);
+    for (int i = 1; i < resultSize; i++) {
+        ASSERT_LE(resultDistances[i - 1], resultDistances[i]);
+    }
+
+    // The radius is the largest hamming distance kept
+    float radius = resultDistances[maxResultWindow / 2];
+    std::vector<int> radiusResultIds;
+    std::vector<float> radiusResultDistances;
+    int radiusResultSize = knn_jni::faiss_wrapper::RangeSearchBinaryIndex_WithFilterBuffer(
+            &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle),
+            reinterpret_cast<jbyteArray>(&query), radius, 0, maxResultWindow, nullptr, 0, nullptr,
+            reinterpret_cast<jintArray>(&radiusResultIds), reinterpret_cast<jfloatArray>(&radiusResultDistances));
+    ASSERT_LT(maxResultWindow / 2, radiusResultSize);
+    for (int i = 0; i < radiusResultSize; i++) {
+        ASSERT_LE(radiusResultDistances[i], radius);
+    }
+
+    // No vector is within a negative radius
+    ASSERT_EQ(0, knn_jni::faiss_wrapper::RangeSearchBinaryIndex_WithFilterBuffer(
+            &mockJNIUtil, &jniEnv, reinterpret_cast<jlong>(&indexHandle),
+            reinterpret_cast<jbyteArray>(&query), -1, 0, maxResultWindow, nullptr, 0, nullptr,
+            reinterpret_cast<jintArray>(&radiusResultIds), reinterpret_cast<jfloatArray>(&radiusResultDistances)));
+}
+
 TEST(FaissRangeSearchQueryIndexTestWithFilterTest, BasicAssertions) {
     // Define the index data
     faiss::idx_t numIds = 200;
@@ -1220,6 +2069,7 @@ TEST(FaissRangeSearchQueryIndexTestWithFilterTest, BasicAssertions) {
             test_util::FaissCreateIndex(dim, method, metricType));
     auto createdIndexWithData =
             test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
 
     // Setup jni
     NiceMock<JNIEnv> jniEnv;
@@ -1243,7 +2093,7 @@ TEST(FaissRangeSearchQueryIndexTestWithFilterTest, BasicAssertions) {
 
                         knn_jni::faiss_wrapper::RangeSearchWithFilter(
                                 &mockJNIUtil, &jniEnv,
-                                reinterpret_cast<jlong>(&createdIndexWithData),
+                                reinterpret_cast<jlong>(&indexHandle),
                                 reinterpret_cast<jfloatArray>(&query), rangeSearchRadius, nullptr, maxResultWindow,
                                 reinterpret_cast<jlongArray>(&bitmap), 0, nullptr)));
 
@@ -1281,44 +2131,50 @@ TEST(FaissRangeSearchQueryIndexTestWithParentFilterTest, BasicAssertions) {
     }
 
     faiss::MetricType metricType = faiss::METRIC_L2;
-    std::string method = "HNSW32,Flat";
 
     // Define query data
-    int numQueries = 1;
-    std::vector<std::vector<float>> queries;
+    std::vector<float> query;
+    for (int j = 0; j < dim; j++) {
+        query.push_back(test_util::RandomFloat(rangeSearchRandomDataMin, rangeSearchRandomDataMax));
+    }
 
-    for (int i = 0; i < numQueries; i++) {
-        std::vector<float> query;
-        query.reserve(dim);
+    // Closest vector of each parent
+    std::map<int, std::pair<float, int>> closestOfGroup;
+    for (size_t i = 0; i < ids.size(); i++) {
+        float distance = 0;
         for (int j = 0; j < dim; j++) {
-            query.push_back(test_util::RandomFloat(rangeSearchRandomDataMin, rangeSearchRandomDataMax));
+            distance += (vectors[i * dim + j] - query[j]) * (vectors[i * dim + j] - query[j]);
+        }
+        auto closest = closestOfGroup.find(ids[i] / 10);
+        if (closest == closestOfGroup.end() || distance < closest->second.first) {
+            closestOfGroup[ids[i] / 10] = {distance, ids[i]};
         }
-        queries.push_back(query);
     }
 
-    // Create the index
-    std::unique_ptr<faiss::Index> createdIndex(
-            test_util::FaissCreateIndex(dim, method, metricType));
-    auto createdIndexWithData =
-            test_util::FaissAddData(createdIndex.get(), ids, vectors);
+    for (std::string method : {"HNSW32,Flat", "Flat"}) {
+        // Create the index
+        std::unique_ptr<faiss::Index> createdIndex(
+                test_util::FaissCreateIndex(dim, method, metricType));
+        auto createdIndexWithData =
+                test_util::FaissAddData(createdIndex.get(), ids, vectors);
+        knn_jni::faiss_wrapper::NativeIndexHandle indexHandle(&createdIndexWithData);
 
-    // Setup jni
-    NiceMock<JNIEnv> jniEnv;
-    NiceMock<test_util::MockJNIUtil> mockJNIUtil;
-    EXPECT_CALL(mockJNIUtil,
-                GetJavaIntArrayLength(
-                        &jniEnv, reinterpret_cast<jintArray>(&parentIds)))
-            .WillRepeatedly(Return(parentIds.size()));
+        // Setup jni
+        NiceMock<JNIEnv> jniEnv;
+        NiceMock<test_util::MockJNIUtil> mockJNIUtil;
+        EXPECT_CALL(mockJNIUtil,
+                    GetJavaIntArrayLength(
+                            &jniEnv, reinterpret_cast<jintArray>(&parentIds)))
+                .WillRepeatedly(Return(parentIds.size()));
 
-    int maxResultWindow = 10000;
+        int maxResultWindow = 10000;
 
-    for (auto query : queries) {
         std::unique_ptr<std::vector<std::pair<int, float> *>> results(
                 reinterpret_cast<std::vector<std::pair<int, float> *> *>(
 
                         knn_jni::faiss_wrapper::RangeSearchWithFilter(
                                 &mockJNIUtil, &jniEnv,
-                                reinterpret_cast<jlong>(&createdIndexWithData),
+                                reinterpret_cast<jlong>(&indexHandle),
                                 reinterpret_cast<jfloatArray>(&query), rangeSearchRadius, nullptr, maxResultWindow, nullptr, 0,
                                 reinterpret_cast<jintArray>(&parentIds))));
 
@@ -1329,7 +2185,15 @@ TEST(FaissRangeSearchQueryIndexTestWithParentFilterTest, BasicAssertions) {
         for (const auto& pairPtr : *results) {
             idSet.insert(pairPtr->first / 10);
         }
-        ASSERT_NE(0, idSet.size());
+        ASSERT_EQ(results->size(), idSet.size());
+
+        // Every vector is within the radius, so a scan finds the closest vector of every group
+        if (method == "Flat") {
+            ASSERT_EQ(closestOfGroup.size(), results->size());
+            for (const auto& pairPtr : *results) {
+                ASSERT_EQ(closestOfGroup[pairPtr->first / 10].second, pairPtr->first);
+            }
+        }
 
         // Need to free up each result
         for (auto it : *results) {
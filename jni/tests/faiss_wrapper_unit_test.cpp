@@ -11,6 +11,7 @@
 
 #include "faiss_wrapper.h"
 
+#include <memory>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -148,33 +149,39 @@ class FaissWrapperParameterizedTestFixture : public testing::TestWithParam<Query
 public:
     FaissWrapperParameterizedTestFixture() : index_(3), id_map_(&index_) {
         index_.hnsw.efSearch = 100; // assigning 100 to make sure default of 16 is not used anywhere
+        index_handle_ = std::make_unique<knn_jni::faiss_wrapper::NativeIndexHandle>(&id_map_);
     }
 
 protected:
     FaissMockIndex index_;
     FaissMockIdMap id_map_;
+    std::unique_ptr<knn_jni::faiss_wrapper::NativeIndexHandle> index_handle_;
 };
 
 class FaissWrapperParameterizedRangeSearchTestFixture : public testing::TestWithParam<RangeSearchTestInput> {
 public:
     FaissWrapperParameterizedRangeSearchTestFixture() : index_(3), id_map_(&index_) {
         index_.hnsw.efSearch = 100; // assigning 100 to make sure default of 16 is not used anywhere
+        index_handle_ = std::make_unique<knn_jni::faiss_wrapper::NativeIndexHandle>(&id_map_);
     }
 
 protected:
     FaissMockIndex index_;
     FaissMockIdMap id_map_;
+    std::unique_ptr<knn_jni::faiss_wrapper::NativeIndexHandle> index_handle_;
 };
 
 class FaissWrapperIVFQueryTestFixture : public testing::TestWithParam<QueryIndexInput> {
 public:
     FaissWrapperIVFQueryTestFixture() : ivf_id_map_(&ivf_index_) {
         ivf_index_.nprobe = 100;
+        index_handle_ = std::make_unique<knn_jni::faiss_wrapper::NativeIndexHandle>(&ivf_id_map_);
     };
 
 protected:
     MockIVFIndex ivf_index_;
     MockIVFIdMap ivf_id_map_;
+    std::unique_ptr<knn_jni::faiss_wrapper::NativeIndexHandle> index_handle_;
 };
 
 namespace query_index_test {
@@ -216,7 +223,7 @@ namespace query_index_test {
         // When
         knn_jni::faiss_wrapper::QueryIndex(
             &mockJNIUtil, jniEnv,
-            reinterpret_cast<jlong>(&id_map_),
+            reinterpret_cast<jlong>(index_handle_.get()),
             reinterpret_cast<jfloatArray>(&query), input.k, reinterpret_cast<jobject>(&methodParams),
             reinterpret_cast<jintArray>(parentIdPtr));
 
@@ -293,7 +300,7 @@ namespace query_index_with_filter_test {
         // When
         knn_jni::faiss_wrapper::QueryIndex_WithFilter(
             &mockJNIUtil, jniEnv,
-            reinterpret_cast<jlong>(&id_map_),
+            reinterpret_cast<jlong>(index_handle_.get()),
             reinterpret_cast<jfloatArray>(&query), input.k, reinterpret_cast<jobject>(&methodParams),
             reinterpret_cast<jlongArray>(filterptr),
             input.filterIdType,
@@ -386,7 +393,7 @@ namespace range_search_test {
         // When
         knn_jni::faiss_wrapper::RangeSearchWithFilter(
             &mockJNIUtil, jniEnv,
-            reinterpret_cast<jlong>(&id_map_),
+            reinterpret_cast<jlong>(index_handle_.get()),
             reinterpret_cast<jfloatArray>(&query), radius, reinterpret_cast<jobject>(&methodParams),
             maxResultWindow,
             reinterpret_cast<jlongArray>(filterptr),
@@ -457,7 +464,7 @@ namespace query_index_with_filter_test_ivf {
         // When
         knn_jni::faiss_wrapper::QueryIndex_WithFilter(
             &mockJNIUtil, jniEnv,
-            reinterpret_cast<jlong>(&ivf_id_map_),
+            reinterpret_cast<jlong>(index_handle_.get()),
             reinterpret_cast<jfloatArray>(&query), input.k, reinterpret_cast<jobject>(&methodParams),
             reinterpret_cast<jlongArray>(filterptr),
             input.filterIdType,
@@ -60,7 +60,7 @@ TEST(NmslibStreamLoadingTest, BasicAssertions) {
       // Define index data
       int numIds = 100;
       std::vector<int> ids;
-      auto vectors = new std::vector<float>();
+      auto vectors = std::make_unique<knn_jni::memory::VectorBuffer<float>>();
       int dim = 2;
       vectors->reserve(dim * numIds);
       for (int i = 0; i < numIds; ++i) {
@@ -93,7 +93,7 @@ TEST(NmslibStreamLoadingTest, BasicAssertions) {
 
       EXPECT_CALL(mockJNIUtil,
                   GetJavaObjectArrayLength(
-                      &jniEnv, reinterpret_cast<jobjectArray>(vectors)))
+                      &jniEnv, reinterpret_cast<jobjectArray>(vectors.get())))
           .WillRepeatedly(Return(vectors->size()));
 
       EXPECT_CALL(mockJNIUtil,
@@ -108,7 +108,7 @@ TEST(NmslibStreamLoadingTest, BasicAssertions) {
       try {
           knn_jni::nmslib_wrapper::CreateIndex(
               &mockJNIUtil, &jniEnv, reinterpret_cast<jintArray>(&ids),
-              (jlong) vectors, dim, (jobject) (&javaFileIndexOutputMock),
+              (jlong) vectors.get(), dim, (jobject) (&javaFileIndexOutputMock),
               (jobject) &parametersMap);
           javaFileIndexOutputMock.file_writer.close();
       } catch (const StreamIOError& e) {
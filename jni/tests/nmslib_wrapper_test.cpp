@@ -45,7 +45,7 @@ TEST(NmslibCreateIndexTest, BasicAssertions) {
         // Define index data
         int numIds = 100;
         std::vector<int> ids;
-        auto *vectors = new std::vector<float>();
+        auto vectors = std::make_unique<knn_jni::memory::VectorBuffer<float>>();
         int dim = 2;
         vectors->reserve(dim * numIds);
         for (int64_t i = 0; i < numIds; ++i) {
@@ -85,7 +85,7 @@ TEST(NmslibCreateIndexTest, BasicAssertions) {
         try {
             knn_jni::nmslib_wrapper::CreateIndex(
                 &mockJNIUtil, &jniEnv, reinterpret_cast<jintArray>(&ids),
-                (jlong) vectors, dim, (jobject)(&javaFileIndexOutputMock),
+                (jlong) vectors.get(), dim, (jobject)(&javaFileIndexOutputMock),
                 (jobject)&parametersMap);
         } catch (const StreamIOError& e) {
             ASSERT_TRUE(throwIOException);
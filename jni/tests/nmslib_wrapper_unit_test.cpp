@@ -103,11 +103,11 @@ namespace nmslib_query_index_test {
                     .WillOnce(testing::Return(3));
 
         EXPECT_CALL(mockJNIUtil,
-                    ReleaseFloatArrayElements(
-                        jniEnv, reinterpret_cast<jfloatArray>(query), query, JNI_ABORT));
+                    ReleasePrimitiveArrayCritical(
+                        jniEnv, reinterpret_cast<jfloatArray>(&query), query, JNI_ABORT));
         EXPECT_CALL(mockJNIUtil,
-                    GetFloatArrayElements(
-                        jniEnv, reinterpret_cast<jfloatArray>(query), nullptr))
+                    GetPrimitiveArrayCritical(
+                        jniEnv, reinterpret_cast<jfloatArray>(&query), nullptr))
                 .WillOnce(testing::Return(query));
 
         knn_jni::nmslib_wrapper::QueryIndex(
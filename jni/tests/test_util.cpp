@@ -13,6 +13,7 @@
 
 #include <jni.h>
 
+#include <algorithm>
 #include <random>
 #include <utility>
 
@@ -47,19 +48,19 @@ test_util::MockJNIUtil::MockJNIUtil() {
             });
 
     ON_CALL(*this, Convert2dJavaObjectArrayAndStoreToFloatVector)
-            .WillByDefault([this](JNIEnv *env, jobjectArray array2dJ, int dim, std::vector<float>* data) {
+            .WillByDefault([this](JNIEnv *env, jobjectArray array2dJ, int dim, knn_jni::memory::VectorBuffer<float>* data) {
                 for (const auto &v :
                         (*reinterpret_cast<std::vector<std::vector<float>> *>(array2dJ)))
                     for (auto item : v) data->push_back(item);
             });
     ON_CALL(*this, Convert2dJavaObjectArrayAndStoreToBinaryVector)
-            .WillByDefault([this](JNIEnv *env, jobjectArray array2dJ, int dim, std::vector<uint8_t>* data) {
+            .WillByDefault([this](JNIEnv *env, jobjectArray array2dJ, int dim, knn_jni::memory::VectorBuffer<uint8_t>* data) {
                 for (const auto &v :
                         (*reinterpret_cast<std::vector<std::vector<uint8_t>> *>(array2dJ)))
                     for (auto item : v) data->push_back(item);
             });
     ON_CALL(*this, Convert2dJavaObjectArrayAndStoreToByteVector)
-                .WillByDefault([this](JNIEnv *env, jobjectArray array2dJ, int dim, std::vector<int8_t>* data) {
+                .WillByDefault([this](JNIEnv *env, jobjectArray array2dJ, int dim, knn_jni::memory::VectorBuffer<int8_t>* data) {
                     for (const auto &v :
                             (*reinterpret_cast<std::vector<std::vector<int8_t>> *>(array2dJ)))
                         for (auto item : v) data->push_back(item);
@@ -192,6 +193,28 @@ test_util::MockJNIUtil::MockJNIUtil() {
                 return reinterpret_cast<std::vector<int64_t> *>(arrayJ)->size();
             });
 
+    // array is re-interpreted as a std::vector<uint8_t> * and its data is
+    // returned. The vector layout does not depend on the element type, so this
+    // works for the float and byte query vectors used in the tests
+    ON_CALL(*this, GetPrimitiveArrayCritical)
+            .WillByDefault([this](JNIEnv *env, jarray array, jboolean *isCopy) {
+                return reinterpret_cast<void *>(
+                        reinterpret_cast<std::vector<uint8_t> *>(array)->data());
+            });
+
+    // buf is re-interpreted as a std::vector<jlong> *, standing in for a direct
+    // ByteBuffer of native order longs
+    ON_CALL(*this, GetDirectBufferAddress)
+            .WillByDefault([this](JNIEnv *env, jobject buf) {
+                return reinterpret_cast<void *>(
+                        reinterpret_cast<std::vector<jlong> *>(buf)->data());
+            });
+
+    ON_CALL(*this, GetDirectBufferCapacity)
+            .WillByDefault([this](JNIEnv *env, jobject buf) {
+                return (jlong) (reinterpret_cast<std::vector<jlong> *>(buf)->size() * sizeof(jlong));
+            });
+
     // arrayJ is re-interpreted as a std::vector<std::vector<float>> * and then
     // the 'index' element is re-interpreted as a jobject
     ON_CALL(*this, GetObjectArrayElement)
@@ -206,6 +229,11 @@ test_util::MockJNIUtil::MockJNIUtil() {
         return reinterpret_cast<jbyteArray>(new std::vector<uint8_t>());
     });
 
+    // create a new std::vector<jlong> and re-interpret it as a jlongArray
+    ON_CALL(*this, NewLongArray).WillByDefault([this](JNIEnv *env, jsize len) {
+        return reinterpret_cast<jlongArray>(new std::vector<jlong>(len));
+    });
+
     // Create a new std::pair<int, float> with the id and distance and then
     // re-interpret it as a jobject
     ON_CALL(*this, NewObject)
@@ -255,6 +283,42 @@ test_util::MockJNIUtil::MockJNIUtil() {
                 }
             });
 
+    // array is re-interpreted as a std::vector<int> * and buf is copied into
+    // [start, start + len), growing the vector if needed
+    ON_CALL(*this, SetIntArrayRegion)
+            .WillByDefault([this](JNIEnv *env, jintArray array, jsize start,
+                                  jsize len, const jint *buf) {
+                auto intBuffer = reinterpret_cast<std::vector<int> *>(array);
+                if (intBuffer->size() < static_cast<size_t>(start + len)) {
+                    intBuffer->resize(start + len);
+                }
+                std::copy(buf, buf + len, intBuffer->begin() + start);
+            });
+
+    // array is re-interpreted as a std::vector<jlong> * and buf is copied into
+    // [start, start + len)
+    ON_CALL(*this, SetLongArrayRegion)
+            .WillByDefault([this](JNIEnv *env, jlongArray array, jsize start,
+                                  jsize len, const jlong *buf) {
+                auto longBuffer = reinterpret_cast<std::vector<jlong> *>(array);
+                if (longBuffer->size() < static_cast<size_t>(start + len)) {
+                    longBuffer->resize(start + len);
+                }
+                std::copy(buf, buf + len, longBuffer->begin() + start);
+            });
+
+    // array is re-interpreted as a std::vector<float> * and buf is copied into
+    // [start, start + len), growing the vector if needed
+    ON_CALL(*this, SetFloatArrayRegion)
+            .WillByDefault([this](JNIEnv *env, jfloatArray array, jsize start,
+                                  jsize len, const jfloat *buf) {
+                auto floatBuffer = reinterpret_cast<std::vector<float> *>(array);
+                if (floatBuffer->size() < static_cast<size_t>(start + len)) {
+                    floatBuffer->resize(start + len);
+                }
+                std::copy(buf, buf + len, floatBuffer->begin() + start);
+            });
+
     // array is re-interpreted as a std::vector<std::pair<int, float> *> * and
     // then val is re-interpreted as a std::pair<int, float> * and added to the
     // vector
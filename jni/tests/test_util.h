@@ -46,11 +46,11 @@ namespace test_util {
         MOCK_METHOD(std::vector<float>, Convert2dJavaObjectArrayToCppFloatVector,
                     (JNIEnv * env, jobjectArray array2dJ, int dim));
         MOCK_METHOD(void, Convert2dJavaObjectArrayAndStoreToFloatVector,
-                    (JNIEnv * env, jobjectArray array2dJ, int dim, std::vector<float>*vect));
+                    (JNIEnv * env, jobjectArray array2dJ, int dim, knn_jni::memory::VectorBuffer<float>*vect));
         MOCK_METHOD(void, Convert2dJavaObjectArrayAndStoreToBinaryVector,
-                    (JNIEnv * env, jobjectArray array2dJ, int dim, std::vector<uint8_t>*vect));
+                    (JNIEnv * env, jobjectArray array2dJ, int dim, knn_jni::memory::VectorBuffer<uint8_t>*vect));
         MOCK_METHOD(void, Convert2dJavaObjectArrayAndStoreToByteVector,
-                            (JNIEnv * env, jobjectArray array2dJ, int dim, std::vector<int8_t>*vect));
+                            (JNIEnv * env, jobjectArray array2dJ, int dim, knn_jni::memory::VectorBuffer<int8_t>*vect));
         MOCK_METHOD(std::vector<int64_t>, ConvertJavaIntArrayToCppIntVector,
                     (JNIEnv * env, jintArray arrayJ));
         MOCK_METHOD2(ConvertJavaMapToCppMap,
@@ -87,6 +87,7 @@ namespace test_util {
         MOCK_METHOD(void, HasExceptionInStack,
                     (JNIEnv * env, const char* message));
         MOCK_METHOD(jbyteArray, NewByteArray, (JNIEnv * env, jsize len));
+        MOCK_METHOD(jlongArray, NewLongArray, (JNIEnv * env, jsize len));
         MOCK_METHOD(jobject, NewObject,
                     (JNIEnv * env, jclass clazz, jmethodID methodId, int id,
                             float distance));
@@ -103,6 +104,15 @@ namespace test_util {
         MOCK_METHOD(void, SetByteArrayRegion,
                     (JNIEnv * env, jbyteArray array, jsize start, jsize len,
                             const jbyte* buf));
+        MOCK_METHOD(void, SetIntArrayRegion,
+                    (JNIEnv * env, jintArray array, jsize start, jsize len,
+                            const jint* buf));
+        MOCK_METHOD(void, SetLongArrayRegion,
+                    (JNIEnv * env, jlongArray array, jsize start, jsize len,
+                            const jlong* buf));
+        MOCK_METHOD(void, SetFloatArrayRegion,
+                    (JNIEnv * env, jfloatArray array, jsize start, jsize len,
+                            const jfloat* buf));
         MOCK_METHOD(void, SetObjectArrayElement,
                     (JNIEnv * env, jobjectArray array, jsize index, jobject val));
         MOCK_METHOD(void, ThrowJavaException,
@@ -116,6 +126,8 @@ namespace test_util {
         MOCK_METHOD(jlong, CallNonvirtualLongMethodA, (JNIEnv * env, jobject obj, jclass clazz, jmethodID methodID, jvalue* args));
         MOCK_METHOD(void *, GetPrimitiveArrayCritical, (JNIEnv * env, jarray array, jboolean *isCopy));
         MOCK_METHOD(void, ReleasePrimitiveArrayCritical, (JNIEnv * env, jarray array, void *carray, jint mode));
+        MOCK_METHOD(void *, GetDirectBufferAddress, (JNIEnv * env, jobject buf));
+        MOCK_METHOD(jlong, GetDirectBufferCapacity, (JNIEnv * env, jobject buf));
         MOCK_METHOD(void, CallNonvirtualVoidMethodA, (JNIEnv * env, jobject obj, jclass clazz, jmethodID methodID, jvalue* args));
     };
 
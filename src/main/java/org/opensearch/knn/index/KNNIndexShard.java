@@ -28,10 +28,12 @@ import org.opensearch.knn.index.engine.MemoryOptimizedSearchSupportSpec;
 import org.opensearch.knn.index.engine.qframe.QuantizationConfig;
 import org.opensearch.knn.index.mapper.KNNVectorFieldMapper;
 import org.opensearch.knn.index.mapper.KNNVectorFieldType;
+import org.opensearch.knn.index.memory.NativeIndexWarmupMode;
 import org.opensearch.knn.index.memory.NativeMemoryAllocation;
 import org.opensearch.knn.index.memory.NativeMemoryCacheManager;
 import org.opensearch.knn.index.memory.NativeMemoryEntryContext;
 import org.opensearch.knn.index.memory.NativeMemoryLoadStrategy;
+import org.opensearch.knn.jni.JNIService;
 
 import java.io.IOException;
 import java.util.ArrayList;
@@ -150,6 +152,7 @@ public class KNNIndexShard {
     }
 
     private void warmUpOffHeapIndex(final List<EngineFileContext> engineFileContexts, final Directory directory) {
+        final NativeIndexWarmupMode warmupMode = KNNSettings.getNativeIndexWarmupMode();
         for (final EngineFileContext engineFileContext : engineFileContexts) {
             try {
                 // Get cache key for an off-heap index
@@ -159,7 +162,7 @@ public class KNNIndexShard {
                 );
 
                 // Load an off-heap index
-                nativeMemoryCacheManager.get(
+                final NativeMemoryAllocation allocation = nativeMemoryCacheManager.get(
                     new NativeMemoryEntryContext.IndexEntryContext(
                         directory,
                         cacheKey,
@@ -175,12 +178,47 @@ public class KNNIndexShard {
                     ),
                     true
                 );
+                warmUpNativeIndex(allocation, warmupMode);
             } catch (ExecutionException ex) {
                 throw new RuntimeException(ex);
             }
         }
     }
 
+    /**
+     * Bring a loaded Faiss index into memory, so that the first queries against it do not pay the page faults and cache
+     * misses of a cold index. Best effort, a failure leaves the index loaded as it is.
+     */
+    private void warmUpNativeIndex(final NativeMemoryAllocation allocation, final NativeIndexWarmupMode warmupMode) {
+        if (warmupMode == NativeIndexWarmupMode.NONE || !(allocation instanceof NativeMemoryAllocation.IndexAllocation)) {
+            return;
+        }
+        final NativeMemoryAllocation.IndexAllocation indexAllocation = (NativeMemoryAllocation.IndexAllocation) allocation;
+        if (indexAllocation.getKnnEngine() != KNNEngine.FAISS) {
+            return;
+        }
+
+        // The read lock keeps the index from being freed by an eviction while it is warmed up
+        indexAllocation.readLock();
+        try {
+            if (indexAllocation.isClosed()) {
+                return;
+            }
+            final long[] stats = JNIService.warmIndex(indexAllocation.getMemoryAddress(), KNNEngine.FAISS, warmupMode);
+            log.debug(
+                "[KNN] Warmed up {} bytes of [{}] in {} ms with mode [{}]",
+                stats[0],
+                indexAllocation.getVectorFileName(),
+                stats[1] / 1_000_000,
+                warmupMode.getName()
+            );
+        } catch (Exception e) {
+            log.warn("[KNN] Failed to warm up [{}]", indexAllocation.getVectorFileName(), e);
+        } finally {
+            indexAllocation.readUnlock();
+        }
+    }
+
     /**
      * Removes all the k-NN segments for this shard from the cache.
      * Adding write lock onto the {@link NativeMemoryAllocation} of the index that needs to be evicted from cache.
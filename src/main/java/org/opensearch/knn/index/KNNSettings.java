@@ -26,9 +26,12 @@ import org.opensearch.core.common.unit.ByteSizeUnit;
 import org.opensearch.core.common.unit.ByteSizeValue;
 import org.opensearch.index.IndexModule;
 import org.opensearch.knn.index.engine.MemoryOptimizedSearchSupportSpec;
+import org.opensearch.knn.index.memory.NativeIndexNumaPlacement;
+import org.opensearch.knn.index.memory.NativeIndexWarmupMode;
 import org.opensearch.knn.index.memory.NativeMemoryCacheManager;
 import org.opensearch.knn.index.memory.NativeMemoryCacheManagerDto;
 import org.opensearch.knn.index.util.IndexHyperParametersUtil;
+import org.opensearch.knn.jni.JNICommons;
 import org.opensearch.knn.quantization.models.quantizationState.QuantizationStateCacheManager;
 import org.opensearch.monitor.jvm.JvmInfo;
 import org.opensearch.monitor.os.OsProbe;
@@ -99,6 +102,19 @@ public class KNNSettings {
     public static final String KNN_FAISS_AVX512_SPR_DISABLED = "knn.faiss.avx512_spr.disabled";
     public static final String KNN_DISK_VECTOR_SHARD_LEVEL_RESCORING_DISABLED = "index.knn.disk.vector.shard_level_rescoring_disabled";
     public static final String KNN_DERIVED_SOURCE_ENABLED = "index.knn.derived_source.enabled";
+    public static final String KNN_VECTOR_BUFFER_POOL_LIMIT = "knn.vector_buffer_pool.limit";
+    public static final String KNN_VECTOR_BUFFER_POOL_HUGE_PAGES_ENABLED = "knn.vector_buffer_pool.huge_pages.enabled";
+    public static final String KNN_FAISS_MMAP_LOAD_ENABLED = "knn.faiss.mmap_load.enabled";
+    public static final String KNN_FAISS_INDEX_COMPRESSION_ENABLED = "index.knn.faiss.index_compression.enabled";
+    public static final String KNN_FAISS_GRAPH_REORDER_ENABLED = "knn.faiss.graph_reorder.enabled";
+    public static final String KNN_NATIVE_INDEX_DIRECT_WRITE_ENABLED = "knn.native_index.direct_write.enabled";
+    public static final String KNN_NATIVE_INDEX_DIRECT_WRITE_PREALLOCATE_ENABLED = "knn.native_index.direct_write.preallocate.enabled";
+    public static final String KNN_NATIVE_INDEX_WARMUP_MODE = "knn.native_index.warmup.mode";
+    public static final String KNN_NATIVE_INDEX_NUMA_PLACEMENT = "knn.native_index.numa_placement";
+    public static final String KNN_NATIVE_INDEX_FREE_TRIM_ENABLED = "knn.native_index.free.trim.enabled";
+    public static final String KNN_NATIVE_INDEX_ARENA_ENABLED = "knn.native_index.arena.enabled";
+    public static final String KNN_FAISS_COMPACT_GRAPH_ENABLED = "knn.faiss.compact_graph.enabled";
+    public static final String KNN_FAISS_QUERY_BATCH_MAX_WAIT = "knn.faiss.query_batch.max_wait";
     // Remote index build index settings
     public static final String KNN_INDEX_REMOTE_VECTOR_BUILD = "index.knn.remote_index_build.enabled";
     public static final String KNN_INDEX_REMOTE_VECTOR_BUILD_SIZE_MIN = "index.knn.remote_index_build.size.min";
@@ -147,6 +163,19 @@ public class KNNSettings {
     // 10% of the JVM heap
     public static final Integer KNN_DEFAULT_QUANTIZATION_STATE_CACHE_EXPIRY_TIME_MINUTES = 60;
     public static final boolean KNN_DISK_VECTOR_SHARD_LEVEL_RESCORING_DISABLED_VALUE = false;
+    public static final ByteSizeValue KNN_DEFAULT_VECTOR_BUFFER_POOL_LIMIT_VALUE = new ByteSizeValue(256, ByteSizeUnit.MB);
+    public static final boolean KNN_DEFAULT_VECTOR_BUFFER_POOL_HUGE_PAGES_ENABLED_VALUE = false;
+    public static final boolean KNN_DEFAULT_FAISS_MMAP_LOAD_ENABLED_VALUE = false;
+    public static final boolean KNN_DEFAULT_FAISS_INDEX_COMPRESSION_ENABLED_VALUE = false;
+    public static final boolean KNN_DEFAULT_FAISS_GRAPH_REORDER_ENABLED_VALUE = false;
+    public static final boolean KNN_DEFAULT_NATIVE_INDEX_DIRECT_WRITE_ENABLED_VALUE = false;
+    public static final boolean KNN_DEFAULT_NATIVE_INDEX_DIRECT_WRITE_PREALLOCATE_ENABLED_VALUE = false;
+    public static final NativeIndexWarmupMode KNN_DEFAULT_NATIVE_INDEX_WARMUP_MODE_VALUE = NativeIndexWarmupMode.TOUCH;
+    public static final NativeIndexNumaPlacement KNN_DEFAULT_NATIVE_INDEX_NUMA_PLACEMENT_VALUE = NativeIndexNumaPlacement.NONE;
+    public static final boolean KNN_DEFAULT_NATIVE_INDEX_FREE_TRIM_ENABLED_VALUE = false;
+    public static final boolean KNN_DEFAULT_NATIVE_INDEX_ARENA_ENABLED_VALUE = false;
+    public static final boolean KNN_DEFAULT_FAISS_COMPACT_GRAPH_ENABLED_VALUE = false;
+    public static final TimeValue KNN_DEFAULT_FAISS_QUERY_BATCH_MAX_WAIT_VALUE = TimeValue.ZERO;
     public static final ByteSizeValue KNN_REMOTE_VECTOR_BUILD_SIZE_LIMIT_DEFAULT_VALUE = new ByteSizeValue(0, ByteSizeUnit.MB);
     // TODO: Tune this default value based on benchmarking
     public static final ByteSizeValue KNN_INDEX_REMOTE_VECTOR_BUILD_THRESHOLD_DEFAULT_VALUE = new ByteSizeValue(50, ByteSizeUnit.MB);
@@ -449,6 +478,164 @@ public class KNNSettings {
         NodeScope
     );
 
+    /**
+     * Node level setting which bounds the native memory kept by the vector buffer pool for reuse across index builds,
+     * once the vectors of a build are released. 0 disables pooling.
+     */
+    public static final Setting<ByteSizeValue> KNN_VECTOR_BUFFER_POOL_LIMIT_SETTING = Setting.byteSizeSetting(
+        KNN_VECTOR_BUFFER_POOL_LIMIT,
+        KNN_DEFAULT_VECTOR_BUFFER_POOL_LIMIT_VALUE,
+        NodeScope,
+        Dynamic
+    );
+
+    /**
+     * Node level setting to back large vector buffers with transparent huge pages, when the platform supports it.
+     */
+    public static final Setting<Boolean> KNN_VECTOR_BUFFER_POOL_HUGE_PAGES_ENABLED_SETTING = Setting.boolSetting(
+        KNN_VECTOR_BUFFER_POOL_HUGE_PAGES_ENABLED,
+        KNN_DEFAULT_VECTOR_BUFFER_POOL_HUGE_PAGES_ENABLED_VALUE,
+        NodeScope,
+        Dynamic
+    );
+
+    /**
+     * Node level setting to load Faiss index files through a memory mapping of the local segment file instead of
+     * streaming them through Lucene's IndexInput. Only applies to file system based directories, and should stay
+     * disabled when the directory transforms the bytes it reads, e.g. for encryption at rest.
+     */
+    public static final Setting<Boolean> KNN_FAISS_MMAP_LOAD_ENABLED_SETTING = Setting.boolSetting(
+        KNN_FAISS_MMAP_LOAD_ENABLED,
+        KNN_DEFAULT_FAISS_MMAP_LOAD_ENABLED_VALUE,
+        NodeScope,
+        Dynamic
+    );
+
+    /**
+     * Index level setting to compress the Faiss index files written by flushes and merges of the index. Compressed files
+     * are smaller to snapshot, recover and upload, and are decompressed transparently when loaded. Memory optimized
+     * search cannot read them, so fields it supports are written uncompressed, and files are only compressed once every
+     * node of the cluster is able to read them.
+     */
+    public static final Setting<Boolean> KNN_FAISS_INDEX_COMPRESSION_ENABLED_SETTING = Setting.boolSetting(
+        KNN_FAISS_INDEX_COMPRESSION_ENABLED,
+        KNN_DEFAULT_FAISS_INDEX_COMPRESSION_ENABLED_VALUE,
+        IndexScope,
+        Dynamic
+    );
+
+    /**
+     * Node level setting to renumber the nodes of the HNSW graphs built by flushes and merges on this node, in the
+     * breadth-first order of the graph from its entry point, before they are written. Neighbors then mostly sit close to
+     * each other in memory, which makes searches cheaper on cache and TLB. The files keep the same format, only the labels
+     * of their id map are no longer in ascending order.
+     */
+    public static final Setting<Boolean> KNN_FAISS_GRAPH_REORDER_ENABLED_SETTING = Setting.boolSetting(
+        KNN_FAISS_GRAPH_REORDER_ENABLED,
+        KNN_DEFAULT_FAISS_GRAPH_REORDER_ENABLED_VALUE,
+        NodeScope,
+        Dynamic
+    );
+
+    /**
+     * Node level setting to let native engines write the index files of flushes and merges straight to the local
+     * segment file, computing the footer checksum natively, instead of handing every buffer to Lucene's IndexOutput.
+     * Only applies to file system based directories, and should stay disabled when the directory transforms the bytes
+     * it writes, e.g. for encryption at rest.
+     */
+    public static final Setting<Boolean> KNN_NATIVE_INDEX_DIRECT_WRITE_ENABLED_SETTING = Setting.boolSetting(
+        KNN_NATIVE_INDEX_DIRECT_WRITE_ENABLED,
+        KNN_DEFAULT_NATIVE_INDEX_DIRECT_WRITE_ENABLED_VALUE,
+        NodeScope,
+        Dynamic
+    );
+
+    /**
+     * Node level setting to reserve disk space ahead of the bytes written by direct writes, which limits the
+     * fragmentation of large index files. Space reserved past the end of the file is released once it is written.
+     */
+    public static final Setting<Boolean> KNN_NATIVE_INDEX_DIRECT_WRITE_PREALLOCATE_ENABLED_SETTING = Setting.boolSetting(
+        KNN_NATIVE_INDEX_DIRECT_WRITE_PREALLOCATE_ENABLED,
+        KNN_DEFAULT_NATIVE_INDEX_DIRECT_WRITE_PREALLOCATE_ENABLED_VALUE,
+        NodeScope,
+        Dynamic
+    );
+
+    /**
+     * Node level setting deciding what the warmup API does to the Faiss indices it loaded: nothing more ("none"), advise
+     * the kernel that their pages will be needed ("advise"), read all their pages ("touch"), or read their pages and run
+     * a few queries against them ("query").
+     */
+    public static final Setting<NativeIndexWarmupMode> KNN_NATIVE_INDEX_WARMUP_MODE_SETTING = new Setting<>(
+        KNN_NATIVE_INDEX_WARMUP_MODE,
+        KNN_DEFAULT_NATIVE_INDEX_WARMUP_MODE_VALUE.getName(),
+        NativeIndexWarmupMode::fromName,
+        NodeScope,
+        Dynamic
+    );
+
+    /**
+     * Node level setting deciding where the memory of Faiss indices goes on hosts with several NUMA nodes once they are
+     * loaded: wherever the loading thread touched it ("none"), interleaved across all the nodes ("interleave"), or bound
+     * to one node per index, assigned in turn ("round_robin").
+     */
+    public static final Setting<NativeIndexNumaPlacement> KNN_NATIVE_INDEX_NUMA_PLACEMENT_SETTING = new Setting<>(
+        KNN_NATIVE_INDEX_NUMA_PLACEMENT,
+        KNN_DEFAULT_NATIVE_INDEX_NUMA_PLACEMENT_VALUE.getName(),
+        NativeIndexNumaPlacement::fromName,
+        NodeScope,
+        Dynamic
+    );
+
+    /**
+     * Node level setting to hand the memory of native indices back to the operating system once they are evicted and
+     * freed. Allocators such as glibc otherwise keep freed memory for reuse, so the resident size of the node stays high.
+     */
+    public static final Setting<Boolean> KNN_NATIVE_INDEX_FREE_TRIM_ENABLED_SETTING = Setting.boolSetting(
+        KNN_NATIVE_INDEX_FREE_TRIM_ENABLED,
+        KNN_DEFAULT_NATIVE_INDEX_FREE_TRIM_ENABLED_VALUE,
+        NodeScope,
+        Dynamic
+    );
+
+    /**
+     * Node level setting to read each Faiss index loaded into memory into an arena of its own, which is unmapped as a
+     * whole when the index is freed. Only supported on Linux by JNI libraries built with KNN_INDEX_ARENAS, which is off by
+     * default. Otherwise a warning is logged on the first load and indices are loaded on the heap.
+     */
+    public static final Setting<Boolean> KNN_NATIVE_INDEX_ARENA_ENABLED_SETTING = Setting.boolSetting(
+        KNN_NATIVE_INDEX_ARENA_ENABLED,
+        KNN_DEFAULT_NATIVE_INDEX_ARENA_ENABLED_VALUE,
+        NodeScope,
+        Dynamic
+    );
+
+    /**
+     * Node level setting to keep the neighbor lists of the HNSW graphs of Faiss indices loaded into memory in a compact,
+     * delta encoded form, which is decoded as the graph is searched. Saves most of the memory of the graph, which
+     * dominates binary indices, for a little search CPU. Applies to the indices loaded after it is changed.
+     */
+    public static final Setting<Boolean> KNN_FAISS_COMPACT_GRAPH_ENABLED_SETTING = Setting.boolSetting(
+        KNN_FAISS_COMPACT_GRAPH_ENABLED,
+        KNN_DEFAULT_FAISS_COMPACT_GRAPH_ENABLED_VALUE,
+        NodeScope,
+        Dynamic
+    );
+
+    /**
+     * Node level setting for how long an unfiltered top k search of a loaded Faiss index waits for concurrent searches
+     * of the same segment, such as the other searches of an msearch request, to join it so that they are all searched
+     * by a single native call. Every search waits up to this long when it runs alone, so batching is disabled by the
+     * default of 0.
+     */
+    public static final Setting<TimeValue> KNN_FAISS_QUERY_BATCH_MAX_WAIT_SETTING = Setting.timeSetting(
+        KNN_FAISS_QUERY_BATCH_MAX_WAIT,
+        KNN_DEFAULT_FAISS_QUERY_BATCH_MAX_WAIT_VALUE,
+        TimeValue.ZERO,
+        NodeScope,
+        Dynamic
+    );
+
     /**
      * Remote build service endpoint to be used for remote index build.
      */
@@ -594,6 +781,12 @@ public class KNNSettings {
         clusterService.getClusterSettings().addSettingsUpdateConsumer(QUANTIZATION_STATE_CACHE_EXPIRY_TIME_MINUTES_SETTING, it -> {
             quantizationStateCacheManager.rebuildCache();
         });
+        clusterService.getClusterSettings()
+            .addSettingsUpdateConsumer(
+                KNN_VECTOR_BUFFER_POOL_LIMIT_SETTING,
+                KNN_VECTOR_BUFFER_POOL_HUGE_PAGES_ENABLED_SETTING,
+                (limit, hugePagesEnabled) -> JNICommons.configureVectorBufferPool(limit.getBytes(), hugePagesEnabled)
+            );
     }
 
     /**
@@ -684,6 +877,58 @@ public class KNNSettings {
             return KNN_REMOTE_VECTOR_BUILD_SIZE_MAX_SETTING;
         }
 
+        if (KNN_VECTOR_BUFFER_POOL_LIMIT.equals(key)) {
+            return KNN_VECTOR_BUFFER_POOL_LIMIT_SETTING;
+        }
+
+        if (KNN_VECTOR_BUFFER_POOL_HUGE_PAGES_ENABLED.equals(key)) {
+            return KNN_VECTOR_BUFFER_POOL_HUGE_PAGES_ENABLED_SETTING;
+        }
+
+        if (KNN_FAISS_MMAP_LOAD_ENABLED.equals(key)) {
+            return KNN_FAISS_MMAP_LOAD_ENABLED_SETTING;
+        }
+
+        if (KNN_FAISS_INDEX_COMPRESSION_ENABLED.equals(key)) {
+            return KNN_FAISS_INDEX_COMPRESSION_ENABLED_SETTING;
+        }
+
+        if (KNN_FAISS_GRAPH_REORDER_ENABLED.equals(key)) {
+            return KNN_FAISS_GRAPH_REORDER_ENABLED_SETTING;
+        }
+
+        if (KNN_NATIVE_INDEX_DIRECT_WRITE_ENABLED.equals(key)) {
+            return KNN_NATIVE_INDEX_DIRECT_WRITE_ENABLED_SETTING;
+        }
+
+        if (KNN_NATIVE_INDEX_DIRECT_WRITE_PREALLOCATE_ENABLED.equals(key)) {
+            return KNN_NATIVE_INDEX_DIRECT_WRITE_PREALLOCATE_ENABLED_SETTING;
+        }
+
+        if (KNN_NATIVE_INDEX_WARMUP_MODE.equals(key)) {
+            return KNN_NATIVE_INDEX_WARMUP_MODE_SETTING;
+        }
+
+        if (KNN_NATIVE_INDEX_NUMA_PLACEMENT.equals(key)) {
+            return KNN_NATIVE_INDEX_NUMA_PLACEMENT_SETTING;
+        }
+
+        if (KNN_NATIVE_INDEX_FREE_TRIM_ENABLED.equals(key)) {
+            return KNN_NATIVE_INDEX_FREE_TRIM_ENABLED_SETTING;
+        }
+
+        if (KNN_NATIVE_INDEX_ARENA_ENABLED.equals(key)) {
+            return KNN_NATIVE_INDEX_ARENA_ENABLED_SETTING;
+        }
+
+        if (KNN_FAISS_COMPACT_GRAPH_ENABLED.equals(key)) {
+            return KNN_FAISS_COMPACT_GRAPH_ENABLED_SETTING;
+        }
+
+        if (KNN_FAISS_QUERY_BATCH_MAX_WAIT.equals(key)) {
+            return KNN_FAISS_QUERY_BATCH_MAX_WAIT_SETTING;
+        }
+
         if (KNN_REMOTE_BUILD_SERVICE_ENDPOINT.equals(key)) {
             return KNN_REMOTE_BUILD_SERVICE_ENDPOINT_SETTING;
         }
@@ -728,6 +973,19 @@ public class KNNSettings {
             KNN_DISK_VECTOR_SHARD_LEVEL_RESCORING_DISABLED_SETTING,
             KNN_DERIVED_SOURCE_ENABLED_SETTING,
             MEMORY_OPTIMIZED_KNN_SEARCH_MODE_SETTING,
+            KNN_VECTOR_BUFFER_POOL_LIMIT_SETTING,
+            KNN_VECTOR_BUFFER_POOL_HUGE_PAGES_ENABLED_SETTING,
+            KNN_FAISS_MMAP_LOAD_ENABLED_SETTING,
+            KNN_FAISS_INDEX_COMPRESSION_ENABLED_SETTING,
+            KNN_FAISS_GRAPH_REORDER_ENABLED_SETTING,
+            KNN_NATIVE_INDEX_DIRECT_WRITE_ENABLED_SETTING,
+            KNN_NATIVE_INDEX_DIRECT_WRITE_PREALLOCATE_ENABLED_SETTING,
+            KNN_NATIVE_INDEX_WARMUP_MODE_SETTING,
+            KNN_NATIVE_INDEX_NUMA_PLACEMENT_SETTING,
+            KNN_NATIVE_INDEX_FREE_TRIM_ENABLED_SETTING,
+            KNN_NATIVE_INDEX_ARENA_ENABLED_SETTING,
+            KNN_FAISS_COMPACT_GRAPH_ENABLED_SETTING,
+            KNN_FAISS_QUERY_BATCH_MAX_WAIT_SETTING,
             // Index level remote vector build settings
             KNN_INDEX_REMOTE_VECTOR_BUILD_SETTING,
             KNN_INDEX_REMOTE_VECTOR_BUILD_SIZE_MIN_SETTING,
@@ -862,6 +1120,76 @@ public class KNNSettings {
         return Booleans.parseBooleanStrict(KNNSettings.state().getSettingValue(KNN_REMOTE_VECTOR_BUILD).toString(), false);
     }
 
+    /**
+     * @return true if Faiss index files should be loaded through a memory mapping of the local file
+     */
+    public static boolean isFaissMmapLoadEnabled() {
+        return KNNSettings.state().getSettingValue(KNN_FAISS_MMAP_LOAD_ENABLED);
+    }
+
+    /**
+     * @return true if HNSW graphs built on this node should be renumbered for locality before they are written
+     */
+    public static boolean isFaissGraphReorderEnabled() {
+        return KNNSettings.state().getSettingValue(KNN_FAISS_GRAPH_REORDER_ENABLED);
+    }
+
+    /**
+     * @return true if native engines should write index files straight to the local segment file
+     */
+    public static boolean isNativeIndexDirectWriteEnabled() {
+        return KNNSettings.state().getSettingValue(KNN_NATIVE_INDEX_DIRECT_WRITE_ENABLED);
+    }
+
+    /**
+     * @return true if disk space should be reserved ahead of the bytes written by direct writes
+     */
+    public static boolean isNativeIndexDirectWritePreallocateEnabled() {
+        return KNNSettings.state().getSettingValue(KNN_NATIVE_INDEX_DIRECT_WRITE_PREALLOCATE_ENABLED);
+    }
+
+    /**
+     * @return what the warmup API does to the native indices it loaded
+     */
+    public static NativeIndexWarmupMode getNativeIndexWarmupMode() {
+        return KNNSettings.state().getSettingValue(KNN_NATIVE_INDEX_WARMUP_MODE);
+    }
+
+    /**
+     * @return where the memory of native indices is placed across NUMA nodes once they are loaded
+     */
+    public static NativeIndexNumaPlacement getNativeIndexNumaPlacement() {
+        return KNNSettings.state().getSettingValue(KNN_NATIVE_INDEX_NUMA_PLACEMENT);
+    }
+
+    /**
+     * @return true if the memory of freed native indices should be handed back to the operating system
+     */
+    public static boolean isNativeIndexFreeTrimEnabled() {
+        return KNNSettings.state().getSettingValue(KNN_NATIVE_INDEX_FREE_TRIM_ENABLED);
+    }
+
+    /**
+     * @return true if Faiss indices should be loaded into arenas of their own
+     */
+    public static boolean isNativeIndexArenaEnabled() {
+        return KNNSettings.state().getSettingValue(KNN_NATIVE_INDEX_ARENA_ENABLED);
+    }
+
+    /**
+     * @return true if the HNSW graphs of loaded Faiss indices should be kept in compact form
+     */
+    public static boolean isFaissCompactGraphEnabled() {
+        return KNNSettings.state().getSettingValue(KNN_FAISS_COMPACT_GRAPH_ENABLED);
+    }
+
+    /**
+     * @return how long a search of a loaded Faiss index waits for concurrent searches to batch with, 0 when disabled
+     */
+    public static TimeValue getFaissQueryBatchMaxWait() {
+        return KNNSettings.state().getSettingValue(KNN_FAISS_QUERY_BATCH_MAX_WAIT);
+    }
+
     /**
      * Gets the remote build service endpoint.
      * @return String representation of the remote build service endpoint URL
@@ -164,6 +164,25 @@ public enum SpaceType {
             return 1 / (1 + rawScore);
         }
 
+        /**
+         * Hamming distances are whole numbers, so the radius is the largest distance whose score is at least the given score.
+         * A score above 1 is met by no distance and gives a negative radius.
+         */
+        @Override
+        public float scoreToDistanceTranslation(float score) {
+            if (score == 0) {
+                throw new IllegalArgumentException(String.format(Locale.ROOT, "score cannot be 0 when space type is [%s]", getValue()));
+            }
+            float distance = (float) Math.floor(1 / (double) score - 1);
+            // Scores are rounded to floats, which can move the boundary by one distance
+            if (scoreTranslation(distance + 1) >= score) {
+                distance++;
+            } else if (distance >= 0 && scoreTranslation(distance) < score) {
+                distance--;
+            }
+            return distance;
+        }
+
         @Override
         public void validateVectorDataType(VectorDataType vectorDataType) {
             if (VectorDataType.BINARY != vectorDataType) {
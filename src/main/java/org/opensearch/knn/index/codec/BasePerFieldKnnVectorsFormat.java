@@ -13,6 +13,7 @@ import org.apache.lucene.codecs.lucene99.Lucene99FlatVectorsFormat;
 import org.apache.lucene.codecs.perfield.PerFieldKnnVectorsFormat;
 import org.opensearch.index.IndexSettings;
 import org.opensearch.index.mapper.MapperService;
+import org.opensearch.knn.common.KNNConstants;
 import org.opensearch.knn.index.KNNSettings;
 import org.opensearch.knn.index.codec.KNN990Codec.NativeEngines990KnnVectorsFormat;
 import org.opensearch.knn.index.codec.nativeindex.NativeIndexBuildStrategyFactory;
@@ -22,6 +23,7 @@ import org.opensearch.knn.index.engine.KNNEngine;
 import org.opensearch.knn.index.engine.KNNMethodContext;
 import org.opensearch.knn.index.mapper.KNNMappingConfig;
 import org.opensearch.knn.index.mapper.KNNVectorFieldType;
+import org.opensearch.knn.index.util.IndexUtil;
 
 import java.util.Map;
 import java.util.Optional;
@@ -99,7 +101,7 @@ public abstract class BasePerFieldKnnVectorsFormat extends PerFieldKnnVectorsFor
 
         final KNNMappingConfig knnMappingConfig = mappedFieldType.getKnnMappingConfig();
         if (knnMappingConfig.getModelId().isPresent()) {
-            return nativeEngineVectorsFormat();
+            return nativeEngineVectorsFormat(mappedFieldType);
         }
 
         final KNNMethodContext knnMethodContext = knnMappingConfig.getKnnMethodContext()
@@ -150,20 +152,31 @@ public abstract class BasePerFieldKnnVectorsFormat extends PerFieldKnnVectorsFor
         }
 
         // All native engines to use NativeEngines990KnnVectorsFormat
-        return nativeEngineVectorsFormat();
+        return nativeEngineVectorsFormat(mappedFieldType);
     }
 
-    private NativeEngines990KnnVectorsFormat nativeEngineVectorsFormat() {
+    private NativeEngines990KnnVectorsFormat nativeEngineVectorsFormat(final KNNVectorFieldType mappedFieldType) {
         // mapperService is already checked for null or valid instance type at caller, hence we don't need
         // addition isPresent check here.
         final int approximateThreshold = getApproximateThresholdValue();
         return new NativeEngines990KnnVectorsFormat(
             new Lucene99FlatVectorsFormat(FlatVectorScorerUtil.getLucene99FlatVectorsScorer()),
             approximateThreshold,
-            nativeIndexBuildStrategyFactory
+            nativeIndexBuildStrategyFactory,
+            isIndexCompressionEnabled(mappedFieldType)
         );
     }
 
+    private boolean isIndexCompressionEnabled(final KNNVectorFieldType mappedFieldType) {
+        // Memory optimized search cannot read compressed files, and it can be turned on for the index after segments were
+        // written, so fields it supports are never compressed. Nodes of earlier versions cannot read them either, so files
+        // are only compressed once every node of the cluster can load them.
+        final IndexSettings indexSettings = mapperService.get().getIndexSettings();
+        return Boolean.TRUE.equals(indexSettings.getValue(KNNSettings.KNN_FAISS_INDEX_COMPRESSION_ENABLED_SETTING))
+            && mappedFieldType.isMemoryOptimizedSearchAvailable() == false
+            && IndexUtil.isClusterOnOrAfterMinRequiredVersion(KNNConstants.FAISS_INDEX_COMPRESSION_FEATURE);
+    }
+
     private int getApproximateThresholdValue() {
         // This is private method and mapperService is already checked for null or valid instance type before this call
         // at caller, hence we don't need additional isPresent check here.
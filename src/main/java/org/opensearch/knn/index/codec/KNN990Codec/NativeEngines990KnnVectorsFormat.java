@@ -37,6 +37,8 @@ public class NativeEngines990KnnVectorsFormat extends KnnVectorsFormat {
     private static final String FORMAT_NAME = "NativeEngines990KnnVectorsFormat";
     private static int approximateThreshold;
     private final NativeIndexBuildStrategyFactory nativeIndexBuildStrategyFactory;
+    /** Whether Faiss indices of the field are written compressed */
+    private final boolean compressIndex;
 
     public NativeEngines990KnnVectorsFormat() {
         this(new Lucene99FlatVectorsFormat(new DefaultFlatVectorScorer()));
@@ -58,11 +60,21 @@ public class NativeEngines990KnnVectorsFormat extends KnnVectorsFormat {
         final FlatVectorsFormat flatVectorsFormat,
         int approximateThreshold,
         final NativeIndexBuildStrategyFactory nativeIndexBuildStrategyFactory
+    ) {
+        this(flatVectorsFormat, approximateThreshold, nativeIndexBuildStrategyFactory, false);
+    }
+
+    public NativeEngines990KnnVectorsFormat(
+        final FlatVectorsFormat flatVectorsFormat,
+        int approximateThreshold,
+        final NativeIndexBuildStrategyFactory nativeIndexBuildStrategyFactory,
+        boolean compressIndex
     ) {
         super(FORMAT_NAME);
         NativeEngines990KnnVectorsFormat.flatVectorsFormat = flatVectorsFormat;
         NativeEngines990KnnVectorsFormat.approximateThreshold = approximateThreshold;
         this.nativeIndexBuildStrategyFactory = nativeIndexBuildStrategyFactory;
+        this.compressIndex = compressIndex;
     }
 
     /**
@@ -76,7 +88,8 @@ public class NativeEngines990KnnVectorsFormat extends KnnVectorsFormat {
             state,
             flatVectorsFormat.fieldsWriter(state),
             approximateThreshold,
-            nativeIndexBuildStrategyFactory
+            nativeIndexBuildStrategyFactory,
+            compressIndex
         );
     }
 
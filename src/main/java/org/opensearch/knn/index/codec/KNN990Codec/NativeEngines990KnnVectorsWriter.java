@@ -55,17 +55,29 @@ public class NativeEngines990KnnVectorsWriter extends KnnVectorsWriter {
     private boolean finished;
     private final Integer approximateThreshold;
     private final NativeIndexBuildStrategyFactory nativeIndexBuildStrategyFactory;
+    private final boolean compressIndex;
 
     public NativeEngines990KnnVectorsWriter(
         SegmentWriteState segmentWriteState,
         FlatVectorsWriter flatVectorsWriter,
         Integer approximateThreshold,
         NativeIndexBuildStrategyFactory nativeIndexBuildStrategyFactory
+    ) {
+        this(segmentWriteState, flatVectorsWriter, approximateThreshold, nativeIndexBuildStrategyFactory, false);
+    }
+
+    public NativeEngines990KnnVectorsWriter(
+        SegmentWriteState segmentWriteState,
+        FlatVectorsWriter flatVectorsWriter,
+        Integer approximateThreshold,
+        NativeIndexBuildStrategyFactory nativeIndexBuildStrategyFactory,
+        boolean compressIndex
     ) {
         this.segmentWriteState = segmentWriteState;
         this.flatVectorsWriter = flatVectorsWriter;
         this.approximateThreshold = approximateThreshold;
         this.nativeIndexBuildStrategyFactory = nativeIndexBuildStrategyFactory;
+        this.compressIndex = compressIndex;
     }
 
     /**
@@ -121,7 +133,8 @@ public class NativeEngines990KnnVectorsWriter extends KnnVectorsWriter {
                 fieldInfo,
                 segmentWriteState,
                 quantizationState,
-                nativeIndexBuildStrategyFactory
+                nativeIndexBuildStrategyFactory,
+                compressIndex
             );
 
             StopWatch stopWatch = new StopWatch().start();
@@ -164,7 +177,8 @@ public class NativeEngines990KnnVectorsWriter extends KnnVectorsWriter {
             fieldInfo,
             segmentWriteState,
             quantizationState,
-            nativeIndexBuildStrategyFactory
+            nativeIndexBuildStrategyFactory,
+            compressIndex
         );
 
         StopWatch stopWatch = new StopWatch().start();
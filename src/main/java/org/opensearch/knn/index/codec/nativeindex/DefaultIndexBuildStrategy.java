@@ -103,8 +103,6 @@ final class DefaultIndexBuildStrategy implements NativeIndexBuildStrategy {
                     return null;
                 });
             }
-            // Resetting here as vectors are deleted in JNILayer for non-iterative index builds
-            vectorTransfer.reset();
         } catch (Exception exception) {
             throw new RuntimeException(
                 "Failed to build index, field name " + indexInfo.getFieldName() + ", parameters " + indexInfo,
@@ -28,13 +28,17 @@ import static org.opensearch.knn.index.codec.util.KNNCodecUtil.initializeVectorV
 /**
  * Iteratively builds the index. Iterative builds are memory optimized as it does not require all vectors
  * to be transferred. It transfers vectors in small batches, builds index and can clear the offheap space where
- * the vectors were transferred
+ * the vectors were transferred. Batches are inserted natively in the background while the next one is transferred.
  */
 @NoArgsConstructor(access = AccessLevel.PRIVATE)
 final class MemOptimizedNativeIndexBuildStrategy implements NativeIndexBuildStrategy {
 
     private static MemOptimizedNativeIndexBuildStrategy INSTANCE = new MemOptimizedNativeIndexBuildStrategy();
 
+    // Number of off-heap buffers the vectors are transferred to. One is filled while the vectors of the others are
+    // inserted.
+    private static final int TRANSFER_BUFFER_COUNT = 2;
+
     public static MemOptimizedNativeIndexBuildStrategy getInstance() {
         return INSTANCE;
     }
@@ -68,56 +72,67 @@ final class MemOptimizedNativeIndexBuildStrategy implements NativeIndexBuildStra
             )
         );
 
+        // The buffers share the vector streaming memory limit, so each of them holds a fraction of the vectors it
+        // would hold alone
+        final int bytesPerTransferredVector = indexBuildSetup.getBytesPerVector() * TRANSFER_BUFFER_COUNT;
         try (
             final OffHeapVectorTransfer vectorTransfer = getVectorTransfer(
                 indexInfo.getVectorDataType(),
-                indexBuildSetup.getBytesPerVector(),
+                bytesPerTransferredVector,
+                indexInfo.getTotalLiveDocs()
+            );
+            final OffHeapVectorTransfer nextVectorTransfer = getVectorTransfer(
+                indexInfo.getVectorDataType(),
+                bytesPerTransferredVector,
                 indexInfo.getTotalLiveDocs()
             )
         ) {
+            // Vectors are inserted on a native thread while the next batch is transferred into the other buffer
+            final long ingestionSession = AccessController.doPrivileged(
+                (PrivilegedAction<Long>) () -> JNIService.startIngestion(
+                    indexMemoryAddress,
+                    indexBuildSetup.getDimensions(),
+                    indexParameters,
+                    TRANSFER_BUFFER_COUNT - 1,
+                    engine
+                )
+            );
 
-            final List<Integer> transferredDocIds = new ArrayList<>(vectorTransfer.getTransferLimit());
-
-            while (knnVectorValues.docId() != NO_MORE_DOCS) {
-                Object vector = QuantizationIndexUtils.processAndReturnVector(knnVectorValues, indexBuildSetup);
-                // append is false to be able to reuse the memory location
-                boolean transferred = vectorTransfer.transfer(vector, false);
-                transferredDocIds.add(knnVectorValues.docId());
-                if (transferred) {
-                    // Insert vectors
-                    long vectorAddress = vectorTransfer.getVectorAddress();
-                    AccessController.doPrivileged((PrivilegedAction<Void>) () -> {
-                        JNIService.insertToIndex(
-                            intListToArray(transferredDocIds),
-                            vectorAddress,
-                            indexBuildSetup.getDimensions(),
-                            indexParameters,
-                            indexMemoryAddress,
-                            engine
-                        );
-                        return null;
-                    });
-                    transferredDocIds.clear();
+            try {
+                OffHeapVectorTransfer currentTransfer = vectorTransfer;
+                OffHeapVectorTransfer otherTransfer = nextVectorTransfer;
+                final List<Integer> transferredDocIds = new ArrayList<>(currentTransfer.getTransferLimit());
+
+                while (knnVectorValues.docId() != NO_MORE_DOCS) {
+                    Object vector = QuantizationIndexUtils.processAndReturnVector(knnVectorValues, indexBuildSetup);
+                    // append is false to be able to reuse the memory location
+                    boolean transferred = currentTransfer.transfer(vector, false);
+                    transferredDocIds.add(knnVectorValues.docId());
+                    if (transferred) {
+                        // Insert vectors. Once the submit returns, the vectors of the other buffer are inserted and it
+                        // can be refilled
+                        submitToIngestion(ingestionSession, transferredDocIds, currentTransfer.getVectorAddress(), engine);
+                        transferredDocIds.clear();
+                        final OffHeapVectorTransfer filledTransfer = currentTransfer;
+                        currentTransfer = otherTransfer;
+                        otherTransfer = filledTransfer;
+                    }
+                    knnVectorValues.nextDoc();
                 }
-                knnVectorValues.nextDoc();
-            }
 
-            boolean flush = vectorTransfer.flush(false);
-            // Need to make sure that the flushed vectors are indexed
-            if (flush) {
-                long vectorAddress = vectorTransfer.getVectorAddress();
+                boolean flush = currentTransfer.flush(false);
+                // Need to make sure that the flushed vectors are indexed
+                if (flush) {
+                    submitToIngestion(ingestionSession, transferredDocIds, currentTransfer.getVectorAddress(), engine);
+                    transferredDocIds.clear();
+                }
+            } finally {
+                // Waits for all vectors to be inserted, the buffers may not be freed before. Insertion failures are
+                // thrown here at the latest.
                 AccessController.doPrivileged((PrivilegedAction<Void>) () -> {
-                    JNIService.insertToIndex(
-                        intListToArray(transferredDocIds),
-                        vectorAddress,
-                        indexBuildSetup.getDimensions(),
-                        indexParameters,
-                        indexMemoryAddress,
-                        engine
-                    );
+                    JNIService.finishIngestion(ingestionSession, engine);
                     return null;
                 });
-                transferredDocIds.clear();
             }
 
             // Write vector
@@ -133,4 +148,11 @@ final class MemOptimizedNativeIndexBuildStrategy implements NativeIndexBuildStra
             );
         }
     }
+
+    private static void submitToIngestion(long ingestionSession, List<Integer> docIds, long vectorAddress, KNNEngine engine) {
+        AccessController.doPrivileged((PrivilegedAction<Void>) () -> {
+            JNIService.submitToIngestion(ingestionSession, intListToArray(docIds), vectorAddress, engine);
+            return null;
+        });
+    }
 }
@@ -8,9 +8,16 @@ package org.opensearch.knn.index.codec.nativeindex;
 import lombok.AllArgsConstructor;
 import lombok.extern.log4j.Log4j2;
 import org.apache.lucene.codecs.CodecUtil;
+import org.apache.lucene.index.CorruptIndexException;
 import org.apache.lucene.index.FieldInfo;
 import org.apache.lucene.index.SegmentWriteState;
+import org.apache.lucene.store.Directory;
+import org.apache.lucene.store.FSDirectory;
+import org.apache.lucene.store.FilterDirectory;
+import org.apache.lucene.store.IOContext;
+import org.apache.lucene.store.IndexInput;
 import org.apache.lucene.store.IndexOutput;
+import org.apache.lucene.util.Constants;
 import org.opensearch.common.Nullable;
 import org.opensearch.common.xcontent.XContentHelper;
 import org.opensearch.core.common.bytes.BytesArray;
@@ -35,6 +42,7 @@ import org.opensearch.knn.plugin.stats.KNNGraphValue;
 import org.opensearch.knn.quantization.models.quantizationState.QuantizationState;
 
 import java.io.IOException;
+import java.nio.file.Path;
 import java.util.HashMap;
 import java.util.Map;
 import java.util.function.Supplier;
@@ -61,6 +69,9 @@ public class NativeIndexWriter {
     private final NativeIndexBuildStrategyFactory indexBuilderFactory;
     @Nullable
     private final QuantizationState quantizationState;
+    // Whether a Faiss index is written compressed. Memory optimized search cannot read compressed files, so the per field
+    // format never asks for it on fields that search supports
+    private final boolean compressIndex;
 
     /**
      * Gets the correct writer type from fieldInfo
@@ -69,7 +80,7 @@ public class NativeIndexWriter {
      * @return correct NativeIndexWriter to make index specified in fieldInfo
      */
     public static NativeIndexWriter getWriter(final FieldInfo fieldInfo, SegmentWriteState state) {
-        return createWriter(fieldInfo, state, null, new NativeIndexBuildStrategyFactory());
+        return createWriter(fieldInfo, state, null, new NativeIndexBuildStrategyFactory(), false);
     }
 
     /**
@@ -92,7 +103,23 @@ public class NativeIndexWriter {
         final QuantizationState quantizationState,
         final NativeIndexBuildStrategyFactory nativeIndexBuildStrategyFactory
     ) {
-        return createWriter(fieldInfo, state, quantizationState, nativeIndexBuildStrategyFactory);
+        return createWriter(fieldInfo, state, quantizationState, nativeIndexBuildStrategyFactory, false);
+    }
+
+    /**
+     * Same as {@link #getWriter(FieldInfo, SegmentWriteState, QuantizationState, NativeIndexBuildStrategyFactory)}, for a field
+     * whose Faiss index may be written compressed, see {@link KNNSettings#KNN_FAISS_INDEX_COMPRESSION_ENABLED}.
+     *
+     * @param compressIndex Whether a Faiss index should be written compressed
+     */
+    public static NativeIndexWriter getWriter(
+        final FieldInfo fieldInfo,
+        final SegmentWriteState state,
+        final QuantizationState quantizationState,
+        final NativeIndexBuildStrategyFactory nativeIndexBuildStrategyFactory,
+        final boolean compressIndex
+    ) {
+        return createWriter(fieldInfo, state, quantizationState, nativeIndexBuildStrategyFactory, compressIndex);
     }
 
     /**
@@ -140,8 +167,14 @@ public class NativeIndexWriter {
             fieldInfo.name,
             knnEngine.getExtension()
         );
+        final IndexOutputWithBuffer indexOutputWithBuffer;
         try (IndexOutput output = state.directory.createOutput(engineFileName, state.context)) {
-            final IndexOutputWithBuffer indexOutputWithBuffer = new IndexOutputWithBuffer(output);
+            indexOutputWithBuffer = new IndexOutputWithBuffer(output, knnEngine == KNNEngine.FAISS && compressIndex);
+            final Path directWritePath = resolveDirectWritePath(state.directory, engineFileName);
+            if (directWritePath != null) {
+                indexOutputWithBuffer.writeDirectlyTo(directWritePath, KNNSettings.isNativeIndexDirectWritePreallocateEnabled());
+            }
+            indexOutputWithBuffer.reorderGraph(knnEngine == KNNEngine.FAISS && KNNSettings.isFaissGraphReorderEnabled());
             final BuildIndexParams nativeIndexParams = indexParams(
                 fieldInfo,
                 indexOutputWithBuffer,
@@ -157,7 +190,44 @@ public class NativeIndexWriter {
                 nativeIndexParams
             );
             indexBuilder.buildAndWriteIndex(nativeIndexParams);
-            CodecUtil.writeFooter(output);
+            if (!indexOutputWithBuffer.isWrittenDirectly()) {
+                CodecUtil.writeFooter(output);
+            }
+        }
+        if (indexOutputWithBuffer.isWrittenDirectly()) {
+            verifyDirectWrite(engineFileName, indexOutputWithBuffer);
+        }
+    }
+
+    /**
+     * Resolve the engine file to a path on the local file system, when native engines should write it directly and the
+     * directory is file system based. Returns null when the index has to be written through IndexOutput.
+     */
+    private static Path resolveDirectWritePath(final Directory directory, final String engineFileName) {
+        if (Constants.WINDOWS || !KNNSettings.isNativeIndexDirectWriteEnabled()) {
+            return null;
+        }
+        final Directory unwrapped = FilterDirectory.unwrap(directory);
+        if (!(unwrapped instanceof FSDirectory)) {
+            return null;
+        }
+        return ((FSDirectory) unwrapped).getDirectory().resolve(engineFileName);
+    }
+
+    /**
+     * Check that the footer of a directly written file holds the checksum native engines computed. The file itself is not
+     * read again, its checksum is verified by Lucene like any other file, e.g. when it is merged or recovered.
+     */
+    private void verifyDirectWrite(final String engineFileName, final IndexOutputWithBuffer indexOutputWithBuffer) throws IOException {
+        final long expectedChecksum = indexOutputWithBuffer.getDirectWriteChecksum();
+        try (IndexInput input = state.directory.openInput(engineFileName, IOContext.READONCE)) {
+            final long checksum = CodecUtil.retrieveChecksum(input, indexOutputWithBuffer.getDirectWriteLength());
+            if ((expectedChecksum & CRC32_CHECKSUM_SANITY) != 0 || checksum != expectedChecksum) {
+                throw new CorruptIndexException(
+                    "Directly written footer checksum " + checksum + " does not match the computed checksum " + expectedChecksum,
+                    input
+                );
+            }
         }
     }
 
@@ -318,14 +388,16 @@ public class NativeIndexWriter {
      * @param state              The SegmentWriteState representing the current segment's writing context.
      * @param quantizationState  The QuantizationState that contains quantization state required for quantization, can be null.
      * @param nativeIndexBuildStrategyFactory The factory which will return the correct {@link NativeIndexBuildStrategy} implementation
+     * @param compressIndex      Whether a Faiss index should be written compressed
      * @return                   A NativeIndexWriter instance appropriate for the specified field, configured with or without quantization.
      */
     private static NativeIndexWriter createWriter(
         final FieldInfo fieldInfo,
         final SegmentWriteState state,
         @Nullable final QuantizationState quantizationState,
-        NativeIndexBuildStrategyFactory nativeIndexBuildStrategyFactory
+        NativeIndexBuildStrategyFactory nativeIndexBuildStrategyFactory,
+        boolean compressIndex
     ) {
-        return new NativeIndexWriter(state, fieldInfo, nativeIndexBuildStrategyFactory, quantizationState);
+        return new NativeIndexWriter(state, fieldInfo, nativeIndexBuildStrategyFactory, quantizationState, compressIndex);
     }
 }
@@ -8,7 +8,6 @@ package org.opensearch.knn.index.codec.transfer;
 import org.opensearch.knn.jni.JNICommons;
 
 import java.io.IOException;
-import java.util.List;
 
 /**
  * Transfer quantized binary vectors to off heap memory
@@ -17,6 +16,10 @@ import java.util.List;
  */
 public final class OffHeapBinaryVectorTransfer extends OffHeapVectorTransfer<byte[]> {
 
+    // Batch of vectors laid out row after row, so it can be copied off heap at once
+    private byte[] stagedVectors;
+    private int vectorLength;
+
     public OffHeapBinaryVectorTransfer(int bytesPerVector, int totalVectorsToTransfer) {
         super(bytesPerVector, totalVectorsToTransfer);
     }
@@ -27,11 +30,21 @@ public final class OffHeapBinaryVectorTransfer extends OffHeapVectorTransfer<byt
     }
 
     @Override
-    protected long transfer(List<byte[]> batch, boolean append) throws IOException {
-        return JNICommons.storeBinaryVectorData(
+    protected void stage(final byte[] vector, int position) {
+        if (stagedVectors == null) {
+            vectorLength = vector.length;
+            stagedVectors = new byte[vectorLength * this.transferLimit];
+        }
+        System.arraycopy(vector, 0, stagedVectors, position * vectorLength, vectorLength);
+    }
+
+    @Override
+    protected long transfer(int vectorsToTransfer, boolean append) throws IOException {
+        return JNICommons.storeFlatBinaryVectorData(
             getVectorAddress(),
-            batch.toArray(new byte[][] {}),
-            (long) batch.get(0).length * transferLimit,
+            stagedVectors,
+            vectorsToTransfer * vectorLength,
+            (long) vectorLength * this.transferLimit,
             append
         );
     }
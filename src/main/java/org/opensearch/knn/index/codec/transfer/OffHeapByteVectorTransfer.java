@@ -8,7 +8,6 @@ package org.opensearch.knn.index.codec.transfer;
 import org.opensearch.knn.jni.JNICommons;
 
 import java.io.IOException;
-import java.util.List;
 
 /**
  * Transfer quantized byte vectors to off heap memory.
@@ -17,16 +16,30 @@ import java.util.List;
  */
 public final class OffHeapByteVectorTransfer extends OffHeapVectorTransfer<byte[]> {
 
+    // Batch of vectors laid out row after row, so it can be copied off heap at once
+    private byte[] stagedVectors;
+    private int vectorLength;
+
     public OffHeapByteVectorTransfer(int bytesPerVector, int totalVectorsToTransfer) {
         super(bytesPerVector, totalVectorsToTransfer);
     }
 
     @Override
-    protected long transfer(List<byte[]> batch, boolean append) throws IOException {
-        return JNICommons.storeByteVectorData(
+    protected void stage(final byte[] vector, int position) {
+        if (stagedVectors == null) {
+            vectorLength = vector.length;
+            stagedVectors = new byte[vectorLength * this.transferLimit];
+        }
+        System.arraycopy(vector, 0, stagedVectors, position * vectorLength, vectorLength);
+    }
+
+    @Override
+    protected long transfer(int vectorsToTransfer, boolean append) throws IOException {
+        return JNICommons.storeFlatByteVectorData(
             getVectorAddress(),
-            batch.toArray(new byte[][] {}),
-            (long) batch.get(0).length * transferLimit,
+            stagedVectors,
+            vectorsToTransfer * vectorLength,
+            (long) vectorLength * this.transferLimit,
             append
         );
     }
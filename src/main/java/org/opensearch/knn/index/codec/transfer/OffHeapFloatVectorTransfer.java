@@ -8,23 +8,36 @@ package org.opensearch.knn.index.codec.transfer;
 import org.opensearch.knn.jni.JNICommons;
 
 import java.io.IOException;
-import java.util.List;
 
 /**
  * Transfer float vectors to off heap memory.
  */
 public final class OffHeapFloatVectorTransfer extends OffHeapVectorTransfer<float[]> {
 
+    // Batch of vectors laid out row after row, so it can be copied off heap at once
+    private float[] stagedVectors;
+    private int dimension;
+
     public OffHeapFloatVectorTransfer(int bytesPerVector, int totalVectorsToTransfer) {
         super(bytesPerVector, totalVectorsToTransfer);
     }
 
     @Override
-    protected long transfer(final List<float[]> vectorsToTransfer, boolean append) throws IOException {
-        return JNICommons.storeVectorData(
+    protected void stage(final float[] vector, int position) {
+        if (stagedVectors == null) {
+            dimension = vector.length;
+            stagedVectors = new float[dimension * this.transferLimit];
+        }
+        System.arraycopy(vector, 0, stagedVectors, position * dimension, dimension);
+    }
+
+    @Override
+    protected long transfer(int vectorsToTransfer, boolean append) throws IOException {
+        return JNICommons.storeFlatVectorData(
             getVectorAddress(),
-            vectorsToTransfer.toArray(new float[][] {}),
-            (long) vectorsToTransfer.get(0).length * this.transferLimit,
+            stagedVectors,
+            vectorsToTransfer * dimension,
+            (long) dimension * this.transferLimit,
             append
         );
     }
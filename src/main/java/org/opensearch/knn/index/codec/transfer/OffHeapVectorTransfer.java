@@ -11,8 +11,6 @@ import org.opensearch.knn.index.vectorvalues.KNNVectorValues;
 
 import java.io.Closeable;
 import java.io.IOException;
-import java.util.ArrayList;
-import java.util.List;
 
 /**
  * <p>
@@ -31,11 +29,12 @@ public abstract class OffHeapVectorTransfer<T> implements Closeable {
     @Getter
     protected final int transferLimit;
 
-    private List<T> vectorsToTransfer;
+    // Number of vectors staged by the implementation and not transferred yet
+    private int vectorsToTransfer;
 
     public OffHeapVectorTransfer(int bytesPerVector, int totalVectorsToTransfer) {
         this.transferLimit = computeTransferLimit(bytesPerVector, totalVectorsToTransfer);
-        this.vectorsToTransfer = new ArrayList<>(this.transferLimit);
+        this.vectorsToTransfer = 0;
         this.vectorAddress = 0;
     }
 
@@ -52,17 +51,17 @@ public abstract class OffHeapVectorTransfer<T> implements Closeable {
      * @throws IOException
      */
     public boolean transfer(T vector, boolean append) throws IOException {
-        vectorsToTransfer.add(vector);
-        if (vectorsToTransfer.size() == this.transferLimit) {
+        stage(vector, vectorsToTransfer++);
+        if (vectorsToTransfer == this.transferLimit) {
             vectorAddress = transfer(vectorsToTransfer, append);
-            vectorsToTransfer.clear();
+            vectorsToTransfer = 0;
             return true;
         }
         return false;
     }
 
     /**
-     * Empties the {@link #vectorsToTransfer} if its not empty. Intended to be used before
+     * Transfers the staged vectors if there are any. Intended to be used before
      * closing the transfer
      *
      * @param append This indicates whether to append or rewrite the off-heap buffer
@@ -71,9 +70,9 @@ public abstract class OffHeapVectorTransfer<T> implements Closeable {
      */
     public boolean flush(boolean append) throws IOException {
         // flush before closing
-        if (!vectorsToTransfer.isEmpty()) {
+        if (vectorsToTransfer > 0) {
             vectorAddress = transfer(vectorsToTransfer, append);
-            vectorsToTransfer.clear();
+            vectorsToTransfer = 0;
             return true;
         }
         return false;
@@ -97,10 +96,26 @@ public abstract class OffHeapVectorTransfer<T> implements Closeable {
      */
     public void reset() {
         vectorAddress = 0;
-        vectorsToTransfer = null;
+        vectorsToTransfer = 0;
     }
 
     protected abstract void deallocate();
 
-    protected abstract long transfer(final List<T> vectorsToTransfer, boolean append) throws IOException;
+    /**
+     * Copies the vector into the staging buffer of the implementation. The vector may be reused by the caller once
+     * this returns.
+     *
+     * @param vector   float[] or byte[]
+     * @param position position of the vector in the current batch
+     */
+    protected abstract void stage(final T vector, int position);
+
+    /**
+     * Transfers the first vectorsToTransfer staged vectors off heap
+     *
+     * @param vectorsToTransfer number of staged vectors
+     * @param append This indicates whether to append or rewrite the off-heap buffer
+     * @return address of the off-heap buffer
+     */
+    protected abstract long transfer(int vectorsToTransfer, boolean append) throws IOException;
 }
@@ -0,0 +1,55 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package org.opensearch.knn.index.memory;
+
+import lombok.Getter;
+
+/**
+ * Bytes held by the structures of a loaded native index, by component, as counted by the native engine.
+ */
+@Getter
+public class NativeIndexMemoryUsage {
+    // Vector codes of flat storages and inverted lists
+    private final long codesBytes;
+    // HNSW graph
+    private final long neighborsBytes;
+    private final long levelsBytes;
+    private final long offsetsBytes;
+    // Labels of id maps and ids of inverted lists
+    private final long idMapBytes;
+    // Coarse quantizer of IVF indices, codebooks and tables of PQ and SQ encoders
+    private final long quantizerBytes;
+    // Precomputed table shared by all the indices of a model
+    private final long sharedStateBytes;
+    private final long otherBytes;
+
+    /**
+     * Constructor
+     *
+     * @param usage components in the order returned by {@link org.opensearch.knn.jni.JNIService#getIndexMemoryUsage}
+     */
+    public NativeIndexMemoryUsage(final long[] usage) {
+        if (usage.length != 8) {
+            throw new IllegalArgumentException("Expected 8 memory usage components, got " + usage.length);
+        }
+        this.codesBytes = usage[0];
+        this.neighborsBytes = usage[1];
+        this.levelsBytes = usage[2];
+        this.offsetsBytes = usage[3];
+        this.idMapBytes = usage[4];
+        this.quantizerBytes = usage[5];
+        this.sharedStateBytes = usage[6];
+        this.otherBytes = usage[7];
+    }
+
+    /**
+     * @return bytes owned by the index itself. The shared state is left out, as it is shared with other indices and
+     *         outlives them.
+     */
+    public long getIndexBytes() {
+        return codesBytes + neighborsBytes + levelsBytes + offsetsBytes + idMapBytes + quantizerBytes + otherBytes;
+    }
+}
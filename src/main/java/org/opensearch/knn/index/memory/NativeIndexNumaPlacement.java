@@ -0,0 +1,52 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package org.opensearch.knn.index.memory;
+
+import lombok.AllArgsConstructor;
+import lombok.Getter;
+
+import java.util.Arrays;
+import java.util.Locale;
+import java.util.stream.Collectors;
+
+/**
+ * Where the memory of native indices is placed across the NUMA nodes of the host once they are loaded. Placement only
+ * applies to Faiss indices on hosts with more than one node.
+ */
+@AllArgsConstructor
+public enum NativeIndexNumaPlacement {
+    // Leave the pages where the loading thread first touched them
+    NONE("none"),
+    // Interleave the pages of every index across all the nodes
+    INTERLEAVE("interleave"),
+    // Bind every index to a single node, assigning nodes to indices in turn
+    ROUND_ROBIN("round_robin");
+
+    @Getter
+    private final String name;
+
+    /**
+     * Get the placement from its name
+     *
+     * @param name name of the placement, e.g. "interleave"
+     * @return the placement with this name
+     */
+    public static NativeIndexNumaPlacement fromName(final String name) {
+        for (NativeIndexNumaPlacement placement : values()) {
+            if (placement.name.equals(name)) {
+                return placement;
+            }
+        }
+        throw new IllegalArgumentException(
+            String.format(
+                Locale.ROOT,
+                "Invalid native index NUMA placement [%s], expected one of %s",
+                name,
+                Arrays.stream(values()).map(NativeIndexNumaPlacement::getName).collect(Collectors.toList())
+            )
+        );
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package org.opensearch.knn.index.memory;
+
+import lombok.AllArgsConstructor;
+import lombok.Getter;
+
+import java.util.Arrays;
+import java.util.Locale;
+import java.util.stream.Collectors;
+
+/**
+ * How the warmup API brings native indices into memory once they are loaded. The values are shared with the JNI layer.
+ */
+@AllArgsConstructor
+public enum NativeIndexWarmupMode {
+    // Only load the index
+    NONE("none", -1),
+    // Advise the kernel that the pages of the index will be needed
+    ADVISE("advise", 0),
+    // Read every page of the graph, the vectors and the id map
+    TOUCH("touch", 1),
+    // Touch the index, then run a few queries made of indexed vectors
+    QUERY("query", 2);
+
+    @Getter
+    private final String name;
+    @Getter
+    private final int value;
+
+    /**
+     * Get the mode from its name
+     *
+     * @param name name of the mode, e.g. "touch"
+     * @return the mode with this name
+     */
+    public static NativeIndexWarmupMode fromName(final String name) {
+        for (NativeIndexWarmupMode mode : values()) {
+            if (mode.name.equals(name)) {
+                return mode;
+            }
+        }
+        throw new IllegalArgumentException(
+            String.format(
+                Locale.ROOT,
+                "Invalid native index warmup mode [%s], expected one of %s",
+                name,
+                Arrays.stream(values()).map(NativeIndexWarmupMode::getName).collect(Collectors.toList())
+            )
+        );
+    }
+}
@@ -15,10 +15,12 @@ import lombok.Getter;
 import lombok.Setter;
 import org.apache.lucene.index.LeafReaderContext;
 import org.opensearch.knn.common.featureflags.KNNFeatureFlags;
+import org.opensearch.knn.index.KNNSettings;
 import org.opensearch.common.concurrent.RefCountedReleasable;
 import org.opensearch.knn.index.VectorDataType;
 import org.opensearch.knn.index.engine.qframe.QuantizationConfig;
 import org.opensearch.knn.index.query.KNNWeight;
+import org.opensearch.knn.jni.JNICommons;
 import org.opensearch.knn.jni.JNIService;
 import org.opensearch.knn.index.engine.KNNEngine;
 
@@ -218,6 +220,11 @@ public interface NativeMemoryAllocation {
             if (sharedIndexState != null) {
                 SharedIndexStateManager.getInstance().release(sharedIndexState);
             }
+
+            // Runs on the close executor unless evictions are forced, so searches do not wait for the trim
+            if (KNNSettings.isNativeIndexFreeTrimEnabled()) {
+                JNICommons.trimNativeMemory();
+            }
         }
 
         @Override
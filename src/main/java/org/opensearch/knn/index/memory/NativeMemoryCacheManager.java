@@ -447,6 +447,16 @@ public class NativeMemoryCacheManager implements Closeable {
         }
     }
 
+    /**
+     * Returns the NativeMemoryAllocation of the given key if it is already loaded, without loading it otherwise.
+     *
+     * @param key Identifier of the entry
+     * @return NativeMemoryAllocation of the key, or null if it is not in the cache
+     */
+    public NativeMemoryAllocation getIfPresent(String key) {
+        return cache.getIfPresent(key);
+    }
+
     /**
      * Returns the NativeMemoryAllocation associated with given index
      * @param indexName name of OpenSearch index
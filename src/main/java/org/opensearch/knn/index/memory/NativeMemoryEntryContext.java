@@ -205,6 +205,9 @@ public abstract class NativeMemoryEntryContext<T extends NativeMemoryAllocation>
         public void close() {
             if (readStream != null) {
                 try {
+                    if (indexInputWithBuffer != null) {
+                        indexInputWithBuffer.stopReadAhead();
+                    }
                     readStream.close();
                     indexGraphFileOpened = false;
                 } catch (IOException e) {
@@ -13,7 +13,10 @@ package org.opensearch.knn.index.memory;
 
 import lombok.extern.log4j.Log4j2;
 import org.apache.lucene.store.Directory;
+import org.apache.lucene.store.FSDirectory;
+import org.apache.lucene.store.FilterDirectory;
 import org.opensearch.core.action.ActionListener;
+import org.opensearch.knn.index.KNNSettings;
 import org.opensearch.knn.index.codec.util.NativeMemoryCacheKeyHelper;
 import org.opensearch.knn.index.engine.qframe.QuantizationConfig;
 import org.opensearch.knn.index.util.IndexUtil;
@@ -24,8 +27,11 @@ import org.opensearch.knn.training.VectorReader;
 
 import java.io.Closeable;
 import java.io.IOException;
+import java.nio.file.Path;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicInteger;
 
 /**
  * Responsible for loading entries from native memory.
@@ -49,6 +55,10 @@ public interface NativeMemoryLoadStrategy<T extends NativeMemoryAllocation, U ex
         private static IndexLoadStrategy INSTANCE;
 
         private final ExecutorService executor;
+        // Node the next index is bound to under round robin placement, modulo the number of nodes
+        private final AtomicInteger nextNumaNode = new AtomicInteger();
+        // Set once it was logged that arenas are enabled but not supported by the JNI library
+        private final AtomicBoolean arenasUnsupportedLogged = new AtomicBoolean();
 
         /**
          * Get Singleton of this load strategy.
@@ -90,13 +100,103 @@ public interface NativeMemoryLoadStrategy<T extends NativeMemoryAllocation, U ex
                 throw new IllegalStateException("Index [" + indexEntryContext.getOpenSearchIndexName() + "] is not preloaded");
             }
             try (indexEntryContext) {
-                final long indexAddress = JNIService.loadIndex(
-                    indexEntryContext.indexInputWithBuffer,
-                    indexEntryContext.getParameters(),
-                    knnEngine
-                );
-                return createIndexAllocation(indexEntryContext, knnEngine, indexAddress, indexSizeKb, vectorFileName);
+                final long indexAddress = loadIndex(indexEntryContext, directory, vectorFileName, knnEngine);
+                placeIndex(indexAddress, knnEngine, vectorFileName);
+                final int loadedIndexSizeKb = getLoadedIndexSizeKb(indexAddress, knnEngine, vectorFileName, indexSizeKb);
+                return createIndexAllocation(indexEntryContext, knnEngine, indexAddress, loadedIndexSizeKb, vectorFileName);
+            }
+        }
+
+        private long loadIndex(
+            final NativeMemoryEntryContext.IndexEntryContext indexEntryContext,
+            final Directory directory,
+            final String vectorFileName,
+            final KNNEngine knnEngine
+        ) {
+            if (KNNEngine.FAISS == knnEngine) {
+                // Picked up by the loads started from now on, so that the setting applies without a restart
+                final boolean arenasEnabled = KNNSettings.isNativeIndexArenaEnabled();
+                if (JNIService.configureIndexArenas(arenasEnabled) == false
+                    && arenasEnabled
+                    && arenasUnsupportedLogged.compareAndSet(false, true)) {
+                    log.warn(
+                        "[{}] is enabled but the JNI library was built without KNN_INDEX_ARENAS or the platform does not support "
+                            + "arenas, indices are loaded on the heap",
+                        KNNSettings.KNN_NATIVE_INDEX_ARENA_ENABLED
+                    );
+                }
+                JNIService.configureCompactGraphs(KNNSettings.isFaissCompactGraphEnabled());
+            }
+            final Path localIndexPath = resolveLocalIndexPath(directory, vectorFileName, knnEngine);
+            if (localIndexPath != null) {
+                try {
+                    return JNIService.loadIndex(localIndexPath.toString(), indexEntryContext.getParameters(), knnEngine);
+                } catch (Exception e) {
+                    log.warn("Failed to load [{}] through a memory mapping, falling back to IndexInput", localIndexPath, e);
+                }
+            }
+            return JNIService.loadIndex(indexEntryContext.indexInputWithBuffer, indexEntryContext.getParameters(), knnEngine);
+        }
+
+        /**
+         * Move the memory of a freshly loaded Faiss index across the NUMA nodes as configured. Placement is best effort:
+         * the index stays usable where it was loaded if it cannot be moved.
+         */
+        private void placeIndex(final long indexAddress, final KNNEngine knnEngine, final String vectorFileName) {
+            final NativeIndexNumaPlacement placement = KNNSettings.getNativeIndexNumaPlacement();
+            if (KNNEngine.FAISS != knnEngine || placement == NativeIndexNumaPlacement.NONE) {
+                return;
+            }
+            try {
+                final int numaNodes = JNIService.getNumaNodeCount();
+                if (numaNodes <= 1) {
+                    return;
+                }
+                final int node = placement == NativeIndexNumaPlacement.ROUND_ROBIN
+                    ? Math.floorMod(nextNumaNode.getAndIncrement(), numaNodes)
+                    : -1;
+                final int placedNode = JNIService.placeIndex(indexAddress, knnEngine, node);
+                log.debug("Placed [{}] with {} placement, bound to node {}", vectorFileName, placement.getName(), placedNode);
+            } catch (Exception e) {
+                log.warn("Failed to place [{}] across NUMA nodes", vectorFileName, e);
+            }
+        }
+
+        /**
+         * Size of a loaded index in kilobytes. Faiss indices are walked natively, as the size of the file misses the
+         * structures rebuilt at load time and counts the ones skipped. Other engines are sized by their file.
+         */
+        private static int getLoadedIndexSizeKb(
+            final long indexAddress,
+            final KNNEngine knnEngine,
+            final String vectorFileName,
+            final int fileSizeKb
+        ) {
+            if (KNNEngine.FAISS != knnEngine) {
+                return fileSizeKb;
+            }
+            try {
+                final NativeIndexMemoryUsage usage = new NativeIndexMemoryUsage(JNIService.getIndexMemoryUsage(indexAddress, knnEngine));
+                return Math.toIntExact((usage.getIndexBytes() + 1023) / 1024);
+            } catch (Exception e) {
+                log.warn("Failed to measure the memory of [{}], sizing it by its file", vectorFileName, e);
+                return fileSizeKb;
+            }
+        }
+
+        /**
+         * Resolve the vector file to a path on the local file system, when the engine can load it from there and the
+         * directory is file system based. Returns null when the index has to be read through IndexInput.
+         */
+        private static Path resolveLocalIndexPath(final Directory directory, final String vectorFileName, final KNNEngine knnEngine) {
+            if (KNNEngine.FAISS != knnEngine || !KNNSettings.isFaissMmapLoadEnabled()) {
+                return null;
+            }
+            final Directory unwrapped = FilterDirectory.unwrap(directory);
+            if (!(unwrapped instanceof FSDirectory)) {
+                return null;
             }
+            return ((FSDirectory) unwrapped).getDirectory().resolve(vectorFileName);
         }
 
         private NativeMemoryAllocation.IndexAllocation createIndexAllocation(
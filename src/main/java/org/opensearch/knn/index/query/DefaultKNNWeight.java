@@ -11,6 +11,11 @@ import org.apache.lucene.index.LeafReaderContext;
 import org.apache.lucene.index.SegmentReader;
 import org.apache.lucene.search.TopDocs;
 import org.apache.lucene.search.Weight;
+import org.apache.lucene.util.BitSetIterator;
+import org.apache.lucene.util.FixedBitSet;
+import org.opensearch.common.lucene.Lucene;
+import org.opensearch.knn.common.FieldInfoExtractor;
+import org.opensearch.knn.index.KNNSettings;
 import org.opensearch.knn.index.SpaceType;
 import org.opensearch.knn.index.VectorDataType;
 import org.opensearch.knn.index.codec.util.KNNCodecUtil;
@@ -28,6 +33,10 @@ import java.util.concurrent.ExecutionException;
 
 import org.apache.lucene.util.BitSet;
 
+import static org.apache.lucene.search.DocIdSetIterator.NO_MORE_DOCS;
+import static org.opensearch.knn.common.KNNConstants.KNN_ENGINE;
+import static org.opensearch.knn.common.KNNConstants.MODEL_ID;
+import static org.opensearch.knn.common.KNNConstants.SPACE_TYPE;
 import static org.opensearch.knn.index.util.IndexUtil.getParametersAtLoading;
 import static org.opensearch.knn.plugin.stats.KNNCounter.GRAPH_QUERY_ERRORS;
 
@@ -39,11 +48,67 @@ import static org.opensearch.knn.plugin.stats.KNNCounter.GRAPH_QUERY_ERRORS;
 public class DefaultKNNWeight extends KNNWeight {
     private final NativeMemoryCacheManager nativeMemoryCacheManager;
 
+    // Native search parameters of the query, created by the first leaf and shared by the others when retained
+    private final Object searchParamsLock = new Object();
+    private boolean retainSearchParams;
+    private boolean querySearchParamsCreated;
+    private long querySearchParamsAddress;
+    private boolean closed;
+
     public DefaultKNNWeight(KNNQuery query, float boost, Weight filterWeight) {
         super(query, boost, filterWeight);
         this.nativeMemoryCacheManager = NativeMemoryCacheManager.getInstance();
     }
 
+    @Override
+    public void retainQueryResources() {
+        synchronized (searchParamsLock) {
+            retainSearchParams = true;
+        }
+    }
+
+    @Override
+    public void close() {
+        synchronized (searchParamsLock) {
+            if (closed) {
+                return;
+            }
+            closed = true;
+            if (querySearchParamsCreated) {
+                JNIService.freeSearchParams(querySearchParamsAddress);
+                querySearchParamsAddress = 0;
+            }
+        }
+    }
+
+    /**
+     * Native search parameters for a leaf. They are compiled once per query when the caller closes the weight after
+     * searching all the leaves, and once per leaf otherwise.
+     */
+    private long acquireSearchParams() {
+        synchronized (searchParamsLock) {
+            if (retainSearchParams == false) {
+                return JNIService.createSearchParams(knnQuery.getMethodParameters());
+            }
+            if (closed) {
+                throw new IllegalStateException("Search parameters of the query have already been released");
+            }
+            if (querySearchParamsCreated == false) {
+                querySearchParamsAddress = JNIService.createSearchParams(knnQuery.getMethodParameters());
+                querySearchParamsCreated = true;
+            }
+            return querySearchParamsAddress;
+        }
+    }
+
+    private void releaseSearchParams(final long searchParamsAddress) {
+        synchronized (searchParamsLock) {
+            if (retainSearchParams == false) {
+                JNIService.freeSearchParams(searchParamsAddress);
+            }
+        }
+    }
+
     @Override
     protected TopDocs doANNSearch(
         final LeafReaderContext context,
@@ -93,8 +158,10 @@ public class DefaultKNNWeight extends KNNWeight {
 
         // From cardinality select different filterIds type
         FilterIdsSelector filterIdsSelector = FilterIdsSelector.getFilterIdSelector(filterIdsBitSet, cardinality);
-        long[] filterIds = filterIdsSelector.getFilterIds();
         FilterIdsSelector.FilterIdsSelectorType filterType = filterIdsSelector.getFilterType();
+        final int resultWindow = k > 0 ? k : knnQuery.getContext().getMaxResultWindow();
+        final int[] resultIds = new int[resultWindow];
+        final float[] resultDistances = new float[resultWindow];
         // Now that we have the allocation, we need to readLock it
         indexAllocation.readLock();
         try {
@@ -104,70 +171,281 @@ public class DefaultKNNWeight extends KNNWeight {
             log.error("[KNN] Exception when allocation getting evicted: ", e);
             throw new RuntimeException("Failed to do kNN search when vector data structures getting evicted ", e);
         }
-        KNNQueryResult[] results;
+        int resultSize;
+        long searchParamsAddress = 0;
         try {
             if (indexAllocation.isClosed()) {
                 throw new RuntimeException("Index has already been closed");
             }
             final int[] parentIds = getParentIdsArray(context);
+            final boolean isBinaryQuery = knnQuery.getVectorDataType() == VectorDataType.BINARY
+                || quantizedVector != null && quantizationService.getVectorDataTypeForTransfer(fieldInfo) == VectorDataType.BINARY;
+            searchParamsAddress = acquireSearchParams();
+            final long batchMaxWaitNanos = KNNSettings.getFaissQueryBatchMaxWait().nanos();
             if (k > 0) {
-                if (knnQuery.getVectorDataType() == VectorDataType.BINARY
-                    || quantizedVector != null && quantizationService.getVectorDataTypeForTransfer(fieldInfo) == VectorDataType.BINARY) {
-                    results = JNIService.queryBinaryIndex(
+                if (batchMaxWaitNanos > 0 && KNNEngine.FAISS == knnEngine && filterIdsBitSet == null && parentIds == null) {
+                    resultSize = searchBatched(
+                        indexAllocation.getMemoryAddress(),
+                        isBinaryQuery,
+                        quantizedVector,
+                        k,
+                        searchParamsAddress,
+                        batchMaxWaitNanos,
+                        resultIds,
+                        resultDistances
+                    );
+                } else if (isBinaryQuery) {
+                    resultSize = JNIService.queryBinaryIndexWithFilterBuffer(
                         indexAllocation.getMemoryAddress(),
                         // TODO: In the future, quantizedVector can have other data types than byte
                         quantizedVector == null ? knnQuery.getByteQueryVector() : quantizedVector,
                         k,
-                        knnQuery.getMethodParameters(),
+                        searchParamsAddress,
                         knnEngine,
-                        filterIds,
+                        filterIdsSelector.getFilterBuffer(),
                         filterType.getValue(),
-                        parentIds
+                        parentIds,
+                        resultIds,
+                        resultDistances
                     );
                 } else {
-                    results = JNIService.queryIndex(
+                    resultSize = JNIService.queryIndexWithFilterBuffer(
                         indexAllocation.getMemoryAddress(),
                         knnQuery.getQueryVector(),
                         k,
-                        knnQuery.getMethodParameters(),
+                        searchParamsAddress,
                         knnEngine,
-                        filterIds,
+                        filterIdsSelector.getFilterBuffer(),
                         filterType.getValue(),
-                        parentIds
+                        parentIds,
+                        resultIds,
+                        resultDistances
                     );
                 }
+            } else if (isBinaryQuery) {
+                // Hamming distances of quantized vectors say nothing of the radius of the field space, so the closest ones
+                // are taken as candidates and compared to the radius once rescored with the full precision vectors
+                resultSize = JNIService.radiusQueryBinaryIndexWithFilterBuffer(
+                    indexAllocation.getMemoryAddress(),
+                    quantizedVector == null ? knnQuery.getByteQueryVector() : quantizedVector,
+                    quantizedVector == null ? knnQuery.getRadius() : Float.MAX_VALUE,
+                    searchParamsAddress,
+                    knnEngine,
+                    resultWindow,
+                    filterIdsSelector.getFilterBuffer(),
+                    filterType.getValue(),
+                    parentIds,
+                    resultIds,
+                    resultDistances
+                );
             } else {
-                results = JNIService.radiusQueryIndex(
+                resultSize = JNIService.radiusQueryIndexWithFilterBuffer(
                     indexAllocation.getMemoryAddress(),
                     knnQuery.getQueryVector(),
                     knnQuery.getRadius(),
-                    knnQuery.getMethodParameters(),
+                    searchParamsAddress,
                     knnEngine,
-                    knnQuery.getContext().getMaxResultWindow(),
-                    filterIds,
+                    resultWindow,
+                    filterIdsSelector.getFilterBuffer(),
                     filterType.getValue(),
-                    parentIds
+                    parentIds,
+                    resultIds,
+                    resultDistances
                 );
             }
         } catch (Exception e) {
             GRAPH_QUERY_ERRORS.increment();
             throw new RuntimeException(e);
         } finally {
+            releaseSearchParams(searchParamsAddress);
             indexAllocation.readUnlock();
             indexAllocation.decRef();
         }
 
+        if (k == 0 && quantizedVector != null) {
+            return rescoreRadialCandidates(context, resultIds, resultSize);
+        }
+
         TopApproxKnnCollector collector = new TopApproxKnnCollector(
-            k > 0 ? k : knnQuery.getContext().getMaxResultWindow(),
+            resultWindow,
             knnEngine,
             quantizedVector != null ? SpaceType.HAMMING : spaceType
         );
-        for (KNNQueryResult knnQueryResult : results) {
+        for (int i = 0; i < resultSize; i++) {
             collector.incVisitedCount(1);
-            collector.collect(knnQueryResult.getId(), knnQueryResult.getScore());
+            collector.collect(resultIds[i], resultDistances[i]);
         }
         TopDocs topDocs = collector.topDocs();
-        addExplainIfRequired(results, knnEngine, spaceType);
+        addExplainIfRequired(resultIds, resultDistances, resultSize, knnEngine, spaceType);
         return topDocs;
     }
+
+    /**
+     * Radial search of a quantized field, over the candidates found in its quantized index. The candidates of a nested
+     * field are already the closest child of each parent, so they are scored one by one.
+     */
+    private TopDocs rescoreRadialCandidates(final LeafReaderContext context, final int[] candidateIds, final int candidateCount)
+        throws IOException {
+        final FixedBitSet candidates = new FixedBitSet(context.reader().maxDoc());
+        for (int i = 0; i < candidateCount; i++) {
+            candidates.set(candidateIds[i]);
+        }
+        return exactSearch(
+            context,
+            ExactSearcher.ExactSearcherContext.builder()
+                .useQuantizedVectorsForSearch(false)
+                .field(knnQuery.getField())
+                .radius(knnQuery.getRadius())
+                .matchedDocsIterator(new BitSetIterator(candidates, candidateCount))
+                .numberOfMatchedDocs(candidateCount)
+                .floatQueryVector(knnQuery.getQueryVector())
+                .maxResultWindow(knnQuery.getContext().getMaxResultWindow())
+                .isMemoryOptimizedSearchEnabled(false)
+                .build()
+        );
+    }
+
+    /**
+     * Search the index together with the concurrent unfiltered searches of the same segment, in a single native call
+     */
+    private int searchBatched(
+        final long indexAddress,
+        final boolean isBinaryQuery,
+        final byte[] quantizedVector,
+        final int k,
+        final long searchParamsAddress,
+        final long batchMaxWaitNanos,
+        final int[] resultIds,
+        final float[] resultDistances
+    ) {
+        final NativeQueryBatcher.QueryType queryType;
+        final Object queryVector;
+        if (isBinaryQuery) {
+            queryType = NativeQueryBatcher.QueryType.BINARY;
+            queryVector = quantizedVector == null ? knnQuery.getByteQueryVector() : quantizedVector;
+        } else if (knnQuery.getVectorDataType() == VectorDataType.BYTE) {
+            // Byte queries are validated to hold byte values, a quarter of the floats is copied into the batch
+            final float[] floatQueryVector = knnQuery.getQueryVector();
+            final byte[] byteQueryVector = new byte[floatQueryVector.length];
+            for (int i = 0; i < floatQueryVector.length; i++) {
+                byteQueryVector[i] = (byte) floatQueryVector[i];
+            }
+            queryType = NativeQueryBatcher.QueryType.BYTE;
+            queryVector = byteQueryVector;
+        } else {
+            queryType = NativeQueryBatcher.QueryType.FLOAT;
+            queryVector = knnQuery.getQueryVector();
+        }
+        return NativeQueryBatcher.getInstance()
+            .search(
+                indexAddress,
+                queryType,
+                queryVector,
+                k,
+                knnQuery.getMethodParameters(),
+                searchParamsAddress,
+                batchMaxWaitNanos,
+                resultIds,
+                resultDistances
+            );
+    }
+
+    @Override
+    protected TopDocs doNativeExactSearch(final LeafReaderContext context, final BitSet filterBitSet, final int cardinality, final int k)
+        throws IOException {
+        // Nested documents are grouped by their parent, and memory optimized searches do not load the native index
+        if (knnQuery.getParentsFilter() != null || knnQuery.isMemoryOptimizedSearch() || knnQuery.getQueryVector() == null) {
+            return null;
+        }
+        final SegmentReader reader = Lucene.segmentReader(context.reader());
+        final FieldInfo fieldInfo = FieldInfoExtractor.getFieldInfo(reader, knnQuery.getField());
+        // Only float Faiss indices built without a model, which are never IVF, are scored by the native exact search.
+        // Quantized segments are searched over their quantized vectors by the exact searcher.
+        if (fieldInfo == null
+            || fieldInfo.getAttribute(MODEL_ID) != null
+            || KNNEngine.FAISS != KNNEngine.getEngine(fieldInfo.attributes().getOrDefault(KNN_ENGINE, KNNEngine.DEFAULT.getName()))
+            || VectorDataType.FLOAT != FieldInfoExtractor.extractVectorDataType(fieldInfo)
+            || SegmentLevelQuantizationInfo.build(reader, fieldInfo, knnQuery.getField()) != null) {
+            return null;
+        }
+        final List<String> engineFiles = KNNCodecUtil.getEngineFiles(
+            KNNEngine.FAISS.getExtension(),
+            knnQuery.getField(),
+            reader.getSegmentInfo().info
+        );
+        if (engineFiles.isEmpty()) {
+            return null;
+        }
+
+        // An exact search over a few documents is not worth loading the index, it is only used when already loaded
+        final String cacheKey = NativeMemoryCacheKeyHelper.constructCacheKey(engineFiles.get(0), reader.getSegmentInfo().info);
+        final NativeMemoryAllocation indexAllocation = nativeMemoryCacheManager.getIfPresent(cacheKey);
+        if (indexAllocation == null) {
+            return null;
+        }
+
+        // Sorted ids are mapped to the vectors of the index by binary search over its labels
+        final long[] filterIds = new long[cardinality];
+        final BitSetIterator filterIterator = new BitSetIterator(filterBitSet, cardinality);
+        int filterIdCount = 0;
+        for (int docId = filterIterator.nextDoc(); docId != NO_MORE_DOCS; docId = filterIterator.nextDoc()) {
+            filterIds[filterIdCount++] = docId;
+        }
+
+        final SpaceType spaceType = SpaceType.getSpace(fieldInfo.attributes().getOrDefault(SPACE_TYPE, SpaceType.L2.getValue()));
+        final int resultWindow = k > 0 ? k : knnQuery.getContext().getMaxResultWindow();
+        final int[] resultIds = new int[resultWindow];
+        final float[] resultDistances = new float[resultWindow];
+        indexAllocation.readLock();
+        try {
+            indexAllocation.incRef();
+        } catch (IllegalStateException e) {
+            // The index is being evicted, the exact searcher reads the vectors from the segment instead
+            indexAllocation.readUnlock();
+            return null;
+        }
+        int resultSize;
+        try {
+            if (indexAllocation.isClosed()) {
+                return null;
+            }
+            if (k > 0) {
+                resultSize = JNIService.exactSearchIndex(
+                    indexAllocation.getMemoryAddress(),
+                    knnQuery.getQueryVector(),
+                    k,
+                    KNNEngine.FAISS,
+                    filterIds,
+                    FilterIdsSelector.FilterIdsSelectorType.SORTED_ARRAY.getValue(),
+                    resultIds,
+                    resultDistances
+                );
+            } else {
+                resultSize = JNIService.exactRadiusSearchIndex(
+                    indexAllocation.getMemoryAddress(),
+                    knnQuery.getQueryVector(),
+                    knnQuery.getRadius(),
+                    KNNEngine.FAISS,
+                    resultWindow,
+                    filterIds,
+                    FilterIdsSelector.FilterIdsSelectorType.SORTED_ARRAY.getValue(),
+                    resultIds,
+                    resultDistances
+                );
+            }
+        } catch (Exception e) {
+            GRAPH_QUERY_ERRORS.increment();
+            throw new RuntimeException(e);
+        } finally {
+            indexAllocation.readUnlock();
+            indexAllocation.decRef();
+        }
+
+        TopApproxKnnCollector collector = new TopApproxKnnCollector(resultWindow, KNNEngine.FAISS, spaceType);
+        for (int i = 0; i < resultSize; i++) {
+            collector.incVisitedCount(1);
+            collector.collect(resultIds[i], resultDistances[i]);
+        }
+        return collector.topDocs();
+    }
 }
@@ -19,6 +19,8 @@ import org.apache.lucene.util.BitSetIterator;
 import org.apache.lucene.util.FixedBitSet;
 
 import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 
 /**
  * Util Class for filter ids selector
@@ -28,20 +30,49 @@ import java.io.IOException;
 public class FilterIdsSelector {
 
     /**
-     * When do ann query with filters, there are two types:
-     * BitMap using FixedBitSet, BATCH using a long array stands for filter result docids.
+     * When do ann query with filters, there are three types:
+     * BitMap using FixedBitSet, BATCH using a long array stands for filter result docids, SORTED_ARRAY using a long
+     * array of docids in ascending order, which the native side reads in place without building a hash set.
      */
     @AllArgsConstructor
     @Getter
     public enum FilterIdsSelectorType {
         BITMAP(0),
-        BATCH(1);
+        BATCH(1),
+        SORTED_ARRAY(2);
 
         private final int value;
     }
 
-    long[] filterIds;
-    private FilterIdsSelectorType filterType;
+    // Direct buffers are costly to allocate, so each search thread keeps one for filters of up to this size, which covers
+    // the bitmap of a segment of 8M documents. Larger filters get a buffer of their own, reclaimed once unreachable.
+    static final int MAX_POOLED_FILTER_BUFFER_BYTES = 1 << 20;
+    private static final ThreadLocal<ByteBuffer> FILTER_BUFFER = new ThreadLocal<>();
+
+    /**
+     * Filter as native order longs that native searches read in place, either the words of a bitmap or sorted ids, and
+     * null when there is no filter. Native searches take the number of longs from the capacity of the buffer. It may be
+     * the buffer of the calling thread, overwritten by its next filter, so it must not be used after the search it was
+     * built for.
+     */
+    private final ByteBuffer filterBuffer;
+    private final FilterIdsSelectorType filterType;
+
+    /**
+     * View of exactly numLongs native order longs, over the buffer of the calling thread when small enough
+     */
+    static ByteBuffer allocateFilterBuffer(final int numLongs) {
+        final int bytes = numLongs * Long.BYTES;
+        if (bytes > MAX_POOLED_FILTER_BUFFER_BYTES) {
+            return ByteBuffer.allocateDirect(bytes).order(ByteOrder.nativeOrder());
+        }
+        ByteBuffer buffer = FILTER_BUFFER.get();
+        if (buffer == null || buffer.capacity() < bytes) {
+            buffer = ByteBuffer.allocateDirect(bytes).order(ByteOrder.nativeOrder());
+            FILTER_BUFFER.set(buffer);
+        }
+        return buffer.slice(0, bytes).order(ByteOrder.nativeOrder());
+    }
 
     /**
      * This function takes a call on what ID Selector to use:
@@ -51,6 +82,7 @@ public class FilterIdsSelector {
      * IDSelectorArray	O(k)	O(k)          O(2k)
      * IDSelectorBatch	O(k)	O(1)          O(2k)
      * IDSelectorBitmap	O(n/8)	O(1)          O(k) n is the max value of id in the index
+     * SortedArray      O(k)    O(log k)      O(k) native side densifies it into a bitmap when n/64 &lt;= k
      *
      * TODO: We need to ideally decide when we can take another hit of K iterations in latency. Some facts:
      * an OpenSearch Index can have max segment size as 5GB which, which on a vector with dimension of 128 boils down to
@@ -68,7 +100,7 @@ public class FilterIdsSelector {
      *
      * Array Memory: Cardinality * Long.BYTES
      * BitSet Memory: MaxId / Byte.SIZE
-     * When Array Memory less than or equal to BitSet Memory return FilterIdsSelectorType.BATCH
+     * When Array Memory less than or equal to BitSet Memory return FilterIdsSelectorType.SORTED_ARRAY
      * Else return FilterIdsSelectorType.BITMAP;
      *
      * @param filterIdsBitSet Filter query result docs
@@ -76,35 +108,50 @@ public class FilterIdsSelector {
      * @return {@link FilterIdsSelector}
      */
     public static FilterIdsSelector getFilterIdSelector(final BitSet filterIdsBitSet, final int cardinality) throws IOException {
-        long[] filterIds;
+        ByteBuffer filterBuffer = null;
         FilterIdsSelector.FilterIdsSelectorType filterType;
         if (filterIdsBitSet == null) {
-            filterIds = null;
             filterType = FilterIdsSelector.FilterIdsSelectorType.BITMAP;
         } else if (filterIdsBitSet instanceof FixedBitSet) {
             /**
              * When filterIds is dense filter, using fixed bitset
              */
-            filterIds = ((FixedBitSet) filterIdsBitSet).getBits();
+            final long[] bits = ((FixedBitSet) filterIdsBitSet).getBits();
+            if (bits.length > 0) {
+                filterBuffer = allocateFilterBuffer(bits.length);
+                filterBuffer.asLongBuffer().put(bits);
+            }
             filterType = FilterIdsSelector.FilterIdsSelectorType.BITMAP;
         } else if ((cardinality * Long.BYTES * Byte.SIZE) <= filterIdsBitSet.length()) {
             /**
              * When filterIds is sparse bitset, using ram usage to decide FilterIdsSelectorType
              */
-            BitSetIterator bitSetIterator = new BitSetIterator(filterIdsBitSet, cardinality);
-            filterIds = new long[cardinality];
-            int idx = 0;
-            for (int docId = bitSetIterator.nextDoc(); docId != DocIdSetIterator.NO_MORE_DOCS; docId = bitSetIterator.nextDoc()) {
-                filterIds[idx++] = docId;
+            if (cardinality > 0) {
+                filterBuffer = allocateFilterBuffer(cardinality);
+                BitSetIterator bitSetIterator = new BitSetIterator(filterIdsBitSet, cardinality);
+                int idx = 0;
+                for (int docId = bitSetIterator.nextDoc(); docId != DocIdSetIterator.NO_MORE_DOCS; docId = bitSetIterator.nextDoc()) {
+                    filterBuffer.putLong(idx++ * Long.BYTES, docId);
+                }
             }
-            filterType = FilterIdsSelectorType.BATCH;
+            filterType = FilterIdsSelectorType.SORTED_ARRAY;
         } else {
-            FixedBitSet fixedBitSet = new FixedBitSet(filterIdsBitSet.length());
-            BitSetIterator sparseBitSetIterator = new BitSetIterator(filterIdsBitSet, cardinality);
-            fixedBitSet.or(sparseBitSetIterator);
-            filterIds = fixedBitSet.getBits();
+            // Same words as a FixedBitSet of the length of the filter, set in place
+            final int numWords = FixedBitSet.bits2words(filterIdsBitSet.length());
+            if (numWords > 0) {
+                filterBuffer = allocateFilterBuffer(numWords);
+                for (int word = 0; word < numWords; word++) {
+                    filterBuffer.putLong(word * Long.BYTES, 0L);
+                }
+                BitSetIterator sparseBitSetIterator = new BitSetIterator(filterIdsBitSet, cardinality);
+                int docId;
+                while ((docId = sparseBitSetIterator.nextDoc()) != DocIdSetIterator.NO_MORE_DOCS) {
+                    final int index = (docId >> 6) * Long.BYTES;
+                    filterBuffer.putLong(index, filterBuffer.getLong(index) | (1L << docId));
+                }
+            }
             filterType = FilterIdsSelector.FilterIdsSelectorType.BITMAP;
         }
-        return new FilterIdsSelector(filterIds, filterType);
+        return new FilterIdsSelector(filterBuffer, filterType);
     }
 }
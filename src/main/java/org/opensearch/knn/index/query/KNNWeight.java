@@ -42,6 +42,7 @@ import org.opensearch.knn.indices.ModelMetadata;
 import org.opensearch.knn.indices.ModelUtil;
 import org.opensearch.knn.plugin.stats.KNNCounter;
 
+import java.io.Closeable;
 import java.io.IOException;
 import java.util.Arrays;
 import java.util.List;
@@ -70,7 +71,7 @@ import static org.opensearch.knn.common.KNNConstants.VECTOR_DATA_TYPE_FIELD;
  * one is being used, user will get the same results.
  */
 @Log4j2
-public abstract class KNNWeight extends Weight {
+public abstract class KNNWeight extends Weight implements Closeable {
     protected static final TopDocs EMPTY_TOPDOCS = new TopDocs(new TotalHits(0, TotalHits.Relation.EQUAL_TO), new ScoreDoc[0]);
     private static ModelDao modelDao;
     private static ExactSearcher DEFAULT_EXACT_SEARCHER;
@@ -109,6 +110,18 @@ public abstract class KNNWeight extends Weight {
         KNNWeight.DEFAULT_EXACT_SEARCHER = exactSearcher;
     }
 
+    /**
+     * Keeps the resources created for the query, such as native search parameters, alive across leaves until
+     * {@link #close()}. Only callers that search all the leaves themselves, and close the weight once done, may call it.
+     */
+    public void retainQueryResources() {}
+
+    /**
+     * Releases the resources retained for the query once all of its leaves have been searched
+     */
+    @Override
+    public void close() {}
+
     @VisibleForTesting
     KnnExplanation getKnnExplanation() {
         return knnExplanation;
@@ -318,7 +331,7 @@ public abstract class KNNWeight extends Weight {
          * This improves the recall.
          */
         if (isFilteredExactSearchPreferred(cardinality)) {
-            TopDocs result = doExactSearch(context, new BitSetIterator(filterBitSet, cardinality), cardinality, k);
+            TopDocs result = doFilteredExactSearch(context, filterBitSet, cardinality, k);
             return new PerLeafResult(filterWeight == null ? null : filterBitSet, result);
         }
 
@@ -338,8 +351,9 @@ public abstract class KNNWeight extends Weight {
         // This is required if there are no native engine files or if approximate search returned
         // results less than K, though we have more than k filtered docs
         if (isExactSearchRequire(context, cardinality, topDocs.scoreDocs.length)) {
-            final BitSetIterator docs = filterWeight != null ? new BitSetIterator(filterBitSet, cardinality) : null;
-            TopDocs result = doExactSearch(context, docs, cardinality, k);
+            TopDocs result = filterWeight != null
+                ? doFilteredExactSearch(context, filterBitSet, cardinality, k)
+                : doExactSearch(context, null, cardinality, k);
             return new PerLeafResult(filterWeight == null ? null : filterBitSet, result);
         }
         return new PerLeafResult(filterWeight == null ? null : filterBitSet, topDocs);
@@ -384,6 +398,33 @@ public abstract class KNNWeight extends Weight {
         return BitSet.of(filterIterator, maxDoc);
     }
 
+    private TopDocs doFilteredExactSearch(final LeafReaderContext context, final BitSet filterBitSet, final int cardinality, final int k)
+        throws IOException {
+        StopWatch stopWatch = startStopWatch();
+        final TopDocs nativeResults = doNativeExactSearch(context, filterBitSet, cardinality, k);
+        if (nativeResults != null) {
+            stopStopWatchAndLog(stopWatch, "Native exact search", Lucene.segmentReader(context.reader()).getSegmentName());
+            return nativeResults;
+        }
+        return doExactSearch(context, new BitSetIterator(filterBitSet, cardinality), cardinality, k);
+    }
+
+    /**
+     * Exact search of the filtered documents scored by the native engine from the vectors its loaded index already
+     * holds, instead of reading them back from the segment.
+     *
+     * @param context LeafReaderContext
+     * @param filterBitSet Bit set of the filtered documents
+     * @param cardinality Number of filtered documents
+     * @param k The number of documents to be collected, 0 for a radial search
+     * @return results of the search, or null when the native engine cannot serve it and the exact searcher must be used
+     * @throws IOException
+     */
+    protected TopDocs doNativeExactSearch(final LeafReaderContext context, final BitSet filterBitSet, final int cardinality, final int k)
+        throws IOException {
+        return null;
+    }
+
     private TopDocs doExactSearch(
         final LeafReaderContext context,
         final DocIdSetIterator acceptedDocs,
@@ -394,8 +435,9 @@ public abstract class KNNWeight extends Weight {
             .parentsFilter(knnQuery.getParentsFilter())
             .k(k)
             // setting to true, so that if quantization details are present we want to do search on the quantized
-            // vectors as this flow is used in first pass of search.
-            .useQuantizedVectorsForSearch(true)
+            // vectors as this flow is used in first pass of search. Radial searches are not rescored, and their radius
+            // is in the space of the full precision vectors.
+            .useQuantizedVectorsForSearch(knnQuery.getRadius() == null)
             .field(knnQuery.getField())
             .radius(knnQuery.getRadius())
             .matchedDocsIterator(acceptedDocs)
@@ -516,15 +558,21 @@ public abstract class KNNWeight extends Weight {
         final int k
     ) throws IOException;
 
-    protected void addExplainIfRequired(final KNNQueryResult[] results, final KNNEngine knnEngine, final SpaceType spaceType) {
+    protected void addExplainIfRequired(
+        final int[] resultIds,
+        final float[] resultScores,
+        final int resultSize,
+        final KNNEngine knnEngine,
+        final SpaceType spaceType
+    ) {
         if (knnQuery.isExplain()) {
-            Arrays.stream(results).forEach(result -> {
+            for (int i = 0; i < resultSize; i++) {
                 if (KNNEngine.FAISS.getName().equals(knnEngine.getName()) && SpaceType.INNER_PRODUCT.equals(spaceType)) {
-                    knnExplanation.addRawScore(result.getId(), -1 * result.getScore());
+                    knnExplanation.addRawScore(resultIds[i], -1 * resultScores[i]);
                 } else {
-                    knnExplanation.addRawScore(result.getId(), result.getScore());
+                    knnExplanation.addRawScore(resultIds[i], resultScores[i]);
                 }
-            });
+            }
         }
     }
 
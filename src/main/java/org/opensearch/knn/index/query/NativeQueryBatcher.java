@@ -0,0 +1,295 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package org.opensearch.knn.index.query;
+
+import lombok.AllArgsConstructor;
+import lombok.EqualsAndHashCode;
+import lombok.Getter;
+import org.opensearch.knn.index.engine.KNNEngine;
+import org.opensearch.knn.jni.JNIService;
+
+import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Coalesces the concurrent top k searches of a loaded Faiss index into batches, each searched by a single native call.
+ * The searches of an msearch request, and concurrent searches of a shard in general, hit the same segments at about the
+ * same time. The first search of a batch waits for others with the same index, k and method parameters to join it, up to
+ * a maximum wait or until the batch is full, and then searches all of them at once on behalf of the others.
+ * <p>
+ * Filters and parent ids are shared by all the queries of a native batch, so only unfiltered searches of non nested
+ * fields are batched.
+ */
+public final class NativeQueryBatcher {
+
+    /**
+     * How the query vectors of a batch are passed to the index
+     */
+    public enum QueryType {
+        // float[] queries of float indices
+        FLOAT,
+        // byte[] queries of byte indices, widened to floats natively
+        BYTE,
+        // byte[] packed bit queries of binary indices
+        BINARY
+    }
+
+    /**
+     * Searches the queries of a batch with a single call, writing the results of query i to [i * k, (i + 1) * k) of ids
+     * and distances
+     */
+    @FunctionalInterface
+    interface BatchSearch {
+        void search(BatchKey key, Object[] queryVectors, int numQueries, long searchParamsAddress, int[] ids, float[] distances);
+    }
+
+    static final int MAX_BATCH_SIZE = 64;
+
+    private static final NativeQueryBatcher INSTANCE = new NativeQueryBatcher(NativeQueryBatcher::searchNative);
+
+    private final BatchSearch batchSearch;
+    // Batches still taking queries
+    private final Map<BatchKey, Batch> openBatches = new ConcurrentHashMap<>();
+
+    NativeQueryBatcher(final BatchSearch batchSearch) {
+        this.batchSearch = batchSearch;
+    }
+
+    public static NativeQueryBatcher getInstance() {
+        return INSTANCE;
+    }
+
+    /**
+     * Search the k nearest neighbors of a query together with the concurrent searches of the same index. The caller must
+     * keep the index loaded until this returns.
+     *
+     * @param indexPointer        pointer to the loaded index
+     * @param queryType           type of the query vector
+     * @param queryVector         float[] for {@link QueryType#FLOAT}, byte[] otherwise
+     * @param k                   neighbors to be returned
+     * @param methodParameters    method parameters of the query, searches only batch with the same ones
+     * @param searchParamsAddress native search parameters created from methodParameters, or 0
+     * @param maxWaitNanos        how long the first search of a batch waits for others to join
+     * @param resultIds           array of at least k entries receiving the neighbor ids
+     * @param resultDistances     array of at least k entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public int search(
+        final long indexPointer,
+        final QueryType queryType,
+        final Object queryVector,
+        final int k,
+        final Map<String, ?> methodParameters,
+        final long searchParamsAddress,
+        final long maxWaitNanos,
+        final int[] resultIds,
+        final float[] resultDistances
+    ) {
+        final BatchKey key = new BatchKey(indexPointer, queryType, k, methodParameters == null ? Map.of() : methodParameters);
+        while (true) {
+            final Batch batch = openBatches.computeIfAbsent(key, Batch::new);
+            final int slot = batch.join(queryVector);
+            if (slot < 0) {
+                // Full or already searching, the next search starts a new batch
+                openBatches.remove(key, batch);
+                continue;
+            }
+            if (slot == 0) {
+                batch.awaitQueries(System.nanoTime() + maxWaitNanos);
+                openBatches.remove(key, batch);
+                batch.searchAll(batchSearch, searchParamsAddress);
+            } else {
+                batch.awaitResults();
+            }
+            return batch.getResults(slot, resultIds, resultDistances);
+        }
+    }
+
+    private static void searchNative(
+        final BatchKey key,
+        final Object[] queryVectors,
+        final int numQueries,
+        final long searchParamsAddress,
+        final int[] ids,
+        final float[] distances
+    ) {
+        final int filterIdsType = FilterIdsSelector.FilterIdsSelectorType.BITMAP.getValue();
+        switch (key.queryType) {
+            case FLOAT:
+                JNIService.queryIndexBatch(
+                    key.indexPointer,
+                    concatenateFloats(queryVectors, numQueries),
+                    numQueries,
+                    key.k,
+                    searchParamsAddress,
+                    KNNEngine.FAISS,
+                    null,
+                    filterIdsType,
+                    null,
+                    ids,
+                    distances
+                );
+                break;
+            case BYTE:
+                JNIService.queryByteIndexBatch(
+                    key.indexPointer,
+                    concatenateBytes(queryVectors, numQueries),
+                    numQueries,
+                    key.k,
+                    searchParamsAddress,
+                    KNNEngine.FAISS,
+                    null,
+                    filterIdsType,
+                    null,
+                    ids,
+                    distances
+                );
+                break;
+            default:
+                JNIService.queryBinaryIndexBatch(
+                    key.indexPointer,
+                    concatenateBytes(queryVectors, numQueries),
+                    numQueries,
+                    key.k,
+                    searchParamsAddress,
+                    KNNEngine.FAISS,
+                    null,
+                    filterIdsType,
+                    null,
+                    ids,
+                    distances
+                );
+        }
+    }
+
+    private static float[] concatenateFloats(final Object[] queryVectors, final int numQueries) {
+        final int dimension = ((float[]) queryVectors[0]).length;
+        final float[] concatenated = new float[numQueries * dimension];
+        for (int i = 0; i < numQueries; i++) {
+            System.arraycopy((float[]) queryVectors[i], 0, concatenated, i * dimension, dimension);
+        }
+        return concatenated;
+    }
+
+    private static byte[] concatenateBytes(final Object[] queryVectors, final int numQueries) {
+        final int length = ((byte[]) queryVectors[0]).length;
+        final byte[] concatenated = new byte[numQueries * length];
+        for (int i = 0; i < numQueries; i++) {
+            System.arraycopy((byte[]) queryVectors[i], 0, concatenated, i * length, length);
+        }
+        return concatenated;
+    }
+
+    @AllArgsConstructor
+    @EqualsAndHashCode
+    @Getter
+    static final class BatchKey {
+        private final long indexPointer;
+        private final QueryType queryType;
+        private final int k;
+        private final Map<String, ?> methodParameters;
+    }
+
+    private static final class Batch {
+        private final BatchKey key;
+        private final Object[] queryVectors = new Object[MAX_BATCH_SIZE];
+        private int size;
+        // Set once the first search stops waiting, no query joins afterwards
+        private boolean closed;
+        private boolean done;
+        private int[] ids;
+        private float[] distances;
+        private RuntimeException failure;
+
+        private Batch(final BatchKey key) {
+            this.key = key;
+        }
+
+        // Returns the slot of the query in the batch, or -1 when the batch does not take queries anymore
+        private synchronized int join(final Object queryVector) {
+            if (closed || size == MAX_BATCH_SIZE) {
+                return -1;
+            }
+            queryVectors[size] = queryVector;
+            if (++size == MAX_BATCH_SIZE) {
+                notifyAll();
+            }
+            return size - 1;
+        }
+
+        // Waits until the batch is full or the deadline passes, and closes it
+        private synchronized void awaitQueries(final long deadlineNanos) {
+            boolean interrupted = false;
+            long remainingNanos;
+            while (size < MAX_BATCH_SIZE && (remainingNanos = deadlineNanos - System.nanoTime()) > 0) {
+                try {
+                    TimeUnit.NANOSECONDS.timedWait(this, remainingNanos);
+                } catch (InterruptedException e) {
+                    // Searches what joined so far instead of leaving the others waiting
+                    interrupted = true;
+                    break;
+                }
+            }
+            closed = true;
+            if (interrupted) {
+                Thread.currentThread().interrupt();
+            }
+        }
+
+        private synchronized void awaitResults() {
+            boolean interrupted = false;
+            while (done == false) {
+                try {
+                    wait();
+                } catch (InterruptedException e) {
+                    // The first search of the batch is searching this query as well, its results are on their way
+                    interrupted = true;
+                }
+            }
+            if (interrupted) {
+                Thread.currentThread().interrupt();
+            }
+        }
+
+        private void searchAll(final BatchSearch batchSearch, final long searchParamsAddress) {
+            final int numQueries;
+            synchronized (this) {
+                numQueries = size;
+            }
+            final int[] batchIds = new int[numQueries * key.k];
+            final float[] batchDistances = new float[numQueries * key.k];
+            RuntimeException batchFailure = null;
+            try {
+                batchSearch.search(key, queryVectors, numQueries, searchParamsAddress, batchIds, batchDistances);
+            } catch (RuntimeException e) {
+                batchFailure = e;
+            }
+            synchronized (this) {
+                ids = batchIds;
+                distances = batchDistances;
+                failure = batchFailure;
+                done = true;
+                notifyAll();
+            }
+        }
+
+        private synchronized int getResults(final int slot, final int[] resultIds, final float[] resultDistances) {
+            if (failure != null) {
+                throw new IllegalStateException("Batched search of " + size + " queries failed", failure);
+            }
+            final int offset = slot * key.k;
+            int resultSize = 0;
+            // Missing neighbors are padded with -1 at the end of the results of each query
+            while (resultSize < key.k && ids[offset + resultSize] != -1) {
+                resultSize++;
+            }
+            System.arraycopy(ids, offset, resultIds, 0, resultSize);
+            System.arraycopy(distances, offset, resultDistances, 0, resultSize);
+            return resultSize;
+        }
+    }
+}
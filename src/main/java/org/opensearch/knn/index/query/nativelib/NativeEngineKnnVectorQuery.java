@@ -59,8 +59,18 @@ public class NativeEngineKnnVectorQuery extends Query {
 
     @Override
     public Weight createWeight(IndexSearcher indexSearcher, ScoreMode scoreMode, float boost) throws IOException {
-        final IndexReader reader = indexSearcher.getIndexReader();
         final KNNWeight knnWeight = (KNNWeight) knnQuery.createWeight(indexSearcher, scoreMode, 1);
+        // All the leaves are searched before returning, so they share the resources of the query, released once done
+        knnWeight.retainQueryResources();
+        try {
+            return searchLeaves(indexSearcher, scoreMode, boost, knnWeight);
+        } finally {
+            knnWeight.close();
+        }
+    }
+
+    private Weight searchLeaves(IndexSearcher indexSearcher, ScoreMode scoreMode, float boost, KNNWeight knnWeight) throws IOException {
+        final IndexReader reader = indexSearcher.getIndexReader();
         List<LeafReaderContext> leafReaderContexts = reader.leaves();
         List<PerLeafResult> perLeafResults;
         RescoreContext rescoreContext = knnQuery.getRescoreContext();
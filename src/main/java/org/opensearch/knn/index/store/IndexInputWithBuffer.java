@@ -6,25 +6,62 @@
 package org.opensearch.knn.index.store;
 
 import lombok.NonNull;
+import lombok.extern.log4j.Log4j2;
 import org.apache.lucene.store.IndexInput;
+import org.opensearch.common.util.concurrent.OpenSearchExecutors;
 
 import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Future;
+import java.util.concurrent.SynchronousQueue;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
 
 /**
  * This class contains a Lucene's IndexInput with a reader buffer.
  * A Java reference of this class will be passed to native engines, then 'copyBytes' method will be
  * called by native engine via JNI API.
  * Therefore, this class servers as a read layer in native engines to read the bytes it wants.
+ *
+ * When direct memory is available, native engines read from a direct read-ahead buffer instead. It is made of two
+ * chunks: native code copies from one chunk in place through its address, while the next chunk is read ahead into the
+ * other one by a background thread. Native code only calls 'nextChunk' once it has consumed a whole chunk.
  */
+@Log4j2
 public class IndexInputWithBuffer {
+    private static final int READ_AHEAD_CHUNK_SIZE = 1024 * 1024;
+    // Threads are only kept while loads are running
+    private static final ExecutorService READ_AHEAD_EXECUTOR = new ThreadPoolExecutor(
+        0,
+        Integer.MAX_VALUE,
+        1,
+        TimeUnit.SECONDS,
+        new SynchronousQueue<>(),
+        OpenSearchExecutors.daemonThreadFactory("knn-index-read-ahead")
+    );
+
     private IndexInput indexInput;
     private long contentLength;
     // 64K buffer.
     private byte[] buffer = new byte[64 * 1024];
+    // Read by native engines, null when direct memory could not be allocated.
+    private final ByteBuffer readAheadBuffer;
+    private final ByteBuffer[] readAheadChunks;
+    // Chunk being read ahead, into readAheadChunks[nextChunk % 2].
+    private Future<Integer> pendingChunk;
+    private long nextChunk;
 
     public IndexInputWithBuffer(@NonNull IndexInput indexInput) {
         this.indexInput = indexInput;
         this.contentLength = indexInput.length();
+        this.readAheadBuffer = allocateReadAheadBuffer(contentLength);
+        this.readAheadChunks = readAheadBuffer == null
+            ? null
+            : new ByteBuffer[] {
+                readAheadBuffer.slice(0, readAheadBuffer.capacity() / 2),
+                readAheadBuffer.slice(readAheadBuffer.capacity() / 2, readAheadBuffer.capacity() / 2) };
     }
 
     /**
@@ -45,6 +82,84 @@ public class IndexInputWithBuffer {
         return contentLength - indexInput.getFilePointer();
     }
 
+    /**
+     * This method will be invoked in native engines via JNI API once they consumed the current chunk of the read-ahead
+     * buffer. It hands out the next chunk, which is usually already read, and starts reading ahead the chunk after it
+     * into the chunk native engines are done with.
+     *
+     * @return The number of bytes in the next chunk, 0 at the end of the input.
+     * @throws IOException
+     */
+    private int nextChunk() throws IOException {
+        final int readBytes = pendingChunk == null ? readChunk(readAheadChunks[chunkSlot(nextChunk)]) : awaitPendingChunk();
+        nextChunk++;
+
+        if (remainingBytes() > 0) {
+            final ByteBuffer chunk = readAheadChunks[chunkSlot(nextChunk)];
+            pendingChunk = READ_AHEAD_EXECUTOR.submit(() -> readChunk(chunk));
+        }
+        return readBytes;
+    }
+
+    /**
+     * Wait for the chunk being read ahead, if any. It must be called before the underlying IndexInput is closed.
+     */
+    public void stopReadAhead() {
+        if (pendingChunk == null) {
+            return;
+        }
+        try {
+            awaitPendingChunk();
+        } catch (IOException e) {
+            log.debug("Read-ahead of [{}] failed after loading stopped", indexInput, e);
+        }
+    }
+
+    private int readChunk(final ByteBuffer chunk) throws IOException {
+        final int chunkBytes = (int) Math.min(chunk.capacity(), remainingBytes());
+        chunk.clear();
+        int readBytes = 0;
+        while (readBytes < chunkBytes) {
+            final int copyBytes = Math.min(buffer.length, chunkBytes - readBytes);
+            indexInput.readBytes(buffer, 0, copyBytes);
+            chunk.put(buffer, 0, copyBytes);
+            readBytes += copyBytes;
+        }
+        return chunkBytes;
+    }
+
+    private int awaitPendingChunk() throws IOException {
+        final Future<Integer> chunk = pendingChunk;
+        pendingChunk = null;
+        try {
+            return chunk.get();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            throw new IOException("Interrupted while reading ahead " + indexInput, e);
+        } catch (ExecutionException e) {
+            if (e.getCause() instanceof IOException) {
+                throw (IOException) e.getCause();
+            }
+            throw new IOException("Failed to read ahead " + indexInput, e.getCause());
+        }
+    }
+
+    private static int chunkSlot(long chunk) {
+        return (int) (chunk & 1);
+    }
+
+    private static ByteBuffer allocateReadAheadBuffer(long contentLength) {
+        // Chunks never need to be larger than the file
+        final int chunkSize = (int) Math.max(1, Math.min(READ_AHEAD_CHUNK_SIZE, contentLength));
+        try {
+            return ByteBuffer.allocateDirect(2 * chunkSize);
+        } catch (OutOfMemoryError e) {
+            // Direct memory is exhausted, native engines fall back to the heap buffer
+            log.debug("Unable to allocate a read-ahead buffer, falling back to the heap buffer", e);
+            return null;
+        }
+    }
+
     @Override
     public String toString() {
         return "{indexInput=" + indexInput + ", len(buffer)=" + buffer.length + "}";
@@ -5,15 +5,19 @@
 
 package org.opensearch.knn.index.store;
 
+import lombok.extern.log4j.Log4j2;
 import org.apache.lucene.store.IndexOutput;
 
 import java.io.IOException;
 import java.io.InputStream;
+import java.nio.ByteBuffer;
+import java.nio.file.Path;
 
 /**
  * Wrapper around {@link IndexOutput} to perform writes in a buffered manner. This class is created per flush/merge, and may be used twice if
  * {@link org.opensearch.knn.index.codec.nativeindex.remote.RemoteIndexBuildStrategy} needs to fall back to a different build strategy.
  */
+@Log4j2
 public class IndexOutputWithBuffer {
     // Underlying `IndexOutput` obtained from Lucene's Directory.
     private IndexOutput indexOutput;
@@ -23,10 +27,37 @@ public class IndexOutputWithBuffer {
     // 64KB to accumulate bytes as possible to reduce the times of calling `writeBytes`.
     private static final int CHUNK_SIZE = 64 * 1024;
     private final byte[] buffer;
+    // Direct write buffer. When present, native engines copy bytes to its address without JNI critical sections, and only
+    // call `writeDirectBytes` once it is full. Null when direct memory could not be allocated.
+    private static final int DIRECT_BUFFER_SIZE = 1024 * 1024;
+    private final ByteBuffer directBuffer;
+    // zlib level of compressed indexes. The fastest level already shrinks neighbor lists and id maps well.
+    private static final int COMPRESSION_LEVEL = 1;
+    private final boolean compress;
+    // Disk space reserved at a time ahead of direct writes.
+    private static final long PREALLOCATION_STEP = 64L * 1024 * 1024;
+    // Local file native engines write to directly instead of going through `indexOutput`, null when they should not.
+    private String directFilePath;
+    private boolean preallocate;
+    // Length and checksum of the file handed back once a direct write is done, -1 until then.
+    private long directWriteLength = -1;
+    private long directWriteChecksum = -1;
+    // Whether native engines should renumber HNSW graph nodes for locality before writing them.
+    private boolean reorderGraph;
 
     public IndexOutputWithBuffer(IndexOutput indexOutput) {
+        this(indexOutput, false);
+    }
+
+    /**
+     * @param indexOutput   Output the index is written to
+     * @param compress      Whether native engines should compress the index they write. Only Faiss supports it.
+     */
+    public IndexOutputWithBuffer(IndexOutput indexOutput, boolean compress) {
         this.indexOutput = indexOutput;
         this.buffer = new byte[CHUNK_SIZE];
+        this.directBuffer = allocateDirectBuffer();
+        this.compress = compress;
     }
 
     // This method will be called in JNI layer which precisely knows
@@ -40,6 +71,98 @@ public class IndexOutputWithBuffer {
         }
     }
 
+    // This method will be called in JNI layer once it filled `length` bytes of the direct buffer.
+    public void writeDirectBytes(int length) {
+        try {
+            directBuffer.clear();
+            int written = 0;
+            while (written < length) {
+                final int copyBytes = Math.min(buffer.length, length - written);
+                directBuffer.get(buffer, 0, copyBytes);
+                indexOutput.writeBytes(buffer, 0, copyBytes);
+                written += copyBytes;
+            }
+        } catch (IOException e) {
+            throw new RuntimeException(e);
+        }
+    }
+
+    // This method will be called in JNI layer before writing an index. 0 means the index is written uncompressed.
+    private int compressionLevel() {
+        return compress ? COMPRESSION_LEVEL : 0;
+    }
+
+    /**
+     * Let native engines write straight to the given file, which must be the local file behind {@link IndexOutput}. They
+     * write the codec footer themselves, so {@link org.apache.lucene.codecs.CodecUtil#writeFooter} must not be called
+     * once {@link #isWrittenDirectly()} returns true.
+     *
+     * @param path          Local file behind the {@link IndexOutput}
+     * @param preallocate   Whether disk space should be reserved ahead of the written bytes
+     */
+    public void writeDirectlyTo(Path path, boolean preallocate) {
+        this.directFilePath = path.toString();
+        this.preallocate = preallocate;
+    }
+
+    /**
+     * Let native engines renumber the nodes of HNSW graphs in breadth-first order from the entry point before writing
+     * them, so that neighbors are laid out close to each other. The written index keeps the same format.
+     *
+     * @param reorderGraph  Whether graphs should be renumbered
+     */
+    public void reorderGraph(boolean reorderGraph) {
+        this.reorderGraph = reorderGraph;
+    }
+
+    // This method will be called in JNI layer before writing an index. 0 keeps the insertion order of the graph, 1 asks
+    // for the breadth-first locality order.
+    private int graphOrder() {
+        return reorderGraph ? 1 : 0;
+    }
+
+    // This method will be called in JNI layer before a direct write. 0 means no disk space is reserved ahead.
+    private long preallocationStep() {
+        return preallocate ? PREALLOCATION_STEP : 0;
+    }
+
+    // This method will be called in JNI layer once the index and the codec footer were written to `directFilePath`.
+    private void directWriteFinished(long length, long checksum) {
+        this.directWriteLength = length;
+        this.directWriteChecksum = checksum;
+    }
+
+    /**
+     * @return true if a native engine wrote the index and its footer straight to the local file
+     */
+    public boolean isWrittenDirectly() {
+        return directWriteLength >= 0;
+    }
+
+    /**
+     * @return Length of the directly written file, footer included
+     */
+    public long getDirectWriteLength() {
+        return directWriteLength;
+    }
+
+    /**
+     * @return Checksum written in the footer of the directly written file
+     */
+    public long getDirectWriteChecksum() {
+        return directWriteChecksum;
+    }
+
+    private static ByteBuffer allocateDirectBuffer() {
+        try {
+            return ByteBuffer.allocateDirect(DIRECT_BUFFER_SIZE);
+        } catch (OutOfMemoryError e) {
+            // Direct memory is exhausted, native engines fall back to the heap buffer
+            log.debug("Unable to allocate a direct write buffer, falling back to the heap buffer", e);
+            return null;
+        }
+    }
+
     /**
      * Writes to the {@link IndexOutput} by buffering bytes into a new buffer of custom size.
      *
@@ -64,6 +187,8 @@ public class IndexOutputWithBuffer {
      * @see IndexOutputWithBuffer#writeFromStreamWithBuffer(InputStream, int)
      */
     private void writeFromStreamWithBuffer(InputStream inputStream, byte[] outputBuffer) throws IOException {
+        // Bytes now go through `indexOutput`, a fallback build must not write to the file behind its back
+        directFilePath = null;
         int bytesRead = 0;
         // InputStream uses -1 indicates there are no more bytes to be read
         while (bytesRead != -1) {
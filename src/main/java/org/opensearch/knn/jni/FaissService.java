@@ -17,6 +17,7 @@ import org.opensearch.knn.index.query.KNNQueryResult;
 import org.opensearch.knn.index.store.IndexInputWithBuffer;
 import org.opensearch.knn.index.store.IndexOutputWithBuffer;
 
+import java.nio.ByteBuffer;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
 import java.util.Map;
@@ -129,13 +130,67 @@ class FaissService {
      */
     public static native void insertToByteIndex(int[] ids, long vectorsAddress, int dim, long indexAddress, int threadCount);
 
+    /**
+     * Starts an ingestion session adding the vectors submitted to it to a faiss index on a native background thread,
+     * so that the next batch of vectors can be transferred while the previous one is inserted.
+     *
+     * @param indexAddress address of native memory where index is stored
+     * @param dim dimension of the vector to be indexed
+     * @param threadCount number of threads to use for insertion
+     * @param maxPendingBatches number of submitted batches that may wait for or be under insertion
+     * @return address of the ingestion session
+     */
+    public static native long startIngestion(long indexAddress, int dim, int threadCount, int maxPendingBatches);
+
+    /**
+     * Starts an ingestion session for a binary faiss index. See {@link #startIngestion}
+     *
+     * @param indexAddress address of native memory where index is stored
+     * @param dim dimension of the vector to be indexed
+     * @param threadCount number of threads to use for insertion
+     * @param maxPendingBatches number of submitted batches that may wait for or be under insertion
+     * @return address of the ingestion session
+     */
+    public static native long startBinaryIngestion(long indexAddress, int dim, int threadCount, int maxPendingBatches);
+
+    /**
+     * Starts an ingestion session for a byte faiss index. See {@link #startIngestion}
+     *
+     * @param indexAddress address of native memory where index is stored
+     * @param dim dimension of the vector to be indexed
+     * @param threadCount number of threads to use for insertion
+     * @param maxPendingBatches number of submitted batches that may wait for or be under insertion
+     * @return address of the ingestion session
+     */
+    public static native long startByteIngestion(long indexAddress, int dim, int threadCount, int maxPendingBatches);
+
+    /**
+     * Queues a batch of vectors for insertion by an ingestion session, blocking until the session has room for it.
+     * The memory at vectorsAddress must not be reused or freed until a later batch is submitted or the session is
+     * finished. Throws if a previously submitted batch failed to be inserted.
+     *
+     * @param sessionAddress address of the ingestion session
+     * @param ids ids of documents
+     * @param vectorsAddress address of native memory where vectors are stored
+     */
+    public static native void submitToIngestion(long sessionAddress, int[] ids, long vectorsAddress);
+
+    /**
+     * Waits for an ingestion session to insert all submitted batches and frees it. Throws if a batch failed to be
+     * inserted.
+     *
+     * @param sessionAddress address of the ingestion session
+     */
+    public static native void finishIngestion(long sessionAddress);
+
     /**
      * Writes a faiss index.
      *
      * NOTE: This will always free the index. Do not call free after this.
      *
      * @param indexAddress address of native memory where index is stored
-     * @param output Index output wrapper having Lucene's IndexOutput to be used to flush bytes in native engines.
+     * @param output Index output wrapper having Lucene's IndexOutput to be used to flush bytes in native engines. The
+     *               index is compressed if the wrapper asks for it.
      */
     public static native void writeIndex(long indexAddress, IndexOutputWithBuffer output);
 
@@ -217,7 +272,7 @@ class FaissService {
     );
 
     /**
-     * Load an index into memory
+     * Load an index into memory. The file is read through a memory mapping where the platform supports it.
      *
      * @param indexPath path to index file
      * @return pointer to location in memory the index resides in
@@ -227,6 +282,7 @@ class FaissService {
     /**
      * Load an index into memory via a wrapping having Lucene's IndexInput.
      * Instead of directly accessing an index path, this will make Faiss delegate IndexInput to load bytes.
+     * Compressed indexes are detected by their header and decompressed while loading.
      *
      * @param readStream IndexInput wrapper having a Lucene's IndexInput reference.
      * @return pointer to location in memory the index resides in
@@ -234,7 +290,7 @@ class FaissService {
     public static native long loadIndexWithStream(IndexInputWithBuffer readStream);
 
     /**
-     * Load a binary index into memory
+     * Load a binary index into memory. The file is read through a memory mapping where the platform supports it.
      *
      * @param indexPath path to index file
      * @return pointer to location in memory the index resides in
@@ -340,6 +396,60 @@ class FaissService {
         int[] parentIds
     );
 
+    /**
+     * Query an index with filter using native search parameters, reading the filter in place from a direct buffer
+     * instead of copying it out of a long array, and write the ids and scores of the neighbors into the given arrays
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param k neighbors to be returned
+     * @param searchParamsAddress address of the native search parameters, or 0 to use the index defaults
+     * @param filterBuffer direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType type of filter ids
+     * @param parentIds list of parent doc ids when the knn field is a nested field
+     * @param resultIds array of at least k entries receiving the neighbor ids
+     * @param resultDistances array of at least k entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public static native int queryIndexWithFilterBuffer(
+        long indexPointer,
+        float[] queryVector,
+        int k,
+        long searchParamsAddress,
+        ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    );
+
+    /**
+     * Query a binary index with filter using native search parameters, reading the filter in place from a direct
+     * buffer, and write the ids and scores of the neighbors into the given arrays
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param k neighbors to be returned
+     * @param searchParamsAddress address of the native search parameters, or 0 to use the index defaults
+     * @param filterBuffer direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType type of filter ids
+     * @param parentIds list of parent doc ids when the knn field is a nested field
+     * @param resultIds array of at least k entries receiving the neighbor ids
+     * @param resultDistances array of at least k entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public static native int queryBinaryIndexWithFilterBuffer(
+        long indexPointer,
+        byte[] queryVector,
+        int k,
+        long searchParamsAddress,
+        ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    );
+
     /**
      * Query a binary index with filter
      *
@@ -359,6 +469,208 @@ class FaissService {
         int[] parentIds
     );
 
+    /**
+     * Query an index with a batch of query vectors in a single native call. The k nearest neighbors of query i are
+     * written to [i * k, (i + 1) * k) of resultIds and resultDistances. Missing neighbors are padded with id -1.
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVectors query vectors laid out one after another
+     * @param numQueries number of query vectors
+     * @param k neighbors to be returned per query
+     * @param searchParamsAddress address of the native search parameters, or 0 to use the index defaults
+     * @param filterBuffer direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType type of filter ids
+     * @param parentIds list of parent doc ids when the knn field is a nested field
+     * @param resultIds array of at least numQueries * k entries receiving the neighbor ids
+     * @param resultDistances array of at least numQueries * k entries receiving the neighbor distances
+     */
+    public static native void queryIndexBatch(
+        long indexPointer,
+        float[] queryVectors,
+        int numQueries,
+        int k,
+        long searchParamsAddress,
+        ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    );
+
+    /**
+     * Query a byte index with a batch of query vectors in a single native call. The k nearest neighbors of query i are
+     * written to [i * k, (i + 1) * k) of resultIds and resultDistances. Missing neighbors are padded with id -1.
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVectors query vectors laid out one after another as signed bytes
+     * @param numQueries number of query vectors
+     * @param k neighbors to be returned per query
+     * @param searchParamsAddress address of the native search parameters, or 0 to use the index defaults
+     * @param filterBuffer direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType type of filter ids
+     * @param parentIds list of parent doc ids when the knn field is a nested field
+     * @param resultIds array of at least numQueries * k entries receiving the neighbor ids
+     * @param resultDistances array of at least numQueries * k entries receiving the neighbor distances
+     */
+    public static native void queryByteIndexBatch(
+        long indexPointer,
+        byte[] queryVectors,
+        int numQueries,
+        int k,
+        long searchParamsAddress,
+        ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    );
+
+    /**
+     * Query a binary index with a batch of query vectors in a single native call. The k nearest neighbors of query i are
+     * written to [i * k, (i + 1) * k) of resultIds and resultDistances. Missing neighbors are padded with id -1.
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVectors query vectors laid out one after another as packed bits
+     * @param numQueries number of query vectors
+     * @param k neighbors to be returned per query
+     * @param searchParamsAddress address of the native search parameters, or 0 to use the index defaults
+     * @param filterBuffer direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType type of filter ids
+     * @param parentIds list of parent doc ids when the knn field is a nested field
+     * @param resultIds array of at least numQueries * k entries receiving the neighbor ids
+     * @param resultDistances array of at least numQueries * k entries receiving the neighbor distances
+     */
+    public static native void queryBinaryIndexBatch(
+        long indexPointer,
+        byte[] queryVectors,
+        int numQueries,
+        int k,
+        long searchParamsAddress,
+        ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    );
+
+    /**
+     * Exact search of the k nearest neighbors among the vectors of an index that pass the filter, scored natively
+     * from the vectors held by the loaded index instead of being read from the segment. Only HNSW and flat float
+     * indices are supported.
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param k neighbors to be returned
+     * @param filterIds list of doc ids to include in the query result, or null to score every vector
+     * @param filterIdsType type of filter ids
+     * @param resultIds array of at least k entries receiving the neighbor ids
+     * @param resultDistances array of at least k entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public static native int exactSearchWithFilter(
+        long indexPointer,
+        float[] queryVector,
+        int k,
+        long[] filterIds,
+        int filterIdsType,
+        int[] resultIds,
+        float[] resultDistances
+    );
+
+    /**
+     * Exact range search among the vectors of an index that pass the filter, scored natively from the vectors held by
+     * the loaded index
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param radius search within radius threshold
+     * @param indexMaxResultWindow maximum number of results to return
+     * @param filterIds list of doc ids to include in the query result, or null to score every vector
+     * @param filterIdsType type of filter ids
+     * @param resultIds array of at least indexMaxResultWindow entries receiving the neighbor ids
+     * @param resultDistances array of at least indexMaxResultWindow entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public static native int exactRangeSearchWithFilter(
+        long indexPointer,
+        float[] queryVector,
+        float radius,
+        int indexMaxResultWindow,
+        long[] filterIds,
+        int filterIdsType,
+        int[] resultIds,
+        float[] resultDistances
+    );
+
+    /**
+     * Warm up a loaded index, so that the first queries against it do not pay the page faults and cache misses of a
+     * cold index
+     *
+     * @param indexPointer pointer to the loaded index
+     * @param mode         value of a {@link org.opensearch.knn.index.memory.NativeIndexWarmupMode} other than NONE
+     * @return bytes of the index that were warmed up, followed by the time it took in nanoseconds
+     */
+    public static native long[] warmIndex(long indexPointer, int mode);
+
+    /**
+     * Count the bytes held by the structures of a loaded index
+     *
+     * @param indexPointer pointer to the loaded index
+     * @return bytes of the codes, neighbors, levels, offsets, id map, quantizer, shared state and other structures
+     */
+    public static native long[] getIndexMemoryUsage(long indexPointer);
+
+    /**
+     * Move the memory of a loaded index to a NUMA node, or interleave it across all the nodes
+     *
+     * @param indexPointer pointer to the loaded index
+     * @param node         node to bind the index to, -1 to interleave it
+     * @return node the index is bound to afterwards, -1 when it is not bound to a single node
+     */
+    public static native int placeIndex(long indexPointer, int node);
+
+    /**
+     * Get the NUMA node a loaded index was bound to by {@link #placeIndex(long, int)}
+     *
+     * @param indexPointer pointer to the loaded index
+     * @return node of the index, -1 when it is not bound to a single node
+     */
+    public static native int getIndexNumaNode(long indexPointer);
+
+    /**
+     * Get the number of NUMA nodes of the host
+     *
+     * @return number of nodes, 1 when the host has a single node or when it cannot be told
+     */
+    public static native int getNumaNodeCount();
+
+    /**
+     * Set whether the indices loaded from now on are read into an arena of their own, so that freeing an index unmaps
+     * all of its memory at once. Indices are loaded on the heap when arenas are not supported, as when the library was
+     * built without KNN_INDEX_ARENAS.
+     *
+     * @param enabled whether to use arenas
+     * @return whether the indices loaded from now on use arenas, false if they are not supported
+     */
+    public static native boolean configureIndexArenas(boolean enabled);
+
+    /**
+     * Set whether the HNSW graphs of the indices loaded from now on are converted to compact neighbor lists, which are
+     * decoded as the graph is searched. Only HNSW indices with flat, SQ, PQ or binary storage are converted.
+     *
+     * @param enabled whether to compact graphs
+     */
+    public static native void configureCompactGraphs(boolean enabled);
+
+    /**
+     * Get the statistics of the arena of a loaded index
+     *
+     * @param indexPointer pointer to the loaded index
+     * @return mapped bytes, live bytes, live allocations, chunks and large allocations of the arena, all 0 if the index
+     *         has no arena
+     */
+    public static native long[] getIndexArenaStats(long indexPointer);
+
     /**
      * Free native memory pointer
      */
@@ -431,6 +743,65 @@ class FaissService {
         int[] parentIds
     );
 
+    /**
+     * Range search index with filter using native search parameters, reading the filter in place from a direct
+     * buffer, and write the ids and scores of the neighbors into the given arrays
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param radius search within radius threshold
+     * @param searchParamsAddress address of the native search parameters, or 0 to use the index defaults
+     * @param indexMaxResultWindow maximum number of results to return
+     * @param filterBuffer direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType type of filter ids
+     * @param parentIds list of parent doc ids when the knn field is a nested field
+     * @param resultIds array of at least indexMaxResultWindow entries receiving the neighbor ids
+     * @param resultDistances array of at least indexMaxResultWindow entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public static native int rangeSearchIndexWithFilterBuffer(
+        long indexPointer,
+        float[] queryVector,
+        float radius,
+        long searchParamsAddress,
+        int indexMaxResultWindow,
+        ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    );
+
+    /**
+     * Range search binary index with filter using native search parameters, reading the filter in place from a direct
+     * buffer, and write the ids and hamming distances of the neighbors into the given arrays. The neighbors are the
+     * vectors whose hamming distance to the query is at most the radius.
+     *
+     * @param indexPointer pointer to binary index in memory
+     * @param queryVector binary vector to be used for query
+     * @param radius largest hamming distance of the neighbors, a negative radius matches no vector
+     * @param searchParamsAddress address of the native search parameters, or 0 to use the index defaults
+     * @param indexMaxResultWindow maximum number of results to return, the closest neighbors are kept
+     * @param filterBuffer direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType type of filter ids
+     * @param parentIds list of parent doc ids when the knn field is a nested field
+     * @param resultIds array of at least indexMaxResultWindow entries receiving the neighbor ids
+     * @param resultDistances array of at least indexMaxResultWindow entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public static native int rangeSearchBinaryIndexWithFilterBuffer(
+        long indexPointer,
+        byte[] queryVector,
+        float radius,
+        long searchParamsAddress,
+        int indexMaxResultWindow,
+        ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    );
+
     /**
      * Range search index
      *
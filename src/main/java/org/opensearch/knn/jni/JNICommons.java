@@ -13,6 +13,7 @@ package org.opensearch.knn.jni;
 
 import org.opensearch.knn.common.KNNConstants;
 
+import java.nio.ByteBuffer;
 import java.security.AccessController;
 import java.security.PrivilegedAction;
 
@@ -151,6 +152,108 @@ public class JNICommons {
      */
     public static native long storeByteVectorData(long memoryAddress, byte[][] data, long initialCapacity, boolean append);
 
+    /**
+     * Same as {@link JNICommons#storeVectorData(long, float[][], long, boolean)}, but takes the vectors as one flat array
+     * of rows*columns elements. The first length elements are copied to native memory in a single copy, without a JNI
+     * call per vector.
+     *
+     * <p>
+     * The function is not threadsafe. If multiple threads are trying to insert on same memory location, then it can
+     * lead to data corruption.
+     * </p>
+     *
+     * @param memoryAddress   The address of the memory location where data will be stored.
+     * @param data            flat float array containing data to be stored in native memory.
+     * @param length          number of elements of data to store.
+     * @param initialCapacity The initial capacity of the memory location.
+     * @param append          append the data or rewrite the memory location
+     * @return memory address where the data is stored.
+     */
+    public static native long storeFlatVectorData(long memoryAddress, float[] data, int length, long initialCapacity, boolean append);
+
+    /**
+     * Same as {@link JNICommons#storeBinaryVectorData(long, byte[][], long, boolean)}, but takes the vectors as one flat
+     * array. See {@link JNICommons#storeFlatVectorData(long, float[], int, long, boolean)}.
+     *
+     * @param memoryAddress   The address of the memory location where data will be stored.
+     * @param data            flat byte array containing binary data to be stored in native memory.
+     * @param length          number of elements of data to store.
+     * @param initialCapacity The initial capacity of the memory location.
+     * @param append          append the data or rewrite the memory location
+     * @return memory address where the data is stored.
+     */
+    public static native long storeFlatBinaryVectorData(long memoryAddress, byte[] data, int length, long initialCapacity, boolean append);
+
+    /**
+     * Same as {@link JNICommons#storeByteVectorData(long, byte[][], long, boolean)}, but takes the vectors as one flat
+     * array. See {@link JNICommons#storeFlatVectorData(long, float[], int, long, boolean)}.
+     *
+     * @param memoryAddress   The address of the memory location where data will be stored.
+     * @param data            flat byte array containing byte data to be stored in native memory.
+     * @param length          number of elements of data to store.
+     * @param initialCapacity The initial capacity of the memory location.
+     * @param append          append the data or rewrite the memory location
+     * @return memory address where the data is stored.
+     */
+    public static native long storeFlatByteVectorData(long memoryAddress, byte[] data, int length, long initialCapacity, boolean append);
+
+    /**
+     * Same as {@link JNICommons#storeFlatVectorData(long, float[], int, long, boolean)}, but copies the vectors from a
+     * direct buffer of native order floats. The buffer is read from its start, its position and limit are ignored.
+     *
+     * @param memoryAddress   The address of the memory location where data will be stored.
+     * @param data            direct buffer containing data to be stored in native memory.
+     * @param length          number of floats of data to store.
+     * @param initialCapacity The initial capacity of the memory location.
+     * @param append          append the data or rewrite the memory location
+     * @return memory address where the data is stored.
+     */
+    public static native long storeVectorDataFromBuffer(
+        long memoryAddress,
+        ByteBuffer data,
+        long length,
+        long initialCapacity,
+        boolean append
+    );
+
+    /**
+     * Same as {@link JNICommons#storeFlatBinaryVectorData(long, byte[], int, long, boolean)}, but copies the vectors
+     * from a direct buffer. The buffer is read from its start, its position and limit are ignored.
+     *
+     * @param memoryAddress   The address of the memory location where data will be stored.
+     * @param data            direct buffer containing binary data to be stored in native memory.
+     * @param length          number of bytes of data to store.
+     * @param initialCapacity The initial capacity of the memory location.
+     * @param append          append the data or rewrite the memory location
+     * @return memory address where the data is stored.
+     */
+    public static native long storeBinaryVectorDataFromBuffer(
+        long memoryAddress,
+        ByteBuffer data,
+        long length,
+        long initialCapacity,
+        boolean append
+    );
+
+    /**
+     * Same as {@link JNICommons#storeFlatByteVectorData(long, byte[], int, long, boolean)}, but copies the vectors from
+     * a direct buffer. The buffer is read from its start, its position and limit are ignored.
+     *
+     * @param memoryAddress   The address of the memory location where data will be stored.
+     * @param data            direct buffer containing byte data to be stored in native memory.
+     * @param length          number of bytes of data to store.
+     * @param initialCapacity The initial capacity of the memory location.
+     * @param append          append the data or rewrite the memory location
+     * @return memory address where the data is stored.
+     */
+    public static native long storeByteVectorDataFromBuffer(
+        long memoryAddress,
+        ByteBuffer data,
+        long length,
+        long initialCapacity,
+        boolean append
+    );
+
     /**
      * Free up the memory allocated for the data stored in memory address. This function should be used with the memory
      * address returned by {@link JNICommons#storeVectorData(long, float[][], long, boolean)}
@@ -189,4 +292,47 @@ public class JNICommons {
      * @param memoryAddress address to be freed.
      */
     public static native void freeByteVectorData(long memoryAddress);
+
+    /**
+     * Configure the native pool of slabs backing the vector data stored through the store*VectorData functions.
+     * Slabs released by index builds are kept for reuse by later builds, up to maxPooledBytes.
+     *
+     * @param maxPooledBytes maximum number of bytes kept in the pool. 0 disables pooling.
+     * @param useHugePages   whether slabs of 2MB and more should be backed by transparent huge pages. This is best
+     *                       effort and has no effect on platforms without madvise(MADV_HUGEPAGE).
+     */
+    public static native void configureVectorBufferPool(long maxPooledBytes, boolean useHugePages);
+
+    /**
+     * Get the statistics of the native vector buffer pool.
+     *
+     * @return long array of [pooled bytes, pooled slabs, used bytes, max pooled bytes, hits, misses]
+     */
+    public static native long[] getVectorBufferPoolStats();
+
+    /**
+     * Hand the free memory of the native allocator back to the operating system, such as the memory of evicted indices
+     * that the allocator keeps for reuse. This walks all the allocator arenas and can take a while on large heaps.
+     *
+     * @return true if memory was released, false if there was none to release or the allocator cannot be trimmed
+     */
+    public static native boolean trimNativeMemory();
+
+    /**
+     * Create native search parameters directly from primitive values. Negative values leave the parameter unset, so
+     * the value the index was built with is used. The returned address must be released with
+     * {@link JNICommons#freeSearchParams(long)}.
+     *
+     * @param efSearch query time ef_search, or -1 if not set.
+     * @param nprobes  query time nprobes, or -1 if not set.
+     * @return memory address of the native search parameters.
+     */
+    public static native long createSearchParams(int efSearch, int nprobes);
+
+    /**
+     * Free up the native search parameters stored in memory address.
+     *
+     * @param searchParamsAddress address to be freed.
+     */
+    public static native void freeSearchParams(long searchParamsAddress);
 }
@@ -15,11 +15,13 @@ import org.apache.commons.lang.ArrayUtils;
 import org.opensearch.common.Nullable;
 import org.opensearch.knn.common.KNNConstants;
 import org.opensearch.knn.index.engine.KNNEngine;
+import org.opensearch.knn.index.memory.NativeIndexWarmupMode;
 import org.opensearch.knn.index.query.KNNQueryResult;
 import org.opensearch.knn.index.store.IndexInputWithBuffer;
 import org.opensearch.knn.index.store.IndexOutputWithBuffer;
 import org.opensearch.knn.index.util.IndexUtil;
 
+import java.nio.ByteBuffer;
 import java.util.Locale;
 import java.util.Map;
 
@@ -90,6 +92,78 @@ public class JNIService {
         );
     }
 
+    /**
+     * Starts an ingestion session inserting the vectors submitted to it on a native background thread, so that the
+     * next batch of vectors can be transferred while the previous one is inserted.
+     *
+     * @param indexAddress      address of native memory where index is stored
+     * @param dimension         dimension of the vector to be indexed
+     * @param parameters        parameters to build index
+     * @param maxPendingBatches number of submitted batches that may wait for or be under insertion
+     * @param knnEngine         knn engine
+     * @return address of the ingestion session
+     */
+    public static long startIngestion(
+        long indexAddress,
+        int dimension,
+        Map<String, Object> parameters,
+        int maxPendingBatches,
+        KNNEngine knnEngine
+    ) {
+        int threadCount = (int) parameters.getOrDefault(KNNConstants.INDEX_THREAD_QTY, 0);
+        if (KNNEngine.FAISS == knnEngine) {
+            if (IndexUtil.isBinaryIndex(knnEngine, parameters)) {
+                return FaissService.startBinaryIngestion(indexAddress, dimension, threadCount, maxPendingBatches);
+            }
+            if (IndexUtil.isByteIndex(parameters)) {
+                return FaissService.startByteIngestion(indexAddress, dimension, threadCount, maxPendingBatches);
+            }
+            return FaissService.startIngestion(indexAddress, dimension, threadCount, maxPendingBatches);
+        }
+
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "startIngestion not supported for provided engine : %s", knnEngine.getName())
+        );
+    }
+
+    /**
+     * Queues a batch of vectors for insertion by an ingestion session, blocking until the session has room for it.
+     * The memory at vectorsAddress must not be reused or freed until a later batch is submitted or the session is
+     * finished.
+     *
+     * @param sessionAddress address of the ingestion session
+     * @param docs           ids of documents
+     * @param vectorsAddress address of native memory where vectors are stored
+     * @param knnEngine      knn engine
+     */
+    public static void submitToIngestion(long sessionAddress, int[] docs, long vectorsAddress, KNNEngine knnEngine) {
+        if (KNNEngine.FAISS == knnEngine) {
+            FaissService.submitToIngestion(sessionAddress, docs, vectorsAddress);
+            return;
+        }
+
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "submitToIngestion not supported for provided engine : %s", knnEngine.getName())
+        );
+    }
+
+    /**
+     * Waits for an ingestion session to insert all submitted batches and frees it. Insertion failures are rethrown.
+     *
+     * @param sessionAddress address of the ingestion session
+     * @param knnEngine      knn engine
+     */
+    public static void finishIngestion(long sessionAddress, KNNEngine knnEngine) {
+        if (KNNEngine.FAISS == knnEngine) {
+            FaissService.finishIngestion(sessionAddress);
+            return;
+        }
+
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "finishIngestion not supported for provided engine : %s", knnEngine.getName())
+        );
+    }
+
     /**
      * Writes a faiss index to disk.
      *
@@ -116,10 +190,9 @@ public class JNIService {
     }
 
     /**
-     * Create an index for the native library. The memory occupied by the vectorsAddress will be freed up during the
-     * function call. So Java layer doesn't need to free up the memory. This is not an ideal behavior because Java layer
-     * created the memory address and that should only free up the memory. We are tracking the proper fix for this on this
-     * <a href="https://github.com/opensearch-project/k-NN/issues/1600">issue</a>
+     * Create an index for the native library. The vectors stored at vectorsAddress are handed back to the native vector
+     * buffer pool during the function call, once they are no longer needed, which lowers the peak memory of the build.
+     * The vectorsAddress itself stays valid and empty, and still has to be freed by the Java layer that created it.
      *
      * @param ids            array of ids mapping to the data passed in
      * @param vectorsAddress address of native memory where vectors are stored
@@ -209,6 +282,29 @@ public class JNIService {
         );
     }
 
+    /**
+     * Load an index from a file on the local file system. Only supported for Faiss, which reads the file through a
+     * memory mapping instead of copying it through Lucene's IndexInput.
+     *
+     * @param indexPath  Path of the index file
+     * @param parameters Parameters to be used when loading index
+     * @param knnEngine  Engine to load index
+     * @return Pointer to location in memory the index resides in
+     */
+    public static long loadIndex(String indexPath, Map<String, Object> parameters, KNNEngine knnEngine) {
+        if (KNNEngine.FAISS == knnEngine) {
+            if (IndexUtil.isBinaryIndex(knnEngine, parameters)) {
+                return FaissService.loadBinaryIndex(indexPath);
+            } else {
+                return FaissService.loadIndex(indexPath);
+            }
+        }
+
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "LoadIndex from a file not supported for provided engine : %s", knnEngine.getName())
+        );
+    }
+
     /**
      * Determine if index contains shared state. Currently, we cannot do this in the plugin because we do not store the
      * model definition anywhere. Only faiss supports indices that have shared state. So for all other engines it will
@@ -260,6 +356,40 @@ public class JNIService {
         );
     }
 
+    /**
+     * Resolve the query time method parameters of a query into native search parameters that the searches of every
+     * segment can take, so that none of them converts the method parameters map. Only ef_search and nprobes are read.
+     *
+     * @param methodParameters method parameters of the query, may be null
+     * @return address of the native search parameters, to be released with {@link #freeSearchParams(long)}, or 0 when
+     * there are no method parameters and the defaults of the index apply
+     */
+    public static long createSearchParams(@Nullable Map<String, ?> methodParameters) {
+        if (methodParameters == null || methodParameters.isEmpty()) {
+            return 0;
+        }
+        return JNICommons.createSearchParams(
+            getIntegerMethodParameter(methodParameters, KNNConstants.METHOD_PARAMETER_EF_SEARCH),
+            getIntegerMethodParameter(methodParameters, KNNConstants.METHOD_PARAMETER_NPROBES)
+        );
+    }
+
+    /**
+     * Free the native search parameters created by {@link #createSearchParams(Map)}
+     *
+     * @param searchParamsAddress address of the search parameters, 0 is ignored
+     */
+    public static void freeSearchParams(long searchParamsAddress) {
+        if (searchParamsAddress != 0) {
+            JNICommons.freeSearchParams(searchParamsAddress);
+        }
+    }
+
+    private static int getIntegerMethodParameter(Map<String, ?> methodParameters, String name) {
+        final Object value = methodParameters.get(name);
+        return value instanceof Number ? ((Number) value).intValue() : -1;
+    }
+
     /**
      * Query an index
      *
@@ -347,6 +477,439 @@ public class JNIService {
         );
     }
 
+    /**
+     * Query an index with a batch of query vectors in a single native call. Results of query i are written to
+     * [i * k, (i + 1) * k) of resultIds and resultDistances and padded with id -1 when fewer than k neighbors are found.
+     *
+     * @param indexPointer        pointer to index in memory
+     * @param queryVectors        float vectors laid out one after another
+     * @param numQueries          number of query vectors
+     * @param k                   neighbors to be returned per query
+     * @param searchParamsAddress address of the native search parameters, or 0 to use the index defaults
+     * @param knnEngine           engine to query index
+     * @param filterBuffer        direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType       how to filter ids: Batch or BitMap
+     * @param parentIds           list of parent doc ids when the knn field is a nested field
+     * @param resultIds           array of at least numQueries * k entries receiving the neighbor ids
+     * @param resultDistances     array of at least numQueries * k entries receiving the neighbor distances
+     */
+    public static void queryIndexBatch(
+        long indexPointer,
+        float[] queryVectors,
+        int numQueries,
+        int k,
+        long searchParamsAddress,
+        KNNEngine knnEngine,
+        @Nullable ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    ) {
+        if (KNNEngine.FAISS == knnEngine) {
+            FaissService.queryIndexBatch(
+                indexPointer,
+                queryVectors,
+                numQueries,
+                k,
+                searchParamsAddress,
+                filterBuffer,
+                filterIdsType,
+                parentIds,
+                resultIds,
+                resultDistances
+            );
+            return;
+        }
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "QueryIndexBatch not supported for provided engine : %s", knnEngine.getName())
+        );
+    }
+
+    /**
+     * Query a byte index with a batch of query vectors in a single native call. Results of query i are written to
+     * [i * k, (i + 1) * k) of resultIds and resultDistances and padded with id -1 when fewer than k neighbors are found.
+     *
+     * @param indexPointer        pointer to index in memory
+     * @param queryVectors        signed byte vectors laid out one after another
+     * @param numQueries          number of query vectors
+     * @param k                   neighbors to be returned per query
+     * @param searchParamsAddress address of the native search parameters, or 0 to use the index defaults
+     * @param knnEngine           engine to query index
+     * @param filterBuffer        direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType       how to filter ids: Batch or BitMap
+     * @param parentIds           list of parent doc ids when the knn field is a nested field
+     * @param resultIds           array of at least numQueries * k entries receiving the neighbor ids
+     * @param resultDistances     array of at least numQueries * k entries receiving the neighbor distances
+     */
+    public static void queryByteIndexBatch(
+        long indexPointer,
+        byte[] queryVectors,
+        int numQueries,
+        int k,
+        long searchParamsAddress,
+        KNNEngine knnEngine,
+        @Nullable ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    ) {
+        if (KNNEngine.FAISS == knnEngine) {
+            FaissService.queryByteIndexBatch(
+                indexPointer,
+                queryVectors,
+                numQueries,
+                k,
+                searchParamsAddress,
+                filterBuffer,
+                filterIdsType,
+                parentIds,
+                resultIds,
+                resultDistances
+            );
+            return;
+        }
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "QueryByteIndexBatch not supported for provided engine : %s", knnEngine.getName())
+        );
+    }
+
+    /**
+     * Query a binary index with a batch of query vectors in a single native call. Results of query i are written to
+     * [i * k, (i + 1) * k) of resultIds and resultDistances and padded with id -1 when fewer than k neighbors are found.
+     *
+     * @param indexPointer        pointer to index in memory
+     * @param queryVectors        packed binary vectors laid out one after another
+     * @param numQueries          number of query vectors
+     * @param k                   neighbors to be returned per query
+     * @param searchParamsAddress address of the native search parameters, or 0 to use the index defaults
+     * @param knnEngine           engine to query index
+     * @param filterBuffer        direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType       how to filter ids: Batch or BitMap
+     * @param parentIds           list of parent doc ids when the knn field is a nested field
+     * @param resultIds           array of at least numQueries * k entries receiving the neighbor ids
+     * @param resultDistances     array of at least numQueries * k entries receiving the neighbor distances
+     */
+    public static void queryBinaryIndexBatch(
+        long indexPointer,
+        byte[] queryVectors,
+        int numQueries,
+        int k,
+        long searchParamsAddress,
+        KNNEngine knnEngine,
+        @Nullable ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    ) {
+        if (KNNEngine.FAISS == knnEngine) {
+            FaissService.queryBinaryIndexBatch(
+                indexPointer,
+                queryVectors,
+                numQueries,
+                k,
+                searchParamsAddress,
+                filterBuffer,
+                filterIdsType,
+                parentIds,
+                resultIds,
+                resultDistances
+            );
+            return;
+        }
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "QueryBinaryIndexBatch not supported for provided engine : %s", knnEngine.getName())
+        );
+    }
+
+    /**
+     * Exact search of the k nearest neighbors among the filtered vectors of a loaded index. The vectors are scored
+     * natively from the index storage, which avoids reading them back through the segment when the filter is too
+     * restrictive for the graph search.
+     *
+     * @param indexPointer    pointer to index in memory
+     * @param queryVector     vector to be used for query
+     * @param k               neighbors to be returned
+     * @param knnEngine       engine to query index
+     * @param filteredIds     array of ids on which the search should be run, or null to score every vector
+     * @param filterIdsType   how to filter ids: Batch, BitMap or SortedArray
+     * @param resultIds       array of at least k entries receiving the neighbor ids
+     * @param resultDistances array of at least k entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public static int exactSearchIndex(
+        long indexPointer,
+        float[] queryVector,
+        int k,
+        KNNEngine knnEngine,
+        long[] filteredIds,
+        int filterIdsType,
+        int[] resultIds,
+        float[] resultDistances
+    ) {
+        if (KNNEngine.FAISS == knnEngine) {
+            return FaissService.exactSearchWithFilter(indexPointer, queryVector, k, filteredIds, filterIdsType, resultIds, resultDistances);
+        }
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "ExactSearchIndex not supported for provided engine : %s", knnEngine.getName())
+        );
+    }
+
+    /**
+     * Exact range search among the filtered vectors of a loaded index, scored natively from the index storage
+     *
+     * @param indexPointer         pointer to index in memory
+     * @param queryVector          vector to be used for query
+     * @param radius               search within radius threshold
+     * @param knnEngine            engine to query index
+     * @param indexMaxResultWindow maximum number of results to return
+     * @param filteredIds          array of ids on which the search should be run, or null to score every vector
+     * @param filterIdsType        how to filter ids: Batch, BitMap or SortedArray
+     * @param resultIds            array of at least indexMaxResultWindow entries receiving the neighbor ids
+     * @param resultDistances      array of at least indexMaxResultWindow entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public static int exactRadiusSearchIndex(
+        long indexPointer,
+        float[] queryVector,
+        float radius,
+        KNNEngine knnEngine,
+        int indexMaxResultWindow,
+        long[] filteredIds,
+        int filterIdsType,
+        int[] resultIds,
+        float[] resultDistances
+    ) {
+        if (KNNEngine.FAISS == knnEngine) {
+            return FaissService.exactRangeSearchWithFilter(
+                indexPointer,
+                queryVector,
+                radius,
+                indexMaxResultWindow,
+                filteredIds,
+                filterIdsType,
+                resultIds,
+                resultDistances
+            );
+        }
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "ExactRadiusSearchIndex not supported for provided engine : %s", knnEngine.getName())
+        );
+    }
+
+    /**
+     * Query an index using native search parameters, with the filter read in place from a direct buffer, and write the
+     * ids and scores of the neighbors into the given arrays. Unlike a long array, the filter buffer is not copied by the
+     * JVM on every call, so a caller building large filters off-heap can reuse them across queries and segments.
+     * nmslib indices take neither filters nor parent ids, which are ignored for them.
+     *
+     * @param indexPointer        pointer to index in memory
+     * @param queryVector         vector to be used for query
+     * @param k                   neighbors to be returned
+     * @param searchParamsAddress address of the native search parameters, or 0 to use the index defaults
+     * @param knnEngine           engine to query index
+     * @param filterBuffer        direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType       how to filter ids: Batch or BitMap
+     * @param parentIds           list of parent doc ids when the knn field is a nested field
+     * @param resultIds           array of at least k entries receiving the neighbor ids
+     * @param resultDistances     array of at least k entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public static int queryIndexWithFilterBuffer(
+        long indexPointer,
+        float[] queryVector,
+        int k,
+        long searchParamsAddress,
+        KNNEngine knnEngine,
+        @Nullable ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    ) {
+        if (KNNEngine.NMSLIB == knnEngine) {
+            return NmslibService.queryIndexWithSearchParams(indexPointer, queryVector, k, searchParamsAddress, resultIds, resultDistances);
+        }
+
+        if (KNNEngine.FAISS == knnEngine) {
+            return FaissService.queryIndexWithFilterBuffer(
+                indexPointer,
+                queryVector,
+                k,
+                searchParamsAddress,
+                filterBuffer,
+                filterIdsType,
+                parentIds,
+                resultIds,
+                resultDistances
+            );
+        }
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "QueryIndexWithFilterBuffer not supported for provided engine : %s", knnEngine.getName())
+        );
+    }
+
+    /**
+     * Query a binary index using native search parameters, with the filter read in place from a direct buffer, and
+     * write the ids and scores of the neighbors into the given arrays
+     *
+     * @param indexPointer        pointer to index in memory
+     * @param queryVector         vector to be used for query
+     * @param k                   neighbors to be returned
+     * @param searchParamsAddress address of the native search parameters, or 0 to use the index defaults
+     * @param knnEngine           engine to query index
+     * @param filterBuffer        direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType       how to filter ids: Batch or BitMap
+     * @param parentIds           list of parent doc ids when the knn field is a nested field
+     * @param resultIds           array of at least k entries receiving the neighbor ids
+     * @param resultDistances     array of at least k entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public static int queryBinaryIndexWithFilterBuffer(
+        long indexPointer,
+        byte[] queryVector,
+        int k,
+        long searchParamsAddress,
+        KNNEngine knnEngine,
+        @Nullable ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    ) {
+        if (KNNEngine.FAISS == knnEngine) {
+            return FaissService.queryBinaryIndexWithFilterBuffer(
+                indexPointer,
+                queryVector,
+                k,
+                searchParamsAddress,
+                filterBuffer,
+                filterIdsType,
+                parentIds,
+                resultIds,
+                resultDistances
+            );
+        }
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "QueryBinaryIndexWithFilterBuffer not supported for provided engine : %s", knnEngine.getName())
+        );
+    }
+
+    /**
+     * Warm up a loaded index, so that the first queries against it do not pay the page faults and cache misses of a
+     * cold index. Only Faiss indices can be warmed up.
+     *
+     * @param indexPointer pointer to the loaded index
+     * @param knnEngine    engine of the index
+     * @param mode         how the index is warmed up, other than {@link NativeIndexWarmupMode#NONE}
+     * @return bytes of the index that were warmed up, followed by the time it took in nanoseconds
+     */
+    public static long[] warmIndex(final long indexPointer, final KNNEngine knnEngine, final NativeIndexWarmupMode mode) {
+        if (KNNEngine.FAISS == knnEngine && mode != NativeIndexWarmupMode.NONE) {
+            return FaissService.warmIndex(indexPointer, mode.getValue());
+        }
+
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "Warmup mode %s not supported for provided engine : %s", mode.getName(), knnEngine.getName())
+        );
+    }
+
+    /**
+     * Count the bytes held by the structures of a loaded index. Only Faiss indices can be walked.
+     *
+     * @param indexPointer pointer to the loaded index
+     * @param knnEngine    engine of the index
+     * @return bytes of the codes, neighbors, levels, offsets, id map, quantizer, shared state and other structures
+     */
+    public static long[] getIndexMemoryUsage(final long indexPointer, final KNNEngine knnEngine) {
+        if (KNNEngine.FAISS == knnEngine) {
+            return FaissService.getIndexMemoryUsage(indexPointer);
+        }
+
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "GetIndexMemoryUsage not supported for provided engine : %s", knnEngine.getName())
+        );
+    }
+
+    /**
+     * Move the memory of a loaded index to a NUMA node, or interleave it across all the nodes. Only Faiss indices can
+     * be placed.
+     *
+     * @param indexPointer pointer to the loaded index
+     * @param knnEngine    engine of the index
+     * @param node         node to bind the index to, -1 to interleave it
+     * @return node the index is bound to afterwards, -1 when it is not bound to a single node
+     */
+    public static int placeIndex(final long indexPointer, final KNNEngine knnEngine, final int node) {
+        if (KNNEngine.FAISS == knnEngine) {
+            return FaissService.placeIndex(indexPointer, node);
+        }
+
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "PlaceIndex not supported for provided engine : %s", knnEngine.getName())
+        );
+    }
+
+    /**
+     * Get the NUMA node a loaded index was bound to, so that work on it can be routed to threads of that node
+     *
+     * @param indexPointer pointer to the loaded index
+     * @param knnEngine    engine of the index
+     * @return node of the index, -1 when it is not bound to a single node
+     */
+    public static int getIndexNumaNode(final long indexPointer, final KNNEngine knnEngine) {
+        if (KNNEngine.FAISS == knnEngine) {
+            return FaissService.getIndexNumaNode(indexPointer);
+        }
+        return -1;
+    }
+
+    /**
+     * Get the number of NUMA nodes of the host
+     *
+     * @return number of nodes, 1 when the host has a single node or when it cannot be told
+     */
+    public static int getNumaNodeCount() {
+        return FaissService.getNumaNodeCount();
+    }
+
+    /**
+     * Set whether the indices loaded from now on are read into an arena of their own. Only Faiss indices use arenas.
+     *
+     * @param enabled whether to use arenas
+     * @return whether the indices loaded from now on use arenas, false if the library was built without them
+     */
+    public static boolean configureIndexArenas(final boolean enabled) {
+        return FaissService.configureIndexArenas(enabled);
+    }
+
+    /**
+     * Set whether the HNSW graphs of the indices loaded from now on are kept compact in memory. Only Faiss indices are
+     * compacted.
+     *
+     * @param enabled whether to compact graphs
+     */
+    public static void configureCompactGraphs(final boolean enabled) {
+        FaissService.configureCompactGraphs(enabled);
+    }
+
+    /**
+     * Get the statistics of the arena of a loaded index. Only Faiss indices use arenas.
+     *
+     * @param indexPointer pointer to the loaded index
+     * @param knnEngine    engine of the index
+     * @return mapped bytes, live bytes, live allocations, chunks and large allocations of the arena, all 0 if the index
+     *         has no arena
+     */
+    public static long[] getIndexArenaStats(final long indexPointer, final KNNEngine knnEngine) {
+        if (KNNEngine.FAISS == knnEngine) {
+            return FaissService.getIndexArenaStats(indexPointer);
+        }
+        return new long[5];
+    }
+
     /**
      * Free native memory pointer
      *
@@ -461,4 +1024,102 @@ public class JNIService {
         }
         throw new IllegalArgumentException(String.format(Locale.ROOT, "RadiusQueryIndex not supported for provided engine"));
     }
+
+    /**
+     * Range search index using native search parameters, with the filter read in place from a direct buffer, and write
+     * the ids and scores of the neighbors into the given arrays
+     *
+     * @param indexPointer         pointer to index in memory
+     * @param queryVector          vector to be used for query
+     * @param radius               search within radius threshold
+     * @param searchParamsAddress  address of the native search parameters, or 0 to use the index defaults
+     * @param knnEngine            engine to query index
+     * @param indexMaxResultWindow maximum number of results to return
+     * @param filterBuffer         direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType        how to filter ids: Batch or BitMap
+     * @param parentIds            parent ids of the vectors
+     * @param resultIds            array of at least indexMaxResultWindow entries receiving the neighbor ids
+     * @param resultDistances      array of at least indexMaxResultWindow entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public static int radiusQueryIndexWithFilterBuffer(
+        long indexPointer,
+        float[] queryVector,
+        float radius,
+        long searchParamsAddress,
+        KNNEngine knnEngine,
+        int indexMaxResultWindow,
+        @Nullable ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    ) {
+        if (KNNEngine.FAISS == knnEngine) {
+            return FaissService.rangeSearchIndexWithFilterBuffer(
+                indexPointer,
+                queryVector,
+                radius,
+                searchParamsAddress,
+                indexMaxResultWindow,
+                filterBuffer,
+                filterIdsType,
+                parentIds,
+                resultIds,
+                resultDistances
+            );
+        }
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "RadiusQueryIndexWithFilterBuffer not supported for provided engine")
+        );
+    }
+
+    /**
+     * Range search binary index using native search parameters, with the filter read in place from a direct buffer,
+     * and write the ids and hamming distances of the neighbors into the given arrays
+     *
+     * @param indexPointer         pointer to binary index in memory
+     * @param queryVector          binary vector to be used for query
+     * @param radius               largest hamming distance of the neighbors
+     * @param searchParamsAddress  address of the native search parameters, or 0 to use the index defaults
+     * @param knnEngine            engine to query index
+     * @param indexMaxResultWindow maximum number of results to return
+     * @param filterBuffer         direct buffer of native order longs holding the filter ids, or null for no filter
+     * @param filterIdsType        how to filter ids: Batch or BitMap
+     * @param parentIds            parent ids of the vectors
+     * @param resultIds            array of at least indexMaxResultWindow entries receiving the neighbor ids
+     * @param resultDistances      array of at least indexMaxResultWindow entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public static int radiusQueryBinaryIndexWithFilterBuffer(
+        long indexPointer,
+        byte[] queryVector,
+        float radius,
+        long searchParamsAddress,
+        KNNEngine knnEngine,
+        int indexMaxResultWindow,
+        @Nullable ByteBuffer filterBuffer,
+        int filterIdsType,
+        int[] parentIds,
+        int[] resultIds,
+        float[] resultDistances
+    ) {
+        if (KNNEngine.FAISS == knnEngine) {
+            return FaissService.rangeSearchBinaryIndexWithFilterBuffer(
+                indexPointer,
+                queryVector,
+                radius,
+                searchParamsAddress,
+                indexMaxResultWindow,
+                filterBuffer,
+                filterIdsType,
+                parentIds,
+                resultIds,
+                resultDistances
+            );
+        }
+        throw new IllegalArgumentException(
+            String.format(Locale.ROOT, "RadiusQueryBinaryIndexWithFilterBuffer not supported for provided engine")
+        );
+    }
 }
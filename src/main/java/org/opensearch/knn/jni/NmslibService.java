@@ -45,10 +45,9 @@ class NmslibService {
     }
 
     /**
-     * Create an index for the native library.  The memory occupied by the vectorsAddress will be freed up during the
-     * function call. So Java layer doesn't need to free up the memory. This is not an ideal behavior because Java layer
-     * created the memory address and that should only free up the memory. We are tracking the proper fix for this on this
-     * <a href="https://github.com/opensearch-project/k-NN/issues/1600">issue</a>
+     * Create an index for the native library. The vectors stored at vectorsAddress are handed back to the native vector
+     * buffer pool during the function call, once they are no longer needed, which lowers the peak memory of the build.
+     * The vectorsAddress itself stays valid and empty, and still has to be freed by the Java layer that created it.
      *
      * @param ids array of ids mapping to the data passed in
      * @param vectorsAddress address of native memory where vectors are stored
@@ -83,6 +82,28 @@ class NmslibService {
      */
     public static native KNNQueryResult[] queryIndex(long indexPointer, float[] queryVector, int k, Map<String, ?> methodParameters);
 
+    /**
+     * Query an index using native search parameters created by {@link JNICommons#createSearchParams(int, int)}, and
+     * write the ids and scores of the neighbors into the given arrays instead of allocating {@link KNNQueryResult}
+     * objects
+     *
+     * @param indexPointer pointer to index in memory
+     * @param queryVector vector to be used for query
+     * @param k neighbors to be returned
+     * @param searchParamsAddress address of the native search parameters, or 0 to use the index defaults
+     * @param resultIds array of at least k entries receiving the neighbor ids
+     * @param resultDistances array of at least k entries receiving the neighbor distances
+     * @return number of neighbors written
+     */
+    public static native int queryIndexWithSearchParams(
+        long indexPointer,
+        float[] queryVector,
+        int k,
+        long searchParamsAddress,
+        int[] resultIds,
+        float[] resultDistances
+    );
+
     /**
      * Free native memory pointer
      */
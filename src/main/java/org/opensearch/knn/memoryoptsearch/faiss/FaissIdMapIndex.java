@@ -12,7 +12,8 @@ import org.apache.lucene.index.FloatVectorValues;
 import org.apache.lucene.index.VectorEncoding;
 import org.apache.lucene.store.IndexInput;
 import org.apache.lucene.util.Bits;
-import org.apache.lucene.util.packed.DirectMonotonicReader;
+import org.apache.lucene.util.LongValues;
+import org.apache.lucene.util.packed.PackedInts;
 import org.opensearch.knn.memoryoptsearch.faiss.binary.FaissBinaryHnswIndex;
 import org.opensearch.knn.memoryoptsearch.faiss.binary.FaissBinaryIndex;
 
@@ -27,6 +28,8 @@ import java.io.IOException;
  * However, these IDs only cover the sparse 30% of Lucene documents, so an ID mapping is needed to convert the internal physical vector ID
  * into the corresponding Lucene document ID.
  * If the mapping is an identity mapping, where each `i` is mapped to itself, we omit storing it to save memory.
+ * Graphs reordered for locality at build time keep their id mapping in the renumbered order, which is no longer ascending. Such a
+ * mapping is kept in packed ints instead of the monotonic encoding.
  */
 public class FaissIdMapIndex extends FaissBinaryIndex implements FaissHNSWProvider {
     public static final String IXMP = "IxMp";
@@ -35,7 +38,7 @@ public class FaissIdMapIndex extends FaissBinaryIndex implements FaissHNSWProvid
     @Getter
     private FaissIndex nestedIndex;
     private FaissHNSWProvider hnswGetter;
-    private DirectMonotonicReader idMappingReader;
+    private LongValues idMappingReader;
 
     public FaissIdMapIndex(final String indexType) {
         super(indexType);
@@ -72,7 +75,46 @@ public class FaissIdMapIndex extends FaissBinaryIndex implements FaissHNSWProvid
         // Lucene document id.
         // Another case is parent-child nested case. In which, this mapping table will map internal vector id to parent document id.
         // NOTE : If the mapping is an identity function that maps `i` to `i`, then the reader will be null.
-        idMappingReader = MonotonicIntegerSequenceEncoder.encode(numElements, input);
+        final long idMappingOffset = input.getFilePointer();
+        long maxDocId = 0;
+        boolean ascending = true;
+        long prevDocId = Long.MIN_VALUE;
+        for (int i = 0; i < numElements; i++) {
+            final long docId = Math.toIntExact(input.readLong());
+            ascending &= prevDocId <= docId;
+            maxDocId = Math.max(maxDocId, docId);
+            prevDocId = docId;
+        }
+
+        input.seek(idMappingOffset);
+        if (ascending) {
+            idMappingReader = MonotonicIntegerSequenceEncoder.encode(numElements, input);
+        } else {
+            idMappingReader = readPackedIdMapping(numElements, maxDocId, input);
+        }
+    }
+
+    /**
+     * Read an id mapping whose document ids are not in ascending order, as written for graphs reordered for locality.
+     *
+     * @param numElements The number of vectors in the index.
+     * @param maxDocId The largest document id in the mapping.
+     * @param input Input stream positioned at the first element of the mapping.
+     * @return A reader returning the document id of the given internal vector id.
+     * @throws IOException
+     */
+    private static LongValues readPackedIdMapping(final int numElements, final long maxDocId, final IndexInput input) throws IOException {
+        final PackedInts.Mutable docIds = PackedInts.getMutable(numElements, PackedInts.bitsRequired(maxDocId), PackedInts.COMPACT);
+        for (int i = 0; i < numElements; i++) {
+            docIds.set(i, input.readLong());
+        }
+
+        return new LongValues() {
+            @Override
+            public long get(long internalVectorId) {
+                return docIds.get((int) internalVectorId);
+            }
+        };
     }
 
     @Override
@@ -47,6 +47,7 @@ import org.opensearch.knn.index.util.KNNClusterUtil;
 import org.opensearch.knn.indices.ModelCache;
 import org.opensearch.knn.indices.ModelDao;
 import org.opensearch.knn.indices.ModelGraveyard;
+import org.opensearch.knn.jni.JNICommons;
 import org.opensearch.knn.jni.PlatformUtils;
 import org.opensearch.knn.plugin.rest.RestClearCacheHandler;
 import org.opensearch.knn.plugin.rest.RestDeleteModelHandler;
@@ -220,6 +221,10 @@ public class KNNPlugin extends Plugin
         NativeMemoryLoadStrategy.TrainingLoadStrategy.initialize(vectorReader);
 
         KNNSettings.state().initialize(client, clusterService);
+        JNICommons.configureVectorBufferPool(
+            KNNSettings.KNN_VECTOR_BUFFER_POOL_LIMIT_SETTING.get(environment.settings()).getBytes(),
+            KNNSettings.KNN_VECTOR_BUFFER_POOL_HUGE_PAGES_ENABLED_SETTING.get(environment.settings())
+        );
         KNNClusterUtil.instance().initialize(clusterService);
         ModelDao.OpenSearchKNNModelDao.initialize(client, clusterService, environment.settings());
         ModelCache.initialize(ModelDao.OpenSearchKNNModelDao.getInstance(), clusterService);
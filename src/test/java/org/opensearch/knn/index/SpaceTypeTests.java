@@ -72,6 +72,20 @@ public class SpaceTypeTests extends KNNTestCase {
         }
     }
 
+    public void testScoreToDistanceTranslation_whenHamming_thenLargestDistanceWithinScore() {
+        assertEquals(4, SpaceType.HAMMING.scoreToDistanceTranslation(0.2f), 0);
+        assertEquals(3, SpaceType.HAMMING.scoreToDistanceTranslation(0.21f), 0);
+        assertEquals(0, SpaceType.HAMMING.scoreToDistanceTranslation(1.0f), 0);
+        for (int distance = 0; distance < 1000; distance++) {
+            final float score = SpaceType.HAMMING.scoreTranslation(distance);
+            assertEquals(distance, SpaceType.HAMMING.scoreToDistanceTranslation(score), 0);
+            assertEquals(distance, SpaceType.HAMMING.scoreToDistanceTranslation(Math.nextUp(score)) + 1, 0);
+        }
+        // No distance has a score above 1
+        assertTrue(SpaceType.HAMMING.scoreToDistanceTranslation(1.5f) < 0);
+        expectThrows(IllegalArgumentException.class, () -> SpaceType.HAMMING.scoreToDistanceTranslation(0));
+    }
+
     public void testValidateVectorDataType_whenCalled_thenReturn() {
         Map<SpaceType, Set<VectorDataType>> expected = Map.of(
             SpaceType.UNDEFINED,
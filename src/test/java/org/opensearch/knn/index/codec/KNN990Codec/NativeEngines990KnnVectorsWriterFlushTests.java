@@ -172,7 +172,7 @@ public class NativeEngines990KnnVectorsWriterFlushTests extends OpenSearchTestCa
 
                 when(quantizationService.getQuantizationParams(fieldInfo)).thenReturn(null);
                 nativeIndexWriterMockedStatic.when(
-                    () -> NativeIndexWriter.getWriter(fieldInfo, segmentWriteState, null, nativeIndexBuildStrategyFactory)
+                    () -> NativeIndexWriter.getWriter(fieldInfo, segmentWriteState, null, nativeIndexBuildStrategyFactory, false)
                 ).thenReturn(nativeIndexWriter);
             });
 
@@ -269,7 +269,13 @@ public class NativeEngines990KnnVectorsWriterFlushTests extends OpenSearchTestCa
                 }
 
                 nativeIndexWriterMockedStatic.when(
-                    () -> NativeIndexWriter.getWriter(fieldInfo, segmentWriteState, quantizationState, nativeIndexBuildStrategyFactory)
+                    () -> NativeIndexWriter.getWriter(
+                        fieldInfo,
+                        segmentWriteState,
+                        quantizationState,
+                        nativeIndexBuildStrategyFactory,
+                        false
+                    )
                 ).thenReturn(nativeIndexWriter);
             });
             doAnswer(answer -> {
@@ -362,7 +368,7 @@ public class NativeEngines990KnnVectorsWriterFlushTests extends OpenSearchTestCa
 
                 when(quantizationService.getQuantizationParams(fieldInfo)).thenReturn(null);
                 nativeIndexWriterMockedStatic.when(
-                    () -> NativeIndexWriter.getWriter(fieldInfo, segmentWriteState, null, nativeIndexBuildStrategyFactory)
+                    () -> NativeIndexWriter.getWriter(fieldInfo, segmentWriteState, null, nativeIndexBuildStrategyFactory, false)
                 ).thenReturn(nativeIndexWriter);
             });
 
@@ -437,7 +443,7 @@ public class NativeEngines990KnnVectorsWriterFlushTests extends OpenSearchTestCa
 
                 when(quantizationService.getQuantizationParams(fieldInfo)).thenReturn(null);
                 nativeIndexWriterMockedStatic.when(
-                    () -> NativeIndexWriter.getWriter(fieldInfo, segmentWriteState, null, nativeIndexBuildStrategyFactory)
+                    () -> NativeIndexWriter.getWriter(fieldInfo, segmentWriteState, null, nativeIndexBuildStrategyFactory, false)
                 ).thenReturn(nativeIndexWriter);
             });
 
@@ -512,7 +518,7 @@ public class NativeEngines990KnnVectorsWriterFlushTests extends OpenSearchTestCa
 
                 when(quantizationService.getQuantizationParams(fieldInfo)).thenReturn(null);
                 nativeIndexWriterMockedStatic.when(
-                    () -> NativeIndexWriter.getWriter(fieldInfo, segmentWriteState, null, nativeIndexBuildStrategyFactory)
+                    () -> NativeIndexWriter.getWriter(fieldInfo, segmentWriteState, null, nativeIndexBuildStrategyFactory, false)
                 ).thenReturn(nativeIndexWriter);
             });
 
@@ -596,7 +602,7 @@ public class NativeEngines990KnnVectorsWriterFlushTests extends OpenSearchTestCa
 
                 when(quantizationService.getQuantizationParams(fieldInfo)).thenReturn(null);
                 nativeIndexWriterMockedStatic.when(
-                    () -> NativeIndexWriter.getWriter(fieldInfo, segmentWriteState, null, nativeIndexBuildStrategyFactory)
+                    () -> NativeIndexWriter.getWriter(fieldInfo, segmentWriteState, null, nativeIndexBuildStrategyFactory, false)
                 ).thenReturn(nativeIndexWriter);
             });
 
@@ -695,7 +701,13 @@ public class NativeEngines990KnnVectorsWriterFlushTests extends OpenSearchTestCa
                 }
 
                 nativeIndexWriterMockedStatic.when(
-                    () -> NativeIndexWriter.getWriter(fieldInfo, segmentWriteState, quantizationState, nativeIndexBuildStrategyFactory)
+                    () -> NativeIndexWriter.getWriter(
+                        fieldInfo,
+                        segmentWriteState,
+                        quantizationState,
+                        nativeIndexBuildStrategyFactory,
+                        false
+                    )
                 ).thenReturn(nativeIndexWriter);
             });
             doAnswer(answer -> {
@@ -800,7 +812,13 @@ public class NativeEngines990KnnVectorsWriterFlushTests extends OpenSearchTestCa
                 }
 
                 nativeIndexWriterMockedStatic.when(
-                    () -> NativeIndexWriter.getWriter(fieldInfo, segmentWriteState, quantizationState, nativeIndexBuildStrategyFactory)
+                    () -> NativeIndexWriter.getWriter(
+                        fieldInfo,
+                        segmentWriteState,
+                        quantizationState,
+                        nativeIndexBuildStrategyFactory,
+                        false
+                    )
                 ).thenReturn(nativeIndexWriter);
             });
             doAnswer(answer -> {
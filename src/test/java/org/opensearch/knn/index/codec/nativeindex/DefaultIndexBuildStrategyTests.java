@@ -95,7 +95,7 @@ public class DefaultIndexBuildStrategyTests extends OpenSearchTestCase {
             mockedJNIService.verifyNoMoreInteractions();
             verify(offHeapVectorTransfer).flush(true);
             verify(offHeapVectorTransfer, times(3)).transfer(vectorTransferCapture.capture(), eq(true));
-            verify(offHeapVectorTransfer).reset();
+            verify(offHeapVectorTransfer, times(0)).reset();
 
             float[] prev = null;
             for (float[] vector : vectorTransferCapture.getAllValues()) {
@@ -129,9 +129,11 @@ public class DefaultIndexBuildStrategyTests extends OpenSearchTestCase {
             // Limits transfer to 2 vectors
             mockedKNNSettings.when(KNNSettings::getVectorStreamingMemoryLimit).thenReturn(new ByteSizeValue(16));
             mockedJNIService.when(() -> JNIService.initIndex(3, 2, Map.of("index", "param"), KNNEngine.FAISS)).thenReturn(100L);
+            mockedJNIService.when(() -> JNIService.startIngestion(100L, 2, Map.of("index", "param"), 1, KNNEngine.FAISS))
+                .thenReturn(300L);
 
             OffHeapVectorTransfer offHeapVectorTransfer = mock(OffHeapVectorTransfer.class);
-            mockedOffHeapVectorTransferFactory.when(() -> OffHeapVectorTransferFactory.getVectorTransfer(VectorDataType.FLOAT, 8, 3))
+            mockedOffHeapVectorTransferFactory.when(() -> OffHeapVectorTransferFactory.getVectorTransfer(VectorDataType.FLOAT, 16, 3))
                 .thenReturn(offHeapVectorTransfer);
 
             QuantizationService quantizationService = mock(QuantizationService.class);
@@ -187,28 +189,16 @@ public class DefaultIndexBuildStrategyTests extends OpenSearchTestCase {
             );
 
             mockedJNIService.verify(
-                () -> JNIService.insertToIndex(
-                    eq(new int[] { 0, 1 }),
-                    vectorAddressCaptor.capture(),
-                    eq(knnVectorValues.dimension()),
-                    eq(Map.of("index", "param")),
-                    eq(100L),
-                    eq(KNNEngine.FAISS)
-                )
+                () -> JNIService.submitToIngestion(eq(300L), eq(new int[] { 0, 1 }), vectorAddressCaptor.capture(), eq(KNNEngine.FAISS))
             );
 
             // For the flush
             mockedJNIService.verify(
-                () -> JNIService.insertToIndex(
-                    eq(new int[] { 2 }),
-                    vectorAddressCaptor.capture(),
-                    eq(knnVectorValues.dimension()),
-                    eq(Map.of("index", "param")),
-                    eq(100L),
-                    eq(KNNEngine.FAISS)
-                )
+                () -> JNIService.submitToIngestion(eq(300L), eq(new int[] { 2 }), vectorAddressCaptor.capture(), eq(KNNEngine.FAISS))
             );
 
+            mockedJNIService.verify(() -> JNIService.finishIngestion(300L, KNNEngine.FAISS));
+
             mockedJNIService.verify(
                 () -> JNIService.writeIndex(eq(indexOutputWithBuffer), eq(100L), eq(KNNEngine.FAISS), eq(Map.of("index", "param")))
             );
@@ -55,9 +55,11 @@ public class MemOptimizedNativeIndexBuildStrategyTests extends OpenSearchTestCas
         ) {
             // Limits transfer to 2 vectors
             mockedJNIService.when(() -> JNIService.initIndex(3, 2, Map.of("index", "param"), KNNEngine.FAISS)).thenReturn(100L);
+            mockedJNIService.when(() -> JNIService.startIngestion(100L, 2, Map.of("index", "param"), 1, KNNEngine.FAISS))
+                .thenReturn(300L);
 
             OffHeapVectorTransfer offHeapVectorTransfer = mock(OffHeapVectorTransfer.class);
-            mockedOffHeapVectorTransferFactory.when(() -> OffHeapVectorTransferFactory.getVectorTransfer(VectorDataType.FLOAT, 8, 3))
+            mockedOffHeapVectorTransferFactory.when(() -> OffHeapVectorTransferFactory.getVectorTransfer(VectorDataType.FLOAT, 16, 3))
                 .thenReturn(offHeapVectorTransfer);
             IndexOutputWithBuffer indexOutputWithBuffer = Mockito.mock(IndexOutputWithBuffer.class);
 
@@ -91,28 +93,16 @@ public class MemOptimizedNativeIndexBuildStrategyTests extends OpenSearchTestCas
             );
 
             mockedJNIService.verify(
-                () -> JNIService.insertToIndex(
-                    eq(new int[] { 0, 1 }),
-                    vectorAddressCaptor.capture(),
-                    eq(knnVectorValues.dimension()),
-                    eq(Map.of("index", "param")),
-                    eq(100L),
-                    eq(KNNEngine.FAISS)
-                )
+                () -> JNIService.submitToIngestion(eq(300L), eq(new int[] { 0, 1 }), vectorAddressCaptor.capture(), eq(KNNEngine.FAISS))
             );
 
             // For the flush
             mockedJNIService.verify(
-                () -> JNIService.insertToIndex(
-                    eq(new int[] { 2 }),
-                    vectorAddressCaptor.capture(),
-                    eq(knnVectorValues.dimension()),
-                    eq(Map.of("index", "param")),
-                    eq(100L),
-                    eq(KNNEngine.FAISS)
-                )
+                () -> JNIService.submitToIngestion(eq(300L), eq(new int[] { 2 }), vectorAddressCaptor.capture(), eq(KNNEngine.FAISS))
             );
 
+            mockedJNIService.verify(() -> JNIService.finishIngestion(300L, KNNEngine.FAISS));
+
             mockedJNIService.verify(
                 () -> JNIService.writeIndex(eq(indexOutputWithBuffer), eq(100L), eq(KNNEngine.FAISS), eq(Map.of("index", "param")))
             );
@@ -152,10 +142,12 @@ public class MemOptimizedNativeIndexBuildStrategyTests extends OpenSearchTestCas
 
             // Limits transfer to 2 vectors
             mockedJNIService.when(() -> JNIService.initIndex(3, 2, Map.of("index", "param"), KNNEngine.FAISS)).thenReturn(100L);
+            mockedJNIService.when(() -> JNIService.startIngestion(100L, 2, Map.of("index", "param"), 1, KNNEngine.FAISS))
+                .thenReturn(300L);
 
             OffHeapVectorTransfer offHeapVectorTransfer = mock(OffHeapVectorTransfer.class);
             when(offHeapVectorTransfer.getTransferLimit()).thenReturn(2);
-            mockedOffHeapVectorTransferFactory.when(() -> OffHeapVectorTransferFactory.getVectorTransfer(VectorDataType.FLOAT, 8, 3))
+            mockedOffHeapVectorTransferFactory.when(() -> OffHeapVectorTransferFactory.getVectorTransfer(VectorDataType.FLOAT, 16, 3))
                 .thenReturn(offHeapVectorTransfer);
 
             QuantizationService quantizationService = mock(QuantizationService.class);
@@ -211,28 +203,16 @@ public class MemOptimizedNativeIndexBuildStrategyTests extends OpenSearchTestCas
             );
 
             mockedJNIService.verify(
-                () -> JNIService.insertToIndex(
-                    eq(new int[] { 0, 1 }),
-                    vectorAddressCaptor.capture(),
-                    eq(knnVectorValues.dimension()),
-                    eq(Map.of("index", "param")),
-                    eq(100L),
-                    eq(KNNEngine.FAISS)
-                )
+                () -> JNIService.submitToIngestion(eq(300L), eq(new int[] { 0, 1 }), vectorAddressCaptor.capture(), eq(KNNEngine.FAISS))
             );
 
             // For the flush
             mockedJNIService.verify(
-                () -> JNIService.insertToIndex(
-                    eq(new int[] { 2 }),
-                    vectorAddressCaptor.capture(),
-                    eq(knnVectorValues.dimension()),
-                    eq(Map.of("index", "param")),
-                    eq(100L),
-                    eq(KNNEngine.FAISS)
-                )
+                () -> JNIService.submitToIngestion(eq(300L), eq(new int[] { 2 }), vectorAddressCaptor.capture(), eq(KNNEngine.FAISS))
             );
 
+            mockedJNIService.verify(() -> JNIService.finishIngestion(300L, KNNEngine.FAISS));
+
             mockedJNIService.verify(
                 () -> JNIService.writeIndex(eq(indexOutputWithBuffer), eq(100L), eq(KNNEngine.FAISS), eq(Map.of("index", "param")))
             );
@@ -13,11 +13,13 @@ package org.opensearch.knn.index.memory;
 
 import com.google.common.collect.ImmutableMap;
 import org.apache.lucene.store.Directory;
+import org.apache.lucene.util.Constants;
 import org.opensearch.core.action.ActionListener;
 import org.opensearch.action.search.SearchResponse;
 import org.opensearch.knn.KNNTestCase;
 import org.opensearch.knn.TestUtils;
 import org.opensearch.knn.common.KNNConstants;
+import org.opensearch.knn.index.KNNSettings;
 import org.opensearch.knn.index.VectorDataType;
 import org.opensearch.knn.index.engine.qframe.QuantizationConfig;
 import org.opensearch.knn.jni.JNICommons;
@@ -25,16 +27,22 @@ import org.opensearch.knn.jni.JNIService;
 import org.opensearch.knn.index.query.KNNQueryResult;
 import org.opensearch.knn.index.SpaceType;
 import org.opensearch.knn.index.engine.KNNEngine;
+import org.opensearch.knn.index.store.IndexInputWithBuffer;
 import org.opensearch.knn.training.FloatTrainingDataConsumer;
 import org.opensearch.knn.training.VectorReader;
+import org.mockito.MockedStatic;
+import org.mockito.Mockito;
 
 import java.io.IOException;
 import java.nio.file.Path;
 import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.List;
 import java.util.Map;
 
 import static org.mockito.ArgumentMatchers.any;
+import static org.mockito.ArgumentMatchers.anyInt;
+import static org.mockito.ArgumentMatchers.anyLong;
 import static org.mockito.ArgumentMatchers.eq;
 import static org.mockito.Mockito.doAnswer;
 import static org.mockito.Mockito.mock;
@@ -139,6 +147,175 @@ public class NativeMemoryLoadStrategyTests extends KNNTestCase {
         }
     }
 
+    public void testLoad_whenNumaPlacementRoundRobin_thenIndicesBoundToNodesInTurn() throws IOException {
+        Path tempDirPath = createTempDir();
+        try (
+            Directory luceneDirectory = newFSDirectory(tempDirPath);
+            MockedStatic<KNNSettings> knnSettingsMockedStatic = Mockito.mockStatic(KNNSettings.class, Mockito.CALLS_REAL_METHODS);
+            MockedStatic<JNIService> jniServiceMockedStatic = Mockito.mockStatic(JNIService.class, Mockito.CALLS_REAL_METHODS)
+        ) {
+            knnSettingsMockedStatic.when(KNNSettings::getNativeIndexNumaPlacement).thenReturn(NativeIndexNumaPlacement.ROUND_ROBIN);
+            jniServiceMockedStatic.when(JNIService::getNumaNodeCount).thenReturn(2);
+
+            KNNEngine knnEngine = KNNEngine.FAISS;
+            int numVectors = 10;
+            int dimension = 10;
+            int[] ids = new int[numVectors];
+            float[][] vectors = new float[numVectors][dimension];
+            for (int i = 0; i < numVectors; i++) {
+                ids[i] = i;
+                Arrays.fill(vectors[i], 1f);
+            }
+            Map<String, Object> parameters = ImmutableMap.of(
+                KNNConstants.SPACE_TYPE,
+                SpaceType.L2.getValue(),
+                KNNConstants.INDEX_DESCRIPTION_PARAMETER,
+                "HNSW16,Flat"
+            );
+
+            List<Integer> nodes = new ArrayList<>();
+            jniServiceMockedStatic.when(() -> JNIService.placeIndex(anyLong(), any(), anyInt())).thenAnswer(i -> {
+                nodes.add(i.getArgument(2));
+                return i.getArgument(2);
+            });
+            for (int i = 0; i < 3; i++) {
+                String indexFileName = "test" + i + knnEngine.getExtension();
+                long memoryAddress = JNICommons.storeVectorData(0, vectors, numVectors * dimension);
+                TestUtils.createIndex(ids, memoryAddress, dimension, luceneDirectory, indexFileName, parameters, knnEngine);
+                JNICommons.freeVectorData(memoryAddress);
+
+                NativeMemoryEntryContext.IndexEntryContext indexEntryContext = new NativeMemoryEntryContext.IndexEntryContext(
+                    luceneDirectory,
+                    TestUtils.createFakeNativeMamoryCacheKey(indexFileName),
+                    NativeMemoryLoadStrategy.IndexLoadStrategy.getInstance(),
+                    parameters,
+                    "test"
+                );
+                indexEntryContext.open();
+                NativeMemoryAllocation.IndexAllocation indexAllocation = indexEntryContext.load();
+                indexAllocation.close();
+            }
+
+            // Consecutive loads alternate between the two nodes, wherever the shared counter started
+            assertEquals(3, nodes.size());
+            assertNotEquals(nodes.get(0), nodes.get(1));
+            assertEquals(nodes.get(0), nodes.get(2));
+        }
+    }
+
+    public void testLoad_whenArenaEnabled_thenIndexLoadedIntoArena() throws IOException {
+        Path tempDirPath = createTempDir();
+        try (
+            Directory luceneDirectory = newFSDirectory(tempDirPath);
+            MockedStatic<KNNSettings> knnSettingsMockedStatic = Mockito.mockStatic(KNNSettings.class, Mockito.CALLS_REAL_METHODS)
+        ) {
+            knnSettingsMockedStatic.when(KNNSettings::isNativeIndexArenaEnabled).thenReturn(true);
+
+            KNNEngine knnEngine = KNNEngine.FAISS;
+            String indexFileName = "test1" + knnEngine.getExtension();
+            int numVectors = 10;
+            int dimension = 10;
+            int[] ids = new int[numVectors];
+            float[][] vectors = new float[numVectors][dimension];
+            for (int i = 0; i < numVectors; i++) {
+                ids[i] = i;
+                Arrays.fill(vectors[i], 1f);
+            }
+            Map<String, Object> parameters = ImmutableMap.of(
+                KNNConstants.SPACE_TYPE,
+                SpaceType.L2.getValue(),
+                KNNConstants.INDEX_DESCRIPTION_PARAMETER,
+                "HNSW16,Flat"
+            );
+            long memoryAddress = JNICommons.storeVectorData(0, vectors, numVectors * dimension);
+            TestUtils.createIndex(ids, memoryAddress, dimension, luceneDirectory, indexFileName, parameters, knnEngine);
+            JNICommons.freeVectorData(memoryAddress);
+
+            NativeMemoryEntryContext.IndexEntryContext indexEntryContext = new NativeMemoryEntryContext.IndexEntryContext(
+                luceneDirectory,
+                TestUtils.createFakeNativeMamoryCacheKey(indexFileName),
+                NativeMemoryLoadStrategy.IndexLoadStrategy.getInstance(),
+                parameters,
+                "test"
+            );
+            indexEntryContext.open();
+            // Arenas are only used by libraries built with KNN_INDEX_ARENAS
+            final boolean arenasSupported = JNIService.configureIndexArenas(true);
+            assertFalse(arenasSupported && Constants.LINUX == false);
+            NativeMemoryAllocation.IndexAllocation indexAllocation = indexEntryContext.load();
+            try {
+                // mapped bytes, live bytes, live allocations, chunks and large allocations
+                long[] arenaStats = JNIService.getIndexArenaStats(indexAllocation.getMemoryAddress(), knnEngine);
+                assertEquals(5, arenaStats.length);
+                if (arenasSupported) {
+                    assertTrue(arenaStats[1] >= (long) numVectors * dimension * Float.BYTES);
+                    assertTrue(arenaStats[0] >= arenaStats[1]);
+                } else {
+                    assertEquals(0, arenaStats[0]);
+                }
+            } finally {
+                indexAllocation.close();
+                JNIService.configureIndexArenas(false);
+            }
+        }
+    }
+
+    public void testLoad_whenFaissMmapLoadEnabled_thenLoadFromLocalFile() throws IOException {
+        Path tempDirPath = createTempDir();
+        try (
+            Directory luceneDirectory = newFSDirectory(tempDirPath);
+            MockedStatic<KNNSettings> knnSettingsMockedStatic = Mockito.mockStatic(KNNSettings.class, Mockito.CALLS_REAL_METHODS);
+            MockedStatic<JNIService> jniServiceMockedStatic = Mockito.mockStatic(JNIService.class, Mockito.CALLS_REAL_METHODS)
+        ) {
+            knnSettingsMockedStatic.when(KNNSettings::isFaissMmapLoadEnabled).thenReturn(true);
+
+            KNNEngine knnEngine = KNNEngine.FAISS;
+            String indexFileName = "test1" + knnEngine.getExtension();
+            int numVectors = 10;
+            int dimension = 10;
+            int[] ids = new int[numVectors];
+            float[][] vectors = new float[numVectors][dimension];
+            for (int i = 0; i < numVectors; i++) {
+                ids[i] = i;
+                Arrays.fill(vectors[i], 1f);
+            }
+            Map<String, Object> parameters = ImmutableMap.of(
+                KNNConstants.SPACE_TYPE,
+                SpaceType.L2.getValue(),
+                KNNConstants.INDEX_DESCRIPTION_PARAMETER,
+                "HNSW16,Flat"
+            );
+            long memoryAddress = JNICommons.storeVectorData(0, vectors, numVectors * dimension);
+            TestUtils.createIndex(ids, memoryAddress, dimension, luceneDirectory, indexFileName, parameters, knnEngine);
+            JNICommons.freeVectorData(memoryAddress);
+
+            NativeMemoryEntryContext.IndexEntryContext indexEntryContext = new NativeMemoryEntryContext.IndexEntryContext(
+                luceneDirectory,
+                TestUtils.createFakeNativeMamoryCacheKey(indexFileName),
+                NativeMemoryLoadStrategy.IndexLoadStrategy.getInstance(),
+                parameters,
+                "test"
+            );
+
+            // open graph file before load
+            indexEntryContext.open();
+            // Load
+            NativeMemoryAllocation.IndexAllocation indexAllocation = indexEntryContext.load();
+
+            // Verify the index was read from the local file rather than through IndexInput
+            jniServiceMockedStatic.verify(
+                () -> JNIService.loadIndex(eq(tempDirPath.resolve(indexFileName).toString()), eq(parameters), eq(knnEngine))
+            );
+            jniServiceMockedStatic.verify(() -> JNIService.loadIndex(any(IndexInputWithBuffer.class), any(), any()), Mockito.never());
+
+            // Confirm that the file was loaded by querying
+            float[] query = new float[dimension];
+            Arrays.fill(query, numVectors + 1);
+            KNNQueryResult[] results = JNIService.queryIndex(indexAllocation.getMemoryAddress(), query, 2, null, knnEngine, null, 0, null);
+            assertTrue(results.length > 0);
+        }
+    }
+
     @SuppressWarnings("unchecked")
     public void testTrainingLoadStrategy_load() {
         // Mock the vector reader so that on read, it waits 2 seconds, transfers vectors to the consumer, and then calls
@@ -47,6 +47,7 @@ import static org.mockito.ArgumentMatchers.any;
 import static org.mockito.ArgumentMatchers.anyInt;
 import static org.mockito.ArgumentMatchers.anyLong;
 import static org.mockito.ArgumentMatchers.eq;
+import static org.mockito.ArgumentMatchers.isNull;
 import static org.mockito.Mockito.mock;
 import static org.mockito.Mockito.times;
 import static org.mockito.Mockito.verify;
@@ -161,8 +162,19 @@ public class ExplainTests extends KNNWeightTestCase {
         knnSettingsMockedStatic.when(() -> KNNSettings.isShardLevelRescoringDisabledForDiskBasedVector(INDEX_NAME)).thenReturn(false);
 
         jniServiceMockedStatic.when(
-            () -> JNIService.queryIndex(anyLong(), eq(QUERY_VECTOR), eq(k), eq(HNSW_METHOD_PARAMETERS), any(), eq(null), anyInt(), any())
-        ).thenReturn(getFilteredKNNQueryResults());
+            () -> JNIService.queryIndexWithFilterBuffer(
+                anyLong(),
+                eq(QUERY_VECTOR),
+                eq(k),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                any(),
+                isNull(),
+                anyInt(),
+                any(),
+                any(),
+                any()
+            )
+        ).thenAnswer(writeResults(getFilteredKNNQueryResults()));
 
         RescoreContext rescoreContext = RescoreContext.builder().oversampleFactor(RescoreContext.MIN_OVERSAMPLE_FACTOR - 1).build();
 
@@ -204,7 +216,18 @@ public class ExplainTests extends KNNWeightTestCase {
         assertEquals(FILTERED_DOC_ID_TO_SCORES.size(), docIdSetIterator.cost());
 
         jniServiceMockedStatic.verify(
-            () -> JNIService.queryIndex(anyLong(), eq(QUERY_VECTOR), eq(k), eq(HNSW_METHOD_PARAMETERS), any(), any(), anyInt(), any()),
+            () -> JNIService.queryIndexWithFilterBuffer(
+                anyLong(),
+                eq(QUERY_VECTOR),
+                eq(k),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                any(),
+                any(),
+                anyInt(),
+                any(),
+                any(),
+                any()
+            ),
             times(1)
         );
 
@@ -312,8 +335,19 @@ public class ExplainTests extends KNNWeightTestCase {
         // Given
         int k = 3;
         jniServiceMockedStatic.when(
-            () -> JNIService.queryIndex(anyLong(), eq(QUERY_VECTOR), eq(k), eq(HNSW_METHOD_PARAMETERS), any(), eq(null), anyInt(), any())
-        ).thenReturn(getFilteredKNNQueryResults());
+            () -> JNIService.queryIndexWithFilterBuffer(
+                anyLong(),
+                eq(QUERY_VECTOR),
+                eq(k),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                any(),
+                isNull(),
+                anyInt(),
+                any(),
+                any(),
+                any()
+            )
+        ).thenAnswer(writeResults(getFilteredKNNQueryResults()));
 
         final int[] filterDocIds = new int[] { 0, 1, 2, 3, 4, 5 };
         final Map<String, String> attributesMap = ImmutableMap.of(
@@ -352,7 +386,18 @@ public class ExplainTests extends KNNWeightTestCase {
         assertEquals(FILTERED_DOC_ID_TO_SCORES.size(), docIdSetIterator.cost());
 
         jniServiceMockedStatic.verify(
-            () -> JNIService.queryIndex(anyLong(), eq(QUERY_VECTOR), eq(k), eq(HNSW_METHOD_PARAMETERS), any(), any(), anyInt(), any()),
+            () -> JNIService.queryIndexWithFilterBuffer(
+                anyLong(),
+                eq(QUERY_VECTOR),
+                eq(k),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                any(),
+                any(),
+                anyInt(),
+                any(),
+                any(),
+                any()
+            ),
             times(1)
         );
 
@@ -389,8 +434,19 @@ public class ExplainTests extends KNNWeightTestCase {
         // Given
         int k = 4;
         jniServiceMockedStatic.when(
-            () -> JNIService.queryIndex(anyLong(), eq(QUERY_VECTOR), eq(k), eq(HNSW_METHOD_PARAMETERS), any(), eq(null), anyInt(), any())
-        ).thenReturn(getFilteredKNNQueryResults());
+            () -> JNIService.queryIndexWithFilterBuffer(
+                anyLong(),
+                eq(QUERY_VECTOR),
+                eq(k),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                any(),
+                isNull(),
+                anyInt(),
+                any(),
+                any(),
+                any()
+            )
+        ).thenAnswer(writeResults(getFilteredKNNQueryResults()));
 
         final int[] filterDocIds = new int[] { 0, 1, 2, 3, 4, 5 };
         final Map<String, String> attributesMap = ImmutableMap.of(
@@ -428,7 +484,18 @@ public class ExplainTests extends KNNWeightTestCase {
         assertEquals(DOC_ID_TO_SCORES.size(), docIdSetIterator.cost());
 
         jniServiceMockedStatic.verify(
-            () -> JNIService.queryIndex(anyLong(), eq(QUERY_VECTOR), eq(k), eq(HNSW_METHOD_PARAMETERS), any(), any(), anyInt(), any()),
+            () -> JNIService.queryIndexWithFilterBuffer(
+                anyLong(),
+                eq(QUERY_VECTOR),
+                eq(k),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                any(),
+                any(),
+                anyInt(),
+                any(),
+                any(),
+                any()
+            ),
             times(1)
         );
 
@@ -688,18 +755,20 @@ public class ExplainTests extends KNNWeightTestCase {
         final float radius = 0.5f;
         final int maxResults = 1000;
         jniServiceMockedStatic.when(
-            () -> JNIService.radiusQueryIndex(
+            () -> JNIService.radiusQueryIndexWithFilterBuffer(
                 anyLong(),
                 eq(queryVector),
                 eq(radius),
-                eq(HNSW_METHOD_PARAMETERS),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
                 any(),
                 eq(maxResults),
                 any(),
                 anyInt(),
+                any(),
+                any(),
                 any()
             )
-        ).thenReturn(getKNNQueryResults());
+        ).thenAnswer(writeResults(getKNNQueryResults()));
 
         Map<String, String> attributesMap = Map.of(
             SPACE_TYPE,
@@ -731,15 +800,17 @@ public class ExplainTests extends KNNWeightTestCase {
         assertNotNull(knnScorer);
         knnWeight.getKnnExplanation().addKnnScorer(leafReaderContext, knnScorer);
         jniServiceMockedStatic.verify(
-            () -> JNIService.radiusQueryIndex(
+            () -> JNIService.radiusQueryIndexWithFilterBuffer(
                 anyLong(),
                 eq(queryVector),
                 eq(radius),
-                eq(HNSW_METHOD_PARAMETERS),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
                 any(),
                 eq(maxResults),
                 any(),
                 anyInt(),
+                any(),
+                any(),
                 any()
             )
         );
@@ -780,18 +851,20 @@ public class ExplainTests extends KNNWeightTestCase {
         final float radius = 0.5f;
         final int maxResults = 1000;
         jniServiceMockedStatic.when(
-            () -> JNIService.radiusQueryIndex(
+            () -> JNIService.radiusQueryIndexWithFilterBuffer(
                 anyLong(),
                 eq(queryVector),
                 eq(radius),
-                eq(HNSW_METHOD_PARAMETERS),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
                 any(),
                 eq(maxResults),
                 any(),
                 anyInt(),
+                any(),
+                any(),
                 any()
             )
-        ).thenReturn(getKNNQueryResults());
+        ).thenAnswer(writeResults(getKNNQueryResults()));
 
         Map<String, String> attributesMap = Map.of(
             SPACE_TYPE,
@@ -17,6 +17,10 @@ import org.apache.lucene.util.FixedBitSet;
 import org.apache.lucene.util.SparseFixedBitSet;
 import org.opensearch.knn.KNNTestCase;
 
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.LongBuffer;
+
 public class FilterIdsSelectorTests extends KNNTestCase {
 
     @SneakyThrows
@@ -27,7 +31,7 @@ public class FilterIdsSelectorTests extends KNNTestCase {
         }
         FilterIdsSelector idsSelector = FilterIdsSelector.getFilterIdSelector(bits, bits.cardinality());
         assertEquals(idsSelector.getFilterType(), FilterIdsSelector.FilterIdsSelectorType.BITMAP);
-        assertArrayEquals(bits.getBits(), idsSelector.filterIds);
+        assertArrayEquals(bits.getBits(), toLongArray(idsSelector.getFilterBuffer()));
     }
 
     @SneakyThrows
@@ -41,7 +45,7 @@ public class FilterIdsSelectorTests extends KNNTestCase {
         FixedBitSet fixedBitSet = new FixedBitSet(bits.length());
         BitSetIterator sparseBitSetIterator = new BitSetIterator(bits, 101);
         fixedBitSet.or(sparseBitSetIterator);
-        assertArrayEquals(fixedBitSet.getBits(), idsSelector.filterIds);
+        assertArrayEquals(fixedBitSet.getBits(), toLongArray(idsSelector.getFilterBuffer()));
     }
 
     @SneakyThrows
@@ -54,7 +58,52 @@ public class FilterIdsSelectorTests extends KNNTestCase {
             array[idx++] = i;
         }
         FilterIdsSelector idsSelector = FilterIdsSelector.getFilterIdSelector(bits, bits.cardinality());
-        assertEquals(idsSelector.getFilterType(), FilterIdsSelector.FilterIdsSelectorType.BATCH);
-        assertArrayEquals(array, idsSelector.filterIds);
+        assertEquals(idsSelector.getFilterType(), FilterIdsSelector.FilterIdsSelectorType.SORTED_ARRAY);
+        assertArrayEquals(array, toLongArray(idsSelector.getFilterBuffer()));
+    }
+
+    @SneakyThrows
+    public void testGetFilterBuffer() {
+        assertNull(FilterIdsSelector.getFilterIdSelector(null, 0).getFilterBuffer());
+
+        SparseFixedBitSet largeBits = new SparseFixedBitSet(1 << 10);
+        long[] largeIds = new long[] { 1, 5, 9, 13 };
+        for (long id : largeIds) {
+            largeBits.set((int) id);
+        }
+        FilterIdsSelector largeSelector = FilterIdsSelector.getFilterIdSelector(largeBits, largeBits.cardinality());
+        assertEquals(FilterIdsSelector.FilterIdsSelectorType.SORTED_ARRAY, largeSelector.getFilterType());
+        ByteBuffer largeBuffer = largeSelector.getFilterBuffer();
+        assertTrue(largeBuffer.isDirect());
+        assertEquals(ByteOrder.nativeOrder(), largeBuffer.order());
+        assertEquals(largeIds.length * Long.BYTES, largeBuffer.capacity());
+        assertArrayEquals(largeIds, toLongArray(largeBuffer));
+
+        // The buffer of the thread is reused, and the view only covers the words of the current filter
+        FixedBitSet smallBits = new FixedBitSet(70);
+        smallBits.set(3);
+        smallBits.set(66);
+        ByteBuffer smallBuffer = FilterIdsSelector.getFilterIdSelector(smallBits, smallBits.cardinality()).getFilterBuffer();
+        assertEquals(smallBits.getBits().length * Long.BYTES, smallBuffer.capacity());
+        assertArrayEquals(smallBits.getBits(), toLongArray(smallBuffer));
+    }
+
+    public void testAllocateFilterBuffer_whenLargerThanPooled_thenNotPooled() {
+        final int pooledLongs = FilterIdsSelector.MAX_POOLED_FILTER_BUFFER_BYTES / Long.BYTES;
+        ByteBuffer pooled = FilterIdsSelector.allocateFilterBuffer(pooledLongs);
+        pooled.putLong(0, 42L);
+        // Filters over the cap get their own buffer and leave the one of the thread untouched
+        ByteBuffer oversized = FilterIdsSelector.allocateFilterBuffer(pooledLongs + 1);
+        assertTrue(oversized.isDirect());
+        assertEquals((pooledLongs + 1) * Long.BYTES, oversized.capacity());
+        oversized.putLong(0, 7L);
+        assertEquals(42L, FilterIdsSelector.allocateFilterBuffer(1).getLong(0));
+    }
+
+    private static long[] toLongArray(ByteBuffer buffer) {
+        LongBuffer longBuffer = buffer.asLongBuffer();
+        long[] ids = new long[longBuffer.remaining()];
+        longBuffer.get(ids);
+        return ids;
     }
 }
@@ -426,13 +426,9 @@ public class KNNQueryBuilderTests extends KNNTestCase {
         expectThrows(IllegalArgumentException.class, () -> knnQueryBuilder.doToQuery(mockQueryShardContext));
     }
 
-    public void testDoToQuery_whenRadialSearchOnBinaryIndex_thenException() {
+    public void testDoToQuery_whenRadialSearchOnBinaryIndex_thenHammingRadius() {
         float[] queryVector = { 1.0f };
-        KNNQueryBuilder knnQueryBuilder = KNNQueryBuilder.builder()
-            .fieldName(FIELD_NAME)
-            .vector(queryVector)
-            .maxDistance(MAX_DISTANCE)
-            .build();
+        KNNQueryBuilder knnQueryBuilder = KNNQueryBuilder.builder().fieldName(FIELD_NAME).vector(queryVector).minScore(0.2f).build();
         Index dummyIndex = new Index("dummy", "dummy");
         QueryShardContext mockQueryShardContext = mock(QueryShardContext.class);
         KNNVectorFieldType mockKNNVectorField = mock(KNNVectorFieldType.class);
@@ -445,11 +441,18 @@ public class KNNQueryBuilderTests extends KNNTestCase {
         );
         KNNMethodContext knnMethodContext = new KNNMethodContext(KNNEngine.FAISS, SpaceType.HAMMING, methodComponentContext);
         when(mockKNNVectorField.getKnnMappingConfig()).thenReturn(getMappingConfigForMethodMapping(knnMethodContext, 8));
-        Exception e = expectThrows(UnsupportedOperationException.class, () -> knnQueryBuilder.doToQuery(mockQueryShardContext));
-        assertTrue(e.getMessage().contains("Binary data type does not support radial search"));
+        IndexSettings indexSettings = mock(IndexSettings.class);
+        when(mockQueryShardContext.getIndexSettings()).thenReturn(indexSettings);
+        when(indexSettings.getMaxResultWindow()).thenReturn(1000);
+
+        KNNQuery query = (KNNQuery) knnQueryBuilder.doToQuery(mockQueryShardContext);
+
+        // A score of 0.2 is met up to a hamming distance of 4
+        assertEquals(4, query.getRadius(), 0);
+        assertArrayEquals(new byte[] { 1 }, query.getByteQueryVector());
     }
 
-    public void testDoToQuery_whenRadialSearchOnDiskMode_thenException() {
+    public void testDoToQuery_whenRadialSearchOnDiskMode_thenFullPrecisionRadius() {
         float[] queryVector = { 1.0f };
         KNNQueryBuilder knnQueryBuilder = KNNQueryBuilder.builder()
             .fieldName(FIELD_NAME)
@@ -486,8 +489,15 @@ public class KNNQueryBuilderTests extends KNNTestCase {
                 return QuantizationConfig.builder().quantizationType(ScalarQuantizationType.ONE_BIT).build();
             }
         });
-        Exception e = expectThrows(UnsupportedOperationException.class, () -> knnQueryBuilder.doToQuery(mockQueryShardContext));
-        assertEquals("Radial search is not supported for indices which have quantization enabled", e.getMessage());
+        IndexSettings indexSettings = mock(IndexSettings.class);
+        when(mockQueryShardContext.getIndexSettings()).thenReturn(indexSettings);
+        when(indexSettings.getMaxResultWindow()).thenReturn(1000);
+
+        KNNQuery query = (KNNQuery) knnQueryBuilder.doToQuery(mockQueryShardContext);
+
+        // Quantized fields are rescored with their full precision vectors, so the radius stays in the space of the field
+        assertEquals(MAX_DISTANCE, query.getRadius(), 0);
+        assertArrayEquals(queryVector, query.getQueryVector(), 0);
     }
 
     public void testDoToQuery_KnnQueryWithFilter_Lucene() throws Exception {
@@ -18,7 +18,9 @@ import org.apache.lucene.util.Version;
 import org.junit.After;
 import org.junit.Before;
 import org.junit.BeforeClass;
+import org.mockito.ArgumentMatcher;
 import org.mockito.MockedStatic;
+import org.mockito.stubbing.Answer;
 import org.opensearch.common.io.PathUtils;
 import org.opensearch.common.unit.TimeValue;
 import org.opensearch.core.common.unit.ByteSizeValue;
@@ -29,6 +31,8 @@ import org.opensearch.knn.index.memory.NativeMemoryAllocation;
 import org.opensearch.knn.index.memory.NativeMemoryCacheManager;
 import org.opensearch.knn.jni.JNIService;
 
+import java.nio.ByteBuffer;
+import java.nio.LongBuffer;
 import java.nio.file.Path;
 import java.util.Map;
 import java.util.Set;
@@ -65,6 +69,7 @@ public class KNNWeightTestCase extends KNNTestCase {
     protected static final String CIRCUIT_BREAKER_LIMIT_100KB = "100Kb";
     protected static final Integer EF_SEARCH = 10;
     protected static final Map<String, ?> HNSW_METHOD_PARAMETERS = Map.of(METHOD_PARAMETER_EF_SEARCH, EF_SEARCH);
+    protected static final long HNSW_SEARCH_PARAMS_ADDRESS = 1L;
     protected static final Map<Integer, Float> DOC_ID_TO_SCORES = Map.of(10, 0.4f, 101, 0.05f, 100, 0.8f, 50, 0.52f);
     protected static final Map<Integer, Float> FILTERED_DOC_ID_TO_SCORES = Map.of(101, 0.05f, 100, 0.8f, 50, 0.52f);
     protected static final Map<Integer, Float> EXACT_SEARCH_DOC_ID_TO_SCORES = Map.of(0, 0.12048191f);
@@ -115,6 +120,7 @@ public class KNNWeightTestCase extends KNNTestCase {
     public void setupBeforeTest() {
         knnSettingsMockedStatic.when(() -> KNNSettings.getFilteredExactSearchThreshold(INDEX_NAME)).thenReturn(0);
         jniServiceMockedStatic = mockStatic(JNIService.class);
+        jniServiceMockedStatic.when(() -> JNIService.createSearchParams(eq(HNSW_METHOD_PARAMETERS))).thenReturn(HNSW_SEARCH_PARAMS_ADDRESS);
     }
 
     @After
@@ -144,6 +150,41 @@ public class KNNWeightTestCase extends KNNTestCase {
             .toArray(new KNNQueryResult[0]);
     }
 
+    /**
+     * Answers a native query by writing the results into its two trailing result id and distance arrays, and returning
+     * how many were written
+     */
+    protected static Answer<Integer> writeResults(final KNNQueryResult[] results) {
+        return invocation -> {
+            final Object[] arguments = invocation.getArguments();
+            final int[] resultIds = (int[]) arguments[arguments.length - 2];
+            final float[] resultDistances = (float[]) arguments[arguments.length - 1];
+            for (int i = 0; i < results.length; i++) {
+                resultIds[i] = results[i].getId();
+                resultDistances[i] = results[i].getScore();
+            }
+            return results.length;
+        };
+    }
+
+    /**
+     * Matches a filter buffer holding exactly the given filter ids
+     */
+    protected static ArgumentMatcher<ByteBuffer> filterBufferOf(final long[] filterIds) {
+        return buffer -> {
+            if (buffer == null || buffer.capacity() != filterIds.length * Long.BYTES) {
+                return false;
+            }
+            final LongBuffer ids = buffer.duplicate().order(buffer.order()).asLongBuffer();
+            for (long filterId : filterIds) {
+                if (ids.get() != filterId) {
+                    return false;
+                }
+            }
+            return true;
+        };
+    }
+
     protected SegmentReader mockSegmentReader() {
         return mockSegmentReader(true);
     }
@@ -38,6 +38,8 @@ import org.opensearch.knn.index.engine.MethodComponentContext;
 import org.opensearch.knn.index.SpaceType;
 import org.opensearch.knn.index.VectorDataType;
 import org.opensearch.knn.index.engine.KNNEngine;
+import org.opensearch.knn.index.memory.NativeMemoryAllocation;
+import org.opensearch.knn.index.memory.NativeMemoryCacheManager;
 import org.opensearch.knn.index.quantizationservice.QuantizationService;
 import org.opensearch.knn.index.vectorvalues.KNNBinaryVectorValues;
 import org.opensearch.knn.index.vectorvalues.KNNFloatVectorValues;
@@ -71,11 +73,14 @@ import static org.mockito.ArgumentMatchers.anyFloat;
 import static org.mockito.ArgumentMatchers.anyInt;
 import static org.mockito.ArgumentMatchers.anyLong;
 import static org.mockito.ArgumentMatchers.anyString;
+import static org.mockito.ArgumentMatchers.aryEq;
+import static org.mockito.ArgumentMatchers.argThat;
 import static org.mockito.ArgumentMatchers.eq;
 import static org.mockito.ArgumentMatchers.isNull;
 import static org.mockito.Mockito.doNothing;
 import static org.mockito.Mockito.mock;
 import static org.mockito.Mockito.mockStatic;
+import static org.mockito.Mockito.never;
 import static org.mockito.Mockito.times;
 import static org.mockito.Mockito.verify;
 import static org.mockito.Mockito.when;
@@ -143,8 +148,9 @@ public class KNNWeightTests extends KNNWeightTestCase {
         SpaceType spaceType = SpaceType.L2;
         final Function<Float, Float> scoreTranslator = spaceType::scoreTranslation;
         final String modelId = "modelId";
-        jniServiceMockedStatic.when(() -> JNIService.queryIndex(anyLong(), any(), eq(K), isNull(), any(), any(), anyInt(), any()))
-            .thenReturn(getKNNQueryResults());
+        jniServiceMockedStatic.when(
+            () -> JNIService.queryIndexWithFilterBuffer(anyLong(), any(), eq(K), eq(0L), any(), any(), anyInt(), any(), any(), any())
+        ).thenAnswer(writeResults(getKNNQueryResults()));
 
         final KNNQuery query = new KNNQuery(FIELD_NAME, QUERY_VECTOR, K, INDEX_NAME, (BitSetProducer) null);
 
@@ -289,8 +295,9 @@ public class KNNWeightTests extends KNNWeightTestCase {
     @SneakyThrows
     public void testEmptyQueryResults() {
         final KNNQueryResult[] knnQueryResults = new KNNQueryResult[] {};
-        jniServiceMockedStatic.when(() -> JNIService.queryIndex(anyLong(), any(), eq(K), isNull(), any(), any(), anyInt(), any()))
-            .thenReturn(knnQueryResults);
+        jniServiceMockedStatic.when(
+            () -> JNIService.queryIndexWithFilterBuffer(anyLong(), any(), eq(K), eq(0L), any(), any(), anyInt(), any(), any(), any())
+        ).thenAnswer(writeResults(knnQueryResults));
 
         final KNNQuery query = new KNNQuery(FIELD_NAME, QUERY_VECTOR, K, INDEX_NAME, null);
         final KNNWeight knnWeight = new DefaultKNNWeight(query, 0.0f, null);
@@ -339,33 +346,51 @@ public class KNNWeightTests extends KNNWeightTestCase {
 
     @SneakyThrows
     public void testScorer_whenNoFilterBinary_thenSuccess() {
-        validateScorer_whenNoFilter_thenSuccess(true);
+        validateScorer_whenNoFilter_thenSuccess(true, false);
     }
 
     @SneakyThrows
     public void testScorer_whenNoFilter_thenSuccess() {
-        validateScorer_whenNoFilter_thenSuccess(false);
+        validateScorer_whenNoFilter_thenSuccess(false, false);
+    }
+
+    @SneakyThrows
+    public void testScorer_whenQueryResourcesRetained_thenSearchParamsSharedAcrossLeaves() {
+        validateScorer_whenNoFilter_thenSuccess(false, true);
     }
 
-    private void validateScorer_whenNoFilter_thenSuccess(final boolean isBinary) throws IOException {
+    private void validateScorer_whenNoFilter_thenSuccess(final boolean isBinary, final boolean retainQueryResources) throws IOException {
         // Given
         int k = 3;
         jniServiceMockedStatic.when(
-            () -> JNIService.queryIndex(anyLong(), eq(QUERY_VECTOR), eq(k), eq(HNSW_METHOD_PARAMETERS), any(), any(), anyInt(), any())
-        ).thenReturn(getFilteredKNNQueryResults());
+            () -> JNIService.queryIndexWithFilterBuffer(
+                anyLong(),
+                eq(QUERY_VECTOR),
+                eq(k),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                any(),
+                any(),
+                anyInt(),
+                any(),
+                any(),
+                any()
+            )
+        ).thenAnswer(writeResults(getFilteredKNNQueryResults()));
 
         jniServiceMockedStatic.when(
-            () -> JNIService.queryBinaryIndex(
+            () -> JNIService.queryBinaryIndexWithFilterBuffer(
                 anyLong(),
                 eq(BYTE_QUERY_VECTOR),
                 eq(k),
-                eq(HNSW_METHOD_PARAMETERS),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
                 any(),
                 any(),
                 anyInt(),
+                any(),
+                any(),
                 any()
             )
-        ).thenReturn(getFilteredKNNQueryResults());
+        ).thenAnswer(writeResults(getFilteredKNNQueryResults()));
         final SegmentReader reader = mockSegmentReader();
         final LeafReaderContext leafReaderContext = mock(LeafReaderContext.class);
         when(leafReaderContext.reader()).thenReturn(reader);
@@ -392,6 +417,9 @@ public class KNNWeightTests extends KNNWeightTestCase {
 
         final float boost = (float) randomDoubleBetween(0, 10, true);
         final KNNWeight knnWeight = new DefaultKNNWeight(query, boost, null);
+        if (retainQueryResources) {
+            knnWeight.retainQueryResources();
+        }
         final FieldInfos fieldInfos = mock(FieldInfos.class);
         final FieldInfo fieldInfo = mock(FieldInfo.class);
         final Map<String, String> attributesMap = ImmutableMap.of(
@@ -412,24 +440,47 @@ public class KNNWeightTests extends KNNWeightTestCase {
         assertNotNull(knnScorer);
         if (isBinary) {
             jniServiceMockedStatic.verify(
-                () -> JNIService.queryBinaryIndex(
+                () -> JNIService.queryBinaryIndexWithFilterBuffer(
                     anyLong(),
                     eq(BYTE_QUERY_VECTOR),
                     eq(k),
-                    eq(HNSW_METHOD_PARAMETERS),
+                    eq(HNSW_SEARCH_PARAMS_ADDRESS),
                     any(),
                     any(),
                     anyInt(),
+                    any(),
+                    any(),
                     any()
                 ),
                 times(1)
             );
         } else {
             jniServiceMockedStatic.verify(
-                () -> JNIService.queryIndex(anyLong(), eq(QUERY_VECTOR), eq(k), eq(HNSW_METHOD_PARAMETERS), any(), any(), anyInt(), any()),
+                () -> JNIService.queryIndexWithFilterBuffer(
+                    anyLong(),
+                    eq(QUERY_VECTOR),
+                    eq(k),
+                    eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                    any(),
+                    any(),
+                    anyInt(),
+                    any(),
+                    any(),
+                    any()
+                ),
                 times(1)
             );
         }
+        if (retainQueryResources) {
+            // Further leaves reuse the native search parameters of the query, which are only freed once the weight is closed
+            knnWeight.scorer(leafReaderContext);
+            jniServiceMockedStatic.verify(() -> JNIService.freeSearchParams(HNSW_SEARCH_PARAMS_ADDRESS), never());
+            knnWeight.close();
+            knnWeight.close();
+        }
+        // The method parameters are resolved once into native search parameters, which are freed after the search
+        jniServiceMockedStatic.verify(() -> JNIService.createSearchParams(eq(HNSW_METHOD_PARAMETERS)), times(1));
+        jniServiceMockedStatic.verify(() -> JNIService.freeSearchParams(HNSW_SEARCH_PARAMS_ADDRESS), times(1));
     }
 
     @SneakyThrows
@@ -455,8 +506,19 @@ public class KNNWeightTests extends KNNWeightTestCase {
             new KNNQueryResult(2, 20.0f)  // Mock result with id 2 and score 20
         };
         jniServiceMockedStatic.when(
-            () -> JNIService.queryBinaryIndex(anyLong(), eq(quantizedVector), eq(k), any(), any(), any(), anyInt(), any())
-        ).thenReturn(knnQueryResults);
+            () -> JNIService.queryBinaryIndexWithFilterBuffer(
+                anyLong(),
+                eq(quantizedVector),
+                eq(k),
+                anyLong(),
+                any(),
+                any(),
+                anyInt(),
+                any(),
+                any(),
+                any()
+            )
+        ).thenAnswer(writeResults(knnQueryResults));
 
         KNNEngine knnEngine = mock(KNNEngine.class);
         when(knnEngine.score(anyFloat(), eq(SpaceType.HAMMING))).thenAnswer(invocation -> {
@@ -529,7 +591,18 @@ public class KNNWeightTests extends KNNWeightTestCase {
 
                 // Verify that JNIService.queryBinaryIndex is called with the quantized vector
                 jniServiceMockedStatic.verify(
-                    () -> JNIService.queryBinaryIndex(anyLong(), eq(quantizedVector), eq(k), any(), any(), any(), anyInt(), any()),
+                    () -> JNIService.queryBinaryIndexWithFilterBuffer(
+                        anyLong(),
+                        eq(quantizedVector),
+                        eq(k),
+                        anyLong(),
+                        any(),
+                        any(),
+                        anyInt(),
+                        any(),
+                        any(),
+                        any()
+                    ),
                     times(1)
                 );
 
@@ -557,30 +630,34 @@ public class KNNWeightTests extends KNNWeightTestCase {
         }
         if (isBinary) {
             jniServiceMockedStatic.when(
-                () -> JNIService.queryBinaryIndex(
+                () -> JNIService.queryBinaryIndexWithFilterBuffer(
                     anyLong(),
                     eq(BYTE_QUERY_VECTOR),
                     eq(k),
-                    eq(HNSW_METHOD_PARAMETERS),
+                    eq(HNSW_SEARCH_PARAMS_ADDRESS),
                     any(),
-                    eq(filterBitSet.getBits()),
+                    argThat(filterBufferOf(filterBitSet.getBits())),
                     anyInt(),
+                    any(),
+                    any(),
                     any()
                 )
-            ).thenReturn(getFilteredKNNQueryResults());
+            ).thenAnswer(writeResults(getFilteredKNNQueryResults()));
         } else {
             jniServiceMockedStatic.when(
-                () -> JNIService.queryIndex(
+                () -> JNIService.queryIndexWithFilterBuffer(
                     anyLong(),
                     eq(QUERY_VECTOR),
                     eq(k),
-                    eq(HNSW_METHOD_PARAMETERS),
+                    eq(HNSW_SEARCH_PARAMS_ADDRESS),
                     any(),
-                    eq(filterBitSet.getBits()),
+                    argThat(filterBufferOf(filterBitSet.getBits())),
                     anyInt(),
+                    any(),
+                    any(),
                     any()
                 )
-            ).thenReturn(getFilteredKNNQueryResults());
+            ).thenAnswer(writeResults(getFilteredKNNQueryResults()));
         }
 
         final Bits liveDocsBits = mock(Bits.class);
@@ -648,21 +725,34 @@ public class KNNWeightTests extends KNNWeightTestCase {
 
         if (isBinary) {
             jniServiceMockedStatic.verify(
-                () -> JNIService.queryBinaryIndex(
+                () -> JNIService.queryBinaryIndexWithFilterBuffer(
                     anyLong(),
                     eq(BYTE_QUERY_VECTOR),
                     eq(k),
-                    eq(HNSW_METHOD_PARAMETERS),
+                    eq(HNSW_SEARCH_PARAMS_ADDRESS),
                     any(),
                     any(),
                     anyInt(),
+                    any(),
+                    any(),
                     any()
                 ),
                 times(1)
             );
         } else {
             jniServiceMockedStatic.verify(
-                () -> JNIService.queryIndex(anyLong(), eq(QUERY_VECTOR), eq(k), eq(HNSW_METHOD_PARAMETERS), any(), any(), anyInt(), any()),
+                () -> JNIService.queryIndexWithFilterBuffer(
+                    anyLong(),
+                    eq(QUERY_VECTOR),
+                    eq(k),
+                    eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                    any(),
+                    any(),
+                    anyInt(),
+                    any(),
+                    any(),
+                    any()
+                ),
                 times(1)
             );
         }
@@ -688,8 +778,19 @@ public class KNNWeightTests extends KNNWeightTestCase {
         }
 
         jniServiceMockedStatic.when(
-            () -> JNIService.queryIndex(anyLong(), eq(QUERY_VECTOR), eq(k), eq(HNSW_METHOD_PARAMETERS), any(), eq(null), anyInt(), any())
-        ).thenReturn(getFilteredKNNQueryResults());
+            () -> JNIService.queryIndexWithFilterBuffer(
+                anyLong(),
+                eq(QUERY_VECTOR),
+                eq(k),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                any(),
+                isNull(),
+                anyInt(),
+                any(),
+                any(),
+                any()
+            )
+        ).thenAnswer(writeResults(getFilteredKNNQueryResults()));
 
         final Bits liveDocsBits = mock(Bits.class);
         for (int filterDocId : filterDocIds) {
@@ -745,7 +846,18 @@ public class KNNWeightTests extends KNNWeightTestCase {
         assertEquals(FILTERED_DOC_ID_TO_SCORES.size(), docIdSetIterator.cost());
 
         jniServiceMockedStatic.verify(
-            () -> JNIService.queryIndex(anyLong(), eq(QUERY_VECTOR), eq(k), eq(HNSW_METHOD_PARAMETERS), any(), any(), anyInt(), any()),
+            () -> JNIService.queryIndexWithFilterBuffer(
+                anyLong(),
+                eq(QUERY_VECTOR),
+                eq(k),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                any(),
+                any(),
+                anyInt(),
+                any(),
+                any(),
+                any()
+            ),
             times(1)
         );
 
@@ -805,7 +917,7 @@ public class KNNWeightTests extends KNNWeightTestCase {
             byte[] byteVector = new byte[] { 1, 3 };
             int filterDocId = 0;
             final LeafReaderContext leafReaderContext = mock(LeafReaderContext.class);
-            final SegmentReader reader = mock(SegmentReader.class);
+            final SegmentReader reader = mockSegmentReader();
             when(leafReaderContext.reader()).thenReturn(reader);
 
             final KNNQuery query = isBinary
@@ -967,7 +1079,7 @@ public class KNNWeightTests extends KNNWeightTestCase {
         float[] vector = new float[] { 0.1f, 0.3f };
         int filterDocId = 0;
         final LeafReaderContext leafReaderContext = mock(LeafReaderContext.class);
-        final SegmentReader reader = mock(SegmentReader.class);
+        final SegmentReader reader = mockSegmentReader();
         when(leafReaderContext.reader()).thenReturn(reader);
 
         final KNNQuery query = new KNNQuery(FIELD_NAME, QUERY_VECTOR, K, INDEX_NAME, FILTER_QUERY, null, null);
@@ -1039,7 +1151,7 @@ public class KNNWeightTests extends KNNWeightTestCase {
         final int[] filterDocIds = new int[] { 0, 1, 2, 3, 4, 5 };
 
         final LeafReaderContext leafReaderContext = mock(LeafReaderContext.class);
-        final SegmentReader reader = mock(SegmentReader.class);
+        final SegmentReader reader = mockSegmentReader();
         when(leafReaderContext.reader()).thenReturn(reader);
         when(reader.maxDoc()).thenReturn(100);
         when(reader.getLiveDocs()).thenReturn(null);
@@ -1089,6 +1201,100 @@ public class KNNWeightTests extends KNNWeightTestCase {
         assertTrue(Comparators.isInOrder(actualDocIds, Comparator.naturalOrder()));
     }
 
+    /**
+     * This test ensures that the filtered exact search is run by the native index when it is already loaded, with the
+     * filtered ids passed as a sorted array and without reading the vectors from the segment.
+     */
+    @SneakyThrows
+    public void testANNWithFilterQuery_whenExactSearchAndIndexLoaded_thenNativeExactSearch() {
+        ModelDao modelDao = mock(ModelDao.class);
+        KNNWeight.initialize(modelDao);
+        knnSettingsMockedStatic.when(() -> KNNSettings.getFilteredExactSearchThreshold(INDEX_NAME)).thenReturn(10);
+        int k = 1;
+        final int[] filterDocIds = new int[] { 0, 1, 2, 3, 4, 5 };
+        final long memoryAddress = 42L;
+
+        final LeafReaderContext leafReaderContext = mock(LeafReaderContext.class);
+        final SegmentReader reader = mockSegmentReader();
+        when(leafReaderContext.reader()).thenReturn(reader);
+        when(reader.maxDoc()).thenReturn(100);
+        when(reader.getLiveDocs()).thenReturn(null);
+        final Weight filterQueryWeight = mock(Weight.class);
+        final Scorer filterScorer = mock(Scorer.class);
+        when(filterQueryWeight.scorer(leafReaderContext)).thenReturn(filterScorer);
+        when(filterScorer.iterator()).thenReturn(DocIdSetIterator.all(filterDocIds.length));
+
+        final Map<String, String> attributesMap = ImmutableMap.of(
+            KNN_ENGINE,
+            KNNEngine.FAISS.getName(),
+            SPACE_TYPE,
+            SpaceType.L2.getValue(),
+            PARAMETERS,
+            String.format(Locale.ROOT, "{\"%s\":\"%s\"}", INDEX_DESCRIPTION_PARAMETER, "HNSW32")
+        );
+        final FieldInfos fieldInfos = mock(FieldInfos.class);
+        final FieldInfo fieldInfo = mock(FieldInfo.class);
+        when(reader.getFieldInfos()).thenReturn(fieldInfos);
+        when(fieldInfos.fieldInfo(any())).thenReturn(fieldInfo);
+        when(fieldInfo.attributes()).thenReturn(attributesMap);
+        when(fieldInfo.getAttribute(SPACE_TYPE)).thenReturn(SpaceType.L2.getValue());
+        when(fieldInfo.getName()).thenReturn(FIELD_NAME);
+
+        final NativeMemoryAllocation nativeMemoryAllocation = mock(NativeMemoryAllocation.class);
+        when(nativeMemoryAllocation.getMemoryAddress()).thenReturn(memoryAddress);
+        final NativeMemoryCacheManager nativeMemoryCacheManager = NativeMemoryCacheManager.getInstance();
+        when(nativeMemoryCacheManager.getIfPresent(anyString())).thenReturn(nativeMemoryAllocation);
+        final float distance = 0.5f;
+        jniServiceMockedStatic.when(
+            () -> JNIService.exactSearchIndex(
+                eq(memoryAddress),
+                eq(QUERY_VECTOR),
+                eq(k),
+                eq(KNNEngine.FAISS),
+                any(),
+                eq(FilterIdsSelector.FilterIdsSelectorType.SORTED_ARRAY.getValue()),
+                any(),
+                any()
+            )
+        ).thenAnswer(invocation -> {
+            ((int[]) invocation.getArgument(6))[0] = 3;
+            ((float[]) invocation.getArgument(7))[0] = distance;
+            return 1;
+        });
+
+        try {
+            final KNNQuery query = new KNNQuery(FIELD_NAME, QUERY_VECTOR, k, INDEX_NAME, FILTER_QUERY, null, null);
+            final float boost = (float) randomDoubleBetween(0, 10, true);
+            final KNNWeight knnWeight = new DefaultKNNWeight(query, boost, filterQueryWeight);
+
+            final KNNScorer knnScorer = (KNNScorer) knnWeight.scorer(leafReaderContext);
+            assertNotNull(knnScorer);
+            final DocIdSetIterator docIdSetIterator = knnScorer.iterator();
+            assertEquals(3, docIdSetIterator.nextDoc());
+            assertEquals(KNNEngine.FAISS.score(distance, SpaceType.L2) * boost, knnScorer.score(), 0.01f);
+            assertEquals(NO_MORE_DOCS, docIdSetIterator.nextDoc());
+
+            jniServiceMockedStatic.verify(
+                () -> JNIService.exactSearchIndex(
+                    eq(memoryAddress),
+                    eq(QUERY_VECTOR),
+                    eq(k),
+                    eq(KNNEngine.FAISS),
+                    aryEq(new long[] { 0, 1, 2, 3, 4, 5 }),
+                    eq(FilterIdsSelector.FilterIdsSelectorType.SORTED_ARRAY.getValue()),
+                    any(),
+                    any()
+                ),
+                times(1)
+            );
+            verify(nativeMemoryAllocation).incRef();
+            verify(nativeMemoryAllocation).decRef();
+            verify(reader, never()).getBinaryDocValues(FIELD_NAME);
+        } finally {
+            when(nativeMemoryCacheManager.getIfPresent(anyString())).thenReturn(null);
+        }
+    }
+
     /**
      * This test ensure that we do the exact search when threshold settings are correct and not using filteredIds<=K
      * condition to do exact search on binary index
@@ -1267,17 +1473,19 @@ public class KNNWeightTests extends KNNWeightTestCase {
         KNNQueryResult[] knnQueryResults = getKNNQueryResults();
 
         jniServiceMockedStatic.when(
-            () -> JNIService.queryIndex(
+            () -> JNIService.queryIndexWithFilterBuffer(
                 anyLong(),
                 eq(QUERY_VECTOR),
                 eq(knnQueryResults.length),
-                eq(HNSW_METHOD_PARAMETERS),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
                 any(),
                 any(),
                 anyInt(),
-                eq(parentsFilter)
+                eq(parentsFilter),
+                any(),
+                any()
             )
-        ).thenReturn(knnQueryResults);
+        ).thenAnswer(writeResults(knnQueryResults));
         final KNNQuery query = KNNQuery.builder()
             .field(FIELD_NAME)
             .queryVector(QUERY_VECTOR)
@@ -1292,15 +1500,17 @@ public class KNNWeightTests extends KNNWeightTestCase {
 
         // Verify
         jniServiceMockedStatic.verify(
-            () -> JNIService.queryIndex(
+            () -> JNIService.queryIndexWithFilterBuffer(
                 anyLong(),
                 eq(QUERY_VECTOR),
                 eq(knnQueryResults.length),
-                eq(HNSW_METHOD_PARAMETERS),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
                 any(),
                 any(),
                 anyInt(),
-                eq(parentsFilter)
+                eq(parentsFilter),
+                any(),
+                any()
             )
         );
         assertNotNull(knnScorer);
@@ -1315,18 +1525,20 @@ public class KNNWeightTests extends KNNWeightTestCase {
         final float radius = 0.5f;
         final int maxResults = 1000;
         jniServiceMockedStatic.when(
-            () -> JNIService.radiusQueryIndex(
+            () -> JNIService.radiusQueryIndexWithFilterBuffer(
                 anyLong(),
                 eq(queryVector),
                 eq(radius),
-                eq(HNSW_METHOD_PARAMETERS),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
                 any(),
                 eq(maxResults),
                 any(),
                 anyInt(),
+                any(),
+                any(),
                 any()
             )
-        ).thenReturn(getKNNQueryResults());
+        ).thenAnswer(writeResults(getKNNQueryResults()));
         KNNQuery.Context context = mock(KNNQuery.Context.class);
         when(context.getMaxResultWindow()).thenReturn(maxResults);
 
@@ -1385,15 +1597,17 @@ public class KNNWeightTests extends KNNWeightTestCase {
         final KNNScorer knnScorer = (KNNScorer) knnWeight.scorer(leafReaderContext);
         assertNotNull(knnScorer);
         jniServiceMockedStatic.verify(
-            () -> JNIService.radiusQueryIndex(
+            () -> JNIService.radiusQueryIndexWithFilterBuffer(
                 anyLong(),
                 eq(queryVector),
                 eq(radius),
-                eq(HNSW_METHOD_PARAMETERS),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
                 any(),
                 eq(maxResults),
                 any(),
                 anyInt(),
+                any(),
+                any(),
                 any()
             )
         );
@@ -1410,6 +1624,114 @@ public class KNNWeightTests extends KNNWeightTestCase {
         assertTrue(Comparators.isInOrder(actualDocIds, Comparator.naturalOrder()));
     }
 
+    @SneakyThrows
+    public void testDoANNSearch_whenRadialIsDefinedOnBinaryField_thenCallJniRadiusQueryBinaryIndex() {
+        final byte[] queryVector = new byte[] { 1, 3 };
+        final float radius = 3f;
+        final int maxResults = 1000;
+        jniServiceMockedStatic.when(
+            () -> JNIService.radiusQueryBinaryIndexWithFilterBuffer(
+                anyLong(),
+                eq(queryVector),
+                eq(radius),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                any(),
+                eq(maxResults),
+                any(),
+                anyInt(),
+                any(),
+                any(),
+                any()
+            )
+        ).thenAnswer(writeResults(getKNNQueryResults()));
+        KNNQuery.Context context = mock(KNNQuery.Context.class);
+        when(context.getMaxResultWindow()).thenReturn(maxResults);
+
+        final KNNQuery query = KNNQuery.builder()
+            .field(FIELD_NAME)
+            .byteQueryVector(queryVector)
+            .vectorDataType(VectorDataType.BINARY)
+            .radius(radius)
+            .indexName(INDEX_NAME)
+            .context(context)
+            .methodParameters(HNSW_METHOD_PARAMETERS)
+            .build();
+        final float boost = (float) randomDoubleBetween(0, 10, true);
+        final KNNWeight knnWeight = new DefaultKNNWeight(query, boost, null);
+
+        final LeafReaderContext leafReaderContext = mock(LeafReaderContext.class);
+        final SegmentReader reader = mock(SegmentReader.class);
+        when(leafReaderContext.reader()).thenReturn(reader);
+
+        final FSDirectory directory = mock(FSDirectory.class);
+        when(reader.directory()).thenReturn(directory);
+        final SegmentInfo segmentInfo = new SegmentInfo(
+            directory,
+            Version.LATEST,
+            Version.LATEST,
+            SEGMENT_NAME,
+            100,
+            true,
+            false,
+            KNNCodecVersion.CURRENT_DEFAULT,
+            Map.of(),
+            new byte[StringHelper.ID_LENGTH],
+            Map.of(),
+            Sort.RELEVANCE
+        );
+        segmentInfo.setFiles(SEGMENT_FILES_FAISS);
+        final SegmentCommitInfo segmentCommitInfo = new SegmentCommitInfo(segmentInfo, 0, 0, 0, 0, 0, new byte[StringHelper.ID_LENGTH]);
+        when(reader.getSegmentInfo()).thenReturn(segmentCommitInfo);
+
+        final Path path = mock(Path.class);
+        when(directory.getDirectory()).thenReturn(path);
+        final FieldInfos fieldInfos = mock(FieldInfos.class);
+        final FieldInfo fieldInfo = mock(FieldInfo.class);
+        when(reader.getFieldInfos()).thenReturn(fieldInfos);
+        when(fieldInfos.fieldInfo(any())).thenReturn(fieldInfo);
+        when(fieldInfo.attributes()).thenReturn(
+            Map.of(
+                SPACE_TYPE,
+                SpaceType.HAMMING.getValue(),
+                VECTOR_DATA_TYPE_FIELD,
+                VectorDataType.BINARY.getValue(),
+                KNN_ENGINE,
+                KNNEngine.FAISS.getName(),
+                PARAMETERS,
+                String.format(Locale.ROOT, "{\"%s\":\"%s\"}", INDEX_DESCRIPTION_PARAMETER, "BHNSW32")
+            )
+        );
+
+        final KNNScorer knnScorer = (KNNScorer) knnWeight.scorer(leafReaderContext);
+        assertNotNull(knnScorer);
+        jniServiceMockedStatic.verify(
+            () -> JNIService.radiusQueryBinaryIndexWithFilterBuffer(
+                anyLong(),
+                eq(queryVector),
+                eq(radius),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                any(),
+                eq(maxResults),
+                any(),
+                anyInt(),
+                any(),
+                any(),
+                any()
+            )
+        );
+
+        final DocIdSetIterator docIdSetIterator = knnScorer.iterator();
+
+        final List<Integer> actualDocIds = new ArrayList<>();
+        final Map<Integer, Float> translatedScores = getTranslatedScores(SpaceType.HAMMING::scoreTranslation);
+        for (int docId = docIdSetIterator.nextDoc(); docId != NO_MORE_DOCS; docId = docIdSetIterator.nextDoc()) {
+            actualDocIds.add(docId);
+            assertEquals(translatedScores.get(docId) * boost, knnScorer.score(), 0.01f);
+        }
+        assertEquals(docIdSetIterator.cost(), actualDocIds.size());
+        assertTrue(Comparators.isInOrder(actualDocIds, Comparator.naturalOrder()));
+    }
+
     private SegmentReader getMockedSegmentReader() {
         final SegmentReader reader = mock(SegmentReader.class);
         when(reader.maxDoc()).thenReturn(1);
@@ -1470,8 +1792,19 @@ public class KNNWeightTests extends KNNWeightTestCase {
         final Map<String, String> fileAttributes
     ) throws IOException {
         jniServiceMockedStatic.when(
-            () -> JNIService.queryIndex(anyLong(), eq(QUERY_VECTOR), eq(K), eq(HNSW_METHOD_PARAMETERS), any(), any(), anyInt(), any())
-        ).thenReturn(getKNNQueryResults());
+            () -> JNIService.queryIndexWithFilterBuffer(
+                anyLong(),
+                eq(QUERY_VECTOR),
+                eq(K),
+                eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                any(),
+                any(),
+                anyInt(),
+                any(),
+                any(),
+                any()
+            )
+        ).thenAnswer(writeResults(getKNNQueryResults()));
 
         final KNNQuery query = KNNQuery.builder()
             .field(FIELD_NAME)
@@ -1548,21 +1881,34 @@ public class KNNWeightTests extends KNNWeightTestCase {
             // Given
             int k = 3;
             jniServiceMockedStatic.when(
-                () -> JNIService.queryIndex(anyLong(), eq(QUERY_VECTOR), eq(k), eq(HNSW_METHOD_PARAMETERS), any(), any(), anyInt(), any())
-            ).thenReturn(getFilteredKNNQueryResults());
+                () -> JNIService.queryIndexWithFilterBuffer(
+                    anyLong(),
+                    eq(QUERY_VECTOR),
+                    eq(k),
+                    eq(HNSW_SEARCH_PARAMS_ADDRESS),
+                    any(),
+                    any(),
+                    anyInt(),
+                    any(),
+                    any(),
+                    any()
+                )
+            ).thenAnswer(writeResults(getFilteredKNNQueryResults()));
 
             jniServiceMockedStatic.when(
-                () -> JNIService.queryBinaryIndex(
+                () -> JNIService.queryBinaryIndexWithFilterBuffer(
                     anyLong(),
                     eq(BYTE_QUERY_VECTOR),
                     eq(k),
-                    eq(HNSW_METHOD_PARAMETERS),
+                    eq(HNSW_SEARCH_PARAMS_ADDRESS),
                     any(),
                     any(),
                     anyInt(),
+                    any(),
+                    any(),
                     any()
                 )
-            ).thenReturn(getFilteredKNNQueryResults());
+            ).thenAnswer(writeResults(getFilteredKNNQueryResults()));
             final SegmentReader reader = mockSegmentReader();
             final LeafReaderContext leafReaderContext = mock(LeafReaderContext.class);
             when(leafReaderContext.reader()).thenReturn(reader);
@@ -1619,30 +1965,34 @@ public class KNNWeightTests extends KNNWeightTestCase {
                 // Given
                 int k = 3;
                 jniServiceMockedStatic.when(
-                    () -> JNIService.queryIndex(
+                    () -> JNIService.queryIndexWithFilterBuffer(
                         anyLong(),
                         eq(QUERY_VECTOR),
                         eq(k),
-                        eq(HNSW_METHOD_PARAMETERS),
+                        eq(HNSW_SEARCH_PARAMS_ADDRESS),
                         any(),
                         any(),
                         anyInt(),
+                        any(),
+                        any(),
                         any()
                     )
-                ).thenReturn(getFilteredKNNQueryResults());
+                ).thenAnswer(writeResults(getFilteredKNNQueryResults()));
 
                 jniServiceMockedStatic.when(
-                    () -> JNIService.queryBinaryIndex(
+                    () -> JNIService.queryBinaryIndexWithFilterBuffer(
                         anyLong(),
                         eq(BYTE_QUERY_VECTOR),
                         eq(k),
-                        eq(HNSW_METHOD_PARAMETERS),
+                        eq(HNSW_SEARCH_PARAMS_ADDRESS),
                         any(),
                         any(),
                         anyInt(),
+                        any(),
+                        any(),
                         any()
                     )
-                ).thenReturn(getFilteredKNNQueryResults());
+                ).thenAnswer(writeResults(getFilteredKNNQueryResults()));
                 final SegmentReader reader = mockSegmentReader();
                 final LeafReaderContext leafReaderContext = mock(LeafReaderContext.class);
                 when(leafReaderContext.reader()).thenReturn(reader);
@@ -1676,14 +2026,16 @@ public class KNNWeightTests extends KNNWeightTestCase {
 
                 assertNotNull(knnScorer);
                 jniServiceMockedStatic.verify(
-                    () -> JNIService.queryIndex(
+                    () -> JNIService.queryIndexWithFilterBuffer(
                         anyLong(),
                         eq(QUERY_VECTOR),
                         eq(k),
-                        eq(HNSW_METHOD_PARAMETERS),
+                        eq(HNSW_SEARCH_PARAMS_ADDRESS),
                         any(),
                         any(),
                         anyInt(),
+                        any(),
+                        any(),
                         any()
                     ),
                     times(1)
@@ -0,0 +1,138 @@
+/*
+ * Copyright OpenSearch Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+package org.opensearch.knn.index.query;
+
+import lombok.SneakyThrows;
+import org.opensearch.knn.KNNTestCase;
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+
+public class NativeQueryBatcherTests extends KNNTestCase {
+
+    private static final long MAX_WAIT_NANOS = TimeUnit.SECONDS.toNanos(30);
+
+    // Returns the first value of each query as its only neighbor, so that results can be told apart by query
+    private static void searchFirstValues(
+        final NativeQueryBatcher.BatchKey key,
+        final Object[] queryVectors,
+        final int numQueries,
+        final int[] ids,
+        final float[] distances
+    ) {
+        for (int i = 0; i < numQueries; i++) {
+            final float value = ((float[]) queryVectors[i])[0];
+            ids[i * key.getK()] = (int) value;
+            distances[i * key.getK()] = value;
+            for (int j = 1; j < key.getK(); j++) {
+                ids[i * key.getK() + j] = -1;
+            }
+        }
+    }
+
+    @SneakyThrows
+    public void testSearch_whenConcurrentSearches_thenSearchedInOneBatch() {
+        final int k = 3;
+        final AtomicInteger batchCount = new AtomicInteger();
+        final AtomicInteger batchedQueries = new AtomicInteger();
+        final NativeQueryBatcher batcher = new NativeQueryBatcher((key, queryVectors, numQueries, searchParamsAddress, ids, distances) -> {
+            batchCount.incrementAndGet();
+            batchedQueries.addAndGet(numQueries);
+            searchFirstValues(key, queryVectors, numQueries, ids, distances);
+        });
+
+        final ExecutorService executor = Executors.newFixedThreadPool(NativeQueryBatcher.MAX_BATCH_SIZE);
+        try {
+            final CountDownLatch start = new CountDownLatch(1);
+            final List<Future<?>> searches = new ArrayList<>();
+            for (int i = 0; i < NativeQueryBatcher.MAX_BATCH_SIZE; i++) {
+                final int query = i;
+                searches.add(executor.submit(() -> {
+                    start.await();
+                    final int[] resultIds = new int[k];
+                    final float[] resultDistances = new float[k];
+                    final int resultSize = batcher.search(
+                        1L,
+                        NativeQueryBatcher.QueryType.FLOAT,
+                        new float[] { query, 0f },
+                        k,
+                        Map.of("ef_search", 100),
+                        0,
+                        MAX_WAIT_NANOS,
+                        resultIds,
+                        resultDistances
+                    );
+                    assertEquals(1, resultSize);
+                    assertEquals(query, resultIds[0]);
+                    assertEquals(query, resultDistances[0], 0.0f);
+                    return null;
+                }));
+            }
+            start.countDown();
+            for (Future<?> search : searches) {
+                search.get(60, TimeUnit.SECONDS);
+            }
+        } finally {
+            executor.shutdownNow();
+        }
+
+        // The batch is searched as soon as it is full, without waiting for the maximum wait
+        assertEquals(1, batchCount.get());
+        assertEquals(NativeQueryBatcher.MAX_BATCH_SIZE, batchedQueries.get());
+    }
+
+    public void testSearch_whenDifferentParameters_thenSearchedSeparately() {
+        final AtomicInteger batchCount = new AtomicInteger();
+        final NativeQueryBatcher batcher = new NativeQueryBatcher((key, queryVectors, numQueries, searchParamsAddress, ids, distances) -> {
+            batchCount.incrementAndGet();
+            assertEquals(1, numQueries);
+            searchFirstValues(key, queryVectors, numQueries, ids, distances);
+        });
+
+        final int[] resultIds = new int[2];
+        final float[] resultDistances = new float[2];
+        assertEquals(
+            1,
+            batcher.search(1L, NativeQueryBatcher.QueryType.FLOAT, new float[] { 7f }, 2, null, 0, 0, resultIds, resultDistances)
+        );
+        assertEquals(7, resultIds[0]);
+        assertEquals(
+            1,
+            batcher.search(
+                1L,
+                NativeQueryBatcher.QueryType.FLOAT,
+                new float[] { 8f },
+                2,
+                Map.of("ef_search", 10),
+                0,
+                0,
+                resultIds,
+                resultDistances
+            )
+        );
+        assertEquals(8, resultIds[0]);
+        assertEquals(2, batchCount.get());
+    }
+
+    public void testSearch_whenBatchFails_thenFailureRethrown() {
+        final NativeQueryBatcher batcher = new NativeQueryBatcher((key, queryVectors, numQueries, searchParamsAddress, ids, distances) -> {
+            throw new RuntimeException("search failed");
+        });
+
+        final IllegalStateException e = expectThrows(
+            IllegalStateException.class,
+            () -> batcher.search(1L, NativeQueryBatcher.QueryType.BINARY, new byte[] { 1 }, 1, null, 0, 0, new int[1], new float[1])
+        );
+        assertEquals("search failed", e.getCause().getMessage());
+    }
+}
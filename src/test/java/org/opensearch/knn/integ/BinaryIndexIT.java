@@ -158,14 +158,22 @@ public class BinaryIndexIT extends KNNRestTestCase {
     }
 
     @SneakyThrows
-    public void testHnswBinary_whenRadialSearch_thenThrowException() {
+    public void testHnswBinary_whenRadialSearch_thenReturnDocsWithinScore() {
         // Create Index
-        createKnnHnswBinaryIndex(engine, INDEX_NAME, FIELD_NAME, 16);
+        createKnnHnswBinaryIndex(engine, INDEX_NAME, FIELD_NAME, 128);
+        ingestTestData(INDEX_NAME, FIELD_NAME);
 
-        // Query
-        float[] queryVector = { (byte) 0b10001111, (byte) 0b10000000 };
-        Exception e = expectThrows(Exception.class, () -> runRnnQuery(INDEX_NAME, FIELD_NAME, queryVector, 1, 4));
-        assertTrue(e.getMessage(), e.getMessage().contains("Binary data type does not support radial search"));
+        int k = 10;
+        for (int i = 0; i < testData.queries.length; i++) {
+            List<KNNResult> knnResults = runKnnQuery(INDEX_NAME, FIELD_NAME, testData.queries[i], k);
+            // The score of the k-th neighbor is the score of a whole hamming distance, which the radius keeps
+            float minScore = knnResults.get(k - 1).getScore();
+            List<KNNResult> rnnResults = runRnnQuery(INDEX_NAME, FIELD_NAME, testData.queries[i], minScore, 100);
+            assertTrue(rnnResults.size() >= k / 2);
+            for (KNNResult result : rnnResults) {
+                assertTrue(result.getScore() >= minScore);
+            }
+        }
     }
 
     private float getRecall(final Set<String> truth, final Set<String> result) {
@@ -12,6 +12,10 @@
 package org.opensearch.knn.jni;
 
 import org.opensearch.knn.KNNTestCase;
+import org.opensearch.knn.index.KNNSettings;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 
 public class JNICommonsTest extends KNNTestCase {
 
@@ -37,4 +41,60 @@ public class JNICommonsTest extends KNNTestCase {
         long memoryAddress = JNICommons.storeVectorData(0, data, 8);
         JNICommons.freeVectorData(memoryAddress);
     }
+
+    public void testStoreFlatVectorData_whenValidInput_ThenSuccess() {
+        float[] data = new float[] { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f };
+        long memoryAddress = JNICommons.storeFlatVectorData(0, data, 4, 6, true);
+        assertTrue(memoryAddress > 0);
+        assertEquals(memoryAddress, JNICommons.storeFlatVectorData(memoryAddress, data, 2, 6, true));
+
+        ByteBuffer buffer = ByteBuffer.allocateDirect(data.length * Float.BYTES).order(ByteOrder.nativeOrder());
+        buffer.asFloatBuffer().put(data);
+        assertEquals(memoryAddress, JNICommons.storeVectorDataFromBuffer(memoryAddress, buffer, data.length, 6, false));
+        expectThrows(Exception.class, () -> JNICommons.storeFlatVectorData(memoryAddress, data, data.length + 1, 6, true));
+        JNICommons.freeVectorData(memoryAddress);
+
+        byte[] byteData = new byte[] { 1, -1, 2, -2 };
+        long byteMemoryAddress = JNICommons.storeFlatByteVectorData(0, byteData, byteData.length, 4, true);
+        assertTrue(byteMemoryAddress > 0);
+        JNICommons.freeByteVectorData(byteMemoryAddress);
+
+        long binaryMemoryAddress = JNICommons.storeBinaryVectorDataFromBuffer(
+            0,
+            ByteBuffer.allocateDirect(byteData.length).put(byteData),
+            byteData.length,
+            4,
+            true
+        );
+        assertTrue(binaryMemoryAddress > 0);
+        JNICommons.freeBinaryVectorData(binaryMemoryAddress);
+    }
+
+    public void testVectorBufferPool_whenConfigured_ThenStatsReflectLimit() {
+        long limit = 1024 * 1024;
+        JNICommons.configureVectorBufferPool(limit, false);
+        try {
+            long memoryAddress = JNICommons.storeVectorData(0, new float[][] { { 1.0f, 2.0f }, { 3.0f, 4.0f } }, 2);
+            JNICommons.freeVectorData(memoryAddress);
+
+            long[] stats = JNICommons.getVectorBufferPoolStats();
+            assertEquals(6, stats.length);
+            assertTrue(stats[0] <= limit);
+            assertEquals(limit, stats[3]);
+
+            JNICommons.configureVectorBufferPool(0, false);
+            stats = JNICommons.getVectorBufferPoolStats();
+            assertEquals(0, stats[0]);
+            assertEquals(0, stats[1]);
+        } finally {
+            JNICommons.configureVectorBufferPool(KNNSettings.KNN_DEFAULT_VECTOR_BUFFER_POOL_LIMIT_VALUE.getBytes(), false);
+        }
+        expectThrows(Exception.class, () -> JNICommons.configureVectorBufferPool(-1, false));
+    }
+
+    public void testSearchParams_whenValidInput_ThenSuccess() {
+        long primitiveAddress = JNICommons.createSearchParams(100, -1);
+        assertTrue(primitiveAddress > 0);
+        JNICommons.freeSearchParams(primitiveAddress);
+    }
 }
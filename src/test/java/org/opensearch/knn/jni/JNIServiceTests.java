@@ -14,6 +14,7 @@ package org.opensearch.knn.jni;
 import com.google.common.collect.ImmutableList;
 import com.google.common.collect.ImmutableMap;
 import lombok.SneakyThrows;
+import org.apache.lucene.codecs.CodecUtil;
 import org.apache.lucene.store.Directory;
 import org.apache.lucene.store.IOContext;
 import org.apache.lucene.store.IndexInput;
@@ -31,15 +32,20 @@ import org.opensearch.knn.index.engine.KNNMethodConfigContext;
 import org.opensearch.knn.index.engine.KNNMethodContext;
 import org.opensearch.knn.index.VectorDataType;
 import org.opensearch.knn.index.engine.nmslib.NmslibHNSWMethod;
+import org.opensearch.knn.index.query.FilterIdsSelector;
 import org.opensearch.knn.index.query.KNNQueryResult;
 import org.opensearch.knn.index.engine.MethodComponentContext;
 import org.opensearch.knn.index.SpaceType;
 import org.opensearch.knn.index.engine.KNNEngine;
+import org.opensearch.knn.index.memory.NativeIndexMemoryUsage;
+import org.opensearch.knn.index.memory.NativeIndexWarmupMode;
 import org.opensearch.knn.index.store.IndexInputWithBuffer;
 import org.opensearch.knn.index.store.IndexOutputWithBuffer;
 
 import java.io.IOException;
 import java.net.URL;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
 import java.nio.file.Path;
 import java.util.ArrayList;
 import java.util.Arrays;
@@ -612,6 +618,372 @@ public class JNIServiceTests extends KNNTestCase {
         }
     }
 
+    @SneakyThrows
+    public void testLoadIndex_faiss_whenCompressed_thenLoadFromStreamAndFile() {
+        Path tempDirPath = createTempDir();
+        try (Directory directory = newFSDirectory(tempDirPath)) {
+            Map<String, Object> parameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER,
+                faissMethod,
+                KNNConstants.SPACE_TYPE,
+                SpaceType.L2.getValue()
+            );
+            int dimension = testData.indexData.getDimension();
+            String[] indexFileNames = new String[2];
+            for (boolean compress : new boolean[] { false, true }) {
+                String indexFileName = "test" + compress + UUID.randomUUID() + ".tmp";
+                long indexAddress = JNIService.initIndex(0, dimension, parameters, KNNEngine.FAISS);
+                JNIService.insertToIndex(
+                    testData.indexData.docs,
+                    testData.loadDataToMemoryAddress(),
+                    dimension,
+                    parameters,
+                    indexAddress,
+                    KNNEngine.FAISS
+                );
+                try (IndexOutput indexOutput = directory.createOutput(indexFileName, IOContext.DEFAULT)) {
+                    JNIService.writeIndex(new IndexOutputWithBuffer(indexOutput, compress), indexAddress, KNNEngine.FAISS, parameters);
+                }
+                indexFileNames[compress ? 1 : 0] = indexFileName;
+            }
+            assertTrue(directory.fileLength(indexFileNames[1]) < directory.fileLength(indexFileNames[0]));
+
+            final long plainPointer;
+            final long streamPointer;
+            try (
+                IndexInput plainInput = directory.openInput(indexFileNames[0], IOContext.DEFAULT);
+                IndexInput compressedInput = directory.openInput(indexFileNames[1], IOContext.DEFAULT)
+            ) {
+                plainPointer = JNIService.loadIndex(new IndexInputWithBuffer(plainInput), Collections.emptyMap(), KNNEngine.FAISS);
+                streamPointer = JNIService.loadIndex(new IndexInputWithBuffer(compressedInput), Collections.emptyMap(), KNNEngine.FAISS);
+            }
+            final long filePointer = JNIService.loadIndex(
+                tempDirPath.resolve(indexFileNames[1]).toString(),
+                Collections.emptyMap(),
+                KNNEngine.FAISS
+            );
+
+            int k = 10;
+            for (float[] query : testData.queries) {
+                KNNQueryResult[] expected = JNIService.queryIndex(plainPointer, query, k, null, KNNEngine.FAISS, null, 0, null);
+                for (long pointer : new long[] { streamPointer, filePointer }) {
+                    KNNQueryResult[] results = JNIService.queryIndex(pointer, query, k, null, KNNEngine.FAISS, null, 0, null);
+                    assertEquals(expected.length, results.length);
+                    for (int i = 0; i < expected.length; i++) {
+                        assertEquals(expected[i].getId(), results[i].getId());
+                        assertEquals(expected[i].getScore(), results[i].getScore(), 0.0f);
+                    }
+                }
+            }
+            JNIService.free(plainPointer, KNNEngine.FAISS);
+            JNIService.free(streamPointer, KNNEngine.FAISS);
+            JNIService.free(filePointer, KNNEngine.FAISS);
+        }
+    }
+
+    @SneakyThrows
+    public void testCreateIndexFromTemplate_faiss_whenCompressed_thenLoadFromStreamAndFile() {
+        long trainPointer = JNICommons.storeVectorData(
+            0,
+            testData.indexData.vectors,
+            testData.indexData.vectors.length * testData.indexData.vectors[0].length
+        );
+        assertNotEquals(0, trainPointer);
+        Map<String, Object> parameters = ImmutableMap.of(
+            INDEX_DESCRIPTION_PARAMETER,
+            "IVF16,Flat",
+            KNNConstants.SPACE_TYPE,
+            SpaceType.L2.getValue()
+        );
+        int dimension = testData.indexData.getDimension();
+        byte[] faissIndex = JNIService.trainIndex(parameters, dimension, trainPointer, KNNEngine.FAISS);
+        assertNotEquals(0, faissIndex.length);
+        JNICommons.freeVectorData(trainPointer);
+
+        Path tempDirPath = createTempDir();
+        try (Directory directory = newFSDirectory(tempDirPath)) {
+            String[] indexFileNames = new String[2];
+            for (boolean compress : new boolean[] { false, true }) {
+                String indexFileName = "test" + compress + UUID.randomUUID() + ".tmp";
+                try (IndexOutput indexOutput = directory.createOutput(indexFileName, IOContext.DEFAULT)) {
+                    JNIService.createIndexFromTemplate(
+                        testData.indexData.docs,
+                        testData.loadDataToMemoryAddress(),
+                        dimension,
+                        new IndexOutputWithBuffer(indexOutput, compress),
+                        faissIndex,
+                        ImmutableMap.of(INDEX_THREAD_QTY, 1),
+                        KNNEngine.FAISS
+                    );
+                }
+                indexFileNames[compress ? 1 : 0] = indexFileName;
+            }
+            assertTrue(directory.fileLength(indexFileNames[1]) < directory.fileLength(indexFileNames[0]));
+
+            final long plainPointer;
+            final long streamPointer;
+            try (
+                IndexInput plainInput = directory.openInput(indexFileNames[0], IOContext.DEFAULT);
+                IndexInput compressedInput = directory.openInput(indexFileNames[1], IOContext.DEFAULT)
+            ) {
+                plainPointer = JNIService.loadIndex(new IndexInputWithBuffer(plainInput), Collections.emptyMap(), KNNEngine.FAISS);
+                streamPointer = JNIService.loadIndex(new IndexInputWithBuffer(compressedInput), Collections.emptyMap(), KNNEngine.FAISS);
+            }
+            final long filePointer = JNIService.loadIndex(
+                tempDirPath.resolve(indexFileNames[1]).toString(),
+                Collections.emptyMap(),
+                KNNEngine.FAISS
+            );
+
+            int k = 10;
+            for (float[] query : testData.queries) {
+                KNNQueryResult[] expected = JNIService.queryIndex(plainPointer, query, k, null, KNNEngine.FAISS, null, 0, null);
+                for (long pointer : new long[] { streamPointer, filePointer }) {
+                    KNNQueryResult[] results = JNIService.queryIndex(pointer, query, k, null, KNNEngine.FAISS, null, 0, null);
+                    assertEquals(expected.length, results.length);
+                    for (int i = 0; i < expected.length; i++) {
+                        assertEquals(expected[i].getId(), results[i].getId());
+                        assertEquals(expected[i].getScore(), results[i].getScore(), 0.0f);
+                    }
+                }
+            }
+            JNIService.free(plainPointer, KNNEngine.FAISS);
+            JNIService.free(streamPointer, KNNEngine.FAISS);
+            JNIService.free(filePointer, KNNEngine.FAISS);
+        }
+    }
+
+    @SneakyThrows
+    public void testWriteIndex_faiss_whenGraphReordered_thenSameResults() {
+        Path tempDirPath = createTempDir();
+        try (Directory directory = newFSDirectory(tempDirPath)) {
+            Map<String, Object> parameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER,
+                faissMethod,
+                KNNConstants.SPACE_TYPE,
+                SpaceType.L2.getValue()
+            );
+            int dimension = testData.indexData.getDimension();
+            long[] pointers = new long[2];
+            for (boolean reorder : new boolean[] { false, true }) {
+                String indexFileName = "test" + reorder + UUID.randomUUID() + ".tmp";
+                long indexAddress = JNIService.initIndex(0, dimension, parameters, KNNEngine.FAISS);
+                JNIService.insertToIndex(
+                    testData.indexData.docs,
+                    testData.loadDataToMemoryAddress(),
+                    dimension,
+                    parameters,
+                    indexAddress,
+                    KNNEngine.FAISS
+                );
+                try (IndexOutput indexOutput = directory.createOutput(indexFileName, IOContext.DEFAULT)) {
+                    IndexOutputWithBuffer indexOutputWithBuffer = new IndexOutputWithBuffer(indexOutput);
+                    indexOutputWithBuffer.reorderGraph(reorder);
+                    JNIService.writeIndex(indexOutputWithBuffer, indexAddress, KNNEngine.FAISS, parameters);
+                }
+                try (IndexInput indexInput = directory.openInput(indexFileName, IOContext.DEFAULT)) {
+                    pointers[reorder ? 1 : 0] = JNIService.loadIndex(
+                        new IndexInputWithBuffer(indexInput),
+                        Collections.emptyMap(),
+                        KNNEngine.FAISS
+                    );
+                }
+            }
+
+            // Renumbering keeps the graph, so searches visit the same vectors and return the same documents
+            int k = 10;
+            for (float[] query : testData.queries) {
+                KNNQueryResult[] expected = JNIService.queryIndex(pointers[0], query, k, null, KNNEngine.FAISS, null, 0, null);
+                KNNQueryResult[] results = JNIService.queryIndex(pointers[1], query, k, null, KNNEngine.FAISS, null, 0, null);
+                assertEquals(expected.length, results.length);
+                for (int i = 0; i < expected.length; i++) {
+                    assertEquals(expected[i].getId(), results[i].getId());
+                    assertEquals(expected[i].getScore(), results[i].getScore(), 0.0f);
+                }
+            }
+            JNIService.free(pointers[0], KNNEngine.FAISS);
+            JNIService.free(pointers[1], KNNEngine.FAISS);
+        }
+    }
+
+    @SneakyThrows
+    public void testWriteIndex_faiss_whenWrittenDirectly_thenFooterHasChecksum() {
+        Path tempDirPath = createTempDir();
+        try (Directory directory = newFSDirectory(tempDirPath)) {
+            Map<String, Object> parameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER,
+                faissMethod,
+                KNNConstants.SPACE_TYPE,
+                SpaceType.L2.getValue()
+            );
+            int dimension = testData.indexData.getDimension();
+            long indexAddress = JNIService.initIndex(0, dimension, parameters, KNNEngine.FAISS);
+            JNIService.insertToIndex(
+                testData.indexData.docs,
+                testData.loadDataToMemoryAddress(),
+                dimension,
+                parameters,
+                indexAddress,
+                KNNEngine.FAISS
+            );
+
+            String indexFileName = "test" + UUID.randomUUID() + ".tmp";
+            IndexOutputWithBuffer indexOutputWithBuffer;
+            try (IndexOutput indexOutput = directory.createOutput(indexFileName, IOContext.DEFAULT)) {
+                indexOutputWithBuffer = new IndexOutputWithBuffer(indexOutput);
+                indexOutputWithBuffer.writeDirectlyTo(tempDirPath.resolve(indexFileName), true);
+                JNIService.writeIndex(indexOutputWithBuffer, indexAddress, KNNEngine.FAISS, parameters);
+            }
+            assertTrue(indexOutputWithBuffer.isWrittenDirectly());
+            assertEquals(directory.fileLength(indexFileName), indexOutputWithBuffer.getDirectWriteLength());
+
+            try (IndexInput indexInput = directory.openInput(indexFileName, IOContext.DEFAULT)) {
+                assertEquals(indexOutputWithBuffer.getDirectWriteChecksum(), CodecUtil.checksumEntireFile(indexInput));
+            }
+            long pointer = JNIService.loadIndex(tempDirPath.resolve(indexFileName).toString(), Collections.emptyMap(), KNNEngine.FAISS);
+            assertNotEquals(0, pointer);
+            JNIService.free(pointer, KNNEngine.FAISS);
+        }
+    }
+
+    @SneakyThrows
+    public void testWarmIndex_faiss_thenBytesOfIndexAreWarmedUp() {
+        Path tempDirPath = createTempDir();
+        try (Directory directory = newFSDirectory(tempDirPath)) {
+            Map<String, Object> parameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER,
+                faissMethod,
+                KNNConstants.SPACE_TYPE,
+                SpaceType.L2.getValue()
+            );
+            int dimension = testData.indexData.getDimension();
+            long indexAddress = JNIService.initIndex(0, dimension, parameters, KNNEngine.FAISS);
+            JNIService.insertToIndex(
+                testData.indexData.docs,
+                testData.loadDataToMemoryAddress(),
+                dimension,
+                parameters,
+                indexAddress,
+                KNNEngine.FAISS
+            );
+            String indexFileName = "test" + UUID.randomUUID() + ".tmp";
+            try (IndexOutput indexOutput = directory.createOutput(indexFileName, IOContext.DEFAULT)) {
+                JNIService.writeIndex(new IndexOutputWithBuffer(indexOutput), indexAddress, KNNEngine.FAISS, parameters);
+            }
+            long pointer = JNIService.loadIndex(tempDirPath.resolve(indexFileName).toString(), Collections.emptyMap(), KNNEngine.FAISS);
+
+            // At least the vectors are warmed up
+            long vectorBytes = (long) testData.indexData.docs.length * dimension * Float.BYTES;
+            for (NativeIndexWarmupMode mode : new NativeIndexWarmupMode[] {
+                NativeIndexWarmupMode.ADVISE,
+                NativeIndexWarmupMode.TOUCH,
+                NativeIndexWarmupMode.QUERY }) {
+                long[] stats = JNIService.warmIndex(pointer, KNNEngine.FAISS, mode);
+                assertEquals(2, stats.length);
+                assertTrue(stats[0] >= vectorBytes);
+                assertTrue(stats[1] >= 0);
+            }
+            expectThrows(IllegalArgumentException.class, () -> JNIService.warmIndex(pointer, KNNEngine.FAISS, NativeIndexWarmupMode.NONE));
+            JNIService.free(pointer, KNNEngine.FAISS);
+        }
+    }
+
+    @SneakyThrows
+    public void testGetIndexMemoryUsage_faiss_thenComponentsOfIndexAreCounted() {
+        Path tempDirPath = createTempDir();
+        try (Directory directory = newFSDirectory(tempDirPath)) {
+            Map<String, Object> parameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER,
+                faissMethod,
+                KNNConstants.SPACE_TYPE,
+                SpaceType.L2.getValue()
+            );
+            int dimension = testData.indexData.getDimension();
+            long indexAddress = JNIService.initIndex(0, dimension, parameters, KNNEngine.FAISS);
+            JNIService.insertToIndex(
+                testData.indexData.docs,
+                testData.loadDataToMemoryAddress(),
+                dimension,
+                parameters,
+                indexAddress,
+                KNNEngine.FAISS
+            );
+            String indexFileName = "test" + UUID.randomUUID() + ".tmp";
+            try (IndexOutput indexOutput = directory.createOutput(indexFileName, IOContext.DEFAULT)) {
+                JNIService.writeIndex(new IndexOutputWithBuffer(indexOutput), indexAddress, KNNEngine.FAISS, parameters);
+            }
+            long pointer = JNIService.loadIndex(tempDirPath.resolve(indexFileName).toString(), Collections.emptyMap(), KNNEngine.FAISS);
+
+            NativeIndexMemoryUsage usage = new NativeIndexMemoryUsage(JNIService.getIndexMemoryUsage(pointer, KNNEngine.FAISS));
+            int numVectors = testData.indexData.docs.length;
+            assertTrue(usage.getCodesBytes() >= (long) numVectors * dimension * Float.BYTES);
+            assertTrue(usage.getNeighborsBytes() > 0);
+            assertTrue(usage.getIdMapBytes() >= (long) numVectors * Long.BYTES);
+            assertEquals(0, usage.getSharedStateBytes());
+            assertTrue(usage.getIndexBytes() > usage.getCodesBytes() + usage.getNeighborsBytes());
+            expectThrows(IllegalArgumentException.class, () -> JNIService.getIndexMemoryUsage(pointer, KNNEngine.NMSLIB));
+            JNIService.free(pointer, KNNEngine.FAISS);
+        }
+    }
+
+    @SneakyThrows
+    public void testLoadIndex_faiss_whenCompactGraphs_thenSameResultsWithFewerNeighborBytes() {
+        Path tempDirPath = createTempDir();
+        try (Directory directory = newFSDirectory(tempDirPath)) {
+            Map<String, Object> parameters = ImmutableMap.of(
+                INDEX_DESCRIPTION_PARAMETER,
+                faissMethod,
+                KNNConstants.SPACE_TYPE,
+                SpaceType.L2.getValue()
+            );
+            int dimension = testData.indexData.getDimension();
+            long indexAddress = JNIService.initIndex(0, dimension, parameters, KNNEngine.FAISS);
+            JNIService.insertToIndex(
+                testData.indexData.docs,
+                testData.loadDataToMemoryAddress(),
+                dimension,
+                parameters,
+                indexAddress,
+                KNNEngine.FAISS
+            );
+            String indexFileName = "test" + UUID.randomUUID() + ".tmp";
+            try (IndexOutput indexOutput = directory.createOutput(indexFileName, IOContext.DEFAULT)) {
+                JNIService.writeIndex(new IndexOutputWithBuffer(indexOutput), indexAddress, KNNEngine.FAISS, parameters);
+            }
+            String indexPath = tempDirPath.resolve(indexFileName).toString();
+            long pointer = JNIService.loadIndex(indexPath, Collections.emptyMap(), KNNEngine.FAISS);
+            long compactPointer;
+            try {
+                JNIService.configureCompactGraphs(true);
+                compactPointer = JNIService.loadIndex(indexPath, Collections.emptyMap(), KNNEngine.FAISS);
+            } finally {
+                JNIService.configureCompactGraphs(false);
+            }
+
+            NativeIndexMemoryUsage usage = new NativeIndexMemoryUsage(JNIService.getIndexMemoryUsage(pointer, KNNEngine.FAISS));
+            NativeIndexMemoryUsage compactUsage = new NativeIndexMemoryUsage(
+                JNIService.getIndexMemoryUsage(compactPointer, KNNEngine.FAISS)
+            );
+            assertTrue(compactUsage.getNeighborsBytes() > 0);
+            assertTrue(compactUsage.getNeighborsBytes() < usage.getNeighborsBytes());
+            assertEquals(usage.getCodesBytes(), compactUsage.getCodesBytes());
+
+            // Neighbors are only visited in another order, so results match but for the odd tie
+            int k = 10;
+            int matches = 0;
+            for (float[] query : testData.queries) {
+                KNNQueryResult[] expected = JNIService.queryIndex(pointer, query, k, null, KNNEngine.FAISS, null, 0, null);
+                KNNQueryResult[] results = JNIService.queryIndex(compactPointer, query, k, null, KNNEngine.FAISS, null, 0, null);
+                assertEquals(expected.length, results.length);
+                Set<Integer> expectedIds = Arrays.stream(expected).map(KNNQueryResult::getId).collect(Collectors.toSet());
+                matches += (int) Arrays.stream(results).filter(result -> expectedIds.contains(result.getId())).count();
+            }
+            assertTrue(matches >= testData.queries.length * k * 9 / 10);
+            JNIService.free(pointer, KNNEngine.FAISS);
+            JNIService.free(compactPointer, KNNEngine.FAISS);
+        }
+    }
+
     @SneakyThrows
     public void testLoadIndex_when_io_exception_was_raised() {
         Path tempDirPath = createTempDir();
@@ -1083,6 +1455,45 @@ public class JNIServiceTests extends KNNTestCase {
                     KNNQueryResult[] results = JNIService.queryIndex(pointer, query, k, null, KNNEngine.NMSLIB, null, 0, null);
                     assertEquals(k, results.length);
                 }
+
+                // Native search parameters give the same neighbors as the method parameters they were created from
+                final Map<String, ?> methodParameters = Map.of(KNNConstants.METHOD_PARAMETER_EF_SEARCH, 100);
+                final long searchParams = JNIService.createSearchParams(methodParameters);
+                try {
+                    final int[] resultIds = new int[k];
+                    final float[] resultDistances = new float[k];
+                    for (float[] query : testData.queries) {
+                        KNNQueryResult[] expected = JNIService.queryIndex(
+                            pointer,
+                            query,
+                            k,
+                            methodParameters,
+                            KNNEngine.NMSLIB,
+                            null,
+                            0,
+                            null
+                        );
+                        int resultSize = JNIService.queryIndexWithFilterBuffer(
+                            pointer,
+                            query,
+                            k,
+                            searchParams,
+                            KNNEngine.NMSLIB,
+                            null,
+                            0,
+                            null,
+                            resultIds,
+                            resultDistances
+                        );
+                        assertEquals(expected.length, resultSize);
+                        for (int i = 0; i < resultSize; i++) {
+                            assertEquals(expected[i].getId(), resultIds[i]);
+                            assertEquals(expected[i].getScore(), resultDistances[i], 0.0f);
+                        }
+                    }
+                } finally {
+                    JNIService.freeSearchParams(searchParams);
+                }
             }
         }
     }
@@ -1221,6 +1632,320 @@ public class JNIServiceTests extends KNNTestCase {
         }
     }
 
+    public void testQueryIndexWithSearchParams_faiss_valid() throws IOException {
+        int k = 10;
+        int efSearch = 100;
+
+        Path tempDirPath = createTempDir();
+        try (Directory directory = newFSDirectory(tempDirPath)) {
+            String indexFileName1 = "test1" + UUID.randomUUID() + ".tmp";
+            TestUtils.createIndex(
+                testData.indexData.docs,
+                testData.loadDataToMemoryAddress(),
+                testData.indexData.getDimension(),
+                directory,
+                indexFileName1,
+                ImmutableMap.of(INDEX_DESCRIPTION_PARAMETER, faissMethod, KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                KNNEngine.FAISS
+            );
+            assertTrue(directory.fileLength(indexFileName1) > 0);
+
+            final long pointer;
+            try (IndexInput indexInput = directory.openInput(indexFileName1, IOContext.DEFAULT)) {
+                final IndexInputWithBuffer indexInputWithBuffer = new IndexInputWithBuffer(indexInput);
+                pointer = JNIService.loadIndex(
+                    indexInputWithBuffer,
+                    ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                    KNNEngine.FAISS
+                );
+                assertNotEquals(0, pointer);
+            } catch (Throwable e) {
+                fail(e.getMessage());
+                throw e;
+            }
+
+            long searchParams = JNIService.createSearchParams(Map.of("ef_search", efSearch));
+            try {
+                int[] resultIds = new int[k];
+                float[] resultDistances = new float[k];
+                for (float[] query : testData.queries) {
+                    KNNQueryResult[] results = JNIService.queryIndex(
+                        pointer,
+                        query,
+                        k,
+                        Map.of("ef_search", efSearch),
+                        KNNEngine.FAISS,
+                        null,
+                        0,
+                        null
+                    );
+                    int resultSize = JNIService.queryIndexWithFilterBuffer(
+                        pointer,
+                        query,
+                        k,
+                        searchParams,
+                        KNNEngine.FAISS,
+                        null,
+                        0,
+                        null,
+                        resultIds,
+                        resultDistances
+                    );
+                    assertEquals(results.length, resultSize);
+                    for (int i = 0; i < resultSize; i++) {
+                        assertEquals(results[i].getId(), resultIds[i]);
+                        assertEquals(results[i].getScore(), resultDistances[i], 0.0f);
+                    }
+                }
+            } finally {
+                JNIService.freeSearchParams(searchParams);
+            }
+        }
+    }
+
+    public void testQueryIndexWithFilterBuffer_faiss_valid() throws IOException {
+        int k = 10;
+
+        Path tempDirPath = createTempDir();
+        try (Directory directory = newFSDirectory(tempDirPath)) {
+            String indexFileName1 = "test1" + UUID.randomUUID() + ".tmp";
+            TestUtils.createIndex(
+                testData.indexData.docs,
+                testData.loadDataToMemoryAddress(),
+                testData.indexData.getDimension(),
+                directory,
+                indexFileName1,
+                ImmutableMap.of(INDEX_DESCRIPTION_PARAMETER, faissMethod, KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                KNNEngine.FAISS
+            );
+            assertTrue(directory.fileLength(indexFileName1) > 0);
+
+            final long pointer;
+            try (IndexInput indexInput = directory.openInput(indexFileName1, IOContext.DEFAULT)) {
+                final IndexInputWithBuffer indexInputWithBuffer = new IndexInputWithBuffer(indexInput);
+                pointer = JNIService.loadIndex(
+                    indexInputWithBuffer,
+                    ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                    KNNEngine.FAISS
+                );
+                assertNotEquals(0, pointer);
+            } catch (Throwable e) {
+                fail(e.getMessage());
+                throw e;
+            }
+
+            // Filter on every other doc, passed as a sorted id list
+            long[] filterIds = Arrays.stream(testData.indexData.docs).filter(docId -> docId % 2 == 0).asLongStream().sorted().toArray();
+            ByteBuffer filterBuffer = ByteBuffer.allocateDirect(filterIds.length * Long.BYTES).order(ByteOrder.nativeOrder());
+            filterBuffer.asLongBuffer().put(filterIds);
+
+            int[] resultIds = new int[k];
+            float[] resultDistances = new float[k];
+            for (float[] query : testData.queries) {
+                KNNQueryResult[] expected = JNIService.queryIndex(
+                    pointer,
+                    query,
+                    k,
+                    null,
+                    KNNEngine.FAISS,
+                    filterIds,
+                    FilterIdsSelector.FilterIdsSelectorType.BATCH.getValue(),
+                    null
+                );
+                int resultSize = JNIService.queryIndexWithFilterBuffer(
+                    pointer,
+                    query,
+                    k,
+                    0,
+                    KNNEngine.FAISS,
+                    filterBuffer,
+                    FilterIdsSelector.FilterIdsSelectorType.BATCH.getValue(),
+                    null,
+                    resultIds,
+                    resultDistances
+                );
+                assertEquals(expected.length, resultSize);
+                for (int i = 0; i < resultSize; i++) {
+                    assertEquals(0, resultIds[i] % 2);
+                    assertEquals(expected[i].getId(), resultIds[i]);
+                    assertEquals(expected[i].getScore(), resultDistances[i], 0.0f);
+                }
+            }
+
+            // Heap buffers have no native address and are rejected
+            expectThrows(
+                Exception.class,
+                () -> JNIService.queryIndexWithFilterBuffer(
+                    pointer,
+                    testData.queries[0],
+                    k,
+                    0,
+                    KNNEngine.FAISS,
+                    ByteBuffer.allocate(Long.BYTES),
+                    FilterIdsSelector.FilterIdsSelectorType.BATCH.getValue(),
+                    null,
+                    resultIds,
+                    resultDistances
+                )
+            );
+        }
+    }
+
+    public void testExactSearchIndex_faiss_valid() throws IOException {
+        int k = 10;
+
+        Path tempDirPath = createTempDir();
+        try (Directory directory = newFSDirectory(tempDirPath)) {
+            String indexFileName1 = "test1" + UUID.randomUUID() + ".tmp";
+            TestUtils.createIndex(
+                testData.indexData.docs,
+                testData.loadDataToMemoryAddress(),
+                testData.indexData.getDimension(),
+                directory,
+                indexFileName1,
+                ImmutableMap.of(INDEX_DESCRIPTION_PARAMETER, faissMethod, KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                KNNEngine.FAISS
+            );
+            assertTrue(directory.fileLength(indexFileName1) > 0);
+
+            final long pointer;
+            try (IndexInput indexInput = directory.openInput(indexFileName1, IOContext.DEFAULT)) {
+                final IndexInputWithBuffer indexInputWithBuffer = new IndexInputWithBuffer(indexInput);
+                pointer = JNIService.loadIndex(
+                    indexInputWithBuffer,
+                    ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                    KNNEngine.FAISS
+                );
+                assertNotEquals(0, pointer);
+            } catch (Throwable e) {
+                fail(e.getMessage());
+                throw e;
+            }
+
+            long[] filterIds = Arrays.stream(testData.indexData.docs).filter(docId -> docId % 3 == 0).asLongStream().sorted().toArray();
+            Set<Long> filter = Arrays.stream(filterIds).boxed().collect(Collectors.toSet());
+            int expectedSize = Math.min(k, filterIds.length);
+
+            int[] resultIds = new int[k];
+            float[] resultDistances = new float[k];
+            for (float[] query : testData.queries) {
+                int resultSize = JNIService.exactSearchIndex(
+                    pointer,
+                    query,
+                    k,
+                    KNNEngine.FAISS,
+                    filterIds,
+                    FilterIdsSelector.FilterIdsSelectorType.SORTED_ARRAY.getValue(),
+                    resultIds,
+                    resultDistances
+                );
+                assertEquals(expectedSize, resultSize);
+                for (int i = 0; i < resultSize; i++) {
+                    assertTrue(filter.contains((long) resultIds[i]));
+                    if (i > 0) {
+                        assertTrue(resultDistances[i - 1] <= resultDistances[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    public void testQueryIndexBatch_faiss_valid() throws IOException {
+        int k = 10;
+        int efSearch = 100;
+
+        Path tempDirPath = createTempDir();
+        try (Directory directory = newFSDirectory(tempDirPath)) {
+            String indexFileName1 = "test1" + UUID.randomUUID() + ".tmp";
+            TestUtils.createIndex(
+                testData.indexData.docs,
+                testData.loadDataToMemoryAddress(),
+                testData.indexData.getDimension(),
+                directory,
+                indexFileName1,
+                ImmutableMap.of(INDEX_DESCRIPTION_PARAMETER, faissMethod, KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                KNNEngine.FAISS
+            );
+            assertTrue(directory.fileLength(indexFileName1) > 0);
+
+            final long pointer;
+            try (IndexInput indexInput = directory.openInput(indexFileName1, IOContext.DEFAULT)) {
+                final IndexInputWithBuffer indexInputWithBuffer = new IndexInputWithBuffer(indexInput);
+                pointer = JNIService.loadIndex(
+                    indexInputWithBuffer,
+                    ImmutableMap.of(KNNConstants.SPACE_TYPE, SpaceType.L2.getValue()),
+                    KNNEngine.FAISS
+                );
+                assertNotEquals(0, pointer);
+            } catch (Throwable e) {
+                fail(e.getMessage());
+                throw e;
+            }
+
+            int dimension = testData.indexData.getDimension();
+            int numQueries = testData.queries.length;
+            float[] queryVectors = new float[numQueries * dimension];
+            for (int i = 0; i < numQueries; i++) {
+                System.arraycopy(testData.queries[i], 0, queryVectors, i * dimension, dimension);
+            }
+
+            int[] resultIds = new int[numQueries * k];
+            float[] resultDistances = new float[numQueries * k];
+            final long searchParamsAddress = JNIService.createSearchParams(Map.of("ef_search", efSearch));
+            JNIService.queryIndexBatch(
+                pointer,
+                queryVectors,
+                numQueries,
+                k,
+                searchParamsAddress,
+                KNNEngine.FAISS,
+                null,
+                0,
+                null,
+                resultIds,
+                resultDistances
+            );
+
+            // Each query of the batch returns the same neighbors as a single query
+            for (int i = 0; i < numQueries; i++) {
+                KNNQueryResult[] results = JNIService.queryIndex(
+                    pointer,
+                    testData.queries[i],
+                    k,
+                    Map.of("ef_search", efSearch),
+                    KNNEngine.FAISS,
+                    null,
+                    0,
+                    null
+                );
+                assertEquals(k, results.length);
+                for (int j = 0; j < k; j++) {
+                    assertEquals(results[j].getId(), resultIds[i * k + j]);
+                    assertEquals(results[j].getScore(), resultDistances[i * k + j], 0.0f);
+                }
+            }
+
+            expectThrows(
+                Exception.class,
+                () -> JNIService.queryIndexBatch(
+                    pointer,
+                    queryVectors,
+                    numQueries + 1,
+                    k,
+                    searchParamsAddress,
+                    KNNEngine.FAISS,
+                    null,
+                    0,
+                    null,
+                    resultIds,
+                    resultDistances
+                )
+            );
+            JNIService.freeSearchParams(searchParamsAddress);
+            JNIService.free(pointer, KNNEngine.FAISS);
+        }
+    }
+
     public void testQueryIndex_faiss_streaming_valid() throws IOException {
         int k = 10;
         int efSearch = 100;
@@ -1501,6 +2226,75 @@ public class JNIServiceTests extends KNNTestCase {
         }
     }
 
+    @SneakyThrows
+    public void testRadiusQueryBinaryIndexWithFilterBuffer_faiss_valid() {
+        int k = 10;
+        int maxResultWindow = 5;
+        Path tempDirPath = createTempDir();
+        try (Directory directory = newFSDirectory(tempDirPath)) {
+            String indexFileName1 = "test1" + UUID.randomUUID() + ".tmp";
+            long memoryAddr = testData.loadBinaryDataToMemoryAddress();
+            TestUtils.createIndex(
+                testData.indexData.docs,
+                memoryAddr,
+                testData.indexData.getDimension(),
+                directory,
+                indexFileName1,
+                ImmutableMap.of(
+                    INDEX_DESCRIPTION_PARAMETER,
+                    faissBinaryMethod,
+                    KNNConstants.SPACE_TYPE,
+                    SpaceType.HAMMING.getValue(),
+                    KNNConstants.VECTOR_DATA_TYPE_FIELD,
+                    VectorDataType.BINARY.getValue()
+                ),
+                KNNEngine.FAISS
+            );
+
+            try (IndexInput indexInput = directory.openInput(indexFileName1, IOContext.READONCE)) {
+                long pointer = JNIService.loadIndex(
+                    new IndexInputWithBuffer(indexInput),
+                    ImmutableMap.of(
+                        INDEX_DESCRIPTION_PARAMETER,
+                        faissBinaryMethod,
+                        KNNConstants.VECTOR_DATA_TYPE_FIELD,
+                        VectorDataType.BINARY.getValue()
+                    ),
+                    KNNEngine.FAISS
+                );
+                assertNotEquals(0, pointer);
+
+                final int[] resultIds = new int[maxResultWindow];
+                final float[] resultDistances = new float[maxResultWindow];
+                for (byte[] query : testData.binaryQueries) {
+                    KNNQueryResult[] knnResults = JNIService.queryBinaryIndex(pointer, query, k, null, KNNEngine.FAISS, null, 0, null);
+                    // The radius is inclusive, so the closest neighbor is always within its own distance
+                    float radius = knnResults[0].getScore();
+
+                    int resultSize = JNIService.radiusQueryBinaryIndexWithFilterBuffer(
+                        pointer,
+                        query,
+                        radius,
+                        0,
+                        KNNEngine.FAISS,
+                        maxResultWindow,
+                        null,
+                        0,
+                        null,
+                        resultIds,
+                        resultDistances
+                    );
+                    assertTrue(resultSize > 0);
+                    assertTrue(resultSize <= maxResultWindow);
+                    for (int i = 0; i < resultSize; i++) {
+                        assertTrue(resultDistances[i] <= radius);
+                    }
+                }
+                JNIService.free(pointer, KNNEngine.FAISS, true);
+            }
+        }
+    }
+
     @SneakyThrows
     public void testQueryBinaryIndex_faiss_streaming_valid() {
         int k = 10;
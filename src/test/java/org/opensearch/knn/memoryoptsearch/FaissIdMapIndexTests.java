@@ -11,7 +11,7 @@ import org.apache.lucene.index.FloatVectorValues;
 import org.apache.lucene.store.ByteBuffersDataOutput;
 import org.apache.lucene.store.IndexInput;
 import org.apache.lucene.util.Bits;
-import org.apache.lucene.util.packed.DirectMonotonicReader;
+import org.apache.lucene.util.LongValues;
 import org.mockito.MockedStatic;
 import org.mockito.stubbing.Answer;
 import org.opensearch.common.lucene.store.ByteArrayIndexInput;
@@ -175,6 +175,43 @@ public class FaissIdMapIndexTests extends KNNTestCase {
         }
     }
 
+    public void testReorderedCase() {
+        doTestReorderedCase(FaissIdMapIndex.IXMP);
+        doTestReorderedCase(FaissIdMapIndex.IBMP);
+    }
+
+    @SneakyThrows
+    private void doTestReorderedCase(final String indexType) {
+        // Dimension : 128
+        // #Vectors : 100
+        // Metric : L2
+        final int totalNumberOfVectors = 100;
+        final int dimension = 128;
+        final boolean l2Metric = true;
+
+        // Prepare id mapping
+        // Assuming 0th, 2nd, 4th, ..., 2k_th docs have KNN field, and vectors were renumbered by a graph reordering.
+        final long[] mappingTable = new long[totalNumberOfVectors];
+        for (int i = 0; i < totalNumberOfVectors; ++i) {
+            mappingTable[i] = 2L * ((i * 37) % totalNumberOfVectors);
+        }
+
+        // Load index
+        final FaissIdMapIndex index = triggerLoadAndGetIndex(dimension, totalNumberOfVectors, l2Metric, mappingTable, indexType);
+
+        final long[] loadedMappingTable = getVectorIdToDocIdMapping(index, totalNumberOfVectors);
+        assertNotNull(loadedMappingTable);
+        assertArrayEquals(mappingTable, loadedMappingTable);
+
+        // Sparse float vectors
+        final FloatVectorValues floatVectorValues = index.getFloatValues(null);
+        final Bits bitsFromFloatVectors = floatVectorValues.getAcceptOrds(mock(Bits.class));
+        for (int i = 0; i < totalNumberOfVectors; ++i) {
+            // Internally, it will intercept the argument then compare the converted doc id to the expected one.
+            bitsFromFloatVectors.get(i);
+        }
+    }
+
     @SneakyThrows
     public void testLoadBinaryIdMapIndex() {
         final String relativePath = "data/memoryoptsearch/faiss_binary_50_vectors_512_dim.bin";
@@ -194,7 +231,7 @@ public class FaissIdMapIndexTests extends KNNTestCase {
     private static long[] getVectorIdToDocIdMapping(final FaissIdMapIndex index, final int totalNumberOfVectors) {
         final Field field = FaissIdMapIndex.class.getDeclaredField("idMappingReader");
         field.setAccessible(true);
-        DirectMonotonicReader decoder = (DirectMonotonicReader) field.get(index);
+        LongValues decoder = (LongValues) field.get(index);
         if (decoder == null) {
             // It's an identical case
             return null;
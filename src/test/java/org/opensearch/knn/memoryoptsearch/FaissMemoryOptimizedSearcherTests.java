@@ -7,11 +7,13 @@ package org.opensearch.knn.memoryoptsearch;
 
 import lombok.RequiredArgsConstructor;
 import lombok.SneakyThrows;
+import org.apache.lucene.codecs.Codec;
 import org.apache.lucene.codecs.hnsw.FlatVectorsReader;
 import org.apache.lucene.index.FieldInfo;
 import org.apache.lucene.index.FieldInfos;
 import org.apache.lucene.index.SegmentInfo;
 import org.apache.lucene.index.SegmentReadState;
+import org.apache.lucene.index.SegmentWriteState;
 import org.apache.lucene.search.DocIdSetIterator;
 import org.apache.lucene.search.KnnCollector;
 import org.apache.lucene.search.ScoreDoc;
@@ -23,16 +25,21 @@ import org.apache.lucene.store.IndexInput;
 import org.apache.lucene.store.IndexOutput;
 import org.apache.lucene.store.MMapDirectory;
 import org.apache.lucene.util.FixedBitSet;
+import org.opensearch.common.settings.Settings;
+import org.opensearch.common.xcontent.XContentFactory;
 import org.opensearch.knn.KNNTestCase;
 import org.opensearch.knn.common.KNNConstants;
 import org.opensearch.knn.generate.IndexingType;
 import org.opensearch.knn.generate.SearchTestHelper;
+import org.opensearch.knn.index.KNNSettings;
 import org.opensearch.knn.index.KNNVectorSimilarityFunction;
 import org.opensearch.knn.index.SpaceType;
 import org.opensearch.knn.index.VectorDataType;
 import org.opensearch.knn.index.codec.KNN990Codec.NativeEngines990KnnVectorsReader;
 import org.opensearch.knn.index.codec.KNNCodecTestUtil;
 import org.opensearch.knn.index.codec.nativeindex.MemoryOptimizedSearchIndexingSupport;
+import org.opensearch.knn.index.codec.nativeindex.NativeIndexBuildStrategyFactory;
+import org.opensearch.knn.index.codec.nativeindex.NativeIndexWriter;
 import org.opensearch.knn.index.codec.nativeindex.model.BuildIndexParams;
 import org.opensearch.knn.index.engine.KNNEngine;
 import org.opensearch.knn.index.mapper.KNNVectorFieldMapper;
@@ -82,6 +89,7 @@ import static org.opensearch.knn.common.KNNConstants.SPACE_TYPE;
 import static org.opensearch.knn.common.KNNConstants.TYPE;
 import static org.opensearch.knn.common.KNNConstants.VECTOR_DATA_TYPE_FIELD;
 import static org.opensearch.knn.generate.SearchTestHelper.generateOneSingleByteVector;
+import static org.opensearch.knn.index.codec.util.KNNCodecUtil.buildEngineFileName;
 import static org.opensearch.knn.generate.SearchTestHelper.generateOneSingleFloatVector;
 import static org.opensearch.knn.generate.SearchTestHelper.generateRandomByteVectors;
 import static org.opensearch.knn.generate.SearchTestHelper.getKnnAnswerSetForVectors;
@@ -240,6 +248,26 @@ public class FaissMemoryOptimizedSearcherTests extends KNNTestCase {
         doSearchTest(testingSpec, IndexingType.DENSE_NESTED);
     }
 
+    public void testFloatIndexTypeWithGraphReorderEnabled() {
+        // Reordered graphs have their id map in the renumbered order, which is no longer ascending
+        clusterService.getClusterSettings()
+            .applySettings(Settings.builder().put(KNNSettings.KNN_FAISS_GRAPH_REORDER_ENABLED, true).build());
+        final TestingSpec testingSpec = new TestingSpec(
+            VectorDataType.FLOAT,
+            FLOAT_HNSW_INDEX_DESCRIPTION,
+            -1000000,
+            1000000,
+            FLOAT32_ENCODER_PARAMETERS
+        );
+        testingSpec.writeWithNativeIndexWriter = true;
+
+        // Test a dense case where all docs have KNN field.
+        doSearchTest(testingSpec, IndexingType.DENSE);
+
+        // Test a sparse case where some docs don't have KNN field
+        doSearchTest(testingSpec, IndexingType.SPARSE);
+    }
+
     @SneakyThrows
     private void doSearchTest(final TestingSpec testingSpec, final IndexingType indexingType) {
         final List<SpaceType> spaceTypes;
@@ -273,7 +301,9 @@ public class FaissMemoryOptimizedSearcherTests extends KNNTestCase {
         final float filteringRatio
     ) {
         // Build FAISS index
-        final BuildInfo buildInfo = buildFaissIndex(testingSpec, TOTAL_NUM_DOCS_IN_SEGMENT, indexingType, spaceType);
+        final BuildInfo buildInfo = testingSpec.writeWithNativeIndexWriter
+            ? writeFaissIndex(testingSpec, TOTAL_NUM_DOCS_IN_SEGMENT, indexingType, spaceType)
+            : buildFaissIndex(testingSpec, TOTAL_NUM_DOCS_IN_SEGMENT, indexingType, spaceType);
 
         // Load FAISS index via JNI
         long indexPointer = -1;
@@ -555,6 +585,79 @@ public class FaissMemoryOptimizedSearcherTests extends KNNTestCase {
         return buildInfo;
     }
 
+    /**
+     * Writes a float index through {@link NativeIndexWriter}, the way a flush does for a field memory optimized search can read.
+     */
+    @SneakyThrows
+    private BuildInfo writeFaissIndex(
+        final TestingSpec testingSpec,
+        final int numberOfTotalDocsInSegment,
+        final IndexingType indexingType,
+        final SpaceType spaceType
+    ) {
+        assert (testingSpec.dataType == VectorDataType.FLOAT);
+        final Path tempDir = createTempDir(UUID.randomUUID().toString());
+        final String segmentName = "_0";
+        final String fileName = buildEngineFileName(
+            segmentName,
+            KNNEngine.FAISS.getVersion(),
+            TARGET_FIELD,
+            KNNEngine.FAISS.getExtension()
+        );
+
+        // Set up parameters
+        final Map<String, Object> parameters = new HashMap<>();
+        parameters.put(NAME, METHOD_HNSW);
+        parameters.put(VECTOR_DATA_TYPE_FIELD, testingSpec.dataType.getValue());
+        parameters.put(SPACE_TYPE, spaceType.getValue());
+        parameters.put(INDEX_THREAD_QTY, 1);
+        parameters.put(INDEX_DESCRIPTION_PARAMETER, testingSpec.indexDescription);
+
+        final Map<String, Object> methodParameters = new HashMap<>();
+        parameters.put(PARAMETERS, methodParameters);
+        methodParameters.put(METHOD_PARAMETER_EF_SEARCH, numberOfTotalDocsInSegment - 1);
+        methodParameters.put(METHOD_PARAMETER_EF_CONSTRUCTION, numberOfTotalDocsInSegment);
+        methodParameters.put(METHOD_ENCODER_PARAMETER, testingSpec.encoderParameters);
+
+        // Set up vectors
+        final List<Integer> documentIds = indexingType.generateDocumentIds(numberOfTotalDocsInSegment);
+        final BuildInfo buildInfo = new BuildInfo(tempDir, fileName, parameters, documentIds);
+        final List<float[]> floatVectors = SearchTestHelper.generateRandomFloatVectors(
+            documentIds,
+            DIMENSIONS,
+            testingSpec.minValue,
+            testingSpec.maxValue
+        );
+        buildInfo.vectors = new SearchTestHelper.Vectors(floatVectors);
+
+        final FieldInfo fieldInfo = KNNCodecTestUtil.FieldInfoBuilder.builder(TARGET_FIELD)
+            .addAttribute(KNNVectorFieldMapper.KNN_FIELD, "true")
+            .addAttribute(KNNConstants.KNN_ENGINE, KNNEngine.FAISS.getName())
+            .addAttribute(VECTOR_DATA_TYPE_FIELD, testingSpec.dataType.getValue())
+            .addAttribute(PARAMETERS, XContentFactory.jsonBuilder().map(parameters).toString())
+            .build();
+        try (final Directory directory = newFSDirectory(tempDir)) {
+            final SegmentInfo segmentInfo = KNNCodecTestUtil.segmentInfoBuilder()
+                .directory(directory)
+                .segmentName(segmentName)
+                .docsInSegment(documentIds.getLast() + 1)
+                .codec(Codec.getDefault())
+                .build();
+            final SegmentWriteState state = new SegmentWriteState(
+                null,
+                directory,
+                segmentInfo,
+                new FieldInfos(new FieldInfo[] { fieldInfo }),
+                null,
+                IOContext.DEFAULT
+            );
+            NativeIndexWriter.getWriter(fieldInfo, state, null, new NativeIndexBuildStrategyFactory())
+                .flushIndex(() -> createKNNFloatVectorValues(documentIds, floatVectors), documentIds.size());
+        }
+
+        return buildInfo;
+    }
+
     public static void validateResults(
         final List<Integer> documentIds,
         final SearchTestHelper.Vectors vectors,
@@ -723,5 +826,6 @@ public class FaissMemoryOptimizedSearcherTests extends KNNTestCase {
         public final Map<String, Object> encoderParameters;
         public ScalarQuantizationParams quantizationParams;
         public QuantizationState quantizationState;
+        public boolean writeWithNativeIndexWriter;
     }
 }